@@ -0,0 +1,121 @@
+#! /usr/bin/env python3
+"""Compare the phase timings and the peak memory usage recorded by a
+performance benchmark (see oomph::PhaseTimings::doc()) against a stored
+baseline.
+
+Both files contain lines of the form
+
+    <phase> <wall clock time [sec]> <number of calls>
+    peak_rss_kb <peak resident set size [kB]>
+
+(lines starting with '#' are ignored). A phase fails if its time exceeds
+the baseline time by more than the relative time tolerance *and* by more
+than the absolute time floor (so that very short phases, whose timings
+are dominated by noise, do not trigger failures). The peak memory usage
+fails if it exceeds the baseline by more than the relative memory
+tolerance. Faster or leaner runs never fail, but large improvements are
+reported so that the baseline can be updated.
+
+Usage:
+
+    compare_benchmarks.py [options] baseline_file result_file
+
+Prints [OK] or [FAILED] (as the other validation scripts) and exits with
+status 0 or 1, respectively; status 2 indicates unreadable input.
+"""
+
+import argparse
+import sys
+
+
+def read_benchmark_file(filename):
+    """Return dictionary of the entries (phase -> value) in the file"""
+    entries = {}
+    with open(filename) as benchmark_file:
+        for line in benchmark_file:
+            fields = line.split()
+            if len(fields) < 2 or fields[0].startswith("#"):
+                continue
+            entries[fields[0]] = float(fields[1])
+    return entries
+
+
+def compare(baseline, result, args, out):
+    """Compare the entries; return True if there is no regression"""
+    passed = True
+    for phase in sorted(baseline.keys()):
+        if phase not in result:
+            out.write("   %-20s missing in result\n" % phase)
+            passed = False
+            continue
+
+        old = baseline[phase]
+        new = result[phase]
+        if phase == "peak_rss_kb":
+            # Memory usage not available on this platform?
+            if old < 0.0 or new < 0.0:
+                out.write("   %-20s not available\n" % phase)
+                continue
+            tolerance = args.memory_tolerance
+            floor = 0.0
+            unit = "kB"
+        else:
+            tolerance = args.time_tolerance
+            floor = args.min_time
+            unit = "sec"
+
+        if new > max(old * (1.0 + tolerance), old + floor):
+            status = "REGRESSION"
+            passed = False
+        elif new < old / (1.0 + tolerance) and old - new > floor:
+            status = "improved (consider updating the baseline)"
+        else:
+            status = "ok"
+
+        change = 100.0 * (new - old) / old if old > 0.0 else 0.0
+        out.write("   %-20s baseline: %12.4g %s; result: %12.4g %s "
+                  "(%+6.1f%%) %s\n" % (phase, old, unit, new, unit,
+                                        change, status))
+
+    # New phases are reported but do not fail the comparison
+    for phase in sorted(set(result.keys()) - set(baseline.keys())):
+        out.write("   %-20s not in baseline (result: %g)\n"
+                  % (phase, result[phase]))
+    return passed
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare performance benchmark results with a baseline")
+    parser.add_argument("baseline_file")
+    parser.add_argument("result_file")
+    parser.add_argument("--time_tolerance", type=float, default=0.5,
+                        help="Permitted relative increase of the phase "
+                        "timings (default: 0.5)")
+    parser.add_argument("--min_time", type=float, default=0.2,
+                        help="Permitted absolute increase of the phase "
+                        "timings in sec (default: 0.2)")
+    parser.add_argument("--memory_tolerance", type=float, default=0.2,
+                        help="Permitted relative increase of the peak "
+                        "memory usage (default: 0.2)")
+    args = parser.parse_args()
+
+    try:
+        baseline = read_benchmark_file(args.baseline_file)
+        result = read_benchmark_file(args.result_file)
+    except (IOError, ValueError) as error:
+        sys.stdout.write("\n   [FAILED] Cannot read benchmark files: %s\n"
+                         % error)
+        return 2
+
+    sys.stdout.write("\n   Comparing %s against baseline %s\n"
+                     % (args.result_file, args.baseline_file))
+    if compare(baseline, result, args, sys.stdout):
+        sys.stdout.write("\n   [OK] No performance regressions\n")
+        return 0
+    sys.stdout.write("\n   [FAILED] Performance regressions detected\n")
+    return 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
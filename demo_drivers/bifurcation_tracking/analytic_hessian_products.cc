@@ -0,0 +1,340 @@
+//LIC// ====================================================================
+//LIC// This file forms part of oomph-lib, the object-oriented,
+//LIC// multi-physics finite-element library, available
+//LIC// at http://www.oomph-lib.org.
+//LIC//
+//LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+//LIC//
+//LIC// This library is free software; you can redistribute it and/or
+//LIC// modify it under the terms of the GNU Lesser General Public
+//LIC// License as published by the Free Software Foundation; either
+//LIC// version 2.1 of the License, or (at your option) any later version.
+//LIC//
+//LIC// This library is distributed in the hope that it will be useful,
+//LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+//LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//LIC// Lesser General Public License for more details.
+//LIC//
+//LIC// You should have received a copy of the GNU Lesser General Public
+//LIC// License along with this library; if not, write to the Free Software
+//LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+//LIC// 02110-1301  USA.
+//LIC//
+//LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+//LIC//
+//LIC//====================================================================
+// Compare the analytic products of the Hessian (the derivatives of the
+// Jacobian w.r.t. the unknowns) with vectors, as used in the tracking of
+// bifurcations, with those computed by the (global) finite-difference
+// default, for Poisson, advection-diffusion, solid (PVD) and
+// Foeppl-von Karman elements.
+
+//Oomph-lib includes
+#include "generic.h"
+#include "poisson.h"
+#include "advection_diffusion.h"
+#include "solid.h"
+#include "constitutive.h"
+#include "foeppl_von_karman.h"
+
+// The meshes
+#include "meshes/simple_rectangular_quadmesh.h"
+#include "meshes/rectangular_quadmesh.h"
+
+using namespace std;
+using namespace oomph;
+
+
+//==start_of_namespace====================================================
+/// Namespace for the problem parameters
+//========================================================================
+namespace Global_Parameters
+{
+ /// Number of elements in each coordinate direction
+ unsigned N_element=16;
+
+ /// Number of evaluations of the products for the timings
+ unsigned N_repeat=10;
+
+ /// Peclet number
+ double Peclet=10.0;
+
+ /// Wind for the advection-diffusion problem
+ void wind_function(const Vector<double>& x, Vector<double>& wind)
+ {
+  wind[0]=sin(6.0*x[1]);
+  wind[1]=cos(6.0*x[0]);
+ }
+
+ /// Poisson's ratio
+ double Nu=0.3;
+
+ /// Mooney-Rivlin parameter for the (compressible) generalised
+ /// Mooney-Rivlin strain energy function
+ double C1=1.3;
+
+ /// FvK parameter
+ double Eta=12.0;
+
+} // end of namespace
+
+
+
+//=====================================================================
+/// Problem on the unit square with a mesh of ELEMENTs; the dofs of
+/// SolidElements are their nodal positions
+//=====================================================================
+template<class ELEMENT, class MESH>
+class HessianTestProblem : public Problem
+{
+
+public:
+
+ /// Constructor: Pass number of elements in each coordinate direction
+ /// and the constitutive law (only used for solid elements)
+ HessianTestProblem(const unsigned& n,
+                    ConstitutiveLaw* constitutive_law_pt=0);
+
+}; // end of HessianTestProblem
+
+
+
+//=====================================================================
+/// Constructor
+//=====================================================================
+template<class ELEMENT, class MESH>
+HessianTestProblem<ELEMENT,MESH>::HessianTestProblem(
+ const unsigned& n, ConstitutiveLaw* constitutive_law_pt)
+{
+ Problem::mesh_pt()=new MESH(n,n,1.0,1.0);
+
+ // The default finite-difference step is too small to resolve the
+ // change in Jacobians that are themselves computed by finite differences
+ FD_step_used_in_get_hessian_vector_products=1.0e-5;
+
+ // Pin all values (or positions) on the boundaries
+ unsigned n_bound=mesh_pt()->nboundary();
+ for (unsigned b=0;b<n_bound;b++)
+  {
+   unsigned n_node=mesh_pt()->nboundary_node(b);
+   for (unsigned j=0;j<n_node;j++)
+    {
+     Node* nod_pt=mesh_pt()->boundary_node_pt(b,j);
+     SolidNode* solid_nod_pt=dynamic_cast<SolidNode*>(nod_pt);
+     if (solid_nod_pt!=0)
+      {
+       solid_nod_pt->pin_position(0);
+       solid_nod_pt->pin_position(1);
+      }
+     else
+      {
+       unsigned n_value=nod_pt->nvalue();
+       for (unsigned i=0;i<n_value;i++)
+        {
+         nod_pt->pin(i);
+        }
+      }
+    }
+  }
+
+ // Set the physical parameters
+ unsigned n_element=mesh_pt()->nelement();
+ for (unsigned e=0;e<n_element;e++)
+  {
+   FiniteElement* el_pt=mesh_pt()->finite_element_pt(e);
+
+   AdvectionDiffusionEquations<2>* adv_diff_el_pt=
+    dynamic_cast<AdvectionDiffusionEquations<2>*>(el_pt);
+   if (adv_diff_el_pt!=0)
+    {
+     adv_diff_el_pt->pe_pt()=&Global_Parameters::Peclet;
+     adv_diff_el_pt->wind_fct_pt()=&Global_Parameters::wind_function;
+    }
+
+   PVDEquations<2>* solid_el_pt=dynamic_cast<PVDEquations<2>*>(el_pt);
+   if (solid_el_pt!=0)
+    {
+     solid_el_pt->constitutive_law_pt()=constitutive_law_pt;
+    }
+
+   FoepplvonKarmanEquations* fvk_el_pt=
+    dynamic_cast<FoepplvonKarmanEquations*>(el_pt);
+   if (fvk_el_pt!=0)
+    {
+     fvk_el_pt->eta_pt()=&Global_Parameters::Eta;
+    }
+  }
+
+ oomph_info << "Number of equations: " << assign_eqn_numbers() << std::endl;
+}
+
+
+
+//=====================================================================
+/// Assign (pseudo-)random values, scaled by the given factor and
+/// shifted by the given offset, to the entries of the vector
+//=====================================================================
+void fill_randomly(DoubleVector& vector, const double& factor,
+                   const double& offset)
+{
+ unsigned n_row=vector.nrow_local();
+ for (unsigned i=0;i<n_row;i++)
+  {
+   vector[i]=offset+factor*(double(rand())/double(RAND_MAX)-0.5);
+  }
+}
+
+
+
+//=====================================================================
+/// Perturb the dofs of the problem randomly (by a fraction of the size
+/// of the n x n elements, so that solid elements are not inverted) and
+/// compute the products of the Hessian with random vectors with finite
+/// differences and analytically. Document the differences and the
+/// timings.
+//=====================================================================
+void compare_hessian_products(const std::string& label, Problem& problem,
+                              const unsigned& n, std::ofstream& trace_file)
+{
+ // Perturb the dofs to move away from the (trivial) reference state
+ DoubleVector dofs;
+ problem.get_dofs(dofs);
+ DoubleVector perturbation(dofs.distribution_pt());
+ fill_randomly(perturbation,0.2/double(n),0.0);
+ dofs+=perturbation;
+ problem.set_dofs(dofs);
+
+ // The vectors
+ unsigned n_vec=2;
+ DoubleVectorWithHaloEntries Y(problem.dof_distribution_pt());
+ fill_randomly(Y,1.0,0.0);
+ Vector<DoubleVectorWithHaloEntries> C(n_vec);
+ for (unsigned i=0;i<n_vec;i++)
+  {
+   C[i].build(problem.dof_distribution_pt(),0.0);
+   fill_randomly(C[i],1.0,0.0);
+  }
+
+ // Compute the products by finite differences and analytically
+ Vector<DoubleVectorWithHaloEntries> product_fd(n_vec);
+ Vector<DoubleVectorWithHaloEntries> product(n_vec);
+ double t_fd=0.0;
+ double t_analytic=0.0;
+ for (unsigned analytic=0;analytic<2;analytic++)
+  {
+   if (analytic==0)
+    {
+     problem.unset_analytic_hessian_products();
+    }
+   else
+    {
+     problem.set_analytic_hessian_products();
+    }
+   double t_start=TimingHelpers::timer();
+   for (unsigned r=0;r<Global_Parameters::N_repeat;r++)
+    {
+     problem.get_hessian_vector_products(Y,C,
+                                         (analytic==0) ? product_fd : product);
+    }
+   double t=(TimingHelpers::timer()-t_start)/
+    double(Global_Parameters::N_repeat);
+   if (analytic==0)
+    {
+     t_fd=t;
+    }
+   else
+    {
+     t_analytic=t;
+    }
+  }
+
+ // Maximum difference relative to the largest entry
+ double max_diff=0.0;
+ double max_entry=0.0;
+ for (unsigned i=0;i<n_vec;i++)
+  {
+   unsigned n_row=product[i].nrow_local();
+   for (unsigned j=0;j<n_row;j++)
+    {
+     max_diff=std::max(max_diff,std::fabs(product[i][j]-product_fd[i][j]));
+     max_entry=std::max(max_entry,std::fabs(product_fd[i][j]));
+    }
+  }
+ double rel_diff=(max_entry>0.0) ? max_diff/max_entry : max_diff;
+
+ oomph_info << label << ": max. entry: " << max_entry
+            << "; (relative) difference: " << rel_diff
+            << "; time (FD): " << t_fd << " sec; time (analytic): "
+            << t_analytic << " sec" << std::endl;
+ trace_file << label << " " << max_entry << " " << rel_diff << " "
+            << t_fd << " " << t_analytic << std::endl;
+}
+
+
+
+//=====================================================================
+/// Driver
+//=====================================================================
+int main(int argc, char **argv)
+{
+ // Store command line arguments
+ CommandLineArgs::setup(argc,argv);
+
+ // Number of elements can be specified on the command line
+ CommandLineArgs::specify_command_line_flag(
+  "--n_element",&Global_Parameters::N_element);
+ CommandLineArgs::parse_and_assign();
+ CommandLineArgs::doc_specified_flags();
+
+ // Output for the results
+ std::ofstream trace_file("RESLT/trace.dat");
+ trace_file << "# element max_entry rel_diff t_fd t_analytic" << std::endl;
+
+ unsigned n=Global_Parameters::N_element;
+
+ // Poisson
+ {
+  HessianTestProblem<QPoissonElement<2,3>,
+   SimpleRectangularQuadMesh<QPoissonElement<2,3> > > problem(n);
+  compare_hessian_products("Poisson",problem,n,trace_file);
+ }
+
+ // Advection-diffusion
+ {
+  HessianTestProblem<QAdvectionDiffusionElement<2,3>,
+   SimpleRectangularQuadMesh<QAdvectionDiffusionElement<2,3> > >
+   problem(n);
+  compare_hessian_products("Advection_diffusion",problem,n,trace_file);
+ }
+
+ // Solid mechanics with a (generalised) Hookean constitutive law...
+ {
+  GeneralisedHookean constitutive_law(&Global_Parameters::Nu);
+  HessianTestProblem<QPVDElement<2,3>,
+   ElasticRectangularQuadMesh<QPVDElement<2,3> > >
+   problem(n/2,&constitutive_law);
+  compare_hessian_products("PVD_Hookean",problem,n/2,trace_file);
+ }
+
+ // ... and a generalised Mooney-Rivlin strain energy function
+ {
+  GeneralisedMooneyRivlin strain_energy_function(&Global_Parameters::Nu,
+                                                 &Global_Parameters::C1);
+  IsotropicStrainEnergyFunctionConstitutiveLaw
+   constitutive_law(&strain_energy_function);
+  HessianTestProblem<QPVDElement<2,3>,
+   ElasticRectangularQuadMesh<QPVDElement<2,3> > >
+   problem(n/2,&constitutive_law);
+  compare_hessian_products("PVD_Mooney_Rivlin",problem,n/2,trace_file);
+ }
+
+ // Foeppl-von Karman
+ {
+  HessianTestProblem<QFoepplvonKarmanElement<3>,
+   SimpleRectangularQuadMesh<QFoepplvonKarmanElement<3> > > problem(n/2);
+  compare_hessian_products("Foeppl_von_Karman",problem,n/2,trace_file);
+ }
+
+ trace_file.close();
+
+} // end of main
@@ -0,0 +1,238 @@
+//LIC// ====================================================================
+//LIC// This file forms part of oomph-lib, the object-oriented,
+//LIC// multi-physics finite-element library, available
+//LIC// at http://www.oomph-lib.org.
+//LIC//
+//LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+//LIC//
+//LIC// This library is free software; you can redistribute it and/or
+//LIC// modify it under the terms of the GNU Lesser General Public
+//LIC// License as published by the Free Software Foundation; either
+//LIC// version 2.1 of the License, or (at your option) any later version.
+//LIC//
+//LIC// This library is distributed in the hope that it will be useful,
+//LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+//LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//LIC// Lesser General Public License for more details.
+//LIC//
+//LIC// You should have received a copy of the GNU Lesser General Public
+//LIC// License along with this library; if not, write to the Free Software
+//LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+//LIC// 02110-1301  USA.
+//LIC//
+//LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+//LIC//
+//LIC//====================================================================
+// Arc-length continuation of the Bratu problem
+//
+//    div grad u + lambda exp(u) = 0   in the unit square, u=0 on its boundary
+//
+// around the fold at lambda=6.808..., with and without re-use of the
+// factorised Jacobian in the bordered Newton iteration of the continuation
+// steps. The continuation derivatives are computed from the last Newton
+// step or by finite differences between the last two points on the branch
+// (secant predictor). Re-using the factorisation only pays off on meshes
+// that are fine enough for the factorisation to dominate the assembly
+// (try --n_element 128).
+
+//Oomph-lib includes
+#include "generic.h"
+#include "advection_diffusion_reaction.h"
+
+// The mesh
+#include "meshes/simple_rectangular_quadmesh.h"
+
+using namespace std;
+using namespace oomph;
+
+
+//==start_of_namespace====================================================
+/// Namespace for the problem parameters
+//========================================================================
+namespace Global_Parameters
+{
+ /// Number of elements in each coordinate direction
+ unsigned N_element=32;
+
+ /// Number of continuation steps
+ unsigned N_step=30;
+
+ /// Max. arc-length step (larger steps jump between the branches)
+ double Ds_max=0.5;
+
+ /// The (continuation) parameter
+ double Lambda=0.0;
+
+ /// Reaction term: the equations are div grad u = R(u)
+ void reaction_function(const Vector<double>& c, Vector<double>& r)
+ {
+  r[0]=-Lambda*exp(c[0]);
+ }
+
+ /// Derivative of the reaction term w.r.t. the unknown
+ void reaction_derivative_function(const Vector<double>& c,
+                                   DenseMatrix<double>& drdc)
+ {
+  drdc(0,0)=-Lambda*exp(c[0]);
+ }
+
+} // end of namespace
+
+
+
+//=====================================================================
+/// Bratu problem on the unit square
+//=====================================================================
+template<class ELEMENT>
+class BratuProblem : public Problem
+{
+
+public:
+
+ /// Constructor: Pass number of elements in each coordinate direction,
+ /// whether the factorised Jacobian is to be re-used in the continuation
+ /// steps and whether the continuation derivatives are to be computed
+ /// by finite differences
+ BratuProblem(const unsigned& n,
+              const bool& reuse_jacobian,
+              const bool& use_fd_derivatives);
+
+ /// Max. nodal value
+ double max_value()
+  {
+   double u_max=0.0;
+   unsigned n_node=mesh_pt()->nnode();
+   for (unsigned j=0;j<n_node;j++)
+    {
+     u_max=std::max(u_max,mesh_pt()->node_pt(j)->value(0));
+    }
+   return u_max;
+  }
+
+}; // end of BratuProblem
+
+
+
+//=====================================================================
+/// Constructor
+//=====================================================================
+template<class ELEMENT>
+BratuProblem<ELEMENT>::BratuProblem(const unsigned& n,
+                                    const bool& reuse_jacobian,
+                                    const bool& use_fd_derivatives)
+{
+ Problem::mesh_pt()=new SimpleRectangularQuadMesh<ELEMENT>(n,n,1.0,1.0);
+
+ // Homogeneous Dirichlet conditions on all boundaries
+ unsigned n_bound=mesh_pt()->nboundary();
+ for (unsigned b=0;b<n_bound;b++)
+  {
+   unsigned n_node=mesh_pt()->nboundary_node(b);
+   for (unsigned j=0;j<n_node;j++)
+    {
+     mesh_pt()->boundary_node_pt(b,j)->pin(0);
+    }
+  }
+
+ // Set the reaction terms
+ unsigned n_element=mesh_pt()->nelement();
+ for (unsigned e=0;e<n_element;e++)
+  {
+   ELEMENT* el_pt=dynamic_cast<ELEMENT*>(mesh_pt()->element_pt(e));
+   el_pt->reaction_fct_pt()=&Global_Parameters::reaction_function;
+   el_pt->reaction_deriv_fct_pt()=
+    &Global_Parameters::reaction_derivative_function;
+  }
+
+ // The iteration with the re-used Jacobian takes more (cheaper) steps
+ if (reuse_jacobian)
+  {
+   enable_jacobian_reuse_in_continuation();
+   Desired_newton_iterations_ds=6;
+   Max_newton_iterations=20;
+  }
+ Use_finite_differences_for_continuation_derivatives=use_fd_derivatives;
+
+ oomph_info << "Bratu problem: " << assign_eqn_numbers()
+            << " dofs" << std::endl;
+}
+
+
+
+//=====================================================================
+/// Follow the branch from lambda=0 around the fold; doc the solution
+/// at each step and the phase timings of the sweep
+//=====================================================================
+void run(const std::string& label,
+         const bool& reuse_jacobian,
+         const bool& use_fd_derivatives,
+         std::ofstream& trace_file)
+{
+ Global_Parameters::Lambda=0.0;
+ BratuProblem<QAdvectionDiffusionReactionElement<1,2,3> >
+  problem(Global_Parameters::N_element,reuse_jacobian,use_fd_derivatives);
+ problem.newton_solver_tolerance()=1.0e-10;
+
+ // Solution at lambda=0 is trivial
+ problem.steady_newton_solve();
+
+ PhaseTimings::reset();
+ PhaseTimings::Record_phase_timings=true;
+ double t_start=TimingHelpers::timer();
+
+ trace_file << "# " << label << ": lambda u_max" << std::endl;
+ double ds=0.5;
+ for (unsigned i=0;i<Global_Parameters::N_step;i++)
+  {
+   ds=problem.arc_length_step_solve(&Global_Parameters::Lambda,ds);
+   ds=std::min(ds,Global_Parameters::Ds_max);
+   trace_file << Global_Parameters::Lambda << " "
+              << problem.max_value() << std::endl;
+  }
+ trace_file << std::endl;
+
+ double t_sweep=TimingHelpers::timer()-t_start;
+ PhaseTimings::Record_phase_timings=false;
+
+ oomph_info << label << ": reached lambda=" << Global_Parameters::Lambda
+            << ", u_max=" << problem.max_value() << " after "
+            << Global_Parameters::N_step << " steps in " << t_sweep
+            << " sec" << std::endl;
+ PhaseTimings::doc(*(oomph_info.stream_pt()));
+}
+
+
+
+//=====================================================================
+/// Driver
+//=====================================================================
+int main(int argc, char **argv)
+{
+ // Store command line arguments
+ CommandLineArgs::setup(argc,argv);
+
+ // Number of elements can be specified on the command line
+ CommandLineArgs::specify_command_line_flag(
+  "--n_element",&Global_Parameters::N_element);
+
+ // Number of continuation steps
+ CommandLineArgs::specify_command_line_flag(
+  "--n_step",&Global_Parameters::N_step);
+
+ CommandLineArgs::parse_and_assign();
+ CommandLineArgs::doc_specified_flags();
+
+ std::ofstream trace_file("RESLT/trace.dat");
+
+ // Full Newton iteration for the bordered system
+ run("full_newton",false,false,trace_file);
+
+ // Secant predictor
+ run("secant",false,true,trace_file);
+
+ // Secant predictor and re-use of the factorised Jacobian
+ run("secant_jacobian_reuse",true,true,trace_file);
+
+ trace_file.close();
+
+} // end of main
@@ -0,0 +1,229 @@
+//LIC// ====================================================================
+//LIC// This file forms part of oomph-lib, the object-oriented,
+//LIC// multi-physics finite-element library, available
+//LIC// at http://www.oomph-lib.org.
+//LIC//
+//LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+//LIC//
+//LIC// This library is free software; you can redistribute it and/or
+//LIC// modify it under the terms of the GNU Lesser General Public
+//LIC// License as published by the Free Software Foundation; either
+//LIC// version 2.1 of the License, or (at your option) any later version.
+//LIC//
+//LIC// This library is distributed in the hope that it will be useful,
+//LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+//LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//LIC// Lesser General Public License for more details.
+//LIC//
+//LIC// You should have received a copy of the GNU Lesser General Public
+//LIC// License along with this library; if not, write to the Free Software
+//LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+//LIC// 02110-1301  USA.
+//LIC//
+//LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+//LIC//
+//LIC//====================================================================
+// Eigenvalues of the advection-diffusion operator
+//
+//    Pe w.grad u - div grad u = - lambda u  in the unit square,
+//
+// with u=0 on the boundary, computed by the KrylovSchur eigensolver
+// during a scan through the Peclet number and two shifts. The solver
+// re-uses the factorisation of the shifted matrix when the shift and
+// the sparsity pattern are unchanged (with iterative refinement if the
+// Peclet number has changed) and the symbolic factorisation if only the
+// pattern is unchanged. The eigenvalues are compared against those
+// computed by the dense QZ solver.
+
+//Generic routines
+#include "generic.h"
+
+// The equations
+#include "advection_diffusion.h"
+
+// The mesh
+#include "meshes/simple_rectangular_quadmesh.h"
+
+using namespace std;
+using namespace oomph;
+
+
+//==start_of_namespace====================================================
+/// Namespace for the problem parameters
+//========================================================================
+namespace Global_Parameters
+{
+ /// Peclet number
+ double Peclet=0.0;
+
+ /// Peclet number multiplied by Strouhal number (scales the mass matrix)
+ double Peclet_St=1.0;
+
+ /// Wind
+ void wind_function(const Vector<double>& x, Vector<double>& wind)
+ {
+  wind[0]=1.0;
+  wind[1]=0.5;
+ }
+
+} // end of namespace
+
+
+
+//=====================================================================
+/// Advection-diffusion eigenproblem on the unit square
+//=====================================================================
+template<class ELEMENT>
+class AdvectionDiffusionEigenProblem : public Problem
+{
+
+public:
+
+ /// Constructor: Pass number of elements in each coordinate direction
+ AdvectionDiffusionEigenProblem(const unsigned& n);
+
+}; // end of AdvectionDiffusionEigenProblem
+
+
+
+//=====================================================================
+/// Constructor
+//=====================================================================
+template<class ELEMENT>
+AdvectionDiffusionEigenProblem<ELEMENT>::AdvectionDiffusionEigenProblem(
+ const unsigned& n)
+{
+ Problem::mesh_pt()=new SimpleRectangularQuadMesh<ELEMENT>(n,n,1.0,1.0);
+
+ // Homogeneous Dirichlet conditions on all boundaries
+ unsigned n_bound=mesh_pt()->nboundary();
+ for (unsigned b=0;b<n_bound;b++)
+  {
+   unsigned n_node=mesh_pt()->nboundary_node(b);
+   for (unsigned j=0;j<n_node;j++)
+    {
+     mesh_pt()->boundary_node_pt(b,j)->pin(0);
+    }
+  }
+
+ // Set the parameters
+ unsigned n_element=mesh_pt()->nelement();
+ for (unsigned e=0;e<n_element;e++)
+  {
+   ELEMENT* el_pt=dynamic_cast<ELEMENT*>(mesh_pt()->element_pt(e));
+   el_pt->pe_pt()=&Global_Parameters::Peclet;
+   el_pt->pe_st_pt()=&Global_Parameters::Peclet_St;
+   el_pt->wind_fct_pt()=&Global_Parameters::wind_function;
+  }
+
+ oomph_info << "Number of equations: " << assign_eqn_numbers() << std::endl;
+}
+
+
+
+//=====================================================================
+/// Compute n_eval eigenvalues with the KrylovSchur solver and return
+/// the max. difference to the ones closest to the shift that are
+/// computed by the QZ solver
+//=====================================================================
+double compare_with_qz(Problem& problem,
+                       KrylovSchur& krylov_schur,
+                       const unsigned& n_eval,
+                       const double& shift)
+{
+ // Krylov-Schur (returns the eigenvalues sorted by their distance from
+ // the shift)
+ Vector<std::complex<double> > eigenvalue;
+ krylov_schur.set_shift(shift);
+ problem.eigen_solver_pt()=&krylov_schur;
+ problem.solve_eigenproblem(n_eval,eigenvalue);
+
+ // All eigenvalues from QZ
+ LAPACK_QZ qz;
+ Vector<std::complex<double> > qz_eigenvalue;
+ problem.eigen_solver_pt()=&qz;
+ problem.solve_eigenproblem(problem.ndof(),qz_eigenvalue);
+
+ // Sort them by their distance from the shift
+ unsigned n_qz=qz_eigenvalue.size();
+ Vector<std::pair<double,unsigned> > sort_key(n_qz);
+ for (unsigned i=0;i<n_qz;i++)
+  {
+   sort_key[i]=std::make_pair(std::abs(qz_eigenvalue[i]-shift),i);
+  }
+ std::sort(sort_key.begin(),sort_key.end());
+
+ // The eigenvalues come in complex conjugate pairs so compare each
+ // Krylov-Schur eigenvalue with the closest of the wanted QZ ones
+ double max_diff=0.0;
+ for (unsigned i=0;i<n_eval;i++)
+  {
+   double diff=DBL_MAX;
+   for (unsigned k=0;k<n_eval;k++)
+    {
+     diff=std::min(diff,std::abs(eigenvalue[i]-
+                                 qz_eigenvalue[sort_key[k].second]));
+    }
+   max_diff=std::max(max_diff,diff/std::abs(eigenvalue[i]));
+  }
+
+ oomph_info << "Pe=" << Global_Parameters::Peclet << ", shift=" << shift
+            << ": factorisation re-used: "
+            << krylov_schur.factorisation_was_reused()
+            << ", symbolic factorisation re-used: "
+            << krylov_schur.symbolic_factorisation_was_reused()
+            << ", refinement steps: "
+            << krylov_schur.nrefinement_iteration()
+            << ", max. rel. difference to QZ: " << max_diff << std::endl;
+
+ return max_diff;
+}
+
+
+
+//=====================================================================
+/// Driver
+//=====================================================================
+int main()
+{
+ AdvectionDiffusionEigenProblem<QAdvectionDiffusionElement<2,3> >
+  problem(8);
+
+ KrylovSchur krylov_schur;
+ unsigned n_eval=4;
+ double tol=1.0e-8;
+
+ std::ofstream trace_file("RESLT/trace.dat");
+
+ // First call: factorise
+ double shift=-10.0;
+ double diff=compare_with_qz(problem,krylov_schur,n_eval,shift);
+ trace_file << (diff<tol) << " "
+            << krylov_schur.factorisation_was_reused() << " "
+            << krylov_schur.symbolic_factorisation_was_reused() << std::endl;
+
+ // Same shift and matrix: re-use the factorisation (the refinement
+ // converges immediately)
+ diff=compare_with_qz(problem,krylov_schur,n_eval,shift);
+ trace_file << (diff<tol) << " "
+            << krylov_schur.factorisation_was_reused() << " "
+            << krylov_schur.nrefinement_iteration() << std::endl;
+
+ // Same shift and pattern but a different Peclet number: re-use the
+ // factorisation of the previous matrix, with iterative refinement
+ Global_Parameters::Peclet=0.5;
+ diff=compare_with_qz(problem,krylov_schur,n_eval,shift);
+ trace_file << (diff<tol) << " "
+            << krylov_schur.factorisation_was_reused() << " "
+            << (krylov_schur.nrefinement_iteration()>0) << std::endl;
+
+ // New shift: re-factorise but re-use the symbolic factorisation
+ shift=-40.0;
+ diff=compare_with_qz(problem,krylov_schur,n_eval,shift);
+ trace_file << (diff<tol) << " "
+            << krylov_schur.factorisation_was_reused() << " "
+            << krylov_schur.symbolic_factorisation_was_reused() << std::endl;
+
+ trace_file.close();
+
+} // end of main
@@ -0,0 +1,220 @@
+//LIC// ====================================================================
+//LIC// This file forms part of oomph-lib, the object-oriented,
+//LIC// multi-physics finite-element library, available
+//LIC// at http://www.oomph-lib.org.
+//LIC//
+//LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+//LIC//
+//LIC// This library is free software; you can redistribute it and/or
+//LIC// modify it under the terms of the GNU Lesser General Public
+//LIC// License as published by the Free Software Foundation; either
+//LIC// version 2.1 of the License, or (at your option) any later version.
+//LIC//
+//LIC// This library is distributed in the hope that it will be useful,
+//LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+//LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//LIC// Lesser General Public License for more details.
+//LIC//
+//LIC// You should have received a copy of the GNU Lesser General Public
+//LIC// License along with this library; if not, write to the Free Software
+//LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+//LIC// 02110-1301  USA.
+//LIC//
+//LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+//LIC//
+//LIC//====================================================================
+// Check the native algebraic multigrid (AMG) preconditioner for the
+// Jacobians of 2D Poisson problems of increasing size:
+// (i)  the V-cycle, used as a stationary iteration, must reduce the
+//      residual by a factor that stays well below one as the mesh is
+//      refined, and
+// (ii) CG, preconditioned by the V-cycle, must reproduce the solution
+//      obtained with a direct solver in a number of iterations that
+//      is (almost) independent of the mesh size.
+
+//Oomph-lib includes
+#include "generic.h"
+#include "poisson.h"
+
+// The mesh
+#include "meshes/simple_rectangular_quadmesh.h"
+
+using namespace std;
+using namespace oomph;
+
+
+//==start_of_namespace====================================================
+/// Namespace for the problem parameters
+//========================================================================
+namespace Global_Parameters
+{
+ /// Constant source function for the Poisson problem
+ void source_function(const Vector<double>& x, double& source)
+ {
+  source=-1.0;
+ }
+
+} // end of namespace
+
+
+
+//=====================================================================
+/// Poisson problem on the unit square with homogeneous Dirichlet
+/// conditions
+//=====================================================================
+template<class ELEMENT>
+class PoissonProblem : public Problem
+{
+
+public:
+
+ /// Constructor: Pass number of elements in each coordinate direction
+ PoissonProblem(const unsigned& n)
+  {
+   Problem::mesh_pt()=new SimpleRectangularQuadMesh<ELEMENT>(n,n,1.0,1.0);
+
+   // Pin the boundary values
+   unsigned n_bound=mesh_pt()->nboundary();
+   for (unsigned b=0;b<n_bound;b++)
+    {
+     unsigned n_node=mesh_pt()->nboundary_node(b);
+     for (unsigned j=0;j<n_node;j++)
+      {
+       mesh_pt()->boundary_node_pt(b,j)->pin(0);
+      }
+    }
+
+   // Set the source function
+   unsigned n_element=mesh_pt()->nelement();
+   for (unsigned e=0;e<n_element;e++)
+    {
+     ELEMENT* el_pt=dynamic_cast<ELEMENT*>(mesh_pt()->element_pt(e));
+     el_pt->source_fct_pt()=&Global_Parameters::source_function;
+    }
+
+   oomph_info << "Poisson problem: " << assign_eqn_numbers()
+              << " dofs" << std::endl;
+  }
+
+}; // end of PoissonProblem
+
+
+
+//=====================================================================
+/// Check the AMG preconditioner pointed to by prec_pt for the given
+/// matrix and right hand side; x_ref is the direct solution.
+//=====================================================================
+void check_amg(const std::string& label,
+               AMGPreconditioner* prec_pt,
+               CRDoubleMatrix& matrix,
+               const DoubleVector& rhs,
+               const DoubleVector& x_ref,
+               std::ofstream& trace_file)
+{
+ prec_pt->disable_doc_time();
+
+ // Preconditioned CG (this sets up the preconditioner)
+ CG<CRDoubleMatrix> solver;
+ solver.tolerance()=1.0e-10;
+ solver.max_iter()=200;
+ solver.disable_doc_time();
+ solver.preconditioner_pt()=prec_pt;
+ DoubleVector x;
+ solver.solve(&matrix,rhs,x);
+ x-=x_ref;
+ double diff=x.norm()/x_ref.norm();
+
+ // Stationary iteration x <- x + M^{-1} (b - A x), starting from x=0;
+ // the average residual reduction per V-cycle is the convergence factor
+ unsigned n_cycle=10;
+ x.initialise(0.0);
+ DoubleVector residual(rhs);
+ double initial_residual_norm=residual.norm();
+ for (unsigned k=0;k<n_cycle;k++)
+  {
+   DoubleVector correction;
+   prec_pt->preconditioner_solve(residual,correction);
+   x+=correction;
+   matrix.residual(x,rhs,residual);
+  }
+ double convergence_factor=
+  pow(residual.norm()/initial_residual_norm,1.0/double(n_cycle));
+
+ oomph_info << label << ": " << prec_pt->nlevel() << " levels; "
+            << "operator complexity: " << prec_pt->operator_complexity()
+            << "; convergence factor: " << convergence_factor
+            << "; CG iterations: " << solver.iterations()
+            << "; rel. difference to direct solution: " << diff
+            << std::endl;
+ trace_file << label << " " << (convergence_factor<0.8) << " "
+            << (solver.iterations()<25) << " " << (diff<1.0e-8)
+            << std::endl;
+}
+
+
+
+//=====================================================================
+/// Driver: Check the AMG preconditioner with smoothed aggregation and
+/// classical coarsening, and with Gauss-Seidel and Jacobi smoothing,
+/// for Poisson problems of increasing size
+//=====================================================================
+int main(int argc, char **argv)
+{
+ // Store command line arguments
+ CommandLineArgs::setup(argc,argv);
+
+ // Output for the results
+ std::ofstream trace_file("RESLT/trace.dat");
+ trace_file << "# n_element coarsening_smoother convergence_factor_below_0.8 "
+            << "less_than_25_cg_iterations agrees_with_direct_solution"
+            << std::endl;
+
+ for (unsigned n=16;n<=64;n*=2)
+  {
+   PoissonProblem<QPoissonElement<2,3> > problem(n);
+   DoubleVector rhs;
+   CRDoubleMatrix jacobian;
+   problem.get_jacobian(rhs,jacobian);
+
+   // Reference solution from the direct solver
+   DoubleVector x_ref;
+   SuperLUSolver direct_solver;
+   direct_solver.disable_doc_time();
+   direct_solver.solve(&jacobian,rhs,x_ref);
+
+   std::ostringstream label;
+   label << n << " ";
+
+   {
+    AMGPreconditioner prec;
+    check_amg(label.str()+"aggregation_GS",&prec,jacobian,rhs,x_ref,
+              trace_file);
+
+    // Set up the preconditioner again for the same matrix: the
+    // coarsening must be re-used
+    Preconditioner* prec_pt=&prec;
+    prec_pt->setup(&jacobian);
+    oomph_info << "Coarsening re-used: " << prec.coarsening_was_reused()
+               << std::endl;
+    trace_file << label.str() << "coarsening_reused "
+               << prec.coarsening_was_reused() << std::endl;
+   }
+   {
+    AMGPreconditioner prec;
+    prec.use_jacobi_smoother();
+    prec.npre_smooth()=2;
+    prec.npost_smooth()=2;
+    check_amg(label.str()+"aggregation_Jacobi",&prec,jacobian,rhs,x_ref,
+              trace_file);
+   }
+   {
+    AMGPreconditioner prec;
+    prec.use_classical_coarsening();
+    check_amg(label.str()+"classical_GS",&prec,jacobian,rhs,x_ref,
+              trace_file);
+   }
+  }
+
+ trace_file.close();
+
+} // end of main
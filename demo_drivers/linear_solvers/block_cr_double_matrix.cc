@@ -0,0 +1,228 @@
+//LIC// ====================================================================
+//LIC// This file forms part of oomph-lib, the object-oriented,
+//LIC// multi-physics finite-element library, available
+//LIC// at http://www.oomph-lib.org.
+//LIC//
+//LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+//LIC//
+//LIC// This library is free software; you can redistribute it and/or
+//LIC// modify it under the terms of the GNU Lesser General Public
+//LIC// License as published by the Free Software Foundation; either
+//LIC// version 2.1 of the License, or (at your option) any later version.
+//LIC//
+//LIC// This library is distributed in the hope that it will be useful,
+//LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+//LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//LIC// Lesser General Public License for more details.
+//LIC//
+//LIC// You should have received a copy of the GNU Lesser General Public
+//LIC// License along with this library; if not, write to the Free Software
+//LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+//LIC// 02110-1301  USA.
+//LIC//
+//LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+//LIC//
+//LIC//====================================================================
+// Solve the linear systems arising from a 2D linear elasticity problem
+// with iterative solvers that use the Jacobian in block compressed row
+// (BlockCRDoubleMatrix) and in compressed row (CRDoubleMatrix) storage,
+// and compare the results against those obtained with a direct solver.
+// The nodal blocks are aligned if the displacements are either fully
+// pinned or fully free at all nodes; we also consider the case in
+// which some nodes are only partially pinned.
+
+//Oomph-lib includes
+#include "generic.h"
+#include "linear_elasticity.h"
+
+// The mesh
+#include "meshes/simple_rectangular_quadmesh.h"
+
+using namespace std;
+using namespace oomph;
+
+
+//==start_of_namespace====================================================
+/// Namespace for the problem parameters
+//========================================================================
+namespace Global_Parameters
+{
+ /// Number of elements in each coordinate direction
+ unsigned N_element=32;
+
+ /// The elasticity tensor (Poisson's ratio 0.3)
+ IsotropicElasticityTensor E(0.3);
+
+} // end of namespace
+
+
+
+//=====================================================================
+/// Linear elasticity problem on the unit square. The bottom boundary
+/// is clamped; if requested, the horizontal displacement is also
+/// suppressed on the left boundary.
+//=====================================================================
+template<class ELEMENT>
+class ElasticityProblem : public Problem
+{
+
+public:
+
+ /// Constructor: Pass number of elements in each coordinate direction
+ /// and flag that indicates if the left boundary is on rollers
+ ElasticityProblem(const unsigned& n, const bool& rollers)
+  {
+   Problem::mesh_pt()=new SimpleRectangularQuadMesh<ELEMENT>(n,n,1.0,1.0);
+
+   // Clamp the bottom boundary (boundary 0)
+   unsigned n_node=mesh_pt()->nboundary_node(0);
+   for (unsigned j=0;j<n_node;j++)
+    {
+     mesh_pt()->boundary_node_pt(0,j)->pin(0);
+     mesh_pt()->boundary_node_pt(0,j)->pin(1);
+    }
+
+   // Put the left boundary (boundary 3) on rollers
+   if (rollers)
+    {
+     n_node=mesh_pt()->nboundary_node(3);
+     for (unsigned j=0;j<n_node;j++)
+      {
+       mesh_pt()->boundary_node_pt(3,j)->pin(0);
+      }
+    }
+
+   // Set the elasticity tensor
+   unsigned n_element=mesh_pt()->nelement();
+   for (unsigned e=0;e<n_element;e++)
+    {
+     ELEMENT* el_pt=dynamic_cast<ELEMENT*>(mesh_pt()->element_pt(e));
+     el_pt->elasticity_tensor_pt()=&Global_Parameters::E;
+    }
+
+   oomph_info << "Linear elasticity problem: " << assign_eqn_numbers()
+              << " dofs" << std::endl;
+  }
+
+}; // end of ElasticityProblem
+
+
+
+//=====================================================================
+/// Solve the linear system with the iterative solver pointed to by
+/// solver_pt and document the number of iterations and the relative
+/// difference to the reference solution x_ref.
+//=====================================================================
+void check_solver(const std::string& label,
+                  IterativeLinearSolver* solver_pt,
+                  DoubleMatrixBase* matrix_pt,
+                  const DoubleVector& rhs,
+                  const DoubleVector& x_ref,
+                  std::ofstream& trace_file)
+{
+ solver_pt->tolerance()=1.0e-10;
+ solver_pt->max_iter()=2000;
+ solver_pt->disable_doc_time();
+
+ DoubleVector x;
+ solver_pt->solve(matrix_pt,rhs,x);
+ x-=x_ref;
+ double diff=x.norm()/x_ref.norm();
+
+ oomph_info << label << ": " << solver_pt->iterations()
+            << " iterations; rel. difference to direct solution: "
+            << diff << std::endl;
+ trace_file << label << " " << (diff<1.0e-6) << std::endl;
+}
+
+
+
+//=====================================================================
+/// Driver: Compare the solutions of the linear elasticity problems
+/// obtained with iterative solvers for block compressed row and compressed
+/// row matrices with the direct solution
+//=====================================================================
+int main(int argc, char **argv)
+{
+ // Store command line arguments
+ CommandLineArgs::setup(argc,argv);
+
+ // Number of elements can be specified on the command line
+ CommandLineArgs::specify_command_line_flag(
+  "--n_element",&Global_Parameters::N_element);
+ CommandLineArgs::parse_and_assign();
+ CommandLineArgs::doc_specified_flags();
+
+ // Output for the results
+ std::ofstream trace_file("RESLT/trace.dat");
+ trace_file << "# case solver agrees_with_direct_solution "
+            << "(or number of blocks)" << std::endl;
+
+ for (unsigned rollers=0;rollers<2;rollers++)
+  {
+   std::string label=(rollers==0) ? "Clamped" : "Rollers";
+   ElasticityProblem<QLinearElasticityElement<2,3> >
+    problem(Global_Parameters::N_element,rollers);
+
+   // Get the Jacobian in both formats
+   DoubleVector residuals;
+   CRDoubleMatrix cr_jacobian;
+   problem.get_jacobian(residuals,cr_jacobian);
+   BlockCRDoubleMatrix block_jacobian(2);
+   problem.get_jacobian(residuals,block_jacobian);
+
+   // Number of values stored (including the explicitly stored zeros)
+   // relative to the compressed row format
+   double fill_ratio=double(block_jacobian.nnz())/double(cr_jacobian.nnz());
+   oomph_info << label << ": values stored in block compressed row format "
+              << "relative to compressed row format: " << fill_ratio
+              << std::endl;
+   trace_file << label << " nnz_block " << block_jacobian.nnz_block()
+              << std::endl;
+
+   // The residuals vanish for this problem: use a constant right hand
+   // side instead
+   DoubleVector rhs(residuals.distribution_pt(),1.0);
+
+   // Reference solution from the direct solver
+   DoubleVector x_ref;
+   SuperLUSolver direct_solver;
+   direct_solver.disable_doc_time();
+   direct_solver.solve(&cr_jacobian,rhs,x_ref);
+
+   // Unpreconditioned CG
+   {
+    CG<CRDoubleMatrix> solver;
+    check_solver(label+" CG<CRDoubleMatrix>",&solver,&cr_jacobian,
+                 rhs,x_ref,trace_file);
+   }
+   {
+    CG<BlockCRDoubleMatrix> solver;
+    check_solver(label+" CG<BlockCRDoubleMatrix>",&solver,&block_jacobian,
+                 rhs,x_ref,trace_file);
+   }
+
+   // GMRES, preconditioned by ILU(0). The preconditioner requires the
+   // compressed row matrix so it is set up (once) before the solves
+   Preconditioner* prec_pt=new ILUZeroPreconditioner<CRDoubleMatrix>;
+   prec_pt->setup(&cr_jacobian);
+   {
+    GMRES<CRDoubleMatrix> solver;
+    solver.preconditioner_pt()=prec_pt;
+    solver.disable_setup_preconditioner_before_solve();
+    check_solver(label+" GMRES<CRDoubleMatrix>",&solver,&cr_jacobian,
+                 rhs,x_ref,trace_file);
+   }
+   {
+    GMRES<BlockCRDoubleMatrix> solver;
+    solver.preconditioner_pt()=prec_pt;
+    solver.disable_setup_preconditioner_before_solve();
+    check_solver(label+" GMRES<BlockCRDoubleMatrix>",&solver,
+                 &block_jacobian,rhs,x_ref,trace_file);
+   }
+   delete prec_pt;
+  }
+
+ trace_file.close();
+
+} // end of main
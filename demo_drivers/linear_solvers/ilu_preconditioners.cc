@@ -0,0 +1,267 @@
+//LIC// ====================================================================
+//LIC// This file forms part of oomph-lib, the object-oriented,
+//LIC// multi-physics finite-element library, available
+//LIC// at http://www.oomph-lib.org.
+//LIC//
+//LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+//LIC//
+//LIC// This library is free software; you can redistribute it and/or
+//LIC// modify it under the terms of the GNU Lesser General Public
+//LIC// License as published by the Free Software Foundation; either
+//LIC// version 2.1 of the License, or (at your option) any later version.
+//LIC//
+//LIC// This library is distributed in the hope that it will be useful,
+//LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+//LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//LIC// Lesser General Public License for more details.
+//LIC//
+//LIC// You should have received a copy of the GNU Lesser General Public
+//LIC// License along with this library; if not, write to the Free Software
+//LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+//LIC// 02110-1301  USA.
+//LIC//
+//LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+//LIC//
+//LIC//====================================================================
+// Check the incomplete LU preconditioners ILU(k) and ILUT for the
+// Jacobian of a 2D Poisson problem: GMRES, preconditioned by the
+// incomplete factorisations, must reproduce the solution obtained with
+// a direct solver, and the number of iterations must not increase as
+// more fill is retained. ILU(0) must agree with ILUZeroPreconditioner,
+// and the level-scheduled and sequential triangular solves must agree.
+
+//Oomph-lib includes
+#include "generic.h"
+#include "poisson.h"
+
+// The mesh
+#include "meshes/simple_rectangular_quadmesh.h"
+
+using namespace std;
+using namespace oomph;
+
+
+//==start_of_namespace====================================================
+/// Namespace for the problem parameters
+//========================================================================
+namespace Global_Parameters
+{
+ /// Number of elements in each coordinate direction
+ unsigned N_element=32;
+
+ /// Constant source function for the Poisson problem
+ void source_function(const Vector<double>& x, double& source)
+ {
+  source=-1.0;
+ }
+
+} // end of namespace
+
+
+
+//=====================================================================
+/// Poisson problem on the unit square with homogeneous Dirichlet
+/// conditions
+//=====================================================================
+template<class ELEMENT>
+class PoissonProblem : public Problem
+{
+
+public:
+
+ /// Constructor: Pass number of elements in each coordinate direction
+ PoissonProblem(const unsigned& n)
+  {
+   Problem::mesh_pt()=new SimpleRectangularQuadMesh<ELEMENT>(n,n,1.0,1.0);
+
+   // Pin the boundary values
+   unsigned n_bound=mesh_pt()->nboundary();
+   for (unsigned b=0;b<n_bound;b++)
+    {
+     unsigned n_node=mesh_pt()->nboundary_node(b);
+     for (unsigned j=0;j<n_node;j++)
+      {
+       mesh_pt()->boundary_node_pt(b,j)->pin(0);
+      }
+    }
+
+   // Set the source function
+   unsigned n_element=mesh_pt()->nelement();
+   for (unsigned e=0;e<n_element;e++)
+    {
+     ELEMENT* el_pt=dynamic_cast<ELEMENT*>(mesh_pt()->element_pt(e));
+     el_pt->source_fct_pt()=&Global_Parameters::source_function;
+    }
+
+   oomph_info << "Poisson problem: " << assign_eqn_numbers()
+              << " dofs" << std::endl;
+  }
+
+}; // end of PoissonProblem
+
+
+
+//=====================================================================
+/// Solve the linear system with GMRES, preconditioned by the
+/// preconditioner pointed to by prec_pt; document the number of
+/// iterations and check the solution against the direct solution x_ref.
+/// Returns the number of iterations.
+//=====================================================================
+unsigned check_preconditioner(const std::string& label,
+                              Preconditioner* prec_pt,
+                              CRDoubleMatrix& matrix,
+                              const DoubleVector& rhs,
+                              const DoubleVector& x_ref,
+                              std::ofstream& trace_file)
+{
+ GMRES<CRDoubleMatrix> solver;
+ solver.tolerance()=1.0e-10;
+ solver.max_iter()=1000;
+ solver.set_preconditioner_RHS();
+ solver.preconditioner_pt()=prec_pt;
+ solver.disable_doc_time();
+
+ DoubleVector x;
+ solver.solve(&matrix,rhs,x);
+ x-=x_ref;
+ double diff=x.norm()/x_ref.norm();
+
+ oomph_info << label << ": " << solver.iterations()
+            << " iterations; rel. difference to direct solution: "
+            << diff << std::endl;
+ trace_file << label << " " << (diff<1.0e-8) << std::endl;
+
+ return solver.iterations();
+}
+
+
+
+//=====================================================================
+/// Return the max. relative difference between the results of
+/// applying two preconditioners (that have been set up) to a vector
+//=====================================================================
+double max_difference(Preconditioner* prec1_pt,
+                      Preconditioner* prec2_pt,
+                      const DoubleVector& r)
+{
+ DoubleVector z1;
+ prec1_pt->preconditioner_solve(r,z1);
+ DoubleVector z2;
+ prec2_pt->preconditioner_solve(r,z2);
+ z2-=z1;
+ return z2.norm()/z1.norm();
+}
+
+
+
+//=====================================================================
+/// Driver: Check the ILU(k) and ILUT preconditioners
+//=====================================================================
+int main(int argc, char **argv)
+{
+ // Store command line arguments
+ CommandLineArgs::setup(argc,argv);
+
+ // Number of elements can be specified on the command line
+ CommandLineArgs::specify_command_line_flag(
+  "--n_element",&Global_Parameters::N_element);
+ CommandLineArgs::parse_and_assign();
+ CommandLineArgs::doc_specified_flags();
+
+ // Output for the results
+ std::ofstream trace_file("RESLT/trace.dat");
+ trace_file << "# preconditioner agrees_with_direct_solution (or check)"
+            << std::endl;
+
+ PoissonProblem<QPoissonElement<2,3> > problem(Global_Parameters::N_element);
+ DoubleVector rhs;
+ CRDoubleMatrix jacobian;
+ problem.get_jacobian(rhs,jacobian);
+
+ // Reference solution from the direct solver
+ DoubleVector x_ref;
+ SuperLUSolver direct_solver;
+ direct_solver.disable_doc_time();
+ direct_solver.solve(&jacobian,rhs,x_ref);
+
+ // ILU(k): the number of iterations must not increase with the fill
+ // level
+ unsigned n_iter_previous=0;
+ bool iterations_decrease=true;
+ for (unsigned k=0;k<3;k++)
+  {
+   ILUKPreconditioner prec(k);
+   std::ostringstream label;
+   label << "ILU(" << k << ")";
+   unsigned n_iter=check_preconditioner(label.str(),&prec,jacobian,rhs,
+                                        x_ref,trace_file);
+   if ((k>0) && (n_iter>n_iter_previous))
+    {
+     iterations_decrease=false;
+    }
+   n_iter_previous=n_iter;
+  }
+ trace_file << "ILU(k)_iterations_decrease " << iterations_decrease
+            << std::endl;
+
+ // ILUT: the number of iterations must not increase as the drop
+ // tolerance is reduced
+ iterations_decrease=true;
+ double drop_tolerance=1.0e-2;
+ for (unsigned i=0;i<3;i++)
+  {
+   ILUTPreconditioner prec(drop_tolerance);
+   std::ostringstream label;
+   label << "ILUT(" << drop_tolerance << ")";
+   unsigned n_iter=check_preconditioner(label.str(),&prec,jacobian,rhs,
+                                        x_ref,trace_file);
+   if ((i>0) && (n_iter>n_iter_previous))
+    {
+     iterations_decrease=false;
+    }
+   n_iter_previous=n_iter;
+   drop_tolerance*=0.1;
+  }
+ trace_file << "ILUT_iterations_decrease " << iterations_decrease
+            << std::endl;
+
+ // ILU(0) must agree with the existing ILU(0) preconditioner (which
+ // requires the column indices to be sorted)
+ jacobian.sort_entries();
+ Preconditioner* ilu_zero_prec_pt=new ILUZeroPreconditioner<CRDoubleMatrix>;
+ ilu_zero_prec_pt->setup(&jacobian);
+ Preconditioner* iluk_prec_pt=new ILUKPreconditioner(0);
+ iluk_prec_pt->setup(&jacobian);
+ double diff=max_difference(ilu_zero_prec_pt,iluk_prec_pt,rhs);
+ oomph_info << "ILU(0) vs ILUZeroPreconditioner: rel. difference "
+            << diff << std::endl;
+ trace_file << "ILU(0)_agrees_with_ILUZeroPreconditioner "
+            << (diff<1.0e-12) << std::endl;
+ delete ilu_zero_prec_pt;
+ delete iluk_prec_pt;
+
+ // The level-scheduled and sequential triangular solves must agree; the
+ // symbolic factorisation must be re-used when the preconditioner is set
+ // up again for the same matrix
+ ILUKPreconditioner level_scheduled_prec(1);
+ ILUKPreconditioner sequential_prec(1);
+ sequential_prec.disable_level_scheduling();
+ Preconditioner* level_scheduled_prec_pt=&level_scheduled_prec;
+ Preconditioner* sequential_prec_pt=&sequential_prec;
+ level_scheduled_prec_pt->setup(&jacobian);
+ sequential_prec_pt->setup(&jacobian);
+ diff=max_difference(level_scheduled_prec_pt,sequential_prec_pt,rhs);
+ oomph_info << "ILU(1) level-scheduled vs sequential solves: "
+            << "rel. difference " << diff << "; levels (forward, backward): "
+            << level_scheduled_prec.nlevel().first << ", "
+            << level_scheduled_prec.nlevel().second << std::endl;
+ trace_file << "level_scheduled_solves_agree " << (diff<1.0e-12)
+            << std::endl;
+ level_scheduled_prec_pt->setup(&jacobian);
+ trace_file << "symbolic_factorisation_reused "
+            << level_scheduled_prec.symbolic_factorisation_was_reused()
+            << std::endl;
+
+ trace_file.close();
+
+} // end of main
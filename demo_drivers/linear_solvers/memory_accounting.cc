@@ -0,0 +1,197 @@
+//LIC// ====================================================================
+//LIC// This file forms part of oomph-lib, the object-oriented,
+//LIC// multi-physics finite-element library, available
+//LIC// at http://www.oomph-lib.org.
+//LIC//
+//LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+//LIC//
+//LIC// This library is free software; you can redistribute it and/or
+//LIC// modify it under the terms of the GNU Lesser General Public
+//LIC// License as published by the Free Software Foundation; either
+//LIC// version 2.1 of the License, or (at your option) any later version.
+//LIC//
+//LIC// This library is distributed in the hope that it will be useful,
+//LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+//LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//LIC// Lesser General Public License for more details.
+//LIC//
+//LIC// You should have received a copy of the GNU Lesser General Public
+//LIC// License along with this library; if not, write to the Free Software
+//LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+//LIC// 02110-1301  USA.
+//LIC//
+//LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+//LIC//
+//LIC//====================================================================
+// Document the memory held by the mesh, the Jacobian, the LU factors
+// and the block preconditioner (and its subsidiary preconditioners)
+// during the Newton solve of a steady driven cavity problem.
+
+//Oomph-lib includes
+#include "generic.h"
+#include "navier_stokes.h"
+
+// The mesh
+#include "meshes/simple_rectangular_quadmesh.h"
+
+using namespace std;
+using namespace oomph;
+
+
+//==start_of_namespace====================================================
+/// Namespace for the problem parameters
+//========================================================================
+namespace Global_Parameters
+{
+ /// Number of elements in each coordinate direction
+ unsigned N_element=32;
+
+ /// Reynolds number
+ double Re=100.0;
+
+} // end of namespace
+
+
+
+//=====================================================================
+/// Steady driven cavity problem on the unit square
+//=====================================================================
+template<class ELEMENT>
+class DrivenCavityProblem : public Problem
+{
+
+public:
+
+ /// Constructor: Pass number of elements in each coordinate direction
+ DrivenCavityProblem(const unsigned& n)
+  {
+   Problem::mesh_pt()=new SimpleRectangularQuadMesh<ELEMENT>(n,n,1.0,1.0);
+
+   // No slip on all boundaries; unit tangential velocity on the lid
+   // (boundary 2)
+   unsigned n_bound=mesh_pt()->nboundary();
+   for (unsigned b=0;b<n_bound;b++)
+    {
+     unsigned n_node=mesh_pt()->nboundary_node(b);
+     for (unsigned j=0;j<n_node;j++)
+      {
+       Node* nod_pt=mesh_pt()->boundary_node_pt(b,j);
+       nod_pt->pin(0);
+       nod_pt->pin(1);
+       if (b==2)
+        {
+         nod_pt->set_value(0,1.0);
+        }
+      }
+    }
+
+   // Set the Reynolds number
+   unsigned n_element=mesh_pt()->nelement();
+   for (unsigned e=0;e<n_element;e++)
+    {
+     ELEMENT* el_pt=dynamic_cast<ELEMENT*>(mesh_pt()->element_pt(e));
+     el_pt->re_pt()=&Global_Parameters::Re;
+    }
+
+   // Pin one pressure value
+   dynamic_cast<ELEMENT*>(mesh_pt()->element_pt(0))->fix_pressure(0,0.0);
+
+   oomph_info << "Driven cavity problem: " << assign_eqn_numbers()
+              << " dofs" << std::endl;
+  }
+
+}; // end of DrivenCavityProblem
+
+
+
+//=====================================================================
+/// Solve the problem, doc'ing the memory usage after each linear
+/// solve; write the memory usage of the linear solver at the peak of
+/// the final linear solve and that still held by the problem after the
+/// solve to the trace file
+//=====================================================================
+void solve_and_doc_memory(const std::string& label,
+                          Problem& problem,
+                          std::ofstream& trace_file)
+{
+ problem.enable_doc_memory_usage_in_newton_solve();
+ problem.newton_solve();
+
+ // Memory held by the linear solver at the peak of the final solve
+ const MemoryAccount& peak_account=
+  problem.linear_solver_pt()->memory_usage_of_last_solve();
+ trace_file << "# " << label << ": peak of the final linear solve"
+            << std::endl;
+ peak_account.doc(trace_file,label+"_peak ");
+
+ // Memory still held by the problem
+ MemoryAccount account;
+ problem.get_memory_usage(account);
+ trace_file << "# " << label << ": problem after the solve" << std::endl;
+ account.doc(trace_file,label+"_problem ");
+
+ double mb=1024.0*1024.0;
+ oomph_info << label << ": memory held by the problem after the solve: "
+            << account.total_nbyte()/mb
+            << " MB; by the linear solver at the peak of the final solve: "
+            << peak_account.total_nbyte()/mb << " MB" << std::endl;
+}
+
+
+
+//=====================================================================
+/// Driver: Doc the memory usage for a direct solver and for GMRES
+/// with the LSC block preconditioner
+//=====================================================================
+int main(int argc, char **argv)
+{
+ // Store command line arguments
+ CommandLineArgs::setup(argc,argv);
+
+ // Number of elements can be specified on the command line
+ CommandLineArgs::specify_command_line_flag(
+  "--n_element",&Global_Parameters::N_element);
+ CommandLineArgs::parse_and_assign();
+ CommandLineArgs::doc_specified_flags();
+
+ // Output for the results
+ std::ofstream trace_file("RESLT/memory_usage.dat");
+ trace_file << "# case_category bytes MB" << std::endl;
+
+ unsigned n=Global_Parameters::N_element;
+
+ // Direct solver (the default)
+ //----------------------------
+ {
+  DrivenCavityProblem<QTaylorHoodElement<2> > problem(n);
+  solve_and_doc_memory("SuperLU",problem,trace_file);
+ }
+
+ // GMRES with the LSC preconditioner and incomplete LU factorisations
+ // as subsidiary preconditioners for the momentum and pressure Poisson
+ // blocks
+ //-------------------------------------------------------------------
+ {
+  DrivenCavityProblem<QTaylorHoodElement<2> > problem(n);
+
+  GMRES<CRDoubleMatrix> solver;
+  solver.tolerance()=1.0e-10;
+  solver.max_iter()=500;
+  solver.set_preconditioner_RHS();
+  solver.disable_doc_time();
+
+  NavierStokesSchurComplementPreconditioner lsc_prec(&problem);
+  lsc_prec.set_navier_stokes_mesh(problem.mesh_pt());
+  ILUKPreconditioner f_prec(1);
+  ILUKPreconditioner p_prec(0);
+  lsc_prec.set_f_preconditioner(&f_prec);
+  lsc_prec.set_p_preconditioner(&p_prec);
+  solver.preconditioner_pt()=&lsc_prec;
+  problem.linear_solver_pt()=&solver;
+
+  solve_and_doc_memory("GMRES_LSC",problem,trace_file);
+ }
+
+ trace_file.close();
+
+} // end of main
@@ -0,0 +1,321 @@
+//LIC// ====================================================================
+//LIC// This file forms part of oomph-lib, the object-oriented,
+//LIC// multi-physics finite-element library, available
+//LIC// at http://www.oomph-lib.org.
+//LIC//
+//LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+//LIC//
+//LIC// This library is free software; you can redistribute it and/or
+//LIC// modify it under the terms of the GNU Lesser General Public
+//LIC// License as published by the Free Software Foundation; either
+//LIC// version 2.1 of the License, or (at your option) any later version.
+//LIC//
+//LIC// This library is distributed in the hope that it will be useful,
+//LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+//LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//LIC// Lesser General Public License for more details.
+//LIC//
+//LIC// You should have received a copy of the GNU Lesser General Public
+//LIC// License along with this library; if not, write to the Free Software
+//LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+//LIC// 02110-1301  USA.
+//LIC//
+//LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+//LIC//
+//LIC//====================================================================
+// Compare GMRES convergence and timings for preconditioners whose
+// factors are stored in double and in single precision, for the
+// Jacobians of a 2D Poisson problem and of a (steady) driven cavity
+// problem.
+
+//Oomph-lib includes
+#include "generic.h"
+#include "poisson.h"
+#include "navier_stokes.h"
+
+// The mesh
+#include "meshes/simple_rectangular_quadmesh.h"
+
+using namespace std;
+using namespace oomph;
+
+
+//==start_of_namespace====================================================
+/// Namespace for the problem parameters
+//========================================================================
+namespace Global_Parameters
+{
+ /// Number of elements in each coordinate direction
+ unsigned N_element=64;
+
+ /// Reynolds number for the driven cavity
+ double Re=100.0;
+
+ /// Constant source function for the Poisson problem
+ void source_function(const Vector<double>& x, double& source)
+ {
+  source=-1.0;
+ }
+
+} // end of namespace
+
+
+
+//=====================================================================
+/// Poisson problem on the unit square with homogeneous Dirichlet
+/// conditions
+//=====================================================================
+template<class ELEMENT>
+class PoissonProblem : public Problem
+{
+
+public:
+
+ /// Constructor: Pass number of elements in each coordinate direction
+ PoissonProblem(const unsigned& n)
+  {
+   Problem::mesh_pt()=new SimpleRectangularQuadMesh<ELEMENT>(n,n,1.0,1.0);
+
+   // Pin the boundary values
+   unsigned n_bound=mesh_pt()->nboundary();
+   for (unsigned b=0;b<n_bound;b++)
+    {
+     unsigned n_node=mesh_pt()->nboundary_node(b);
+     for (unsigned j=0;j<n_node;j++)
+      {
+       mesh_pt()->boundary_node_pt(b,j)->pin(0);
+      }
+    }
+
+   // Set the source function
+   unsigned n_element=mesh_pt()->nelement();
+   for (unsigned e=0;e<n_element;e++)
+    {
+     ELEMENT* el_pt=dynamic_cast<ELEMENT*>(mesh_pt()->element_pt(e));
+     el_pt->source_fct_pt()=&Global_Parameters::source_function;
+    }
+
+   oomph_info << "Poisson problem: " << assign_eqn_numbers()
+              << " dofs" << std::endl;
+  }
+
+}; // end of PoissonProblem
+
+
+
+//=====================================================================
+/// Steady driven cavity problem on the unit square
+//=====================================================================
+template<class ELEMENT>
+class DrivenCavityProblem : public Problem
+{
+
+public:
+
+ /// Constructor: Pass number of elements in each coordinate direction
+ DrivenCavityProblem(const unsigned& n)
+  {
+   Problem::mesh_pt()=new SimpleRectangularQuadMesh<ELEMENT>(n,n,1.0,1.0);
+
+   // No slip on all boundaries; unit tangential velocity on the lid
+   // (boundary 2)
+   unsigned n_bound=mesh_pt()->nboundary();
+   for (unsigned b=0;b<n_bound;b++)
+    {
+     unsigned n_node=mesh_pt()->nboundary_node(b);
+     for (unsigned j=0;j<n_node;j++)
+      {
+       Node* nod_pt=mesh_pt()->boundary_node_pt(b,j);
+       nod_pt->pin(0);
+       nod_pt->pin(1);
+       if (b==2)
+        {
+         nod_pt->set_value(0,1.0);
+        }
+      }
+    }
+
+   // Set the Reynolds number
+   unsigned n_element=mesh_pt()->nelement();
+   for (unsigned e=0;e<n_element;e++)
+    {
+     ELEMENT* el_pt=dynamic_cast<ELEMENT*>(mesh_pt()->element_pt(e));
+     el_pt->re_pt()=&Global_Parameters::Re;
+    }
+
+   // Pin one pressure value
+   dynamic_cast<ELEMENT*>(mesh_pt()->element_pt(0))->fix_pressure(0,0.0);
+
+   oomph_info << "Driven cavity problem: " << assign_eqn_numbers()
+              << " dofs" << std::endl;
+  }
+
+}; // end of DrivenCavityProblem
+
+
+
+//=====================================================================
+/// Solve the linear system with GMRES, preconditioned by the
+/// preconditioner pointed to by solver_prec_pt, whose (subsidiary)
+/// preconditioners are pointed to by the entries in prec_pt. These
+/// store their factors in double and then in single precision; document
+/// the number of iterations, the timings and the difference between
+/// the solutions.
+//=====================================================================
+template<class PRECONDITIONER>
+void compare_precisions(const std::string& label,
+                        Preconditioner* solver_prec_pt,
+                        Vector<PRECONDITIONER*>& prec_pt,
+                        CRDoubleMatrix& jacobian,
+                        DoubleVector& rhs,
+                        std::ofstream& trace_file)
+{
+ // Use right preconditioning so that the convergence criterion
+ // refers to the actual (rather than the preconditioned) residual
+ GMRES<CRDoubleMatrix> solver;
+ solver.tolerance()=1.0e-8;
+ solver.max_iter()=1000;
+ solver.set_preconditioner_RHS();
+ solver.preconditioner_pt()=solver_prec_pt;
+ solver.disable_doc_time();
+ solver.enable_setup_preconditioner_before_solve();
+
+ DoubleVector x_double;
+ unsigned n_prec=prec_pt.size();
+ for (unsigned single=0;single<2;single++)
+  {
+   // Wipe the previous factorisation so the setup times are comparable
+   solver_prec_pt->clean_up_memory();
+   for (unsigned i=0;i<n_prec;i++)
+    {
+     prec_pt[i]->clean_up_memory();
+     if (single==0)
+      {
+       prec_pt[i]->disable_single_precision_storage();
+      }
+     else
+      {
+       prec_pt[i]->enable_single_precision_storage();
+      }
+    }
+
+   DoubleVector x;
+   solver.solve(&jacobian,rhs,x);
+
+   // Relative residual
+   DoubleVector residual;
+   jacobian.multiply(x,residual);
+   residual-=rhs;
+   double rel_residual=residual.norm()/rhs.norm();
+
+   // Difference to the solution obtained with the double precision
+   // preconditioner
+   double diff=0.0;
+   if (single==0)
+    {
+     x_double=x;
+    }
+   else
+    {
+     x-=x_double;
+     diff=x.norm()/x_double.norm();
+    }
+
+   std::string precision=(single==0) ? "double" : "single";
+   oomph_info << label << " (" << precision << "): "
+              << solver.iterations() << " iterations; setup: "
+              << solver.preconditioner_setup_time() << " sec; solve: "
+              << solver.linear_solver_solution_time()
+              << " sec; rel. residual: " << rel_residual
+              << "; rel. difference of solutions: " << diff
+              << std::endl;
+   trace_file << label << " " << precision << " "
+              << solver.iterations() << " "
+              << solver.preconditioner_setup_time() << " "
+              << solver.linear_solver_solution_time() << " "
+              << rel_residual << " " << diff << std::endl;
+  }
+}
+
+
+
+//=====================================================================
+/// Driver: Compare the preconditioners for the Poisson and driven
+/// cavity Jacobians
+//=====================================================================
+int main(int argc, char **argv)
+{
+ // Store command line arguments
+ CommandLineArgs::setup(argc,argv);
+
+ // Number of elements can be specified on the command line
+ CommandLineArgs::specify_command_line_flag(
+  "--n_element",&Global_Parameters::N_element);
+ CommandLineArgs::parse_and_assign();
+ CommandLineArgs::doc_specified_flags();
+
+ // Output for the results
+ std::ofstream trace_file("RESLT/trace.dat");
+ trace_file << "# preconditioner precision n_iter t_setup t_solve "
+            << "rel_residual rel_diff" << std::endl;
+
+ unsigned n=Global_Parameters::N_element;
+
+ // Poisson problem
+ //----------------
+ {
+  PoissonProblem<QPoissonElement<2,3> > problem(n);
+  DoubleVector residuals;
+  CRDoubleMatrix jacobian;
+  problem.get_jacobian(residuals,jacobian);
+
+  MatrixBasedDiagPreconditioner diag_prec;
+  Vector<MatrixBasedDiagPreconditioner*> diag_prec_pt(1,&diag_prec);
+  compare_precisions("Poisson_diagonal",&diag_prec,diag_prec_pt,
+                     jacobian,residuals,trace_file);
+
+  ILUZeroPreconditioner<CRDoubleMatrix> ilu_zero_prec;
+  Vector<ILUZeroPreconditioner<CRDoubleMatrix>*>
+   ilu_zero_prec_pt(1,&ilu_zero_prec);
+  compare_precisions("Poisson_ILU(0)",&ilu_zero_prec,ilu_zero_prec_pt,
+                     jacobian,residuals,trace_file);
+
+  ILUKPreconditioner ilu_one_prec(1);
+  Vector<ILUKPreconditioner*> ilu_one_prec_pt(1,&ilu_one_prec);
+  compare_precisions("Poisson_ILU(1)",&ilu_one_prec,ilu_one_prec_pt,
+                     jacobian,residuals,trace_file);
+ }
+
+ // Driven cavity problem: Compute the steady solution (with the default
+ // direct solver), then compare the LSC preconditioner with
+ // incomplete LU factorisations as subsidiary preconditioners for the
+ // momentum and pressure Poisson blocks
+ //-------------------------------------------------------------------
+ {
+  DrivenCavityProblem<QTaylorHoodElement<2> > problem(n/2);
+  problem.newton_solve();
+  DoubleVector residuals;
+  CRDoubleMatrix jacobian;
+  problem.get_jacobian(residuals,jacobian);
+
+  // The residuals vanish at the steady solution: use a constant right
+  // hand side instead
+  DoubleVector rhs(residuals.distribution_pt(),1.0);
+
+  NavierStokesSchurComplementPreconditioner lsc_prec(&problem);
+  lsc_prec.set_navier_stokes_mesh(problem.mesh_pt());
+
+  Vector<ILUKPreconditioner*> ilu_prec_pt(2);
+  ilu_prec_pt[0]=new ILUKPreconditioner(1);
+  ilu_prec_pt[1]=new ILUKPreconditioner(0);
+  lsc_prec.set_f_preconditioner(ilu_prec_pt[0]);
+  lsc_prec.set_p_preconditioner(ilu_prec_pt[1]);
+  compare_precisions("Cavity_LSC_ILU",&lsc_prec,ilu_prec_pt,
+                     jacobian,rhs,trace_file);
+  delete ilu_prec_pt[0];
+  delete ilu_prec_pt[1];
+ }
+
+ trace_file.close();
+
+} // end of main
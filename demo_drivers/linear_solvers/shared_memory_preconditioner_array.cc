@@ -0,0 +1,248 @@
+//LIC// ====================================================================
+//LIC// This file forms part of oomph-lib, the object-oriented,
+//LIC// multi-physics finite-element library, available
+//LIC// at http://www.oomph-lib.org.
+//LIC//
+//LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+//LIC//
+//LIC// This library is free software; you can redistribute it and/or
+//LIC// modify it under the terms of the GNU Lesser General Public
+//LIC// License as published by the Free Software Foundation; either
+//LIC// version 2.1 of the License, or (at your option) any later version.
+//LIC//
+//LIC// This library is distributed in the hope that it will be useful,
+//LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+//LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//LIC// Lesser General Public License for more details.
+//LIC//
+//LIC// You should have received a copy of the GNU Lesser General Public
+//LIC// License along with this library; if not, write to the Free Software
+//LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+//LIC// 02110-1301  USA.
+//LIC//
+//LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+//LIC//
+//LIC//====================================================================
+// Check that the SharedMemoryPreconditionerArray, which sets up and
+// applies its preconditioners concurrently (on separate groups of
+// threads), produces the same results as setting up and applying the
+// same preconditioners one after the other. The matrices are the
+// Jacobians of 2D Poisson problems of different sizes.
+
+//Oomph-lib includes
+#include "generic.h"
+#include "poisson.h"
+
+// The mesh
+#include "meshes/simple_rectangular_quadmesh.h"
+
+using namespace std;
+using namespace oomph;
+
+
+//==start_of_namespace====================================================
+/// Namespace for the problem parameters
+//========================================================================
+namespace Global_Parameters
+{
+ /// Number of elements in each coordinate direction for the largest
+ /// problem
+ unsigned N_element=48;
+
+ /// Constant source function for the Poisson problem
+ void source_function(const Vector<double>& x, double& source)
+ {
+  source=-1.0;
+ }
+
+} // end of namespace
+
+
+
+//=====================================================================
+/// Poisson problem on the unit square with homogeneous Dirichlet
+/// conditions
+//=====================================================================
+template<class ELEMENT>
+class PoissonProblem : public Problem
+{
+
+public:
+
+ /// Constructor: Pass number of elements in each coordinate direction
+ PoissonProblem(const unsigned& n)
+  {
+   Problem::mesh_pt()=new SimpleRectangularQuadMesh<ELEMENT>(n,n,1.0,1.0);
+
+   // Pin the boundary values
+   unsigned n_bound=mesh_pt()->nboundary();
+   for (unsigned b=0;b<n_bound;b++)
+    {
+     unsigned n_node=mesh_pt()->nboundary_node(b);
+     for (unsigned j=0;j<n_node;j++)
+      {
+       mesh_pt()->boundary_node_pt(b,j)->pin(0);
+      }
+    }
+
+   // Set the source function
+   unsigned n_element=mesh_pt()->nelement();
+   for (unsigned e=0;e<n_element;e++)
+    {
+     ELEMENT* el_pt=dynamic_cast<ELEMENT*>(mesh_pt()->element_pt(e));
+     el_pt->source_fct_pt()=&Global_Parameters::source_function;
+    }
+
+   oomph_info << "Poisson problem: " << assign_eqn_numbers()
+              << " dofs" << std::endl;
+  }
+
+}; // end of PoissonProblem
+
+
+
+//=====================================================================
+/// Create a preconditioner of the specified type
+//=====================================================================
+Preconditioner* create_preconditioner(const std::string& type)
+{
+ if (type=="SuperLU")
+  {
+   return new SuperLUPreconditioner;
+  }
+ else if (type=="ILU(1)")
+  {
+   return new ILUKPreconditioner(1);
+  }
+ else if (type=="ILUT")
+  {
+   return new ILUTPreconditioner;
+  }
+ else
+  {
+   return new AMGPreconditioner;
+  }
+}
+
+
+
+//=====================================================================
+/// Set up and apply the preconditioners of the specified types (one
+/// for each matrix) concurrently, with the SharedMemoryPreconditionerArray,
+/// and one after the other; document the max. difference between the
+/// results
+//=====================================================================
+void compare_concurrent_and_serial(const std::string& label,
+                                   const Vector<std::string>& type,
+                                   const Vector<CRDoubleMatrix*>& matrix_pt,
+                                   const Vector<DoubleVector>& r,
+                                   std::ofstream& trace_file)
+{
+ unsigned n_prec=matrix_pt.size();
+ Vector<Preconditioner*> concurrent_prec_pt(n_prec);
+ Vector<Preconditioner*> serial_prec_pt(n_prec);
+ for (unsigned i=0;i<n_prec;i++)
+  {
+   concurrent_prec_pt[i]=create_preconditioner(type[i]);
+   serial_prec_pt[i]=create_preconditioner(type[i]);
+  }
+
+ // Concurrent setup and solve
+ double t_start=TimingHelpers::timer();
+ SharedMemoryPreconditionerArray prec_array;
+ prec_array.setup_preconditioners(matrix_pt,concurrent_prec_pt);
+ Vector<DoubleVector> z_concurrent;
+ prec_array.solve_preconditioners(r,z_concurrent);
+ double t_concurrent=TimingHelpers::timer()-t_start;
+
+ // Serial setup and solve
+ t_start=TimingHelpers::timer();
+ Vector<DoubleVector> z_serial(n_prec);
+ for (unsigned i=0;i<n_prec;i++)
+  {
+   serial_prec_pt[i]->setup(matrix_pt[i]);
+   serial_prec_pt[i]->preconditioner_solve(r[i],z_serial[i]);
+  }
+ double t_serial=TimingHelpers::timer()-t_start;
+
+ // Max. relative difference between the results
+ double max_diff=0.0;
+ for (unsigned i=0;i<n_prec;i++)
+  {
+   DoubleVector diff(z_concurrent[i]);
+   diff-=z_serial[i];
+   max_diff=std::max(max_diff,diff.norm()/z_serial[i].norm());
+  }
+
+ oomph_info << label << ": " << prec_array.ngroup()
+            << " thread group(s); concurrent: " << t_concurrent
+            << " sec; serial: " << t_serial
+            << " sec; max. rel. difference of results: " << max_diff
+            << std::endl;
+ trace_file << label << " " << (max_diff<1.0e-12) << std::endl;
+
+ for (unsigned i=0;i<n_prec;i++)
+  {
+   delete concurrent_prec_pt[i];
+   delete serial_prec_pt[i];
+  }
+}
+
+
+
+//=====================================================================
+/// Driver: Compare the concurrent and serial setup of arrays of
+/// preconditioners for the Jacobians of Poisson problems
+//=====================================================================
+int main(int argc, char **argv)
+{
+ // Store command line arguments
+ CommandLineArgs::setup(argc,argv);
+
+ // Number of elements can be specified on the command line
+ CommandLineArgs::specify_command_line_flag(
+  "--n_element",&Global_Parameters::N_element);
+ CommandLineArgs::parse_and_assign();
+ CommandLineArgs::doc_specified_flags();
+
+ // Output for the results
+ std::ofstream trace_file("RESLT/trace.dat");
+ trace_file << "# preconditioners results_agree" << std::endl;
+
+ // Get the Jacobians (and residuals) of Poisson problems of decreasing
+ // size so that the thread groups have different amounts of work
+ unsigned n_prec=4;
+ Vector<CRDoubleMatrix*> matrix_pt(n_prec);
+ Vector<DoubleVector> r(n_prec);
+ for (unsigned i=0;i<n_prec;i++)
+  {
+   unsigned n=Global_Parameters::N_element*(n_prec-i)/n_prec;
+   PoissonProblem<QPoissonElement<2,3> > problem(n);
+   matrix_pt[i]=new CRDoubleMatrix;
+   problem.get_jacobian(r[i],*matrix_pt[i]);
+  }
+
+ // The same type of preconditioner for all matrices: SuperLU factorises
+ // its matrices one at a time
+ compare_concurrent_and_serial("SuperLU",Vector<std::string>(n_prec,"SuperLU"),
+                               matrix_pt,r,trace_file);
+ compare_concurrent_and_serial("ILUT",Vector<std::string>(n_prec,"ILUT"),
+                               matrix_pt,r,trace_file);
+ compare_concurrent_and_serial("AMG",Vector<std::string>(n_prec,"AMG"),
+                               matrix_pt,r,trace_file);
+
+ // Different preconditioners for the different matrices
+ Vector<std::string> type(n_prec);
+ type[0]="AMG";
+ type[1]="ILUT";
+ type[2]="ILU(1)";
+ type[3]="SuperLU";
+ compare_concurrent_and_serial("Mixed",type,matrix_pt,r,trace_file);
+
+ for (unsigned i=0;i<n_prec;i++)
+  {
+   delete matrix_pt[i];
+  }
+ trace_file.close();
+
+} // end of main
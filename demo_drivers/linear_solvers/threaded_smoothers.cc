@@ -0,0 +1,240 @@
+//LIC// ====================================================================
+//LIC// This file forms part of oomph-lib, the object-oriented,
+//LIC// multi-physics finite-element library, available
+//LIC// at http://www.oomph-lib.org.
+//LIC//
+//LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+//LIC//
+//LIC// This library is free software; you can redistribute it and/or
+//LIC// modify it under the terms of the GNU Lesser General Public
+//LIC// License as published by the Free Software Foundation; either
+//LIC// version 2.1 of the License, or (at your option) any later version.
+//LIC//
+//LIC// This library is distributed in the hope that it will be useful,
+//LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+//LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//LIC// Lesser General Public License for more details.
+//LIC//
+//LIC// You should have received a copy of the GNU Lesser General Public
+//LIC// License along with this library; if not, write to the Free Software
+//LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+//LIC// 02110-1301  USA.
+//LIC//
+//LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+//LIC//
+//LIC//====================================================================
+// Check the multicolour Gauss-Seidel and Chebyshev smoothers for the
+// Jacobian of a 2D Poisson problem:
+// (i)  starting from an oscillatory error, a few sweeps of the
+//      multicolour Gauss-Seidel smoother must reduce the residual about as
+//      effectively as the (sequential) Gauss-Seidel smoother, and those
+//      of the Chebyshev smoother by (at least) the factor expected from
+//      the Chebyshev polynomial for the targeted part of the spectrum, and
+// (ii) when iterated to convergence, the multicolour Gauss-Seidel
+//      smoother must reproduce the solution obtained with a direct
+//      solver.
+
+//Oomph-lib includes
+#include "generic.h"
+#include "poisson.h"
+
+// The mesh
+#include "meshes/simple_rectangular_quadmesh.h"
+
+using namespace std;
+using namespace oomph;
+
+
+//==start_of_namespace====================================================
+/// Namespace for the problem parameters
+//========================================================================
+namespace Global_Parameters
+{
+ /// Number of elements in each coordinate direction
+ unsigned N_element=16;
+
+ /// Constant source function for the Poisson problem
+ void source_function(const Vector<double>& x, double& source)
+ {
+  source=-1.0;
+ }
+
+} // end of namespace
+
+
+
+//=====================================================================
+/// Poisson problem on the unit square with homogeneous Dirichlet
+/// conditions
+//=====================================================================
+template<class ELEMENT>
+class PoissonProblem : public Problem
+{
+
+public:
+
+ /// Constructor: Pass number of elements in each coordinate direction
+ PoissonProblem(const unsigned& n)
+  {
+   Problem::mesh_pt()=new SimpleRectangularQuadMesh<ELEMENT>(n,n,1.0,1.0);
+
+   // Pin the boundary values
+   unsigned n_bound=mesh_pt()->nboundary();
+   for (unsigned b=0;b<n_bound;b++)
+    {
+     unsigned n_node=mesh_pt()->nboundary_node(b);
+     for (unsigned j=0;j<n_node;j++)
+      {
+       mesh_pt()->boundary_node_pt(b,j)->pin(0);
+      }
+    }
+
+   // Set the source function
+   unsigned n_element=mesh_pt()->nelement();
+   for (unsigned e=0;e<n_element;e++)
+    {
+     ELEMENT* el_pt=dynamic_cast<ELEMENT*>(mesh_pt()->element_pt(e));
+     el_pt->source_fct_pt()=&Global_Parameters::source_function;
+    }
+
+   oomph_info << "Poisson problem: " << assign_eqn_numbers()
+              << " dofs" << std::endl;
+  }
+
+}; // end of PoissonProblem
+
+
+
+//=====================================================================
+/// Do n_sweep iterations with the smoother pointed to by solver_pt,
+/// starting from zero, and return the relative residual
+//=====================================================================
+double relative_residual(const std::string& label,
+                         IterativeLinearSolver* solver_pt,
+                         CRDoubleMatrix& matrix,
+                         const DoubleVector& rhs,
+                         const unsigned& n_sweep)
+{
+ solver_pt->tolerance()=1.0e-16;
+ solver_pt->max_iter()=n_sweep;
+ solver_pt->disable_doc_time();
+
+ DoubleVector x;
+ solver_pt->solve(&matrix,rhs,x);
+ DoubleVector residual;
+ matrix.residual(x,rhs,residual);
+ double rel_residual=residual.norm()/rhs.norm();
+
+ oomph_info << label << ": rel. residual after " << n_sweep
+            << " sweeps: " << rel_residual << std::endl;
+ return rel_residual;
+}
+
+
+
+//=====================================================================
+/// Driver: Check the multicolour Gauss-Seidel and Chebyshev smoothers
+//=====================================================================
+int main(int argc, char **argv)
+{
+ // Store command line arguments
+ CommandLineArgs::setup(argc,argv);
+
+ // Number of elements can be specified on the command line
+ CommandLineArgs::specify_command_line_flag(
+  "--n_element",&Global_Parameters::N_element);
+ CommandLineArgs::parse_and_assign();
+ CommandLineArgs::doc_specified_flags();
+
+ // Output for the results
+ std::ofstream trace_file("RESLT/trace.dat");
+ trace_file << "# check passed" << std::endl;
+
+ PoissonProblem<QPoissonElement<2,3> > problem(Global_Parameters::N_element);
+ DoubleVector residuals;
+ CRDoubleMatrix jacobian;
+ problem.get_jacobian(residuals,jacobian);
+
+ // Right hand side for which the exact solution (and hence the initial
+ // error) is oscillatory
+ DoubleVector x_osc(residuals.distribution_pt(),0.0);
+ unsigned n_dof=x_osc.nrow();
+ for (unsigned i=0;i<n_dof;i++)
+  {
+   x_osc[i]=sin(1.0+double(i*i));
+  }
+ DoubleVector rhs;
+ jacobian.multiply(x_osc,rhs);
+
+ // Residual reduction achieved by a few sweeps of the smoothers
+ unsigned n_sweep=3;
+ double res_gs=0.0;
+ {
+  GS<CRDoubleMatrix> solver;
+  res_gs=relative_residual("GS",&solver,jacobian,rhs,n_sweep);
+ }
+ {
+  DampedJacobi<CRDoubleMatrix> solver;
+  relative_residual("DampedJacobi",&solver,jacobian,rhs,n_sweep);
+ }
+ {
+  MulticolourGS solver;
+  double res=relative_residual("MulticolourGS",&solver,jacobian,rhs,
+                               n_sweep);
+  oomph_info << "Number of colours: " << solver.ncolour() << std::endl;
+  trace_file << "MulticolourGS_comparable_to_GS " << (res<2.0*res_gs)
+             << std::endl;
+ }
+ {
+  MulticolourGS solver;
+  solver.enable_symmetric_sweep();
+  double res=relative_residual("MulticolourGS (symmetric)",&solver,
+                               jacobian,rhs,n_sweep);
+  trace_file << "symmetric_MulticolourGS_comparable_to_GS "
+             << (res<2.0*res_gs) << std::endl;
+ }
+ {
+  Chebyshev solver;
+  double res=relative_residual("Chebyshev",&solver,jacobian,rhs,n_sweep);
+
+  // Each sweep reduces the components of the error in the targeted part
+  // of the spectrum of inv(D)*A, [lambda_max/ratio, lambda_max], by the
+  // factor 1/T_k((lambda_max+lambda_min)/(lambda_max-lambda_min)),
+  // where T_k is the Chebyshev polynomial of the degree of the smoother
+  double lambda_max=solver.max_eigenvalue_estimate();
+  double lambda_min=lambda_max/solver.eigenvalue_ratio();
+  double t_k=cosh(double(solver.degree())*
+                  acosh((lambda_max+lambda_min)/(lambda_max-lambda_min)));
+  double expected_res=pow(1.0/t_k,double(n_sweep));
+  oomph_info << "Chebyshev: expected reduction: " << expected_res
+             << std::endl;
+  trace_file << "Chebyshev_reduction_as_expected "
+             << (res<expected_res) << std::endl;
+ }
+
+ // Iterate the symmetric multicolour Gauss-Seidel smoother to
+ // convergence and compare against the direct solution
+ DoubleVector x_ref;
+ SuperLUSolver direct_solver;
+ direct_solver.disable_doc_time();
+ direct_solver.solve(&jacobian,residuals,x_ref);
+ {
+  MulticolourGS solver;
+  solver.enable_symmetric_sweep();
+  solver.tolerance()=1.0e-12;
+  solver.max_iter()=100000;
+  solver.disable_doc_time();
+  DoubleVector x;
+  solver.solve(&jacobian,residuals,x);
+  x-=x_ref;
+  double diff=x.norm()/x_ref.norm();
+  oomph_info << "MulticolourGS (symmetric) converged in "
+             << solver.iterations() << " iterations; "
+             << "rel. difference to direct solution: " << diff << std::endl;
+  trace_file << "MulticolourGS_agrees_with_direct_solution "
+             << (diff<1.0e-8) << std::endl;
+ }
+
+ trace_file.close();
+
+} // end of main
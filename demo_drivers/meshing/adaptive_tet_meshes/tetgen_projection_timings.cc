@@ -0,0 +1,208 @@
+//LIC// ====================================================================
+//LIC// This file forms part of oomph-lib, the object-oriented,
+//LIC// multi-physics finite-element library, available
+//LIC// at http://www.oomph-lib.org.
+//LIC//
+//LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+//LIC//
+//LIC// This library is free software; you can redistribute it and/or
+//LIC// modify it under the terms of the GNU Lesser General Public
+//LIC// License as published by the Free Software Foundation; either
+//LIC// version 2.1 of the License, or (at your option) any later version.
+//LIC//
+//LIC// This library is distributed in the hope that it will be useful,
+//LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+//LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//LIC// Lesser General Public License for more details.
+//LIC//
+//LIC// You should have received a copy of the GNU Lesser General Public
+//LIC// License along with this library; if not, write to the Free Software
+//LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+//LIC// 02110-1301  USA.
+//LIC//
+//LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+//LIC//
+//LIC//====================================================================
+// Adapt a tetgen mesh of the unit cube that carries a linear field and
+// check that (i) the field is projected exactly onto the new mesh and
+// (ii) the timings of the assembly/setup of the projection matrices and
+// of the re-solves are documented when requested.
+
+//Generic routines
+#include "generic.h"
+
+// Poisson
+#include "poisson.h"
+
+// Tetgen mesh
+#include "meshes/refineable_tetgen_mesh.h"
+
+using namespace std;
+using namespace oomph;
+
+
+//=====================================================================
+/// Faceted surface of the unit cube; the six faces are the
+/// boundaries 0 to 5 (one-based ids 1 to 6) of the mesh
+//=====================================================================
+class CubeTetMeshFacetedSurface : public virtual TetMeshFacetedClosedSurface
+{
+
+public:
+
+ /// Constructor
+ CubeTetMeshFacetedSurface()
+  {
+   // Vertices
+   Vertex_pt.resize(8);
+   Vector<double> x(3);
+   for (unsigned j=0;j<8;j++)
+    {
+     x[0]=double(j%2);
+     x[1]=double((j/2)%2);
+     x[2]=double(j/4);
+     Vertex_pt[j]=new TetMeshVertex(x);
+    }
+
+   // Faces: x=0, x=1, y=0, y=1, z=0, z=1
+   unsigned face_vertex[6][4]={{0,2,6,4},{1,3,7,5},{0,1,5,4},
+                               {2,3,7,6},{0,1,3,2},{4,5,7,6}};
+   Facet_pt.resize(6);
+   for (unsigned f=0;f<6;f++)
+    {
+     Facet_pt[f]=new TetMeshFacet(4);
+     for (unsigned j=0;j<4;j++)
+      {
+       Facet_pt[f]->set_vertex_pt(j,Vertex_pt[face_vertex[f][j]]);
+      }
+     Facet_pt[f]->set_one_based_boundary_id(f+1);
+    }
+  }
+
+ /// Destructor
+ ~CubeTetMeshFacetedSurface()
+  {
+   for (unsigned f=0;f<6;f++)
+    {
+     delete Facet_pt[f];
+    }
+   for (unsigned j=0;j<8;j++)
+    {
+     delete Vertex_pt[j];
+    }
+  }
+
+};
+
+
+
+//==start_of_namespace====================================================
+/// The linear field that is carried by the mesh
+//========================================================================
+namespace Global_Parameters
+{
+ /// Linear field
+ double linear_field(const Vector<double>& x)
+ {
+  return 1.0+x[0]+2.0*x[1]+3.0*x[2];
+ }
+
+} // end of namespace
+
+
+
+//=====================================================================
+/// Driver
+//=====================================================================
+int main()
+{
+ typedef ProjectablePoissonElement<TPoissonElement<3,3> > ELEMENT;
+
+ // Capture the output of the adaptation to check that the projection
+ // timings are documented
+ std::ostream* saved_stream_pt=oomph_info.stream_pt();
+ std::ostringstream adapt_output;
+
+ // Build the mesh
+ CubeTetMeshFacetedSurface outer_boundary;
+ Vector<TetMeshFacetedSurface*> internal_surface_pt;
+ double element_volume=0.01;
+ RefineableTetgenMesh<ELEMENT> mesh(&outer_boundary,
+                                    internal_surface_pt,
+                                    element_volume);
+ mesh.min_element_size()=1.0e-4;
+ mesh.max_element_size()=0.1;
+ mesh.max_permitted_error()=0.5;
+ mesh.min_permitted_error()=0.1;
+ mesh.enable_timings_projection();
+
+ // Set the linear field (and assign the equation numbers that are
+ // required to set up the projection)
+ unsigned n_node=mesh.nnode();
+ Vector<double> x(3);
+ for (unsigned j=0;j<n_node;j++)
+  {
+   Node* nod_pt=mesh.node_pt(j);
+   for (unsigned i=0;i<3;i++)
+    {
+     x[i]=nod_pt->x(i);
+    }
+   nod_pt->set_value(0,Global_Parameters::linear_field(x));
+  }
+ unsigned n_element_before=mesh.nelement();
+
+ // Pretend that the error is large in the corner at the origin
+ Vector<double> elem_error(n_element_before,0.2);
+ for (unsigned e=0;e<n_element_before;e++)
+  {
+   FiniteElement* el_pt=mesh.finite_element_pt(e);
+   Vector<double> s(3,0.25);
+   el_pt->interpolated_x(s,x);
+   if (x[0]*x[0]+x[1]*x[1]+x[2]*x[2]<0.25)
+    {
+     elem_error[e]=1.0;
+    }
+  }
+
+ // Adapt
+ oomph_info.stream_pt()=&adapt_output;
+ mesh.adapt(elem_error);
+ oomph_info.stream_pt()=saved_stream_pt;
+ unsigned n_element_after=mesh.nelement();
+
+ // Max. error in the projected field
+ double max_error=0.0;
+ n_node=mesh.nnode();
+ for (unsigned j=0;j<n_node;j++)
+  {
+   Node* nod_pt=mesh.node_pt(j);
+   for (unsigned i=0;i<3;i++)
+    {
+     x[i]=nod_pt->x(i);
+    }
+   max_error=std::max(
+    max_error,std::fabs(nod_pt->value(0)-Global_Parameters::linear_field(x)));
+  }
+
+ // Have the projection timings been documented?
+ bool timings_documented=
+  (adapt_output.str().find("projection matrices")!=std::string::npos) &&
+  (adapt_output.str().find("re-solves with stored projection matrices")!=
+   std::string::npos);
+
+ oomph_info << "Number of elements before/after adaptation: "
+            << n_element_before << " " << n_element_after << std::endl;
+ oomph_info << "Max. error in projected linear field: " << max_error
+            << std::endl;
+ oomph_info << "Projection timings documented: " << timings_documented
+            << std::endl;
+
+ // Doc the checks (not the timings or element counts, which depend on
+ // the tetgen version) for validation
+ std::ofstream trace_file("RESLT/trace.dat");
+ trace_file << (n_element_after>n_element_before) << " "
+            << (max_error<1.0e-8) << " "
+            << timings_documented << std::endl;
+ trace_file.close();
+
+} // end of main
@@ -0,0 +1,466 @@
+//LIC// ====================================================================
+//LIC// This file forms part of oomph-lib, the object-oriented,
+//LIC// multi-physics finite-element library, available
+//LIC// at http://www.oomph-lib.org.
+//LIC//
+//LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+//LIC//
+//LIC// This library is free software; you can redistribute it and/or
+//LIC// modify it under the terms of the GNU Lesser General Public
+//LIC// License as published by the Free Software Foundation; either
+//LIC// version 2.1 of the License, or (at your option) any later version.
+//LIC//
+//LIC// This library is distributed in the hope that it will be useful,
+//LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+//LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//LIC// Lesser General Public License for more details.
+//LIC//
+//LIC// You should have received a copy of the GNU Lesser General Public
+//LIC// License along with this library; if not, write to the Free Software
+//LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+//LIC// 02110-1301  USA.
+//LIC//
+//LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+//LIC//
+//LIC//====================================================================
+// Check the analytic derivatives of the nodal positions w.r.t. the
+// geometric Data in a collapsible channel whose upper wall depends on
+// Data, for the algebraic and the MacroElement-based node updates:
+// compare them with finite differences of the node update, and compare
+// the element Jacobians obtained with the resulting chain-rule shape
+// derivatives with those obtained by direct finite differencing.
+
+//Generic routines
+#include "generic.h"
+
+// The Navier Stokes equations
+#include "navier_stokes.h"
+
+// The mesh
+#include "meshes/collapsible_channel_mesh.h"
+
+using namespace std;
+using namespace oomph;
+
+
+//==start_of_namespace====================================================
+/// Namespace for physical parameters
+//========================================================================
+namespace Global_Physical_Variables
+{
+ /// Reynolds number
+ double Re=50.0;
+
+ /// Womersley number
+ double ReSt=10.0;
+
+} // end of namespace
+
+
+
+//=======start_of_wall_class==============================================
+/// Upper wall of the collapsible segment: a bulge of amplitude A
+/// (which also shears the wall axially) superimposed on a uniform
+/// vertical displacement B. A and B are the two values of the
+/// geometric Data.
+//========================================================================
+class BulgedWall : public GeomObject
+{
+
+public:
+
+ /// Constructor: Pass the x-coordinate of the upstream end, the
+ /// length of the segment and the height of the undeformed wall
+ BulgedWall(const double& x_left, const double& length,
+            const double& height) :
+  GeomObject(1,2), X_left(x_left), Length(length), H(height)
+  {
+   // The wall is undeformed initially
+   Geom_data_pt.resize(1);
+   Geom_data_pt[0]=new Data(2);
+  }
+
+ /// Destructor: Clean up the Data
+ ~BulgedWall()
+  {
+   delete Geom_data_pt[0];
+  }
+
+ /// Position vector at Lagrangian coordinate zeta
+ void position(const Vector<double>& zeta, Vector<double>& r) const
+  {
+   double a=Geom_data_pt[0]->value(0);
+   double b=Geom_data_pt[0]->value(1);
+   double phi=MathematicalConstants::Pi*zeta[0]/Length;
+   r[0]=X_left+zeta[0]+0.2*a*sin(2.0*phi);
+   r[1]=H+b+a*sin(phi);
+  }
+
+ /// Position vector at time level t: The wall is steady
+ void position(const unsigned& t, const Vector<double>& zeta,
+               Vector<double>& r) const
+  {
+   position(zeta,r);
+  }
+
+ /// Analytic derivatives of the position vector w.r.t. A and B
+ void dposition_dgeom_data(
+  const Vector<double>& zeta,
+  std::map<Data*,DenseMatrix<double> >& dposition_dgeom_data)
+  {
+   double phi=MathematicalConstants::Pi*zeta[0]/Length;
+   dposition_dgeom_data.clear();
+   DenseMatrix<double>& dr_ddata=dposition_dgeom_data[Geom_data_pt[0]];
+   dr_ddata.resize(2,2,0.0);
+   dr_ddata(0,0)=0.2*sin(2.0*phi);
+   dr_ddata(1,0)=sin(phi);
+   dr_ddata(1,1)=1.0;
+  }
+
+ /// Number of geometric Data
+ unsigned ngeom_data() const {return 1;}
+
+ /// Pointer to the j-th geometric Data
+ Data* geom_data_pt(const unsigned& j) {return Geom_data_pt[0];}
+
+private:
+
+ /// x-coordinate of the upstream end of the segment
+ double X_left;
+
+ /// Length of the segment
+ double Length;
+
+ /// Height of the undeformed wall
+ double H;
+
+ /// Geometric Data: amplitude of the bulge and uniform displacement
+ Vector<Data*> Geom_data_pt;
+
+}; // end of wall class
+
+
+
+//=======start_of_problem_class===========================================
+/// Navier-Stokes flow in a collapsible channel whose wall shape depends
+/// on unknown (global) Data. MESH is the mesh with the node update
+/// to be tested.
+//========================================================================
+template <class ELEMENT, class MESH>
+class CollapsibleChannelProblem : public Problem
+{
+
+public:
+
+ /// Constructor
+ CollapsibleChannelProblem();
+
+ /// Destructor
+ ~CollapsibleChannelProblem()
+  {
+   delete mesh_pt();
+   delete Wall_pt;
+  }
+
+ /// Deform the wall and set a (smooth but otherwise arbitrary)
+ /// flow field
+ void set_state();
+
+ /// Compare the nodes' position sensitivities with finite differences
+ /// of their node update; return the max. difference
+ double check_position_sensitivities();
+
+ /// Compare the element Jacobians computed with chain-rule shape
+ /// derivatives with those computed by direct finite differencing;
+ /// return the max. difference, relative to the max. entry
+ double check_jacobians();
+
+ /// Pointer to the wall
+ BulgedWall* wall_pt() {return Wall_pt;}
+
+private:
+
+ /// Pointer to the wall
+ BulgedWall* Wall_pt;
+
+}; // end of problem class
+
+
+
+//=======start_of_constructor=============================================
+/// Constructor
+//========================================================================
+template <class ELEMENT, class MESH>
+CollapsibleChannelProblem<ELEMENT,MESH>::CollapsibleChannelProblem()
+{
+ // Geometry of the channel
+ unsigned nup=2;
+ unsigned ncollapsible=4;
+ unsigned ndown=2;
+ unsigned ny=4;
+ double lup=1.0;
+ double lcollapsible=2.0;
+ double ldown=1.0;
+ double ly=1.0;
+
+ // The wall, in its undeformed position
+ Wall_pt=new BulgedWall(lup,lcollapsible,ly);
+
+ // Build the mesh
+ Problem::mesh_pt()=new MESH(nup,ncollapsible,ndown,ny,
+                             lup,lcollapsible,ldown,ly,Wall_pt);
+
+ // The wall Data are unknowns (e.g. determined by a wall equation
+ // in an FSI problem)
+ add_global_data(Wall_pt->geom_data_pt(0));
+
+ // Pin the velocities on all boundaries apart from the outflow
+ // (boundary 1)
+ unsigned nbound=mesh_pt()->nboundary();
+ for (unsigned b=0;b<nbound;b++)
+  {
+   if (b!=1)
+    {
+     unsigned nnod=mesh_pt()->nboundary_node(b);
+     for (unsigned j=0;j<nnod;j++)
+      {
+       mesh_pt()->boundary_node_pt(b,j)->pin(0);
+       mesh_pt()->boundary_node_pt(b,j)->pin(1);
+      }
+    }
+  }
+
+ // Pass the physical parameters to the elements
+ unsigned nel=mesh_pt()->nelement();
+ for (unsigned e=0;e<nel;e++)
+  {
+   ELEMENT* el_pt=dynamic_cast<ELEMENT*>(mesh_pt()->element_pt(e));
+   el_pt->re_pt()=&Global_Physical_Variables::Re;
+   el_pt->re_st_pt()=&Global_Physical_Variables::ReSt;
+  }
+
+ // Setup equation numbering scheme
+ oomph_info << "Number of equations: " << assign_eqn_numbers() << std::endl;
+
+} // end of constructor
+
+
+
+//=======start_of_set_state===============================================
+/// Deform the wall and set a (smooth but otherwise arbitrary)
+/// flow field
+//========================================================================
+template <class ELEMENT, class MESH>
+void CollapsibleChannelProblem<ELEMENT,MESH>::set_state()
+{
+ // Deform the wall and update the nodal positions
+ Wall_pt->geom_data_pt(0)->set_value(0,0.3);
+ Wall_pt->geom_data_pt(0)->set_value(1,-0.1);
+ mesh_pt()->node_update();
+
+ // Set the nodal values
+ unsigned nnod=mesh_pt()->nnode();
+ for (unsigned j=0;j<nnod;j++)
+  {
+   Node* nod_pt=mesh_pt()->node_pt(j);
+   double x=nod_pt->x(0);
+   double y=nod_pt->x(1);
+   unsigned nval=nod_pt->nvalue();
+   for (unsigned i=0;i<nval;i++)
+    {
+     nod_pt->set_value(i,y*(1.0-y)+0.1*double(i)+0.2*sin(double(i+1)*x));
+    }
+  }
+} // end of set_state
+
+
+
+//=======start_of_check_position_sensitivities============================
+/// Compare the nodes' position sensitivities with finite differences
+/// of their node update; return the max. difference
+//========================================================================
+template <class ELEMENT, class MESH>
+double CollapsibleChannelProblem<ELEMENT,MESH>::
+check_position_sensitivities()
+{
+ double max_diff=0.0;
+ unsigned n_moving=0;
+ unsigned nnod=mesh_pt()->nnode();
+ for (unsigned j=0;j<nnod;j++)
+  {
+   Node* nod_pt=mesh_pt()->node_pt(j);
+
+   // Sensitivities provided by the node
+   std::map<Data*,DenseMatrix<double> > dx_ddata;
+   nod_pt->get_dposition_dgeom_data(dx_ddata);
+
+   // Finite difference version
+   std::map<Data*,DenseMatrix<double> > dx_ddata_fd;
+   nod_pt->Node::get_dposition_dgeom_data(dx_ddata_fd);
+
+   // Nodes outside the collapsible segment don't move; in the
+   // macro-element version they may still report zero sensitivities
+   // w.r.t. the wall Data
+   for (std::map<Data*,DenseMatrix<double> >::iterator it=
+         dx_ddata_fd.begin();it!=dx_ddata_fd.end();it++)
+    {
+     DenseMatrix<double>& fd=it->second;
+     std::map<Data*,DenseMatrix<double> >::iterator it_an=
+      dx_ddata.find(it->first);
+     bool moves=false;
+     for (unsigned i=0;i<fd.nrow();i++)
+      {
+       for (unsigned k=0;k<fd.ncol();k++)
+        {
+         double analytic=0.0;
+         if (it_an!=dx_ddata.end()) analytic=it_an->second(i,k);
+         max_diff=std::max(max_diff,std::fabs(analytic-fd(i,k)));
+         if (fd(i,k)!=0.0) moves=true;
+        }
+      }
+     if (moves) n_moving++;
+    }
+  }
+ oomph_info << "Nodes that depend on the wall: " << n_moving
+            << "; max. difference between analytic and FD position "
+            << "sensitivities: " << max_diff << std::endl;
+ return max_diff;
+} // end of check_position_sensitivities
+
+
+
+//=======start_of_check_jacobians=========================================
+/// Compare the element Jacobians computed with chain-rule shape
+/// derivatives with those computed by direct finite differencing;
+/// return the max. difference, relative to the max. entry
+//========================================================================
+template <class ELEMENT, class MESH>
+double CollapsibleChannelProblem<ELEMENT,MESH>::check_jacobians()
+{
+ double max_diff=0.0;
+ double max_entry=0.0;
+ double t_fd=0.0;
+ double t_chain=0.0;
+ unsigned nel=mesh_pt()->nelement();
+ for (unsigned e=0;e<nel;e++)
+  {
+   ELEMENT* el_pt=dynamic_cast<ELEMENT*>(mesh_pt()->element_pt(e));
+   unsigned ndof=el_pt->ndof();
+   Vector<double> residuals(ndof);
+   DenseMatrix<double> jac_fd(ndof,ndof,0.0);
+   DenseMatrix<double> jac_chain(ndof,ndof,0.0);
+
+   // Direct finite differencing of the residuals w.r.t. the
+   // geometric dofs
+   el_pt->evaluate_shape_derivs_by_direct_fd();
+   double t_start=TimingHelpers::timer();
+   el_pt->get_jacobian(residuals,jac_fd);
+   t_fd+=TimingHelpers::timer()-t_start;
+
+   // Chain rule, using the nodes' position sensitivities
+   el_pt->evaluate_shape_derivs_by_chain_rule(true);
+   t_start=TimingHelpers::timer();
+   el_pt->get_jacobian(residuals,jac_chain);
+   t_chain+=TimingHelpers::timer()-t_start;
+   el_pt->evaluate_shape_derivs_by_direct_fd();
+
+   for (unsigned i=0;i<ndof;i++)
+    {
+     for (unsigned j=0;j<ndof;j++)
+      {
+       max_entry=std::max(max_entry,std::fabs(jac_fd(i,j)));
+       max_diff=std::max(max_diff,std::fabs(jac_fd(i,j)-jac_chain(i,j)));
+      }
+    }
+  }
+ oomph_info << "Max. difference between the element Jacobians: "
+            << max_diff << " (max. entry: " << max_entry << ")\n"
+            << "Time for element Jacobians with direct FD: " << t_fd
+            << " sec; with chain rule: " << t_chain << " sec" << std::endl;
+ return max_diff/max_entry;
+} // end of check_jacobians
+
+
+
+//=======start_of_check_wall==============================================
+/// Compare the wall's analytic position derivatives with the
+/// GeomObject's finite difference default; return the max. difference
+//========================================================================
+double check_wall(BulgedWall* wall_pt)
+{
+ double max_diff=0.0;
+ Vector<double> zeta(1);
+ unsigned npt=11;
+ for (unsigned j=0;j<npt;j++)
+  {
+   zeta[0]=2.0*double(j)/double(npt-1);
+   std::map<Data*,DenseMatrix<double> > dr_ddata;
+   wall_pt->dposition_dgeom_data(zeta,dr_ddata);
+   std::map<Data*,DenseMatrix<double> > dr_ddata_fd;
+   wall_pt->GeomObject::dposition_dgeom_data(zeta,dr_ddata_fd);
+   DenseMatrix<double>& an=dr_ddata[wall_pt->geom_data_pt(0)];
+   DenseMatrix<double>& fd=dr_ddata_fd[wall_pt->geom_data_pt(0)];
+   for (unsigned i=0;i<2;i++)
+    {
+     for (unsigned k=0;k<2;k++)
+      {
+       max_diff=std::max(max_diff,std::fabs(an(i,k)-fd(i,k)));
+      }
+    }
+  }
+ oomph_info << "Max. difference between analytic and FD wall "
+            << "derivatives: " << max_diff << std::endl;
+ return max_diff;
+} // end of check_wall
+
+
+
+//=======start_of_run=====================================================
+/// Run the checks for the given element/mesh combination and doc
+/// the results (1/0 for passed/failed) in the trace file
+//========================================================================
+template <class ELEMENT, class MESH>
+void run(const std::string& label, std::ofstream& trace_file)
+{
+ oomph_info << "\n" << label << " node update\n";
+
+ // Tolerances for the differences between the analytic and finite
+ // difference derivatives, and for the relative difference between
+ // the Jacobians
+ double tol_position=1.0e-6;
+ double tol_jacobian=1.0e-6;
+
+ CollapsibleChannelProblem<ELEMENT,MESH> problem;
+ problem.set_state();
+
+ bool wall_ok=(check_wall(problem.wall_pt())<tol_position);
+ bool position_ok=(problem.check_position_sensitivities()<tol_position);
+ bool jacobian_ok=(problem.check_jacobians()<tol_jacobian);
+
+ trace_file << label << " " << wall_ok << " " << position_ok << " "
+            << jacobian_ok << std::endl;
+} // end of run
+
+
+
+//=======start_of_main====================================================
+/// Driver: Check the analytic position sensitivities for the
+/// algebraic and the MacroElement-based node update
+//========================================================================
+int main()
+{
+ std::ofstream trace_file("RESLT/trace.dat");
+
+ // Algebraic node update
+ run<AlgebraicElement<QTaylorHoodElement<2> >,
+     AlgebraicCollapsibleChannelMesh<
+      AlgebraicElement<QTaylorHoodElement<2> > > >("algebraic",trace_file);
+
+ // MacroElement-based node update
+ run<MacroElementNodeUpdateElement<QTaylorHoodElement<2> >,
+     MacroElementNodeUpdateCollapsibleChannelMesh<
+      MacroElementNodeUpdateElement<QTaylorHoodElement<2> > > >(
+       "macro_element",trace_file);
+
+ trace_file.close();
+} // end of main
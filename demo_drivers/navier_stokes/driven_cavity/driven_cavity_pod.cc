@@ -0,0 +1,253 @@
+//LIC// ====================================================================
+//LIC// This file forms part of oomph-lib, the object-oriented,
+//LIC// multi-physics finite-element library, available
+//LIC// at http://www.oomph-lib.org.
+//LIC//
+//LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+//LIC//
+//LIC// This library is free software; you can redistribute it and/or
+//LIC// modify it under the terms of the GNU Lesser General Public
+//LIC// License as published by the Free Software Foundation; either
+//LIC// version 2.1 of the License, or (at your option) any later version.
+//LIC//
+//LIC// This library is distributed in the hope that it will be useful,
+//LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+//LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//LIC// Lesser General Public License for more details.
+//LIC//
+//LIC// You should have received a copy of the GNU Lesser General Public
+//LIC// License along with this library; if not, write to the Free Software
+//LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+//LIC// 02110-1301  USA.
+//LIC//
+//LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+//LIC//
+//LIC//====================================================================
+// Driver for a POD-Galerkin reduced-order model of the 2D driven cavity
+// problem, parametrised by the Reynolds number: The reduced model is
+// built from full solutions at a set of Reynolds numbers and is then
+// used to compute the flow at intermediate Reynolds numbers, with and
+// without hyper-reduction. Finally, the full-model fallback is
+// demonstrated by extrapolating to a Reynolds number outside the
+// training range.
+
+//Generic routines
+#include "generic.h"
+
+// The Navier Stokes equations
+#include "navier_stokes.h"
+
+// The mesh
+#include "meshes/simple_rectangular_quadmesh.h"
+
+using namespace std;
+using namespace oomph;
+
+
+//==start_of_namespace====================================================
+/// Namespace for the problem parameters
+//========================================================================
+namespace Global_Parameters
+{
+ /// Number of elements in each coordinate direction
+ unsigned N_element=16;
+
+ /// Reynolds number
+ double Re=0.0;
+
+ /// Maximum Reynolds number for the snapshots
+ double Re_max=400.0;
+
+ /// Number of snapshots
+ unsigned N_snapshot=17;
+
+} // end of namespace
+
+
+
+//=====================================================================
+/// Steady driven cavity problem on the unit square
+//=====================================================================
+template<class ELEMENT>
+class DrivenCavityProblem : public Problem
+{
+
+public:
+
+ /// Constructor: Pass number of elements in each coordinate direction
+ DrivenCavityProblem(const unsigned& n)
+  {
+   Problem::mesh_pt()=new SimpleRectangularQuadMesh<ELEMENT>(n,n,1.0,1.0);
+
+   // No slip on all boundaries; unit tangential velocity on the lid
+   // (boundary 2)
+   unsigned n_bound=mesh_pt()->nboundary();
+   for (unsigned b=0;b<n_bound;b++)
+    {
+     unsigned n_node=mesh_pt()->nboundary_node(b);
+     for (unsigned j=0;j<n_node;j++)
+      {
+       Node* nod_pt=mesh_pt()->boundary_node_pt(b,j);
+       nod_pt->pin(0);
+       nod_pt->pin(1);
+       if (b==2)
+        {
+         nod_pt->set_value(0,1.0);
+        }
+      }
+    }
+
+   // Set the Reynolds number
+   unsigned n_element=mesh_pt()->nelement();
+   for (unsigned e=0;e<n_element;e++)
+    {
+     ELEMENT* el_pt=dynamic_cast<ELEMENT*>(mesh_pt()->element_pt(e));
+     el_pt->re_pt()=&Global_Parameters::Re;
+    }
+
+   // Pin one pressure value
+   dynamic_cast<ELEMENT*>(mesh_pt()->element_pt(0))->fix_pressure(0,0.0);
+
+   oomph_info << "Number of equations: " << assign_eqn_numbers()
+              << std::endl;
+  }
+
+}; // end of DrivenCavityProblem
+
+
+
+//=====================================================================
+/// Return the maximum difference between the problem's dofs and
+/// the reference values
+//=====================================================================
+double max_difference(Problem& problem, const DoubleVector& reference)
+{
+ double max_diff=0.0;
+ unsigned long n_dof=problem.ndof();
+ for (unsigned long i=0;i<n_dof;i++)
+  {
+   max_diff=std::max(max_diff,std::fabs(problem.dof(i)-reference[i]));
+  }
+ return max_diff;
+}
+
+
+
+//=====================================================================
+/// Driver: Build the reduced-order model and compare its solutions
+/// and timings with those of the full model
+//=====================================================================
+int main(int argc, char **argv)
+{
+ // Store command line arguments
+ CommandLineArgs::setup(argc,argv);
+
+ // Number of elements can be specified on the command line
+ CommandLineArgs::specify_command_line_flag(
+  "--n_element",&Global_Parameters::N_element);
+ CommandLineArgs::parse_and_assign();
+ CommandLineArgs::doc_specified_flags();
+
+ DrivenCavityProblem<QTaylorHoodElement<2> >
+  problem(Global_Parameters::N_element);
+ problem.disable_info_in_newton_solve();
+
+ PODGalerkinModel reduced_model(&problem);
+ reduced_model.enable_doc_time();
+
+ // Offline: Compute the snapshots by continuation in the Reynolds
+ // number
+ //---------------------------------------------------------------
+ unsigned n_snapshot=Global_Parameters::N_snapshot;
+ double dre=Global_Parameters::Re_max/double(n_snapshot-1);
+ double t_start=TimingHelpers::timer();
+ for (unsigned i=0;i<n_snapshot;i++)
+  {
+   Global_Parameters::Re=double(i)*dre;
+   problem.newton_solve();
+   reduced_model.add_snapshot();
+  }
+ oomph_info << "Time for " << n_snapshot << " full solves [sec]: "
+            << TimingHelpers::timer()-t_start << std::endl;
+
+ // Build the basis
+ reduced_model.energy_tolerance()=1.0e-10;
+ reduced_model.build_basis();
+
+ // Train the hyper-reduction at the snapshots
+ for (unsigned i=0;i<n_snapshot;i++)
+  {
+   Global_Parameters::Re=double(i)*dre;
+   reduced_model.assign_snapshot(i);
+   reduced_model.add_hyper_reduction_training_point();
+  }
+
+ // Output for the results
+ std::ofstream trace_file("RESLT/trace.dat");
+ trace_file << "# Re hyper_reduction t_full t_reduced max_diff"
+            << std::endl;
+
+ // Online: Solve at the Reynolds numbers half way between the
+ // snapshots, starting from the solution at the previous snapshot,
+ // without and with hyper-reduction
+ //----------------------------------------------------------------
+ for (unsigned hyper=0;hyper<2;hyper++)
+  {
+   if (hyper==1)
+    {
+     reduced_model.hyper_reduction_tolerance()=1.0e-5;
+     reduced_model.setup_hyper_reduction();
+    }
+   for (unsigned i=0;i<n_snapshot-1;i++)
+    {
+     Global_Parameters::Re=(double(i)+0.5)*dre;
+
+     // Full solution
+     reduced_model.assign_snapshot(i);
+     t_start=TimingHelpers::timer();
+     problem.newton_solve();
+     double t_full=TimingHelpers::timer()-t_start;
+     DoubleVector full_dofs;
+     problem.get_dofs(full_dofs);
+
+     // Reduced solution
+     reduced_model.assign_snapshot(i);
+     t_start=TimingHelpers::timer();
+     reduced_model.newton_solve();
+     double t_reduced=TimingHelpers::timer()-t_start;
+     double diff=max_difference(problem,full_dofs);
+
+     std::string label=(hyper==0) ? "reduced" : "hyper-reduced";
+     oomph_info << "Re = " << Global_Parameters::Re
+                << ": full solve: " << t_full << " sec; " << label
+                << " solve: " << t_reduced << " sec; max. difference: "
+                << diff << std::endl;
+     trace_file << Global_Parameters::Re << " " << hyper << " "
+                << t_full << " " << t_reduced << " " << diff << std::endl;
+    }
+  }
+
+ // Use the residuals of the full model as an error indicator: Solve
+ // within the training range, and far outside it, where the reduced
+ // model is not expected to be accurate and the full model is used
+ //--------------------------------------------------------------------
+ reduced_model.enable_full_model_fallback(1.0e-2);
+ for (unsigned i=0;i<2;i++)
+  {
+   Global_Parameters::Re=(i==0) ? 0.5*Global_Parameters::Re_max+0.5*dre
+                                : 2.0*Global_Parameters::Re_max;
+   reduced_model.assign_snapshot((i==0) ? n_snapshot/2 : n_snapshot-1);
+   reduced_model.newton_solve();
+   oomph_info << "Re = " << Global_Parameters::Re
+              << ": error indicator: " << reduced_model.error_indicator()
+              << "; full model used: " << reduced_model.full_model_was_used()
+              << std::endl;
+   trace_file << "# Re = " << Global_Parameters::Re
+              << " error_indicator " << reduced_model.error_indicator()
+              << " full_model_used " << reduced_model.full_model_was_used()
+              << std::endl;
+  }
+
+ trace_file.close();
+
+} // end of main
@@ -0,0 +1,289 @@
+//LIC// ====================================================================
+//LIC// This file forms part of oomph-lib, the object-oriented,
+//LIC// multi-physics finite-element library, available
+//LIC// at http://www.oomph-lib.org.
+//LIC//
+//LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+//LIC//
+//LIC// This library is free software; you can redistribute it and/or
+//LIC// modify it under the terms of the GNU Lesser General Public
+//LIC// License as published by the Free Software Foundation; either
+//LIC// version 2.1 of the License, or (at your option) any later version.
+//LIC//
+//LIC// This library is distributed in the hope that it will be useful,
+//LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+//LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//LIC// Lesser General Public License for more details.
+//LIC//
+//LIC// You should have received a copy of the GNU Lesser General Public
+//LIC// License along with this library; if not, write to the Free Software
+//LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+//LIC// 02110-1301  USA.
+//LIC//
+//LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+//LIC//
+//LIC//====================================================================
+// Compare the number of timesteps required by the variable-order BDF
+// timestepper with those required by the adaptive BDF<2> timestepper
+// for two ODEs:
+//
+// (i)  the Prothero-Robinson problem y' = lambda (y - g) + g' with
+//      lambda=-10, whose solution is g(t) = sin(t) + cos(3t), for
+//      0 < t < 20, and
+//
+// (ii) the harmonic oscillator y0' = y1, y1' = -y0, whose solution is
+//      y0 = cos(t), y1 = -sin(t), for 0 < t < 50,
+//
+// at a range of tolerances for the temporal error.
+
+//Generic routines
+#include "generic.h"
+
+// The ODE elements
+#include "ode.h"
+
+using namespace std;
+using namespace oomph;
+
+
+//=====================================================================
+/// The Prothero-Robinson problem, y' = lambda (y - g) + g', with
+/// solution y = g(t) = sin(t) + cos(3t)
+//=====================================================================
+class ProtheroRobinsonSolution : public SolutionFunctorBase
+{
+
+public:
+
+ /// Constructor: Pass lambda
+ ProtheroRobinsonSolution(const double& lambda) : Lambda(lambda) {}
+
+ /// The solution
+ Vector<double> operator()(const double& t, const Vector<double>& x) const
+  {
+   Vector<double> y(1);
+   y[0]=sin(t)+cos(3.0*t);
+   return y;
+  }
+
+ /// The right-hand side of the ODE
+ Vector<double> derivative(const double& t,
+                           const Vector<double>& x,
+                           const Vector<double>& u) const
+  {
+   Vector<double> dydt(1);
+   dydt[0]=Lambda*(u[0]-sin(t)-cos(3.0*t))+cos(t)-3.0*sin(3.0*t);
+   return dydt;
+  }
+
+private:
+
+ /// Stiffness parameter
+ double Lambda;
+
+};
+
+
+
+//=====================================================================
+/// The harmonic oscillator, y0' = y1, y1' = -y0, with solution
+/// y0 = cos(t), y1 = -sin(t)
+//=====================================================================
+class HarmonicOscillatorSolution : public SolutionFunctorBase
+{
+
+public:
+
+ /// The solution
+ Vector<double> operator()(const double& t, const Vector<double>& x) const
+  {
+   Vector<double> y(2);
+   y[0]=cos(t);
+   y[1]=-sin(t);
+   return y;
+  }
+
+ /// The right-hand side of the ODE
+ Vector<double> derivative(const double& t,
+                           const Vector<double>& x,
+                           const Vector<double>& u) const
+  {
+   Vector<double> dydt(2);
+   dydt[0]=u[1];
+   dydt[1]=-u[0];
+   return dydt;
+  }
+
+};
+
+
+
+//=====================================================================
+/// Problem that integrates an ODE with an adaptive timestepper
+//=====================================================================
+class ODEProblem : public Problem
+{
+
+public:
+
+ /// Constructor: Pass the timestepper and the solution (whose
+ /// derivative function defines the ODE)
+ ODEProblem(TimeStepper* time_stepper_pt,
+            SolutionFunctorBase* solution_pt)
+  {
+   add_time_stepper_pt(time_stepper_pt);
+   Problem::mesh_pt()=new Mesh;
+   Element_pt=new ODEElement(time_stepper_pt,solution_pt);
+   mesh_pt()->add_element_pt(Element_pt);
+   assign_eqn_numbers();
+  }
+
+ /// Destructor: Clean up
+ ~ODEProblem()
+  {
+   delete mesh_pt();
+   delete time_stepper_pt();
+  }
+
+ /// Global temporal error norm: rms of the errors in the values
+ double global_temporal_error_norm()
+  {
+   Data* data_pt=Element_pt->internal_data_pt(0);
+   unsigned n_value=data_pt->nvalue();
+   double error=0.0;
+   for (unsigned j=0;j<n_value;j++)
+    {
+     double error_j=time_stepper_pt()->temporal_error_in_value(data_pt,j);
+     error+=error_j*error_j;
+    }
+   return sqrt(error/double(n_value));
+  }
+
+ /// Set the initial condition (impulsive start) and the initial timestep
+ void set_initial_condition(const double& dt)
+  {
+   initialise_dt(dt);
+   Vector<double> y=Element_pt->exact_solution(0.0);
+   Data* data_pt=Element_pt->internal_data_pt(0);
+   unsigned n_value=y.size();
+   for (unsigned j=0;j<n_value;j++)
+    {
+     data_pt->set_value(j,y[j]);
+    }
+   time_stepper_pt()->assign_initial_values_impulsive(data_pt);
+  }
+
+ /// Max. error in the values at the current time
+ double error()
+  {
+   Vector<double> y=Element_pt->exact_solution(time());
+   Data* data_pt=Element_pt->internal_data_pt(0);
+   double max_error=0.0;
+   unsigned n_value=y.size();
+   for (unsigned j=0;j<n_value;j++)
+    {
+     max_error=std::max(max_error,std::fabs(y[j]-data_pt->value(j)));
+    }
+   return max_error;
+  }
+
+private:
+
+ /// The (only) element
+ ODEElement* Element_pt;
+
+};
+
+
+
+//=====================================================================
+/// Integrate the ODE up to t_max with the given timestepper and
+/// tolerance; return the number of timesteps and the max. error
+//=====================================================================
+unsigned run(const std::string& label,
+             TimeStepper* time_stepper_pt,
+             SolutionFunctorBase* solution_pt,
+             const double& tolerance,
+             const double& t_max,
+             double& max_error)
+{
+ ODEProblem problem(time_stepper_pt,solution_pt);
+ problem.linear_solver_pt()->disable_doc_time();
+
+ // Start with a small timestep; the adaptation will increase it
+ double dt=1.0e-4;
+ problem.set_initial_condition(dt);
+
+ // Suppress the output from the Newton solver
+ std::ostream* saved_stream_pt=oomph_info.stream_pt();
+ oomph_info.stream_pt()=&oomph_nullstream;
+ unsigned n_step=0;
+ max_error=0.0;
+ while (problem.time()<t_max)
+  {
+   dt=problem.adaptive_unsteady_newton_solve(dt,tolerance);
+   n_step++;
+   max_error=std::max(max_error,problem.error());
+  }
+ oomph_info.stream_pt()=saved_stream_pt;
+
+ oomph_info << label << ": tolerance " << tolerance << ": " << n_step
+            << " timesteps; max. error " << max_error;
+ VariableOrderBDF* variable_order_bdf_pt=
+  dynamic_cast<VariableOrderBDF*>(time_stepper_pt);
+ if (variable_order_bdf_pt!=0)
+  {
+   oomph_info << "; " << variable_order_bdf_pt->nrejected_timestep()
+              << " rejected; accepted at orders 1 to "
+              << variable_order_bdf_pt->max_order() << ":";
+   for (unsigned k=1;k<=variable_order_bdf_pt->max_order();k++)
+    {
+     oomph_info << " " << variable_order_bdf_pt->naccepted_timestep()[k];
+    }
+  }
+ oomph_info << std::endl;
+
+ return n_step;
+}
+
+
+
+//=====================================================================
+/// Driver
+//=====================================================================
+int main()
+{
+ ProtheroRobinsonSolution prothero_robinson(-10.0);
+ HarmonicOscillatorSolution harmonic_oscillator;
+ SolutionFunctorBase* solution_pt[2]={&prothero_robinson,
+                                      &harmonic_oscillator};
+ std::string label[2]={"Prothero-Robinson","Harmonic oscillator"};
+ double t_max[2]={20.0,50.0};
+ double tolerance[3]={1.0e-4,1.0e-6,1.0e-8};
+
+ std::ofstream trace_file("RESLT/trace.dat");
+ trace_file << "# tolerance n_step_bdf2 n_step_variable_order "
+            << "fewer_steps smaller_error" << std::endl;
+ for (unsigned c=0;c<2;c++)
+  {
+   oomph_info << label[c] << std::endl;
+   for (unsigned i=0;i<3;i++)
+    {
+     double error_bdf2=0.0;
+     unsigned n_step_bdf2=run("BDF<2>",new BDF<2>(true),solution_pt[c],
+                              tolerance[i],t_max[c],error_bdf2);
+     double error_variable_order=0.0;
+     unsigned n_step_variable_order=
+      run("VariableOrderBDF",new VariableOrderBDF,solution_pt[c],
+          tolerance[i],t_max[c],error_variable_order);
+
+     trace_file << tolerance[i] << " " << n_step_bdf2 << " "
+                << n_step_variable_order << " "
+                << (n_step_variable_order<n_step_bdf2) << " "
+                << (error_variable_order<error_bdf2) << std::endl;
+    }
+   trace_file << std::endl;
+  }
+ trace_file.close();
+
+} // end of main
@@ -0,0 +1,531 @@
+//LIC// ====================================================================
+//LIC// This file forms part of oomph-lib, the object-oriented,
+//LIC// multi-physics finite-element library, available
+//LIC// at http://www.oomph-lib.org.
+//LIC//
+//LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+//LIC//
+//LIC// This library is free software; you can redistribute it and/or
+//LIC// modify it under the terms of the GNU Lesser General Public
+//LIC// License as published by the Free Software Foundation; either
+//LIC// version 2.1 of the License, or (at your option) any later version.
+//LIC//
+//LIC// This library is distributed in the hope that it will be useful,
+//LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+//LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//LIC// Lesser General Public License for more details.
+//LIC//
+//LIC// You should have received a copy of the GNU Lesser General Public
+//LIC// License along with this library; if not, write to the Free Software
+//LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+//LIC// 02110-1301  USA.
+//LIC//
+//LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+//LIC//
+//LIC//====================================================================
+// Driver that checks threaded mesh adaptation against the serial version:
+// The same 2D Poisson problem is refined and unrefined (selectively,
+// by error-driven adaptation and uniformly) with and without
+// TreeBasedRefineableMeshBase::enable_threaded_adaptation(). After every
+// step we compare the number of elements and nodes, the hanging node
+// schemes (master nodes and weights) and the solutions.
+
+// Generic oomph-lib headers
+#include "generic.h"
+
+// The Poisson equations
+#include "poisson.h"
+
+// The mesh
+#include "meshes/rectangular_quadmesh.h"
+
+using namespace std;
+
+using namespace oomph;
+
+//===== start_of_namespace=============================================
+/// Namespace for exact solution for Poisson equation with "sharp step"
+//=====================================================================
+namespace TanhSolnForPoisson
+{
+
+ /// Parameter for steepness of "step"
+ double Alpha=10.0;
+
+ /// Parameter for angle Phi of "step"
+ double TanPhi=0.5;
+
+ /// Exact solution as a Vector
+ void get_exact_u(const Vector<double>& x, Vector<double>& u)
+ {
+  u[0]=tanh(1.0-Alpha*(TanPhi*x[0]-x[1]));
+ }
+
+ /// Source function required to make the solution above an exact solution
+ void get_source(const Vector<double>& x, double& source)
+ {
+  source = 2.0*tanh(-1.0+Alpha*(TanPhi*x[0]-x[1]))*
+   (1.0-pow(tanh(-1.0+Alpha*(TanPhi*x[0]-x[1])),2.0))*
+   Alpha*Alpha*TanPhi*TanPhi+2.0*tanh(-1.0+Alpha*(TanPhi*x[0]-x[1]))*
+   (1.0-pow(tanh(-1.0+Alpha*(TanPhi*x[0]-x[1])),2.0))*Alpha*Alpha;
+ }
+
+} // end of namespace
+
+
+
+//====== start_of_problem_class=======================================
+/// 2D Poisson problem on rectangular domain, discretised with
+/// refineable 2D QPoisson elements. The specific type of element is
+/// specified via the template parameter.
+//====================================================================
+template<class ELEMENT>
+class RefineablePoissonProblem : public Problem
+{
+
+public:
+
+ /// Constructor: Pass flag indicating if the mesh is to be
+ /// adapted with threads
+ RefineablePoissonProblem(const bool& use_threaded_adaptation);
+
+ /// Destructor: Cleanup
+ ~RefineablePoissonProblem()
+  {
+   delete mesh_pt()->spatial_error_estimator_pt();
+   delete Problem::mesh_pt();
+  }
+
+ /// Update the problem specs before solve: Reset boundary conditions
+ /// to the values from the exact solution.
+ void actions_before_newton_solve();
+
+ /// Update the problem after solve (empty)
+ void actions_after_newton_solve(){}
+
+ /// Overloaded version of the problem's access function to
+ /// the mesh. Recasts the pointer to the base Mesh object to
+ /// the actual mesh type.
+ RefineableRectangularQuadMesh<ELEMENT>* mesh_pt()
+  {
+   return dynamic_cast<RefineableRectangularQuadMesh<ELEMENT>*>(
+    Problem::mesh_pt());
+  }
+
+ /// Record the number of elements and nodes in the mesh
+ void get_counts(Vector<unsigned>& counts);
+
+ /// Record the hanging node schemes: For every node and every value
+ /// (including the geometric one) record whether it hangs and, if so,
+ /// the numbers of its master nodes and their weights.
+ void get_hanging_schemes(Vector<double>& hanging_data);
+
+ /// Record the nodal positions and the nodal values
+ void get_solution(Vector<double>& solution);
+
+}; // end of problem class
+
+
+
+
+//=====start_of_constructor===============================================
+/// Constructor for Poisson problem: Pass flag indicating if the mesh
+/// is to be adapted with threads
+//========================================================================
+template<class ELEMENT>
+RefineablePoissonProblem<ELEMENT>::
+RefineablePoissonProblem(const bool& use_threaded_adaptation)
+{
+
+ // Setup mesh: Use several elements (i.e. trees in the forest) so
+ // that the threads have different trees to work on
+
+ // # of elements in x-direction
+ unsigned n_x=4;
+
+ // # of elements in y-direction
+ unsigned n_y=4;
+
+ // Domain length in x-direction
+ double l_x=1.0;
+
+ // Domain length in y-direction
+ double l_y=2.0;
+
+ // Build and assign mesh
+ Problem::mesh_pt()=
+  new RefineableRectangularQuadMesh<ELEMENT>(n_x,n_y,l_x,l_y);
+
+ // Create/set error estimator
+ mesh_pt()->spatial_error_estimator_pt()=new Z2ErrorEstimator;
+
+ // Set error targets for adaptive refinement
+ mesh_pt()->max_permitted_error()=1.0e-3;
+ mesh_pt()->min_permitted_error()=1.0e-5;
+
+ // Switch on threaded adaptation if required
+ if (use_threaded_adaptation)
+  {
+   mesh_pt()->enable_threaded_adaptation();
+  }
+
+ // Set the boundary conditions for this problem: All nodes are
+ // free by default -- just pin the ones that have Dirichlet conditions
+ // here.
+ unsigned num_bound = mesh_pt()->nboundary();
+ for(unsigned ibound=0;ibound<num_bound;ibound++)
+  {
+   unsigned num_nod= mesh_pt()->nboundary_node(ibound);
+   for (unsigned inod=0;inod<num_nod;inod++)
+    {
+     mesh_pt()->boundary_node_pt(ibound,inod)->pin(0);
+    }
+  }
+
+ // Complete the build of all elements so they are fully functional
+
+ // Loop over the elements to set up element-specific
+ // things that cannot be handled by the (argument-free!) ELEMENT
+ // constructor: Pass pointer to source function
+ unsigned n_element = mesh_pt()->nelement();
+ for(unsigned i=0;i<n_element;i++)
+  {
+   // Upcast from GeneralisedElement to the present element
+   ELEMENT *el_pt = dynamic_cast<ELEMENT*>(mesh_pt()->element_pt(i));
+
+   //Set the source function pointer
+   el_pt->source_fct_pt() = &TanhSolnForPoisson::get_source;
+  }
+
+ // Setup equation numbering scheme
+ assign_eqn_numbers();
+
+} // end of constructor
+
+
+
+
+//=================================start_of_actions_before_newton_solve===
+/// Update the problem specs before solve: (Re-)set boundary conditions
+/// to the values from the exact solution.
+//========================================================================
+template<class ELEMENT>
+void RefineablePoissonProblem<ELEMENT>::actions_before_newton_solve()
+{
+ // How many boundaries are there?
+ unsigned num_bound = mesh_pt()->nboundary();
+
+ //Loop over the boundaries
+ for(unsigned ibound=0;ibound<num_bound;ibound++)
+  {
+   // How many nodes are there on this boundary?
+   unsigned num_nod=mesh_pt()->nboundary_node(ibound);
+
+   // Loop over the nodes on boundary
+   for (unsigned inod=0;inod<num_nod;inod++)
+    {
+     // Get pointer to node
+     Node* nod_pt=mesh_pt()->boundary_node_pt(ibound,inod);
+
+     // Extract nodal coordinates from node:
+     Vector<double> x(2);
+     x[0]=nod_pt->x(0);
+     x[1]=nod_pt->x(1);
+
+     // Compute the value of the exact solution at the nodal point
+     Vector<double> u(1);
+     TanhSolnForPoisson::get_exact_u(x,u);
+
+     // Assign the value to the one (and only) nodal value at this node
+     nod_pt->set_value(0,u[0]);
+    }
+  }
+}  // end of actions before solve
+
+
+
+
+//=====================start_of_get_counts================================
+/// Record the number of elements and nodes in the mesh
+//========================================================================
+template<class ELEMENT>
+void RefineablePoissonProblem<ELEMENT>::get_counts(Vector<unsigned>& counts)
+{
+ counts.resize(2);
+ counts[0]=mesh_pt()->nelement();
+ counts[1]=mesh_pt()->nnode();
+}
+
+
+
+//=====================start_of_get_hanging_schemes=======================
+/// Record the hanging node schemes: For every node and every value
+/// (including the geometric one) record whether it hangs and, if so,
+/// the numbers of its master nodes and their weights.
+//========================================================================
+template<class ELEMENT>
+void RefineablePoissonProblem<ELEMENT>::
+get_hanging_schemes(Vector<double>& hanging_data)
+{
+ hanging_data.clear();
+
+ // Number the nodes so we can identify the master nodes
+ std::map<Node*,unsigned> node_number;
+ unsigned n_node=mesh_pt()->nnode();
+ for (unsigned j=0;j<n_node;j++)
+  {
+   node_number[mesh_pt()->node_pt(j)]=j;
+  }
+
+ // Loop over the nodes
+ for (unsigned j=0;j<n_node;j++)
+  {
+   Node* nod_pt=mesh_pt()->node_pt(j);
+
+   // Loop over the values, starting with the geometric hanging scheme
+   int n_value=nod_pt->nvalue();
+   for (int i=-1;i<n_value;i++)
+    {
+     if (nod_pt->is_hanging(i))
+      {
+       // The order of the master nodes depends on their addresses
+       // so sort them by their numbers. Master nodes that are not in
+       // the mesh are flagged by -1.
+       HangInfo* hang_pt=nod_pt->hanging_pt(i);
+       std::multimap<int,double> master_weight;
+       unsigned n_master=hang_pt->nmaster();
+       for (unsigned m=0;m<n_master;m++)
+        {
+         int master_number=-1;
+         std::map<Node*,unsigned>::iterator it=
+          node_number.find(hang_pt->master_node_pt(m));
+         if (it!=node_number.end())
+          {
+           master_number=int(it->second);
+          }
+         master_weight.insert(std::make_pair(master_number,
+                                             hang_pt->master_weight(m)));
+        }
+       hanging_data.push_back(double(n_master));
+       for (std::multimap<int,double>::iterator it=master_weight.begin();
+            it!=master_weight.end();it++)
+        {
+         hanging_data.push_back(double(it->first));
+         hanging_data.push_back(it->second);
+        }
+      }
+     else
+      {
+       hanging_data.push_back(0.0);
+      }
+    }
+  }
+}
+
+
+
+//=====================start_of_get_solution==============================
+/// Record the nodal positions and the nodal values
+//========================================================================
+template<class ELEMENT>
+void RefineablePoissonProblem<ELEMENT>::get_solution(Vector<double>& solution)
+{
+ solution.clear();
+ unsigned n_node=mesh_pt()->nnode();
+ for (unsigned j=0;j<n_node;j++)
+  {
+   Node* nod_pt=mesh_pt()->node_pt(j);
+   solution.push_back(nod_pt->x(0));
+   solution.push_back(nod_pt->x(1));
+   solution.push_back(nod_pt->value(0));
+  }
+}
+
+
+
+//=====================start_of_compare===================================
+/// Compare the state of the two problems and doc the outcome:
+/// Return true if the element/node counts, the hanging node schemes
+/// and the solutions agree.
+//========================================================================
+template<class ELEMENT>
+bool compare(const std::string& label,
+             RefineablePoissonProblem<ELEMENT>& serial_problem,
+             RefineablePoissonProblem<ELEMENT>& threaded_problem,
+             ofstream& trace_file)
+{
+ // Tolerance for the comparison of the weights and the solution
+ double tol=1.0e-12;
+
+ // Compare the numbers of elements and nodes
+ Vector<unsigned> serial_counts, threaded_counts;
+ serial_problem.get_counts(serial_counts);
+ threaded_problem.get_counts(threaded_counts);
+ bool counts_ok=(serial_counts==threaded_counts);
+
+ // Compare the hanging node schemes
+ Vector<double> serial_hanging, threaded_hanging;
+ serial_problem.get_hanging_schemes(serial_hanging);
+ threaded_problem.get_hanging_schemes(threaded_hanging);
+ bool hanging_ok=(serial_hanging.size()==threaded_hanging.size());
+ unsigned n_hanging_node=0;
+ if (hanging_ok)
+  {
+   unsigned n=serial_hanging.size();
+   for (unsigned i=0;i<n;i++)
+    {
+     if (std::fabs(serial_hanging[i]-threaded_hanging[i])>tol)
+      {
+       hanging_ok=false;
+      }
+    }
+  }
+ unsigned n_node=serial_problem.mesh_pt()->nnode();
+ for (unsigned j=0;j<n_node;j++)
+  {
+   if (serial_problem.mesh_pt()->node_pt(j)->is_hanging())
+    {
+     n_hanging_node++;
+    }
+  }
+
+ // Compare the solutions
+ Vector<double> serial_soln, threaded_soln;
+ serial_problem.get_solution(serial_soln);
+ threaded_problem.get_solution(threaded_soln);
+ bool solution_ok=(serial_soln.size()==threaded_soln.size());
+ double max_diff=0.0;
+ if (solution_ok)
+  {
+   unsigned n=serial_soln.size();
+   for (unsigned i=0;i<n;i++)
+    {
+     max_diff=std::max(max_diff,std::fabs(serial_soln[i]-threaded_soln[i]));
+    }
+   solution_ok=(max_diff<tol);
+  }
+
+ oomph_info << label << ": "
+            << serial_counts[0] << " elements, "
+            << serial_counts[1] << " nodes, "
+            << n_hanging_node << " hanging nodes; "
+            << "max. difference in solution: " << max_diff << std::endl;
+
+ trace_file << label << " "
+            << counts_ok << " "
+            << hanging_ok << " "
+            << solution_ok << std::endl;
+
+ return counts_ok && hanging_ok && solution_ok;
+}
+
+
+
+//=====================start_of_main======================================
+/// Refine and unrefine the same problem with serial and threaded
+/// mesh adaptation and compare the outcomes after each step.
+//========================================================================
+int main()
+{
+ // Shorthand for the element type
+ typedef RefineableQPoissonElement<2,2> ELEMENT;
+
+ // Build the problems
+ RefineablePoissonProblem<ELEMENT> serial_problem(false);
+ RefineablePoissonProblem<ELEMENT> threaded_problem(true);
+ RefineablePoissonProblem<ELEMENT>* problem_pt[2];
+ problem_pt[0]=&serial_problem;
+ problem_pt[1]=&threaded_problem;
+
+ // Open trace file
+ DocInfo doc_info;
+ doc_info.set_directory("RESLT");
+ ofstream trace_file;
+ char filename[100];
+ sprintf(filename,"%s/trace.dat",doc_info.directory().c_str());
+ trace_file.open(filename);
+
+ bool all_ok=true;
+
+ // Refine selected elements twice so that some of the master nodes
+ //----------------------------------------------------------------
+ // of the hanging nodes are hanging themselves
+ //--------------------------------------------
+ for (unsigned p=0;p<2;p++)
+  {
+   // Refine the elements in the second column: The corner nodes of
+   // their sons that are located on the edges of the (unrefined)
+   // elements in the first column are hanging...
+   Vector<unsigned> elements_to_be_refined;
+   elements_to_be_refined.push_back(1);
+   elements_to_be_refined.push_back(5);
+   elements_to_be_refined.push_back(9);
+   elements_to_be_refined.push_back(13);
+   problem_pt[p]->refine_selected_elements(elements_to_be_refined);
+
+   // ...and so are some of the master nodes of the hanging nodes created
+   // by refining the north-west sons once more
+   elements_to_be_refined.clear();
+   unsigned n_element=problem_pt[p]->mesh_pt()->nelement();
+   for (unsigned e=0;e<n_element;e++)
+    {
+     RefineableQElement<2>* el_pt=dynamic_cast<RefineableQElement<2>*>(
+      problem_pt[p]->mesh_pt()->element_pt(e));
+     if ((el_pt->tree_pt()->level()==1)&&(el_pt->tree_pt()->son_type()==
+                                          QuadTreeNames::NW))
+      {
+       elements_to_be_refined.push_back(e);
+      }
+    }
+   problem_pt[p]->refine_selected_elements(elements_to_be_refined);
+   problem_pt[p]->newton_solve();
+  }
+ all_ok=compare("selective_refinement",serial_problem,threaded_problem,
+                trace_file) && all_ok;
+
+ // Error-driven adaptation
+ //------------------------
+ unsigned max_adapt=3;
+ for (unsigned i=0;i<max_adapt;i++)
+  {
+   for (unsigned p=0;p<2;p++)
+    {
+     problem_pt[p]->adapt();
+     problem_pt[p]->newton_solve();
+    }
+   char label[100];
+   sprintf(label,"adapt%i",i);
+   all_ok=compare(label,serial_problem,threaded_problem,trace_file) && all_ok;
+  }
+
+ // Uniform refinement
+ //-------------------
+ for (unsigned p=0;p<2;p++)
+  {
+   problem_pt[p]->refine_uniformly();
+   problem_pt[p]->newton_solve();
+  }
+ all_ok=compare("uniform_refinement",serial_problem,threaded_problem,
+                trace_file) && all_ok;
+
+ // Uniform unrefinement
+ //---------------------
+ for (unsigned p=0;p<2;p++)
+  {
+   problem_pt[p]->unrefine_uniformly();
+   problem_pt[p]->newton_solve();
+  }
+ all_ok=compare("uniform_unrefinement",serial_problem,threaded_problem,
+                trace_file) && all_ok;
+
+ trace_file.close();
+
+ if (!all_ok)
+  {
+   oomph_info << "Serial and threaded adaptation differ!" << std::endl;
+   return 1;
+  }
+
+ return 0;
+
+} // end of main
@@ -0,0 +1,283 @@
+//LIC// ====================================================================
+//LIC// This file forms part of oomph-lib, the object-oriented, 
+//LIC// multi-physics finite-element library, available 
+//LIC// at http://www.oomph-lib.org.
+//LIC// 
+//LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+//LIC// 
+//LIC// This library is free software; you can redistribute it and/or
+//LIC// modify it under the terms of the GNU Lesser General Public
+//LIC// License as published by the Free Software Foundation; either
+//LIC// version 2.1 of the License, or (at your option) any later version.
+//LIC// 
+//LIC// This library is distributed in the hope that it will be useful,
+//LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+//LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//LIC// Lesser General Public License for more details.
+//LIC// 
+//LIC// You should have received a copy of the GNU Lesser General Public
+//LIC// License along with this library; if not, write to the Free Software
+//LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+//LIC// 02110-1301  USA.
+//LIC// 
+//LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+//LIC// 
+//LIC//====================================================================
+// Benchmark for the sample point containers: time the setup and
+// Benchmark for the parallel-in-time (parareal) solution of the block
+// triangular systems that arise from time-slab discretisations: compare
+// sequential block forward substitution against the parareal iteration
+// for the (backward Euler) discretisation of the 1D heat equation,
+// split into a number of time slabs.
+
+//Oomph-lib includes
+#include "generic.h"
+#include "space_time_block_preconditioner.h"
+
+using namespace std;
+using namespace oomph;
+
+
+//==start_of_namespace====================================================
+/// Namespace for benchmark parameters
+//========================================================================
+namespace BenchmarkParameters
+{
+ /// Number of (interior) grid points in space
+ unsigned N_space=1000;
+
+ /// Number of time steps in each slab
+ unsigned N_step_per_slab=20;
+
+ /// Number of time slabs
+ unsigned N_slab=16;
+
+ /// Time step (scaled by the square of the spatial step)
+ double Scaled_dt=0.1;
+
+ /// Fill level of the incomplete factorisation used as the coarse
+ /// preconditioner. The convergence of the parareal iteration depends
+ /// on how well this captures the propagation through the time slab:
+ /// it deteriorates for small fill levels and large time steps.
+ unsigned Coarse_fill_level=3;
+
+ /// Build the diagonal block for a time slab: block lower bidiagonal
+ /// with (I+dt K) on the diagonal and -I on the sub-diagonal where K is
+ /// the second-order finite difference approximation of -d^2/dx^2
+ void build_slab_matrix(const LinearAlgebraDistribution* dist_pt,
+                        CRDoubleMatrix& matrix)
+ {
+  unsigned n=N_space;
+  unsigned n_row=n*N_step_per_slab;
+  Vector<double> value;
+  Vector<int> column_index;
+  Vector<SparseOffset> row_start(n_row+1,0);
+  for (unsigned m=0;m<N_step_per_slab;m++)
+   {
+    for (unsigned i=0;i<n;i++)
+     {
+      unsigned row=m*n+i;
+
+      // Coupling to the previous time step
+      if (m>0)
+       {
+        column_index.push_back(row-n);
+        value.push_back(-1.0);
+       }
+
+      // Spatial operator
+      if (i>0)
+       {
+        column_index.push_back(row-1);
+        value.push_back(-Scaled_dt);
+       }
+      column_index.push_back(row);
+      value.push_back(1.0+2.0*Scaled_dt);
+      if (i+1<n)
+       {
+        column_index.push_back(row+1);
+        value.push_back(-Scaled_dt);
+       }
+      row_start[row+1]=value.size();
+     }
+   }
+  matrix.build(dist_pt,n_row,value,column_index,row_start);
+ }
+
+ /// Build the off-diagonal block that couples the first time step in a
+ /// slab to the last time step in the previous slab
+ void build_coupling_matrix(const LinearAlgebraDistribution* dist_pt,
+                            CRDoubleMatrix& matrix)
+ {
+  unsigned n=N_space;
+  unsigned n_row=n*N_step_per_slab;
+  Vector<double> value;
+  Vector<int> column_index;
+  Vector<SparseOffset> row_start(n_row+1,0);
+  for (unsigned i=0;i<n;i++)
+   {
+    column_index.push_back(n_row-n+i);
+    value.push_back(-1.0);
+    row_start[i+1]=value.size();
+   }
+  for (unsigned row=n;row<n_row;row++)
+   {
+    row_start[row+1]=value.size();
+   }
+  matrix.build(dist_pt,n_row,value,column_index,row_start);
+ }
+
+ /// Initial condition
+ double initial_condition(const unsigned& i)
+ {
+  double x=double(i+1)/double(N_space+1);
+  return sin(MathematicalConstants::Pi*x)+
+   0.5*sin(7.0*MathematicalConstants::Pi*x);
+ }
+
+} // end of namespace
+
+
+
+//=====================================================================
+/// Driver: Compare block forward substitution and parareal
+//=====================================================================
+int main(int argc, char **argv)
+{
+ // Store command line arguments
+ CommandLineArgs::setup(argc,argv);
+
+ // Problem size can be specified on the command line
+ CommandLineArgs::specify_command_line_flag(
+  "--n_space",&BenchmarkParameters::N_space);
+ CommandLineArgs::specify_command_line_flag(
+  "--n_step_per_slab",&BenchmarkParameters::N_step_per_slab);
+ CommandLineArgs::specify_command_line_flag(
+  "--n_slab",&BenchmarkParameters::N_slab);
+ CommandLineArgs::specify_command_line_flag(
+  "--scaled_dt",&BenchmarkParameters::Scaled_dt);
+ CommandLineArgs::specify_command_line_flag(
+  "--coarse_fill_level",&BenchmarkParameters::Coarse_fill_level);
+ CommandLineArgs::parse_and_assign(); 
+ CommandLineArgs::doc_specified_flags();
+
+ unsigned n_slab=BenchmarkParameters::N_slab;
+ unsigned n_row=BenchmarkParameters::N_space*
+  BenchmarkParameters::N_step_per_slab;
+
+ // Serial distribution for the slab vectors
+ OomphCommunicator communicator;
+ LinearAlgebraDistribution dist(&communicator,n_row,false);
+
+ // Build the matrices (all slabs are the same)
+ CRDoubleMatrix slab_matrix;
+ BenchmarkParameters::build_slab_matrix(&dist,slab_matrix);
+ CRDoubleMatrix coupling_matrix;
+ BenchmarkParameters::build_coupling_matrix(&dist,coupling_matrix);
+
+ // Set up the fine (exact) and coarse (ILU(k)) preconditioners and the
+ // matrix-vector products for the coupling blocks
+ double t_start=TimingHelpers::timer();
+ Vector<Preconditioner*> fine_preconditioner_pt(n_slab);
+ Vector<Preconditioner*> coarse_preconditioner_pt(n_slab);
+ DenseMatrix<MatrixVectorProduct*> coupling_pt(n_slab,n_slab,0);
+ for (unsigned i=0;i<n_slab;i++)
+  {
+   fine_preconditioner_pt[i]=new SuperLUPreconditioner;
+   fine_preconditioner_pt[i]->setup(&slab_matrix);
+   coarse_preconditioner_pt[i]=
+    new ILUKPreconditioner(BenchmarkParameters::Coarse_fill_level);
+   coarse_preconditioner_pt[i]->setup(&slab_matrix);
+   if (i>0)
+    {
+     coupling_pt(i,i-1)=new MatrixVectorProduct;
+     coupling_pt(i,i-1)->setup(&coupling_matrix);
+    }
+  }
+ oomph_info << "Setup time [sec]: " << TimingHelpers::timer()-t_start
+            << std::endl;
+
+ // The rhs: the initial condition enters the first time step
+ Vector<DoubleVector> r(n_slab);
+ for (unsigned i=0;i<n_slab;i++)
+  {
+   r[i].build(&dist,0.0);
+  }
+ for (unsigned j=0;j<BenchmarkParameters::N_space;j++)
+  {
+   r[0][j]=BenchmarkParameters::initial_condition(j);
+  }
+
+ // Reference solution: sequential block forward substitution
+ t_start=TimingHelpers::timer();
+ Vector<DoubleVector> z_exact(n_slab);
+ for (unsigned i=0;i<n_slab;i++)
+  {
+   DoubleVector rhs(r[i]);
+   if (i>0)
+    {
+     DoubleVector temp;
+     coupling_pt(i,i-1)->multiply(z_exact[i-1],temp);
+     rhs-=temp;
+    }
+   fine_preconditioner_pt[i]->preconditioner_solve(rhs,z_exact[i]);
+  }
+ double t_sequential=TimingHelpers::timer()-t_start;
+ oomph_info << "\nSequential block substitution: " << t_sequential 
+            << " sec" << std::endl;
+
+ // Output for the results
+ std::ofstream trace_file("RESLT/parareal_benchmark.dat");
+ trace_file << "# n_iteration t_total t_fine t_coarse max_error"
+            << std::endl;
+ trace_file << "0 " << t_sequential << " " << t_sequential 
+            << " 0 0" << std::endl;
+
+ // Parareal with different numbers of iterations
+ PararealBlockTriangularSolver parareal_solver;
+ parareal_solver.setup(fine_preconditioner_pt,coarse_preconditioner_pt,
+                       coupling_pt,false);
+ unsigned n_iteration_max=std::min(n_slab,unsigned(6));
+ for (unsigned n_iteration=1;n_iteration<=n_iteration_max;n_iteration++)
+  {
+   parareal_solver.n_iteration()=n_iteration;
+   Vector<DoubleVector> z;
+   t_start=TimingHelpers::timer();
+   parareal_solver.solve(r,z);
+   double t_parareal=TimingHelpers::timer()-t_start;
+
+   // Max. error relative to the sequential solution
+   double max_error=0.0;
+   for (unsigned i=0;i<n_slab;i++)
+    {
+     DoubleVector diff(z[i]);
+     diff-=z_exact[i];
+     max_error=std::max(max_error,diff.max());
+     diff*=-1.0;
+     max_error=std::max(max_error,diff.max());
+    }
+
+   oomph_info << "Parareal with " << n_iteration << " iterations: " 
+              << t_parareal << " sec (fine solves: " 
+              << parareal_solver.fine_solve_time() << " sec; coarse sweeps: "
+              << parareal_solver.coarse_solve_time() 
+              << " sec); max. error: " << max_error << std::endl;
+   trace_file << n_iteration << " " << t_parareal << " " 
+              << parareal_solver.fine_solve_time() << " "
+              << parareal_solver.coarse_solve_time() << " "
+              << max_error << std::endl;
+  }
+ trace_file.close();
+
+ // Clean up
+ for (unsigned i=0;i<n_slab;i++)
+  {
+   delete fine_preconditioner_pt[i];
+   delete coarse_preconditioner_pt[i];
+   for (unsigned j=0;j<n_slab;j++)
+    {
+     delete coupling_pt(i,j);
+    }
+  }
+
+} // end of main
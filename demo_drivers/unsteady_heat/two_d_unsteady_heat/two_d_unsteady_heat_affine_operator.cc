@@ -0,0 +1,245 @@
+//LIC// ====================================================================
+//LIC// This file forms part of oomph-lib, the object-oriented,
+//LIC// multi-physics finite-element library, available
+//LIC// at http://www.oomph-lib.org.
+//LIC//
+//LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+//LIC//
+//LIC// This library is free software; you can redistribute it and/or
+//LIC// modify it under the terms of the GNU Lesser General Public
+//LIC// License as published by the Free Software Foundation; either
+//LIC// version 2.1 of the License, or (at your option) any later version.
+//LIC//
+//LIC// This library is distributed in the hope that it will be useful,
+//LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+//LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//LIC// Lesser General Public License for more details.
+//LIC//
+//LIC// You should have received a copy of the GNU Lesser General Public
+//LIC// License along with this library; if not, write to the Free Software
+//LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+//LIC// 02110-1301  USA.
+//LIC//
+//LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+//LIC//
+//LIC//====================================================================
+// Driver for a 2D unsteady heat problem with a constant source
+// function, solved (a) with the standard assembly of the Jacobian and
+// the residuals in every timestep, (b) with the cached (affine)
+// operator and (c) with the cached operator, residuals computed from
+// the cached operator and recycling of the Jacobian and (d) as (c) but
+// after a steady solve (during which the cached operator is set up
+// without the mass matrix). The timestep is halved half-way through the
+// simulation.
+
+//Generic routines
+#include "generic.h"
+
+// The unsteady heat equations
+#include "unsteady_heat.h"
+
+// The mesh
+#include "meshes/simple_rectangular_quadmesh.h"
+
+using namespace std;
+using namespace oomph;
+
+
+//==start_of_namespace====================================================
+/// Namespace for the problem parameters
+//========================================================================
+namespace GlobalParameters
+{
+ /// Number of elements in each coordinate direction
+ unsigned N_element=32;
+
+ /// Number of timesteps
+ unsigned N_timestep=40;
+
+ /// Initial timestep
+ double Dt=0.01;
+
+ /// Constant source function
+ void source_function(const double& time,
+                      const Vector<double>& x,
+                      double& source)
+ {
+  source=-1.0;
+ }
+
+} // end of namespace
+
+
+
+//=====================================================================
+/// Unsteady heat problem on the unit square with homogeneous
+/// Dirichlet conditions
+//=====================================================================
+template<class ELEMENT>
+class UnsteadyHeatProblem : public Problem
+{
+
+public:
+
+ /// Constructor: Pass number of elements in each coordinate direction
+ UnsteadyHeatProblem(const unsigned& n)
+  {
+   // Allocate the timestepper
+   add_time_stepper_pt(new BDF<2>);
+
+   Problem::mesh_pt()=new SimpleRectangularQuadMesh<ELEMENT>(
+    n,n,1.0,1.0,time_stepper_pt());
+
+   // Pin the boundary values
+   unsigned n_bound=mesh_pt()->nboundary();
+   for (unsigned b=0;b<n_bound;b++)
+    {
+     unsigned n_node=mesh_pt()->nboundary_node(b);
+     for (unsigned j=0;j<n_node;j++)
+      {
+       mesh_pt()->boundary_node_pt(b,j)->pin(0);
+      }
+    }
+
+   // Set the source function
+   unsigned n_element=mesh_pt()->nelement();
+   for (unsigned e=0;e<n_element;e++)
+    {
+     ELEMENT* el_pt=dynamic_cast<ELEMENT*>(mesh_pt()->element_pt(e));
+     el_pt->source_fct_pt()=&GlobalParameters::source_function;
+    }
+
+   assign_eqn_numbers();
+  }
+
+ /// Destructor: Clean up
+ ~UnsteadyHeatProblem()
+  {
+   delete mesh_pt();
+   delete time_stepper_pt();
+  }
+
+ /// Set the initial condition u = sin(pi x) sin(pi y) (impulsive
+ /// start)
+ void set_initial_condition()
+  {
+   unsigned n_node=mesh_pt()->nnode();
+   for (unsigned j=0;j<n_node;j++)
+    {
+     Node* nod_pt=mesh_pt()->node_pt(j);
+     nod_pt->set_value(0,sin(MathematicalConstants::Pi*nod_pt->x(0))*
+                       sin(MathematicalConstants::Pi*nod_pt->x(1)));
+    }
+   assign_initial_values_impulsive(GlobalParameters::Dt);
+  }
+
+}; // end of UnsteadyHeatProblem
+
+
+
+//=====================================================================
+/// Run the simulation; the flag selects the assembly:
+/// 0: standard assembly; 1: cached operator; 2: cached operator,
+/// residuals from the cached operator and recycling of the Jacobian;
+/// 3: as 2 but after a steady solve (the cached operator is set up
+/// then and must be set up again when the timestepper is no longer
+/// steady). Return the time taken and the final values of the unknowns.
+//=====================================================================
+double run(const unsigned& flag, DoubleVector& dofs)
+{
+ UnsteadyHeatProblem<QUnsteadyHeatElement<2,3> >
+  problem(GlobalParameters::N_element);
+ problem.disable_info_in_newton_solve();
+ problem.linear_solver_pt()->disable_doc_time();
+ if (flag==1)
+  {
+   problem.enable_affine_operator_caching();
+  }
+ else if (flag>=2)
+  {
+   problem.enable_affine_operator_caching(true);
+   problem.enable_jacobian_reuse();
+  }
+
+ // Steady solve (its solution is overwritten by the initial condition)
+ if (flag==3)
+  {
+   problem.steady_newton_solve();
+  }
+
+ problem.set_initial_condition();
+
+ double t_start=TimingHelpers::timer();
+ double dt=GlobalParameters::Dt;
+ for (unsigned i=0;i<GlobalParameters::N_timestep;i++)
+  {
+   // Halve the timestep half-way through
+   if (i==GlobalParameters::N_timestep/2)
+    {
+     dt*=0.5;
+    }
+   problem.unsteady_newton_solve(dt);
+  }
+ double t_end=TimingHelpers::timer();
+
+ problem.get_dofs(dofs);
+ return t_end-t_start;
+}
+
+
+
+//=====================================================================
+/// Driver: Compare the different types of assembly
+//=====================================================================
+int main(int argc, char **argv)
+{
+ // Store command line arguments
+ CommandLineArgs::setup(argc,argv);
+
+ // Number of elements and timesteps can be specified on the command line
+ CommandLineArgs::specify_command_line_flag(
+  "--n_element",&GlobalParameters::N_element);
+ CommandLineArgs::specify_command_line_flag(
+  "--n_timestep",&GlobalParameters::N_timestep);
+ CommandLineArgs::parse_and_assign();
+ CommandLineArgs::doc_specified_flags();
+
+ // Output for the results
+ std::ofstream trace_file("RESLT/trace.dat");
+ trace_file << "# assembly time max_diff" << std::endl;
+
+ std::string label[4]={"standard","cached_operator",
+                       "cached_operator_and_jacobian",
+                       "cached_operator_after_steady_solve"};
+ DoubleVector reference_dofs;
+ for (unsigned flag=0;flag<4;flag++)
+  {
+   DoubleVector dofs;
+   double time=run(flag,dofs);
+
+   // Maximum difference to the solution obtained with the standard
+   // assembly
+   double max_diff=0.0;
+   if (flag==0)
+    {
+     reference_dofs=dofs;
+    }
+   else
+    {
+     dofs-=reference_dofs;
+     unsigned n_dof=dofs.nrow_local();
+     for (unsigned i=0;i<n_dof;i++)
+      {
+       max_diff=std::max(max_diff,std::fabs(dofs[i]));
+      }
+    }
+
+   oomph_info << label[flag] << ": " << time
+              << " sec; max. difference of solutions: " << max_diff
+              << std::endl;
+   trace_file << label[flag] << " " << time << " " << max_diff
+              << std::endl;
+  }
+ trace_file.close();
+
+} // end of main
@@ -0,0 +1,164 @@
+//LIC// ====================================================================
+//LIC// This file forms part of oomph-lib, the object-oriented,
+//LIC// multi-physics finite-element library, available
+//LIC// at http://www.oomph-lib.org.
+//LIC//
+//LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+//LIC//
+//LIC// This library is free software; you can redistribute it and/or
+//LIC// modify it under the terms of the GNU Lesser General Public
+//LIC// License as published by the Free Software Foundation; either
+//LIC// version 2.1 of the License, or (at your option) any later version.
+//LIC//
+//LIC// This library is distributed in the hope that it will be useful,
+//LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+//LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//LIC// Lesser General Public License for more details.
+//LIC//
+//LIC// You should have received a copy of the GNU Lesser General Public
+//LIC// License along with this library; if not, write to the Free Software
+//LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+//LIC// 02110-1301  USA.
+//LIC//
+//LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+//LIC//
+//LIC//====================================================================
+// Check that the LineVisualiser relocates its plot points after the mesh
+// has been adapted, even if the adaptation does not change the number of
+// elements in the mesh (the elements that contained the plot points may
+// have been deleted).
+
+//Generic routines
+#include "generic.h"
+
+// Poisson
+#include "poisson.h"
+
+// Mesh
+#include "meshes/rectangular_quadmesh.h"
+
+using namespace std;
+using namespace oomph;
+
+
+//==start_of_namespace====================================================
+/// The linear field that is carried by the mesh
+//========================================================================
+namespace Global_Parameters
+{
+ /// Linear field
+ double linear_field(const Vector<double>& x)
+ {
+  return 1.0+x[0]+2.0*x[1];
+ }
+
+} // end of namespace
+
+
+
+//=====================================================================
+/// Max. difference between the data returned by the visualiser and
+/// the coordinates of the plot points and the field at these points
+//=====================================================================
+double max_error(LineVisualiser& visualiser,
+                 const Vector<Vector<double> >& coord_vec)
+{
+ Vector<Vector<double> > data;
+ visualiser.get_output_data(data);
+
+ double error=0.0;
+ unsigned n_point=coord_vec.size();
+ for (unsigned j=0;j<n_point;j++)
+  {
+   // Not found: flag as a large error
+   if (data[j].size()!=3)
+    {
+     return DBL_MAX;
+    }
+   for (unsigned i=0;i<2;i++)
+    {
+     error=std::max(error,std::fabs(data[j][i]-coord_vec[j][i]));
+    }
+   error=std::max(error,std::fabs(
+                   data[j][2]-Global_Parameters::linear_field(coord_vec[j])));
+  }
+ return error;
+}
+
+
+
+//=====================================================================
+/// Driver
+//=====================================================================
+int main()
+{
+ // Uniformly refined 2x2 mesh of the unit square
+ RefineableRectangularQuadMesh<RefineableQPoissonElement<2,3> >
+  mesh(2,2,1.0,1.0);
+ mesh.refine_uniformly();
+
+ // Set the linear field (which is interpolated exactly when the mesh
+ // is refined)
+ unsigned n_node=mesh.nnode();
+ Vector<double> x(2);
+ for (unsigned j=0;j<n_node;j++)
+  {
+   Node* nod_pt=mesh.node_pt(j);
+   x[0]=nod_pt->x(0);
+   x[1]=nod_pt->x(1);
+   nod_pt->set_value(0,Global_Parameters::linear_field(x));
+  }
+
+ // Plot points along the diagonal
+ Vector<double> start(2,0.01);
+ Vector<double> end(2,0.99);
+ Vector<Vector<double> > coord_vec;
+ LineVisualiser::line_plot_points(start,end,21,coord_vec);
+ LineVisualiser visualiser(&mesh,coord_vec);
+
+ std::ofstream trace_file("RESLT/trace.dat");
+ double error=max_error(visualiser,coord_vec);
+ oomph_info << "Max. error before adaptation: " << error << std::endl;
+ trace_file << (error<1.0e-12) << std::endl;
+
+ // Unrefine the elements in the lower left quadrant and refine
+ // one element in the upper right one, so the number of elements
+ // doesn't change
+ mesh.min_permitted_error()=0.1;
+ mesh.max_permitted_error()=0.5;
+ mesh.max_keep_unrefined()=0;
+ unsigned n_element_before=mesh.nelement();
+ Vector<double> elem_error(n_element_before,0.3);
+ bool refine=true;
+ Vector<double> s(2,0.0);
+ for (unsigned e=0;e<n_element_before;e++)
+  {
+   mesh.finite_element_pt(e)->interpolated_x(s,x);
+   if ((x[0]<0.5)&&(x[1]<0.5))
+    {
+     elem_error[e]=0.0;
+    }
+   else if ((x[0]>0.5)&&(x[1]>0.5)&&refine)
+    {
+     elem_error[e]=1.0;
+     refine=false;
+    }
+  }
+ unsigned long generation_before=mesh.element_storage_generation();
+ mesh.adapt(elem_error);
+ unsigned n_element_after=mesh.nelement();
+
+ oomph_info << "Number of elements before/after adaptation: "
+            << n_element_before << " " << n_element_after << std::endl;
+ trace_file << (n_element_after==n_element_before) << " "
+            << (mesh.element_storage_generation()!=generation_before)
+            << std::endl;
+
+ // The visualiser must relocate the plot points in the new elements
+ error=max_error(visualiser,coord_vec);
+ oomph_info << "Max. error after adaptation: " << error << std::endl;
+ trace_file << (error<1.0e-12) << std::endl;
+
+ trace_file.close();
+
+} // end of main
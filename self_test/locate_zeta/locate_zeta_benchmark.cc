@@ -0,0 +1,262 @@
+//LIC// ====================================================================
+//LIC// This file forms part of oomph-lib, the object-oriented, 
+//LIC// multi-physics finite-element library, available 
+//LIC// at http://www.oomph-lib.org.
+//LIC// 
+//LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+//LIC// 
+//LIC// This library is free software; you can redistribute it and/or
+//LIC// modify it under the terms of the GNU Lesser General Public
+//LIC// License as published by the Free Software Foundation; either
+//LIC// version 2.1 of the License, or (at your option) any later version.
+//LIC// 
+//LIC// This library is distributed in the hope that it will be useful,
+//LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+//LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//LIC// Lesser General Public License for more details.
+//LIC// 
+//LIC// You should have received a copy of the GNU Lesser General Public
+//LIC// License along with this library; if not, write to the Free Software
+//LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+//LIC// 02110-1301  USA.
+//LIC// 
+//LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+//LIC// 
+//LIC//====================================================================
+// Benchmark for the sample point containers: time the setup and
+// locate_zeta for random points in a uniform, a strongly graded and an
+// anisotropic mesh, using all available sample point containers.
+
+//Oomph-lib includes
+#include "generic.h"
+#include "poisson.h"
+
+// The mesh
+#include "meshes/simple_rectangular_quadmesh.h"
+
+using namespace std;
+using namespace oomph;
+
+
+//==start_of_namespace====================================================
+/// Namespace for benchmark parameters
+//========================================================================
+namespace BenchmarkParameters
+{
+ /// Number of elements in each coordinate direction
+ unsigned N_element=100;
+
+ /// Number of points to be located
+ unsigned N_point=20000;
+
+ /// Type of mesh: 0: uniform; 1: strongly graded towards the
+ /// corner; 2: anisotropic (boundary-layer type grading in y-direction
+ /// only)
+ unsigned Mesh_type=0;
+
+ /// Names of the meshes
+ std::string Mesh_name[3]={"uniform","graded","anisotropic"};
+
+ /// Map the nodes of a uniform mesh on the unit square 
+ void map_node(Node* nod_pt)
+ {
+  double x=nod_pt->x(0);
+  double y=nod_pt->x(1);
+  switch (Mesh_type)
+   {
+   case 1:
+    nod_pt->x(0)=pow(x,4);
+    nod_pt->x(1)=pow(y,4);
+    break;
+    
+   case 2:
+    nod_pt->x(1)=0.01*pow(y,5);
+    break;
+
+   default:
+    break;
+   }
+ }
+
+ /// Deterministic pseudo-random number in [0,1]
+ double random_number(unsigned long& seed)
+ {
+  seed=(1103515245*seed+12345)%2147483648ul;
+  return double(seed)/2147483647.0;
+ }
+
+} // end of namespace
+
+
+
+//=====================================================================
+/// Set up the specified sample point container for the mesh, then
+/// locate all points and check the results. Returns the number of
+/// points that were located correctly, and the time for setup and
+/// locate_zeta.
+//=====================================================================
+unsigned benchmark_container(Mesh* mesh_pt,
+                             const unsigned& container_type,
+                             const Vector<Vector<double> >& point,
+                             double& t_setup,
+                             double& t_locate)
+{
+ // Create the parameters for the requested container
+ SamplePointContainerParameters* params_pt=0;
+ switch (container_type)
+  {
+  case UseRefineableBinArray:
+   params_pt=new RefineableBinArrayParameters(mesh_pt);
+   break;
+   
+  case UseNonRefineableBinArray:
+   params_pt=new NonRefineableBinArrayParameters(mesh_pt);
+   break;
+   
+  case UseBVHSamplePointContainer:
+   params_pt=new BVHSamplePointContainerParameters(mesh_pt);
+   break;
+   
+#ifdef OOMPH_HAS_CGAL
+  case UseCGALSamplePointContainer:
+   params_pt=new CGALSamplePointContainerParameters(mesh_pt);
+   break;
+#endif
+   
+  default:
+   throw OomphLibError("Unknown sample point container",
+                       OOMPH_CURRENT_FUNCTION,
+                       OOMPH_EXCEPTION_LOCATION);
+  }
+ 
+ // Setup
+ double t_start=TimingHelpers::timer();
+ MeshAsGeomObject* mesh_geom_obj_pt=new MeshAsGeomObject(params_pt);
+ t_setup=TimingHelpers::timer()-t_start;
+ delete params_pt;
+
+ // Locate the points
+ unsigned n_point=point.size();
+ unsigned n_correct=0;
+ Vector<double> s(2);
+ Vector<double> x(2);
+ t_start=TimingHelpers::timer();
+ for (unsigned j=0;j<n_point;j++)
+  {
+   GeomObject* geom_obj_pt=0;
+   mesh_geom_obj_pt->locate_zeta(point[j],geom_obj_pt,s);
+   
+   // Check that we've found the right point
+   if (geom_obj_pt!=0)
+    {
+     geom_obj_pt->position(s,x);
+     double dist=sqrt(pow(x[0]-point[j][0],2)+pow(x[1]-point[j][1],2));
+     if (dist<1.0e-8)
+      {
+       n_correct++;
+      }
+    }
+  }
+ t_locate=TimingHelpers::timer()-t_start;
+
+ delete mesh_geom_obj_pt;
+ return n_correct;
+}
+
+
+
+//=====================================================================
+/// Driver: Run the benchmark for all meshes and sample point
+/// containers
+//=====================================================================
+int main(int argc, char **argv)
+{
+ // Store command line arguments
+ CommandLineArgs::setup(argc,argv);
+
+ // Number of elements and points can be specified on the command line
+ CommandLineArgs::specify_command_line_flag(
+  "--n_element",&BenchmarkParameters::N_element);
+ CommandLineArgs::specify_command_line_flag(
+  "--n_point",&BenchmarkParameters::N_point);
+ CommandLineArgs::parse_and_assign(); 
+ CommandLineArgs::doc_specified_flags();
+
+ // The sample point containers to be compared
+ Vector<unsigned> container_type;
+ Vector<std::string> container_name;
+ container_type.push_back(UseRefineableBinArray);
+ container_name.push_back("RefineableBinArray");
+ container_type.push_back(UseNonRefineableBinArray);
+ container_name.push_back("NonRefineableBinArray");
+ container_type.push_back(UseBVHSamplePointContainer);
+ container_name.push_back("BVHSamplePointContainer");
+#ifdef OOMPH_HAS_CGAL
+ container_type.push_back(UseCGALSamplePointContainer);
+ container_name.push_back("CGALSamplePointContainer");
+#endif
+ unsigned n_container=container_type.size();
+ 
+ // Output for the results
+ std::ofstream trace_file("RESLT/benchmark.dat");
+ trace_file << "# mesh container n_located n_point t_setup t_locate"
+            << std::endl;
+ 
+ // Loop over the meshes
+ for (unsigned mesh_type=0;mesh_type<3;mesh_type++)
+  {
+   BenchmarkParameters::Mesh_type=mesh_type;
+   
+   // Build and map the mesh (use bilinear elements so the strong grading
+   // doesn't invert the elements)
+   unsigned n=BenchmarkParameters::N_element;
+   Mesh* mesh_pt=new SimpleRectangularQuadMesh<QPoissonElement<2,2> >(
+    n,n,1.0,1.0);
+   unsigned nnod=mesh_pt->nnode();
+   for (unsigned j=0;j<nnod;j++)
+    {
+     BenchmarkParameters::map_node(mesh_pt->node_pt(j));
+    }
+   
+   // Points to be located: random, but transformed in the same way as
+   // the mesh so they have the same distribution as the elements
+   unsigned long seed=1;
+   unsigned n_point=BenchmarkParameters::N_point;
+   Vector<Vector<double> > point(n_point);
+   for (unsigned j=0;j<n_point;j++)
+    {
+     Node dummy_node(2,1,0);
+     dummy_node.x(0)=BenchmarkParameters::random_number(seed);
+     dummy_node.x(1)=BenchmarkParameters::random_number(seed);
+     BenchmarkParameters::map_node(&dummy_node);
+     point[j].resize(2);
+     point[j][0]=dummy_node.x(0);
+     point[j][1]=dummy_node.x(1);
+    }
+
+   oomph_info << "\nMesh: " << BenchmarkParameters::Mesh_name[mesh_type]
+              << " (" << mesh_pt->nelement() << " elements)\n";
+
+   // Loop over the containers
+   for (unsigned c=0;c<n_container;c++)
+    {
+     double t_setup=0.0;
+     double t_locate=0.0;
+     unsigned n_located=benchmark_container(mesh_pt,container_type[c],
+                                            point,t_setup,t_locate);
+     oomph_info << container_name[c] << ": located " << n_located
+                << " of " << n_point << " points; setup: " << t_setup 
+                << " sec; locate_zeta: " << t_locate << " sec" 
+                << std::endl;
+     trace_file << BenchmarkParameters::Mesh_name[mesh_type] << " "
+                << container_name[c] << " " << n_located << " " 
+                << n_point << " " << t_setup << " " << t_locate 
+                << std::endl;
+    }
+   
+   delete mesh_pt;
+  }
+ 
+ trace_file.close();
+
+} // end of main
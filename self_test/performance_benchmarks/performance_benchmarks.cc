@@ -0,0 +1,350 @@
+//LIC// ====================================================================
+//LIC// This file forms part of oomph-lib, the object-oriented, 
+//LIC// multi-physics finite-element library, available 
+//LIC// at http://www.oomph-lib.org.
+//LIC// 
+//LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+//LIC// 
+//LIC// This library is free software; you can redistribute it and/or
+//LIC// modify it under the terms of the GNU Lesser General Public
+//LIC// License as published by the Free Software Foundation; either
+//LIC// version 2.1 of the License, or (at your option) any later version.
+//LIC// 
+//LIC// This library is distributed in the hope that it will be useful,
+//LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+//LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//LIC// Lesser General Public License for more details.
+//LIC// 
+//LIC// You should have received a copy of the GNU Lesser General Public
+//LIC// License along with this library; if not, write to the Free Software
+//LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+//LIC// 02110-1301  USA.
+//LIC// 
+//LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+//LIC// 
+//LIC//====================================================================
+// Performance benchmarks: Solve a curated set of problems (larger
+// versions of the driven cavity, adaptive Poisson and 3D fluid demo
+// drivers) and record the wall-clock times spent in the assembly, solve,
+// adapt and output phases, and the peak memory usage. The results are
+// compared against stored baselines by validate.sh.
+
+//Oomph-lib includes
+#include "generic.h"
+#include "poisson.h"
+#include "navier_stokes.h"
+
+// The meshes
+#include "meshes/simple_rectangular_quadmesh.h"
+#include "meshes/rectangular_quadmesh.h"
+#include "meshes/simple_cubic_mesh.h"
+
+using namespace std;
+using namespace oomph;
+
+
+//==start_of_namespace====================================================
+/// Namespace for benchmark parameters
+//========================================================================
+namespace BenchmarkParameters
+{
+ /// Benchmark case: "driven_cavity", "adaptive_poisson" or
+ /// "three_d_fluid"
+ std::string Case="driven_cavity";
+
+ /// Scaling factor for the number of elements in each coordinate
+ /// direction (relative to the default sizes of the benchmarks)
+ double Size_factor=1.0;
+
+ /// Reynolds number for the fluid problems
+ double Re=100.0;
+
+ /// Parameter for the steepness of the step in the solution of the
+ /// Poisson problem
+ double Alpha=50.0;
+
+ /// Orientation (non-dimensional location) of the step
+ double TanPhi=0.0;
+
+ /// Exact solution of the Poisson problem: tanh step
+ void get_exact_u(const Vector<double>& x, Vector<double>& u)
+ {
+  u[0]=tanh(1.0-Alpha*(TanPhi*x[0]-x[1]));
+ }
+
+ /// Source function that produces the tanh step
+ void source_function(const Vector<double>& x, double& source)
+ {
+  source=2.0*tanh(-1.0+Alpha*(TanPhi*x[0]-x[1]))*
+   (1.0-pow(tanh(-1.0+Alpha*(TanPhi*x[0]-x[1])),2.0))*
+   Alpha*Alpha*TanPhi*TanPhi+2.0*tanh(-1.0+Alpha*(TanPhi*x[0]-x[1]))*
+   (1.0-pow(tanh(-1.0+Alpha*(TanPhi*x[0]-x[1])),2.0))*Alpha*Alpha;
+ }
+
+ /// Scale the default number of elements by the size factor
+ unsigned n_element(const unsigned& n_default)
+ {
+  return std::max(unsigned(1),unsigned(double(n_default)*Size_factor+0.5));
+ }
+
+} // end of namespace
+
+
+
+//=====================================================================
+/// Lid-driven cavity in 2D or 3D: No slip on all walls, unit
+/// velocity in the x-direction on the lid (the wall at which the
+/// last coordinate is one).
+//=====================================================================
+template<class ELEMENT>
+class CavityBenchmarkProblem : public Problem
+{
+
+public:
+
+ /// Constructor: Pass the mesh (on the unit square or cube)
+ CavityBenchmarkProblem(Mesh* mesh_pt);
+
+ /// Doc the solution
+ void doc_solution()
+  {
+   ofstream some_file("RESLT/soln.dat");
+   mesh_pt()->output(some_file,3);
+   some_file.close();
+  }
+
+}; // end of CavityBenchmarkProblem
+
+
+
+//=====================================================================
+/// Constructor
+//=====================================================================
+template<class ELEMENT>
+CavityBenchmarkProblem<ELEMENT>::CavityBenchmarkProblem(Mesh* mesh_pt)
+{
+ Problem::mesh_pt()=mesh_pt;
+ unsigned dim=mesh_pt->finite_element_pt(0)->dim();
+
+ // Pin the velocities on all boundaries; drive the flow by the lid
+ unsigned n_bound=mesh_pt->nboundary();
+ for (unsigned b=0;b<n_bound;b++)
+  {
+   unsigned n_node=mesh_pt->nboundary_node(b);
+   for (unsigned j=0;j<n_node;j++)
+    {
+     Node* nod_pt=mesh_pt->boundary_node_pt(b,j);
+     for (unsigned i=0;i<dim;i++)
+      {
+       nod_pt->pin(i);
+      }
+     if (nod_pt->x(dim-1)>1.0-1.0e-10)
+      {
+       nod_pt->set_value(0,1.0);
+      }
+    }
+  }
+
+ // Set the Reynolds number
+ unsigned n_element=mesh_pt->nelement();
+ for (unsigned e=0;e<n_element;e++)
+  {
+   ELEMENT* el_pt=dynamic_cast<ELEMENT*>(mesh_pt->element_pt(e));
+   el_pt->re_pt()=&BenchmarkParameters::Re;
+  }
+
+ // Pin one pressure value
+ dynamic_cast<ELEMENT*>(mesh_pt->element_pt(0))->fix_pressure(0,0.0);
+
+ oomph_info << "Number of equations: " << assign_eqn_numbers() << std::endl;
+}
+
+
+
+//=====================================================================
+/// Adaptive Poisson problem on the unit square whose solution has a
+/// steep tanh step
+//=====================================================================
+template<class ELEMENT>
+class AdaptivePoissonBenchmarkProblem : public Problem
+{
+
+public:
+
+ /// Constructor: Pass the number of elements in each coordinate
+ /// direction of the initial mesh
+ AdaptivePoissonBenchmarkProblem(const unsigned& n);
+
+ /// Set the boundary conditions from the exact solution
+ void actions_before_newton_solve()
+  {
+   Vector<double> x(2);
+   Vector<double> u(1);
+   unsigned n_bound=mesh_pt()->nboundary();
+   for (unsigned b=0;b<n_bound;b++)
+    {
+     unsigned n_node=mesh_pt()->nboundary_node(b);
+     for (unsigned j=0;j<n_node;j++)
+      {
+       Node* nod_pt=mesh_pt()->boundary_node_pt(b,j);
+       x[0]=nod_pt->x(0);
+       x[1]=nod_pt->x(1);
+       BenchmarkParameters::get_exact_u(x,u);
+       nod_pt->set_value(0,u[0]);
+      }
+    }
+  }
+
+ /// Pin the boundary values and set the source function after the
+ /// mesh has been adapted
+ void actions_after_adapt()
+  {
+   complete_problem_setup();
+  }
+
+ /// Doc the solution
+ void doc_solution()
+  {
+   ofstream some_file("RESLT/soln.dat");
+   mesh_pt()->output(some_file,5);
+   some_file.close();
+  }
+
+private:
+
+ /// Pin the boundary values and set the source function
+ void complete_problem_setup();
+
+}; // end of AdaptivePoissonBenchmarkProblem
+
+
+
+//=====================================================================
+/// Constructor
+//=====================================================================
+template<class ELEMENT>
+AdaptivePoissonBenchmarkProblem<ELEMENT>::AdaptivePoissonBenchmarkProblem(
+ const unsigned& n)
+{
+ RefineableRectangularQuadMesh<ELEMENT>* mesh_pt=
+  new RefineableRectangularQuadMesh<ELEMENT>(n,n,1.0,1.0);
+ mesh_pt->spatial_error_estimator_pt()=new Z2ErrorEstimator;
+ mesh_pt->max_permitted_error()=1.0e-4;
+ mesh_pt->min_permitted_error()=1.0e-6;
+ Problem::mesh_pt()=mesh_pt;
+
+ complete_problem_setup();
+
+ oomph_info << "Number of equations: " << assign_eqn_numbers() << std::endl;
+}
+
+
+
+//=====================================================================
+/// Pin the boundary values and set the source function
+//=====================================================================
+template<class ELEMENT>
+void AdaptivePoissonBenchmarkProblem<ELEMENT>::complete_problem_setup()
+{
+ unsigned n_bound=mesh_pt()->nboundary();
+ for (unsigned b=0;b<n_bound;b++)
+  {
+   unsigned n_node=mesh_pt()->nboundary_node(b);
+   for (unsigned j=0;j<n_node;j++)
+    {
+     mesh_pt()->boundary_node_pt(b,j)->pin(0);
+    }
+  }
+
+ unsigned n_element=mesh_pt()->nelement();
+ for (unsigned e=0;e<n_element;e++)
+  {
+   ELEMENT* el_pt=dynamic_cast<ELEMENT*>(mesh_pt()->element_pt(e));
+   el_pt->source_fct_pt()=&BenchmarkParameters::source_function;
+  }
+}
+
+
+
+//=====================================================================
+/// Solve the problem (with the given maximum number of adaptations)
+/// and doc the solution, recording the phase timings
+//=====================================================================
+template<class PROBLEM>
+void run_benchmark(PROBLEM& problem, const unsigned& max_adapt)
+{
+ problem.newton_solve(max_adapt);
+
+ PhaseTimings::start("output");
+ problem.doc_solution();
+ PhaseTimings::halt("output");
+}
+
+
+
+//=====================================================================
+/// Driver: Run the benchmark specified on the command line and doc the
+/// phase timings and the peak memory usage in RESLT/benchmark.dat
+//=====================================================================
+int main(int argc, char **argv)
+{
+ // Store command line arguments
+ CommandLineArgs::setup(argc,argv);
+
+ // Benchmark case and problem size
+ CommandLineArgs::specify_command_line_flag(
+  "--case",&BenchmarkParameters::Case);
+ CommandLineArgs::specify_command_line_flag(
+  "--size_factor",&BenchmarkParameters::Size_factor);
+ CommandLineArgs::parse_and_assign();
+ CommandLineArgs::doc_specified_flags();
+
+ // Record the phase timings, including the setup of the problem
+ PhaseTimings::Record_phase_timings=true;
+ double t_start=TimingHelpers::wall_clock_time();
+ PhaseTimings::start("setup");
+
+ if (BenchmarkParameters::Case=="driven_cavity")
+  {
+   unsigned n=BenchmarkParameters::n_element(48);
+   CavityBenchmarkProblem<QTaylorHoodElement<2> > problem(
+    new SimpleRectangularQuadMesh<QTaylorHoodElement<2> >(n,n,1.0,1.0));
+   PhaseTimings::halt("setup");
+   run_benchmark(problem,0);
+  }
+ else if (BenchmarkParameters::Case=="adaptive_poisson")
+  {
+   unsigned n=BenchmarkParameters::n_element(8);
+   AdaptivePoissonBenchmarkProblem<RefineableQPoissonElement<2,3> >
+    problem(n);
+   PhaseTimings::halt("setup");
+   run_benchmark(problem,8);
+  }
+ else if (BenchmarkParameters::Case=="three_d_fluid")
+  {
+   unsigned n=BenchmarkParameters::n_element(6);
+   CavityBenchmarkProblem<QTaylorHoodElement<3> > problem(
+    new SimpleCubicMesh<QTaylorHoodElement<3> >(n,n,n,1.0,1.0,1.0));
+   PhaseTimings::halt("setup");
+   run_benchmark(problem,0);
+  }
+ else
+  {
+   std::ostringstream error_stream;
+   error_stream << "Unknown benchmark case: " << BenchmarkParameters::Case
+                << "\nUse driven_cavity, adaptive_poisson or three_d_fluid."
+                << std::endl;
+   throw OomphLibError(error_stream.str(),
+                       OOMPH_CURRENT_FUNCTION,
+                       OOMPH_EXCEPTION_LOCATION);
+  }
+
+ // Doc the phase timings, the total time and the peak memory usage
+ ofstream benchmark_file("RESLT/benchmark.dat");
+ PhaseTimings::doc(benchmark_file);
+ benchmark_file << "total " << TimingHelpers::wall_clock_time()-t_start
+                << " 1" << std::endl;
+ benchmark_file.close();
+ PhaseTimings::doc(*(oomph_info.stream_pt()));
+
+} // end of main
@@ -0,0 +1,84 @@
+#! /bin/sh
+
+# Get the OOPMH-LIB root directory from a makefile
+OOMPH_ROOT_DIR=$(make -s --no-print-directory print-top_builddir)
+
+# Performance benchmarks: Run the benchmark cases and compare the phase
+# timings and the peak memory usage against the baselines in validata.
+# The baselines are machine specific: Run
+#
+#    ./validate.sh update_baselines
+#
+# to replace them by the results obtained on the present machine.
+# The tolerances can be set via the environment variables
+# OOMPH_BENCHMARK_TIME_TOLERANCE, OOMPH_BENCHMARK_MIN_TIME and
+# OOMPH_BENCHMARK_MEMORY_TOLERANCE (see bin/compare_benchmarks.py).
+
+# Benchmark cases
+CASES="driven_cavity adaptive_poisson three_d_fluid"
+
+#Set the number of tests to be checked
+NUM_TESTS=3
+
+# Tolerances
+TOLERANCES="--time_tolerance ${OOMPH_BENCHMARK_TIME_TOLERANCE:-0.5} \
+ --min_time ${OOMPH_BENCHMARK_MIN_TIME:-0.2} \
+ --memory_tolerance ${OOMPH_BENCHMARK_MEMORY_TOLERANCE:-0.2}"
+
+# Setup validation directory
+#---------------------------
+touch Validation
+rm -r -f Validation
+mkdir Validation
+
+cd Validation
+
+for case in $CASES; do
+
+# Run the benchmark
+#------------------
+echo "Running performance benchmark $case "
+mkdir RESLT
+../performance_benchmarks --case $case > OUTPUT_$case
+echo "done"
+echo " " >> validation.log
+echo "Performance benchmark: $case" >> validation.log
+echo "------------------------------------------" >> validation.log
+echo " " >> validation.log
+echo "Validation directory: " >> validation.log
+echo " " >> validation.log
+echo "  " `pwd` >> validation.log
+echo " " >> validation.log
+mv RESLT/benchmark.dat benchmark_$case.dat
+rm -r -f RESLT
+
+if test "$1" = "update_baselines"; then
+  cp benchmark_$case.dat ../validata/benchmark_$case.dat
+  echo "dummy [OK] -- Updated the baseline for $case" >> validation.log
+elif test "$1" = "no_fpdiff"; then
+  echo "dummy [OK] -- Can't run compare_benchmarks.py because we don't have python or validata" >> validation.log
+else
+  $OOMPH_ROOT_DIR/bin/compare_benchmarks.py $TOLERANCES \
+   ../validata/benchmark_$case.dat benchmark_$case.dat >> validation.log
+fi
+
+done
+
+# Append log to main validation log
+cat validation.log >> ../../../validation.log
+
+cd ..
+
+
+#######################################################################
+
+
+#Check that we get the correct number of OKs
+# validate_ok_count will exit with status
+# 0 if all tests has passed.
+# 1 if some tests failed.
+# 2 if there are more 'OK' than expected.
+. $OOMPH_ROOT_DIR/bin/validate_ok_count
+
+# Never get here
+exit 10
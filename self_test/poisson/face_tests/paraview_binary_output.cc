@@ -0,0 +1,208 @@
+//LIC// ====================================================================
+//LIC// This file forms part of oomph-lib, the object-oriented,
+//LIC// multi-physics finite-element library, available
+//LIC// at http://www.oomph-lib.org.
+//LIC//
+//LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+//LIC//
+//LIC// This library is free software; you can redistribute it and/or
+//LIC// modify it under the terms of the GNU Lesser General Public
+//LIC// License as published by the Free Software Foundation; either
+//LIC// version 2.1 of the License, or (at your option) any later version.
+//LIC//
+//LIC// This library is distributed in the hope that it will be useful,
+//LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+//LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//LIC// Lesser General Public License for more details.
+//LIC//
+//LIC// You should have received a copy of the GNU Lesser General Public
+//LIC// License along with this library; if not, write to the Free Software
+//LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+//LIC// 02110-1301  USA.
+//LIC//
+//LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+//LIC//
+//LIC//====================================================================
+// Check the data assembled for the binary paraview output: (i) the
+// paraview cells and scalars that the Q and T elements and the Poisson
+// elements provide directly must agree with the ones obtained from
+// their ascii output and (ii) plot points that coincide (to within the
+// tolerance) must be merged, even if they straddle the boundary of the
+// cells in which the points are binned.
+
+//Generic routines
+#include "generic.h"
+
+// Poisson
+#include "poisson.h"
+
+// Meshes
+#include "meshes/one_d_mesh.h"
+#include "meshes/simple_rectangular_quadmesh.h"
+#include "meshes/simple_cubic_mesh.h"
+#include "meshes/simple_rectangular_tri_mesh.h"
+#include "meshes/simple_cubic_tet_mesh.h"
+
+using namespace std;
+using namespace oomph;
+
+
+//=====================================================================
+/// Set the nodal values to a smooth function and compare the paraview
+/// cells and scalars provided directly by the elements with the ones
+/// obtained (by the FiniteElement fallbacks) from their ascii output.
+/// Returns the number of mismatches.
+//=====================================================================
+unsigned compare_with_ascii_output(Mesh* mesh_pt, const std::string& label)
+{
+ unsigned n_node=mesh_pt->nnode();
+ for (unsigned j=0;j<n_node;j++)
+  {
+   Node* nod_pt=mesh_pt->node_pt(j);
+   double u=1.0;
+   unsigned n_dim=nod_pt->ndim();
+   for (unsigned i=0;i<n_dim;i++)
+    {
+     u+=sin(double(i+1)*nod_pt->x(i));
+    }
+   nod_pt->set_value(0,u);
+  }
+
+ unsigned n_mismatch=0;
+ unsigned n_element=mesh_pt->nelement();
+ for (unsigned e=0;e<n_element;e++)
+  {
+   FiniteElement* el_pt=mesh_pt->finite_element_pt(e);
+   for (unsigned nplot=2;nplot<6;nplot++)
+    {
+     // Cells
+     Vector<int> connectivity, offsets, types;
+     el_pt->paraview_cells(nplot,connectivity,offsets,types);
+     Vector<int> ascii_connectivity, ascii_offsets, ascii_types;
+     el_pt->FiniteElement::paraview_cells(nplot,ascii_connectivity,
+                                          ascii_offsets,ascii_types);
+     if ((connectivity!=ascii_connectivity)||(offsets!=ascii_offsets)||
+         (types!=ascii_types))
+      {
+       n_mismatch++;
+      }
+
+     // Scalars
+     Vector<double> values, ascii_values;
+     el_pt->scalar_values_paraview(0,nplot,values);
+     el_pt->FiniteElement::scalar_values_paraview(0,nplot,ascii_values);
+     if (values.size()!=ascii_values.size())
+      {
+       n_mismatch++;
+      }
+     else
+      {
+       unsigned n_value=values.size();
+       for (unsigned j=0;j<n_value;j++)
+        {
+         if (std::fabs(values[j]-ascii_values[j])>1.0e-14)
+          {
+           n_mismatch++;
+          }
+        }
+      }
+    }
+  }
+
+ oomph_info << label << ": " << n_mismatch
+            << " mismatches between direct and ascii-based paraview data"
+            << std::endl;
+ return n_mismatch;
+}
+
+
+//=====================================================================
+/// Number of points in a .vtu file
+//=====================================================================
+unsigned npoint_in_vtu_file(const std::string& filename)
+{
+ std::ifstream vtu_file(filename.c_str());
+ std::stringstream content;
+ content << vtu_file.rdbuf();
+ std::string key="NumberOfPoints=\"";
+ size_t pos=content.str().find(key);
+ if (pos==std::string::npos)
+  {
+   return 0;
+  }
+ return atoi(content.str().c_str()+pos+key.size());
+}
+
+
+//=====================================================================
+/// Driver
+//=====================================================================
+int main()
+{
+ std::ofstream trace_file("RESLT/trace.dat");
+
+ // Direct vs ascii-based paraview data
+ //------------------------------------
+ {
+  OneDMesh<QPoissonElement<1,3> > mesh(3,1.0);
+  trace_file << compare_with_ascii_output(&mesh,"1D Q") << std::endl;
+ }
+ {
+  SimpleRectangularQuadMesh<QPoissonElement<2,3> > mesh(2,2,1.0,1.0);
+  trace_file << compare_with_ascii_output(&mesh,"2D Q") << std::endl;
+ }
+ {
+  SimpleCubicMesh<QPoissonElement<3,3> > mesh(2,2,2,1.0,1.0,1.0);
+  trace_file << compare_with_ascii_output(&mesh,"3D Q") << std::endl;
+ }
+ {
+  SimpleRectangularTriMesh<TPoissonElement<2,3> > mesh(2,2,1.0,1.0);
+  trace_file << compare_with_ascii_output(&mesh,"2D T") << std::endl;
+ }
+ {
+  SimpleCubicTetMesh<TPoissonElement<3,3> > mesh(1,1,1,1.0,1.0,1.0);
+  trace_file << compare_with_ascii_output(&mesh,"3D T") << std::endl;
+ }
+
+ // Merging of coincident plot points
+ //----------------------------------
+
+ // Three two-node line elements on [0,1] whose end nodes are not shared
+ // but are within the merging tolerance (1e-10 times the size of the
+ // bounding box) of each other. The first pair is in the same bin of
+ // size tol but would be rounded to different multiples of tol; the
+ // second pair straddles the boundary between two bins.
+ double tol=1.0e-10;
+ Vector<double> x_node(6);
+ x_node[0]=0.0;
+ x_node[1]=(5.0e9+0.2)*tol;
+ x_node[2]=(5.0e9+0.8)*tol;
+ x_node[3]=(7.5e9-0.3)*tol;
+ x_node[4]=(7.5e9+0.3)*tol;
+ x_node[5]=1.0;
+
+ Mesh mesh;
+ for (unsigned e=0;e<3;e++)
+  {
+   QPoissonElement<1,2>* el_pt=new QPoissonElement<1,2>;
+   for (unsigned j=0;j<2;j++)
+    {
+     Node* nod_pt=el_pt->construct_node(j);
+     nod_pt->x(0)=x_node[2*e+j];
+     nod_pt->set_value(0,1.0);
+     mesh.add_node_pt(nod_pt);
+    }
+   mesh.add_element_pt(el_pt);
+  }
+
+ mesh.output_paraview_binary("RESLT/merged",2);
+ mesh.output_paraview_binary("RESLT/not_merged",2,Mesh::Paraview_base64,false);
+ unsigned n_merged=npoint_in_vtu_file("RESLT/merged.vtu");
+ unsigned n_not_merged=npoint_in_vtu_file("RESLT/not_merged.vtu");
+ oomph_info << "Number of plot points with/without merging: "
+            << n_merged << " " << n_not_merged << std::endl;
+ trace_file << n_merged << " " << n_not_merged << std::endl;
+
+ trace_file.close();
+
+} // end of main
@@ -196,6 +196,52 @@ namespace oomph
       }
     }
 
+    /// Return the values of the i-th scalar field at the plot points
+    /// (in the order used by scalar_value_paraview(...)) in numerical
+    /// form, for use by the binary paraview output
+    void scalar_values_paraview(const unsigned& i,
+                                const unsigned& nplot,
+                                Vector<double>& values) const
+    {
+      if (i > DIM)
+      {
+        std::stringstream error_stream;
+        error_stream << "Advection Diffusion Elements only store " << DIM + 1
+                     << " fields " << std::endl;
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+
+      // Vector of local coordinates
+      Vector<double> s(DIM);
+      Vector<double> x(DIM);
+      Vector<double> wind(DIM);
+
+      // Loop over plot points
+      unsigned num_plot_points = nplot_points_paraview(nplot);
+      values.resize(num_plot_points);
+      for (unsigned iplot = 0; iplot < num_plot_points; iplot++)
+      {
+        // Get local coordinates of plot point
+        get_s_plot(iplot, nplot, s);
+
+        // Wind
+        if (i < DIM)
+        {
+          // Dummy ipt argument
+          unsigned ipt = 0;
+          interpolated_x(s, x);
+          get_wind_adv_diff(ipt, s, x, wind);
+          values[iplot] = wind[i];
+        }
+        // Advection Diffusion
+        else
+        {
+          values[iplot] = interpolated_u_adv_diff(s);
+        }
+      }
+    }
+
     /// Name of the i-th scalar field. Default implementation
     /// returns V1 for the first one, V2 for the second etc. Can (should!) be
     /// overloaded with more meaningful names in specific elements.
@@ -444,6 +490,26 @@ namespace oomph
     }
 
 
+    /// Products of the Hessian, d(J_{ij})/d u_{k}, with the vectors Y and
+    /// C: The wind, the source and the mesh velocity do not depend on the
+    /// unknowns, so the residuals are linear and there is nothing to add
+    /// -- unless the nodal positions depend on geometric data (in
+    /// wrappers such as SpineElement or AlgebraicElement) which may be
+    /// unknowns too. Those elements use the (broken) default, so the
+    /// global finite-difference products have to be used for them.
+    void fill_in_contribution_to_hessian_vector_products(
+      Vector<double> const& Y,
+      DenseMatrix<double> const& C,
+      DenseMatrix<double>& product)
+    {
+      if (this->ngeom_data() != 0)
+      {
+        FiniteElement::fill_in_contribution_to_hessian_vector_products(
+          Y, C, product);
+      }
+    }
+
+
     /// Add the element's contribution to its residuals vector,
     /// jacobian matrix and mass matrix
     void fill_in_contribution_to_jacobian_and_mass_matrix(
@@ -446,10 +446,10 @@ namespace oomph
   void InexactSubBiharmonicPreconditioner::compute_inexact_schur_complement()
   {
     // if required get pointers to the vector components of J01 and J10
-    int* J_01_row_start = 0;
+    SparseOffset* J_01_row_start = 0;
     int* J_01_column_index = 0;
     double* J_01_value = 0;
-    int* J_10_row_start = 0;
+    SparseOffset* J_10_row_start = 0;
     int* J_10_column_index = 0;
 
     // J_01 matrix
@@ -462,10 +462,10 @@ namespace oomph
     J_10_column_index = Matrix_of_block_pointers(1, 0)->column_index();
 
     // if required get pointers to the vector components of J01 and J10
-    int* J_02_row_start = 0;
+    SparseOffset* J_02_row_start = 0;
     int* J_02_column_index = 0;
     double* J_02_value = 0;
-    int* J_20_row_start = 0;
+    SparseOffset* J_20_row_start = 0;
     int* J_20_column_index = 0;
 
     // J_02 matrix
@@ -491,7 +491,7 @@ namespace oomph
     unsigned J_00_nrow = Matrix_of_block_pointers(0, 0)->nrow();
 
     // vectors for the schur complement
-    Vector<int> S_00_row_start(J_00_nrow + 1);
+    Vector<SparseOffset> S_00_row_start(J_00_nrow + 1);
     Vector<int> S_00_column_index;
     Vector<double> S_00_value;
 
@@ -581,7 +581,9 @@ namespace oomph
           double temp_value = Matrix_of_block_pointers(0, 0)->operator()(i, j);
 
           // iterate through non-zero entries of  column j of A_10
-          for (int k = J_01_row_start[i]; k < J_01_row_start[i + 1]; k++)
+          for (SparseOffset k = J_01_row_start[i];
+               k < J_01_row_start[i + 1];
+               k++)
           {
             if (J_10_column_index[J_10_row_start[J_01_column_index[k]]] <=
                   static_cast<int>(j) &&
@@ -599,7 +601,9 @@ namespace oomph
           // next compute contribution for A_02*lumped(A_22)'*A_20
 
           // iterate through non-zero entries of  column j of A_10
-          for (int k = J_02_row_start[i]; k < J_02_row_start[i + 1]; k++)
+          for (SparseOffset k = J_02_row_start[i];
+               k < J_02_row_start[i + 1];
+               k++)
           {
             if (J_20_column_index[J_20_row_start[J_02_column_index[k]]] <=
                   static_cast<int>(j) &&
@@ -668,6 +668,375 @@ namespace oomph
   }
 
 
+  //===========================================================================
+  /// Calculate the contravariant tensors from the covariant tensors at
+  /// n_point points and return the determinants of the covariant tensors.
+  /// Entry (i,j) at point ipt is stored in Gdown[(i*dim+j)*n_point+ipt].
+  //===========================================================================
+  void ConstitutiveLaw::calculate_contravariant_at_points(
+    const unsigned& n_point,
+    const unsigned& dim,
+    const double* Gdown,
+    double* Gup,
+    double* det)
+  {
+    // Offsets of the individual entries in the structure of arrays
+    const unsigned n = n_point;
+
+    // The inversion depends upon the dimension of the matrix. The
+    // expressions are identical to those in calculate_contravariant(...)
+    switch (dim)
+    {
+        // One dimension
+      case 1:
+        for (unsigned ipt = 0; ipt < n; ipt++)
+        {
+          det[ipt] = Gdown[ipt];
+          Gup[ipt] = 1.0 / Gdown[ipt];
+        }
+        break;
+
+        // Two dimensions
+      case 2:
+      {
+        const double* G00 = Gdown;
+        const double* G01 = Gdown + n;
+        const double* G10 = Gdown + 2 * n;
+        const double* G11 = Gdown + 3 * n;
+        for (unsigned ipt = 0; ipt < n; ipt++)
+        {
+          const double d = G00[ipt] * G11[ipt] - G01[ipt] * G10[ipt];
+          det[ipt] = d;
+          Gup[ipt] = G11[ipt] / d;
+          Gup[n + ipt] = -G01[ipt] / d;
+          Gup[2 * n + ipt] = -G10[ipt] / d;
+          Gup[3 * n + ipt] = G00[ipt] / d;
+        }
+      }
+      break;
+
+      // Three dimensions
+      case 3:
+      {
+        const double* G00 = Gdown;
+        const double* G01 = Gdown + n;
+        const double* G02 = Gdown + 2 * n;
+        const double* G10 = Gdown + 3 * n;
+        const double* G11 = Gdown + 4 * n;
+        const double* G12 = Gdown + 5 * n;
+        const double* G20 = Gdown + 6 * n;
+        const double* G21 = Gdown + 7 * n;
+        const double* G22 = Gdown + 8 * n;
+        for (unsigned ipt = 0; ipt < n; ipt++)
+        {
+          const double d = G00[ipt] * G11[ipt] * G22[ipt] +
+                           G01[ipt] * G12[ipt] * G20[ipt] +
+                           G02[ipt] * G10[ipt] * G21[ipt] -
+                           G00[ipt] * G12[ipt] * G21[ipt] -
+                           G01[ipt] * G10[ipt] * G22[ipt] -
+                           G02[ipt] * G11[ipt] * G20[ipt];
+          det[ipt] = d;
+          Gup[ipt] = (G11[ipt] * G22[ipt] - G12[ipt] * G21[ipt]) / d;
+          Gup[n + ipt] = -(G01[ipt] * G22[ipt] - G02[ipt] * G21[ipt]) / d;
+          Gup[2 * n + ipt] = (G01[ipt] * G12[ipt] - G02[ipt] * G11[ipt]) / d;
+          Gup[3 * n + ipt] = -(G10[ipt] * G22[ipt] - G12[ipt] * G20[ipt]) / d;
+          Gup[4 * n + ipt] = (G00[ipt] * G22[ipt] - G02[ipt] * G20[ipt]) / d;
+          Gup[5 * n + ipt] = -(G00[ipt] * G12[ipt] - G02[ipt] * G10[ipt]) / d;
+          Gup[6 * n + ipt] = (G10[ipt] * G21[ipt] - G11[ipt] * G20[ipt]) / d;
+          Gup[7 * n + ipt] = -(G00[ipt] * G21[ipt] - G01[ipt] * G20[ipt]) / d;
+          Gup[8 * n + ipt] = (G00[ipt] * G11[ipt] - G01[ipt] * G10[ipt]) / d;
+        }
+      }
+      break;
+
+      default:
+        throw OomphLibError("Dimension of matrix must be 1, 2 or 3\n",
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+        break;
+    }
+  }
+
+
+  //==========================================================================
+  /// Calculate the contravariant 2nd Piola Kirchhoff stress tensor at
+  /// n_point points. Default: Copy each point's metric tensors into
+  /// (reused) matrices and call the pointwise version.
+  //==========================================================================
+  void ConstitutiveLaw::calculate_second_piola_kirchhoff_stress_at_points(
+    const unsigned& n_point,
+    const unsigned& dim,
+    const double* g,
+    const double* G,
+    double* sigma)
+  {
+    DenseMatrix<double> g_pt(dim, dim), G_pt(dim, dim), sigma_pt(dim, dim);
+    for (unsigned ipt = 0; ipt < n_point; ipt++)
+    {
+      for (unsigned i = 0; i < dim; i++)
+      {
+        for (unsigned j = 0; j < dim; j++)
+        {
+          g_pt(i, j) = g[(i * dim + j) * n_point + ipt];
+          G_pt(i, j) = G[(i * dim + j) * n_point + ipt];
+        }
+      }
+
+      calculate_second_piola_kirchhoff_stress(g_pt, G_pt, sigma_pt);
+
+      for (unsigned i = 0; i < dim; i++)
+      {
+        for (unsigned j = 0; j < dim; j++)
+        {
+          sigma[(i * dim + j) * n_point + ipt] = sigma_pt(i, j);
+        }
+      }
+    }
+  }
+
+
+  //==========================================================================
+  /// Calculate the derivatives of the contravariant 2nd Piola Kirchhoff
+  /// stress tensor with respect to the deformed metric tensor at
+  /// n_point points. Default: Call the pointwise version for each point.
+  //==========================================================================
+  void ConstitutiveLaw::calculate_d_second_piola_kirchhoff_stress_dG_at_points(
+    const unsigned& n_point,
+    const unsigned& dim,
+    const double* g,
+    const double* G,
+    const double* sigma,
+    double* d_sigma_dG,
+    const bool& symmetrize_tensor)
+  {
+    DenseMatrix<double> g_pt(dim, dim), G_pt(dim, dim), sigma_pt(dim, dim);
+    RankFourTensor<double> d_sigma_dG_pt(dim, dim, dim, dim);
+    const unsigned n_entry = dim * dim;
+    for (unsigned ipt = 0; ipt < n_point; ipt++)
+    {
+      for (unsigned i = 0; i < dim; i++)
+      {
+        for (unsigned j = 0; j < dim; j++)
+        {
+          g_pt(i, j) = g[(i * dim + j) * n_point + ipt];
+          G_pt(i, j) = G[(i * dim + j) * n_point + ipt];
+          sigma_pt(i, j) = sigma[(i * dim + j) * n_point + ipt];
+        }
+      }
+
+      // Initialise (the pointwise version may only fill in the
+      // "upper triangular" entries)
+      d_sigma_dG_pt.initialise(0.0);
+      calculate_d_second_piola_kirchhoff_stress_dG(
+        g_pt, G_pt, sigma_pt, d_sigma_dG_pt, symmetrize_tensor);
+
+      for (unsigned ij = 0; ij < n_entry; ij++)
+      {
+        for (unsigned kl = 0; kl < n_entry; kl++)
+        {
+          d_sigma_dG[(ij * n_entry + kl) * n_point + ipt] =
+            d_sigma_dG_pt.raw_direct_access(ij * n_entry + kl);
+        }
+      }
+    }
+  }
+
+
+  //==========================================================================
+  /// Calculate the deviatoric part of the stress, the contravariant
+  /// deformed metric tensor and its determinant at n_point points
+  /// (truly-incompressible form). Default: Call the pointwise version
+  /// for each point.
+  //==========================================================================
+  void ConstitutiveLaw::calculate_second_piola_kirchhoff_stress_at_points(
+    const unsigned& n_point,
+    const unsigned& dim,
+    const double* g,
+    const double* G,
+    double* sigma_dev,
+    double* G_contra,
+    double* Gdet)
+  {
+    DenseMatrix<double> g_pt(dim, dim), G_pt(dim, dim);
+    DenseMatrix<double> sigma_dev_pt(dim, dim), G_contra_pt(dim, dim);
+    for (unsigned ipt = 0; ipt < n_point; ipt++)
+    {
+      for (unsigned i = 0; i < dim; i++)
+      {
+        for (unsigned j = 0; j < dim; j++)
+        {
+          g_pt(i, j) = g[(i * dim + j) * n_point + ipt];
+          G_pt(i, j) = G[(i * dim + j) * n_point + ipt];
+        }
+      }
+
+      calculate_second_piola_kirchhoff_stress(
+        g_pt, G_pt, sigma_dev_pt, G_contra_pt, Gdet[ipt]);
+
+      for (unsigned i = 0; i < dim; i++)
+      {
+        for (unsigned j = 0; j < dim; j++)
+        {
+          sigma_dev[(i * dim + j) * n_point + ipt] = sigma_dev_pt(i, j);
+          G_contra[(i * dim + j) * n_point + ipt] = G_contra_pt(i, j);
+        }
+      }
+    }
+  }
+
+
+  //==========================================================================
+  /// Calculate the deviatoric part of the stress, the contravariant
+  /// deformed metric tensor, the generalised dilatation and the inverse
+  /// bulk modulus at n_point points (near-incompressible form).
+  /// Default: Call the pointwise version for each point.
+  //==========================================================================
+  void ConstitutiveLaw::calculate_second_piola_kirchhoff_stress_at_points(
+    const unsigned& n_point,
+    const unsigned& dim,
+    const double* g,
+    const double* G,
+    double* sigma_dev,
+    double* Gcontra,
+    double* gen_dil,
+    double* inv_kappa)
+  {
+    DenseMatrix<double> g_pt(dim, dim), G_pt(dim, dim);
+    DenseMatrix<double> sigma_dev_pt(dim, dim), Gcontra_pt(dim, dim);
+    for (unsigned ipt = 0; ipt < n_point; ipt++)
+    {
+      for (unsigned i = 0; i < dim; i++)
+      {
+        for (unsigned j = 0; j < dim; j++)
+        {
+          g_pt(i, j) = g[(i * dim + j) * n_point + ipt];
+          G_pt(i, j) = G[(i * dim + j) * n_point + ipt];
+        }
+      }
+
+      calculate_second_piola_kirchhoff_stress(g_pt,
+                                              G_pt,
+                                              sigma_dev_pt,
+                                              Gcontra_pt,
+                                              gen_dil[ipt],
+                                              inv_kappa[ipt]);
+
+      for (unsigned i = 0; i < dim; i++)
+      {
+        for (unsigned j = 0; j < dim; j++)
+        {
+          sigma_dev[(i * dim + j) * n_point + ipt] = sigma_dev_pt(i, j);
+          Gcontra[(i * dim + j) * n_point + ipt] = Gcontra_pt(i, j);
+        }
+      }
+    }
+  }
+
+
+  //==========================================================================
+  /// Finite-difference the derivatives of the stress tensor with respect
+  /// to the deformed metric tensor at n_point points. As in the pointwise
+  /// version we only increment the "upper" entries of G (and their
+  /// symmetric counterparts) and only fill in the "upper triangular"
+  /// entries unless symmetrize_tensor is true. Each increment is applied
+  /// to all points simultaneously so the batched stress computation is
+  /// called only dim*(dim+1)/2 times.
+  //==========================================================================
+  void ConstitutiveLaw::fd_d_second_piola_kirchhoff_stress_dG_at_points(
+    const unsigned& n_point,
+    const unsigned& dim,
+    const double* g,
+    const double* G,
+    const double* sigma,
+    double* d_sigma_dG,
+    const bool& symmetrize_tensor)
+  {
+    // FD step
+    const double eps_fd = GeneralisedElement::Default_fd_jacobian_step;
+
+    // Number of entries in each tensor (per point)
+    const unsigned n_entry = dim * dim;
+
+    // Advanced metric tensors and stresses
+    Vector<double> G_pls(n_entry * n_point);
+    Vector<double> sigma_pls(n_entry * n_point);
+
+    // Copy across the original values
+    for (unsigned k = 0; k < n_entry * n_point; k++)
+    {
+      G_pls[k] = G[k];
+    }
+
+    for (unsigned i = 0; i < dim; i++)
+    {
+      for (unsigned j = i; j < dim; j++)
+      {
+        const unsigned ij = (i * dim + j) * n_point;
+        const unsigned ji = (j * dim + i) * n_point;
+        for (unsigned ipt = 0; ipt < n_point; ipt++)
+        {
+          G_pls[ij + ipt] += eps_fd;
+          G_pls[ji + ipt] = G_pls[ij + ipt];
+        }
+
+        // Get advanced stresses at all points
+        this->calculate_second_piola_kirchhoff_stress_at_points(
+          n_point, dim, g, &G_pls[0], &sigma_pls[0]);
+
+        for (unsigned ii = 0; ii < dim; ii++)
+        {
+          for (unsigned jj = ii; jj < dim; jj++)
+          {
+            const unsigned iijj = (ii * dim + jj) * n_point;
+            double* d_pt =
+              d_sigma_dG + ((ii * dim + jj) * n_entry + i * dim + j) * n_point;
+            for (unsigned ipt = 0; ipt < n_point; ipt++)
+            {
+              d_pt[ipt] =
+                (sigma_pls[iijj + ipt] - sigma[iijj + ipt]) / eps_fd;
+            }
+          }
+        }
+
+        // Reset
+        for (unsigned ipt = 0; ipt < n_point; ipt++)
+        {
+          G_pls[ij + ipt] = G[ij + ipt];
+          G_pls[ji + ipt] = G[ji + ipt];
+        }
+      }
+    }
+
+    // If we are symmetrising the tensor, do so (exactly as in the
+    // pointwise version)
+    if (symmetrize_tensor)
+    {
+      for (unsigned i = 0; i < dim; i++)
+      {
+        for (unsigned j = 0; j < i; j++)
+        {
+          for (unsigned ii = 0; ii < dim; ii++)
+          {
+            for (unsigned jj = 0; jj < ii; jj++)
+            {
+              double* d_pt =
+                d_sigma_dG +
+                ((ii * dim + jj) * n_entry + i * dim + j) * n_point;
+              const double* d_sym_pt =
+                d_sigma_dG +
+                ((jj * dim + ii) * n_entry + j * dim + i) * n_point;
+              for (unsigned ipt = 0; ipt < n_point; ipt++)
+              {
+                d_pt[ipt] = d_sym_pt[ipt];
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+
   /// //////////////////////////////////////////////////////////////////
   /// //////////////////////////////////////////////////////////////////
   /// //////////////////////////////////////////////////////////////////
@@ -752,6 +1121,97 @@ namespace oomph
     }
   }
 
+  //=====================================================================
+  /// Calculate the contravariant 2nd Piola Kirchhoff stress tensor at
+  /// n_point points in one go. Same algebra as the pointwise version
+  /// but with the loops over the points innermost so that they can
+  /// be vectorised.
+  //=====================================================================
+  void GeneralisedHookean::calculate_second_piola_kirchhoff_stress_at_points(
+    const unsigned& n_point,
+    const unsigned& dim,
+    const double* g,
+    const double* G,
+    double* sigma)
+  {
+    // Number of entries in each tensor (per point)
+    const unsigned n_entry = dim * dim;
+    const unsigned n = n_point;
+
+    // Calculate the contravariant deformed metric tensors
+    Vector<double> Gup(n_entry * n), detG(n);
+    calculate_contravariant_at_points(n, dim, G, &Gup[0], &detG[0]);
+
+    // Premultiply some constants
+    double C1 = (*E_pt) / (2.0 * (1.0 + (*Nu_pt)));
+    double C2 = 2.0 * (*Nu_pt) / (1.0 - 2.0 * (*Nu_pt));
+
+    // Strain tensors: Upper triangle, then copy across
+    Vector<double> strain(n_entry * n);
+    for (unsigned i = 0; i < dim; i++)
+    {
+      for (unsigned j = i; j < dim; j++)
+      {
+        const unsigned ij = (i * dim + j) * n;
+        const unsigned ji = (j * dim + i) * n;
+        for (unsigned ipt = 0; ipt < n; ipt++)
+        {
+          strain[ij + ipt] = 0.5 * (G[ij + ipt] - g[ij + ipt]);
+          strain[ji + ipt] = strain[ij + ipt];
+        }
+      }
+    }
+
+    // Compute upper triangle of stress
+    for (unsigned i = 0; i < dim; i++)
+    {
+      for (unsigned j = i; j < dim; j++)
+      {
+        double* sigma_ij = sigma + (i * dim + j) * n;
+        const double* Gup_ij = &Gup[(i * dim + j) * n];
+        for (unsigned ipt = 0; ipt < n; ipt++)
+        {
+          sigma_ij[ipt] = 0.0;
+        }
+        for (unsigned k = 0; k < dim; k++)
+        {
+          const double* Gup_ik = &Gup[(i * dim + k) * n];
+          const double* Gup_jk = &Gup[(j * dim + k) * n];
+          for (unsigned l = 0; l < dim; l++)
+          {
+            const double* Gup_jl = &Gup[(j * dim + l) * n];
+            const double* Gup_il = &Gup[(i * dim + l) * n];
+            const double* Gup_kl = &Gup[(k * dim + l) * n];
+            const double* strain_kl = &strain[(k * dim + l) * n];
+            for (unsigned ipt = 0; ipt < n; ipt++)
+            {
+              sigma_ij[ipt] += C1 *
+                               (Gup_ik[ipt] * Gup_jl[ipt] +
+                                Gup_il[ipt] * Gup_jk[ipt] +
+                                C2 * Gup_ij[ipt] * Gup_kl[ipt]) *
+                               strain_kl[ipt];
+            }
+          }
+        }
+      }
+    }
+
+    // Copy across
+    for (unsigned i = 0; i < dim; i++)
+    {
+      for (unsigned j = 0; j < i; j++)
+      {
+        const unsigned ij = (i * dim + j) * n;
+        const unsigned ji = (j * dim + i) * n;
+        for (unsigned ipt = 0; ipt < n; ipt++)
+        {
+          sigma[ij + ipt] = sigma[ji + ipt];
+        }
+      }
+    }
+  }
+
+
   //===========================================================================
   /// Calculate the deviatoric part of the contravariant
   /// 2nd Piola Kirchoff stress tensor. Also return the contravariant
@@ -997,6 +1457,141 @@ namespace oomph
     }
   }
 
+  //========================================================================
+  /// Calculate the contravariant 2nd Piola Kirchhoff stress tensor at
+  /// n_point points in one go. Same algebra as the pointwise version but
+  /// with the loops over the points innermost, and with a single call
+  /// to the strain energy function for all points.
+  //=======================================================================
+  void IsotropicStrainEnergyFunctionConstitutiveLaw::
+    calculate_second_piola_kirchhoff_stress_at_points(const unsigned& n_point,
+                                                      const unsigned& dim,
+                                                      const double* g,
+                                                      const double* G,
+                                                      double* sigma)
+  {
+#ifdef PARANOID
+    if (dim == 1)
+    {
+      throw OomphLibError("Check constitutive equations carefully when dim=1",
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    // Number of entries in each tensor (per point)
+    const unsigned n_entry = dim * dim;
+    const unsigned n = n_point;
+
+    // Calculate the contravariant undeformed and deformed metric tensors
+    // and get the determinants of the metric tensors
+    Vector<double> gup(n_entry * n), Gup(n_entry * n), detg(n), detG(n);
+    calculate_contravariant_at_points(n, dim, g, &gup[0], &detg[0]);
+    calculate_contravariant_at_points(n, dim, G, &Gup[0], &detG[0]);
+
+    // Calculate the strain invariants (I[k*n+ipt] is the k-th invariant
+    // at point ipt)
+    Vector<double> I(3 * n, 0.0);
+    double* I0 = &I[0];
+    double* I1 = &I[n];
+    double* I2 = &I[2 * n];
+
+    // The third strain invaraint is the volumetric change
+    for (unsigned ipt = 0; ipt < n; ipt++)
+    {
+      I2[ipt] = detG[ipt] / detg[ipt];
+    }
+
+    // The first and second are a bit more complex --- see G&Z
+    for (unsigned ij = 0; ij < n_entry; ij++)
+    {
+      const unsigned offset = ij * n;
+      for (unsigned ipt = 0; ipt < n; ipt++)
+      {
+        I0[ipt] += gup[offset + ipt] * G[offset + ipt];
+        I1[ipt] += g[offset + ipt] * Gup[offset + ipt];
+      }
+    }
+
+    // Plane strain (see pointwise version) and second strain
+    // invariant is multiplied by the third.
+    const double plane_strain_offset = (dim == 2) ? 1.0 : 0.0;
+    for (unsigned ipt = 0; ipt < n; ipt++)
+    {
+      I0[ipt] += plane_strain_offset;
+      I1[ipt] += plane_strain_offset;
+      I1[ipt] *= I2[ipt];
+    }
+
+    // Calculate the derivatives of the strain energy function wrt the
+    // strain invariants at all points
+    Vector<double> dWdI(3 * n, 0.0);
+    Strain_energy_function_pt->derivatives_at_points(n, &I[0], &dWdI[0]);
+    const double* dWdI0 = &dWdI[0];
+    const double* dWdI1 = &dWdI[n];
+    const double* dWdI2 = &dWdI[2 * n];
+
+    // Only bother to compute the tensor B^{ij} (Green & Zerna notation)
+    // if the derivative wrt the second strain invariant is non-zero
+    // somewhere
+    bool need_bup = false;
+    for (unsigned ipt = 0; ipt < n; ipt++)
+    {
+      if (std::fabs(dWdI1[ipt]) > 0.0)
+      {
+        need_bup = true;
+        break;
+      }
+    }
+    Vector<double> Bup(n_entry * n, 0.0);
+    if (need_bup)
+    {
+      for (unsigned i = 0; i < dim; i++)
+      {
+        for (unsigned j = 0; j < dim; j++)
+        {
+          double* Bup_ij = &Bup[(i * dim + j) * n];
+          const double* gup_ij = &gup[(i * dim + j) * n];
+          for (unsigned ipt = 0; ipt < n; ipt++)
+          {
+            Bup_ij[ipt] = I0[ipt] * gup_ij[ipt];
+          }
+          for (unsigned r = 0; r < dim; r++)
+          {
+            const double* gup_ir = &gup[(i * dim + r) * n];
+            for (unsigned s = 0; s < dim; s++)
+            {
+              const double* gup_js = &gup[(j * dim + s) * n];
+              const double* G_rs = G + (r * dim + s) * n;
+              for (unsigned ipt = 0; ipt < n; ipt++)
+              {
+                Bup_ij[ipt] -= gup_ir[ipt] * gup_js[ipt] * G_rs[ipt];
+              }
+            }
+          }
+        }
+      }
+    }
+
+    // Put it all together to get the stress, using the functions phi,
+    // psi and p (Green & Zerna notation, scaled as in the pointwise
+    // version)
+    for (unsigned ij = 0; ij < n_entry; ij++)
+    {
+      const unsigned offset = ij * n;
+      for (unsigned ipt = 0; ipt < n; ipt++)
+      {
+        double phi = 2.0 * dWdI0[ipt];
+        double psi = 2.0 * dWdI1[ipt];
+        double p = 2.0 * dWdI2[ipt] * I2[ipt];
+        sigma[offset + ipt] = phi * gup[offset + ipt] +
+                              psi * Bup[offset + ipt] +
+                              p * Gup[offset + ipt];
+      }
+    }
+  }
+
+
   //===========================================================================
   /// Calculate the deviatoric part
   /// \f$ \overline{ \sigma^{ij}}\f$  of the contravariant
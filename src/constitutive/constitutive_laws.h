@@ -122,6 +122,32 @@ namespace oomph
       }
     }
 
+    /// Return the derivatives of the strain energy function with
+    /// respect to the strain invariants at n_point points in one go.
+    /// The invariants and their derivatives are stored as structure of
+    /// arrays, i.e. the k-th invariant at point ipt is I[k*n_point+ipt].
+    /// The default version calls derivatives(...) point by point;
+    /// strain energy functions with closed-form derivatives should
+    /// overload it to avoid the per-point virtual function call.
+    virtual void derivatives_at_points(const unsigned& n_point,
+                                       const double* I,
+                                       double* dWdI)
+    {
+      Vector<double> I_pt(3), dWdI_pt(3);
+      for (unsigned ipt = 0; ipt < n_point; ipt++)
+      {
+        for (unsigned k = 0; k < 3; k++)
+        {
+          I_pt[k] = I[k * n_point + ipt];
+        }
+        derivatives(I_pt, dWdI_pt);
+        for (unsigned k = 0; k < 3; k++)
+        {
+          dWdI[k * n_point + ipt] = dWdI_pt[k];
+        }
+      }
+    }
+
     /// Pure virtual function in which the user must declare if the
     /// constitutive equation requires an incompressible formulation
     /// in which the volume constraint is enforced explicitly.
@@ -177,6 +203,21 @@ namespace oomph
       dWdI[2] = 0.0;
     }
 
+    /// Return the derivatives of the strain energy function with
+    /// respect to the strain invariants at n_point points (structure
+    /// of arrays storage, see StrainEnergyFunction::derivatives_at_points())
+    void derivatives_at_points(const unsigned& n_point,
+                               const double* I,
+                               double* dWdI)
+    {
+      for (unsigned ipt = 0; ipt < n_point; ipt++)
+      {
+        dWdI[ipt] = (*C1_pt);
+        dWdI[n_point + ipt] = (*C2_pt);
+        dWdI[2 * n_point + ipt] = 0.0;
+      }
+    }
+
     /// Pure virtual function in which the user must declare if the
     /// constitutive equation requires an incompressible formulation
     /// in which the volume constraint is enforced explicitly.
@@ -276,6 +317,25 @@ namespace oomph
                          (2.0 * (1.0 - 2.0 * (*Nu_pt))));
     }
 
+    /// Return the derivatives of the strain energy function with
+    /// respect to the strain invariants at n_point points (structure
+    /// of arrays storage, see StrainEnergyFunction::derivatives_at_points())
+    void derivatives_at_points(const unsigned& n_point,
+                               const double* I,
+                               double* dWdI)
+    {
+      double G = (*E_pt) / (2.0 * (1.0 + (*Nu_pt)));
+      for (unsigned ipt = 0; ipt < n_point; ipt++)
+      {
+        dWdI[ipt] = 0.5 * (*C1_pt);
+        dWdI[n_point + ipt] = 0.5 * (G - (*C1_pt));
+        dWdI[2 * n_point + ipt] =
+          0.5 * ((*C1_pt) - 2.0 * G +
+                 2.0 * (1.0 - (*Nu_pt)) * G * (I[2 * n_point + ipt] - 1.0) /
+                   (2.0 * (1.0 - 2.0 * (*Nu_pt))));
+      }
+    }
+
 
     /// Pure virtual function in which the user must declare if the
     /// constitutive equation requires an incompressible formulation
@@ -513,6 +573,31 @@ namespace oomph
                                       RankFourTensor<double>& dGcontra_dG,
                                       DenseMatrix<double>& d_detG_dG);
 
+    /// Calculate the contravariant tensors from the covariant tensors
+    /// at n_point points and return the determinants of the covariant
+    /// tensors. Tensors are stored as structure of arrays, i.e. entry
+    /// (i,j) at point ipt is Gcov[(i*dim+j)*n_point+ipt].
+    void calculate_contravariant_at_points(const unsigned& n_point,
+                                           const unsigned& dim,
+                                           const double* Gcov,
+                                           double* Gcontra,
+                                           double* det);
+
+    /// Finite-difference the derivatives of the stress tensor with
+    /// respect to the deformed metric tensor at n_point points, using
+    /// one call to calculate_second_piola_kirchhoff_stress_at_points(...)
+    /// per independent component of G (rather than one per component
+    /// and point). Storage as in
+    /// calculate_d_second_piola_kirchhoff_stress_dG_at_points(...)
+    void fd_d_second_piola_kirchhoff_stress_dG_at_points(
+      const unsigned& n_point,
+      const unsigned& dim,
+      const double* g,
+      const double* G,
+      const double* sigma,
+      double* d_sigma_dG,
+      const bool& symmetrize_tensor);
+
 
   public:
     /// Empty constructor
@@ -643,6 +728,73 @@ namespace oomph
       const bool& symmetrize_tensor = true);
 
 
+    /// Calculate the contravariant 2nd Piola Kirchhoff stress tensor
+    /// at n_point points in one go, e.g. at all integration points of
+    /// an element. The dim x dim tensors are stored as structure of
+    /// arrays so that loops over the points are contiguous: entry (i,j)
+    /// at point ipt is g[(i*dim+j)*n_point+ipt], and similarly for G
+    /// and sigma. The default implementation calls the pointwise
+    /// version for each point; constitutive laws that overload the
+    /// pointwise version should overload this one too.
+    virtual void calculate_second_piola_kirchhoff_stress_at_points(
+      const unsigned& n_point,
+      const unsigned& dim,
+      const double* g,
+      const double* G,
+      double* sigma);
+
+    /// Calculate the derivatives of the contravariant 2nd Piola
+    /// Kirchhoff stress tensor with respect to the deformed metric
+    /// tensor at n_point points in one go. Storage of g, G and sigma as
+    /// in calculate_second_piola_kirchhoff_stress_at_points(...);
+    /// the derivative of sigma(i,j) w.r.t. G(k,l) at point ipt is
+    /// d_sigma_dG[(((i*dim+j)*dim+k)*dim+l)*n_point+ipt].
+    /// The default implementation calls the pointwise version for each
+    /// point. If the boolean flag symmetrize_tensor is false, only the
+    /// "upper  triangular" entries of the tensor will be filled in.
+    virtual void calculate_d_second_piola_kirchhoff_stress_dG_at_points(
+      const unsigned& n_point,
+      const unsigned& dim,
+      const double* g,
+      const double* G,
+      const double* sigma,
+      double* d_sigma_dG,
+      const bool& symmetrize_tensor = true);
+
+    /// Calculate the deviatoric part of the contravariant 2nd Piola
+    /// Kirchhoff stress tensor, the contravariant deformed metric tensor
+    /// and the determinant of the deformed metric tensor at n_point
+    /// points in one go (truly-incompressible form). Tensors are stored
+    /// as in calculate_second_piola_kirchhoff_stress_at_points(...);
+    /// Gdet has one entry per point. The default implementation calls
+    /// the pointwise version for each point.
+    virtual void calculate_second_piola_kirchhoff_stress_at_points(
+      const unsigned& n_point,
+      const unsigned& dim,
+      const double* g,
+      const double* G,
+      double* sigma_dev,
+      double* G_contra,
+      double* Gdet);
+
+    /// Calculate the deviatoric part of the contravariant 2nd Piola
+    /// Kirchhoff stress tensor, the contravariant deformed metric
+    /// tensor, the generalised dilatation and the inverse of the bulk
+    /// modulus at n_point points in one go (near-incompressible form).
+    /// Tensors are stored as in
+    /// calculate_second_piola_kirchhoff_stress_at_points(...); gen_dil
+    /// and inv_kappa have one entry per point. The default
+    /// implementation calls the pointwise version for each point.
+    virtual void calculate_second_piola_kirchhoff_stress_at_points(
+      const unsigned& n_point,
+      const unsigned& dim,
+      const double* g,
+      const double* G,
+      double* sigma_dev,
+      double* Gcontra,
+      double* gen_dil,
+      double* inv_kappa);
+
     /// Pure virtual function in which the user must declare if the
     /// constitutive equation requires an incompressible formulation
     /// in which the volume constraint is enforced explicitly.
@@ -787,6 +939,35 @@ namespace oomph
                                                  double& inv_kappa);
 
 
+    /// Import the batched versions of the (near-)incompressible forms
+    using ConstitutiveLaw::calculate_second_piola_kirchhoff_stress_at_points;
+
+    /// Calculate the contravariant 2nd Piola Kirchhoff stress tensor
+    /// at n_point points in one go (structure of arrays storage, see
+    /// ConstitutiveLaw::calculate_second_piola_kirchhoff_stress_at_points())
+    void calculate_second_piola_kirchhoff_stress_at_points(
+      const unsigned& n_point,
+      const unsigned& dim,
+      const double* g,
+      const double* G,
+      double* sigma);
+
+    /// Calculate the derivatives of the stress tensor with respect
+    /// to the deformed metric tensor at n_point points by finite
+    /// differencing the batched stress computation.
+    void calculate_d_second_piola_kirchhoff_stress_dG_at_points(
+      const unsigned& n_point,
+      const unsigned& dim,
+      const double* g,
+      const double* G,
+      const double* sigma,
+      double* d_sigma_dG,
+      const bool& symmetrize_tensor = true)
+    {
+      fd_d_second_piola_kirchhoff_stress_dG_at_points(
+        n_point, dim, g, G, sigma, d_sigma_dG, symmetrize_tensor);
+    }
+
     /// Pure virtual function in which the writer must declare if the
     /// constitutive equation requires an incompressible formulation
     /// in which the volume constraint is enforced explicitly.
@@ -875,6 +1056,37 @@ namespace oomph
                                                  double& inv_kappa);
 
 
+    /// Import the batched versions of the (near-)incompressible forms
+    using ConstitutiveLaw::calculate_second_piola_kirchhoff_stress_at_points;
+
+    /// Calculate the contravariant 2nd Piola Kirchhoff stress tensor
+    /// at n_point points in one go, with a single call to
+    /// StrainEnergyFunction::derivatives_at_points() for all points
+    /// (structure of arrays storage, see
+    /// ConstitutiveLaw::calculate_second_piola_kirchhoff_stress_at_points())
+    void calculate_second_piola_kirchhoff_stress_at_points(
+      const unsigned& n_point,
+      const unsigned& dim,
+      const double* g,
+      const double* G,
+      double* sigma);
+
+    /// Calculate the derivatives of the stress tensor with respect
+    /// to the deformed metric tensor at n_point points by finite
+    /// differencing the batched stress computation.
+    void calculate_d_second_piola_kirchhoff_stress_dG_at_points(
+      const unsigned& n_point,
+      const unsigned& dim,
+      const double* g,
+      const double* G,
+      const double* sigma,
+      double* d_sigma_dG,
+      const bool& symmetrize_tensor = true)
+    {
+      fd_d_second_piola_kirchhoff_stress_dG_at_points(
+        n_point, dim, g, G, sigma, d_sigma_dG, symmetrize_tensor);
+    }
+
     /// State if the constitutive equation requires an incompressible
     /// formulation in which the volume constraint is enforced explicitly.
     /// Used as a sanity check in PARANOID mode. This is determined
@@ -320,6 +320,156 @@ namespace oomph
     }
   }
 
+  //======================================================================
+  /// Add the element's contribution to the products of the Hessian
+  /// (d(J_{ij})/d u_{k}) Y_{j} C_{k} with the vectors Y and C. The
+  /// residuals are linear in the unknowns, apart from the Monge-Ampere
+  /// terms which are quadratic in the smoothed derivatives of w and phi.
+  /// Their contribution to the product is therefore obtained by
+  /// evaluating the (symmetrised) bilinear form with the second
+  /// derivatives interpolated from Y and from C, respectively.
+  //======================================================================
+  void FoepplvonKarmanEquations::
+    fill_in_contribution_to_hessian_vector_products(
+      Vector<double> const& Y,
+      DenseMatrix<double> const& C,
+      DenseMatrix<double>& product)
+  {
+    // Nothing to do for the linear bending model
+    if (Linear_bending_model)
+    {
+      return;
+    }
+
+    // Find out how many nodes there are
+    const unsigned n_node = nnode();
+
+    // Number of vectors C
+    const unsigned n_vec = C.nrow();
+
+    // Set up memory for the shape and test functions
+    Shape psi(n_node), test(n_node);
+    DShape dpsidx(n_node, 2), dtestdx(n_node, 2);
+
+    // Indices at which the unknowns are stored
+    const unsigned w_nodal_index = nodal_index_fvk(0);
+    const unsigned phi_nodal_index = nodal_index_fvk(2);
+    const unsigned smooth_dwdx_nodal_index = nodal_index_fvk(4);
+    const unsigned smooth_dwdy_nodal_index = nodal_index_fvk(5);
+    const unsigned smooth_dphidx_nodal_index = nodal_index_fvk(6);
+    const unsigned smooth_dphidy_nodal_index = nodal_index_fvk(7);
+
+    // Set the value of n_intpt
+    const unsigned n_intpt = integral_pt()->nweight();
+
+    // Second derivatives of w and phi (in the order xx, yy, xy),
+    // interpolated from the entries of Y and of the vectors C
+    double d2w_Y[3], d2phi_Y[3];
+    DenseMatrix<double> d2w_C(n_vec, 3), d2phi_C(n_vec, 3);
+
+    // Integers to store the local equation numbers
+    int local_eqn = 0;
+
+    // Loop over the integration points
+    for (unsigned ipt = 0; ipt < n_intpt; ipt++)
+    {
+      // Get the integral weight
+      double w = integral_pt()->weight(ipt);
+
+      // Call the derivatives of the shape and test functions
+      double J =
+        dshape_and_dtest_eulerian_at_knot_fvk(ipt, psi, dpsidx, test, dtestdx);
+
+      // Premultiply the weights and the Jacobian
+      double W = w * J;
+
+      // Initialise
+      for (unsigned k = 0; k < 3; k++)
+      {
+        d2w_Y[k] = 0.0;
+        d2phi_Y[k] = 0.0;
+      }
+      d2w_C.initialise(0.0);
+      d2phi_C.initialise(0.0);
+
+      // Interpolate the second derivatives as in the residuals; pinned
+      // values do not vary and therefore do not contribute
+      for (unsigned l = 0; l < n_node; l++)
+      {
+        // Derivatives of the smooth dw/dx, dw/dy, dphi/dx and dphi/dy
+        unsigned nodal_index[4] = {smooth_dwdx_nodal_index,
+                                   smooth_dwdy_nodal_index,
+                                   smooth_dphidx_nodal_index,
+                                   smooth_dphidy_nodal_index};
+        for (unsigned m = 0; m < 4; m++)
+        {
+          local_eqn = nodal_local_eqn(l, nodal_index[m]);
+          if (local_eqn >= 0)
+          {
+            // Contributions to the second derivatives of w or phi
+            // (xx or yy from the first derivative w.r.t. x or y;
+            // xy from both)
+            unsigned direction = m % 2;
+            double d_xx_or_yy = dpsidx(l, direction);
+            double d_xy = 0.5 * dpsidx(l, 1 - direction);
+            if (m < 2)
+            {
+              d2w_Y[direction] += Y[local_eqn] * d_xx_or_yy;
+              d2w_Y[2] += Y[local_eqn] * d_xy;
+              for (unsigned v = 0; v < n_vec; v++)
+              {
+                d2w_C(v, direction) += C(v, local_eqn) * d_xx_or_yy;
+                d2w_C(v, 2) += C(v, local_eqn) * d_xy;
+              }
+            }
+            else
+            {
+              d2phi_Y[direction] += Y[local_eqn] * d_xx_or_yy;
+              d2phi_Y[2] += Y[local_eqn] * d_xy;
+              for (unsigned v = 0; v < n_vec; v++)
+              {
+                d2phi_C(v, direction) += C(v, local_eqn) * d_xx_or_yy;
+                d2phi_C(v, 2) += C(v, local_eqn) * d_xy;
+              }
+            }
+          }
+        }
+      }
+
+      // Loop over the vectors C
+      for (unsigned v = 0; v < n_vec; v++)
+      {
+        // Second directional derivative of the Monge-Ampere term
+        // in the equation for w
+        double w_term =
+          eta() * (d2w_Y[0] * d2phi_C(v, 1) + d2w_C(v, 0) * d2phi_Y[1] +
+                   d2w_Y[1] * d2phi_C(v, 0) + d2w_C(v, 1) * d2phi_Y[0] -
+                   2.0 * (d2w_Y[2] * d2phi_C(v, 2) + d2w_C(v, 2) * d2phi_Y[2]));
+
+        // ... and in the equation for phi
+        double phi_term = -(d2w_Y[0] * d2w_C(v, 1) + d2w_C(v, 0) * d2w_Y[1] -
+                            2.0 * d2w_Y[2] * d2w_C(v, 2));
+
+        // Loop over the test functions
+        for (unsigned l = 0; l < n_node; l++)
+        {
+          local_eqn = nodal_local_eqn(l, w_nodal_index);
+          if (local_eqn >= 0)
+          {
+            product(v, local_eqn) += w_term * test(l) * W;
+          }
+
+          local_eqn = nodal_local_eqn(l, phi_nodal_index);
+          if (local_eqn >= 0)
+          {
+            product(v, local_eqn) += phi_term * test(l) * W;
+          }
+        }
+      }
+    } // End of loop over integration points
+  }
+
+
   /*
   void FoepplvonKarmanEquations::fill_in_contribution_to_jacobian(Vector<double>
   &residuals, DenseMatrix<double> &jacobian)
@@ -303,6 +303,14 @@ namespace oomph
     /// Fill in the residuals with this element's contribution
     void fill_in_contribution_to_residuals(Vector<double>& residuals);
 
+    /// Add the contribution of the (quadratic) Monge-Ampere terms to the
+    /// products of the Hessian with the vectors Y and C; all other terms
+    /// are linear in the unknowns.
+    void fill_in_contribution_to_hessian_vector_products(
+      Vector<double> const& Y,
+      DenseMatrix<double> const& C,
+      DenseMatrix<double>& product);
+
     // void fill_in_contribution_to_jacobian(Vector<double> &residuals,
     //                                      DenseMatrix<double> &jacobian);
 
@@ -674,6 +674,27 @@ namespace oomph
       }
     }
 
+    /// Return the cells of the paraview sub-elements in numerical form
+    /// (as written by write_paraview_output_offset_information(...),
+    /// write_paraview_offsets(...) and write_paraview_type(...)), for
+    /// use by the binary paraview output
+    void paraview_cells(const unsigned& nplot,
+                        Vector<int>& connectivity,
+                        Vector<int>& offsets,
+                        Vector<int>& types) const
+    {
+      unsigned local_loop = nsub_elements_paraview(nplot);
+      connectivity.resize(2 * local_loop);
+      offsets.resize(local_loop);
+      types.assign(local_loop, 3);
+      for (unsigned i = 0; i < local_loop; i++)
+      {
+        connectivity[2 * i] = i;
+        connectivity[2 * i + 1] = i + 1;
+        offsets[i] = 2 * (i + 1);
+      }
+    }
+
     /// Output
     void output(std::ostream& outfile);
 
@@ -1049,6 +1070,31 @@ namespace oomph
       }
     }
 
+    /// Return the cells of the paraview sub-elements in numerical form
+    /// (as written by write_paraview_output_offset_information(...),
+    /// write_paraview_offsets(...) and write_paraview_type(...)), for
+    /// use by the binary paraview output
+    void paraview_cells(const unsigned& nplot,
+                        Vector<int>& connectivity,
+                        Vector<int>& offsets,
+                        Vector<int>& types) const
+    {
+      unsigned local_loop = nsub_elements_paraview(nplot);
+      connectivity.resize(4 * local_loop);
+      offsets.resize(local_loop);
+      types.assign(local_loop, 9);
+      for (unsigned i = 0; i < local_loop; i++)
+      {
+        unsigned d = (i - (i % (nplot - 1))) / (nplot - 1);
+        unsigned first = i % (nplot - 1) + d * nplot;
+        connectivity[4 * i] = first;
+        connectivity[4 * i + 1] = first + 1;
+        connectivity[4 * i + 2] = first + 1 + nplot;
+        connectivity[4 * i + 3] = first + nplot;
+        offsets[i] = 4 * (i + 1);
+      }
+    }
+
     /// Output
     void output(std::ostream& outfile);
 
@@ -1509,6 +1555,49 @@ namespace oomph
       }
     }
 
+    /// Return the cells of the paraview sub-elements in numerical form
+    /// (as written by write_paraview_output_offset_information(...),
+    /// write_paraview_offsets(...) and write_paraview_type(...)), for
+    /// use by the binary paraview output
+    void paraview_cells(const unsigned& nplot,
+                        Vector<int>& connectivity,
+                        Vector<int>& offsets,
+                        Vector<int>& types) const
+    {
+      unsigned local_loop = nsub_elements_paraview(nplot);
+      connectivity.resize(8 * local_loop);
+      offsets.resize(local_loop);
+      types.assign(local_loop, 12);
+
+      // Sub-elements are numbered layer by layer, as in
+      // write_paraview_output_offset_information(...)
+      unsigned sub_plot = (nplot - 1) * (nplot - 1);
+      unsigned count = 0;
+      for (unsigned r = 0; r < nplot - 1; r++)
+      {
+        for (unsigned i = 0; i < sub_plot; i++)
+        {
+          unsigned d = ((i - (i % (nplot - 1))) / (nplot - 1));
+          unsigned first = i % (nplot - 1) + d * nplot + r * nplot * nplot;
+
+          // Lower level of rectangle
+          connectivity[8 * count] = first;
+          connectivity[8 * count + 1] = first + 1;
+          connectivity[8 * count + 2] = first + 1 + nplot;
+          connectivity[8 * count + 3] = first + nplot;
+
+          // Upper level of rectangle
+          connectivity[8 * count + 4] = first + nplot * nplot;
+          connectivity[8 * count + 5] = first + 1 + nplot * nplot;
+          connectivity[8 * count + 6] = first + 1 + nplot + nplot * nplot;
+          connectivity[8 * count + 7] = first + nplot + nplot * nplot;
+
+          offsets[count] = 8 * (count + 1);
+          count++;
+        }
+      }
+    }
+
     /// Output
     void output(std::ostream& outfile);
 
@@ -109,6 +109,14 @@ namespace oomph
     }
 
 
+    /// Add the memory held by the LU factors to the account (forward
+    /// the call to the version in SuperLU in its LinearSolver incarnation)
+    void get_memory_usage(MemoryAccount& account)
+    {
+      Solver.get_memory_usage(account);
+    }
+
+
     /// Get the amount of memory used to store the LU factors inside SuperLU
     double get_memory_usage_for_lu_factors()
     {
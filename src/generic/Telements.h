@@ -1429,6 +1429,27 @@ namespace oomph
       }
     }
 
+    /// Return the cells of the paraview sub-elements in numerical form
+    /// (as written by write_paraview_output_offset_information(...),
+    /// write_paraview_offsets(...) and write_paraview_type(...)), for
+    /// use by the binary paraview output
+    void paraview_cells(const unsigned& nplot,
+                        Vector<int>& connectivity,
+                        Vector<int>& offsets,
+                        Vector<int>& types) const
+    {
+      unsigned local_loop = nsub_elements_paraview(nplot);
+      connectivity.resize(2 * local_loop);
+      offsets.resize(local_loop);
+      types.assign(local_loop, 3);
+      for (unsigned i = 0; i < local_loop; i++)
+      {
+        connectivity[2 * i] = i;
+        connectivity[2 * i + 1] = i + 1;
+        offsets[i] = 2 * (i + 1);
+      }
+    }
+
     /// Output
     void output(std::ostream& output);
 
@@ -1764,6 +1785,44 @@ namespace oomph
       }
     }
 
+    /// Return the cells of the paraview sub-elements in numerical form
+    /// (as written by write_paraview_output_offset_information(...),
+    /// write_paraview_offsets(...) and write_paraview_type(...)), for
+    /// use by the binary paraview output
+    void paraview_cells(const unsigned& nplot,
+                        Vector<int>& connectivity,
+                        Vector<int>& offsets,
+                        Vector<int>& types) const
+    {
+      connectivity.clear();
+      unsigned node_count = 0;
+      for (unsigned i = 0; i < nplot - 1; i++)
+      {
+        for (unsigned j = 0; j < nplot - i - 1; j++)
+        {
+          connectivity.push_back(j + node_count);
+          connectivity.push_back(j + node_count + 1);
+          connectivity.push_back(j + nplot + node_count - i);
+
+          if (j < nplot - i - 2)
+          {
+            connectivity.push_back(j + node_count + 1);
+            connectivity.push_back(j + nplot + node_count - i + 1);
+            connectivity.push_back(j + nplot + node_count - i);
+          }
+        }
+        node_count += (nplot - i);
+      }
+
+      unsigned local_loop = nsub_elements_paraview(nplot);
+      offsets.resize(local_loop);
+      types.assign(local_loop, 5);
+      for (unsigned i = 0; i < local_loop; i++)
+      {
+        offsets[i] = 3 * (i + 1);
+      }
+    }
+
     /// Output
     void output(std::ostream& output);
 
@@ -3337,6 +3396,79 @@ namespace oomph
       }
     }
 
+    /// Return the cells of the paraview sub-elements in numerical form
+    /// (as written by write_paraview_output_offset_information(...),
+    /// write_paraview_offsets(...) and write_paraview_type(...)), for
+    /// use by the binary paraview output
+    void paraview_cells(const unsigned& nplot,
+                        Vector<int>& connectivity,
+                        Vector<int>& offsets,
+                        Vector<int>& types) const
+    {
+      // Same numbering as in write_paraview_output_offset_information(...)
+      // (whose node count starts at one)
+      connectivity.clear();
+      int nod_count = 0;
+      int n = nplot;
+      for (int i = 0; i < n; i++)
+      {
+        for (int j = 0; j < n - i; j++)
+        {
+          // Offset to the next layer
+          int layer = (n - 1 - i) * (n - i) / 2;
+          for (int k = 0; k < n - i - j; k++)
+          {
+            if (k < n - i - j - 1)
+            {
+              connectivity.push_back(nod_count);
+              connectivity.push_back(nod_count + 1);
+              connectivity.push_back(nod_count + n - i - j);
+              connectivity.push_back(nod_count + n - i - j + layer);
+              if (k < n - i - j - 2)
+              {
+                connectivity.push_back(nod_count + 1);
+                connectivity.push_back(nod_count + n - i - j);
+                connectivity.push_back(nod_count + n - i - j + layer);
+                connectivity.push_back(nod_count + 2 * (n - i - j) - 1 + layer);
+
+                connectivity.push_back(nod_count + 1);
+                connectivity.push_back(nod_count + n - i - j);
+                connectivity.push_back(nod_count + n - i - j + 1);
+                connectivity.push_back(nod_count + 2 * (n - i - j) - 1 + layer);
+
+                connectivity.push_back(nod_count + 1);
+                connectivity.push_back(nod_count + n - i - j + layer);
+                connectivity.push_back(nod_count + n - i - j + layer + 1);
+                connectivity.push_back(nod_count + 2 * (n - i - j) - 1 + layer);
+
+                connectivity.push_back(nod_count + 1);
+                connectivity.push_back(nod_count + n - i - j + 1);
+                connectivity.push_back(nod_count + n - i - j + layer + 1);
+                connectivity.push_back(nod_count + 2 * (n - i - j) - 1 + layer);
+              }
+              if (k > 1)
+              {
+                connectivity.push_back(nod_count + n - i - j - 1);
+                connectivity.push_back(nod_count + n - i - j + layer - 1);
+                connectivity.push_back(nod_count + 2 * (n - i - j - 1) + layer -
+                                       1);
+                connectivity.push_back(nod_count + 2 * (n - i - j - 1) + layer);
+              }
+            }
+            ++nod_count;
+          }
+        }
+      }
+
+      unsigned local_loop = nsub_elements_paraview(nplot);
+      offsets.resize(local_loop);
+      types.assign(local_loop, 10);
+      for (unsigned i = 0; i < local_loop; i++)
+      {
+        offsets[i] = 4 * (i + 1);
+      }
+    }
+
     /// Output
     void output(std::ostream& output);
 
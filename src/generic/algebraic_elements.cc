@@ -289,6 +289,27 @@ namespace oomph
   }
 
 
+  //========================================================================
+  /// Compute the derivatives of the nodal position w.r.t. the
+  /// geometric Data: the AlgebraicMesh implements the node update so it
+  /// computes the sensitivities too.
+  //========================================================================
+  void AlgebraicNode::get_dposition_dgeom_data(
+    std::map<Data*, DenseMatrix<double>>& dposition_dgeom_data)
+  {
+    // The position of hanging nodes is determined by their master nodes
+    // (see node_update()) so finite difference their update
+    if (is_hanging() || (nnode_update_fcts() == 0))
+    {
+      Node::get_dposition_dgeom_data(dposition_dgeom_data);
+      return;
+    }
+
+    mesh_pt()->get_dalgebraic_node_position_dgeom_data(this,
+                                                       dposition_dgeom_data);
+  }
+
+
   //========================================================================
   /// Perform self test: If the node has multiple update functions,
   /// check that all update functions give the same result (with a tolerance of
@@ -132,6 +132,15 @@ namespace oomph
     void node_update(const bool& update_all_time_levels_for_new_node = false);
 
 
+    /// Overload the function that computes the derivatives of the
+    /// nodal position w.r.t. the geometric Data: call the function in the
+    /// (default) AlgebraicMesh that implements the node update (which may
+    /// provide analytic sensitivities). Hanging nodes use the finite
+    /// difference default.
+    void get_dposition_dgeom_data(
+      std::map<Data*, DenseMatrix<double>>& dposition_dgeom_data);
+
+
     /// Number of node update fcts
     unsigned nnode_update_fcts()
     {
@@ -646,6 +655,20 @@ namespace oomph
     virtual void update_node_update(AlgebraicNode*& node_pt) = 0;
 
 
+    /// Compute the derivatives of the (current) position of the given
+    /// node w.r.t. the Data that affect its node update:
+    /// dposition_dgeom_data[data_pt](i,k) = dx_i / d (k-th value of
+    /// data_pt). The default implementation finite differences the
+    /// update of the node; specific AlgebraicMeshes can overload this to
+    /// provide analytic sensitivities.
+    virtual void get_dalgebraic_node_position_dgeom_data(
+      AlgebraicNode* node_pt,
+      std::map<Data*, DenseMatrix<double>>& dposition_dgeom_data)
+    {
+      node_pt->Node::get_dposition_dgeom_data(dposition_dgeom_data);
+    }
+
+
     /// Update all nodal positions via algebraic node update functions
     /// [Doesn't make sense to use this mesh with SolidElements anyway,
     /// so we buffer the case if update_all_solid_nodes is set to
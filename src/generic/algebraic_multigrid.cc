@@ -0,0 +1,1063 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+#include "algebraic_multigrid.h"
+
+#include <queue>
+
+
+namespace oomph
+{
+  //=============================================================================
+  /// Clean up the level matrices, the interpolation/restriction matrices
+  /// and the coarse solver, but keep the coarsening
+  //=============================================================================
+  void AMGPreconditioner::clean_up_hierarchy()
+  {
+    unsigned n_matrix = Level_matrix_pt.size();
+    for (unsigned l = 0; l < n_matrix; l++)
+    {
+      delete Level_matrix_pt[l];
+    }
+    Level_matrix_pt.clear();
+
+    unsigned n_interpolation = Interpolation_matrix_pt.size();
+    for (unsigned l = 0; l < n_interpolation; l++)
+    {
+      delete Interpolation_matrix_pt[l];
+      delete Restriction_matrix_pt[l];
+    }
+    Interpolation_matrix_pt.clear();
+    Restriction_matrix_pt.clear();
+
+    Inv_diag.clear();
+    X_level.clear();
+    Rhs_level.clear();
+    Residual_level.clear();
+
+    delete Coarse_solver_pt;
+    Coarse_solver_pt = 0;
+
+    Nlevel = 0;
+  }
+
+
+  //=============================================================================
+  /// Clean up memory: delete the hierarchy, including the coarsening
+  //=============================================================================
+  void AMGPreconditioner::clean_up_memory()
+  {
+    clean_up_hierarchy();
+    Coarse_index.clear();
+    Ncoarse.clear();
+    Fine_row_start.clear();
+    Fine_column_index.clear();
+  }
+
+
+  //=============================================================================
+  /// Operator complexity: total number of nonzeros in all level matrices
+  /// divided by the number of nonzeros in the finest one
+  //=============================================================================
+  double AMGPreconditioner::operator_complexity() const
+  {
+    if (Nlevel == 0 || Level_matrix_pt[0]->nnz() == 0)
+    {
+      return 0.0;
+    }
+    double nnz_total = 0.0;
+    for (unsigned l = 0; l < Nlevel; l++)
+    {
+      nnz_total += double(Level_matrix_pt[l]->nnz());
+    }
+    return nnz_total / double(Level_matrix_pt[0]->nnz());
+  }
+
+
+  //=============================================================================
+  /// Setup the preconditioner: build the multigrid hierarchy
+  //=============================================================================
+  void AMGPreconditioner::setup()
+  {
+    double t_start = TimingHelpers::timer();
+
+    // Cast to CRDoubleMatrix
+    CRDoubleMatrix* cr_matrix_pt = dynamic_cast<CRDoubleMatrix*>(matrix_pt());
+
+#ifdef PARANOID
+    if (cr_matrix_pt == 0)
+    {
+      std::ostringstream error_msg;
+      error_msg << "AMGPreconditioner only works with CRDoubleMatrices.";
+      throw OomphLibError(
+        error_msg.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+    if (cr_matrix_pt->nrow() != cr_matrix_pt->ncol())
+    {
+      std::ostringstream error_msg;
+      error_msg << "The matrix must be square but it has "
+                << cr_matrix_pt->nrow() << " rows and " << cr_matrix_pt->ncol()
+                << " columns.";
+      throw OomphLibError(
+        error_msg.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    // If the matrix is distributed then build the global version
+    bool built_global = false;
+    if (cr_matrix_pt->distributed())
+    {
+      cr_matrix_pt = cr_matrix_pt->global_matrix();
+      built_global = true;
+    }
+
+    // Store the distribution
+    this->build_distribution(cr_matrix_pt->distribution_pt());
+
+    unsigned n_row = cr_matrix_pt->nrow();
+    unsigned n_nz = cr_matrix_pt->nnz();
+    const SparseOffset* row_start = cr_matrix_pt->row_start();
+    const int* column_index = cr_matrix_pt->column_index();
+    const double* value = cr_matrix_pt->value();
+
+    // Can we re-use the coarsening? Only if the sparsity pattern is the same
+    Coarsening_was_reused = false;
+    if (Reuse_coarsening && (Coarse_index.size() > 0) &&
+        (Fine_row_start.size() == n_row + 1) &&
+        (Fine_column_index.size() == n_nz))
+    {
+      Coarsening_was_reused =
+        std::equal(row_start, row_start + n_row + 1, Fine_row_start.begin()) &&
+        std::equal(
+          column_index, column_index + n_nz, Fine_column_index.begin());
+    }
+
+    // Wipe the old hierarchy (and the coarsening unless we re-use it)
+    clean_up_hierarchy();
+    if (!Coarsening_was_reused)
+    {
+      Coarse_index.clear();
+      Ncoarse.clear();
+      Fine_row_start.assign(row_start, row_start + n_row + 1);
+      Fine_column_index.assign(column_index, column_index + n_nz);
+    }
+
+    // Copy the matrix (it may be deleted by the caller after the setup,
+    // e.g. by block preconditioners)
+    LinearAlgebraDistribution dist(
+      cr_matrix_pt->distribution_pt()->communicator_pt(), n_row, false);
+    Vector<double> fine_value;
+    fine_value.assign(value, value + n_nz);
+    Level_matrix_pt.push_back(new CRDoubleMatrix(
+      &dist, n_row, fine_value, Fine_column_index, Fine_row_start));
+
+    if (built_global)
+    {
+      delete cr_matrix_pt;
+    }
+
+    // Build the levels
+    unsigned level = 0;
+    while (level + 1 < Max_number_of_levels)
+    {
+      CRDoubleMatrix* a_pt = Level_matrix_pt[level];
+      if (a_pt->nrow() <= Max_coarse_size) break;
+
+      // Strength of connection
+      Vector<SparseOffset> strength_row_start;
+      Vector<int> strength_column_index;
+      if ((!Coarsening_was_reused) || (Coarsening_method == Classical))
+      {
+        compute_strength(level, strength_row_start, strength_column_index);
+      }
+
+      // Coarsening
+      if (!Coarsening_was_reused)
+      {
+        Vector<int> coarse_index;
+        unsigned n_coarse = 0;
+        if (Coarsening_method == SmoothedAggregation)
+        {
+          n_coarse =
+            aggregate(strength_row_start, strength_column_index, coarse_index);
+        }
+        else
+        {
+          n_coarse = classical_splitting(
+            strength_row_start, strength_column_index, coarse_index);
+        }
+
+        // Stop if the coarsening doesn't reduce the size of the problem
+        if ((n_coarse == 0) || (n_coarse >= a_pt->nrow())) break;
+
+        Coarse_index.push_back(coarse_index);
+        Ncoarse.push_back(n_coarse);
+      }
+      else if (level >= Coarse_index.size())
+      {
+        break;
+      }
+
+      // Interpolation and restriction
+      CRDoubleMatrix* p_pt = new CRDoubleMatrix;
+      if (Coarsening_method == SmoothedAggregation)
+      {
+        build_smoothed_aggregation_interpolation(level, p_pt);
+      }
+      else
+      {
+        build_classical_interpolation(
+          level, strength_row_start, strength_column_index, p_pt);
+      }
+      CRDoubleMatrix* r_pt = new CRDoubleMatrix;
+      p_pt->get_matrix_transpose(r_pt);
+      Interpolation_matrix_pt.push_back(p_pt);
+      Restriction_matrix_pt.push_back(r_pt);
+
+      // Galerkin product
+      CRDoubleMatrix ap;
+      multiply(*a_pt, *p_pt, ap);
+      CRDoubleMatrix* coarse_matrix_pt = new CRDoubleMatrix;
+      multiply(*r_pt, ap, *coarse_matrix_pt);
+      Level_matrix_pt.push_back(coarse_matrix_pt);
+
+      level++;
+    }
+    Nlevel = Level_matrix_pt.size();
+
+    // The coarsening may extend further than the hierarchy if the
+    // parameters have been changed since it was built
+    Coarse_index.resize(Nlevel - 1);
+    Ncoarse.resize(Nlevel - 1);
+
+    // Inverse diagonals and vectors for the V-cycle
+    Inv_diag.resize(Nlevel);
+    X_level.resize(Nlevel);
+    Rhs_level.resize(Nlevel);
+    Residual_level.resize(Nlevel);
+    for (unsigned l = 0; l < Nlevel; l++)
+    {
+      CRDoubleMatrix* a_pt = Level_matrix_pt[l];
+      unsigned n = a_pt->nrow();
+      const SparseOffset* a_row_start = a_pt->row_start();
+      const int* a_column_index = a_pt->column_index();
+      const double* a_value = a_pt->value();
+      Inv_diag[l].assign(n, 0.0);
+      for (unsigned i = 0; i < n; i++)
+      {
+        for (SparseOffset k = a_row_start[i]; k < a_row_start[i + 1]; k++)
+        {
+          if (unsigned(a_column_index[k]) == i && a_value[k] != 0.0)
+          {
+            Inv_diag[l][i] = 1.0 / a_value[k];
+          }
+        }
+      }
+      X_level[l].build(a_pt->distribution_pt(), 0.0);
+      Rhs_level[l].build(a_pt->distribution_pt(), 0.0);
+      Residual_level[l].build(a_pt->distribution_pt(), 0.0);
+    }
+
+    // Factorise the coarsest level matrix
+    if (Level_matrix_pt[Nlevel - 1]->nrow() > 0)
+    {
+      Coarse_solver_pt = new SuperLUSolver;
+      Coarse_solver_pt->disable_doc_time();
+      Coarse_solver_pt->factorise(Level_matrix_pt[Nlevel - 1]);
+    }
+
+    if (Doc_time)
+    {
+      oomph_info << "Time for setup of AMG preconditioner";
+      if (Coarsening_was_reused)
+      {
+        oomph_info << " (re-using coarsening)";
+      }
+      oomph_info << " [sec]: " << TimingHelpers::timer() - t_start
+                 << "\nNumber of levels: " << Nlevel << "; rows: ";
+      for (unsigned l = 0; l < Nlevel; l++)
+      {
+        oomph_info << Level_matrix_pt[l]->nrow() << " ";
+      }
+      oomph_info << "; operator complexity: " << operator_complexity()
+                 << std::endl;
+    }
+  }
+
+
+  //=============================================================================
+  /// Compute the strength-of-connection graph for the matrix on the given
+  /// level
+  //=============================================================================
+  void AMGPreconditioner::compute_strength(
+    const unsigned& level,
+    Vector<SparseOffset>& strength_row_start,
+    Vector<int>& strength_column_index)
+  {
+    CRDoubleMatrix* a_pt = Level_matrix_pt[level];
+    unsigned n = a_pt->nrow();
+    const SparseOffset* row_start = a_pt->row_start();
+    const int* column_index = a_pt->column_index();
+    const double* value = a_pt->value();
+
+    strength_row_start.resize(n + 1);
+    strength_column_index.clear();
+    strength_column_index.reserve(a_pt->nnz());
+    strength_row_start[0] = 0;
+
+    if (Coarsening_method == SmoothedAggregation)
+    {
+      // Absolute values of the diagonal entries
+      Vector<double> abs_diag(n, 0.0);
+      for (unsigned i = 0; i < n; i++)
+      {
+        for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
+        {
+          if (unsigned(column_index[k]) == i)
+          {
+            abs_diag[i] += std::fabs(value[k]);
+          }
+        }
+      }
+
+      // |a_ij| >= theta sqrt(|a_ii a_jj|)
+      double theta_squared = Strength_threshold * Strength_threshold;
+      for (unsigned i = 0; i < n; i++)
+      {
+        for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
+        {
+          unsigned j = column_index[k];
+          if ((j != i) && (value[k] != 0.0) &&
+              (value[k] * value[k] >= theta_squared * abs_diag[i] * abs_diag[j]))
+          {
+            strength_column_index.push_back(j);
+          }
+        }
+        strength_row_start[i + 1] = strength_column_index.size();
+      }
+    }
+    else
+    {
+      // -a_ij >= theta max_{k!=i} (-a_ik)
+      for (unsigned i = 0; i < n; i++)
+      {
+        double max_negative = 0.0;
+        for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
+        {
+          if (unsigned(column_index[k]) != i)
+          {
+            max_negative = std::max(max_negative, -value[k]);
+          }
+        }
+        if (max_negative > 0.0)
+        {
+          for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
+          {
+            unsigned j = column_index[k];
+            if ((j != i) && (-value[k] >= Strength_threshold * max_negative))
+            {
+              strength_column_index.push_back(j);
+            }
+          }
+        }
+        strength_row_start[i + 1] = strength_column_index.size();
+      }
+    }
+  }
+
+
+  //=============================================================================
+  /// Build the aggregates for smoothed aggregation (the standard
+  /// three-phase greedy algorithm). Returns the number of aggregates.
+  //=============================================================================
+  unsigned AMGPreconditioner::aggregate(
+    const Vector<SparseOffset>& strength_row_start,
+    const Vector<int>& strength_column_index,
+    Vector<int>& coarse_index)
+  {
+    unsigned n = strength_row_start.size() - 1;
+    coarse_index.assign(n, -1);
+    unsigned n_aggregate = 0;
+
+    // Phase 1: Form aggregates from rows whose strong neighbours are all
+    // still unaggregated
+    for (unsigned i = 0; i < n; i++)
+    {
+      if (coarse_index[i] != -1) continue;
+      int first = strength_row_start[i];
+      int last = strength_row_start[i + 1];
+      if (first == last) continue;
+      bool all_free = true;
+      for (int k = first; k < last; k++)
+      {
+        if (coarse_index[strength_column_index[k]] != -1)
+        {
+          all_free = false;
+          break;
+        }
+      }
+      if (all_free)
+      {
+        coarse_index[i] = n_aggregate;
+        for (int k = first; k < last; k++)
+        {
+          coarse_index[strength_column_index[k]] = n_aggregate;
+        }
+        n_aggregate++;
+      }
+    }
+
+    // Phase 2: Add the remaining rows to the aggregate of a strong
+    // neighbour (from phase 1, to avoid growing long chains)
+    Vector<int> phase_one_index(coarse_index);
+    for (unsigned i = 0; i < n; i++)
+    {
+      if (coarse_index[i] != -1) continue;
+      for (SparseOffset k = strength_row_start[i];
+           k < strength_row_start[i + 1];
+           k++)
+      {
+        int neighbour_aggregate = phase_one_index[strength_column_index[k]];
+        if (neighbour_aggregate != -1)
+        {
+          coarse_index[i] = neighbour_aggregate;
+          break;
+        }
+      }
+    }
+
+    // Phase 3: Form new aggregates from whatever is left (rows without
+    // any strong connections remain unaggregated)
+    for (unsigned i = 0; i < n; i++)
+    {
+      if (coarse_index[i] != -1) continue;
+      int first = strength_row_start[i];
+      int last = strength_row_start[i + 1];
+      if (first == last) continue;
+      coarse_index[i] = n_aggregate;
+      for (int k = first; k < last; k++)
+      {
+        if (coarse_index[strength_column_index[k]] == -1)
+        {
+          coarse_index[strength_column_index[k]] = n_aggregate;
+        }
+      }
+      n_aggregate++;
+    }
+
+    return n_aggregate;
+  }
+
+
+  //=============================================================================
+  /// Classical (Ruge-Stueben) C/F splitting: first pass of the standard
+  /// greedy algorithm (based on the number of rows that strongly depend on
+  /// each row), followed by a check that every F row that has strong
+  /// connections has at least one strong C neighbour. Returns the number
+  /// of C points.
+  //=============================================================================
+  unsigned AMGPreconditioner::classical_splitting(
+    const Vector<SparseOffset>& strength_row_start,
+    const Vector<int>& strength_column_index,
+    Vector<int>& coarse_index)
+  {
+    unsigned n = strength_row_start.size() - 1;
+
+    // Transpose of the strength graph: which rows depend strongly on i?
+    Vector<SparseOffset> transpose_row_start(n + 1, 0);
+    unsigned n_strong = strength_column_index.size();
+    for (unsigned k = 0; k < n_strong; k++)
+    {
+      transpose_row_start[strength_column_index[k] + 1]++;
+    }
+    for (unsigned i = 0; i < n; i++)
+    {
+      transpose_row_start[i + 1] += transpose_row_start[i];
+    }
+    Vector<int> transpose_column_index(n_strong);
+    Vector<SparseOffset> next(transpose_row_start);
+    for (unsigned i = 0; i < n; i++)
+    {
+      for (SparseOffset k = strength_row_start[i];
+           k < strength_row_start[i + 1];
+           k++)
+      {
+        transpose_column_index[next[strength_column_index[k]]++] = i;
+      }
+    }
+
+    // Status of the rows
+    enum
+    {
+      Undecided,
+      Coarse,
+      Fine
+    };
+    Vector<unsigned> status(n, Undecided);
+
+    // Measure: number of undecided rows that depend strongly on each row.
+    // Rows that don't depend on anything don't need to be interpolated:
+    // make them F points straight away.
+    Vector<int> measure(n, 0);
+    std::priority_queue<std::pair<int, int>> queue;
+    for (unsigned i = 0; i < n; i++)
+    {
+      measure[i] = transpose_row_start[i + 1] - transpose_row_start[i];
+      if (strength_row_start[i] == strength_row_start[i + 1])
+      {
+        status[i] = Fine;
+      }
+      else
+      {
+        queue.push(std::make_pair(measure[i], int(i)));
+      }
+    }
+
+    // First pass: pick the undecided row with the largest measure, make it
+    // a C point and the rows that depend on it F points
+    while (!queue.empty())
+    {
+      int i = queue.top().second;
+      int queued_measure = queue.top().first;
+      queue.pop();
+
+      // Skip outdated entries
+      if ((status[i] != Undecided) || (queued_measure != measure[i])) continue;
+
+      status[i] = Coarse;
+      for (SparseOffset k = transpose_row_start[i];
+           k < transpose_row_start[i + 1];
+           k++)
+      {
+        int j = transpose_column_index[k];
+        if (status[j] == Undecided)
+        {
+          status[j] = Fine;
+
+          // The rows j depends on become more attractive as C points
+          for (SparseOffset kk = strength_row_start[j];
+               kk < strength_row_start[j + 1];
+               kk++)
+          {
+            int jj = strength_column_index[kk];
+            if (status[jj] == Undecided)
+            {
+              measure[jj]++;
+              queue.push(std::make_pair(measure[jj], jj));
+            }
+          }
+        }
+      }
+
+      // The rows i depends on become less attractive
+      for (SparseOffset k = strength_row_start[i];
+           k < strength_row_start[i + 1];
+           k++)
+      {
+        int j = strength_column_index[k];
+        if (status[j] == Undecided)
+        {
+          measure[j]--;
+          queue.push(std::make_pair(measure[j], j));
+        }
+      }
+    }
+
+    // Make sure each F point with strong connections can be interpolated
+    // from at least one C point
+    for (unsigned i = 0; i < n; i++)
+    {
+      if ((status[i] != Fine) ||
+          (strength_row_start[i] == strength_row_start[i + 1]))
+      {
+        continue;
+      }
+      bool has_coarse_neighbour = false;
+      for (SparseOffset k = strength_row_start[i];
+           k < strength_row_start[i + 1];
+           k++)
+      {
+        if (status[strength_column_index[k]] == Coarse)
+        {
+          has_coarse_neighbour = true;
+          break;
+        }
+      }
+      if (!has_coarse_neighbour)
+      {
+        status[i] = Coarse;
+      }
+    }
+
+    // Number the C points
+    coarse_index.assign(n, -1);
+    unsigned n_coarse = 0;
+    for (unsigned i = 0; i < n; i++)
+    {
+      if (status[i] == Coarse)
+      {
+        coarse_index[i] = n_coarse++;
+      }
+    }
+    return n_coarse;
+  }
+
+
+  //=============================================================================
+  /// Build the smoothed aggregation interpolation matrix
+  /// P = (I - omega D^{-1} A) P_tent, where P_tent is the piecewise
+  /// constant interpolation from the aggregates and
+  /// omega = 4/(3 rho(D^{-1} A)). The spectral radius is bounded by
+  /// Gershgorin's theorem (which is cheap and never underestimates it).
+  //=============================================================================
+  void AMGPreconditioner::build_smoothed_aggregation_interpolation(
+    const unsigned& level, CRDoubleMatrix* p_pt)
+  {
+    CRDoubleMatrix* a_pt = Level_matrix_pt[level];
+    unsigned n = a_pt->nrow();
+    const SparseOffset* row_start = a_pt->row_start();
+    const int* column_index = a_pt->column_index();
+    const double* value = a_pt->value();
+    const Vector<int>& aggregate = Coarse_index[level];
+    unsigned n_coarse = Ncoarse[level];
+
+    // Diagonal and bound for the spectral radius of D^{-1} A
+    Vector<double> diag(n, 0.0);
+    for (unsigned i = 0; i < n; i++)
+    {
+      for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
+      {
+        if (unsigned(column_index[k]) == i)
+        {
+          diag[i] += value[k];
+        }
+      }
+    }
+    double rho = 0.0;
+    for (unsigned i = 0; i < n; i++)
+    {
+      if (diag[i] == 0.0) continue;
+      double row_sum = 0.0;
+      for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
+      {
+        row_sum += std::fabs(value[k]);
+      }
+      rho = std::max(rho, row_sum / std::fabs(diag[i]));
+    }
+    double omega = (rho > 0.0) ? 4.0 / (3.0 * rho) : 0.0;
+
+    // Assemble P row by row (position[j] is the position of coarse
+    // column j in the current row, or -1)
+    Vector<int> position(n_coarse, -1);
+    Vector<double> p_value;
+    Vector<int> p_column_index;
+    Vector<SparseOffset> p_row_start(n + 1);
+    p_value.reserve(a_pt->nnz());
+    p_column_index.reserve(a_pt->nnz());
+    p_row_start[0] = 0;
+    for (unsigned i = 0; i < n; i++)
+    {
+      unsigned row_first = p_value.size();
+      if (aggregate[i] != -1)
+      {
+        position[aggregate[i]] = p_value.size();
+        p_column_index.push_back(aggregate[i]);
+        p_value.push_back(1.0);
+      }
+      if (diag[i] != 0.0)
+      {
+        double factor = omega / diag[i];
+        for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
+        {
+          int j = aggregate[column_index[k]];
+          if (j == -1) continue;
+          if (position[j] == -1)
+          {
+            position[j] = p_value.size();
+            p_column_index.push_back(j);
+            p_value.push_back(0.0);
+          }
+          p_value[position[j]] -= factor * value[k];
+        }
+      }
+      for (unsigned k = row_first; k < p_value.size(); k++)
+      {
+        position[p_column_index[k]] = -1;
+      }
+      p_row_start[i + 1] = p_value.size();
+    }
+
+    p_pt->build(
+      a_pt->distribution_pt(), n_coarse, p_value, p_column_index, p_row_start);
+  }
+
+
+  //=============================================================================
+  /// Build the classical direct interpolation matrix: C points are
+  /// injected; F point i is interpolated from its strong C neighbours
+  /// with w_ij = -alpha_i a_ij / a_ii for negative and
+  /// w_ij = -beta_i a_ij / a_ii for positive a_ij, where alpha_i and
+  /// beta_i scale the weights so that constants are interpolated exactly.
+  /// (If there are no positive connections to C points the positive
+  /// entries are lumped onto the diagonal.)
+  //=============================================================================
+  void AMGPreconditioner::build_classical_interpolation(
+    const unsigned& level,
+    const Vector<SparseOffset>& strength_row_start,
+    const Vector<int>& strength_column_index,
+    CRDoubleMatrix* p_pt)
+  {
+    CRDoubleMatrix* a_pt = Level_matrix_pt[level];
+    unsigned n = a_pt->nrow();
+    const SparseOffset* row_start = a_pt->row_start();
+    const int* column_index = a_pt->column_index();
+    const double* value = a_pt->value();
+    const Vector<int>& coarse_index = Coarse_index[level];
+    unsigned n_coarse = Ncoarse[level];
+
+    // Flags for the strong neighbours of the current row
+    Vector<unsigned char> is_strong(n, 0);
+
+    Vector<double> p_value;
+    Vector<int> p_column_index;
+    Vector<SparseOffset> p_row_start(n + 1);
+    p_value.reserve(2 * n);
+    p_column_index.reserve(2 * n);
+    p_row_start[0] = 0;
+    for (unsigned i = 0; i < n; i++)
+    {
+      // C points are injected
+      if (coarse_index[i] != -1)
+      {
+        p_column_index.push_back(coarse_index[i]);
+        p_value.push_back(1.0);
+        p_row_start[i + 1] = p_value.size();
+        continue;
+      }
+
+      for (SparseOffset k = strength_row_start[i];
+           k < strength_row_start[i + 1];
+           k++)
+      {
+        is_strong[strength_column_index[k]] = 1;
+      }
+
+      // Sums of the negative/positive entries, over all neighbours and
+      // over the interpolatory ones
+      double diag = 0.0;
+      double negative_sum = 0.0;
+      double positive_sum = 0.0;
+      double negative_sum_coarse = 0.0;
+      double positive_sum_coarse = 0.0;
+      for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
+      {
+        unsigned j = column_index[k];
+        if (j == i)
+        {
+          diag += value[k];
+          continue;
+        }
+        bool interpolatory = is_strong[j] && (coarse_index[j] != -1);
+        if (value[k] < 0.0)
+        {
+          negative_sum += value[k];
+          if (interpolatory) negative_sum_coarse += value[k];
+        }
+        else
+        {
+          positive_sum += value[k];
+          if (interpolatory) positive_sum_coarse += value[k];
+        }
+      }
+      double alpha =
+        (negative_sum_coarse != 0.0) ? negative_sum / negative_sum_coarse : 0.0;
+      double beta = 0.0;
+      if (positive_sum_coarse != 0.0)
+      {
+        beta = positive_sum / positive_sum_coarse;
+      }
+      else
+      {
+        diag += positive_sum;
+      }
+
+      if (diag != 0.0)
+      {
+        for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
+        {
+          unsigned j = column_index[k];
+          if ((j == i) || (!is_strong[j]) || (coarse_index[j] == -1)) continue;
+          double weight = (value[k] < 0.0) ? alpha : beta;
+          if (weight == 0.0) continue;
+          p_column_index.push_back(coarse_index[j]);
+          p_value.push_back(-weight * value[k] / diag);
+        }
+      }
+      p_row_start[i + 1] = p_value.size();
+
+      for (SparseOffset k = strength_row_start[i];
+           k < strength_row_start[i + 1];
+           k++)
+      {
+        is_strong[strength_column_index[k]] = 0;
+      }
+    }
+
+    p_pt->build(
+      a_pt->distribution_pt(), n_coarse, p_value, p_column_index, p_row_start);
+  }
+
+
+  //=============================================================================
+  /// Sparse matrix-matrix product result = a b for serial matrices
+  //=============================================================================
+  void AMGPreconditioner::multiply(const CRDoubleMatrix& a,
+                                   const CRDoubleMatrix& b,
+                                   CRDoubleMatrix& result)
+  {
+    unsigned n_row = a.nrow();
+    unsigned n_col = b.ncol();
+    const SparseOffset* a_row_start = a.row_start();
+    const int* a_column_index = a.column_index();
+    const double* a_value = a.value();
+    const SparseOffset* b_row_start = b.row_start();
+    const int* b_column_index = b.column_index();
+    const double* b_value = b.value();
+
+    // position[j] is the position of column j in the current row of the
+    // result, or -1
+    Vector<int> position(n_col, -1);
+    Vector<double> value;
+    Vector<int> column_index;
+    Vector<SparseOffset> row_start(n_row + 1);
+    value.reserve(a.nnz() + b.nnz());
+    column_index.reserve(a.nnz() + b.nnz());
+    row_start[0] = 0;
+    for (unsigned i = 0; i < n_row; i++)
+    {
+      unsigned row_first = value.size();
+      for (SparseOffset k = a_row_start[i]; k < a_row_start[i + 1]; k++)
+      {
+        int a_col = a_column_index[k];
+        double a_val = a_value[k];
+        for (SparseOffset kk = b_row_start[a_col];
+             kk < b_row_start[a_col + 1];
+             kk++)
+        {
+          int j = b_column_index[kk];
+          if (position[j] == -1)
+          {
+            position[j] = value.size();
+            column_index.push_back(j);
+            value.push_back(a_val * b_value[kk]);
+          }
+          else
+          {
+            value[position[j]] += a_val * b_value[kk];
+          }
+        }
+      }
+      unsigned row_last = value.size();
+      for (unsigned k = row_first; k < row_last; k++)
+      {
+        position[column_index[k]] = -1;
+      }
+      row_start[i + 1] = row_last;
+    }
+
+    result.build(a.distribution_pt(), n_col, value, column_index, row_start);
+  }
+
+
+  //=============================================================================
+  /// Do one smoothing sweep on the given level
+  //=============================================================================
+  void AMGPreconditioner::smooth(const unsigned& level,
+                                 const bool& forward_sweep)
+  {
+    CRDoubleMatrix* a_pt = Level_matrix_pt[level];
+    int n = a_pt->nrow();
+    const SparseOffset* row_start = a_pt->row_start();
+    const int* column_index = a_pt->column_index();
+    const double* value = a_pt->value();
+    const double* inv_diag = &Inv_diag[level][0];
+    double* x = X_level[level].values_pt();
+    const double* rhs = Rhs_level[level].values_pt();
+
+    if (Smoother == Jacobi)
+    {
+      double* residual = Residual_level[level].values_pt();
+      for (int i = 0; i < n; i++)
+      {
+        double r = rhs[i];
+        for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
+        {
+          r -= value[k] * x[column_index[k]];
+        }
+        residual[i] = r;
+      }
+      for (int i = 0; i < n; i++)
+      {
+        x[i] += Jacobi_damping_factor * inv_diag[i] * residual[i];
+      }
+    }
+    else
+    {
+      int first = forward_sweep ? 0 : n - 1;
+      int last = forward_sweep ? n : -1;
+      int step = forward_sweep ? 1 : -1;
+      for (int i = first; i != last; i += step)
+      {
+        double r = rhs[i];
+        for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
+        {
+          r -= value[k] * x[column_index[k]];
+        }
+        x[i] += inv_diag[i] * r;
+      }
+    }
+  }
+
+
+  //=============================================================================
+  /// Do a V-cycle, starting on the given level (with the current
+  /// X_level[level] as the initial guess)
+  //=============================================================================
+  void AMGPreconditioner::vcycle(const unsigned& level)
+  {
+    // Exact solve on the coarsest level
+    if (level == Nlevel - 1)
+    {
+      if (Coarse_solver_pt != 0)
+      {
+        Coarse_solver_pt->backsub(Rhs_level[level], X_level[level]);
+      }
+      return;
+    }
+
+    // Pre-smoothing
+    for (unsigned i = 0; i < Npre_smooth; i++)
+    {
+      smooth(level, true);
+    }
+
+    // Restrict the residual
+    Level_matrix_pt[level]->residual(
+      X_level[level], Rhs_level[level], Residual_level[level]);
+    Restriction_matrix_pt[level]->multiply(Residual_level[level],
+                                           Rhs_level[level + 1]);
+
+    // Coarse-grid correction
+    X_level[level + 1].initialise(0.0);
+    vcycle(level + 1);
+    Interpolation_matrix_pt[level]->multiply(X_level[level + 1],
+                                             Residual_level[level]);
+    X_level[level] += Residual_level[level];
+
+    // Post-smoothing
+    for (unsigned i = 0; i < Npost_smooth; i++)
+    {
+      smooth(level, false);
+    }
+  }
+
+
+  //=============================================================================
+  /// Apply the preconditioner: Nvcycle V-cycles for A z = r, starting
+  /// from z=0
+  //=============================================================================
+  void AMGPreconditioner::preconditioner_solve(const DoubleVector& r,
+                                               DoubleVector& z)
+  {
+#ifdef PARANOID
+    if (Nlevel == 0)
+    {
+      throw OomphLibError("The preconditioner has not been set up.",
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    // Store the distribution of z
+    LinearAlgebraDistribution* z_dist = 0;
+    if (z.built())
+    {
+      z_dist = new LinearAlgebraDistribution(z.distribution_pt());
+    }
+
+    // Get the (global) rhs
+    Rhs_level[0] = r;
+    if (Rhs_level[0].distributed())
+    {
+      Rhs_level[0].redistribute(Level_matrix_pt[0]->distribution_pt());
+    }
+
+    // Do the V-cycles
+    X_level[0].initialise(0.0);
+    for (unsigned i = 0; i < Nvcycle; i++)
+    {
+      vcycle(0);
+    }
+
+    // Return the result (in the original distribution of z, or of r)
+    z = X_level[0];
+    if (z_dist != 0)
+    {
+      z.redistribute(z_dist);
+      delete z_dist;
+    }
+    else if (r.distributed())
+    {
+      z.redistribute(r.distribution_pt());
+    }
+  }
+
+
+  //=============================================================================
+  /// Functions to create instances of the native AMG preconditioner
+  //=============================================================================
+  namespace AMG_Subsidiary_Preconditioner_Helper
+  {
+    /// Smoothed aggregation AMG with symmetric Gauss-Seidel smoothing
+    Preconditioner* get_smoothed_aggregation_amg_preconditioner()
+    {
+      AMGPreconditioner* amg_pt = new AMGPreconditioner;
+      amg_pt->use_smoothed_aggregation();
+      amg_pt->disable_doc_time();
+      return amg_pt;
+    }
+
+    /// Classical AMG with symmetric Gauss-Seidel smoothing
+    Preconditioner* get_classical_amg_preconditioner()
+    {
+      AMGPreconditioner* amg_pt = new AMGPreconditioner;
+      amg_pt->use_classical_coarsening();
+      amg_pt->disable_doc_time();
+      return amg_pt;
+    }
+
+  } // namespace AMG_Subsidiary_Preconditioner_Helper
+
+} // namespace oomph
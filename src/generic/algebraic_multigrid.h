@@ -0,0 +1,406 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+// Include guards
+#ifndef OOMPH_ALGEBRAIC_MULTIGRID_HEADER
+#define OOMPH_ALGEBRAIC_MULTIGRID_HEADER
+
+
+// Config header generated by autoconfig
+#ifdef HAVE_CONFIG_H
+#include <oomph-lib-config.h>
+#endif
+
+#include "preconditioner.h"
+#include "matrices.h"
+#include "linear_solver.h"
+
+
+namespace oomph
+{
+  //=============================================================================
+  /// Native algebraic multigrid (AMG) preconditioner that operates
+  /// directly on a CRDoubleMatrix, so it doesn't require Hypre or Trilinos
+  /// and doesn't copy the matrix into a third-party format. The
+  /// hierarchy is built either by smoothed aggregation or by classical
+  /// (Ruge-Stueben) coarsening with direct interpolation; coarse-level
+  /// operators are the Galerkin products R A P with R = P^T. The
+  /// preconditioner applies Nvcycle V-cycles with Jacobi or (symmetric)
+  /// Gauss-Seidel smoothing and an exact (SuperLU) solve on the
+  /// coarsest level.
+  ///
+  /// If the preconditioner is set up again for a matrix with the same
+  /// sparsity pattern (e.g. during a Newton iteration or a time-stepping
+  /// loop) the coarsening (aggregates or C/F splitting) is re-used by
+  /// default and only the interpolation weights, the Galerkin products and
+  /// the coarse-level factorisation are recomputed.
+  ///
+  /// Distributed matrices are gathered onto each processor, so (like
+  /// ILUZeroPreconditioner) the preconditioner can be used in parallel
+  /// but doesn't scale.
+  //=============================================================================
+  class AMGPreconditioner : public Preconditioner
+  {
+  public:
+    /// Coarsening methods
+    enum AMGCoarseningMethod
+    {
+      SmoothedAggregation,
+      Classical
+    };
+
+    /// Smoothers
+    enum AMGSmoother
+    {
+      Jacobi,
+      GaussSeidel
+    };
+
+    /// Constructor: Smoothed aggregation AMG with one symmetric
+    /// Gauss-Seidel pre- and post-smoothing sweep
+    AMGPreconditioner()
+      : Coarsening_method(SmoothedAggregation),
+        Strength_threshold(0.08),
+        Max_number_of_levels(20),
+        Max_coarse_size(100),
+        Smoother(GaussSeidel),
+        Jacobi_damping_factor(2.0 / 3.0),
+        Npre_smooth(1),
+        Npost_smooth(1),
+        Nvcycle(1),
+        Reuse_coarsening(true),
+        Coarsening_was_reused(false),
+        Doc_time(true),
+        Nlevel(0),
+        Coarse_solver_pt(0)
+    {
+    }
+
+    /// Destructor
+    ~AMGPreconditioner()
+    {
+      clean_up_memory();
+    }
+
+    /// Broken copy constructor
+    AMGPreconditioner(const AMGPreconditioner&) = delete;
+
+    /// Broken assignment operator
+    void operator=(const AMGPreconditioner&) = delete;
+
+    /// Setup the preconditioner: build the multigrid hierarchy for
+    /// the matrix (re-using the previous coarsening if allowed and
+    /// possible).
+    void setup();
+
+    /// Apply the preconditioner, i.e. do Nvcycle V-cycles for
+    /// A z = r, starting from z=0.
+    void preconditioner_solve(const DoubleVector& r, DoubleVector& z);
+
+    /// Clean up memory: delete the hierarchy, including the coarsening
+    /// (so the next setup() starts from scratch)
+    void clean_up_memory();
+
+    /// Use smoothed aggregation (the default). Also resets the
+    /// strength threshold to its default (0.08) for this method.
+    void use_smoothed_aggregation()
+    {
+      Coarsening_method = SmoothedAggregation;
+      Strength_threshold = 0.08;
+      clean_up_memory();
+    }
+
+    /// Use classical (Ruge-Stueben) coarsening. Also resets the
+    /// strength threshold to its default (0.25) for this method.
+    void use_classical_coarsening()
+    {
+      Coarsening_method = Classical;
+      Strength_threshold = 0.25;
+      clean_up_memory();
+    }
+
+    /// Access function to the strength threshold: for smoothed
+    /// aggregation, i and j are strongly connected if
+    /// |a_ij| >= threshold * sqrt(|a_ii a_jj|); for classical
+    /// coarsening, i strongly depends on j if
+    /// -a_ij >= threshold * max_{k!=i} (-a_ik).
+    double& strength_threshold()
+    {
+      return Strength_threshold;
+    }
+
+    /// Access function to the max. number of levels (incl. the
+    /// finest one)
+    unsigned& max_number_of_levels()
+    {
+      return Max_number_of_levels;
+    }
+
+    /// Access function to the max. number of rows in the coarsest
+    /// level matrix (which is solved by SuperLU)
+    unsigned& max_coarse_size()
+    {
+      return Max_coarse_size;
+    }
+
+    /// Use damped Jacobi smoothing
+    void use_jacobi_smoother()
+    {
+      Smoother = Jacobi;
+    }
+
+    /// Use Gauss-Seidel smoothing (forward sweeps for pre-smoothing,
+    /// backward sweeps for post-smoothing, so the V-cycle is symmetric
+    /// for symmetric matrices). This is the default.
+    void use_gauss_seidel_smoother()
+    {
+      Smoother = GaussSeidel;
+    }
+
+    /// Access function to the damping factor for Jacobi smoothing
+    double& jacobi_damping_factor()
+    {
+      return Jacobi_damping_factor;
+    }
+
+    /// Access function to the number of pre-smoothing sweeps
+    unsigned& npre_smooth()
+    {
+      return Npre_smooth;
+    }
+
+    /// Access function to the number of post-smoothing sweeps
+    unsigned& npost_smooth()
+    {
+      return Npost_smooth;
+    }
+
+    /// Access function to the number of V-cycles per application of the
+    /// preconditioner
+    unsigned& nvcycle()
+    {
+      return Nvcycle;
+    }
+
+    /// Re-use the coarsening if the preconditioner is set up again for a
+    /// matrix with the same sparsity pattern (the default)
+    void enable_reuse_of_coarsening()
+    {
+      Reuse_coarsening = true;
+    }
+
+    /// Always rebuild the coarsening from scratch
+    void disable_reuse_of_coarsening()
+    {
+      Reuse_coarsening = false;
+    }
+
+    /// Was the coarsening re-used during the most recent setup?
+    bool coarsening_was_reused() const
+    {
+      return Coarsening_was_reused;
+    }
+
+    /// Enable documentation of timings and of the hierarchy
+    void enable_doc_time()
+    {
+      Doc_time = true;
+    }
+
+    /// Disable documentation of timings and of the hierarchy
+    void disable_doc_time()
+    {
+      Doc_time = false;
+    }
+
+    /// Number of levels in the hierarchy (incl. the finest one)
+    unsigned nlevel() const
+    {
+      return Nlevel;
+    }
+
+    /// Operator complexity: total number of nonzeros in all level
+    /// matrices divided by the number of nonzeros in the finest one
+    double operator_complexity() const;
+
+  private:
+    /// Clean up the level matrices, the interpolation/restriction
+    /// matrices and the coarse solver, but keep the coarsening
+    void clean_up_hierarchy();
+
+    /// Compute the strength-of-connection graph for the matrix on the
+    /// given level (in compressed row format)
+    void compute_strength(const unsigned& level,
+                          Vector<SparseOffset>& strength_row_start,
+                          Vector<int>& strength_column_index);
+
+    /// Build the aggregates for smoothed aggregation on the given
+    /// level: coarse_index[i] is the aggregate that contains row i (or
+    /// -1 if the row isn't strongly connected to anything). Returns the
+    /// number of aggregates.
+    unsigned aggregate(const Vector<SparseOffset>& strength_row_start,
+                       const Vector<int>& strength_column_index,
+                       Vector<int>& coarse_index);
+
+    /// Do the classical (Ruge-Stueben) C/F splitting: coarse_index[i] is
+    /// the number of the coarse point if i is a C point or -1 if it's
+    /// an F point. Returns the number of C points.
+    unsigned classical_splitting(const Vector<SparseOffset>& strength_row_start,
+                                 const Vector<int>& strength_column_index,
+                                 Vector<int>& coarse_index);
+
+    /// Build the smoothed aggregation interpolation matrix for the given
+    /// level from the aggregates
+    void build_smoothed_aggregation_interpolation(const unsigned& level,
+                                                  CRDoubleMatrix* p_pt);
+
+    /// Build the classical direct interpolation matrix for the given
+    /// level from the C/F splitting
+    void build_classical_interpolation(
+      const unsigned& level,
+      const Vector<SparseOffset>& strength_row_start,
+      const Vector<int>& strength_column_index,
+      CRDoubleMatrix* p_pt);
+
+    /// Sparse matrix-matrix product result = a b for serial matrices.
+    /// Uses a dense marker array to accumulate each row of the result,
+    /// which is much faster than CRDoubleMatrix::multiply(...) for the
+    /// (relatively dense) Galerkin products on the coarser levels.
+    static void multiply(const CRDoubleMatrix& a,
+                         const CRDoubleMatrix& b,
+                         CRDoubleMatrix& result);
+
+    /// Do one smoothing sweep on the given level. Gauss-Seidel sweeps
+    /// forward if forward_sweep is true and backward otherwise.
+    void smooth(const unsigned& level, const bool& forward_sweep);
+
+    /// Do a V-cycle, starting on the given level
+    void vcycle(const unsigned& level);
+
+    /// The coarsening method
+    AMGCoarseningMethod Coarsening_method;
+
+    /// The strength threshold
+    double Strength_threshold;
+
+    /// Max. number of levels
+    unsigned Max_number_of_levels;
+
+    /// Max. number of rows in the coarsest level matrix
+    unsigned Max_coarse_size;
+
+    /// The smoother
+    AMGSmoother Smoother;
+
+    /// Damping factor for Jacobi smoothing
+    double Jacobi_damping_factor;
+
+    /// Number of pre-smoothing sweeps
+    unsigned Npre_smooth;
+
+    /// Number of post-smoothing sweeps
+    unsigned Npost_smooth;
+
+    /// Number of V-cycles per application of the preconditioner
+    unsigned Nvcycle;
+
+    /// Re-use the coarsening if the sparsity pattern hasn't changed?
+    bool Reuse_coarsening;
+
+    /// Was the coarsening re-used during the most recent setup?
+    bool Coarsening_was_reused;
+
+    /// Document timings and the hierarchy?
+    bool Doc_time;
+
+    /// Number of levels
+    unsigned Nlevel;
+
+    /// Row starts of the finest-level matrix the coarsening was built
+    /// for (used to decide if it can be re-used)
+    Vector<SparseOffset> Fine_row_start;
+
+    /// Column indices of the finest-level matrix the coarsening was
+    /// built for (used to decide if it can be re-used)
+    Vector<int> Fine_column_index;
+
+    /// The coarsening on each level but the coarsest:
+    /// Coarse_index[level][i] is the aggregate (smoothed aggregation) or
+    /// the coarse point (classical coarsening) associated with row i,
+    /// or -1.
+    Vector<Vector<int>> Coarse_index;
+
+    /// The number of coarse rows generated by the coarsening on each
+    /// level but the coarsest
+    Vector<unsigned> Ncoarse;
+
+    /// The matrices on each level (the finest one is a copy of the
+    /// matrix the preconditioner was set up for)
+    Vector<CRDoubleMatrix*> Level_matrix_pt;
+
+    /// The interpolation matrices from level+1 to level
+    Vector<CRDoubleMatrix*> Interpolation_matrix_pt;
+
+    /// The restriction matrices from level to level+1
+    Vector<CRDoubleMatrix*> Restriction_matrix_pt;
+
+    /// Inverse diagonal entries of the matrices on each level (zero
+    /// where the diagonal is zero)
+    Vector<Vector<double>> Inv_diag;
+
+    /// The solution on each level
+    Vector<DoubleVector> X_level;
+
+    /// The right-hand side on each level
+    Vector<DoubleVector> Rhs_level;
+
+    /// Work vector (residual) on each level
+    Vector<DoubleVector> Residual_level;
+
+    /// SuperLU solver for the coarsest level
+    SuperLUSolver* Coarse_solver_pt;
+  };
+
+
+  //=============================================================================
+  /// Functions to create instances of the native AMG preconditioner, e.g.
+  /// for use as subsidiary preconditioners in block preconditioners
+  //=============================================================================
+  namespace AMG_Subsidiary_Preconditioner_Helper
+  {
+    /// Smoothed aggregation AMG with symmetric Gauss-Seidel smoothing
+    /// (e.g. for the momentum blocks)
+    extern Preconditioner* get_smoothed_aggregation_amg_preconditioner();
+
+    /// Classical AMG with symmetric Gauss-Seidel smoothing (e.g. for
+    /// Poisson-type blocks such as the pressure Poisson matrix in
+    /// NavierStokesSchurComplementPreconditioner)
+    extern Preconditioner* get_classical_amg_preconditioner();
+
+  } // namespace AMG_Subsidiary_Preconditioner_Helper
+
+} // namespace oomph
+
+#endif
@@ -0,0 +1,488 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+// Non-inline member functions for the block compressed row matrix class
+
+#include <algorithm>
+
+#include "block_cr_double_matrix.h"
+
+
+namespace oomph
+{
+  //=============================================================================
+  /// Build the matrix from a (non-distributed) CRDoubleMatrix, using
+  /// the given block size. Every block that contains at least one entry
+  /// of the CRDoubleMatrix is stored; the block column indices are sorted
+  /// within each block row.
+  //=============================================================================
+  void BlockCRDoubleMatrix::build(const CRDoubleMatrix& matrix,
+                                  const unsigned& block_size)
+  {
+#ifdef PARANOID
+    if (!matrix.built())
+    {
+      throw OomphLibError("The CRDoubleMatrix has not been built",
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+    if (matrix.distributed())
+    {
+      throw OomphLibError(
+        "BlockCRDoubleMatrix can only be built from a non-distributed matrix",
+        OOMPH_CURRENT_FUNCTION,
+        OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    // The block size must be valid (even without PARANOID: otherwise the
+    // trailing rows and columns would be lost and we'd write beyond the
+    // end of the block storage)
+    if ((block_size == 0) || (matrix.nrow() % block_size != 0) ||
+        (matrix.ncol() % block_size != 0))
+    {
+      std::ostringstream error_stream;
+      error_stream << "The block size " << block_size
+                   << " must divide the number of rows (" << matrix.nrow()
+                   << ") and columns (" << matrix.ncol()
+                   << ") of the matrix\n";
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+
+    // Wipe any existing data
+    clear();
+
+    // Store the size and the distribution
+    Block_size = block_size;
+    Ncol = matrix.ncol();
+    this->build_distribution(matrix.distribution_pt());
+
+    const unsigned n_entry_per_block = Block_size * Block_size;
+    const unsigned long n_block_row = matrix.nrow() / Block_size;
+    const unsigned long n_block_col = Ncol / Block_size;
+    const SparseOffset* row_start = matrix.row_start();
+    const int* column_index = matrix.column_index();
+    const double* value = matrix.value();
+
+    // Position of the blocks in the current block row
+    // (-1 if the block is not (yet) present)
+    Vector<int> block_position(n_block_col, -1);
+
+    // Block columns in the current block row
+    Vector<int> block_col;
+
+    Block_row_start.resize(n_block_row + 1);
+    Block_row_start[0] = 0;
+    for (unsigned long bi = 0; bi < n_block_row; bi++)
+    {
+      // Find the blocks in the present block row...
+      block_col.clear();
+      const unsigned long first_row = bi * Block_size;
+      for (unsigned long i = first_row; i < first_row + Block_size; i++)
+      {
+        for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
+        {
+          const int bj = column_index[k] / Block_size;
+          if (block_position[bj] < 0)
+          {
+            block_position[bj] = 0;
+            block_col.push_back(bj);
+          }
+        }
+      }
+
+      // ... sort them ...
+      std::sort(block_col.begin(), block_col.end());
+      const unsigned n_block = block_col.size();
+      const unsigned offset = Block_column_index.size();
+      for (unsigned b = 0; b < n_block; b++)
+      {
+        block_position[block_col[b]] = offset + b;
+        Block_column_index.push_back(block_col[b]);
+      }
+      Block_row_start[bi + 1] = offset + n_block;
+
+      // ... and copy the values into the blocks
+      Block_value.resize((offset + n_block) * n_entry_per_block, 0.0);
+      for (unsigned long i = first_row; i < first_row + Block_size; i++)
+      {
+        const unsigned local_row = i - first_row;
+        for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
+        {
+          const int j = column_index[k];
+          const unsigned long position = block_position[j / Block_size];
+          Block_value[position * n_entry_per_block + local_row * Block_size +
+                      j % Block_size] += value[k];
+        }
+      }
+
+      // Reset the positions
+      for (unsigned b = 0; b < n_block; b++)
+      {
+        block_position[block_col[b]] = -1;
+      }
+    }
+
+    Built = true;
+  }
+
+
+  //=============================================================================
+  /// Convert the matrix to a CRDoubleMatrix, dropping the entries in
+  /// the blocks that are exactly zero.
+  //=============================================================================
+  void BlockCRDoubleMatrix::get_cr_matrix(CRDoubleMatrix& result) const
+  {
+#ifdef PARANOID
+    if (!Built)
+    {
+      throw OomphLibError("This matrix has not been built",
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    const unsigned n_entry_per_block = Block_size * Block_size;
+    const unsigned long n_row = this->nrow();
+
+    Vector<double> value;
+    Vector<int> column_index;
+    Vector<SparseOffset> row_start(n_row + 1);
+    value.reserve(Block_value.size());
+    column_index.reserve(Block_value.size());
+
+    row_start[0] = 0;
+    for (unsigned long i = 0; i < n_row; i++)
+    {
+      const unsigned long bi = i / Block_size;
+      const unsigned local_row = i % Block_size;
+      for (SparseOffset b = Block_row_start[bi];
+           b < Block_row_start[bi + 1];
+           b++)
+      {
+        const double* block_row_pt =
+          &Block_value[b * n_entry_per_block + local_row * Block_size];
+        const int first_col = Block_column_index[b] * Block_size;
+        for (unsigned l = 0; l < Block_size; l++)
+        {
+          if (block_row_pt[l] != 0.0)
+          {
+            value.push_back(block_row_pt[l]);
+            column_index.push_back(first_col + l);
+          }
+        }
+      }
+      row_start[i + 1] = value.size();
+    }
+
+    result.build(this->distribution_pt(), Ncol, value, column_index, row_start);
+  }
+
+
+  //=============================================================================
+  /// Wipe the matrix
+  //=============================================================================
+  void BlockCRDoubleMatrix::clear()
+  {
+    Block_row_start.clear();
+    Block_column_index.clear();
+    Block_value.clear();
+    Ncol = 0;
+    this->clear_distribution();
+    Built = false;
+  }
+
+
+  //=============================================================================
+  /// Round-bracket access operator for read-only access
+  //=============================================================================
+  double BlockCRDoubleMatrix::operator()(const unsigned long& i,
+                                         const unsigned long& j) const
+  {
+#ifdef PARANOID
+    if ((i >= this->nrow()) || (j >= Ncol))
+    {
+      std::ostringstream error_stream;
+      error_stream << "Range error: entry (" << i << "," << j
+                   << ") requested but the matrix is " << this->nrow() << "x"
+                   << Ncol << "\n";
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    // Find the block by bisection within the block row
+    const unsigned long bi = i / Block_size;
+    const int bj = j / Block_size;
+    Vector<int>::const_iterator first =
+      Block_column_index.begin() + Block_row_start[bi];
+    Vector<int>::const_iterator last =
+      Block_column_index.begin() + Block_row_start[bi + 1];
+    Vector<int>::const_iterator it = std::lower_bound(first, last, bj);
+    if ((it == last) || (*it != bj))
+    {
+      return 0.0;
+    }
+    const unsigned long b = it - Block_column_index.begin();
+    return Block_value[b * Block_size * Block_size + (i % Block_size) *
+                                                       Block_size +
+                       j % Block_size];
+  }
+
+
+  //=============================================================================
+  /// Helper function for the matrix-vector product with a block size
+  /// that is known at compile time. The block rows are independent so
+  /// they can be processed concurrently.
+  //=============================================================================
+  template<unsigned BLOCK_SIZE>
+  void BlockCRDoubleMatrix::multiply_helper(const double* x_pt,
+                                            double* soln_pt) const
+  {
+    const long n_block_row = this->nrow() / BLOCK_SIZE;
+    const SparseOffset* block_row_start = &Block_row_start[0];
+    const int* block_column_index =
+      Block_column_index.empty() ? 0 : &Block_column_index[0];
+    const double* block_value = Block_value.empty() ? 0 : &Block_value[0];
+
+#ifdef _OPENMP
+#pragma omp parallel for if (n_block_row > 256)
+#endif
+    for (long bi = 0; bi < n_block_row; bi++)
+    {
+      double soln_i[BLOCK_SIZE];
+      for (unsigned r = 0; r < BLOCK_SIZE; r++)
+      {
+        soln_i[r] = 0.0;
+      }
+      for (SparseOffset b = block_row_start[bi];
+           b < block_row_start[bi + 1];
+           b++)
+      {
+        const double* a_pt = block_value + b * BLOCK_SIZE * BLOCK_SIZE;
+        const double* x_j = x_pt + block_column_index[b] * BLOCK_SIZE;
+        for (unsigned r = 0; r < BLOCK_SIZE; r++)
+        {
+          for (unsigned c = 0; c < BLOCK_SIZE; c++)
+          {
+            soln_i[r] += a_pt[r * BLOCK_SIZE + c] * x_j[c];
+          }
+        }
+      }
+      for (unsigned r = 0; r < BLOCK_SIZE; r++)
+      {
+        soln_pt[bi * BLOCK_SIZE + r] = soln_i[r];
+      }
+    }
+  }
+
+
+  //=============================================================================
+  /// Multiply the matrix by the vector x: soln=Ax
+  //=============================================================================
+  void BlockCRDoubleMatrix::multiply(const DoubleVector& x,
+                                     DoubleVector& soln) const
+  {
+#ifdef PARANOID
+    // check that this matrix is built
+    if (!Built)
+    {
+      throw OomphLibError("This matrix has not been built",
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+    // check that the distribution of x is setup
+    if (!x.built())
+    {
+      throw OomphLibError("The distribution of the vector x must be setup",
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+    // Check to see if x.size() = ncol().
+    if (Ncol != x.distribution_pt()->nrow())
+    {
+      std::ostringstream error_message_stream;
+      error_message_stream << "The number of rows in the x vector and the "
+                              "number of columns in the "
+                           << "matrix must be the same";
+      throw OomphLibError(error_message_stream.str(),
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+    // if the soln is distributed
+    if (soln.built())
+    {
+      if (!(*soln.distribution_pt() == *this->distribution_pt()))
+      {
+        std::ostringstream error_message_stream;
+        error_message_stream
+          << "The soln vector is setup and therefore must have the same "
+          << "distribution as the matrix";
+        throw OomphLibError(error_message_stream.str(),
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+    }
+#endif
+
+    // if soln is not setup then setup the distribution
+    if (!soln.built())
+    {
+      soln.build(this->distribution_pt(), 0.0);
+    }
+
+    const double* x_pt = x.values_pt();
+    double* soln_pt = soln.values_pt();
+
+    // Use the unrolled versions for the common block sizes
+    switch (Block_size)
+    {
+      case 1:
+        multiply_helper<1>(x_pt, soln_pt);
+        break;
+
+      case 2:
+        multiply_helper<2>(x_pt, soln_pt);
+        break;
+
+      case 3:
+        multiply_helper<3>(x_pt, soln_pt);
+        break;
+
+      case 4:
+        multiply_helper<4>(x_pt, soln_pt);
+        break;
+
+      default:
+      {
+        const unsigned n_entry_per_block = Block_size * Block_size;
+        const long n_block_row = this->nrow() / Block_size;
+#ifdef _OPENMP
+#pragma omp parallel for if (n_block_row > 256)
+#endif
+        for (long bi = 0; bi < n_block_row; bi++)
+        {
+          double* soln_i = soln_pt + bi * Block_size;
+          for (unsigned r = 0; r < Block_size; r++)
+          {
+            soln_i[r] = 0.0;
+          }
+          for (SparseOffset b = Block_row_start[bi];
+               b < Block_row_start[bi + 1];
+               b++)
+          {
+            const double* a_pt = &Block_value[b * n_entry_per_block];
+            const double* x_j = x_pt + Block_column_index[b] * Block_size;
+            for (unsigned r = 0; r < Block_size; r++)
+            {
+              for (unsigned c = 0; c < Block_size; c++)
+              {
+                soln_i[r] += a_pt[r * Block_size + c] * x_j[c];
+              }
+            }
+          }
+        }
+      }
+      break;
+    }
+  }
+
+
+  //=============================================================================
+  /// Multiply the transposed matrix by the vector x: soln=A^T x
+  //=============================================================================
+  void BlockCRDoubleMatrix::multiply_transpose(const DoubleVector& x,
+                                               DoubleVector& soln) const
+  {
+#ifdef PARANOID
+    // check that this matrix is built
+    if (!Built)
+    {
+      throw OomphLibError("This matrix has not been built",
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+    // Check to see if x.size() = nrow().
+    if (!(*this->distribution_pt() == *x.distribution_pt()))
+    {
+      std::ostringstream error_message_stream;
+      error_message_stream
+        << "The x vector and this matrix must have the same distribution.";
+      throw OomphLibError(error_message_stream.str(),
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+    // if soln is setup then it should have the same distribution as x
+    if (soln.built())
+    {
+      if (soln.distribution_pt()->nrow() != Ncol)
+      {
+        std::ostringstream error_message_stream;
+        error_message_stream
+          << "The soln vector is setup and therefore must have the same "
+          << "number of rows as the matrix has columns";
+        throw OomphLibError(error_message_stream.str(),
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+    }
+#endif
+
+    // if soln is not setup then setup the distribution
+    if (!soln.built())
+    {
+      LinearAlgebraDistribution dist(
+        this->distribution_pt()->communicator_pt(), Ncol, false);
+      soln.build(&dist, 0.0);
+    }
+    soln.initialise(0.0);
+
+    // Scatter the contributions of the blocks
+    const unsigned n_entry_per_block = Block_size * Block_size;
+    const unsigned long n_block_row = this->nrow() / Block_size;
+    const double* x_pt = x.values_pt();
+    double* soln_pt = soln.values_pt();
+    for (unsigned long bi = 0; bi < n_block_row; bi++)
+    {
+      const double* x_i = x_pt + bi * Block_size;
+      for (SparseOffset b = Block_row_start[bi];
+           b < Block_row_start[bi + 1];
+           b++)
+      {
+        const double* a_pt = &Block_value[b * n_entry_per_block];
+        double* soln_j = soln_pt + Block_column_index[b] * Block_size;
+        for (unsigned r = 0; r < Block_size; r++)
+        {
+          for (unsigned c = 0; c < Block_size; c++)
+          {
+            soln_j[c] += a_pt[r * Block_size + c] * x_i[r];
+          }
+        }
+      }
+    }
+  }
+
+} // namespace oomph
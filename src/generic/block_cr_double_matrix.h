@@ -0,0 +1,211 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+#ifndef OOMPH_BLOCK_CR_DOUBLE_MATRIX_H
+#define OOMPH_BLOCK_CR_DOUBLE_MATRIX_H
+
+// Config header generated by autoconfig
+#ifdef HAVE_CONFIG_H
+#include <oomph-lib-config.h>
+#endif
+
+// oomph-lib headers
+#include "Vector.h"
+#include "matrices.h"
+#include "double_vector.h"
+#include "linear_algebra_distribution.h"
+
+
+namespace oomph
+{
+  //=============================================================================
+  /// A class for block compressed row (BSR) matrices: the matrix is
+  /// partitioned into dense square blocks of a fixed size, and only the
+  /// non-zero blocks are stored, in compressed row format. Only one column
+  /// index is stored per block, which reduces the memory required for the
+  /// indices (and the memory traffic in matrix-vector products) for
+  /// multi-field problems in which the unknowns are interleaved node by node,
+  /// e.g. the displacements in solid mechanics, where the Jacobian consists
+  /// of dense nodal blocks. The values of each block are stored
+  /// contiguously, row by row. Zero entries in the non-zero blocks are
+  /// stored explicitly.
+  ///
+  /// The blocks only align with the nodes if each node contributes exactly
+  /// block-size consecutive unknowns, i.e. if no node has partially pinned
+  /// values and no node stores additional values. This is not the case
+  /// for Taylor-Hood Navier-Stokes elements (the vertex nodes also store
+  /// the pressure) or for any problem in which only some of the values
+  /// at a boundary node are pinned. For such problems the matrix is still
+  /// correct, but the blocks that straddle two nodes contain explicitly
+  /// stored zeros, which reduces the storage savings.
+  ///
+  /// The matrix can only be built from (and converted back to) a
+  /// non-distributed CRDoubleMatrix. There is no default linear solver;
+  /// direct solvers require the conversion to a CRDoubleMatrix, but the
+  /// matrix can be used with iterative solvers that only require
+  /// matrix-vector products (CG, BiCGStab and GMRES are instantiated for
+  /// it); preconditioners that need a CRDoubleMatrix have to be set up
+  /// separately, for the converted matrix.
+  //=============================================================================
+  class BlockCRDoubleMatrix : public DoubleMatrixBase,
+                              public DistributableLinearAlgebraObject
+  {
+  public:
+    /// Constructor: Pass the block size (defaults to 1)
+    BlockCRDoubleMatrix(const unsigned& block_size = 1)
+      : Block_size(block_size), Ncol(0), Built(false)
+    {
+    }
+
+    /// Constructor: build from a CRDoubleMatrix with the given block
+    /// size
+    BlockCRDoubleMatrix(const CRDoubleMatrix& matrix,
+                        const unsigned& block_size)
+      : Block_size(block_size), Ncol(0), Built(false)
+    {
+      build(matrix, block_size);
+    }
+
+    /// Broken copy constructor
+    BlockCRDoubleMatrix(const BlockCRDoubleMatrix& matrix) = delete;
+
+    /// Broken assignment operator
+    void operator=(const BlockCRDoubleMatrix&) = delete;
+
+    /// Destructor
+    virtual ~BlockCRDoubleMatrix() {}
+
+    /// Build the matrix from a (non-distributed) CRDoubleMatrix, using
+    /// the given block size, which must divide the number of rows and
+    /// columns of the matrix.
+    void build(const CRDoubleMatrix& matrix, const unsigned& block_size);
+
+    /// Convert the matrix to a CRDoubleMatrix. The entries in the
+    /// non-zero blocks that are exactly zero are dropped.
+    void get_cr_matrix(CRDoubleMatrix& result) const;
+
+    /// Wipe the matrix (the block size is retained)
+    void clear();
+
+    /// Block size
+    unsigned block_size() const
+    {
+      return Block_size;
+    }
+
+    /// Return the number of rows of the matrix
+    unsigned long nrow() const
+    {
+      return DistributableLinearAlgebraObject::nrow();
+    }
+
+    /// Return the number of columns of the matrix
+    unsigned long ncol() const
+    {
+      return Ncol;
+    }
+
+    /// Return the number of (non-zero) blocks
+    unsigned long nnz_block() const
+    {
+      return Block_column_index.size();
+    }
+
+    /// Return the number of stored entries, including the zero
+    /// entries in the non-zero blocks
+    unsigned long nnz() const
+    {
+      return Block_value.size();
+    }
+
+    /// Access to the block row starts
+    const Vector<SparseOffset>& block_row_start() const
+    {
+      return Block_row_start;
+    }
+
+    /// Access to the block column indices
+    const Vector<int>& block_column_index() const
+    {
+      return Block_column_index;
+    }
+
+    /// Access to the values; the k-th block occupies the entries
+    /// [k*block_size^2, (k+1)*block_size^2), stored row by row.
+    const Vector<double>& block_value() const
+    {
+      return Block_value;
+    }
+
+    /// Access to the values (non-const version)
+    Vector<double>& block_value()
+    {
+      return Block_value;
+    }
+
+    /// Round-bracket access operator for read-only access
+    double operator()(const unsigned long& i, const unsigned long& j) const;
+
+    /// Multiply the matrix by the vector x: soln=Ax
+    void multiply(const DoubleVector& x, DoubleVector& soln) const;
+
+    /// Multiply the transposed matrix by the vector x: soln=A^T x
+    void multiply_transpose(const DoubleVector& x, DoubleVector& soln) const;
+
+    /// Access function to the Built flag
+    bool built() const
+    {
+      return Built;
+    }
+
+  private:
+    /// Helper function for the matrix-vector product, with the block
+    /// size as a template parameter so that the loops over the entries in
+    /// the blocks can be unrolled by the compiler
+    template<unsigned BLOCK_SIZE>
+    void multiply_helper(const double* x_pt, double* soln_pt) const;
+
+    /// Size of the (square) blocks
+    unsigned Block_size;
+
+    /// Number of columns
+    unsigned long Ncol;
+
+    /// Start of the block rows in Block_column_index
+    Vector<SparseOffset> Block_row_start;
+
+    /// Block column index of the blocks
+    Vector<int> Block_column_index;
+
+    /// Values of the entries in the blocks
+    Vector<double> Block_value;
+
+    /// Flag to indicate whether the matrix has been built
+    bool Built;
+  };
+
+} // namespace oomph
+
+#endif
@@ -5141,7 +5141,7 @@ namespace oomph
         !cr_matrix_pt->distribution_pt()->distributed())
     {
       // pointers for the jacobian matrix is compressed row sparse format
-      int* j_row_start;
+      SparseOffset* j_row_start;
       int* j_column_index;
       double* j_value;
 
@@ -5158,7 +5158,7 @@ namespace oomph
       // temp_ptr is used to point to an element in each column - required as
       // cannot assume that order of block's rows in jacobian and the block
       // matrix will be the same
-      int* temp_row_start = new int[block_nrow + 1];
+      SparseOffset* temp_row_start = new SparseOffset[block_nrow + 1];
       for (unsigned i = 0; i <= block_nrow; i++)
       {
         temp_row_start[i] = 0;
@@ -5176,7 +5176,7 @@ namespace oomph
       {
         if (internal_block_number(k) == static_cast<int>(block_i))
         {
-          for (int l = j_row_start[k]; l < j_row_start[k + 1]; l++)
+          for (SparseOffset l = j_row_start[k]; l < j_row_start[k + 1]; l++)
           {
             if (internal_block_number(j_column_index[l]) ==
                 static_cast<int>(block_j))
@@ -5208,7 +5208,7 @@ namespace oomph
         {
           if (internal_block_number(k) == static_cast<int>(block_i))
           {
-            for (int l = j_row_start[k]; l < j_row_start[k + 1]; l++)
+            for (SparseOffset l = j_row_start[k]; l < j_row_start[k + 1]; l++)
             {
               if (internal_block_number(j_column_index[l]) ==
                   static_cast<int>(block_j))
@@ -5254,7 +5254,7 @@ namespace oomph
       unsigned my_rank = this->distribution_pt()->communicator_pt()->my_rank();
 
       // sets pointers to jacobian matrix
-      int* j_row_start = cr_matrix_pt->row_start();
+      SparseOffset* j_row_start = cr_matrix_pt->row_start();
       int* j_column_index = cr_matrix_pt->column_index();
       double* j_value = cr_matrix_pt->value();
 
@@ -5299,7 +5299,7 @@ namespace oomph
         {
           unsigned row = Rows_to_send_for_get_block(block_i, p)[i];
           int c = 0;
-          for (int r = j_row_start[row]; r < j_row_start[row + 1]; r++)
+          for (SparseOffset r = j_row_start[row]; r < j_row_start[row + 1]; r++)
           {
             if (internal_block_number(j_column_index[r]) == int(block_j))
             {
@@ -5368,7 +5368,9 @@ namespace oomph
             for (int i = 0; i < nrow_send; i++)
             {
               unsigned row = Rows_to_send_for_get_block(block_i, p)[i];
-              for (int r = j_row_start[row]; r < j_row_start[row + 1]; r++)
+              for (SparseOffset r = j_row_start[row];
+                   r < j_row_start[row + 1];
+                   r++)
               {
                 if (internal_block_number(j_column_index[r]) == int(block_j))
                 {
@@ -5465,7 +5467,7 @@ namespace oomph
       }
 
       // next assemble row start recv
-      int* row_start_recv = new int[nrow_local + 1];
+      SparseOffset* row_start_recv = new SparseOffset[nrow_local + 1];
       for (unsigned i = 0; i <= nrow_local; i++)
       {
         row_start_recv[i] = 0;
@@ -5600,7 +5602,9 @@ namespace oomph
                 }
               }
               unsigned row = Rows_to_send_for_get_block(block_i, my_rank)[i];
-              for (int r = j_row_start[row]; r < j_row_start[row + 1]; r++)
+              for (SparseOffset r = j_row_start[row];
+                   r < j_row_start[row + 1];
+                   r++)
               {
                 if (internal_block_number(j_column_index[r]) == int(block_j))
                 {
@@ -2154,6 +2154,47 @@ namespace oomph
       return Master_block_preconditioner_pt;
     } // EOFunc master_block_preconditioner_pt()
 
+    /// Add the memory held by the block lookup schemes (the mappings
+    /// between global dofs, dof types and blocks; only stored in the
+    /// master block preconditioner) to the category "block_lookup" of
+    /// the account, and that held by the replacement dof-level blocks
+    /// to "replacement_dof_blocks". Block preconditioners that own
+    /// subsidiary preconditioners should overload this function to add
+    /// their memory usage too.
+    virtual void get_memory_usage(MemoryAccount& account)
+    {
+      double lookup_nbyte = double(Index_in_dof_block_dense.size() +
+                                   Dof_number_dense.size() +
+                                   Dof_dimension.size() +
+                                   Dof_number_to_block_number_lookup.size()) *
+                            sizeof(unsigned);
+#ifdef OOMPH_HAS_MPI
+      lookup_nbyte +=
+        double(Global_index_sparse.size() + Index_in_dof_block_sparse.size() +
+               Dof_number_sparse.size()) *
+        sizeof(unsigned);
+#endif
+      unsigned n_block = Global_index.size();
+      for (unsigned b = 0; b < n_block; b++)
+      {
+        lookup_nbyte += double(Global_index[b].size()) * sizeof(unsigned);
+      }
+      account.add("block_lookup", lookup_nbyte);
+
+      unsigned n_dof_types = Doftype_coarsen_map_coarse.size();
+      for (unsigned i = 0; i < n_dof_types; i++)
+      {
+        for (unsigned j = 0; j < n_dof_types; j++)
+        {
+          CRDoubleMatrix* block_pt = Replacement_dof_block_pt.get(i, j);
+          if (block_pt != 0)
+          {
+            block_pt->get_memory_usage(account, "replacement_dof_blocks");
+          }
+        }
+      }
+    } // EOFunc get_memory_usage(...)
+
     /// Clears all BlockPreconditioner data. Called by the destructor
     /// and the block_setup(...) methods
     void clear_block_preconditioner_base()
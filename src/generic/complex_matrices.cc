@@ -23,6 +23,8 @@
 // LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
 // LIC//
 // LIC//====================================================================
+#include <climits>
+
 #include "complex_matrices.h"
 
 namespace oomph
@@ -638,6 +640,30 @@ namespace oomph
     int n_aux = (int)N;
     int nnz_aux = (int)Nnz;
 
+    // SuperLU expects int offsets: copy them if the matrix uses 64-bit
+    // offsets (after checking that they fit)
+#ifdef OOMPH_HAS_64_BIT_SPARSE_OFFSETS
+    if (Nnz > static_cast<unsigned long>(INT_MAX))
+    {
+      std::ostringstream error_message_stream;
+      error_message_stream << "Number of nonzero entries, " << Nnz
+                           << ", exceeds the largest int.\n"
+                           << "SuperLU can only be used for matrices "
+                           << "with fewer than 2^31 nonzero entries.\n";
+      throw OomphLibError(error_message_stream.str(),
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+    Vector<int> superlu_start(N + 1);
+    for (unsigned long j = 0; j <= N; j++)
+    {
+      superlu_start[j] = static_cast<int>(Column_start[j]);
+    }
+    int* superlu_start_pt = &superlu_start[0];
+#else
+    int* superlu_start_pt = Column_start;
+#endif
+
     // Integer to hold the sign of the determinant
     int sign = 0;
 
@@ -649,7 +675,7 @@ namespace oomph
                            0,
                            Value,
                            Row_index,
-                           Column_start,
+                           superlu_start_pt,
                            0,
                            &n_aux,
                            &transpose,
@@ -719,13 +745,14 @@ namespace oomph
     // SuperLU in three steps (lu decompose, back subst, cleanup)
     // Do the solve phase
     int i = 2;
+    // (The offsets are only needed for the LU decomposition)
     superlu_complex(&i,
                     &n_aux,
                     &nnz_aux,
                     &nrhs,
                     Value,
                     Row_index,
-                    Column_start,
+                    0,
                     b,
                     &n_aux,
                     &transpose,
@@ -768,13 +795,14 @@ namespace oomph
       // SuperLU in three steps (lu decompose, back subst, cleanup)
       // Flag to indicate which solve step to do (1, 2 or 3)
       int i = 3;
+      // (The offsets are only needed for the LU decomposition)
       superlu_complex(&i,
                       &n_aux,
                       &nnz_aux,
                       0,
                       Value,
                       Row_index,
-                      Column_start,
+                      0,
                       0,
                       &n_aux,
                       &transpose,
@@ -839,7 +867,7 @@ namespace oomph
     // Now loop over columns
     for (unsigned long j = 0; j < N; j++)
     {
-      for (long k = Column_start[j]; k < Column_start[j + 1]; k++)
+      for (SparseOffset k = Column_start[j]; k < Column_start[j + 1]; k++)
       {
         unsigned long i = Row_index[k];
         std::complex<double> a_ij = Value[k];
@@ -880,7 +908,7 @@ namespace oomph
 
     for (unsigned long j = 0; j < N; j++)
     {
-      for (long k = Column_start[j]; k < Column_start[j + 1]; k++)
+      for (SparseOffset k = Column_start[j]; k < Column_start[j + 1]; k++)
       {
         unsigned long i = Row_index[k];
         std::complex<double> a_ij = Value[k];
@@ -925,7 +953,7 @@ namespace oomph
     // Matrix vector product
     for (unsigned long i = 0; i < N; i++)
     {
-      for (long k = Column_start[i]; k < Column_start[i + 1]; k++)
+      for (SparseOffset k = Column_start[i]; k < Column_start[i + 1]; k++)
       {
         unsigned long j = Row_index[k];
         std::complex<double> a_ij = Value[k];
@@ -970,6 +998,30 @@ namespace oomph
     int n_aux = int(N);
     int nnz_aux = int(Nnz);
 
+    // SuperLU expects int offsets: copy them if the matrix uses 64-bit
+    // offsets (after checking that they fit)
+#ifdef OOMPH_HAS_64_BIT_SPARSE_OFFSETS
+    if (Nnz > static_cast<unsigned long>(INT_MAX))
+    {
+      std::ostringstream error_message_stream;
+      error_message_stream << "Number of nonzero entries, " << Nnz
+                           << ", exceeds the largest int.\n"
+                           << "SuperLU can only be used for matrices "
+                           << "with fewer than 2^31 nonzero entries.\n";
+      throw OomphLibError(error_message_stream.str(),
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+    Vector<int> superlu_start(N + 1);
+    for (unsigned long j = 0; j <= N; j++)
+    {
+      superlu_start[j] = static_cast<int>(Row_start[j]);
+    }
+    int* superlu_start_pt = &superlu_start[0];
+#else
+    int* superlu_start_pt = Row_start;
+#endif
+
     // Integer to hold the sign of the determinant
     int sign = 0;
 
@@ -981,7 +1033,7 @@ namespace oomph
                            0,
                            Value,
                            Column_index,
-                           Row_start,
+                           superlu_start_pt,
                            0,
                            &n_aux,
                            &transpose,
@@ -1049,13 +1101,14 @@ namespace oomph
     // SuperLU in three steps (lu decompose, back subst, cleanup)
     // Do the solve phase
     int i = 2;
+    // (The offsets are only needed for the LU decomposition)
     superlu_complex(&i,
                     &n_aux,
                     &nnz_aux,
                     &nrhs,
                     Value,
                     Column_index,
-                    Row_start,
+                    0,
                     b,
                     &n_aux,
                     &transpose,
@@ -1097,13 +1150,14 @@ namespace oomph
       // SuperLU in three steps (lu decompose, back subst, cleanup)
       // Flag to indicate which solve step to do (1, 2 or 3)
       int i = 3;
+      // (The offsets are only needed for the LU decomposition)
       superlu_complex(&i,
                       &n_aux,
                       &nnz_aux,
                       0,
                       Value,
                       Column_index,
-                      Row_start,
+                      0,
                       0,
                       &n_aux,
                       &transpose,
@@ -1154,7 +1208,7 @@ namespace oomph
     for (unsigned long i = 0; i < N; i++)
     {
       residual[i] = rhs[i];
-      for (long k = Row_start[i]; k < Row_start[i + 1]; k++)
+      for (SparseOffset k = Row_start[i]; k < Row_start[i + 1]; k++)
       {
         unsigned long j = Column_index[k];
         std::complex<double> a_ij = Value[k];
@@ -1191,7 +1245,7 @@ namespace oomph
     for (unsigned long i = 0; i < N; i++)
     {
       soln[i] = 0.0;
-      for (long k = Row_start[i]; k < Row_start[i + 1]; k++)
+      for (SparseOffset k = Row_start[i]; k < Row_start[i + 1]; k++)
       {
         unsigned long j = Column_index[k];
         std::complex<double> a_ij = Value[k];
@@ -1236,7 +1290,7 @@ namespace oomph
     // Matrix vector product
     for (unsigned long i = 0; i < N; i++)
     {
-      for (long k = Row_start[i]; k < Row_start[i + 1]; k++)
+      for (SparseOffset k = Row_start[i]; k < Row_start[i + 1]; k++)
       {
         unsigned long j = Column_index[k];
         std::complex<double> a_ij = Value[k];
@@ -297,7 +297,7 @@ namespace oomph
     /// for square matrices)
     CRComplexMatrix(const Vector<std::complex<double>>& value,
                     const Vector<int>& column_index,
-                    const Vector<int>& row_start,
+                    const Vector<SparseOffset>& row_start,
                     const unsigned long& n,
                     const unsigned long& m)
       : CRMatrix<std::complex<double>>(value, column_index, row_start, n, m),
@@ -417,7 +417,7 @@ namespace oomph
     /// to its correct length.
     CCComplexMatrix(const Vector<std::complex<double>>& value,
                     const Vector<int>& row_index,
-                    const Vector<int>& column_start,
+                    const Vector<SparseOffset>& column_start,
                     const unsigned long& n,
                     const unsigned long& m)
       : CCMatrix<std::complex<double>>(value, row_index, column_start, n, m),
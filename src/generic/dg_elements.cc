@@ -409,6 +409,63 @@ namespace oomph
   }
 
 
+  //===================================================================
+  /// Compute the numerical flux at the integration points owned by
+  /// the present face. The flux is stored in the present face and, with
+  /// the opposite sign, in the paired integration point of the
+  /// neighbouring face. Only the entries associated with the owned
+  /// integration points are written, so different faces can be
+  /// processed concurrently.
+  //===================================================================
+  void DGFaceElement::precompute_fluxes()
+  {
+    // Find the number of nodes
+    const unsigned n_node = nnode();
+    // Storage for the shape functions
+    Shape psi(n_node);
+    // Number of fluxes
+    const unsigned n_flux = this->required_nflux();
+
+    // Storage for the flux; the derivatives are not required
+    Vector<double> F(n_flux);
+    DenseMatrix<double> dummy_dF_du_int;
+    DenseMatrix<double> dummy_dF_du_ext;
+
+    // Loop over the integration points owned by the present face
+    const unsigned n_owned = Flux_owner_knot.size();
+    for (unsigned k = 0; k < n_owned; k++)
+    {
+      const unsigned ipt = Flux_owner_knot[k];
+
+      // Get the shape functions at the knot and the numerical flux
+      this->shape_at_knot(ipt, psi);
+      this->numerical_flux_at_knot(
+        ipt, psi, F, dummy_dF_du_int, dummy_dF_du_ext, 0);
+
+      // Store it in the present face
+      Vector<double>& own_F = Precomputed_flux[ipt];
+      for (unsigned i = 0; i < n_flux; i++)
+      {
+        own_F[i] = F[i];
+      }
+
+      // The flux out of the neighbouring face is the negative of the
+      // flux out of the present face
+      const int neighbour_ipt = Neighbour_knot[ipt];
+      if (neighbour_ipt >= 0)
+      {
+        Vector<double>& neighbour_F =
+          dynamic_cast<DGFaceElement*>(Neighbour_face_pt[ipt])
+            ->Precomputed_flux[neighbour_ipt];
+        for (unsigned i = 0; i < n_flux; i++)
+        {
+          neighbour_F[i] = -F[i];
+        }
+      }
+    }
+  }
+
+
   //===================================================================
   /// Calculate the integrated (numerical) flux out of the face and add
   /// it to the residuals vector
@@ -480,8 +537,21 @@ namespace oomph
         J *= this->J_eulerian_at_knot(ipt);
       }
 
-      // Now calculate the numerical flux (and derivatives)
-      this->numerical_flux_at_knot(ipt, psi, F, dF_du_int, dF_du_ext, flag);
+      // If the flux has been precomputed by the mesh and we only
+      // require the residuals, use it
+      if (Flux_has_been_precomputed && !(flag && (flag < 3)))
+      {
+        const Vector<double>& precomputed_F = Precomputed_flux[ipt];
+        for (unsigned i = 0; i < n_flux; i++)
+        {
+          F[i] = precomputed_F[i];
+        }
+      }
+      // Otherwise calculate the numerical flux (and derivatives)
+      else
+      {
+        this->numerical_flux_at_knot(ipt, psi, F, dF_du_int, dF_du_ext, flag);
+      }
 
       // Limit if desired here
 
@@ -734,6 +804,204 @@ namespace oomph
   double DGMesh::FaceTolerance = 1.0e-10;
 
 
+  //=====================================================================
+  /// Pair up the integration points in adjacent faces: the integration
+  /// point ipt in face f is paired with integration point jpt in its
+  /// neighbouring face g if the two points coincide (to within
+  /// FaceTolerance in g's local coordinates) and ipt is also the
+  /// neighbouring point of jpt. The numerical flux at a pair of points
+  /// is computed by the face that is encountered first; unpaired points
+  /// (e.g. on boundaries) are computed by their own face.
+  //=====================================================================
+  void DGMesh::setup_interface_flux_pairing()
+  {
+    // Collect all the faces and number them in the order in which
+    // they are visited
+    Flux_face_pt.clear();
+    std::map<DGFaceElement*, unsigned> face_number;
+    const unsigned n_element = this->nelement();
+    for (unsigned e = 0; e < n_element; e++)
+    {
+      DGElement* const elem_pt =
+        dynamic_cast<DGElement*>(this->element_pt(e));
+      const unsigned n_face = elem_pt->nface();
+      for (unsigned f = 0; f < n_face; f++)
+      {
+        DGFaceElement* const face_pt = elem_pt->face_element_pt(f);
+        face_number[face_pt] = Flux_face_pt.size();
+        Flux_face_pt.push_back(face_pt);
+      }
+    }
+
+    // Now set up the storage for the fluxes and the pairing
+    const unsigned n_face = Flux_face_pt.size();
+    for (unsigned f = 0; f < n_face; f++)
+    {
+      DGFaceElement* const face_pt = Flux_face_pt[f];
+      const unsigned n_intpt = face_pt->integral_pt()->nweight();
+      const unsigned n_flux = face_pt->required_nflux();
+
+#ifdef PARANOID
+      if (face_pt->Neighbour_face_pt.size() != n_intpt)
+      {
+        std::ostringstream error_stream;
+        error_stream
+          << "Face neighbour information has not been set up.\n"
+          << "You should call DGMesh::setup_face_neighbour_info() before\n"
+          << "enabling the precomputation of the interface fluxes\n";
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+
+      face_pt->Neighbour_knot.assign(n_intpt, -1);
+      face_pt->Flux_owner_knot.clear();
+      face_pt->Precomputed_flux.resize(n_intpt);
+      for (unsigned ipt = 0; ipt < n_intpt; ipt++)
+      {
+        face_pt->Precomputed_flux[ipt].assign(n_flux, 0.0);
+      }
+      face_pt->Flux_has_been_precomputed = false;
+    }
+
+    // Local coordinate of the integration points
+    Vector<double> s;
+    for (unsigned f = 0; f < n_face; f++)
+    {
+      DGFaceElement* const face_pt = Flux_face_pt[f];
+      const unsigned n_intpt = face_pt->integral_pt()->nweight();
+      for (unsigned ipt = 0; ipt < n_intpt; ipt++)
+      {
+        // If the point has already been paired, it is owned by the
+        // neighbour
+        if (face_pt->Neighbour_knot[ipt] >= 0)
+        {
+          continue;
+        }
+
+        // Otherwise the present face computes the flux
+        face_pt->Flux_owner_knot.push_back(ipt);
+
+        // Find the neighbour; nothing to pair if it is the face itself
+        // or it is not part of the present mesh
+        DGFaceElement* const neighbour_pt =
+          dynamic_cast<DGFaceElement*>(face_pt->Neighbour_face_pt[ipt]);
+        if ((neighbour_pt == face_pt) ||
+            (neighbour_pt->bulk_element_pt() == face_pt->bulk_element_pt()))
+        {
+          continue;
+        }
+        std::map<DGFaceElement*, unsigned>::iterator it =
+          face_number.find(neighbour_pt);
+        if ((it == face_number.end()) || (it->second <= f))
+        {
+          continue;
+        }
+
+        // Find the integration point in the neighbour that coincides
+        // with the present integration point and whose neighbour is
+        // the present point
+        const Vector<double>& s_neighbour =
+          face_pt->Neighbour_local_coordinate[ipt];
+        const unsigned el_dim = neighbour_pt->dim();
+        s.resize(el_dim);
+        const unsigned n_neighbour_intpt =
+          neighbour_pt->integral_pt()->nweight();
+        for (unsigned jpt = 0; jpt < n_neighbour_intpt; jpt++)
+        {
+          if ((neighbour_pt->Neighbour_face_pt[jpt] != face_pt) ||
+              (neighbour_pt->Neighbour_knot[jpt] >= 0))
+          {
+            continue;
+          }
+
+          // Compare the local coordinates in the neighbour ...
+          bool coincident = true;
+          for (unsigned i = 0; i < el_dim; i++)
+          {
+            if (std::fabs(neighbour_pt->integral_pt()->knot(jpt, i) -
+                          s_neighbour[i]) > FaceTolerance)
+            {
+              coincident = false;
+              break;
+            }
+          }
+          // ... and in the present face
+          if (coincident)
+          {
+            const Vector<double>& s_present =
+              neighbour_pt->Neighbour_local_coordinate[jpt];
+            for (unsigned i = 0; i < el_dim; i++)
+            {
+              if (std::fabs(face_pt->integral_pt()->knot(ipt, i) -
+                            s_present[i]) > FaceTolerance)
+              {
+                coincident = false;
+                break;
+              }
+            }
+          }
+
+          // Pair the points up
+          if (coincident)
+          {
+            face_pt->Neighbour_knot[ipt] = jpt;
+            neighbour_pt->Neighbour_knot[jpt] = ipt;
+            break;
+          }
+        }
+      }
+    }
+  }
+
+
+  //=====================================================================
+  /// Compute the numerical fluxes at the integration points in all
+  /// faces, evaluating the flux once for each pair of coincident points
+  /// in adjacent faces. Each face only writes the fluxes at its owned
+  /// points (and the paired points in the neighbours, which are not
+  /// owned by anybody else) so the faces can be processed concurrently;
+  /// this requires the faces' numerical_flux(...) functions to be
+  /// thread-safe.
+  //=====================================================================
+  void DGMesh::precompute_interface_fluxes()
+  {
+    // Set up the pairing if required
+    if (Flux_face_pt.size() == 0)
+    {
+      setup_interface_flux_pairing();
+    }
+
+    const int n_face = Flux_face_pt.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64) if (n_face > 256)
+#endif
+    for (int f = 0; f < n_face; f++)
+    {
+      Flux_face_pt[f]->precompute_fluxes();
+    }
+
+    // The fluxes can now be used
+    for (int f = 0; f < n_face; f++)
+    {
+      Flux_face_pt[f]->Flux_has_been_precomputed = true;
+    }
+  }
+
+
+  //=====================================================================
+  /// Flag the precomputed fluxes as out of date
+  //=====================================================================
+  void DGMesh::release_interface_fluxes()
+  {
+    const unsigned n_face = Flux_face_pt.size();
+    for (unsigned f = 0; f < n_face; f++)
+    {
+      Flux_face_pt[f]->Flux_has_been_precomputed = false;
+    }
+  }
+
+
   //====================================================
   /// Helper minmod function
   //====================================================
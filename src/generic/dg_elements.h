@@ -62,6 +62,37 @@ namespace oomph
     /// boolean flag set to true.
     Vector<Vector<unsigned>> Neighbour_external_data;
 
+    /// The DGMesh sets up the pairing of the integration points
+    /// in adjacent faces and precomputes the fluxes, so it's a friend
+    friend class DGMesh;
+
+    /// Vector of the indices of the integration points in the
+    /// neighbouring faces that coincide with the integration points in
+    /// the present face (-1 if there is no such point, e.g. on a boundary
+    /// where the neighbour is the face itself). Only set up by
+    /// DGMesh::setup_interface_flux_pairing().
+    Vector<int> Neighbour_knot;
+
+    /// Vector of the integration points at which the present face
+    /// computes the numerical flux when the fluxes are precomputed.
+    /// The flux at the paired point in the neighbouring face is
+    /// obtained by conservation.
+    Vector<unsigned> Flux_owner_knot;
+
+    /// Vector of the numerical fluxes at the integration points, as
+    /// precomputed by DGMesh::precompute_interface_fluxes()
+    Vector<Vector<double>> Precomputed_flux;
+
+    /// Boolean flag to indicate whether the entries in
+    /// Precomputed_flux are up to date
+    bool Flux_has_been_precomputed;
+
+    /// Compute the numerical fluxes at the integration points owned
+    /// by the present face and store them in the present face and
+    /// (with the opposite sign) in the paired integration points of the
+    /// neighbouring faces
+    void precompute_fluxes();
+
   protected:
     /// Return the index at which the i-th unknown flux is stored.
     // The default return is suitable for single-physics problem
@@ -78,7 +109,7 @@ namespace oomph
 
   public:
     /// Empty Constructor
-    DGFaceElement() : FaceElement() {}
+    DGFaceElement() : FaceElement(), Flux_has_been_precomputed(false) {}
 
     /// Empty Destructor
     virtual ~DGFaceElement() {}
@@ -463,7 +494,7 @@ namespace oomph
   public:
     static double FaceTolerance;
 
-    DGMesh() : Mesh() {}
+    DGMesh() : Mesh(), Interface_flux_precomputation_is_enabled(false) {}
 
     virtual ~DGMesh() {}
 
@@ -496,8 +527,58 @@ namespace oomph
         dynamic_cast<DGElement*>(this->element_pt(e))
           ->setup_face_neighbour_info(add_face_data_as_external);
       }
+
+      // The pairing of the integration points in adjacent faces
+      // must be recomputed
+      if (Interface_flux_precomputation_is_enabled)
+      {
+        setup_interface_flux_pairing();
+      }
+    }
+
+    /// Enable the precomputation of the numerical fluxes: the flux
+    /// across each interface between two elements is computed once (by
+    /// the face that owns the interface) rather than separately by each
+    /// of the two adjacent faces. Only valid if the numerical flux is
+    /// conservative, i.e. the flux computed in the neighbouring face is
+    /// the negative of the flux in the present face. The fluxes are
+    /// precomputed in Problem::get_inverse_mass_matrix_times_residuals(...)
+    /// and are only used when the residuals (but not the Jacobian) are
+    /// assembled.
+    void enable_interface_flux_precomputation()
+    {
+      Interface_flux_precomputation_is_enabled = true;
+      setup_interface_flux_pairing();
+    }
+
+    /// Disable the precomputation of the numerical fluxes (the default)
+    void disable_interface_flux_precomputation()
+    {
+      Interface_flux_precomputation_is_enabled = false;
+      release_interface_fluxes();
+      Flux_face_pt.clear();
+    }
+
+    /// Return whether the numerical fluxes are precomputed
+    bool interface_flux_precomputation_is_enabled() const
+    {
+      return Interface_flux_precomputation_is_enabled;
     }
 
+    /// Pair up the integration points in adjacent faces and decide
+    /// which face computes the flux at each interface. Requires the
+    /// face neighbour information to have been set up.
+    void setup_interface_flux_pairing();
+
+    /// Compute the numerical fluxes at all integration points in all
+    /// faces, evaluating the flux once per interface. The faces are
+    /// processed in parallel if OpenMP is available.
+    void precompute_interface_fluxes();
+
+    /// Flag the precomputed fluxes as out of date so that the faces
+    /// compute their fluxes themselves again
+    void release_interface_fluxes();
+
     // Limit the slopes on the entire mesh
     void limit_slopes(SlopeLimiter* const& slope_limiter_pt)
     {
@@ -515,6 +596,84 @@ namespace oomph
           ->slope_limit(slope_limiter_pt);
       }
     }
+
+  private:
+    /// Boolean flag to indicate whether the numerical fluxes are
+    /// precomputed once per interface
+    bool Interface_flux_precomputation_is_enabled;
+
+    /// Vector of pointers to all the faces in the mesh, in the order
+    /// in which they were visited when setting up the flux pairing
+    Vector<DGFaceElement*> Flux_face_pt;
+  };
+
+
+  //======================================================================
+  /// Precomputes the numerical fluxes in the DGMeshes for which the
+  /// precomputation is enabled on construction and flags them as out of
+  /// date when the object goes out of scope, so the faces never use
+  /// stale fluxes, even if an exception is thrown while the (inverse mass
+  /// matrix times) residuals are assembled.
+  //======================================================================
+  class DGInterfaceFluxPrecomputation
+  {
+  public:
+    /// Constructor: Precompute the fluxes in the meshes (those for
+    /// which the precomputation is not enabled are ignored)
+    DGInterfaceFluxPrecomputation(const Vector<DGMesh*>& mesh_pt)
+    {
+      const unsigned n_mesh = mesh_pt.size();
+      for (unsigned m = 0; m < n_mesh; m++)
+      {
+        if (mesh_pt[m]->interface_flux_precomputation_is_enabled())
+        {
+          Mesh_pt.push_back(mesh_pt[m]);
+        }
+      }
+
+      // The destructor isn't called if the constructor throws, so
+      // release the fluxes here if the precomputation fails
+      try
+      {
+        const unsigned n_precomputed = Mesh_pt.size();
+        for (unsigned m = 0; m < n_precomputed; m++)
+        {
+          Mesh_pt[m]->precompute_interface_fluxes();
+        }
+      }
+      catch (...)
+      {
+        release();
+        throw;
+      }
+    }
+
+    /// Broken copy constructor
+    DGInterfaceFluxPrecomputation(const DGInterfaceFluxPrecomputation&) =
+      delete;
+
+    /// Broken assignment operator
+    void operator=(const DGInterfaceFluxPrecomputation&) = delete;
+
+    /// Destructor: Flag the precomputed fluxes as out of date
+    ~DGInterfaceFluxPrecomputation()
+    {
+      release();
+    }
+
+  private:
+    /// Flag the precomputed fluxes as out of date
+    void release()
+    {
+      const unsigned n_mesh = Mesh_pt.size();
+      for (unsigned m = 0; m < n_mesh; m++)
+      {
+        Mesh_pt[m]->release_interface_fluxes();
+      }
+    }
+
+    /// The meshes whose fluxes have been precomputed
+    Vector<DGMesh*> Mesh_pt;
   };
 
 
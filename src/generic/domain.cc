@@ -32,6 +32,60 @@
 
 namespace oomph
 {
+  //=================================================================
+  /// Derivatives of the vector representation of the i_macro-th
+  /// macro element boundary i_direct at the current time w.r.t. the
+  /// values of the Data in the set geom_data_pt, obtained by finite
+  /// differencing macro_element_boundary(...):
+  /// df_dgeom_data[data_pt](i,k) = df_i / d (k-th value of data_pt).
+  //=================================================================
+  void Domain::dmacro_element_boundary_dgeom_data(
+    const unsigned& i_macro,
+    const unsigned& i_direct,
+    const Vector<double>& s,
+    const std::set<Data*>& geom_data_pt,
+    std::map<Data*, DenseMatrix<double>>& df_dgeom_data)
+  {
+    df_dgeom_data.clear();
+
+    // Unperturbed position (the boundaries of n-dimensional macro
+    // elements are parametrised by n-1 coordinates)
+    const unsigned n_dim = s.size() + 1;
+    Vector<double> f(n_dim);
+    macro_element_boundary(i_macro, i_direct, s, f);
+
+    // Use the same step as the default finite difference Jacobians
+    const double fd_step = 1.0e-8;
+
+    // Loop over the Data and their values
+    Vector<double> f_pls(n_dim);
+    for (std::set<Data*>::const_iterator it = geom_data_pt.begin();
+         it != geom_data_pt.end();
+         it++)
+    {
+      Data* data_pt = *it;
+      const unsigned n_value = data_pt->nvalue();
+      DenseMatrix<double>& df_ddata = df_dgeom_data[data_pt];
+      df_ddata.resize(n_dim, n_value, 0.0);
+      for (unsigned k = 0; k < n_value; k++)
+      {
+        // Perturb the value and get the new position
+        double* value_pt = data_pt->value_pt(k);
+        double old_var = *value_pt;
+        *value_pt += fd_step;
+        macro_element_boundary(i_macro, i_direct, s, f_pls);
+        for (unsigned i = 0; i < n_dim; i++)
+        {
+          df_ddata(i, k) = (f_pls[i] - f[i]) / fd_step;
+        }
+
+        // Reset the value
+        *value_pt = old_var;
+      }
+    }
+  }
+
+
   /// //////////////////////////////////////////////////////////////////////
   /// //////////////////////////////////////////////////////////////////////
   // Warped cube domain
@@ -183,6 +183,22 @@ namespace oomph
     }
 
 
+    /// Derivatives of the vector representation of the i_macro-th
+    /// macro element boundary i_direct (e.g. N/S/W/E in 2D) at the current
+    /// time w.r.t. the values of the Data in the set geom_data_pt, which
+    /// are assumed to contain all Data that the shape of the Domain
+    /// depends on: df_dgeom_data[data_pt](i,k) = df_i / d (k-th value of
+    /// data_pt). The default implementation finite differences
+    /// macro_element_boundary(...); overload it to provide analytic
+    /// derivatives.
+    virtual void dmacro_element_boundary_dgeom_data(
+      const unsigned& i_macro,
+      const unsigned& i_direct,
+      const Vector<double>& s,
+      const std::set<Data*>& geom_data_pt,
+      std::map<Data*, DenseMatrix<double>>& df_dgeom_data);
+
+
     /// Output all macro element boundaries as tecplot zones
     void output_macro_element_boundaries(const std::string& filename,
                                          const unsigned& nplot)
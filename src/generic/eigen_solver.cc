@@ -34,6 +34,8 @@
 #include "arpack.h"
 #include "lapack_qz.h"
 
+#include <algorithm>
+
 // Oomph-lib headers
 #include "eigen_solver.h"
 #include "linear_solver.h"
@@ -831,4 +833,870 @@ namespace oomph
     delete[] A_linear;
     delete[] M_linear;
   }
+
+
+  //===============================================================
+  /// Constructor, set default values and set the initial
+  /// linear solver to be superlu
+  //===============================================================
+  KrylovSchur::KrylovSchur()
+    : EigenSolver(),
+      Factorised_linear_solver_pt(0),
+      NKrylov(30),
+      Block_size(1),
+      Max_restarts(300),
+      Tolerance(1.0e-10),
+      Nrestart(0),
+      Noperator_application(0),
+      Compute_eigenvectors(true),
+      Factorisation_reuse_is_enabled(true),
+      Factorisation_is_stored(false),
+      Factorisation_was_reused(false),
+      Symbolic_factorisation_was_reused(false),
+      Refinement_tolerance(1.0e-12),
+      Max_refinement_iterations(10),
+      Nrefinement_iteration(0),
+      Stored_sigma(0.0),
+      Stored_pattern_checksum(0),
+      Doc_time(false),
+      Random_seed(1)
+  {
+    Default_linear_solver_pt = Linear_solver_pt = new SuperLUSolver;
+  }
+
+  //===============================================================
+  /// Destructor, delete the default linear solver (and with it
+  /// any factorisation it stores)
+  //===============================================================
+  KrylovSchur::~KrylovSchur()
+  {
+    delete Default_linear_solver_pt;
+  }
+
+  //===============================================================
+  /// Wipe the stored factorisation of the shifted matrix
+  //===============================================================
+  void KrylovSchur::clean_up_factorisation()
+  {
+    if (Factorisation_is_stored && (Factorised_linear_solver_pt != 0))
+    {
+      Factorised_linear_solver_pt->disable_resolve();
+    }
+    Factorisation_is_stored = false;
+    Factorised_linear_solver_pt = 0;
+  }
+
+  //===============================================================
+  /// Checksum (FNV-1a hash) of the sparsity pattern of a
+  /// CRDoubleMatrix
+  //===============================================================
+  unsigned long KrylovSchur::pattern_checksum(CRDoubleMatrix& matrix) const
+  {
+    const unsigned long prime = 1099511628211UL;
+    unsigned long hash = 14695981039346656037UL;
+
+    const unsigned long n_row = matrix.nrow_local();
+    const unsigned long n_nz = matrix.nnz();
+    hash = (hash ^ n_row) * prime;
+    hash = (hash ^ n_nz) * prime;
+
+    const SparseOffset* row_start_pt = matrix.row_start();
+    for (unsigned long i = 0; i <= n_row; i++)
+    {
+      hash = (hash ^ static_cast<unsigned long>(row_start_pt[i])) * prime;
+    }
+
+    const int* column_index_pt = matrix.column_index();
+    for (unsigned long k = 0; k < n_nz; k++)
+    {
+      hash = (hash ^ static_cast<unsigned long>(column_index_pt[k])) * prime;
+    }
+
+    return hash;
+  }
+
+  //===============================================================
+  /// Factorise the shifted matrix and store the factorisation
+  /// (re-using the symbolic factorisation of the stored factors if
+  /// requested and if the linear solver is SuperLU)
+  //===============================================================
+  void KrylovSchur::factorise_shifted_matrix(
+    CRDoubleMatrix& AsigmaM,
+    const unsigned long& matrix_pattern_checksum,
+    const bool& reuse_symbolic_factorisation)
+  {
+    SuperLUSolver* superlu_solver_pt =
+      dynamic_cast<SuperLUSolver*>(Linear_solver_pt);
+    Symbolic_factorisation_was_reused =
+      reuse_symbolic_factorisation && (superlu_solver_pt != 0);
+    if (Symbolic_factorisation_was_reused)
+    {
+      // Keep the stored factors; SuperLU replaces them
+      superlu_solver_pt->enable_reuse_of_symbolic_factorisation();
+    }
+    else
+    {
+      clean_up_factorisation();
+    }
+
+    // Do not report the time taken by the linear solver
+    bool doc_time_backup = Linear_solver_pt->is_doc_time_enabled();
+    Linear_solver_pt->disable_doc_time();
+
+    // Factorise (by solving a dummy system) and keep the factors
+    Linear_solver_pt->enable_resolve();
+    DoubleVector rhs(this->distribution_pt(), 0.0);
+    DoubleVector x(this->distribution_pt(), 0.0);
+    Linear_solver_pt->solve(&AsigmaM, rhs, x);
+
+    if (doc_time_backup)
+    {
+      Linear_solver_pt->enable_doc_time();
+    }
+    if (Symbolic_factorisation_was_reused)
+    {
+      superlu_solver_pt->disable_reuse_of_symbolic_factorisation();
+    }
+
+    Factorisation_is_stored = true;
+    Factorised_linear_solver_pt = Linear_solver_pt;
+    Stored_sigma = Sigma_real;
+    Stored_pattern_checksum = matrix_pattern_checksum;
+  }
+
+  //===============================================================
+  /// Solve the shifted system with the stored factorisation,
+  /// followed (if refine is true) by iterative refinement with the
+  /// actual shifted matrix. Returns false if the normwise backward
+  /// error ||r||/(||A|| ||x|| + ||b||) (in the infinity norm) does
+  /// not drop below the refinement tolerance.
+  //===============================================================
+  bool KrylovSchur::solve_shifted_system(const CRDoubleMatrix& AsigmaM,
+                                         const double& a_norm,
+                                         const DoubleVector& rhs,
+                                         DoubleVector& x,
+                                         const bool& refine)
+  {
+    Linear_solver_pt->resolve(rhs, x);
+    if (!refine)
+    {
+      return true;
+    }
+
+    const double rhs_norm = rhs.max();
+    DoubleVector r(this->distribution_pt(), 0.0);
+    DoubleVector dx(this->distribution_pt(), 0.0);
+    for (unsigned iter = 0; iter <= Max_refinement_iterations; iter++)
+    {
+      // Residual (with the opposite sign) r = A x - b
+      AsigmaM.multiply(x, r);
+      r -= rhs;
+      if (r.max() <= Refinement_tolerance * (a_norm * x.max() + rhs_norm))
+      {
+        return true;
+      }
+      if (iter == Max_refinement_iterations)
+      {
+        break;
+      }
+
+      // Correct the solution
+      Linear_solver_pt->resolve(r, dx);
+      x -= dx;
+      Nrefinement_iteration++;
+    }
+    return false;
+  }
+
+  //===============================================================
+  /// Orthogonalise w against the first nbasis vectors in basis
+  /// (two passes of modified Gram-Schmidt). Adds the projection
+  /// coefficients to coeff and returns the norm of the result.
+  //===============================================================
+  double KrylovSchur::orthogonalise(const Vector<DoubleVector>& basis,
+                                    const unsigned& nbasis,
+                                    DoubleVector& w,
+                                    Vector<double>& coeff) const
+  {
+    const unsigned n_row = w.nrow_local();
+    double* w_pt = w.values_pt();
+    for (unsigned pass = 0; pass < 2; pass++)
+    {
+      for (unsigned i = 0; i < nbasis; i++)
+      {
+        const double* b_pt = basis[i].values_pt();
+        double r = 0.0;
+        for (unsigned k = 0; k < n_row; k++)
+        {
+          r += b_pt[k] * w_pt[k];
+        }
+        for (unsigned k = 0; k < n_row; k++)
+        {
+          w_pt[k] -= r * b_pt[k];
+        }
+        coeff[i] += r;
+      }
+    }
+    return w.norm();
+  }
+
+  //===============================================================
+  /// Fill w with pseudo-random entries (from a simple linear
+  /// congruential generator so that runs are reproducible),
+  /// orthogonalise it against the basis and normalise it
+  //===============================================================
+  void KrylovSchur::random_orthonormal_vector(const Vector<DoubleVector>& basis,
+                                              const unsigned& nbasis,
+                                              DoubleVector& w)
+  {
+    const unsigned n_row = w.nrow_local();
+    double* w_pt = w.values_pt();
+    for (unsigned k = 0; k < n_row; k++)
+    {
+      Random_seed = (1103515245UL * Random_seed + 12345UL) % 2147483648UL;
+      w_pt[k] = double(Random_seed) / 2147483648.0 - 0.5;
+    }
+    Vector<double> dummy_coeff(nbasis, 0.0);
+    double norm = orthogonalise(basis, nbasis, w, dummy_coeff);
+    for (unsigned k = 0; k < n_row; k++)
+    {
+      w_pt[k] /= norm;
+    }
+  }
+
+  //===============================================================
+  /// Compute the eigenvalues and (real storage of the) right
+  /// eigenvectors of the n x n leading block of h, using LAPACK's
+  /// QZ algorithm with an identity "mass matrix".
+  //===============================================================
+  void KrylovSchur::eigen_decompose_projected_matrix(
+    const DenseMatrix<double>& h,
+    const unsigned& n,
+    Vector<std::complex<double>>& theta,
+    DenseMatrix<double>& y)
+  {
+    // Some character identifiers for use in the LAPACK routine
+    // Do not calculate the left eigenvectors
+    char no_eigvecs[2] = "N";
+    // Do caculate the eigenvectors
+    char eigvecs[2] = "V";
+
+    int n_int = n;
+
+    // Pad even-sized arrays, as in LAPACK_QZ::solve_eigenproblem(...)
+    int padding = 0;
+    if (n % 2 == 0)
+    {
+      padding = 1;
+    }
+    int padded_n = n_int + padding;
+
+    // Column-major storage of the matrices
+    double* A = new double[padded_n * padded_n];
+    double* B = new double[padded_n * padded_n];
+    unsigned index = 0;
+    for (unsigned j = 0; j < n; j++)
+    {
+      for (unsigned i = 0; i < n; i++)
+      {
+        A[index] = h(i, j);
+        B[index] = (i == j) ? 1.0 : 0.0;
+        ++index;
+      }
+      if (padding)
+      {
+        A[index] = 0.0;
+        B[index] = 0.0;
+        ++index;
+      }
+    }
+
+    double* alpha_r = new double[n];
+    double* alpha_i = new double[n];
+    double* beta = new double[n];
+    double* vec_left = new double[1];
+    double* vec_right = new double[n * n];
+
+    // Workspace query
+    std::vector<double> work(1, 0.0);
+    int info = 0;
+    LAPACK_DGGEV(no_eigvecs,
+                 eigvecs,
+                 n_int,
+                 &A[0],
+                 padded_n,
+                 &B[0],
+                 padded_n,
+                 alpha_r,
+                 alpha_i,
+                 beta,
+                 vec_left,
+                 1,
+                 vec_right,
+                 n_int,
+                 &work[0],
+                 -1,
+                 info);
+    int required_workspace = (int)work[0];
+    work.resize(required_workspace);
+
+    // Now do it
+    LAPACK_DGGEV(no_eigvecs,
+                 eigvecs,
+                 n_int,
+                 &A[0],
+                 padded_n,
+                 &B[0],
+                 padded_n,
+                 alpha_r,
+                 alpha_i,
+                 beta,
+                 vec_left,
+                 1,
+                 vec_right,
+                 n_int,
+                 &work[0],
+                 required_workspace,
+                 info);
+
+    if (info != 0)
+    {
+      std::ostringstream error_stream;
+      error_stream << "LAPACK's DGGEV failed with info = " << info
+                   << " for the projected eigenproblem.\n";
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+
+    // The "mass matrix" is the identity so beta never vanishes
+    theta.resize(n);
+    y.resize(n, n);
+    for (unsigned i = 0; i < n; i++)
+    {
+      theta[i] =
+        std::complex<double>(alpha_r[i] / beta[i], alpha_i[i] / beta[i]);
+      for (unsigned k = 0; k < n; k++)
+      {
+        y(k, i) = vec_right[i * n + k];
+      }
+    }
+
+    delete[] vec_right;
+    delete[] vec_left;
+    delete[] beta;
+    delete[] alpha_i;
+    delete[] alpha_r;
+    delete[] B;
+    delete[] A;
+  }
+
+
+  //==========================================================================
+  /// Use the (block) Krylov-Schur method with shift-invert to solve
+  /// an eigenproblem that is assembled by elements in a mesh in a
+  /// Problem object. The Krylov decomposition
+  /// \f[ OP V_m = V_m H_m + V_{+} B^T \f]
+  /// (with \f$ OP = (J - \sigma M)^{-1} M \f$) is expanded by block
+  /// Arnoldi steps and, once the maximum dimension has been reached,
+  /// truncated to an orthonormal basis of the wanted Ritz vectors
+  /// (i.e. to the invariant subspace spanned by the wanted Schur
+  /// vectors of \f$ H_m \f$) which is then expanded again.
+  //==========================================================================
+  void KrylovSchur::solve_eigenproblem(Problem* const& problem_pt,
+                                       const int& n_eval,
+                                       Vector<std::complex<double>>& eigenvalue,
+                                       Vector<DoubleVector>& eigenvector)
+  {
+    double t_start = TimingHelpers::timer();
+
+    // Reset the stats
+    Nrestart = 0;
+    Noperator_application = 0;
+    Nrefinement_iteration = 0;
+    Factorisation_was_reused = false;
+    Symbolic_factorisation_was_reused = false;
+
+    // Size of the problem
+    const unsigned n = problem_pt->ndof();
+
+    // Number of wanted eigenvalues and block size
+    const unsigned nev = n_eval;
+    const unsigned nblock = Block_size;
+
+#ifdef PARANOID
+    if (nblock == 0)
+    {
+      throw OomphLibError("Block size must be positive",
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    // Maximum dimension of the Krylov subspace: a multiple of the block
+    // size that leaves room for the wanted eigenvalues plus (at least)
+    // one further block.
+    unsigned m = nblock * ((NKrylov + nblock - 1) / nblock);
+    if (nev + nblock > m)
+    {
+      m = nblock * ((nev + 2 * nblock - 1) / nblock);
+
+      std::ostringstream warning_stream;
+      warning_stream << "Number of requested eigenvalues " << nev << "\n"
+                     << "is too large for the dimension of the Krylov "
+                     << "subspace " << NKrylov << "\n"
+                     << "Increasing the dimension of the Krylov subspace to "
+                     << m << "\n but you may want to increase it further "
+                     << "using\nKrylovSchur::nkrylov()\n"
+                     << "which will also get rid of this warning.\n";
+      OomphLibWarning(
+        warning_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+    if (m + nblock > n)
+    {
+      m = nblock * ((n - nblock) / nblock);
+      if ((n < nblock) || (nev + nblock > m))
+      {
+        std::ostringstream error_stream;
+        error_stream << "Problem (ndof = " << n << ") is too small to "
+                     << "compute " << nev << " eigenvalues with block size "
+                     << nblock << ".\nUse a dense eigensolver (LAPACK_QZ) "
+                     << "instead.\n";
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+    }
+
+    // Only use non-distributed matrices and vectors (as in ARPACK)
+    LinearAlgebraDistribution dist(problem_pt->communicator_pt(), n, false);
+    this->build_distribution(dist);
+
+    // Assemble the mass matrix and the shifted main matrix
+    CRDoubleMatrix M(this->distribution_pt()), AsigmaM(this->distribution_pt());
+    problem_pt->get_eigenproblem_matrices(M, AsigmaM, Sigma_real);
+    double t_assembly = TimingHelpers::timer() - t_start;
+
+    // Factorise the shifted matrix unless we can re-use the stored
+    // factorisation. The symbolic factorisation can be re-used if the
+    // sparsity pattern is unchanged; the numeric factorisation if the
+    // shift is unchanged too (in which case the operator is applied with
+    // iterative refinement because the values of the matrix may differ).
+    double t_factorisation_start = TimingHelpers::timer();
+    unsigned long matrix_pattern_checksum = 0;
+    bool same_pattern = false;
+    if (Factorisation_reuse_is_enabled)
+    {
+      matrix_pattern_checksum = pattern_checksum(AsigmaM);
+      same_pattern = Factorisation_is_stored &&
+                     (Factorised_linear_solver_pt == Linear_solver_pt) &&
+                     (Stored_pattern_checksum == matrix_pattern_checksum);
+    }
+    if (same_pattern && (Stored_sigma == Sigma_real))
+    {
+      Factorisation_was_reused = true;
+    }
+    else
+    {
+      factorise_shifted_matrix(AsigmaM, matrix_pattern_checksum, same_pattern);
+    }
+    const double a_norm = AsigmaM.inf_norm();
+    double t_factorisation = TimingHelpers::timer() - t_factorisation_start;
+
+    // Timers for the iteration
+    double t_operator = 0.0;
+    double t_orthogonalisation = 0.0;
+    double t_projected = 0.0;
+
+    // Storage for the basis vectors and the projected matrix:
+    // OP V(:,0:j-1) = V(:,0:j+nblock-1) H(0:j+nblock-1,0:j-1)
+    Vector<DoubleVector> v(m + nblock);
+    for (unsigned i = 0; i < m + nblock; i++)
+    {
+      v[i].build(this->distribution_pt(), 0.0);
+    }
+    DenseMatrix<double> h(m + nblock, m, 0.0);
+
+    // Random (but reproducible) starting block
+    Random_seed = 1;
+    for (unsigned c = 0; c < nblock; c++)
+    {
+      random_orthonormal_vector(v, c, v[c]);
+    }
+
+    // Storage for the result of the operator applications
+    Vector<DoubleVector> w(nblock);
+    DoubleVector mx(this->distribution_pt(), 0.0);
+
+    // Ritz values, vectors and the order in which they're wanted:
+    // Each entry in wanted stores the index of a real eigenvalue or
+    // the first index of a complex conjugate pair
+    Vector<std::complex<double>> theta;
+    DenseMatrix<double> y;
+    Vector<unsigned> wanted;
+
+    // Number of columns that have been processed
+    unsigned j = 0;
+
+    // Keep going until we have converged (or run out of restarts)
+    bool converged = false;
+    while (true)
+    {
+      // Expand the Krylov decomposition by block Arnoldi steps
+      while (j + nblock <= m)
+      {
+        // Apply the operator to the last block
+        double t_op_start = TimingHelpers::timer();
+        for (unsigned c = 0; c < nblock; c++)
+        {
+          M.multiply(v[j + c], mx);
+          if (!solve_shifted_system(
+                AsigmaM, a_norm, mx, w[c], Factorisation_was_reused))
+          {
+            // The re-used factorisation is too far off: Re-factorise
+            // (the pattern is unchanged) and try again
+            double t_refactorisation_start = TimingHelpers::timer();
+            factorise_shifted_matrix(AsigmaM, matrix_pattern_checksum, true);
+            Factorisation_was_reused = false;
+            double t_refactorisation =
+              TimingHelpers::timer() - t_refactorisation_start;
+            t_factorisation += t_refactorisation;
+            t_operator -= t_refactorisation;
+            solve_shifted_system(AsigmaM, a_norm, mx, w[c], false);
+          }
+          Noperator_application++;
+        }
+        t_operator += TimingHelpers::timer() - t_op_start;
+
+        // Orthogonalise each new vector against the current basis
+        // (including the new vectors that have already been added)
+        double t_orth_start = TimingHelpers::timer();
+        for (unsigned c = 0; c < nblock; c++)
+        {
+          const unsigned col = j + c;
+          const unsigned nbasis = j + nblock + c;
+          Vector<double> coeff(nbasis, 0.0);
+          double norm_before = w[c].norm();
+          double norm = orthogonalise(v, nbasis, w[c], coeff);
+          for (unsigned i = 0; i < nbasis; i++)
+          {
+            h(i, col) = coeff[i];
+          }
+
+          // Have we found an invariant subspace? Keep going with
+          // a new random vector
+          if (norm <= 1.0e-12 * norm_before)
+          {
+            h(nbasis, col) = 0.0;
+            random_orthonormal_vector(v, nbasis, v[nbasis]);
+          }
+          else
+          {
+            h(nbasis, col) = norm;
+            const unsigned n_row = w[c].nrow_local();
+            double* w_pt = w[c].values_pt();
+            double* v_pt = v[nbasis].values_pt();
+            for (unsigned k = 0; k < n_row; k++)
+            {
+              v_pt[k] = w_pt[k] / norm;
+            }
+          }
+        }
+        t_orthogonalisation += TimingHelpers::timer() - t_orth_start;
+
+        j += nblock;
+      }
+
+      double t_proj_start = TimingHelpers::timer();
+
+      // Solve the projected eigenproblem
+      eigen_decompose_projected_matrix(h, m, theta, y);
+
+      // Sort the eigenvalues (and complex conjugate pairs) by their
+      // magnitude: the largest eigenvalues of the shift-invert operator
+      // correspond to the eigenvalues closest to the shift
+      Vector<std::pair<double, unsigned>> sort_key;
+      for (unsigned i = 0; i < m; i++)
+      {
+        sort_key.push_back(std::make_pair(-std::abs(theta[i]), i));
+        if (theta[i].imag() != 0.0)
+        {
+          i++;
+        }
+      }
+      std::sort(sort_key.begin(), sort_key.end());
+      const unsigned n_unit = sort_key.size();
+      wanted.resize(n_unit);
+      for (unsigned u = 0; u < n_unit; u++)
+      {
+        wanted[u] = sort_key[u].second;
+      }
+
+      // Check convergence of the wanted Ritz pairs: the residual
+      // of the Ritz pair (theta,V y) is given by ||B^T y||
+      unsigned n_wanted_converged = 0;
+      unsigned n_wanted = 0;
+      for (unsigned u = 0; u < n_unit; u++)
+      {
+        if (n_wanted >= nev) break;
+        const unsigned i = wanted[u];
+        const unsigned n_col = (theta[i].imag() != 0.0) ? 2 : 1;
+        double res_squared = 0.0;
+        double y_norm_squared = 0.0;
+        for (unsigned col = i; col < i + n_col; col++)
+        {
+          for (unsigned r = 0; r < nblock; r++)
+          {
+            double sum = 0.0;
+            for (unsigned k = 0; k < m; k++)
+            {
+              sum += h(m + r, k) * y(k, col);
+            }
+            res_squared += sum * sum;
+          }
+          for (unsigned k = 0; k < m; k++)
+          {
+            y_norm_squared += y(k, col) * y(k, col);
+          }
+        }
+        if (std::sqrt(res_squared / y_norm_squared) <=
+            Tolerance * std::abs(theta[i]))
+        {
+          n_wanted_converged += n_col;
+        }
+        n_wanted += n_col;
+      }
+
+      if (n_wanted_converged == n_wanted)
+      {
+        converged = true;
+        t_projected += TimingHelpers::timer() - t_proj_start;
+        break;
+      }
+      if (Nrestart == Max_restarts)
+      {
+        t_projected += TimingHelpers::timer() - t_proj_start;
+        break;
+      }
+
+      // Restart: Select the Ritz vectors to be kept. Keep the wanted
+      // ones plus about half of the remaining space, without
+      // splitting complex conjugate pairs.
+      const unsigned k_target = nev + (m - nblock - nev) / 2;
+      unsigned k = 0;
+      DenseMatrix<double> q(m, m - nblock, 0.0);
+      for (unsigned u = 0; u < n_unit; u++)
+      {
+        const unsigned i = wanted[u];
+        const unsigned n_col = (theta[i].imag() != 0.0) ? 2 : 1;
+        if ((k >= k_target) || (k + n_col > m - nblock)) break;
+        for (unsigned col = i; col < i + n_col; col++)
+        {
+          for (unsigned r = 0; r < m; r++)
+          {
+            q(r, k) = y(r, col);
+          }
+          k++;
+        }
+      }
+
+      // Orthonormalise the selected vectors (two passes of modified
+      // Gram-Schmidt); they span an invariant subspace of H_m
+      for (unsigned c = 0; c < k; c++)
+      {
+        for (unsigned pass = 0; pass < 2; pass++)
+        {
+          for (unsigned c2 = 0; c2 < c; c2++)
+          {
+            double r = 0.0;
+            for (unsigned l = 0; l < m; l++)
+            {
+              r += q(l, c2) * q(l, c);
+            }
+            for (unsigned l = 0; l < m; l++)
+            {
+              q(l, c) -= r * q(l, c2);
+            }
+          }
+        }
+        double norm = 0.0;
+        for (unsigned l = 0; l < m; l++)
+        {
+          norm += q(l, c) * q(l, c);
+        }
+        norm = std::sqrt(norm);
+        for (unsigned l = 0; l < m; l++)
+        {
+          q(l, c) /= norm;
+        }
+      }
+
+      // New projected matrix: Q^T H_m Q and B^T Q
+      DenseMatrix<double> hq(m + nblock, k, 0.0);
+      for (unsigned r = 0; r < m + nblock; r++)
+      {
+        for (unsigned c = 0; c < k; c++)
+        {
+          double sum = 0.0;
+          for (unsigned l = 0; l < m; l++)
+          {
+            sum += h(r, l) * q(l, c);
+          }
+          hq(r, c) = sum;
+        }
+      }
+      h.initialise(0.0);
+      for (unsigned r = 0; r < k; r++)
+      {
+        for (unsigned c = 0; c < k; c++)
+        {
+          double sum = 0.0;
+          for (unsigned l = 0; l < m; l++)
+          {
+            sum += q(l, r) * hq(l, c);
+          }
+          h(r, c) = sum;
+        }
+      }
+      for (unsigned r = 0; r < nblock; r++)
+      {
+        for (unsigned c = 0; c < k; c++)
+        {
+          h(k + r, c) = hq(m + r, c);
+        }
+      }
+      t_projected += TimingHelpers::timer() - t_proj_start;
+
+      // New basis: V_m Q, followed by the residual block
+      double t_orth_start = TimingHelpers::timer();
+      const unsigned n_row = v[0].nrow_local();
+      Vector<DoubleVector> v_new(k);
+      for (unsigned c = 0; c < k; c++)
+      {
+        v_new[c].build(this->distribution_pt(), 0.0);
+        double* new_pt = v_new[c].values_pt();
+        for (unsigned l = 0; l < m; l++)
+        {
+          const double q_lc = q(l, c);
+          if (q_lc != 0.0)
+          {
+            const double* v_pt = v[l].values_pt();
+            for (unsigned r = 0; r < n_row; r++)
+            {
+              new_pt[r] += q_lc * v_pt[r];
+            }
+          }
+        }
+      }
+      for (unsigned c = 0; c < nblock; c++)
+      {
+        v[k + c] = v[m + c];
+      }
+      for (unsigned c = 0; c < k; c++)
+      {
+        v[c] = v_new[c];
+      }
+      t_orthogonalisation += TimingHelpers::timer() - t_orth_start;
+
+      // Continue expanding from the k-th column
+      j = k;
+      Nrestart++;
+    }
+
+    if (!converged)
+    {
+      std::ostringstream warning_stream;
+      warning_stream << "KrylovSchur eigensolver did not converge within "
+                     << Max_restarts << " restarts.\n"
+                     << "Returning the current approximations.\n";
+      OomphLibWarning(
+        warning_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+
+    // Recover the eigenvalues and eigenvectors of the original problem
+    double t_eigenvector_start = TimingHelpers::timer();
+    eigenvalue.resize(0);
+    eigenvector.resize(0);
+    const unsigned n_unit = wanted.size();
+    for (unsigned u = 0; u < n_unit; u++)
+    {
+      if (eigenvalue.size() >= nev) break;
+      const unsigned i = wanted[u];
+      const unsigned n_col = (theta[i].imag() != 0.0) ? 2 : 1;
+
+      // Undo the spectral transformation
+      std::complex<double> lambda = Sigma_real + 1.0 / theta[i];
+      eigenvalue.push_back(lambda);
+      if (n_col == 2)
+      {
+        eigenvalue.push_back(std::conj(lambda));
+      }
+
+      if (Compute_eigenvectors)
+      {
+        // x = V_m y (real and imaginary parts for complex pairs)
+        double norm_squared = 0.0;
+        for (unsigned col = i; col < i + n_col; col++)
+        {
+          DoubleVector x(this->distribution_pt(), 0.0);
+          double* x_pt = x.values_pt();
+          const unsigned n_row = x.nrow_local();
+          for (unsigned l = 0; l < m; l++)
+          {
+            const double y_l = y(l, col);
+            const double* v_pt = v[l].values_pt();
+            for (unsigned r = 0; r < n_row; r++)
+            {
+              x_pt[r] += y_l * v_pt[r];
+            }
+          }
+          double norm = x.norm();
+          norm_squared += norm * norm;
+          eigenvector.push_back(x);
+        }
+
+        // Normalise
+        const unsigned n_vec = eigenvector.size();
+        const double scale = 1.0 / std::sqrt(norm_squared);
+        for (unsigned col = n_vec - n_col; col < n_vec; col++)
+        {
+          double* x_pt = eigenvector[col].values_pt();
+          const unsigned n_row = eigenvector[col].nrow_local();
+          for (unsigned r = 0; r < n_row; r++)
+          {
+            x_pt[r] *= scale;
+          }
+        }
+      }
+    }
+    double t_eigenvector = TimingHelpers::timer() - t_eigenvector_start;
+
+    if (Doc_time)
+    {
+      oomph_info << "Time for assembly of eigenproblem matrices [sec]: "
+                 << t_assembly << std::endl;
+      if (Factorisation_was_reused)
+      {
+        oomph_info << "Re-used factorisation of shifted matrix (check "
+                   << "took " << t_factorisation << " sec; "
+                   << Nrefinement_iteration << " refinement steps)"
+                   << std::endl;
+      }
+      else
+      {
+        oomph_info << "Time for factorisation of shifted matrix [sec]: "
+                   << t_factorisation << std::endl;
+      }
+      oomph_info << "Time for " << Noperator_application
+                 << " applications of shift-invert operator [sec]: "
+                 << t_operator << std::endl;
+      oomph_info << "Time for orthogonalisation and basis updates [sec]: "
+                 << t_orthogonalisation << std::endl;
+      oomph_info << "Time for projected eigenproblems (" << Nrestart
+                 << " restarts) [sec]: " << t_projected << std::endl;
+      oomph_info << "Time for recovery of eigenvectors [sec]: "
+                 << t_eigenvector << std::endl;
+      oomph_info << "Total time for KrylovSchur eigensolver ( ndof = " << n
+                 << " ) [sec]: " << TimingHelpers::timer() - t_start
+                 << std::endl;
+    }
+  }
 } // namespace oomph
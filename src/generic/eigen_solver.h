@@ -250,6 +250,303 @@ namespace oomph
     void get_eigenvalues_right_of_shift() {}
   };
 
+
+  //=====================================================================
+  /// Native (block) Krylov-Schur eigensolver for the generalised
+  /// eigenproblem \f$ J x = \lambda M x \f$. Uses the shift-invert
+  /// operator \f$ (J - \sigma M)^{-1} M \f$ so the eigenvalues closest
+  /// to the shift \f$ \sigma \f$ are found first. The sparse
+  /// factorisation of \f$ J - \sigma M \f$ is retained by the linear
+  /// solver (which must therefore not be used for anything else
+  /// between calls) and re-used in subsequent calls if the shift and the
+  /// sparsity pattern of the shifted matrix are unchanged, e.g. when
+  /// computing further eigenvalues for the same state or during a
+  /// stability analysis in a parameter scan. Since the values of the
+  /// shifted matrix may have changed, the shift-invert operator is then
+  /// applied with iterative refinement; the matrix is re-factorised
+  /// if the refinement does not converge. If only the pattern is
+  /// unchanged, the symbolic factorisation (the column ordering) is
+  /// re-used by SuperLU.
+  //=====================================================================
+  class KrylovSchur : public EigenSolver
+  {
+  public:
+    /// Constructor: Set default values and create SuperLU as the
+    /// default linear solver
+    KrylovSchur();
+
+    /// Broken copy constructor
+    KrylovSchur(const KrylovSchur&) = delete;
+
+    /// Broken assignment operator
+    void operator=(const KrylovSchur&) = delete;
+
+    /// Destructor: Delete the default linear solver
+    virtual ~KrylovSchur();
+
+    /// Solve the eigenproblem. On return eigenvalue contains (at least)
+    /// n_eval eigenvalues, sorted by their distance from the shift.
+    /// As in ARPACK, complex conjugate pairs of eigenvalues occupy
+    /// consecutive entries and the corresponding eigenvector entries
+    /// contain the real and imaginary part of the eigenvector
+    /// belonging to the first eigenvalue in the pair.
+    void solve_eigenproblem(Problem* const& problem_pt,
+                            const int& n_eval,
+                            Vector<std::complex<double>>& eigenvalue,
+                            Vector<DoubleVector>& eigenvector);
+
+    /// Access function for the (maximum) dimension of the Krylov
+    /// subspace (rounded up to a multiple of the block size)
+    unsigned& nkrylov()
+    {
+      return NKrylov;
+    }
+
+    /// Access function for the block size, i.e. the number of vectors
+    /// to which the shift-invert operator is applied simultaneously
+    unsigned& block_size()
+    {
+      return Block_size;
+    }
+
+    /// Access function for the maximum number of restarts
+    unsigned& max_restarts()
+    {
+      return Max_restarts;
+    }
+
+    /// Access function for the convergence tolerance (for the relative
+    /// residual of the Ritz pairs of the shift-invert operator)
+    double& tolerance()
+    {
+      return Tolerance;
+    }
+
+    /// Number of restarts performed during the most recent solve
+    unsigned nrestart() const
+    {
+      return Nrestart;
+    }
+
+    /// Number of applications of the shift-invert operator (i.e. the
+    /// number of linear re-solves) during the most recent solve
+    unsigned noperator_application() const
+    {
+      return Noperator_application;
+    }
+
+    /// Enable the re-use of the factorisation of the shifted matrix
+    /// across calls (default)
+    void enable_factorisation_reuse()
+    {
+      Factorisation_reuse_is_enabled = true;
+    }
+
+    /// Disable the re-use of the factorisation of the shifted matrix
+    /// across calls. Also wipes any stored factorisation.
+    void disable_factorisation_reuse()
+    {
+      Factorisation_reuse_is_enabled = false;
+      clean_up_factorisation();
+    }
+
+    /// Wipe the stored factorisation so it is recomputed in the next call
+    void clean_up_factorisation();
+
+    /// Has the factorisation been re-used in the most recent solve?
+    bool factorisation_was_reused() const
+    {
+      return Factorisation_was_reused;
+    }
+
+    /// Has the symbolic factorisation been re-used when (re-)factorising
+    /// the shifted matrix in the most recent solve?
+    bool symbolic_factorisation_was_reused() const
+    {
+      return Symbolic_factorisation_was_reused;
+    }
+
+    /// Access function for the tolerance for the iterative refinement
+    /// (for the normwise backward error) with which the shift-invert
+    /// operator is applied if the factorisation is re-used
+    double& refinement_tolerance()
+    {
+      return Refinement_tolerance;
+    }
+
+    /// Access function for the maximum number of refinement steps per
+    /// application of the shift-invert operator before the shifted
+    /// matrix is re-factorised
+    unsigned& max_refinement_iterations()
+    {
+      return Max_refinement_iterations;
+    }
+
+    /// Number of refinement steps during the most recent solve
+    unsigned nrefinement_iteration() const
+    {
+      return Nrefinement_iteration;
+    }
+
+    /// Set to enable the computation of the eigenvectors (default)
+    void enable_compute_eigenvectors()
+    {
+      Compute_eigenvectors = true;
+    }
+
+    /// Set to disable the computation of the eigenvectors
+    void disable_compute_eigenvectors()
+    {
+      Compute_eigenvectors = false;
+    }
+
+    /// Enable documentation of the per-phase timings
+    void enable_doc_time()
+    {
+      Doc_time = true;
+    }
+
+    /// Disable documentation of the per-phase timings
+    void disable_doc_time()
+    {
+      Doc_time = false;
+    }
+
+    /// Return a pointer to the linear solver object
+    LinearSolver*& linear_solver_pt()
+    {
+      return Linear_solver_pt;
+    }
+
+    /// Return a pointer to the linear solver object (const version)
+    LinearSolver* const& linear_solver_pt() const
+    {
+      return Linear_solver_pt;
+    }
+
+  private:
+    /// Compute the eigenvalues theta and (real storage of the) right
+    /// eigenvectors of the n x n leading block of the dense matrix
+    /// h. Complex conjugate pairs are stored as in LAPACK: the
+    /// eigenvectors for the pair (i,i+1) are given by
+    /// y(:,i) +/- i y(:,i+1).
+    void eigen_decompose_projected_matrix(const DenseMatrix<double>& h,
+                                          const unsigned& n,
+                                          Vector<std::complex<double>>& theta,
+                                          DenseMatrix<double>& y);
+
+    /// Orthogonalise w against the first nbasis (orthonormal) vectors
+    /// in basis, using two passes of modified Gram-Schmidt. The
+    /// projection coefficients are added to coeff[0...nbasis-1];
+    /// returns the norm of the orthogonalised vector.
+    double orthogonalise(const Vector<DoubleVector>& basis,
+                         const unsigned& nbasis,
+                         DoubleVector& w,
+                         Vector<double>& coeff) const;
+
+    /// Fill w with (reproducible) pseudo-random entries, orthogonalise
+    /// it against the first nbasis vectors in basis and normalise it.
+    /// Used to start the iteration and to continue it if an invariant
+    /// subspace has been found.
+    void random_orthonormal_vector(const Vector<DoubleVector>& basis,
+                                   const unsigned& nbasis,
+                                   DoubleVector& w);
+
+    /// Checksum of the sparsity pattern of a CRDoubleMatrix, used
+    /// to decide if the stored factorisation can be re-used
+    unsigned long pattern_checksum(CRDoubleMatrix& matrix) const;
+
+    /// Factorise the shifted matrix (whose sparsity pattern has the
+    /// given checksum) and store the factorisation. Re-use the
+    /// symbolic factorisation of the stored factors if
+    /// reuse_symbolic_factorisation is true (and the linear solver
+    /// is SuperLU).
+    void factorise_shifted_matrix(CRDoubleMatrix& AsigmaM,
+                                  const unsigned long& matrix_pattern_checksum,
+                                  const bool& reuse_symbolic_factorisation);
+
+    /// Solve the shifted system with the stored factorisation. If
+    /// refine is true the factorisation may be that of a shifted matrix
+    /// with different values, so the solution is improved by iterative
+    /// refinement until its normwise backward error (computed with the
+    /// infinity norm a_norm of the shifted matrix) is below the
+    /// refinement tolerance. Returns false if the refinement fails to
+    /// converge.
+    bool solve_shifted_system(const CRDoubleMatrix& AsigmaM,
+                              const double& a_norm,
+                              const DoubleVector& rhs,
+                              DoubleVector& x,
+                              const bool& refine);
+
+    /// Pointer to the linear solver used for the shift-invert operator
+    LinearSolver* Linear_solver_pt;
+
+    /// Pointer to the default linear solver
+    LinearSolver* Default_linear_solver_pt;
+
+    /// Pointer to the linear solver that holds the stored factorisation
+    LinearSolver* Factorised_linear_solver_pt;
+
+    /// Maximum dimension of the Krylov subspace
+    unsigned NKrylov;
+
+    /// Block size
+    unsigned Block_size;
+
+    /// Maximum number of restarts
+    unsigned Max_restarts;
+
+    /// Convergence tolerance
+    double Tolerance;
+
+    /// Number of restarts performed during the most recent solve
+    unsigned Nrestart;
+
+    /// Number of applications of the shift-invert operator during the
+    /// most recent solve
+    unsigned Noperator_application;
+
+    /// Boolean to indicate whether or not to compute the eigenvectors
+    bool Compute_eigenvectors;
+
+    /// Flag to indicate that the factorisation may be re-used
+    bool Factorisation_reuse_is_enabled;
+
+    /// Flag to indicate that the linear solver currently stores a
+    /// factorisation of the shifted matrix
+    bool Factorisation_is_stored;
+
+    /// Flag to indicate that the factorisation was re-used in the
+    /// most recent solve
+    bool Factorisation_was_reused;
+
+    /// Flag to indicate that the symbolic factorisation was re-used
+    /// in the most recent solve
+    bool Symbolic_factorisation_was_reused;
+
+    /// Tolerance for the iterative refinement
+    double Refinement_tolerance;
+
+    /// Maximum number of refinement steps per operator application
+    unsigned Max_refinement_iterations;
+
+    /// Number of refinement steps during the most recent solve
+    unsigned Nrefinement_iteration;
+
+    /// Shift for which the stored factorisation was computed
+    double Stored_sigma;
+
+    /// Checksum of the sparsity pattern of the shifted matrix for which
+    /// the stored factorisation was computed
+    unsigned long Stored_pattern_checksum;
+
+    /// Flag to indicate if the per-phase timings are to be documented
+    bool Doc_time;
+
+    /// State of the pseudo-random number generator for the start vectors
+    unsigned long Random_seed;
+  };
+
 } // namespace oomph
 
 #endif
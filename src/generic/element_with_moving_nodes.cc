@@ -531,7 +531,9 @@ namespace oomph
 
   //======================================================================
   /// Compute derivatives of the nodal coordinates w.r.t.
-  /// to the geometric dofs. Default implementation by FD can be overwritten
+  /// to the geometric dofs. Default implementation assembles the
+  /// sensitivities provided by the shape-controlling nodes (see
+  /// Node::get_dposition_dgeom_data(...)); can be overwritten
   /// for specific elements.
   /// dnodal_coordinates_dgeom_dofs(l,i,j) = dX_{ij} / d s_l
   //======================================================================
@@ -556,19 +558,8 @@ namespace oomph
     // Get dimension from first node
     unsigned dim_nod = node_pt(0)->ndim();
 
-    // Number of shape controlling nodes for nonrefineable elements
-    unsigned n_shape_controlling_node = n_nod;
-
     // Are we dealing with a refineable element?
     RefineableElement* ref_el_pt = dynamic_cast<RefineableElement*>(this);
-    if (ref_el_pt != 0)
-    {
-      // Adjust number of shape controlling nodes
-      n_shape_controlling_node = ref_el_pt->nshape_controlling_nodes();
-    }
-
-    // Current and advanced nodal positions
-    DenseMatrix<double> pos(dim_nod, n_shape_controlling_node);
 
     // Shape controlling nodes
     std::map<Node*, unsigned> local_shape_controlling_node_lookup;
@@ -590,7 +581,17 @@ namespace oomph
       }
     }
 
-    // Loop over all shape-controlling nodes to backup their original position
+    // Lookup scheme for the index of the geometric Data in the element
+    std::map<Data*, unsigned> geom_data_index;
+    for (unsigned i = 0; i < n_geometric_data; i++)
+    {
+      geom_data_index[Geom_data_pt[i]] = i;
+    }
+
+    // Loop over all shape-controlling nodes and get the sensitivities of
+    // their positions w.r.t. the Data that affect their node update (either
+    // analytically or by finite differencing the update of the node itself)
+    std::map<Data*, DenseMatrix<double>> dposition_dgeom_data;
     for (std::map<Node*, unsigned>::iterator it =
            local_shape_controlling_node_lookup.begin();
          it != local_shape_controlling_node_lookup.end();
@@ -602,74 +603,45 @@ namespace oomph
       // Get its number
       unsigned node_number = it->second;
 
-      // Backup
-      for (unsigned i = 0; i < dim_nod; i++)
-      {
-        pos(i, node_number) = nod_pt->position(i);
-      }
-    }
-
-
-    // Integer storage for the local unknown
-    int local_unknown = 0;
+      // Get the sensitivities
+      nod_pt->get_dposition_dgeom_data(dposition_dgeom_data);
 
-    // Use the default finite difference step
-    const double fd_step = GeneralisedElement::Default_fd_jacobian_step;
-
-    // Loop over the Data items that affect the node update operations
-    for (unsigned i = 0; i < n_geometric_data; i++)
-    {
-      // Loop over values
-      unsigned n_value = Geom_data_pt[i]->nvalue();
-      for (unsigned j = 0; j < n_value; j++)
+      // Copy them into the element's storage
+      for (std::map<Data*, DenseMatrix<double>>::iterator it_data =
+             dposition_dgeom_data.begin();
+           it_data != dposition_dgeom_data.end();
+           it_data++)
       {
-        local_unknown = geometric_data_local_eqn(i, j);
+        std::map<Data*, unsigned>::iterator it_index =
+          geom_data_index.find(it_data->first);
 
-        // If the value is free
-        if (local_unknown >= 0)
+#ifdef PARANOID
+        if (it_index == geom_data_index.end())
         {
-          // Get a pointer to the geometric data value
-          double* value_pt = Geom_data_pt[i]->value_pt(j);
-
-          // Save the old value
-          double old_var = *value_pt;
-
-          // Increment the variable
-          *value_pt += fd_step;
-
-          // Update the whole element
-          this->node_update();
+          throw OomphLibError(
+            "Node depends on geometric Data that isn't stored in element",
+            OOMPH_CURRENT_FUNCTION,
+            OOMPH_EXCEPTION_LOCATION);
+        }
+#endif
 
-          // Loop over all shape-controlling nodes
-          for (std::map<Node*, unsigned>::iterator it =
-                 local_shape_controlling_node_lookup.begin();
-               it != local_shape_controlling_node_lookup.end();
-               it++)
+        DenseMatrix<double>& dx_ddata = it_data->second;
+        unsigned n_value = dx_ddata.ncol();
+        for (unsigned j = 0; j < n_value; j++)
+        {
+          // If the value is free
+          int local_unknown = geometric_data_local_eqn(it_index->second, j);
+          if (local_unknown >= 0)
           {
-            // Get node
-            Node* nod_pt = it->first;
-
-            // Get its number
-            unsigned node_number = it->second;
-
-            // Get advanced position and FD
             for (unsigned ii = 0; ii < dim_nod; ii++)
             {
               dnodal_coordinates_dgeom_dofs(local_unknown, ii, node_number) =
-                (nod_pt->position(ii) - pos(ii, node_number)) / fd_step;
+                dx_ddata(ii, j);
             }
           }
-
-          // Reset the variable
-          *value_pt = old_var;
-
-          // We're relying on the total node update in the next loop
         }
       }
     }
-    // Node update the element one final time to get things back to
-    // the original state
-    this->node_update();
   }
 
 } // namespace oomph
@@ -291,7 +291,9 @@ namespace oomph
 
   protected:
     /// Compute derivatives of the nodal coordinates w.r.t.
-    /// to the geometric dofs. Default implementation by FD can be overwritten
+    /// to the geometric dofs. Default implementation assembles the
+    /// sensitivities provided by the shape-controlling nodes (see
+    /// Node::get_dposition_dgeom_data(...)); can be overwritten
     /// for specific elements.
     /// dnodal_coordinates_dgeom_dofs(l,i,j) = dX_{ij} / d s_l
     virtual void get_dnodal_coordinates_dgeom_dofs(
@@ -1596,6 +1596,41 @@ namespace oomph
   }
 
 
+  //==========================================================================
+  /// Number of bytes held by the element's lookup schemes and by its
+  /// internal data
+  //==========================================================================
+  double GeneralisedElement::memory_usage_in_bytes() const
+  {
+    double nbyte = sizeof(GeneralisedElement);
+
+    // Global equation numbers and (if stored) pointers to the dofs
+    nbyte += double(Ndof) * sizeof(unsigned long);
+    if (Dof_pt != 0)
+    {
+      nbyte += double(Ndof) * sizeof(double*);
+    }
+
+    // Pointers to the internal and external data, their local equation
+    // numbers and the internal data themselves
+    const unsigned n_total_data = Ninternal_data + Nexternal_data;
+    nbyte += double(n_total_data) * sizeof(Data*);
+    if (Data_local_eqn != 0)
+    {
+      nbyte += double(n_total_data) * sizeof(int*);
+      for (unsigned i = 0; i < n_total_data; i++)
+      {
+        nbyte += double(Data_pt[i]->nvalue()) * sizeof(int);
+      }
+    }
+    for (unsigned i = 0; i < Ninternal_data; i++)
+    {
+      nbyte += Data_pt[i]->memory_usage_in_bytes();
+    }
+    return nbyte;
+  }
+
+
   //==========================================================================
   /// Self-test: Have all internal values been classified as
   /// pinned/unpinned? Return 0 if OK.
@@ -4436,6 +4471,32 @@ namespace oomph
     }
   }
 
+  //==========================================================================
+  /// Number of bytes held by the element, including the pointers to
+  /// the nodes and the local equation numbers of the nodal values
+  //==========================================================================
+  double FiniteElement::memory_usage_in_bytes() const
+  {
+    double nbyte = GeneralisedElement::memory_usage_in_bytes() +
+                   sizeof(FiniteElement) - sizeof(GeneralisedElement);
+
+    const unsigned n_node = Nnode;
+    nbyte += double(n_node) * sizeof(Node*);
+    if (Nodal_local_eqn != 0)
+    {
+      nbyte += double(n_node) * sizeof(int*);
+      for (unsigned n = 0; n < n_node; n++)
+      {
+        if (Node_pt[n] != 0)
+        {
+          nbyte += double(Node_pt[n]->nvalue()) * sizeof(int);
+        }
+      }
+    }
+    return nbyte;
+  }
+
+
   //==========================================================================
   /// Self-test: Have all internal values been classified as
   /// pinned/unpinned? Has pointer to spatial integration scheme
@@ -5069,6 +5130,124 @@ namespace oomph
   }
 
 
+  //=======================================================================
+  /// Return the values of the i-th scalar field at the plot points in
+  /// numerical form. Default implementation: redirect the ascii output of
+  /// scalar_value_paraview(...) into an in-memory buffer (written with
+  /// full precision) and parse it.
+  //=======================================================================
+  void FiniteElement::scalar_values_paraview(const unsigned& i,
+                                             const unsigned& nplot,
+                                             Vector<double>& values) const
+  {
+    // Redirect an ofstream to a string buffer
+    std::stringbuf buffer;
+    std::ofstream capture_stream;
+    capture_stream.std::ios::rdbuf(&buffer);
+    capture_stream.precision(17);
+
+    // Write the values (the element's own scalar_value_paraview(...)
+    // does all the work)
+    scalar_value_paraview(capture_stream, i, nplot);
+
+    // ...and read them back
+    values.clear();
+    values.reserve(nplot_points_paraview(nplot));
+    std::istringstream parse_stream(buffer.str());
+    double value = 0.0;
+    while (parse_stream >> value)
+    {
+      values.push_back(value);
+    }
+
+#ifdef PARANOID
+    if (values.size() != nplot_points_paraview(nplot))
+    {
+      std::ostringstream error_stream;
+      error_stream << "Got " << values.size() << " values for scalar " << i
+                   << " but the element has " << nplot_points_paraview(nplot)
+                   << " plot points.\n"
+                   << "Does scalar_value_paraview(...) write something "
+                   << "that isn't a number?\n";
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+  }
+
+
+  //=======================================================================
+  /// Return the cells of the paraview sub-elements in numerical form.
+  /// Default implementation: redirect the ascii output of the
+  /// write_paraview_*(...) functions into an in-memory buffer and parse it.
+  //=======================================================================
+  void FiniteElement::paraview_cells(const unsigned& nplot,
+                                     Vector<int>& connectivity,
+                                     Vector<int>& offsets,
+                                     Vector<int>& types) const
+  {
+    // Redirect an ofstream to a string buffer
+    std::stringbuf buffer;
+    std::ofstream capture_stream;
+    capture_stream.std::ios::rdbuf(&buffer);
+
+    // Connectivity, relative to our own plot points
+    unsigned counter = 0;
+    write_paraview_output_offset_information(capture_stream, nplot, counter);
+    connectivity.clear();
+    {
+      std::istringstream parse_stream(buffer.str());
+      int entry = 0;
+      while (parse_stream >> entry)
+      {
+        connectivity.push_back(entry);
+      }
+    }
+
+    // Offsets, relative to the start of our own connectivity
+    buffer.str("");
+    unsigned offset_sum = 0;
+    write_paraview_offsets(capture_stream, nplot, offset_sum);
+    offsets.clear();
+    {
+      std::istringstream parse_stream(buffer.str());
+      int entry = 0;
+      while (parse_stream >> entry)
+      {
+        offsets.push_back(entry);
+      }
+    }
+
+    // Cell types
+    buffer.str("");
+    write_paraview_type(capture_stream, nplot);
+    types.clear();
+    {
+      std::istringstream parse_stream(buffer.str());
+      int entry = 0;
+      while (parse_stream >> entry)
+      {
+        types.push_back(entry);
+      }
+    }
+
+#ifdef PARANOID
+    unsigned nsub = nsub_elements_paraview(nplot);
+    if ((offsets.size() != nsub) || (types.size() != nsub) ||
+        ((nsub > 0) && (unsigned(offsets[nsub - 1]) != connectivity.size())))
+    {
+      std::ostringstream error_stream;
+      error_stream << "Inconsistent paraview cell information: element has "
+                   << nsub << " sub-elements but provided " << offsets.size()
+                   << " offsets, " << types.size() << " types and "
+                   << connectivity.size() << " connectivity entries.\n";
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+  }
+
+
   //=======================================================================
   /// Loop over all nodes in the element and update their positions
   /// using each node's (algebraic) update function
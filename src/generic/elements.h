@@ -1117,6 +1117,12 @@ namespace oomph
     }
 
 
+    /// Number of bytes held by the element's lookup schemes (global
+    /// and local equation numbers, pointers to its data) and by its
+    /// internal data. The storage allocated by derived classes is not
+    /// included (apart from their part of the object itself).
+    virtual double memory_usage_in_bytes() const;
+
     /// Self-test: Have all internal values been classified as
     /// pinned/unpinned? Return 0 if OK.
     virtual unsigned self_test();
@@ -3050,6 +3056,33 @@ namespace oomph
       return "V" + StringConversion::to_string(i);
     }
 
+    /// Return the values of the i-th scalar field at the plot points
+    /// (in the order used by scalar_value_paraview(...)) in numerical
+    /// form, for use by the binary paraview output. Should be overloaded
+    /// to compute the values directly (as in the Poisson,
+    /// advection-diffusion and Navier-Stokes elements). The default
+    /// implementation is a (slow) fallback for elements that only
+    /// implement scalar_value_paraview(...): it captures its output in
+    /// memory and parses it.
+    virtual void scalar_values_paraview(const unsigned& i,
+                                        const unsigned& nplot,
+                                        Vector<double>& values) const;
+
+    /// Return the cells of the paraview sub-elements in numerical form,
+    /// for use by the binary paraview output: connectivity (in terms of
+    /// the element's own plot points, i.e. numbered from zero), the
+    /// cumulative offsets into the connectivity (also starting from zero)
+    /// and the VTK cell types. Overloaded to compute these directly in
+    /// the QElements and TElements. The default implementation is a
+    /// (slow) fallback for other geometric elements: it captures the
+    /// output of write_paraview_output_offset_information(...),
+    /// write_paraview_offsets(...) and write_paraview_type(...) in memory
+    /// and parses it.
+    virtual void paraview_cells(const unsigned& nplot,
+                                Vector<int>& connectivity,
+                                Vector<int>& offsets,
+                                Vector<int>& types) const;
+
     /// Output the element data --- typically the values at the
     /// nodes in a format suitable for post-processing.
     virtual void output(std::ostream& outfile)
@@ -3369,6 +3402,12 @@ namespace oomph
                                     FaceElement* face_element_pt);
 
 
+    /// Number of bytes held by the element: that held by the
+    /// GeneralisedElement, plus the pointers to the nodes and the local
+    /// equation numbers of the nodal values (the nodes themselves are
+    /// held by the mesh).
+    double memory_usage_in_bytes() const;
+
     /// Self-test: Check inversion of element & do self-test for
     /// GeneralisedElement. Return 0 if OK.
     virtual unsigned self_test();
@@ -148,6 +148,56 @@ namespace oomph
       // preconditioners you give it and requires new ones each time!
       this->Subsidiary_preconditioner_pt.clear();
     }
+    // If using shared memory parallelisation, extract all the blocks and
+    // set up their preconditioners concurrently
+    else if (this->use_concurrent_subsidiary_preconditioners())
+    {
+      Vector<CRDoubleMatrix*> block_diagonal_matrix_pt(nblock_types, 0);
+      for (unsigned i = 0; i < nblock_types; i++)
+      {
+        // Allocate space for the new matrix
+        block_diagonal_matrix_pt[i] = new CRDoubleMatrix;
+
+        // Get the start time
+        double t_extract_start = TimingHelpers::timer();
+
+        // Extract the i-th block
+        this->get_block(
+          i, get_other_diag_ds(i, nblock_types), *block_diagonal_matrix_pt[i]);
+
+        // Get the end time
+        double t_extract_end = TimingHelpers::timer();
+
+        // Update the timing total
+        t_extraction_total += (t_extract_end - t_extract_start);
+      }
+
+      // Get the start time
+      double t_subsidiary_setup_start = TimingHelpers::timer();
+
+      // Set up the preconditioners
+      this->setup_subsidiary_preconditioners_concurrently(
+        block_diagonal_matrix_pt);
+
+      // Get the end time
+      double t_subsidiary_setup_end = TimingHelpers::timer();
+
+      // Update the timing total
+      t_subsidiary_setup_total +=
+        (t_subsidiary_setup_end - t_subsidiary_setup_start);
+
+      for (unsigned i = 0; i < nblock_types; i++)
+      {
+        // Tell the user
+        oomph_info << "Took "
+                   << this->Shared_memory_preconditioner_array.setup_time(i)
+                   << "s to setup." << std::endl;
+
+        // and delete the block
+        delete block_diagonal_matrix_pt[i];
+        block_diagonal_matrix_pt[i] = 0;
+      }
+    }
     // Otherwise just set up each block's preconditioner in order
     else
     {
@@ -231,6 +281,25 @@ namespace oomph
     {
       Preconditioner_array_pt->solve_preconditioners(block_r, block_z);
     }
+    else if (this->use_concurrent_subsidiary_preconditioners())
+    {
+      double t_start = 0.0;
+      if (Doc_time_during_preconditioner_solve)
+      {
+        t_start = TimingHelpers::timer();
+      }
+
+      // solve the diagonal blocks concurrently
+      this->Shared_memory_preconditioner_array.solve_preconditioners(block_r,
+                                                                     block_z);
+
+      if (Doc_time_during_preconditioner_solve)
+      {
+        oomph_info << "Time for concurrent application of the block "
+                   << "preconditioners: " << TimingHelpers::timer() - t_start
+                   << std::endl;
+      }
+    }
     else
     {
       // solve each diagonal block
@@ -349,10 +418,58 @@ namespace oomph
     // The total time for setting up the matrix-vector products
     double t_mvp_setup_total = 0.0;
 
+    // Set up the preconditioners for the diagonal blocks concurrently if
+    // required (they are independent of each other)
+    bool concurrent_setup = this->use_concurrent_subsidiary_preconditioners();
+    if (concurrent_setup)
+    {
+      Vector<CRDoubleMatrix*> block_diagonal_matrix_pt(nblock_types, 0);
+      for (unsigned i = 0; i < nblock_types; i++)
+      {
+        // Allocate space for the new matrix
+        block_diagonal_matrix_pt[i] = new CRDoubleMatrix;
+
+        // Get the start time
+        double t_extract_start = TimingHelpers::timer();
+
+        // Grab the i-th diagonal block
+        this->get_block(i, i, *block_diagonal_matrix_pt[i]);
+
+        // Get the end time
+        double t_extract_end = TimingHelpers::timer();
+
+        // Update the timing total
+        t_extraction_total += (t_extract_end - t_extract_start);
+      }
+
+      // Get the start time
+      double t_subsidiary_setup_start = TimingHelpers::timer();
+
+      // Set up the preconditioners
+      this->setup_subsidiary_preconditioners_concurrently(
+        block_diagonal_matrix_pt);
+
+      // Get the end time
+      double t_subsidiary_setup_end = TimingHelpers::timer();
+
+      // Update the timing total
+      t_subsidiary_setup_total +=
+        (t_subsidiary_setup_end - t_subsidiary_setup_start);
+
+      // Delete the blocks
+      for (unsigned i = 0; i < nblock_types; i++)
+      {
+        delete block_diagonal_matrix_pt[i];
+        block_diagonal_matrix_pt[i] = 0;
+      }
+    }
+
     // build the preconditioners and matrix vector products
     for (unsigned i = 0; i < nblock_types; i++)
     {
-      // Get the block and set up the preconditioner.
+      // Get the block and set up the preconditioner (unless this has
+      // already been done concurrently).
+      if (!concurrent_setup)
       {
         // Get the start time
         double t_extract_start = TimingHelpers::timer();
@@ -87,7 +87,8 @@ namespace oomph
     GeneralPurposeBlockPreconditioner()
       : BlockPreconditioner<MATRIX>(),
         Subsidiary_preconditioner_creation_function_pt(
-          &PreconditionerCreationFunctions::create_super_lu_preconditioner)
+          &PreconditionerCreationFunctions::create_super_lu_preconditioner),
+        Use_shared_memory_parallelisation(false)
     {
       // Make sure that the Gp_mesh_pt container is size zero.
       Gp_mesh_pt.resize(0);
@@ -121,10 +122,33 @@ namespace oomph
         }
       }
 
+      // Forget about the preconditioners in the shared memory array
+      Shared_memory_preconditioner_array.clean_up_memory();
+
       // Clean up the block preconditioner base class stuff
       this->clear_block_preconditioner_base();
     }
 
+    /// Add the memory held by the block preconditioner base class and
+    /// by the subsidiary preconditioners (whose categories are prefixed
+    /// by "subsidiary:") to the account
+    virtual void get_memory_usage(MemoryAccount& account)
+    {
+      BlockPreconditioner<MATRIX>::get_memory_usage(account);
+
+      MemoryAccount subsidiary_account;
+      for (unsigned j = 0, nj = Subsidiary_preconditioner_pt.size(); j < nj;
+           j++)
+      {
+        if (Subsidiary_preconditioner_pt[j] != 0)
+        {
+          Subsidiary_preconditioner_pt[j]->get_memory_usage(
+            subsidiary_account);
+        }
+      }
+      account.add(subsidiary_account, "subsidiary:");
+    }
+
     /// Broken copy constructor
     GeneralPurposeBlockPreconditioner(
       const GeneralPurposeBlockPreconditioner&) = delete;
@@ -171,6 +195,26 @@ namespace oomph
       Subsidiary_preconditioner_pt[i] = prec;
     }
 
+    /// Set up (and, where the block structure allows, apply) the
+    /// subsidiary preconditioners concurrently, each on its own group of
+    /// threads (see SharedMemoryPreconditionerArray). If the library is
+    /// compiled without OpenMP they are processed one after the other.
+    /// NOTE: The default subsidiary preconditioner (SuperLU) serialises
+    /// its factorisations, so only the back-substitutions benefit; use
+    /// subsidiary preconditioners whose setup is thread-safe (e.g. the
+    /// ILU or AMG-type preconditioners) to set up the blocks concurrently.
+    void enable_shared_memory_parallelisation()
+    {
+      Use_shared_memory_parallelisation = true;
+    }
+
+    /// Set up and apply the subsidiary preconditioners one after the
+    /// other (default)
+    void disable_shared_memory_parallelisation()
+    {
+      Use_shared_memory_parallelisation = false;
+    }
+
     /// Get the subsidiary precondtioner pointer in block i (is
     /// allowed to be null if not yet set).
     Preconditioner* subsidiary_preconditioner_pt(const unsigned& i) const
@@ -290,15 +334,52 @@ namespace oomph
       }
     }
 
+    /// Are the subsidiary preconditioners to be processed concurrently?
+    /// This requires shared memory parallelisation to be enabled and all
+    /// subsidiary preconditioners to be independent of this one (i.e. none
+    /// of them may be a block preconditioner since these operate on the
+    /// full vectors).
+    bool use_concurrent_subsidiary_preconditioners() const
+    {
+      if (!Use_shared_memory_parallelisation) return false;
+      for (unsigned j = 0, nj = Subsidiary_preconditioner_pt.size(); j < nj;
+           j++)
+      {
+        if (dynamic_cast<BlockPreconditioner<CRDoubleMatrix>*>(
+              Subsidiary_preconditioner_pt[j]) != 0)
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /// Set up the subsidiary preconditioners for the given blocks
+    /// concurrently
+    void setup_subsidiary_preconditioners_concurrently(
+      const Vector<CRDoubleMatrix*>& block_matrix_pt)
+    {
+      Shared_memory_preconditioner_array.setup_preconditioners(
+        block_matrix_pt, Subsidiary_preconditioner_pt);
+    }
+
     /// List of preconditioners to use for the blocks to be solved.
     Vector<Preconditioner*> Subsidiary_preconditioner_pt;
 
+    /// The array that sets up and applies the subsidiary preconditioners
+    /// concurrently (if shared memory parallelisation is enabled)
+    SharedMemoryPreconditionerArray Shared_memory_preconditioner_array;
+
     /// Function to create any subsidiary preconditioners not set in
     /// Subsidiary_preconditioner_pt.
     SubsidiaryPreconditionerFctPt
       Subsidiary_preconditioner_creation_function_pt;
 
   private:
+    /// Use shared memory parallelisation for the subsidiary
+    /// preconditioners?
+    bool Use_shared_memory_parallelisation;
+
     /// the set of dof to block maps for this preconditioner
     Vector<unsigned> Dof_to_block_map;
 
@@ -313,7 +394,10 @@ namespace oomph
   /// the subsidiary systems, but other preconditioners can be used by setting
   /// them using passing a pointer to a function of type
   /// SubsidiaryPreconditionerFctPt to the method
-  /// subsidiary_preconditioner_function_pt().
+  /// subsidiary_preconditioner_function_pt(). The independent subsidiary
+  /// systems can be set up and solved concurrently, either on
+  /// subsets of processors (two-level parallelisation, requires MPI) or on
+  /// groups of threads (shared memory parallelisation).
   //=============================================================================
   template<typename MATRIX>
   class BlockDiagonalPreconditioner
@@ -373,6 +457,7 @@ namespace oomph
                           OOMPH_EXCEPTION_LOCATION);
 #endif
       Use_two_level_parallelisation = true;
+      this->disable_shared_memory_parallelisation();
     }
 
     /// Don't use two-level parallelisation
@@ -381,6 +466,15 @@ namespace oomph
       Use_two_level_parallelisation = false;
     }
 
+    /// Set up and apply the subsidiary preconditioners concurrently on
+    /// groups of threads (instead of using two-level parallelisation)
+    void enable_shared_memory_parallelisation()
+    {
+      GeneralPurposeBlockPreconditioner<
+        MATRIX>::enable_shared_memory_parallelisation();
+      Use_two_level_parallelisation = false;
+    }
+
     /// Enable Doc timings in application of block sub-preconditioners
     void enable_doc_time_during_preconditioner_solve()
     {
@@ -451,7 +545,10 @@ namespace oomph
   /// solve the subsidiary systems, but other preconditioners can be used by
   /// setting them using passing a pointer to a function of type
   /// SubsidiaryPreconditionerFctPt to the method
-  /// subsidiary_preconditioner_function_pt().
+  /// subsidiary_preconditioner_function_pt(). With shared memory
+  /// parallelisation the subsidiary preconditioners are set up concurrently;
+  /// they are always applied one after the other since each block solve
+  /// depends on the previous ones.
   //=============================================================================
   template<typename MATRIX>
   class BlockTriangularPreconditioner
@@ -32,6 +32,12 @@
 // oomph-lib includes
 #include "general_purpose_preconditioners.h"
 
+#include <queue>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 namespace oomph
 {
@@ -108,6 +114,18 @@ namespace oomph
       LinearAlgebraDistribution dist(comm_pt(), n_row, false);
       this->build_distribution(dist);
     }
+
+    // Copy the inverse diagonal entries into single precision storage
+    // (and release the double precision ones) if required
+    if (Use_single_precision_storage)
+    {
+      Single_precision_inv_diag.assign(Inv_diag.begin(), Inv_diag.end());
+      Vector<double>().swap(Inv_diag);
+    }
+    else
+    {
+      Single_precision_inv_diag.clear();
+    }
   }
 
 
@@ -154,9 +172,19 @@ namespace oomph
     const double* r_values = r.values_pt();
     double* z_values = z.values_pt();
     unsigned nrow_local = this->nrow_local();
-    for (unsigned i = 0; i < nrow_local; i++)
+    if (Single_precision_inv_diag.size() > 0)
     {
-      z_values[i] = Inv_diag[i] * r_values[i];
+      for (unsigned i = 0; i < nrow_local; i++)
+      {
+        z_values[i] = Single_precision_inv_diag[i] * r_values[i];
+      }
+    }
+    else
+    {
+      for (unsigned i = 0; i < nrow_local; i++)
+      {
+        z_values[i] = Inv_diag[i] * r_values[i];
+      }
     }
   }
 
@@ -243,7 +271,7 @@ namespace oomph
     }
 
     // get the matrix
-    int* m_row_start = cr_matrix_pt->row_start();
+    SparseOffset* m_row_start = cr_matrix_pt->row_start();
     double* m_value = cr_matrix_pt->value();
 
     // intially set positive matrix to true
@@ -253,7 +281,7 @@ namespace oomph
     for (unsigned i = 0; i < Nrow; i++)
     {
       Inv_lumped_diag_pt[i] = 0.0;
-      for (int j = m_row_start[i]; j < m_row_start[i + 1]; j++)
+      for (SparseOffset j = m_row_start[i]; j < m_row_start[i + 1]; j++)
       {
         // if the matrix contains negative coefficient the matrix not positive
         if (m_value[j] < 0.0)
@@ -346,11 +374,11 @@ namespace oomph
     this->build_distribution(dist);
 
     // declares variables to store number of non zero entires in L and U
-    int l_nz = 0;
-    int u_nz = 0;
+    SparseOffset l_nz = 0;
+    SparseOffset u_nz = 0;
 
     // create space for m matrix
-    int* m_column_start;
+    SparseOffset* m_column_start;
     int* m_row_index;
     double* m_value;
 
@@ -362,7 +390,7 @@ namespace oomph
     // find number non zero entries in L and U
     for (int i = 0; i < n_row; i++)
     {
-      for (int j = m_column_start[i]; j < m_column_start[i + 1]; j++)
+      for (SparseOffset j = m_column_start[i]; j < m_column_start[i + 1]; j++)
       {
         if (m_row_index[j] > i)
         {
@@ -393,17 +421,17 @@ namespace oomph
     {
       L_column_start[i + 1] = L_column_start[i];
       U_column_start[i + 1] = U_column_start[i];
-      for (int j = m_column_start[i]; j < m_column_start[i + 1]; j++)
+      for (SparseOffset j = m_column_start[i]; j < m_column_start[i + 1]; j++)
       {
         if (m_row_index[j] > i)
         {
-          int k = L_column_start[i + 1]++;
+          SparseOffset k = L_column_start[i + 1]++;
           L_row_entry[k].index() = m_row_index[j];
           L_row_entry[k].value() = m_value[j];
         }
         else
         {
-          int k = U_column_start[i + 1]++;
+          SparseOffset k = U_column_start[i + 1]++;
           U_row_entry[k].index() = m_row_index[j];
           U_row_entry[k].value() = m_value[j];
         }
@@ -427,7 +455,7 @@ namespace oomph
 
     // factorise matrix
     int i;
-    unsigned j, pn, qn, rn;
+    SparseOffset j, pn, qn, rn;
     pn = 0;
     qn = 0;
     rn = 0;
@@ -465,6 +493,23 @@ namespace oomph
         }
       }
     }
+
+    // Copy the factors into single precision storage (and release the
+    // double precision ones) if required
+    if (Use_single_precision_storage)
+    {
+      Single_precision_L_row_entry.assign(L_row_entry.begin(),
+                                          L_row_entry.end());
+      Single_precision_U_row_entry.assign(U_row_entry.begin(),
+                                          U_row_entry.end());
+      Vector<CompressedMatrixCoefficient>().swap(L_row_entry);
+      Vector<CompressedMatrixCoefficient>().swap(U_row_entry);
+    }
+    else
+    {
+      Single_precision_L_row_entry.clear();
+      Single_precision_U_row_entry.clear();
+    }
   }
 
 
@@ -507,11 +552,11 @@ namespace oomph
     int n_row = cr_matrix_pt->nrow();
 
     // declares variables to store number of non zero entires in L and U
-    int l_nz = 0;
-    int u_nz = 0;
+    SparseOffset l_nz = 0;
+    SparseOffset u_nz = 0;
 
     // create space for m matrix
-    int* m_row_start;
+    SparseOffset* m_row_start;
     int* m_column_index;
     double* m_value;
 
@@ -523,7 +568,7 @@ namespace oomph
     // find number non zero entries in L and U
     for (int i = 0; i < n_row; i++)
     {
-      for (int j = m_row_start[i]; j < m_row_start[i + 1]; j++)
+      for (SparseOffset j = m_row_start[i]; j < m_row_start[i + 1]; j++)
       {
         if (m_column_index[j] < i)
         {
@@ -554,17 +599,17 @@ namespace oomph
     {
       L_row_start[i + 1] = L_row_start[i];
       U_row_start[i + 1] = U_row_start[i];
-      for (int j = m_row_start[i]; j < m_row_start[i + 1]; j++)
+      for (SparseOffset j = m_row_start[i]; j < m_row_start[i + 1]; j++)
       {
         if (m_column_index[j] < i)
         {
-          int k = L_row_start[i + 1]++;
+          SparseOffset k = L_row_start[i + 1]++;
           L_row_entry[k].value() = m_value[j];
           L_row_entry[k].index() = m_column_index[j];
         }
         else
         {
-          int k = U_row_start[i + 1]++;
+          SparseOffset k = U_row_start[i + 1]++;
           U_row_entry[k].value() = m_value[j];
           U_row_entry[k].index() = m_column_index[j];
         }
@@ -573,7 +618,8 @@ namespace oomph
 
 
     // factorise matrix
-    unsigned i, j, pn, qn, rn;
+    unsigned i;
+    SparseOffset j, pn, qn, rn;
     pn = 0;
     qn = 0;
     rn = 0;
@@ -609,6 +655,23 @@ namespace oomph
       }
     }
 
+    // Copy the factors into single precision storage (and release the
+    // double precision ones) if required
+    if (Use_single_precision_storage)
+    {
+      Single_precision_L_row_entry.assign(L_row_entry.begin(),
+                                          L_row_entry.end());
+      Single_precision_U_row_entry.assign(U_row_entry.begin(),
+                                          U_row_entry.end());
+      Vector<CompressedMatrixCoefficient>().swap(L_row_entry);
+      Vector<CompressedMatrixCoefficient>().swap(U_row_entry);
+    }
+    else
+    {
+      Single_precision_L_row_entry.clear();
+      Single_precision_U_row_entry.clear();
+    }
+
     // if we built the global matrix then delete it
     if (built_global)
     {
@@ -617,6 +680,47 @@ namespace oomph
   }
 
 
+  //=============================================================================
+  /// Helper for the ILU(0) preconditioner for CCDoubleMatrix: Solve Ly=r
+  /// then Uz=y for the factors stored in the given vectors of (single or
+  /// double precision) coefficients. On entry z contains r.
+  //=============================================================================
+  template<class COEFFICIENT>
+  void ILUZeroPreconditioner<CCDoubleMatrix>::substitute(
+    const Vector<COEFFICIENT>& l_row_entry,
+    const Vector<COEFFICIENT>& u_row_entry,
+    DoubleVector& z) const
+  {
+    // # of rows in the matrix
+    int n_row = z.nrow();
+
+    // solve Ly=r (note L matrix is unit and diagonal is not stored)
+    for (unsigned i = 0; i < static_cast<unsigned>(n_row); i++)
+    {
+      for (SparseOffset j = L_column_start[i]; j < L_column_start[i + 1]; j++)
+      {
+        z[l_row_entry[j].index()] =
+          z[l_row_entry[j].index()] - z[i] * l_row_entry[j].value();
+      }
+    }
+
+    // solve Uz=y
+    double x;
+    for (int i = n_row - 1; i >= 0; i--)
+    {
+      x = z[i] / u_row_entry[U_column_start[i + 1] - 1].value();
+      z[i] = x;
+      for (SparseOffset j = U_column_start[i];
+           j < U_column_start[i + 1] - 1;
+           j++)
+      {
+        z[u_row_entry[j].index()] =
+          z[u_row_entry[j].index()] - x * u_row_entry[j].value();
+      }
+    }
+  }
+
+
   //=============================================================================
   /// Apply ILU(0) preconditioner for CCDoubleMatrix: Solve Ly=r then
   /// Uz=y and return z
@@ -624,9 +728,6 @@ namespace oomph
   void ILUZeroPreconditioner<CCDoubleMatrix>::preconditioner_solve(
     const DoubleVector& r, DoubleVector& z)
   {
-    // # of rows in the matrix
-    int n_row = r.nrow();
-
     // store the distribution of z
     LinearAlgebraDistribution* z_dist = 0;
     if (z.built())
@@ -643,37 +744,64 @@ namespace oomph
       z.redistribute(this->distribution_pt());
     }
 
+    // solve LUz=r (using the factors stored during the most recent setup)
+    if (Single_precision_U_row_entry.size() > 0)
+    {
+      substitute(Single_precision_L_row_entry, Single_precision_U_row_entry, z);
+    }
+    else
+    {
+      substitute(L_row_entry, U_row_entry, z);
+    }
+
+    // if the distribution of z was preset the redistribute to original
+    if (z_dist != 0)
+    {
+      z.redistribute(z_dist);
+      delete z_dist;
+    }
+  }
+
+  //=============================================================================
+  /// Helper for the ILU(0) preconditioner for CRDoubleMatrix: Solve Ly=r
+  /// then Uz=y for the factors stored in the given vectors of (single or
+  /// double precision) coefficients. On entry z contains r.
+  //=============================================================================
+  template<class COEFFICIENT>
+  void ILUZeroPreconditioner<CRDoubleMatrix>::substitute(
+    const Vector<COEFFICIENT>& l_row_entry,
+    const Vector<COEFFICIENT>& u_row_entry,
+    DoubleVector& z) const
+  {
+    // # of rows in the matrix
+    int n_row = z.nrow();
+
     // solve Ly=r (note L matrix is unit and diagonal is not stored)
-    for (unsigned i = 0; i < static_cast<unsigned>(n_row); i++)
+    double t;
+    for (int i = 0; i < n_row; i++)
     {
-      for (unsigned j = L_column_start[i]; j < L_column_start[i + 1]; j++)
+      t = 0;
+      for (SparseOffset j = L_row_start[i]; j < L_row_start[i + 1]; j++)
       {
-        z[L_row_entry[j].index()] =
-          z[L_row_entry[j].index()] - z[i] * L_row_entry[j].value();
+        t = t + l_row_entry[j].value() * z[l_row_entry[j].index()];
       }
+      z[i] = z[i] - t;
     }
 
     // solve Uz=y
-    double x;
     for (int i = n_row - 1; i >= 0; i--)
     {
-      x = z[i] / U_row_entry[U_column_start[i + 1] - 1].value();
-      z[i] = x;
-      for (unsigned j = U_column_start[i]; j < U_column_start[i + 1] - 1; j++)
+      t = 0;
+      for (SparseOffset j = U_row_start[i] + 1; j < U_row_start[i + 1]; j++)
       {
-        z[U_row_entry[j].index()] =
-          z[U_row_entry[j].index()] - x * U_row_entry[j].value();
+        t = t + u_row_entry[j].value() * z[u_row_entry[j].index()];
       }
-    }
-
-    // if the distribution of z was preset the redistribute to original
-    if (z_dist != 0)
-    {
-      z.redistribute(z_dist);
-      delete z_dist;
+      z[i] = z[i] - t;
+      z[i] = z[i] / u_row_entry[U_row_start[i]].value();
     }
   }
 
+
   //=============================================================================
   /// Apply ILU(0) preconditioner for CRDoubleMatrix: Solve Ly=r then
   /// Uz=y
@@ -682,9 +810,6 @@ namespace oomph
   void ILUZeroPreconditioner<CRDoubleMatrix>::preconditioner_solve(
     const DoubleVector& r, DoubleVector& z)
   {
-    // # of rows in the matrix
-    int n_row = r.nrow();
-
     // store the distribution of z
     LinearAlgebraDistribution* z_dist = 0;
     if (z.built())
@@ -701,28 +826,463 @@ namespace oomph
       z.redistribute(this->distribution_pt());
     }
 
-    // solve Ly=r (note L matrix is unit and diagonal is not stored)
-    double t;
+    // solve LUz=r (using the factors stored during the most recent setup)
+    if (Single_precision_U_row_entry.size() > 0)
+    {
+      substitute(Single_precision_L_row_entry, Single_precision_U_row_entry, z);
+    }
+    else
+    {
+      substitute(L_row_entry, U_row_entry, z);
+    }
+
+    // if the distribution of z was preset the redistribute to original
+    if (z_dist != 0)
+    {
+      z.redistribute(z_dist);
+      delete z_dist;
+    }
+  }
+
+
+  //=============================================================================
+  /// Setup the incomplete LU preconditioner: compute the factorisation,
+  /// re-using the symbolic factorisation if the sparsity pattern of the
+  /// matrix hasn't changed
+  //=============================================================================
+  void ILUPreconditionerBase::setup()
+  {
+    double t_start = TimingHelpers::timer();
+
+    // cast the Double Base Matrix to Compressed Row Double Matrix
+    CRDoubleMatrix* cr_matrix_pt = dynamic_cast<CRDoubleMatrix*>(matrix_pt());
+
+#ifdef PARANOID
+    if (cr_matrix_pt == 0)
+    {
+      std::ostringstream error_msg;
+      error_msg << "Failed to convert matrix_pt to CRDoubleMatrix*.";
+      throw OomphLibError(
+        error_msg.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    // if the matrix is distributed then build global version
+    bool built_global = false;
+    if (cr_matrix_pt->distributed())
+    {
+      cr_matrix_pt = cr_matrix_pt->global_matrix();
+      built_global = true;
+    }
+
+    // store the Distribution
+    this->build_distribution(cr_matrix_pt->distribution_pt());
+
+    unsigned n_row = cr_matrix_pt->nrow();
+    unsigned n_nz = cr_matrix_pt->nnz();
+    const SparseOffset* row_start = cr_matrix_pt->row_start();
+    const int* column_index = cr_matrix_pt->column_index();
+
+    // Can we re-use the symbolic factorisation?
+    Symbolic_factorisation_was_reused = false;
+    if (Reuse_symbolic_factorisation && (U_row_start.size() == n_row + 1) &&
+        (Matrix_row_start.size() == n_row + 1) &&
+        (Matrix_column_index.size() == n_nz))
+    {
+      Symbolic_factorisation_was_reused =
+        std::equal(
+          row_start, row_start + n_row + 1, Matrix_row_start.begin()) &&
+        std::equal(
+          column_index, column_index + n_nz, Matrix_column_index.begin());
+    }
+
+    if (Symbolic_factorisation_was_reused)
+    {
+      numeric_factorisation(cr_matrix_pt);
+    }
+    else
+    {
+      Matrix_row_start.assign(row_start, row_start + n_row + 1);
+      Matrix_column_index.assign(column_index, column_index + n_nz);
+      factorise(cr_matrix_pt);
+      build_level_schedules();
+    }
+
+    // Copy the factors into single precision storage (and release the
+    // double precision ones) if required
+    if (Use_single_precision_storage)
+    {
+      Single_precision_L_value.assign(L_value.begin(), L_value.end());
+      Single_precision_U_value.assign(U_value.begin(), U_value.end());
+      Single_precision_U_inv_diag.assign(U_inv_diag.begin(), U_inv_diag.end());
+      Vector<double>().swap(L_value);
+      Vector<double>().swap(U_value);
+      Vector<double>().swap(U_inv_diag);
+    }
+    else
+    {
+      Single_precision_L_value.clear();
+      Single_precision_U_value.clear();
+      Single_precision_U_inv_diag.clear();
+    }
+
+    // if we built the global matrix then delete it
+    if (built_global)
+    {
+      delete cr_matrix_pt;
+    }
+
+    if (Doc_time)
+    {
+      oomph_info << "Time for setup of incomplete LU preconditioner";
+      if (Symbolic_factorisation_was_reused)
+      {
+        oomph_info << " (re-using symbolic factorisation)";
+      }
+      oomph_info << " [sec]: " << TimingHelpers::timer() - t_start
+                 << "\nNonzeros in factors / matrix: "
+                 << double(nnz_factors()) / double(std::max(n_nz, 1u))
+                 << "; levels in forward/backward substitution: "
+                 << nlevel().first << " / " << nlevel().second << std::endl;
+    }
+  }
+
+
+  //=============================================================================
+  /// Clean up memory
+  //=============================================================================
+  void ILUPreconditionerBase::clean_up_memory()
+  {
+    L_row_start.clear();
+    L_column_index.clear();
+    L_value.clear();
+    U_row_start.clear();
+    U_column_index.clear();
+    U_value.clear();
+    U_inv_diag.clear();
+    Single_precision_L_value.clear();
+    Single_precision_U_value.clear();
+    Single_precision_U_inv_diag.clear();
+    Matrix_row_start.clear();
+    Matrix_column_index.clear();
+    L_level_start.clear();
+    L_level_row.clear();
+    U_level_start.clear();
+    U_level_row.clear();
+  }
+
+
+  //=============================================================================
+  /// Add the memory held by the factors and by the data for the re-use
+  /// of the symbolic factorisation and the level scheduling to the account
+  //=============================================================================
+  void ILUPreconditionerBase::get_memory_usage(MemoryAccount& account)
+  {
+    account.add(
+      "ilu_factors",
+      double(L_row_start.size() + U_row_start.size()) * sizeof(SparseOffset) +
+        double(L_column_index.size() + U_column_index.size()) * sizeof(int) +
+        double(L_value.size() + U_value.size() + U_inv_diag.size()) *
+          sizeof(double) +
+        double(Single_precision_L_value.size() +
+               Single_precision_U_value.size() +
+               Single_precision_U_inv_diag.size()) *
+          sizeof(float));
+    account.add(
+      "ilu_symbolic_factorisation",
+      double(Matrix_row_start.size()) * sizeof(SparseOffset) +
+        double(Matrix_column_index.size() + L_level_start.size() +
+               L_level_row.size() + U_level_start.size() +
+               U_level_row.size()) *
+          sizeof(int));
+  }
+
+
+  //=============================================================================
+  /// Return a pivot that is safe to divide by
+  //=============================================================================
+  double ILUPreconditionerBase::safe_pivot(const double& pivot,
+                                           const double& row_norm)
+  {
+    double min_pivot = 1.0e-12 * row_norm;
+    if (std::fabs(pivot) > min_pivot && pivot != 0.0)
+    {
+      return pivot;
+    }
+    if (row_norm == 0.0)
+    {
+      return 1.0;
+    }
+    return (pivot < 0.0) ? -min_pivot : min_pivot;
+  }
+
+
+  //=============================================================================
+  /// Numerical factorisation, restricted to the current sparsity pattern
+  /// of the factors (IKJ variant of Gaussian elimination)
+  //=============================================================================
+  void ILUPreconditionerBase::numeric_factorisation(
+    CRDoubleMatrix* matrix_pt)
+  {
+    int n_row = matrix_pt->nrow();
+    const SparseOffset* row_start = matrix_pt->row_start();
+    const int* column_index = matrix_pt->column_index();
+    const double* value = matrix_pt->value();
+
+    L_value.assign(L_column_index.size(), 0.0);
+    U_value.assign(U_column_index.size(), 0.0);
+    U_inv_diag.resize(n_row);
+
+    // Work vector for the current row and flags indicating which of its
+    // entries are in the sparsity pattern (mark[j]==i)
+    Vector<double> w(n_row, 0.0);
+    Vector<int> mark(n_row, -1);
+
     for (int i = 0; i < n_row; i++)
     {
-      t = 0;
-      for (unsigned j = L_row_start[i]; j < L_row_start[i + 1]; j++)
+      // Initialise the entries in the pattern
+      for (SparseOffset k = L_row_start[i]; k < L_row_start[i + 1]; k++)
       {
-        t = t + L_row_entry[j].value() * z[L_row_entry[j].index()];
+        mark[L_column_index[k]] = i;
+        w[L_column_index[k]] = 0.0;
+      }
+      mark[i] = i;
+      w[i] = 0.0;
+      for (SparseOffset k = U_row_start[i]; k < U_row_start[i + 1]; k++)
+      {
+        mark[U_column_index[k]] = i;
+        w[U_column_index[k]] = 0.0;
+      }
+
+      // Scatter the row of the matrix (entries that have been dropped
+      // from the pattern are ignored)
+      double row_norm = 0.0;
+      for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
+      {
+        row_norm += value[k] * value[k];
+        if (mark[column_index[k]] == i)
+        {
+          w[column_index[k]] += value[k];
+        }
+      }
+      row_norm = sqrt(row_norm);
+
+      // Eliminate (the column indices in L are sorted)
+      for (SparseOffset k = L_row_start[i]; k < L_row_start[i + 1]; k++)
+      {
+        int j = L_column_index[k];
+        double l = w[j] * U_inv_diag[j];
+        w[j] = l;
+        if (l == 0.0) continue;
+        for (SparseOffset kk = U_row_start[j]; kk < U_row_start[j + 1]; kk++)
+        {
+          int c = U_column_index[kk];
+          if (mark[c] == i)
+          {
+            w[c] -= l * U_value[kk];
+          }
+        }
+      }
+
+      // Store
+      for (SparseOffset k = L_row_start[i]; k < L_row_start[i + 1]; k++)
+      {
+        L_value[k] = w[L_column_index[k]];
+      }
+      U_inv_diag[i] = 1.0 / safe_pivot(w[i], row_norm);
+      for (SparseOffset k = U_row_start[i]; k < U_row_start[i + 1]; k++)
+      {
+        U_value[k] = w[U_column_index[k]];
       }
-      z[i] = z[i] - t;
     }
+  }
 
-    // solve Uz=y
+
+  //=============================================================================
+  /// Group the rows of L and U into levels: a row of L can be processed
+  /// during the forward substitution once all the rows its entries refer
+  /// to have been processed, so its level is one more than the max.
+  /// level of these rows (similarly for U in the backward substitution).
+  //=============================================================================
+  void ILUPreconditionerBase::build_level_schedules()
+  {
+    int n_row = U_inv_diag.size();
+    Vector<int> level(n_row, 0);
+
+    // Forward substitution
+    int n_level = 0;
+    for (int i = 0; i < n_row; i++)
+    {
+      int lev = 0;
+      for (SparseOffset k = L_row_start[i]; k < L_row_start[i + 1]; k++)
+      {
+        lev = std::max(lev, level[L_column_index[k]] + 1);
+      }
+      level[i] = lev;
+      n_level = std::max(n_level, lev + 1);
+    }
+    L_level_start.assign(n_level + 1, 0);
+    for (int i = 0; i < n_row; i++)
+    {
+      L_level_start[level[i] + 1]++;
+    }
+    for (int l = 0; l < n_level; l++)
+    {
+      L_level_start[l + 1] += L_level_start[l];
+    }
+    L_level_row.resize(n_row);
+    Vector<int> next(L_level_start);
+    for (int i = 0; i < n_row; i++)
+    {
+      L_level_row[next[level[i]]++] = i;
+    }
+
+    // Backward substitution
+    n_level = 0;
     for (int i = n_row - 1; i >= 0; i--)
     {
-      t = 0;
-      for (unsigned j = U_row_start[i] + 1; j < U_row_start[i + 1]; j++)
+      int lev = 0;
+      for (SparseOffset k = U_row_start[i]; k < U_row_start[i + 1]; k++)
       {
-        t = t + U_row_entry[j].value() * z[U_row_entry[j].index()];
+        lev = std::max(lev, level[U_column_index[k]] + 1);
       }
-      z[i] = z[i] - t;
-      z[i] = z[i] / U_row_entry[U_row_start[i]].value();
+      level[i] = lev;
+      n_level = std::max(n_level, lev + 1);
+    }
+    U_level_start.assign(n_level + 1, 0);
+    for (int i = 0; i < n_row; i++)
+    {
+      U_level_start[level[i] + 1]++;
+    }
+    for (int l = 0; l < n_level; l++)
+    {
+      U_level_start[l + 1] += U_level_start[l];
+    }
+    U_level_row.resize(n_row);
+    next = U_level_start;
+    for (int i = n_row - 1; i >= 0; i--)
+    {
+      U_level_row[next[level[i]]++] = i;
+    }
+  }
+
+
+  //=============================================================================
+  /// Helper for the incomplete LU preconditioner: Solve Ly=r then Uz=y
+  /// for the given (single or double precision) values of the factors.
+  /// On entry z_pt contains r.
+  //=============================================================================
+  template<class T>
+  void ILUPreconditionerBase::substitute(const Vector<T>& l_value,
+                                         const Vector<T>& u_value,
+                                         const Vector<T>& u_inv_diag,
+                                         double* z_pt) const
+  {
+    int n_row = U_row_start.size() - 1;
+
+#ifdef _OPENMP
+    if (Use_level_scheduling && (omp_get_max_threads() > 1))
+    {
+      // solve Ly=r, level by level (note L matrix is unit and diagonal is
+      // not stored)
+      int n_level = L_level_start.size() - 1;
+      for (int l = 0; l < n_level; l++)
+      {
+        int first = L_level_start[l];
+        int last = L_level_start[l + 1];
+#pragma omp parallel for if (last - first > 256)
+        for (int m = first; m < last; m++)
+        {
+          int i = L_level_row[m];
+          double t = 0.0;
+          for (SparseOffset k = L_row_start[i]; k < L_row_start[i + 1]; k++)
+          {
+            t += l_value[k] * z_pt[L_column_index[k]];
+          }
+          z_pt[i] -= t;
+        }
+      }
+
+      // solve Uz=y, level by level
+      n_level = U_level_start.size() - 1;
+      for (int l = 0; l < n_level; l++)
+      {
+        int first = U_level_start[l];
+        int last = U_level_start[l + 1];
+#pragma omp parallel for if (last - first > 256)
+        for (int m = first; m < last; m++)
+        {
+          int i = U_level_row[m];
+          double t = 0.0;
+          for (SparseOffset k = U_row_start[i]; k < U_row_start[i + 1]; k++)
+          {
+            t += u_value[k] * z_pt[U_column_index[k]];
+          }
+          z_pt[i] = (z_pt[i] - t) * u_inv_diag[i];
+        }
+      }
+    }
+    else
+#endif
+    {
+      // solve Ly=r (note L matrix is unit and diagonal is not stored)
+      for (int i = 0; i < n_row; i++)
+      {
+        double t = 0.0;
+        for (SparseOffset k = L_row_start[i]; k < L_row_start[i + 1]; k++)
+        {
+          t += l_value[k] * z_pt[L_column_index[k]];
+        }
+        z_pt[i] -= t;
+      }
+
+      // solve Uz=y
+      for (int i = n_row - 1; i >= 0; i--)
+      {
+        double t = 0.0;
+        for (SparseOffset k = U_row_start[i]; k < U_row_start[i + 1]; k++)
+        {
+          t += u_value[k] * z_pt[U_column_index[k]];
+        }
+        z_pt[i] = (z_pt[i] - t) * u_inv_diag[i];
+      }
+    }
+  }
+
+
+  //=============================================================================
+  /// Apply the incomplete LU preconditioner: Solve Ly=r then Uz=y
+  //=============================================================================
+  void ILUPreconditionerBase::preconditioner_solve(const DoubleVector& r,
+                                                   DoubleVector& z)
+  {
+    // store the distribution of z
+    LinearAlgebraDistribution* z_dist = 0;
+    if (z.built())
+    {
+      z_dist = new LinearAlgebraDistribution(z.distribution_pt());
+    }
+
+    // copy r to z
+    z = r;
+
+    // if z is distributed then change to global
+    if (z.distributed())
+    {
+      z.redistribute(this->distribution_pt());
+    }
+
+    // solve LUz=r (using the factors stored during the most recent setup)
+    if (Single_precision_U_inv_diag.size() > 0)
+    {
+      substitute(Single_precision_L_value,
+                 Single_precision_U_value,
+                 Single_precision_U_inv_diag,
+                 z.values_pt());
+    }
+    else
+    {
+      substitute(L_value, U_value, U_inv_diag, z.values_pt());
     }
 
     // if the distribution of z was preset the redistribute to original
@@ -732,4 +1292,292 @@ namespace oomph
       delete z_dist;
     }
   }
+
+
+  //=============================================================================
+  /// ILU(k): Symbolic factorisation based on the levels of fill (the
+  /// level of the fill entry created by eliminating entry (i,k) with
+  /// the entry (k,j) of U is lev(i,k)+lev(k,j)+1; entries of the matrix
+  /// have level zero), followed by the numerical factorisation.
+  //=============================================================================
+  void ILUKPreconditioner::factorise(CRDoubleMatrix* matrix_pt)
+  {
+    int n_row = matrix_pt->nrow();
+    const SparseOffset* row_start = matrix_pt->row_start();
+    const int* column_index = matrix_pt->column_index();
+    int fill_level = Fill_level;
+
+    L_row_start.assign(1, 0);
+    L_column_index.clear();
+    U_row_start.assign(1, 0);
+    U_column_index.clear();
+    L_column_index.reserve(matrix_pt->nnz());
+    U_column_index.reserve(matrix_pt->nnz());
+    U_inv_diag.resize(n_row);
+
+    // Levels of fill of the entries in U
+    Vector<int> u_level;
+    u_level.reserve(matrix_pt->nnz());
+
+    // The pattern of the current row is stored as a sorted linked list:
+    // next[j] is the column after column j (n_row marks the end). mark[j]==i
+    // indicates that column j is in the pattern and lev[j] is its
+    // level of fill
+    Vector<int> next(n_row + 1, n_row);
+    Vector<int> mark(n_row, -1);
+    Vector<int> lev(n_row, 0);
+    Vector<int> row_column;
+
+    for (int i = 0; i < n_row; i++)
+    {
+      // Start with the pattern of the matrix (and the diagonal)
+      row_column.clear();
+      for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
+      {
+        int j = column_index[k];
+        if (mark[j] != i)
+        {
+          mark[j] = i;
+          lev[j] = 0;
+          row_column.push_back(j);
+        }
+      }
+      if (mark[i] != i)
+      {
+        mark[i] = i;
+        lev[i] = 0;
+        row_column.push_back(i);
+      }
+      std::sort(row_column.begin(), row_column.end());
+      unsigned n_column = row_column.size();
+      for (unsigned m = 0; m + 1 < n_column; m++)
+      {
+        next[row_column[m]] = row_column[m + 1];
+      }
+      next[row_column[n_column - 1]] = n_row;
+      int head = row_column[0];
+
+      // Add the fill from eliminating the entries in the lower part
+      for (int k = head; k < i; k = next[k])
+      {
+        int insert_after = k;
+        for (SparseOffset kk = U_row_start[k]; kk < U_row_start[k + 1]; kk++)
+        {
+          int j = U_column_index[kk];
+          int new_level = lev[k] + u_level[kk] + 1;
+          if (new_level > fill_level) continue;
+          if (mark[j] == i)
+          {
+            lev[j] = std::min(lev[j], new_level);
+          }
+          else
+          {
+            mark[j] = i;
+            lev[j] = new_level;
+            while (next[insert_after] < j)
+            {
+              insert_after = next[insert_after];
+            }
+            next[j] = next[insert_after];
+            next[insert_after] = j;
+          }
+          insert_after = j;
+        }
+      }
+
+      // Store the pattern
+      for (int j = head; j < n_row; j = next[j])
+      {
+        if (j < i)
+        {
+          L_column_index.push_back(j);
+        }
+        else if (j > i)
+        {
+          U_column_index.push_back(j);
+          u_level.push_back(lev[j]);
+        }
+      }
+      L_row_start.push_back(L_column_index.size());
+      U_row_start.push_back(U_column_index.size());
+    }
+
+    // Now compute the values
+    numeric_factorisation(matrix_pt);
+  }
+
+
+  //=============================================================================
+  /// Helper class to sort the entries of a row by decreasing
+  /// magnitude in ILUT
+  //=============================================================================
+  class ILUTEntryComparison
+  {
+  public:
+    /// Comparison operator: entry_1 is larger in magnitude than entry_2
+    bool operator()(const std::pair<double, int>& entry_1,
+                    const std::pair<double, int>& entry_2) const
+    {
+      return std::fabs(entry_1.first) > std::fabs(entry_2.first);
+    }
+  };
+
+
+  //=============================================================================
+  /// ILUT: threshold factorisation
+  //=============================================================================
+  void ILUTPreconditioner::factorise(CRDoubleMatrix* matrix_pt)
+  {
+    int n_row = matrix_pt->nrow();
+    const SparseOffset* row_start = matrix_pt->row_start();
+    const int* column_index = matrix_pt->column_index();
+    const double* value = matrix_pt->value();
+
+    L_row_start.assign(1, 0);
+    L_column_index.clear();
+    L_value.clear();
+    U_row_start.assign(1, 0);
+    U_column_index.clear();
+    U_value.clear();
+    U_inv_diag.resize(n_row);
+
+    // Work vector for the current row, flags indicating which of its
+    // entries are nonzero (mark[j]==i), and the nonzero columns
+    Vector<double> w(n_row, 0.0);
+    Vector<int> mark(n_row, -1);
+    Vector<int> row_column;
+
+    // The columns in the lower part, to be eliminated in increasing order
+    std::priority_queue<int, std::vector<int>, std::greater<int>> lower;
+
+    // The entries to be kept
+    Vector<std::pair<double, int>> l_entry;
+    Vector<std::pair<double, int>> u_entry;
+    Vector<std::pair<int, double>> sorted_entry;
+
+    for (int i = 0; i < n_row; i++)
+    {
+      // Scatter the row of the matrix
+      row_column.clear();
+      double row_norm = 0.0;
+      for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
+      {
+        int j = column_index[k];
+        row_norm += value[k] * value[k];
+        if (mark[j] != i)
+        {
+          mark[j] = i;
+          w[j] = 0.0;
+          row_column.push_back(j);
+          if (j < i) lower.push(j);
+        }
+        w[j] += value[k];
+      }
+      if (mark[i] != i)
+      {
+        mark[i] = i;
+        w[i] = 0.0;
+        row_column.push_back(i);
+      }
+      row_norm = sqrt(row_norm);
+      double tolerance = Drop_tolerance * row_norm;
+
+      // Eliminate
+      while (!lower.empty())
+      {
+        int j = lower.top();
+        lower.pop();
+        double l = w[j] * U_inv_diag[j];
+        if (std::fabs(l) < tolerance)
+        {
+          w[j] = 0.0;
+          continue;
+        }
+        w[j] = l;
+        for (SparseOffset kk = U_row_start[j]; kk < U_row_start[j + 1]; kk++)
+        {
+          int c = U_column_index[kk];
+          if (mark[c] != i)
+          {
+            mark[c] = i;
+            w[c] = 0.0;
+            row_column.push_back(c);
+            if (c < i) lower.push(c);
+          }
+          w[c] -= l * U_value[kk];
+        }
+      }
+
+      // Drop small entries and keep the largest ones
+      l_entry.clear();
+      u_entry.clear();
+      unsigned n_column = row_column.size();
+      for (unsigned m = 0; m < n_column; m++)
+      {
+        int j = row_column[m];
+        if ((j == i) || (std::fabs(w[j]) < tolerance) || (w[j] == 0.0))
+        {
+          continue;
+        }
+        if (j < i)
+        {
+          l_entry.push_back(std::make_pair(w[j], j));
+        }
+        else
+        {
+          u_entry.push_back(std::make_pair(w[j], j));
+        }
+      }
+      if (l_entry.size() > Max_fill_per_row)
+      {
+        std::nth_element(l_entry.begin(),
+                         l_entry.begin() + Max_fill_per_row,
+                         l_entry.end(),
+                         ILUTEntryComparison());
+        l_entry.resize(Max_fill_per_row);
+      }
+      if (u_entry.size() > Max_fill_per_row)
+      {
+        std::nth_element(u_entry.begin(),
+                         u_entry.begin() + Max_fill_per_row,
+                         u_entry.end(),
+                         ILUTEntryComparison());
+        u_entry.resize(Max_fill_per_row);
+      }
+
+      // Store (sorted by column)
+      sorted_entry.clear();
+      unsigned n_l = l_entry.size();
+      for (unsigned m = 0; m < n_l; m++)
+      {
+        sorted_entry.push_back(
+          std::make_pair(l_entry[m].second, l_entry[m].first));
+      }
+      std::sort(sorted_entry.begin(), sorted_entry.end());
+      for (unsigned m = 0; m < n_l; m++)
+      {
+        L_column_index.push_back(sorted_entry[m].first);
+        L_value.push_back(sorted_entry[m].second);
+      }
+      L_row_start.push_back(L_column_index.size());
+
+      U_inv_diag[i] = 1.0 / safe_pivot(w[i], row_norm);
+
+      sorted_entry.clear();
+      unsigned n_u = u_entry.size();
+      for (unsigned m = 0; m < n_u; m++)
+      {
+        sorted_entry.push_back(
+          std::make_pair(u_entry[m].second, u_entry[m].first));
+      }
+      std::sort(sorted_entry.begin(), sorted_entry.end());
+      for (unsigned m = 0; m < n_u; m++)
+      {
+        U_column_index.push_back(sorted_entry[m].first);
+        U_value.push_back(sorted_entry[m].second);
+      }
+      U_row_start.push_back(U_column_index.size());
+    }
+  }
+
 } // namespace oomph
@@ -43,13 +43,15 @@
 namespace oomph
 {
   //=====================================================================
-  /// Matrix-based diagonal preconditioner
+  /// Matrix-based diagonal preconditioner. The inverse diagonal
+  /// entries can be stored in single precision (see
+  /// enable_single_precision_storage()).
   //=====================================================================
   class MatrixBasedDiagPreconditioner : public Preconditioner
   {
   public:
-    /// Constructor (empty)
-    MatrixBasedDiagPreconditioner(){};
+    /// Constructor
+    MatrixBasedDiagPreconditioner() : Use_single_precision_storage(false) {}
 
     /// Destructor (empty)
     ~MatrixBasedDiagPreconditioner(){};
@@ -68,9 +70,44 @@ namespace oomph
     /// assembled matrix.
     void setup();
 
+    /// Store the inverse diagonal entries in single precision
+    /// (takes effect during the next setup())
+    void enable_single_precision_storage()
+    {
+      Use_single_precision_storage = true;
+    }
+
+    /// Store the inverse diagonal entries in double precision (the
+    /// default; takes effect during the next setup())
+    void disable_single_precision_storage()
+    {
+      Use_single_precision_storage = false;
+    }
+
+    /// Are the inverse diagonal entries stored in single precision?
+    bool single_precision_storage_is_enabled() const
+    {
+      return Use_single_precision_storage;
+    }
+
+    /// Add the memory held by the inverse diagonal entries to the
+    /// category "inverse_diagonal" of the account
+    void get_memory_usage(MemoryAccount& account)
+    {
+      account.add("inverse_diagonal",
+                  double(Inv_diag.size()) * sizeof(double) +
+                    double(Single_precision_inv_diag.size()) * sizeof(float));
+    }
+
   private:
     /// Vector of inverse diagonal entries
     Vector<double> Inv_diag;
+
+    /// Vector of inverse diagonal entries (single precision storage)
+    Vector<float> Single_precision_inv_diag;
+
+    /// Store the inverse diagonal entries in single precision?
+    bool Use_single_precision_storage;
   };
 
   //=============================================================================
@@ -252,6 +289,48 @@ namespace oomph
   };
 
 
+  //=============================================================================
+  /// Single precision version of the CompressedMatrixCoefficient: Contains
+  /// the (row or column) index and the value (stored as a float) of a
+  /// coefficient in a compressed row or column. Used to store the factors
+  /// of the ILU(0) preconditioners if single precision storage is enabled.
+  //=============================================================================
+  class SinglePrecisionCompressedMatrixCoefficient
+  {
+  public:
+    /// Constructor (no arguments)
+    SinglePrecisionCompressedMatrixCoefficient() {}
+
+    /// Constructor: Copy the index and the (rounded) value of a double
+    /// precision coefficient
+    SinglePrecisionCompressedMatrixCoefficient(
+      const CompressedMatrixCoefficient& a)
+    {
+      Index = a.index();
+      Value = float(a.value());
+    }
+
+    /// Access function for the coefficient's (row or column) index
+    unsigned index() const
+    {
+      return Index;
+    }
+
+    /// Access function for the coefficient's value
+    double value() const
+    {
+      return Value;
+    }
+
+  private:
+    /// the row or column index of the compressed-matrix coefficient
+    unsigned Index;
+
+    /// the value of the compressed-matrix coefficient
+    float Value;
+  };
+
+
   //=============================================================================
   /// ILU(0) Preconditioner
   //=============================================================================
@@ -262,14 +341,16 @@ namespace oomph
 
 
   //=============================================================================
-  /// ILU(0) Preconditioner for matrices of CCDoubleMatrix Format
+  /// ILU(0) Preconditioner for matrices of CCDoubleMatrix Format. The
+  /// factors can be stored in single precision (see
+  /// enable_single_precision_storage()).
   //=============================================================================
   template<>
   class ILUZeroPreconditioner<CCDoubleMatrix> : public Preconditioner
   {
   public:
-    /// Constructor (empty)
-    ILUZeroPreconditioner(){};
+    /// Constructor
+    ILUZeroPreconditioner() : Use_single_precision_storage(false) {}
 
     /// Destructor (empty)
     ~ILUZeroPreconditioner(){};
@@ -288,32 +369,91 @@ namespace oomph
     /// assembled matrix. Problem pointer is ignored.
     void setup();
 
+    /// Store the factors in single precision (the factorisation itself
+    /// is computed in double precision; takes effect during the next
+    /// setup())
+    void enable_single_precision_storage()
+    {
+      Use_single_precision_storage = true;
+    }
+
+    /// Store the factors in double precision (the default; takes
+    /// effect during the next setup())
+    void disable_single_precision_storage()
+    {
+      Use_single_precision_storage = false;
+    }
+
+    /// Are the factors stored in single precision?
+    bool single_precision_storage_is_enabled() const
+    {
+      return Use_single_precision_storage;
+    }
+
+    /// Add the memory held by the factors to the category
+    /// "ilu_factors" of the account
+    void get_memory_usage(MemoryAccount& account)
+    {
+      account.add(
+        "ilu_factors",
+        double(U_column_start.size() + L_column_start.size()) *
+            sizeof(unsigned) +
+          double(U_row_entry.size() + L_row_entry.size()) *
+            sizeof(CompressedMatrixCoefficient) +
+          double(Single_precision_U_row_entry.size() +
+                 Single_precision_L_row_entry.size()) *
+            sizeof(SinglePrecisionCompressedMatrixCoefficient));
+    }
+
   private:
+    /// Solve Ly=r then Uz=y for the factors stored in the given
+    /// vectors of (single or double precision) coefficients; on entry
+    /// z contains r.
+    template<class COEFFICIENT>
+    void substitute(const Vector<COEFFICIENT>& l_row_entry,
+                    const Vector<COEFFICIENT>& u_row_entry,
+                    DoubleVector& z) const;
+
     /// Column start for upper triangular matrix
-    Vector<unsigned> U_column_start;
+    Vector<SparseOffset> U_column_start;
 
     /// Row entry for the upper triangular matrix (each element of the
     /// vector contains the row index and coefficient)
     Vector<CompressedMatrixCoefficient> U_row_entry;
 
     /// Column start for lower triangular matrix
-    Vector<unsigned> L_column_start;
+    Vector<SparseOffset> L_column_start;
 
     /// Row entry for the lower triangular matrix (each element of the
     /// vector contains the row index and coefficient)
     Vector<CompressedMatrixCoefficient> L_row_entry;
+
+    /// Row entry for the upper triangular matrix (single precision
+    /// storage)
+    Vector<SinglePrecisionCompressedMatrixCoefficient>
+      Single_precision_U_row_entry;
+
+    /// Row entry for the lower triangular matrix (single precision
+    /// storage)
+    Vector<SinglePrecisionCompressedMatrixCoefficient>
+      Single_precision_L_row_entry;
+
+    /// Store the factors in single precision?
+    bool Use_single_precision_storage;
   };
 
 
   //=============================================================================
-  /// ILU(0) Preconditioner for matrices of CRDoubleMatrix Format
+  /// ILU(0) Preconditioner for matrices of CRDoubleMatrix Format. The
+  /// factors can be stored in single precision (see
+  /// enable_single_precision_storage()).
   //=============================================================================
   template<>
   class ILUZeroPreconditioner<CRDoubleMatrix> : public Preconditioner
   {
   public:
-    /// Constructor (empty)
-    ILUZeroPreconditioner(){};
+    /// Constructor
+    ILUZeroPreconditioner() : Use_single_precision_storage(false) {}
 
 
     /// Broken copy constructor
@@ -332,23 +472,421 @@ namespace oomph
     /// assembled matrix. Problem pointer is ignored.
     void setup();
 
+    /// Store the factors in single precision (the factorisation itself
+    /// is computed in double precision; takes effect during the next
+    /// setup())
+    void enable_single_precision_storage()
+    {
+      Use_single_precision_storage = true;
+    }
+
+    /// Store the factors in double precision (the default; takes
+    /// effect during the next setup())
+    void disable_single_precision_storage()
+    {
+      Use_single_precision_storage = false;
+    }
+
+    /// Are the factors stored in single precision?
+    bool single_precision_storage_is_enabled() const
+    {
+      return Use_single_precision_storage;
+    }
+
+    /// Add the memory held by the factors to the category
+    /// "ilu_factors" of the account
+    void get_memory_usage(MemoryAccount& account)
+    {
+      account.add(
+        "ilu_factors",
+        double(U_row_start.size() + L_row_start.size()) * sizeof(unsigned) +
+          double(U_row_entry.size() + L_row_entry.size()) *
+            sizeof(CompressedMatrixCoefficient) +
+          double(Single_precision_U_row_entry.size() +
+                 Single_precision_L_row_entry.size()) *
+            sizeof(SinglePrecisionCompressedMatrixCoefficient));
+    }
 
   private:
+    /// Solve Ly=r then Uz=y for the factors stored in the given
+    /// vectors of (single or double precision) coefficients; on entry
+    /// z contains r.
+    template<class COEFFICIENT>
+    void substitute(const Vector<COEFFICIENT>& l_row_entry,
+                    const Vector<COEFFICIENT>& u_row_entry,
+                    DoubleVector& z) const;
+
     /// Row start for upper triangular matrix
-    Vector<unsigned> U_row_start;
+    Vector<SparseOffset> U_row_start;
 
     /// column entry for the upper triangular matrix (each element of the
     /// vector contains the column index and coefficient)
     Vector<CompressedMatrixCoefficient> U_row_entry;
 
     /// Row start for lower triangular matrix
-    Vector<unsigned> L_row_start;
+    Vector<SparseOffset> L_row_start;
 
     /// column entry for the lower triangular matrix (each element of the
     /// vector contains the column index and coefficient)
     Vector<CompressedMatrixCoefficient> L_row_entry;
+
+    /// column entry for the upper triangular matrix (single precision
+    /// storage)
+    Vector<SinglePrecisionCompressedMatrixCoefficient>
+      Single_precision_U_row_entry;
+
+    /// column entry for the lower triangular matrix (single precision
+    /// storage)
+    Vector<SinglePrecisionCompressedMatrixCoefficient>
+      Single_precision_L_row_entry;
+
+    /// Store the factors in single precision?
+    bool Use_single_precision_storage;
   };
 
+  //=============================================================================
+  /// Base class for incomplete LU preconditioners with fill
+  /// (ILUKPreconditioner, ILUTPreconditioner) for matrices of CRDoubleMatrix
+  /// format. Stores the factors in compressed row format (L with unit
+  /// diagonal, U with the inverse of its diagonal stored separately).
+  ///
+  /// If the preconditioner is set up again for a matrix with the same
+  /// sparsity pattern (e.g. during a Newton iteration), the symbolic
+  /// factorisation (the sparsity pattern of the factors) is re-used by
+  /// default and only the numerical factorisation is repeated.
+  ///
+  /// The forward and backward substitutions can be level-scheduled:
+  /// the rows of each factor are grouped into levels whose rows only
+  /// depend on rows in earlier levels, so the rows within a level can be
+  /// processed concurrently. This is used (with OpenMP threads) if
+  /// the library is compiled with OpenMP support (e.g. with
+  /// CXXFLAGS="-fopenmp"); otherwise the rows are processed in their
+  /// natural order.
+  ///
+  /// The factors are computed in double precision but can be stored
+  /// (and applied) in single precision, roughly halving the memory
+  /// traffic of the triangular solves (see
+  /// enable_single_precision_storage()).
+  //=============================================================================
+  class ILUPreconditionerBase : public Preconditioner
+  {
+  public:
+    /// Constructor
+    ILUPreconditionerBase()
+      : Reuse_symbolic_factorisation(true),
+        Symbolic_factorisation_was_reused(false),
+        Use_level_scheduling(true),
+        Use_single_precision_storage(false),
+        Doc_time(false)
+    {
+    }
+
+    /// Destructor (empty)
+    virtual ~ILUPreconditionerBase() {}
+
+    /// Broken copy constructor
+    ILUPreconditionerBase(const ILUPreconditionerBase&) = delete;
+
+    /// Broken assignment operator
+    void operator=(const ILUPreconditionerBase&) = delete;
+
+    /// Apply preconditioner to r, i.e. solve LU z = r
+    void preconditioner_solve(const DoubleVector& r, DoubleVector& z);
+
+    /// Setup the preconditioner: compute the incomplete factorisation
+    /// of the fully assembled matrix (re-using the symbolic
+    /// factorisation if allowed and possible)
+    void setup();
+
+    /// Clean up memory (the next setup() starts from scratch)
+    void clean_up_memory();
+
+    /// Re-use the sparsity pattern of the factors if the preconditioner
+    /// is set up again for a matrix with the same sparsity pattern (the
+    /// default)
+    void enable_reuse_of_symbolic_factorisation()
+    {
+      Reuse_symbolic_factorisation = true;
+    }
+
+    /// Always redo the symbolic factorisation
+    void disable_reuse_of_symbolic_factorisation()
+    {
+      Reuse_symbolic_factorisation = false;
+    }
+
+    /// Was the symbolic factorisation re-used during the most recent
+    /// setup?
+    bool symbolic_factorisation_was_reused() const
+    {
+      return Symbolic_factorisation_was_reused;
+    }
+
+    /// Use level scheduling for the triangular solves (the default;
+    /// only has an effect if the library is compiled with OpenMP)
+    void enable_level_scheduling()
+    {
+      Use_level_scheduling = true;
+    }
+
+    /// Don't use level scheduling for the triangular solves
+    void disable_level_scheduling()
+    {
+      Use_level_scheduling = false;
+    }
+
+    /// Store the factors in single precision (takes effect during the
+    /// next setup())
+    void enable_single_precision_storage()
+    {
+      Use_single_precision_storage = true;
+    }
+
+    /// Store the factors in double precision (the default; takes
+    /// effect during the next setup())
+    void disable_single_precision_storage()
+    {
+      Use_single_precision_storage = false;
+    }
+
+    /// Are the factors stored in single precision?
+    bool single_precision_storage_is_enabled() const
+    {
+      return Use_single_precision_storage;
+    }
+
+    /// Enable documentation of timings and fill
+    void enable_doc_time()
+    {
+      Doc_time = true;
+    }
+
+    /// Disable documentation of timings and fill
+    void disable_doc_time()
+    {
+      Doc_time = false;
+    }
+
+    /// Number of nonzeros in the factors (incl. the diagonal of U)
+    unsigned long nnz_factors() const
+    {
+      unsigned long n_diag =
+        (U_row_start.size() > 0) ? U_row_start.size() - 1 : 0;
+      return L_column_index.size() + U_column_index.size() + n_diag;
+    }
+
+    /// Add the memory held by the factors to the category
+    /// "ilu_factors" of the account, and that held by the copy of the
+    /// matrix's sparsity pattern and the level schedules to
+    /// "ilu_symbolic_factorisation"
+    void get_memory_usage(MemoryAccount& account);
+
+    /// Number of levels in the forward (first entry) and backward
+    /// (second entry) substitution schedules
+    std::pair<unsigned, unsigned> nlevel() const
+    {
+      unsigned n_forward =
+        (L_level_start.size() > 0) ? L_level_start.size() - 1 : 0;
+      unsigned n_backward =
+        (U_level_start.size() > 0) ? U_level_start.size() - 1 : 0;
+      return std::make_pair(n_forward, n_backward);
+    }
+
+  protected:
+    /// Compute the factorisation of the (global) matrix from
+    /// scratch, i.e. determine the sparsity pattern of L and U (stored in
+    /// L_row_start, L_column_index, U_row_start and U_column_index,
+    /// with sorted column indices) and their values.
+    virtual void factorise(CRDoubleMatrix* matrix_pt) = 0;
+
+    /// Numerical factorisation of the (global) matrix, restricted to
+    /// the current sparsity pattern of the factors.
+    void numeric_factorisation(CRDoubleMatrix* matrix_pt);
+
+    /// Return a pivot that is safe to divide by: tiny pivots are
+    /// replaced by a small multiple of the norm of the row
+    static double safe_pivot(const double& pivot, const double& row_norm);
+
+    /// Row start for the strictly lower triangular factor
+    /// (the diagonal of L is one)
+    Vector<SparseOffset> L_row_start;
+
+    /// Column indices for the strictly lower triangular factor
+    Vector<int> L_column_index;
+
+    /// Values of the strictly lower triangular factor
+    Vector<double> L_value;
+
+    /// Row start for the strictly upper triangular factor
+    Vector<SparseOffset> U_row_start;
+
+    /// Column indices for the strictly upper triangular factor
+    Vector<int> U_column_index;
+
+    /// Values of the strictly upper triangular factor
+    Vector<double> U_value;
+
+    /// Inverse of the diagonal of U
+    Vector<double> U_inv_diag;
+
+  private:
+    /// Group the rows of L and U into levels for the level-scheduled
+    /// triangular solves
+    void build_level_schedules();
+
+    /// Solve Ly=r then Uz=y for the given (single or double precision)
+    /// values of the factors; on entry z_pt contains r.
+    template<class T>
+    void substitute(const Vector<T>& l_value,
+                    const Vector<T>& u_value,
+                    const Vector<T>& u_inv_diag,
+                    double* z_pt) const;
+
+    /// Values of the strictly lower triangular factor (single
+    /// precision storage)
+    Vector<float> Single_precision_L_value;
+
+    /// Values of the strictly upper triangular factor (single
+    /// precision storage)
+    Vector<float> Single_precision_U_value;
+
+    /// Inverse of the diagonal of U (single precision storage)
+    Vector<float> Single_precision_U_inv_diag;
+
+    /// Re-use the symbolic factorisation if the pattern hasn't changed?
+    bool Reuse_symbolic_factorisation;
+
+    /// Was the symbolic factorisation re-used during the most recent
+    /// setup?
+    bool Symbolic_factorisation_was_reused;
+
+    /// Use level scheduling?
+    bool Use_level_scheduling;
+
+    /// Store the factors in single precision?
+    bool Use_single_precision_storage;
+
+    /// Document timings and fill?
+    bool Doc_time;
+
+    /// Row starts of the matrix the factorisation was computed for
+    Vector<SparseOffset> Matrix_row_start;
+
+    /// Column indices of the matrix the factorisation was computed for
+    Vector<int> Matrix_column_index;
+
+    /// Start of each level (in L_level_row) of the forward substitution
+    Vector<int> L_level_start;
+
+    /// Rows of L, sorted by level
+    Vector<int> L_level_row;
+
+    /// Start of each level (in U_level_row) of the backward substitution
+    Vector<int> U_level_start;
+
+    /// Rows of U, sorted by level
+    Vector<int> U_level_row;
+  };
+
+
+  //=============================================================================
+  /// ILU(k) preconditioner for matrices of CRDoubleMatrix format:
+  /// incomplete LU factorisation that keeps all fill entries whose level
+  /// of fill is less than or equal to k (ILU(0) keeps the sparsity
+  /// pattern of the matrix).
+  //=============================================================================
+  class ILUKPreconditioner : public ILUPreconditionerBase
+  {
+  public:
+    /// Constructor: specify the level of fill (defaults to 1)
+    ILUKPreconditioner(const unsigned& fill_level = 1)
+      : ILUPreconditionerBase(), Fill_level(fill_level)
+    {
+    }
+
+    /// Broken copy constructor
+    ILUKPreconditioner(const ILUKPreconditioner&) = delete;
+
+    /// Broken assignment operator
+    void operator=(const ILUKPreconditioner&) = delete;
+
+    /// Access function to the level of fill. (Changing it requires
+    /// a new symbolic factorisation, so call clean_up_memory() afterwards
+    /// if the preconditioner has been set up before.)
+    unsigned& fill_level()
+    {
+      return Fill_level;
+    }
+
+  protected:
+    /// Symbolic factorisation (based on the levels of fill), followed
+    /// by the numerical factorisation
+    void factorise(CRDoubleMatrix* matrix_pt);
+
+  private:
+    /// The level of fill
+    unsigned Fill_level;
+  };
+
+
+  //=============================================================================
+  /// ILUT preconditioner for matrices of CRDoubleMatrix format (Saad's
+  /// dual threshold incomplete LU factorisation): entries that are
+  /// smaller than the drop tolerance (relative to the 2-norm of the
+  /// row of the matrix) are dropped, and only the Max_fill_per_row
+  /// largest entries of L and U are kept in each row (in addition to
+  /// the diagonal).
+  ///
+  /// If the symbolic factorisation is re-used, the numerical
+  /// factorisation is restricted to the sparsity pattern selected by the
+  /// thresholds during the first setup.
+  //=============================================================================
+  class ILUTPreconditioner : public ILUPreconditionerBase
+  {
+  public:
+    /// Constructor: specify the drop tolerance and the max. number of
+    /// entries per row of L and U
+    ILUTPreconditioner(const double& drop_tolerance = 1.0e-3,
+                       const unsigned& max_fill_per_row = 20)
+      : ILUPreconditionerBase(),
+        Drop_tolerance(drop_tolerance),
+        Max_fill_per_row(max_fill_per_row)
+    {
+    }
+
+    /// Broken copy constructor
+    ILUTPreconditioner(const ILUTPreconditioner&) = delete;
+
+    /// Broken assignment operator
+    void operator=(const ILUTPreconditioner&) = delete;
+
+    /// Access function to the drop tolerance
+    double& drop_tolerance()
+    {
+      return Drop_tolerance;
+    }
+
+    /// Access function to the max. number of entries per row of L and
+    /// of U
+    unsigned& max_fill_per_row()
+    {
+      return Max_fill_per_row;
+    }
+
+  protected:
+    /// Threshold factorisation (determines the sparsity pattern and
+    /// the values of the factors)
+    void factorise(CRDoubleMatrix* matrix_pt);
+
+  private:
+    /// The drop tolerance
+    double Drop_tolerance;
+
+    /// Max. number of entries per row of L and U
+    unsigned Max_fill_per_row;
+  };
+
+
   //=============================================================================
   /// A preconditioner for performing inner iteration preconditioner
   /// solves. The template argument SOLVER specifies the inner iteration
@@ -321,6 +321,53 @@ namespace oomph
     }
 
 
+    /// Derivatives of the position Vector (at the current time) w.r.t.
+    /// the values of the geometric Data that the object's shape depends on:
+    /// dposition_dgeom_data[data_pt](i,k) = dR_i / d (k-th value of
+    /// data_pt). The default implementation uses finite differences;
+    /// overload it to provide analytic derivatives.
+    virtual void dposition_dgeom_data(
+      const Vector<double>& zeta,
+      std::map<Data*, DenseMatrix<double>>& dposition_dgeom_data)
+    {
+      dposition_dgeom_data.clear();
+
+      // Unperturbed position
+      const unsigned n_dim = ndim();
+      Vector<double> r(n_dim);
+      position(zeta, r);
+
+      // Use the same step as the default finite difference Jacobians
+      const double fd_step = 1.0e-8;
+
+      // Loop over the geometric Data and their values
+      Vector<double> r_pls(n_dim);
+      const unsigned n_geom_data = ngeom_data();
+      for (unsigned j = 0; j < n_geom_data; j++)
+      {
+        Data* data_pt = geom_data_pt(j);
+        const unsigned n_value = data_pt->nvalue();
+        DenseMatrix<double>& dr_ddata = dposition_dgeom_data[data_pt];
+        dr_ddata.resize(n_dim, n_value, 0.0);
+        for (unsigned k = 0; k < n_value; k++)
+        {
+          // Perturb the value and get the new position
+          double* value_pt = data_pt->value_pt(k);
+          double old_var = *value_pt;
+          *value_pt += fd_step;
+          position(zeta, r_pls);
+          for (unsigned i = 0; i < n_dim; i++)
+          {
+            dr_ddata(i, k) = (r_pls[i] - r[i]) / fd_step;
+          }
+
+          // Reset the value
+          *value_pt = old_var;
+        }
+      }
+    }
+
+
     /// Derivative of position Vector w.r.t. to coordinates:
     /// \f$ \frac{dR_i}{d \zeta_\alpha}\f$ = drdzeta(alpha,i).
     /// Evaluated at current time.
@@ -557,6 +604,19 @@ namespace oomph
     }
 
 
+    /// Derivatives of the position Vector w.r.t. the height of the
+    /// line: dR_1/dH = 1
+    void dposition_dgeom_data(
+      const Vector<double>& zeta,
+      std::map<Data*, DenseMatrix<double>>& dposition_dgeom_data)
+    {
+      dposition_dgeom_data.clear();
+      DenseMatrix<double>& dr_ddata = dposition_dgeom_data[Geom_data_pt[0]];
+      dr_ddata.resize(2, Geom_data_pt[0]->nvalue(), 0.0);
+      dr_ddata(1, 0) = 1.0;
+    }
+
+
     /// Derivative of position Vector w.r.t. to coordinates:
     /// \f$ \frac{dR_i}{d \zeta_\alpha}\f$ = drdzeta(alpha,i).
     /// Evaluated at current time.
@@ -786,6 +846,20 @@ namespace oomph
     }
 
 
+    /// Derivatives of the position Vector w.r.t. the half axes:
+    /// dR_0/dA = cos(zeta), dR_1/dB = sin(zeta)
+    void dposition_dgeom_data(
+      const Vector<double>& zeta,
+      std::map<Data*, DenseMatrix<double>>& dposition_dgeom_data)
+    {
+      dposition_dgeom_data.clear();
+      DenseMatrix<double>& dr_ddata = dposition_dgeom_data[Geom_data_pt[0]];
+      dr_ddata.resize(2, Geom_data_pt[0]->nvalue(), 0.0);
+      dr_ddata(0, 0) = cos(zeta[0]);
+      dr_ddata(1, 1) = sin(zeta[0]);
+    }
+
+
     /// Derivative of position Vector w.r.t. to coordinates:
     /// \f$ \frac{dR_i}{d \zeta_\alpha}\f$ = drdzeta(alpha,i).
     void dposition(const Vector<double>& zeta,
@@ -1073,6 +1147,21 @@ namespace oomph
       }
     }
 
+    /// Derivatives of the position Vector w.r.t. the coordinates of
+    /// the centre and the radius
+    void dposition_dgeom_data(
+      const Vector<double>& zeta,
+      std::map<Data*, DenseMatrix<double>>& dposition_dgeom_data)
+    {
+      dposition_dgeom_data.clear();
+      DenseMatrix<double>& dr_ddata = dposition_dgeom_data[Geom_data_pt[0]];
+      dr_ddata.resize(2, Geom_data_pt[0]->nvalue(), 0.0);
+      dr_ddata(0, 0) = 1.0;
+      dr_ddata(1, 1) = 1.0;
+      dr_ddata(0, 2) = cos(zeta[0]);
+      dr_ddata(1, 2) = sin(zeta[0]);
+    }
+
     /// Access function to x-coordinate of centre of circle
     double& x_c()
     {
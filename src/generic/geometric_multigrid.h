@@ -402,7 +402,7 @@ namespace oomph
     void interpolation_matrix_set(const unsigned& level,
                                   double* value,
                                   int* col_index,
-                                  int* row_st,
+                                  SparseOffset* row_st,
                                   unsigned& ncol,
                                   unsigned& nnz)
     {
@@ -420,7 +420,7 @@ namespace oomph
     void interpolation_matrix_set(const unsigned& level,
                                   Vector<double>& value,
                                   Vector<int>& col_index,
-                                  Vector<int>& row_st,
+                                  Vector<SparseOffset>& row_st,
                                   unsigned& ncol,
                                   unsigned& nrow)
     {
@@ -1646,7 +1646,7 @@ namespace oomph
       // as the vector value.
       Vector<double> value;
       Vector<int> column_index;
-      Vector<int> row_start(n_rows + 1);
+      Vector<SparseOffset> row_start(n_rows + 1);
 
       // The value of index will tell us which row of the interpolation matrix
       // we're working on in the following for loop
@@ -1869,7 +1869,7 @@ namespace oomph
       // as the vector value.
       Vector<double> value;
       Vector<int> column_index;
-      Vector<int> row_start(fine_n_unknowns + 1);
+      Vector<SparseOffset> row_start(fine_n_unknowns + 1);
 
       // Vector to contain the (Eulerian) spatial location of the fine node
       Vector<double> fine_node_position(DIM);
@@ -2030,7 +2030,9 @@ namespace oomph
 #endif
 
     // Multiply the residual vector by the restriction matrix on the level-th
-    // level (to restrict the vector down to the next coarser level)
+    // level (to restrict the vector down to the next coarser level). For
+    // non-distributed matrices the product is computed by a row-parallel
+    // loop if the library is compiled with OpenMP.
     Restriction_matrices_storage_pt[level]->multiply(
       Residual_mg_vectors_storage[level], Rhs_mg_vectors_storage[level + 1]);
   } // End of restrict_residual
@@ -2052,15 +2054,49 @@ namespace oomph
     }
 #endif
 
-    // Build distribution of a temporary vector
-    DoubleVector temp_soln(X_mg_vectors_storage[level - 1].distribution_pt());
+    // Pointer to the interpolation matrix
+    CRDoubleMatrix* interpolation_matrix_pt =
+      Interpolation_matrices_storage_pt[level - 1];
 
-    // Interpolate the solution vector
-    Interpolation_matrices_storage_pt[level - 1]->multiply(
-      X_mg_vectors_storage[level], temp_soln);
+    // If the matrix is distributed we need the general matrix-vector product
+    if (interpolation_matrix_pt->distributed() &&
+        (interpolation_matrix_pt->distribution_pt()->communicator_pt()->nproc() >
+         1))
+    {
+      // Build distribution of a temporary vector
+      DoubleVector temp_soln(
+        X_mg_vectors_storage[level - 1].distribution_pt());
+
+      // Interpolate the solution vector
+      interpolation_matrix_pt->multiply(X_mg_vectors_storage[level],
+                                        temp_soln);
 
-    // Update
-    X_mg_vectors_storage[level - 1] += temp_soln;
+      // Update
+      X_mg_vectors_storage[level - 1] += temp_soln;
+    }
+    // Otherwise interpolate and correct in a single (row-parallel) loop
+    // without the temporary vector
+    else
+    {
+      int n_row = interpolation_matrix_pt->nrow();
+      const SparseOffset* row_start = interpolation_matrix_pt->row_start();
+      const int* column_index = interpolation_matrix_pt->column_index();
+      const double* value = interpolation_matrix_pt->value();
+      const double* coarse_pt = X_mg_vectors_storage[level].values_pt();
+      double* fine_pt = X_mg_vectors_storage[level - 1].values_pt();
+#ifdef _OPENMP
+#pragma omp parallel for if (n_row > 256)
+#endif
+      for (int i = 0; i < n_row; i++)
+      {
+        double correction = 0.0;
+        for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
+        {
+          correction += value[k] * coarse_pt[column_index[k]];
+        }
+        fine_pt[i] += correction;
+      }
+    }
   } // End of interpolate_and_correct
 
   //===================================================================
@@ -2079,7 +2115,7 @@ namespace oomph
       restriction_matrix_pt = Restriction_matrices_storage_pt[level];
 
       // Get access to the row start data
-      const int* row_start_pt = restriction_matrix_pt->row_start();
+      const SparseOffset* row_start_pt = restriction_matrix_pt->row_start();
 
       // Get access to the matrix entries
       double* value_pt = restriction_matrix_pt->value();
@@ -324,7 +324,7 @@ namespace oomph
       const double* matrix_vals = oomph_matrix->value();
 
       // row starts
-      const int* matrix_row_start = oomph_matrix->row_start();
+      const SparseOffset* matrix_row_start = oomph_matrix->row_start();
 
       // build the distribution
       if (oomph_matrix->distribution_pt()->distributed())
@@ -379,7 +379,7 @@ namespace oomph
       }
 
       // put values in HYPRE matrix
-      int local_start = 0;
+      SparseOffset local_start = 0;
       if (!oomph_matrix->distributed() && dist_pt->distributed())
       {
         local_start += matrix_row_start[hypre_first_row];
@@ -38,6 +38,9 @@
 // sumofmatrices class.
 #include "sum_of_matrices.h"
 
+// ...and for block compressed row matrices
+#include "block_cr_double_matrix.h"
+
 
 namespace oomph
 {
@@ -340,6 +343,10 @@ namespace oomph
         double t_end_prec = TimingHelpers::timer();
         Preconditioner_setup_time = t_end_prec - t_start_prec;
 
+        // Record the memory usage while the matrix and the
+        // preconditioner are both held in memory
+        record_memory_usage_of_solve(matrix_pt);
+
         if (Doc_time)
         {
           oomph_info << "Time for setup of preconditioner  [sec]: "
@@ -771,6 +778,10 @@ namespace oomph
         double t_end_prec = TimingHelpers::timer();
         Preconditioner_setup_time = t_end_prec - t_start_prec;
 
+        // Record the memory usage while the matrix and the
+        // preconditioner are both held in memory
+        record_memory_usage_of_solve(matrix_pt);
+
         if (Doc_time)
         {
           oomph_info << "Time for setup of preconditioner  [sec]: "
@@ -1582,7 +1593,7 @@ namespace oomph
     // First acquire access to the value, row_start and column_index arrays
     // from the compressed row matrix
     const double* value_pt = tmp_matrix_pt->value();
-    const int* row_start_pt = tmp_matrix_pt->row_start();
+    const SparseOffset* row_start_pt = tmp_matrix_pt->row_start();
     const int* column_index_pt = tmp_matrix_pt->column_index();
 
     // We've finished using the temporary matrix pointer so make it a null
@@ -1594,7 +1605,7 @@ namespace oomph
     for (unsigned i = 0; i < n_dof; i++)
     {
       // Get the index of the last entry below or on the diagonal in row i
-      unsigned diag_index = Index_of_diagonal_entries[i];
+      SparseOffset diag_index = Index_of_diagonal_entries[i];
 
       if (unsigned(*(column_index_pt + diag_index)) != i)
       {
@@ -1618,10 +1629,10 @@ namespace oomph
     for (unsigned i = 0; i < n_dof; i++)
     {
       // Get the index of the last entry below or on the diagonal in row i
-      unsigned diag_index = Index_of_diagonal_entries[i];
+      SparseOffset diag_index = Index_of_diagonal_entries[i];
 
       // Get the index of the first entry in row i
-      unsigned row_i_start = *(row_start_pt + i);
+      SparseOffset row_i_start = *(row_start_pt + i);
 
       // If there are entries strictly below the diagonal then the
       // column index of the first entry in the i-th row cannot be
@@ -1634,7 +1645,7 @@ namespace oomph
         unsigned column_index = 0;
 
         // Loop over the entries below the diagonal on row i
-        for (unsigned j = row_i_start; j < diag_index; j++)
+        for (SparseOffset j = row_i_start; j < diag_index; j++)
         {
           // Find the column index of this nonzero entry
           column_index = *(column_index_pt + j);
@@ -1669,11 +1680,11 @@ namespace oomph
 
       // Auxiliary variable to store the index of the first entry on the
       // upper triangular portion of the matrix
-      unsigned upper_tri_start = 0;
+      SparseOffset upper_tri_start = 0;
 
       // Auxiliary variable to store the index of the first entry in the
       // next row
-      unsigned next_row_start = 0;
+      SparseOffset next_row_start = 0;
 
       // Set the temporary vector temp_vec to be initially be the zero vector
       temp_vec.initialise(0.0);
@@ -1695,7 +1706,7 @@ namespace oomph
         unsigned column_index = 0;
 
         // Loop over all of the entries above the diagonal
-        for (unsigned j = upper_tri_start; j < next_row_start; j++)
+        for (SparseOffset j = upper_tri_start; j < next_row_start; j++)
         {
           // Get the column index of this entry
           column_index = *(column_index_pt + j);
@@ -1724,10 +1735,10 @@ namespace oomph
       for (unsigned i = 0; i < n_dof; i++)
       {
         // Get the index of the last entry below or on the diagonal in row i
-        unsigned diag_index = Index_of_diagonal_entries[i];
+        SparseOffset diag_index = Index_of_diagonal_entries[i];
 
         // Get the index of the first entry in row i
-        unsigned row_i_start = *(row_start_pt + i);
+        SparseOffset row_i_start = *(row_start_pt + i);
 
         // If there are no entries strictly below the diagonal then the
         // column index of the first entry in the i-th row will be greater
@@ -1738,7 +1749,7 @@ namespace oomph
           unsigned column_index = 0;
 
           // Loop over the entries below the diagonal
-          for (unsigned j = row_i_start; j < diag_index; j++)
+          for (SparseOffset j = row_i_start; j < diag_index; j++)
           {
             // Find the column index of this nonzero entry
             column_index = *(column_index_pt + j);
@@ -2124,6 +2135,628 @@ namespace oomph
   /// ////////////////////////////////////////////////////////////////////
 
 
+  //==================================================================
+  /// Solver: Takes pointer to problem and returns the results
+  /// vector which contains the solution of the linear system defined
+  /// by the problem's fully assembled Jacobian and residual vector.
+  //==================================================================
+  void ThreadedCRSmootherBase::solve(Problem* const& problem_pt,
+                                     DoubleVector& result)
+  {
+    // Reset the Use_as_smoother_flag as the solver is not being used
+    // as a smoother
+    Use_as_smoother = false;
+
+    // Find the # of degrees of freedom (variables)
+    unsigned n_dof = problem_pt->ndof();
+
+    // Initialise timer
+    double t_start = TimingHelpers::timer();
+
+    // We're not re-solving
+    Resolving = false;
+
+    // Get rid of any previously stored data
+    clean_up_memory();
+
+    // Set up the distribution
+    LinearAlgebraDistribution dist(problem_pt->communicator_pt(), n_dof, false);
+
+    // Assign the distribution to the LinearSolver
+    this->build_distribution(dist);
+
+    // Allocate space for the Jacobian matrix
+    CRDoubleMatrix* matrix_pt = new CRDoubleMatrix;
+
+    // Get the nonlinear residuals vector
+    DoubleVector f;
+
+    // Assign the Jacobian and the residuals vector
+    problem_pt->get_jacobian(f, *matrix_pt);
+
+    // Store the matrix and set up the smoother-specific data
+    store_matrix_and_setup(matrix_pt);
+
+    // We've made the matrix, we can delete it...
+    Matrix_can_be_deleted = true;
+
+    // Doc time for setup
+    double t_end = TimingHelpers::timer();
+    Jacobian_setup_time = t_end - t_start;
+
+    // If time documentation is enabled
+    if (Doc_time)
+    {
+      oomph_info << "Time for setup of Jacobian [sec]: " << Jacobian_setup_time
+                 << std::endl;
+    }
+
+    // Call linear algebra-style solver
+    solve_helper(f, result);
+
+    // Kill matrix unless it's still required for resolve
+    if (!Enable_resolve) clean_up_memory();
+  } // End of solve
+
+  //==================================================================
+  /// Cast the matrix to a CRDoubleMatrix, check that it can be
+  /// handled and set up the smoother-specific data
+  //==================================================================
+  void ThreadedCRSmootherBase::store_matrix_and_setup(
+    DoubleMatrixBase* matrix_pt)
+  {
+    // Upcast to the appropriate matrix type
+    Matrix_pt = dynamic_cast<CRDoubleMatrix*>(matrix_pt);
+
+#ifdef PARANOID
+    // Make sure we've got a CRDoubleMatrix
+    if (Matrix_pt == 0)
+    {
+      throw OomphLibError("The smoother can only be used with CRDoubleMatrices",
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+
+    // Make sure the matrix is square
+    if (Matrix_pt->nrow() != Matrix_pt->ncol())
+    {
+      std::ostringstream error_message_stream;
+      error_message_stream << "The matrix must be square but it has "
+                           << Matrix_pt->nrow() << " rows and "
+                           << Matrix_pt->ncol() << " columns.";
+      throw OomphLibError(error_message_stream.str(),
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    // The sweeps operate on the local rows with global column indices
+    // so we can't deal with matrices that are distributed over several
+    // processors
+    if (Matrix_pt->distributed() &&
+        (Matrix_pt->distribution_pt()->communicator_pt()->nproc() > 1))
+    {
+      throw OomphLibError(
+        "The threaded smoothers cannot be used with distributed matrices",
+        OOMPH_CURRENT_FUNCTION,
+        OOMPH_EXCEPTION_LOCATION);
+    }
+
+    // Set up the smoother-specific data
+    setup_helper();
+  } // End of store_matrix_and_setup
+
+  //==================================================================
+  /// Extract the reciprocals of the diagonal entries of Matrix_pt
+  /// and store them in Inverse_diagonal
+  //==================================================================
+  void ThreadedCRSmootherBase::setup_inverse_diagonal()
+  {
+    // Get the diagonal entries
+    Inverse_diagonal = Matrix_pt->diagonal_entries();
+
+    // Invert them
+    unsigned n_row = Inverse_diagonal.size();
+    for (unsigned i = 0; i < n_row; i++)
+    {
+      if (Inverse_diagonal[i] == 0.0)
+      {
+        std::ostringstream error_message_stream;
+        error_message_stream << "Zero diagonal entry in row " << i
+                             << " of the matrix.";
+        throw OomphLibError(error_message_stream.str(),
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+      Inverse_diagonal[i] = 1.0 / Inverse_diagonal[i];
+    }
+  } // End of setup_inverse_diagonal
+
+  //==================================================================
+  /// Compute soln=Matrix_pt*x with a row-parallel loop
+  //==================================================================
+  void ThreadedCRSmootherBase::threaded_multiply(const double* const x_pt,
+                                                 double* const soln_pt)
+  {
+    int n_row = Matrix_pt->nrow();
+    const SparseOffset* row_start = Matrix_pt->row_start();
+    const int* column_index = Matrix_pt->column_index();
+    const double* value = Matrix_pt->value();
+
+#ifdef _OPENMP
+#pragma omp parallel for if (n_row > 256)
+#endif
+    for (int i = 0; i < n_row; i++)
+    {
+      double t = 0.0;
+      for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
+      {
+        t += value[k] * x_pt[column_index[k]];
+      }
+      soln_pt[i] = t;
+    }
+  } // End of threaded_multiply
+
+  //==================================================================
+  /// Perform Max_iter smoothing iterations and, if the smoother is
+  /// not used as a smoother, monitor the convergence
+  //==================================================================
+  void ThreadedCRSmootherBase::solve_helper(const DoubleVector& rhs,
+                                            DoubleVector& solution)
+  {
+#ifdef PARANOID
+    // PARANOID Run the self-tests to check the inputs are correct
+    unsigned n_dof = rhs.nrow();
+    this->check_validity_of_solve_helper_inputs<CRDoubleMatrix>(
+      Matrix_pt, rhs, solution, n_dof);
+#endif
+
+    // Setup the solution if it is not
+    if (!solution.distribution_pt()->built())
+    {
+      solution.build(this->distribution_pt(), 0.0);
+    }
+    // If we're inside the multigrid solver we smooth the current
+    // approximation so the solution must only be reset if we're NOT
+    // inside the multigrid solver
+    else if (!Use_as_smoother)
+    {
+      solution.initialise(0.0);
+    }
+
+    // Initialise timer
+    double t_start = TimingHelpers::timer();
+
+    // Create a vector to hold the residual. This will only be built if
+    // we're not inside the multigrid solver
+    DoubleVector local_residual;
+
+    // Variable to store the 2-norm of the residual vector. Only used
+    // if we are not working inside the MG solver
+    double norm_res = 0.0;
+
+    // Variables to hold the initial residual norm. Only used if we're
+    // not inside the multigrid solver
+    double norm_f = 0.0;
+
+    // Initialise the value of Iterations
+    Iterations = 0;
+
+    // Calculate the residual only if we're not inside the multigrid solver
+    if (!Use_as_smoother)
+    {
+      // Build the local residual vector
+      local_residual.build(this->distribution_pt(), 0.0);
+
+      // Calculate the residual vector and its 2-norm
+      Matrix_pt->residual(solution, rhs, local_residual);
+      norm_res = local_residual.norm();
+      norm_f = norm_res;
+
+      // If required will document convergence history to screen
+      // or file (if stream is open)
+      if (Doc_convergence_history)
+      {
+        if (!Output_file_stream.is_open())
+        {
+          oomph_info << Iterations << " " << norm_res << std::endl;
+        }
+        else
+        {
+          Output_file_stream << Iterations << " " << norm_res << std::endl;
+        }
+      } // if (Doc_convergence_history)
+    } // if (!Use_as_smoother)
+
+    // Outermost loop: Run up to Max_iter times (the iteration number)
+    for (unsigned iter_num = 0; iter_num < Max_iter; iter_num++)
+    {
+      // Do a smoothing iteration
+      smoothing_iteration(rhs, solution);
+
+      // Increment the value of Iterations
+      Iterations++;
+
+      // Calculate the residual only if we're not inside the multigrid solver
+      if (!Use_as_smoother)
+      {
+        // Get the relative norm of the residual r=b-Ax
+        Matrix_pt->residual(solution, rhs, local_residual);
+        norm_res = local_residual.norm() / norm_f;
+
+        // If required, this will document convergence history to
+        // screen or file (if the stream is open)
+        if (Doc_convergence_history)
+        {
+          if (!Output_file_stream.is_open())
+          {
+            oomph_info << Iterations << " " << norm_res << std::endl;
+          }
+          else
+          {
+            Output_file_stream << Iterations << " " << norm_res << std::endl;
+          }
+        } // if (Doc_convergence_history)
+
+        // Check the tolerance only if the residual norm is being computed
+        if (norm_res < Tolerance)
+        {
+          break;
+        }
+      } // if (!Use_as_smoother)
+    } // for (unsigned iter_num=0;iter_num<Max_iter;iter_num++)
+
+    // Doc. time for solver
+    double t_end = TimingHelpers::timer();
+    Solution_time = t_end - t_start;
+    if ((!Use_as_smoother) && (Doc_time))
+    {
+      oomph_info << "\n"
+                 << smoother_name() << " converged. Residual norm: " << norm_res
+                 << "\nNumber of iterations to convergence: " << Iterations
+                 << "\n"
+                 << std::endl;
+      oomph_info << "Time for solve with " << smoother_name()
+                 << " [sec]: " << Solution_time << std::endl;
+    }
+
+    // If the solver failed to converge and the user asked for an error if
+    // this happened
+    if ((!Use_as_smoother) && (norm_res >= Tolerance) &&
+        (Throw_error_after_max_iter))
+    {
+      std::string error_message =
+        "Solver failed to converge and you requested ";
+      error_message += "an error on convergence failures.";
+      throw OomphLibError(
+        error_message, OOMPH_EXCEPTION_LOCATION, OOMPH_CURRENT_FUNCTION);
+    }
+  } // End of solve_helper
+
+
+  /// ////////////////////////////////////////////////////////////////////
+  /// ////////////////////////////////////////////////////////////////////
+  /// ////////////////////////////////////////////////////////////////////
+
+
+  //==================================================================
+  /// Set up the multicolour Gauss-Seidel smoother: Colour the graph
+  /// of the symmetrised sparsity pattern greedily (in row order) and
+  /// sort the rows by colour
+  //==================================================================
+  void MulticolourGS::setup_helper()
+  {
+    // Get the inverse of the diagonal entries
+    setup_inverse_diagonal();
+
+    // Get the matrix data
+    unsigned n_row = Matrix_pt->nrow();
+    const SparseOffset* row_start = Matrix_pt->row_start();
+    const int* column_index = Matrix_pt->column_index();
+
+    // Build the adjacency structure of the symmetrised pattern: count
+    // the off-diagonal entries of A and A^T in each row...
+    Vector<unsigned> adjacency_start(n_row + 1, 0);
+    for (unsigned i = 0; i < n_row; i++)
+    {
+      for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
+      {
+        unsigned j = column_index[k];
+        if (j != i)
+        {
+          adjacency_start[i + 1]++;
+          adjacency_start[j + 1]++;
+        }
+      }
+    }
+    for (unsigned i = 0; i < n_row; i++)
+    {
+      adjacency_start[i + 1] += adjacency_start[i];
+    }
+
+    // ...and fill them in (duplicates don't matter for the colouring)
+    Vector<unsigned> adjacency(adjacency_start[n_row]);
+    Vector<unsigned> next;
+    next.assign(adjacency_start.begin(), adjacency_start.end() - 1);
+    for (unsigned i = 0; i < n_row; i++)
+    {
+      for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
+      {
+        unsigned j = column_index[k];
+        if (j != i)
+        {
+          adjacency[next[i]++] = j;
+          adjacency[next[j]++] = i;
+        }
+      }
+    }
+
+    // Greedy colouring: give each row the smallest colour that is not
+    // used by any of its (already coloured) neighbours. Colour_of_row is
+    // -1 for rows that haven't been coloured yet; last_used_by[c]=i+1
+    // flags that colour c is used by a neighbour of row i.
+    Vector<int> colour_of_row(n_row, -1);
+    Vector<unsigned> last_used_by;
+    unsigned n_colour = 0;
+    for (unsigned i = 0; i < n_row; i++)
+    {
+      for (unsigned k = adjacency_start[i]; k < adjacency_start[i + 1]; k++)
+      {
+        int c = colour_of_row[adjacency[k]];
+        if (c >= 0)
+        {
+          last_used_by[c] = i + 1;
+        }
+      }
+      unsigned c = 0;
+      while ((c < n_colour) && (last_used_by[c] == i + 1))
+      {
+        c++;
+      }
+      if (c == n_colour)
+      {
+        n_colour++;
+        last_used_by.push_back(0);
+      }
+      colour_of_row[i] = c;
+    }
+
+    // Sort the rows by colour
+    Colour_start.assign(n_colour + 1, 0);
+    for (unsigned i = 0; i < n_row; i++)
+    {
+      Colour_start[colour_of_row[i] + 1]++;
+    }
+    for (unsigned c = 0; c < n_colour; c++)
+    {
+      Colour_start[c + 1] += Colour_start[c];
+    }
+    Colour_row.resize(n_row);
+    next.assign(Colour_start.begin(), Colour_start.end() - 1);
+    for (unsigned i = 0; i < n_row; i++)
+    {
+      Colour_row[next[colour_of_row[i]]++] = i;
+    }
+  } // End of setup_helper
+
+  //==================================================================
+  /// Update all rows of the given colour. The rows of one colour are
+  /// not coupled so they can be updated concurrently.
+  //==================================================================
+  void MulticolourGS::relax_colour(const unsigned& colour,
+                                   const double* const rhs_pt,
+                                   double* const x_pt)
+  {
+    const SparseOffset* row_start = Matrix_pt->row_start();
+    const int* column_index = Matrix_pt->column_index();
+    const double* value = Matrix_pt->value();
+    const double* inv_diag_pt = &Inverse_diagonal[0];
+    const unsigned* colour_row_pt = &Colour_row[0];
+
+    int first = Colour_start[colour];
+    int last = Colour_start[colour + 1];
+#ifdef _OPENMP
+#pragma omp parallel for if (last - first > 256)
+#endif
+    for (int m = first; m < last; m++)
+    {
+      int i = colour_row_pt[m];
+      double t = rhs_pt[i];
+      for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
+      {
+        int j = column_index[k];
+        if (j != i)
+        {
+          t -= value[k] * x_pt[j];
+        }
+      }
+      x_pt[i] = t * inv_diag_pt[i];
+    }
+  } // End of relax_colour
+
+  //==================================================================
+  /// Perform one (forward or symmetric) multicolour sweep
+  //==================================================================
+  void MulticolourGS::smoothing_iteration(const DoubleVector& rhs,
+                                          DoubleVector& x)
+  {
+    // Nothing to do for an empty matrix
+    unsigned n_colour = ncolour();
+    if (n_colour == 0) return;
+
+    const double* rhs_pt = rhs.values_pt();
+    double* x_pt = x.values_pt();
+
+    // Forward sweep
+    for (unsigned c = 0; c < n_colour; c++)
+    {
+      relax_colour(c, rhs_pt, x_pt);
+    }
+
+    // Backward sweep (the last colour has just been updated)
+    if (Symmetric_sweep)
+    {
+      for (int c = int(n_colour) - 2; c >= 0; c--)
+      {
+        relax_colour(c, rhs_pt, x_pt);
+      }
+    }
+  } // End of smoothing_iteration
+
+
+  /// ////////////////////////////////////////////////////////////////////
+  /// ////////////////////////////////////////////////////////////////////
+  /// ////////////////////////////////////////////////////////////////////
+
+
+  //==================================================================
+  /// Set up the Chebyshev smoother: Get the inverse diagonal and
+  /// estimate the largest eigenvalue of inv(D)*A by power iteration
+  //==================================================================
+  void Chebyshev::setup_helper()
+  {
+    // Get the inverse of the diagonal entries
+    setup_inverse_diagonal();
+
+    // Set up the work vectors
+    int n_row = Matrix_pt->nrow();
+    Residual.assign(n_row, 0.0);
+    Direction.assign(n_row, 0.0);
+    Work.assign(n_row, 0.0);
+    if (n_row == 0) return;
+
+    // Start the power iteration with a (deterministic) pseudo-random
+    // vector so that it has components in the direction of the
+    // eigenvectors at the upper end of the spectrum
+    double* v_pt = &Direction[0];
+    double* w_pt = &Work[0];
+    const double* inv_diag_pt = &Inverse_diagonal[0];
+    double norm = 0.0;
+    for (int i = 0; i < n_row; i++)
+    {
+      v_pt[i] = double((7919 * long(i) + 13) % 1009) / 1009.0 - 0.5;
+      norm += v_pt[i] * v_pt[i];
+    }
+    norm = sqrt(norm);
+    for (int i = 0; i < n_row; i++)
+    {
+      v_pt[i] /= norm;
+    }
+
+    // Do the power iterations with w=inv(D)*A*v
+    Max_eigenvalue = 0.0;
+    for (unsigned iter = 0; iter < N_power_iteration; iter++)
+    {
+      threaded_multiply(v_pt, w_pt);
+      norm = 0.0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : norm) if (n_row > 256)
+#endif
+      for (int i = 0; i < n_row; i++)
+      {
+        w_pt[i] *= inv_diag_pt[i];
+        norm += w_pt[i] * w_pt[i];
+      }
+      norm = sqrt(norm);
+
+      // Bail out if we've hit the null space
+      if (norm == 0.0) break;
+
+      Max_eigenvalue = norm;
+#ifdef _OPENMP
+#pragma omp parallel for if (n_row > 256)
+#endif
+      for (int i = 0; i < n_row; i++)
+      {
+        v_pt[i] = w_pt[i] / norm;
+      }
+    }
+
+    // Make sure we've got a usable estimate
+    if (Max_eigenvalue == 0.0)
+    {
+      throw OomphLibError(
+        "Estimate of the largest eigenvalue of inv(D)*A is zero",
+        OOMPH_CURRENT_FUNCTION,
+        OOMPH_EXCEPTION_LOCATION);
+    }
+  } // End of setup_helper
+
+  //==================================================================
+  /// Apply one Chebyshev polynomial in inv(D)*A (e.g. Saad, "Iterative
+  /// methods for sparse linear systems", Algorithm 12.1) to the system
+  /// Matrix_pt*x=rhs
+  //==================================================================
+  void Chebyshev::smoothing_iteration(const DoubleVector& rhs, DoubleVector& x)
+  {
+    int n_row = Matrix_pt->nrow();
+    if (n_row == 0) return;
+
+    // The targeted eigenvalue interval [a,b]
+    double b = Upper_bound_factor * Max_eigenvalue;
+    double a = Max_eigenvalue / Eigenvalue_ratio;
+
+    // Centre and half-width of the interval
+    double theta = 0.5 * (b + a);
+    double delta = 0.5 * (b - a);
+    double sigma = theta / delta;
+    double rho = 1.0 / sigma;
+
+    const double* rhs_pt = rhs.values_pt();
+    double* x_pt = x.values_pt();
+    double* r_pt = &Residual[0];
+    double* d_pt = &Direction[0];
+    double* w_pt = &Work[0];
+    const double* inv_diag_pt = &Inverse_diagonal[0];
+
+    // Preconditioned residual r=inv(D)*(b-A*x) and first direction
+    threaded_multiply(x_pt, w_pt);
+#ifdef _OPENMP
+#pragma omp parallel for if (n_row > 256)
+#endif
+    for (int i = 0; i < n_row; i++)
+    {
+      r_pt[i] = inv_diag_pt[i] * (rhs_pt[i] - w_pt[i]);
+      d_pt[i] = r_pt[i] / theta;
+    }
+
+    for (unsigned k = 0; k < Degree; k++)
+    {
+      // Update the solution
+#ifdef _OPENMP
+#pragma omp parallel for if (n_row > 256)
+#endif
+      for (int i = 0; i < n_row; i++)
+      {
+        x_pt[i] += d_pt[i];
+      }
+
+      // We're done after the last update
+      if (k + 1 == Degree) break;
+
+      // Update the residual and the direction
+      threaded_multiply(d_pt, w_pt);
+      double rho_new = 1.0 / (2.0 * sigma - rho);
+      double c_d = rho_new * rho;
+      double c_r = 2.0 * rho_new / delta;
+#ifdef _OPENMP
+#pragma omp parallel for if (n_row > 256)
+#endif
+      for (int i = 0; i < n_row; i++)
+      {
+        r_pt[i] -= inv_diag_pt[i] * w_pt[i];
+        d_pt[i] = c_d * d_pt[i] + c_r * r_pt[i];
+      }
+      rho = rho_new;
+    }
+  } // End of smoothing_iteration
+
+
+  /// ////////////////////////////////////////////////////////////////////
+  /// ////////////////////////////////////////////////////////////////////
+  /// ////////////////////////////////////////////////////////////////////
+
+
   //==================================================================
   /// \Short Re-solve the system defined by the last assembled Jacobian
   /// and the rhs vector specified here. Solution is returned in
@@ -2363,6 +2996,10 @@ namespace oomph
         double t_end_prec = TimingHelpers::timer();
         Preconditioner_setup_time = t_end_prec - t_start_prec;
 
+        // Record the memory usage while the matrix and the
+        // preconditioner are both held in memory
+        record_memory_usage_of_solve(matrix_pt);
+
         if (Doc_time)
         {
           oomph_info << "Time for setup of preconditioner  [sec]: "
@@ -3002,6 +3639,10 @@ namespace oomph
         double t_end_prec = TimingHelpers::timer();
         Preconditioner_setup_time = t_end_prec - t_start_prec;
 
+        // Record the memory usage while the matrix and the
+        // preconditioner are both held in memory
+        record_memory_usage_of_solve(input_matrix_pt);
+
         // If we're meant to document timings
         if (Doc_time)
         {
@@ -3542,4 +4183,10 @@ namespace oomph
   template class CG<SumOfMatrices>;
   template class GS<SumOfMatrices>;
   template class GMRES<SumOfMatrices>;
+
+  // Solvers for block compressed row matrices (which only provide
+  // matrix-vector products)
+  template class BiCGStab<BlockCRDoubleMatrix>;
+  template class CG<BlockCRDoubleMatrix>;
+  template class GMRES<BlockCRDoubleMatrix>;
 } // namespace oomph
@@ -222,7 +222,30 @@ namespace oomph
       Use_iterative_solver_as_preconditioner = false;
     }
 
+    /// Add the memory held by the preconditioner to the account
+    /// (its categories are prefixed by "preconditioner:")
+    void get_memory_usage(MemoryAccount& account)
+    {
+      MemoryAccount preconditioner_account;
+      Preconditioner_pt->get_memory_usage(preconditioner_account);
+      account.add(preconditioner_account, "preconditioner:");
+    }
+
   protected:
+    /// Record the memory held by the matrix (category "jacobian")
+    /// and by the preconditioner after the preconditioner has been set
+    /// up for it, i.e. at the peak of the solve
+    void record_memory_usage_of_solve(DoubleMatrixBase* const& matrix_pt)
+    {
+      Memory_usage_of_last_solve.clear();
+      CRDoubleMatrix* cr_matrix_pt = dynamic_cast<CRDoubleMatrix*>(matrix_pt);
+      if (cr_matrix_pt != 0)
+      {
+        cr_matrix_pt->get_memory_usage(Memory_usage_of_last_solve, "jacobian");
+      }
+      get_memory_usage(Memory_usage_of_last_solve);
+    }
+
     /// Flag indicating if the convergence history is to be
     /// documented
     bool Doc_convergence_history;
@@ -985,7 +1008,7 @@ namespace oomph
 
     /// Vector whose i'th entry contains the index of the last entry
     /// below or on the diagonal of the i'th row of the matrix
-    Vector<int> Index_of_diagonal_entries;
+    Vector<SparseOffset> Index_of_diagonal_entries;
   };
 
   /// ////////////////////////////////////////////////////////////////////
@@ -1002,7 +1025,11 @@ namespace oomph
   {
   public:
     /// Empty constructor
-    DampedJacobi(const double& omega = 2.0 / 3.0) : Matrix_can_be_deleted(true)
+    DampedJacobi(const double& omega = 2.0 / 3.0)
+      : Matrix_pt(0),
+        Resolving(false),
+        Matrix_can_be_deleted(true),
+        Iterations(0)
     {
       // Damping factor
       Omega = omega;
@@ -1061,7 +1088,7 @@ namespace oomph
         // of the iterative scheme so we can store it and call it in each
         // iteration)
         Matrix_diagonal =
-          dynamic_cast<CRDoubleMatrix*>(Matrix_pt)->diagonal_entries();
+          dynamic_cast<CRDoubleMatrix*>(matrix_pt)->diagonal_entries();
       }
       // If we're using a complex matrix then diagonal entries has to be a
       // complex vector rather than a vector of doubles.
@@ -1086,13 +1113,14 @@ namespace oomph
       else
       {
         // Calculate the number of rows in the matrix
-        unsigned n_row = Matrix_pt->nrow();
+        unsigned n_row = matrix_pt->nrow();
 
         // Loop over the rows of the matrix
+        Matrix_diagonal.resize(n_row);
         for (unsigned i = 0; i < n_row; i++)
         {
           // Assign the i-th value of Matrix_diagonal
-          Matrix_diagonal[i] = (*Matrix_pt)(i, i);
+          Matrix_diagonal[i] = (*matrix_pt)(i, i);
         }
       } // if (dynamic_cast<CRDoubleMatrix*>(matrix_pt))
 
@@ -1219,6 +1247,405 @@ namespace oomph
   /// ////////////////////////////////////////////////////////////////////
 
 
+  //======================================================================
+  /// Base class for smoothers that operate directly on the compressed
+  /// row storage of a (non-distributed) CRDoubleMatrix and whose sweeps
+  /// can be executed concurrently by several threads. The class provides
+  /// the IterativeLinearSolver/Smoother interfaces, the storage of the
+  /// matrix and the (optional) convergence check; derived classes only
+  /// need to set up their data for the matrix (setup_helper()) and
+  /// perform a single smoothing iteration (smoothing_iteration()).
+  /// The loops are parallelised with OpenMP if the library is compiled
+  /// with OpenMP enabled; otherwise they run serially.
+  //======================================================================
+  class ThreadedCRSmootherBase : public virtual Smoother
+  {
+  public:
+    /// Constructor
+    ThreadedCRSmootherBase()
+      : Matrix_pt(0),
+        Iterations(0),
+        Resolving(false),
+        Matrix_can_be_deleted(true)
+    {
+    }
+
+    /// Destructor (cleanup storage)
+    virtual ~ThreadedCRSmootherBase()
+    {
+      clean_up_memory();
+    }
+
+    /// Broken copy constructor
+    ThreadedCRSmootherBase(const ThreadedCRSmootherBase&) = delete;
+
+    /// Broken assignment operator
+    void operator=(const ThreadedCRSmootherBase&) = delete;
+
+    /// The smoother_solve function performs fixed number of iterations
+    /// on the system A*result=rhs. The number of (smoothing) iterations is
+    /// the same as the max. number of iterations in the underlying
+    /// IterativeLinearSolver class.
+    void smoother_solve(const DoubleVector& rhs, DoubleVector& result)
+    {
+      // If you use a smoother but you don't want to calculate the residual
+      Use_as_smoother = true;
+
+      // Call the helper function
+      solve_helper(rhs, result);
+    } // End of smoother_solve
+
+    /// Set up the smoother for the matrix specified by the pointer
+    void smoother_setup(DoubleMatrixBase* matrix_pt)
+    {
+      // Get rid of any previously stored data
+      clean_up_memory();
+
+      // Assume the matrix has been passed in from the outside so we must
+      // not delete it (the pre- and post-smoothers in the MG solver share
+      // the same matrix)
+      Matrix_can_be_deleted = false;
+
+      // Store the matrix and set up the smoother-specific data
+      store_matrix_and_setup(matrix_pt);
+    } // End of smoother_setup
+
+    /// Overload disable resolve so that it cleans up memory too
+    void disable_resolve()
+    {
+      LinearSolver::disable_resolve();
+      clean_up_memory();
+    } // End of disable_resolve
+
+    /// Solver: Takes pointer to problem and returns the results vector
+    /// which contains the solution of the linear system defined by
+    /// the problem's fully assembled Jacobian and residual vector.
+    void solve(Problem* const& problem_pt, DoubleVector& result);
+
+    /// Linear-algebra-type solver: Takes pointer to a matrix and rhs
+    /// vector and returns the solution of the linear system.
+    void solve(DoubleMatrixBase* const& matrix_pt,
+               const DoubleVector& rhs,
+               DoubleVector& solution)
+    {
+      // Reset the Use_as_smoother_flag as the solver is not being used
+      // as a smoother
+      Use_as_smoother = false;
+
+      // Set up the distribution
+      this->build_distribution(rhs.distribution_pt());
+
+      // Set up the smoother for this matrix unless we're re-solving
+      if (!Resolving)
+      {
+        // Get rid of any previously stored data
+        clean_up_memory();
+
+        // Matrix has been passed in from the outside so we must not
+        // delete it
+        Matrix_can_be_deleted = false;
+
+        // Store the matrix and set up the smoother-specific data
+        store_matrix_and_setup(matrix_pt);
+      }
+
+      // Call the helper function
+      solve_helper(rhs, solution);
+    } // End of solve
+
+    /// Linear-algebra-type solver: Takes pointer to a matrix
+    /// and rhs vector and returns the solution of the linear system
+    /// Call the broken base-class version. If you want this, please
+    /// implement it
+    void solve(DoubleMatrixBase* const& matrix_pt,
+               const Vector<double>& rhs,
+               Vector<double>& result)
+    {
+      LinearSolver::solve(matrix_pt, rhs, result);
+    } // End of solve
+
+    /// Re-solve the system defined by the last assembled Jacobian
+    /// and the rhs vector specified here. Solution is returned in the
+    /// vector result.
+    void resolve(const DoubleVector& rhs, DoubleVector& result)
+    {
+      // We are re-solving
+      Resolving = true;
+
+#ifdef PARANOID
+      // If the matrix pointer is null
+      if (Matrix_pt == 0)
+      {
+        throw OomphLibError("No matrix was stored -- cannot re-solve",
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+
+      // Call linear algebra-style solver
+      solve(Matrix_pt, rhs, result);
+
+      // Reset re-solving flag
+      Resolving = false;
+    } // End of resolve
+
+    /// Number of iterations taken
+    unsigned iterations() const
+    {
+      // Return the number of iterations
+      return Iterations;
+    } // End of iterations
+
+  protected:
+    /// Set up the smoother-specific data for the matrix pointed to
+    /// by Matrix_pt
+    virtual void setup_helper() = 0;
+
+    /// Perform a single smoothing iteration on the system
+    /// Matrix_pt*x=rhs, updating x in place
+    virtual void smoothing_iteration(const DoubleVector& rhs,
+                                     DoubleVector& x) = 0;
+
+    /// Name of the smoother (used in the timing output)
+    virtual std::string smoother_name() const = 0;
+
+    /// Extract the reciprocals of the diagonal entries of Matrix_pt
+    /// and store them in Inverse_diagonal
+    void setup_inverse_diagonal();
+
+    /// Compute soln=Matrix_pt*x with a row-parallel loop
+    void threaded_multiply(const double* const x_pt, double* const soln_pt);
+
+    /// System matrix pointer
+    CRDoubleMatrix* Matrix_pt;
+
+    /// Reciprocals of the diagonal entries of the matrix
+    Vector<double> Inverse_diagonal;
+
+  private:
+    /// Cast the matrix to a CRDoubleMatrix, check that it can be
+    /// handled and set up the smoother-specific data
+    void store_matrix_and_setup(DoubleMatrixBase* matrix_pt);
+
+    /// Perform Max_iter smoothing iterations and, if the smoother is
+    /// not used as a smoother, monitor the convergence
+    void solve_helper(const DoubleVector& rhs, DoubleVector& solution);
+
+    /// Clean up data that's stored for resolve (if any has been stored)
+    void clean_up_memory()
+    {
+      // If the matrix pointer isn't null AND we're allowed to delete the
+      // matrix which is only when we create the matrix ourselves
+      if ((Matrix_pt != 0) && (Matrix_can_be_deleted))
+      {
+        // Delete the matrix
+        delete Matrix_pt;
+      }
+
+      // Assign the associated pointer the value NULL
+      Matrix_pt = 0;
+    } // End of clean_up_memory
+
+    /// Number of iterations taken
+    unsigned Iterations;
+
+    /// Boolean flag to indicate if the solve is done in re-solve mode,
+    /// bypassing setup of matrix and preconditioner
+    bool Resolving;
+
+    /// Boolean flag to indicate if the matrix pointed to be Matrix_pt
+    /// can be deleted.
+    bool Matrix_can_be_deleted;
+  };
+
+
+  /// ////////////////////////////////////////////////////////////////////
+  /// ////////////////////////////////////////////////////////////////////
+  /// ////////////////////////////////////////////////////////////////////
+
+
+  //======================================================================
+  /// Multicolour Gauss-Seidel smoother for CRDoubleMatrices. The rows
+  /// of the matrix are coloured greedily using the graph of the
+  /// symmetrised sparsity pattern so that no two rows of the same
+  /// colour are coupled. A sweep visits the colours in turn and the
+  /// rows within each colour are updated concurrently. By default each
+  /// iteration is a forward sweep; a symmetric sweep (forward followed
+  /// by backward colour order) can be selected instead.
+  //======================================================================
+  class MulticolourGS : public ThreadedCRSmootherBase
+  {
+  public:
+    /// Constructor
+    MulticolourGS() : Symmetric_sweep(false) {}
+
+    /// Broken copy constructor
+    MulticolourGS(const MulticolourGS&) = delete;
+
+    /// Broken assignment operator
+    void operator=(const MulticolourGS&) = delete;
+
+    /// Do a forward and a backward colour sweep in each iteration
+    void enable_symmetric_sweep()
+    {
+      Symmetric_sweep = true;
+    }
+
+    /// Only do a forward colour sweep in each iteration (default)
+    void disable_symmetric_sweep()
+    {
+      Symmetric_sweep = false;
+    }
+
+    /// Number of colours used by the current colouring
+    unsigned ncolour() const
+    {
+      return Colour_start.size() == 0 ? 0 : Colour_start.size() - 1;
+    }
+
+  protected:
+    /// Compute the colouring and the inverse diagonal
+    void setup_helper();
+
+    /// Perform one (forward or symmetric) multicolour sweep
+    void smoothing_iteration(const DoubleVector& rhs, DoubleVector& x);
+
+    /// Name of the smoother
+    std::string smoother_name() const
+    {
+      return "multicolour Gauss Seidel";
+    }
+
+  private:
+    /// Update all rows of the given colour
+    void relax_colour(const unsigned& colour,
+                      const double* const rhs_pt,
+                      double* const x_pt);
+
+    /// Rows of colour c are Colour_row[Colour_start[c]] ...
+    /// Colour_row[Colour_start[c+1]-1]
+    Vector<unsigned> Colour_start;
+
+    /// Rows of the matrix sorted by colour
+    Vector<unsigned> Colour_row;
+
+    /// Flag to indicate that a backward colour sweep is done after
+    /// the forward one
+    bool Symmetric_sweep;
+  };
+
+
+  /// ////////////////////////////////////////////////////////////////////
+  /// ////////////////////////////////////////////////////////////////////
+  /// ////////////////////////////////////////////////////////////////////
+
+
+  //======================================================================
+  /// Chebyshev polynomial smoother for CRDoubleMatrices. Each
+  /// iteration applies the Chebyshev polynomial of degree Degree in the
+  /// Jacobi-preconditioned operator inv(D)*A that damps the part of the
+  /// spectrum in [lambda_max/Eigenvalue_ratio, Upper_bound_factor *
+  /// lambda_max]. The largest eigenvalue, lambda_max, is estimated
+  /// during the setup by a few power iterations. The smoother only
+  /// requires matrix-vector products and vector updates so all of its
+  /// work is done in parallel loops. The matrix should be symmetric
+  /// positive definite (or at least have a real, positive spectrum).
+  //======================================================================
+  class Chebyshev : public ThreadedCRSmootherBase
+  {
+  public:
+    /// Constructor: Specify the degree of the polynomial
+    Chebyshev(const unsigned& degree = 3)
+      : Degree(degree),
+        Eigenvalue_ratio(30.0),
+        Upper_bound_factor(1.1),
+        N_power_iteration(10),
+        Max_eigenvalue(0.0)
+    {
+    }
+
+    /// Broken copy constructor
+    Chebyshev(const Chebyshev&) = delete;
+
+    /// Broken assignment operator
+    void operator=(const Chebyshev&) = delete;
+
+    /// Access function to the degree of the Chebyshev polynomial
+    unsigned& degree()
+    {
+      return Degree;
+    }
+
+    /// Access function to the ratio between the upper and the lower
+    /// end of the targeted eigenvalue interval
+    double& eigenvalue_ratio()
+    {
+      return Eigenvalue_ratio;
+    }
+
+    /// Access function to the safety factor applied to the
+    /// estimate of the largest eigenvalue
+    double& upper_bound_factor()
+    {
+      return Upper_bound_factor;
+    }
+
+    /// Access function to the number of power iterations used to
+    /// estimate the largest eigenvalue of inv(D)*A
+    unsigned& n_power_iteration()
+    {
+      return N_power_iteration;
+    }
+
+    /// Estimate of the largest eigenvalue of inv(D)*A (computed
+    /// during the setup)
+    double max_eigenvalue_estimate() const
+    {
+      return Max_eigenvalue;
+    }
+
+  protected:
+    /// Compute the inverse diagonal and estimate the largest eigenvalue
+    void setup_helper();
+
+    /// Apply one Chebyshev polynomial
+    void smoothing_iteration(const DoubleVector& rhs, DoubleVector& x);
+
+    /// Name of the smoother
+    std::string smoother_name() const
+    {
+      return "Chebyshev";
+    }
+
+  private:
+    /// Degree of the Chebyshev polynomial applied in each iteration
+    unsigned Degree;
+
+    /// Ratio between the upper and the lower end of the targeted
+    /// eigenvalue interval
+    double Eigenvalue_ratio;
+
+    /// Safety factor applied to the estimate of the largest eigenvalue
+    double Upper_bound_factor;
+
+    /// Number of power iterations used to estimate the largest
+    /// eigenvalue
+    unsigned N_power_iteration;
+
+    /// Estimate of the largest eigenvalue of inv(D)*A
+    double Max_eigenvalue;
+
+    /// Work vectors (residual, search direction and matrix-vector
+    /// product) -- stored to avoid reallocating them in every iteration
+    Vector<double> Residual, Direction, Work;
+  };
+
+
+  /// ////////////////////////////////////////////////////////////////////
+  /// ////////////////////////////////////////////////////////////////////
+  /// ////////////////////////////////////////////////////////////////////
+
+
   //======================================================================
   /// The GMRES method.
   //======================================================================
@@ -61,7 +61,11 @@ namespace oomph
                    const Vector<Vector<double>>& coord_vec,
                    const double& max_search_radius = DBL_MAX)
       : Max_search_radius(max_search_radius),
-        Comm_pt(mesh_pt->communicator_pt())
+        Comm_pt(mesh_pt->communicator_pt()),
+        Mesh_pt(mesh_pt),
+        Nelement_when_located(0),
+        Element_storage_generation_when_located(0),
+        Automatic_revalidation(false)
     {
       // Do the actual work
       setup(mesh_pt, coord_vec);
@@ -75,7 +79,12 @@ namespace oomph
     LineVisualiser(Mesh* mesh_pt,
                    const std::string file_name,
                    const double& scale = 1.0)
-      : Max_search_radius(DBL_MAX), Comm_pt(mesh_pt->communicator_pt())
+      : Max_search_radius(DBL_MAX),
+        Comm_pt(mesh_pt->communicator_pt()),
+        Mesh_pt(mesh_pt),
+        Nelement_when_located(0),
+        Element_storage_generation_when_located(0),
+        Automatic_revalidation(false)
     {
       setup_from_file(mesh_pt, file_name, scale);
     }
@@ -95,12 +104,216 @@ namespace oomph
                    const std::string file_name,
                    const double& scale = 1.0)
       : Max_search_radius(max_search_radius),
-        Comm_pt(mesh_pt->communicator_pt())
+        Comm_pt(mesh_pt->communicator_pt()),
+        Mesh_pt(mesh_pt),
+        Nelement_when_located(0),
+        Element_storage_generation_when_located(0),
+        Automatic_revalidation(false)
     {
       setup_from_file(mesh_pt, file_name, scale);
     }
 
 
+    /// Helper function to create the coordinates of npts equally spaced
+    /// plot points on the straight line from start to end, for use
+    /// in the constructor. Consecutive points are usually located in the
+    /// same element, which makes their location cheap.
+    static void line_plot_points(const Vector<double>& start,
+                                 const Vector<double>& end,
+                                 const unsigned& npts,
+                                 Vector<Vector<double>>& coord_vec)
+    {
+      unsigned dim = start.size();
+      coord_vec.resize(npts);
+      for (unsigned j = 0; j < npts; j++)
+      {
+        double lambda = (npts > 1) ? double(j) / double(npts - 1) : 0.0;
+        coord_vec[j].resize(dim);
+        for (unsigned i = 0; i < dim; i++)
+        {
+          coord_vec[j][i] = start[i] + lambda * (end[i] - start[i]);
+        }
+      }
+    }
+
+
+    /// Helper function to create the coordinates of n0 x n1 plot points
+    /// on the parallelogram spanned by edge0 and edge1 from origin,
+    /// for use in the constructor. The points are enumerated
+    /// in "rows" along edge0, so consecutive points are usually located
+    /// in the same element.
+    static void plane_plot_points(const Vector<double>& origin,
+                                  const Vector<double>& edge0,
+                                  const Vector<double>& edge1,
+                                  const unsigned& n0,
+                                  const unsigned& n1,
+                                  Vector<Vector<double>>& coord_vec)
+    {
+      unsigned dim = origin.size();
+      coord_vec.resize(n0 * n1);
+      for (unsigned j1 = 0; j1 < n1; j1++)
+      {
+        double lambda1 = (n1 > 1) ? double(j1) / double(n1 - 1) : 0.0;
+        for (unsigned j0 = 0; j0 < n0; j0++)
+        {
+          double lambda0 = (n0 > 1) ? double(j0) / double(n0 - 1) : 0.0;
+          Vector<double>& x = coord_vec[j1 * n0 + j0];
+          x.resize(dim);
+          for (unsigned i = 0; i < dim; i++)
+          {
+            x[i] = origin[i] + lambda0 * edge0[i] + lambda1 * edge1[i];
+          }
+        }
+      }
+    }
+
+
+    /// Relocate all plot points in the mesh. Must be called after
+    /// the mesh has been adapted or rebuilt (the elements that contain the
+    /// plot points may have been deleted). This is done automatically
+    /// when output data is requested and the mesh has been adapted
+    /// (see Mesh::element_storage_generation()) since the plot points
+    /// were last located.
+    void relocate_plot_points()
+    {
+      // Forget the old elements: they may no longer exist
+      for (unsigned i = 0; i < Nplot_points; i++)
+      {
+        Plot_point[i].first = 0;
+        Plot_point_is_valid[i] = false;
+      }
+      if (Nplot_points == 0) return;
+      locate_plot_points();
+    }
+
+
+    /// Check that the stored elements and local coordinates of
+    /// the plot points still correspond to their coordinates (they won't
+    /// if the nodes have moved) and relocate those that don't, first by
+    /// a local search in the same element and then, if necessary, through
+    /// the mesh. Much cheaper than relocating all points if only a few
+    /// are affected. Returns the number of plot points that had to be
+    /// relocated. NOTE: this can't be used after mesh adaptation;
+    /// use relocate_plot_points() instead.
+    unsigned revalidate_plot_points(const double& tol = 1.0e-10)
+    {
+      unsigned n_invalid = 0;
+      for (unsigned i = 0; i < Nplot_points; i++)
+      {
+        FiniteElement* fe_pt = Plot_point[i].first;
+        if (fe_pt == 0) continue;
+
+        unsigned dim = Plot_point[i].second.size();
+        double dist = 0.0;
+        for (unsigned j = 0; j < dim; j++)
+        {
+          double dx = fe_pt->interpolated_x(Plot_point[i].second, j) -
+                      Plot_point_coordinates[i][j];
+          dist += dx * dx;
+        }
+        if (sqrt(dist) > tol)
+        {
+          n_invalid++;
+          Plot_point_is_valid[i] = false;
+        }
+      }
+
+      // Relocate the invalid ones (all processors have to take part
+      // because relocation involves communication)
+      unsigned n_invalid_global = n_invalid;
+#ifdef OOMPH_HAS_MPI
+      if ((Comm_pt != 0) && (Comm_pt->nproc() > 1))
+      {
+        MPI_Allreduce(&n_invalid,
+                      &n_invalid_global,
+                      1,
+                      MPI_UNSIGNED,
+                      MPI_SUM,
+                      Comm_pt->mpi_comm());
+      }
+#endif
+      if (n_invalid_global > 0)
+      {
+        locate_plot_points();
+      }
+      return n_invalid;
+    }
+
+
+    /// Revalidate the plot points (see revalidate_plot_points(...))
+    /// every time output data is requested. Use this if the mesh
+    /// moves.
+    void enable_automatic_revalidation()
+    {
+      Automatic_revalidation = true;
+    }
+
+
+    /// Don't revalidate the plot points every time output data is
+    /// requested (default).
+    void disable_automatic_revalidation()
+    {
+      Automatic_revalidation = false;
+    }
+
+
+    /// Record the data at all plot points at the specified time in
+    /// the internal time-series buffer. Much cheaper than output
+    /// to file at every time step; write the buffer with
+    /// output_time_series(...). NOTE: in a distributed problem, data is
+    /// only recorded on processor 0.
+    void record_time_series(const double& time)
+    {
+      Vector<Vector<double>> data;
+      get_output_data(data);
+
+      // Flat-pack the data for all plot points
+      Vector<double> flat_data;
+      for (unsigned i = 0; i < Nplot_points; i++)
+      {
+        flat_data.insert(flat_data.end(), data[i].begin(), data[i].end());
+      }
+      Time_series_time.push_back(time);
+      Time_series_data.push_back(flat_data);
+    }
+
+
+    /// Number of samples in the time-series buffer
+    unsigned ntime_series_sample() const
+    {
+      return Time_series_time.size();
+    }
+
+
+    /// Output the recorded time series in a single pass: one line per
+    /// recorded time, containing the time followed by the output data
+    /// for all plot points. The buffer is cleared afterwards (unless
+    /// clear_buffer is false) so this can be called periodically
+    /// during a run.
+    void output_time_series(std::ostream& outfile,
+                            const bool& clear_buffer = true)
+    {
+      unsigned n_sample = Time_series_time.size();
+      for (unsigned k = 0; k < n_sample; k++)
+      {
+        unsigned n_data = Time_series_data[k].size();
+        if (n_data == 0) continue;
+        outfile << Time_series_time[k];
+        for (unsigned j = 0; j < n_data; j++)
+        {
+          outfile << " " << Time_series_data[k][j];
+        }
+        outfile << std::endl;
+      }
+
+      if (clear_buffer)
+      {
+        Time_series_time.clear();
+        Time_series_data.clear();
+      }
+    }
+
+
     /// Output function: output each plot point.
     /// NOTE: in a distributed problem, output is only done
     /// on processor 0.
@@ -133,6 +346,9 @@ namespace oomph
     /// plot point in data array
     void get_output_data(Vector<Vector<double>>& data)
     {
+      // Make sure the plot points are still where they should be
+      update_plot_points_if_required();
+
       // Resize output data array
       data.resize(Nplot_points);
 
@@ -670,36 +886,96 @@ namespace oomph
       // Read out number of plot points
       Nplot_points = coord_vec.size();
 
+      // Store the coordinates so the points can be relocated later
+      Plot_point_coordinates = coord_vec;
+
+      // Make space; none of the points has been located yet
+      Plot_point.resize(Nplot_points);
+      Plot_point_is_valid.assign(Nplot_points, false);
+      for (unsigned i = 0; i < Nplot_points; i++)
+      {
+        Plot_point[i].first = 0;
+      }
+
       if (Nplot_points == 0) return;
 
+      // Do the actual work
+      locate_plot_points();
+    }
+
+
+    /// Helper function to (re-)locate all plot points that are not
+    /// known to be valid. Points are first sought in the element that
+    /// contained the point previously (if any), then in the element that
+    /// contains the previous plot point (so points along lines and
+    /// planes are cheap to locate), and only then through the
+    /// mesh. The bin structure required for the latter is only built
+    /// if it's actually needed.
+    void locate_plot_points()
+    {
       // Keep track of unlocated plot points
       unsigned count_not_found_local = 0;
 
       // Dimension
-      unsigned dim = coord_vec[0].size();
-
-      // Make space
-      Plot_point.resize(Nplot_points);
+      unsigned dim = Plot_point_coordinates[0].size();
 
-      // Transform mesh into a geometric object
-      MeshAsGeomObject mesh_geom_tmp(mesh_pt);
+      // Mesh as geometric object; only built if needed
+      MeshAsGeomObject* mesh_geom_tmp_pt = 0;
 
-      // Limit the search radius
-      mesh_geom_tmp.sample_point_container_pt()->max_search_radius() =
-        Max_search_radius;
+      // Element that contains the previous plot point
+      FiniteElement* previous_fe_pt = 0;
 
       // Loop over input points
       double tt_start = TimingHelpers::timer();
+      unsigned count_relocated = 0;
       for (unsigned i = 0; i < Nplot_points; i++)
       {
+        // Nothing to be done for points that are still valid
+        if (Plot_point_is_valid[i])
+        {
+          previous_fe_pt = Plot_point[i].first;
+          continue;
+        }
+        count_relocated++;
+
         // Local coordinate of the plot point with its element
         Vector<double> s(dim, 0.0);
 
         // Pointer to GeomObject that contains the plot point
         GeomObject* geom_pt = 0;
 
-        // Locate zeta
-        mesh_geom_tmp.locate_zeta(coord_vec[i], geom_pt, s);
+        // Try the element that contained it before (the mesh has moved),
+        // using the old local coordinate as the initial guess
+        if (Plot_point[i].first != 0)
+        {
+          s = Plot_point[i].second;
+          Plot_point[i].first->locate_zeta(
+            Plot_point_coordinates[i], geom_pt, s, true);
+        }
+
+        // Try the element that contains the previous plot point
+        if ((geom_pt == 0) && (previous_fe_pt != 0) &&
+            (previous_fe_pt != Plot_point[i].first))
+        {
+          previous_fe_pt->locate_zeta(Plot_point_coordinates[i], geom_pt, s);
+        }
+
+        // Search through the whole mesh
+        if (geom_pt == 0)
+        {
+          if (mesh_geom_tmp_pt == 0)
+          {
+            // Transform mesh into a geometric object
+            mesh_geom_tmp_pt = new MeshAsGeomObject(Mesh_pt);
+
+            // Limit the search radius
+            mesh_geom_tmp_pt->sample_point_container_pt()
+              ->max_search_radius() = Max_search_radius;
+          }
+
+          // Locate zeta
+          mesh_geom_tmp_pt->locate_zeta(Plot_point_coordinates[i], geom_pt, s);
+        }
 
         // Upcast GeomElement as a FiniteElement
         FiniteElement* fe_pt = dynamic_cast<FiniteElement*>(geom_pt);
@@ -708,21 +984,25 @@ namespace oomph
         if (fe_pt == 0)
         {
           count_not_found_local++;
-          /* oomph_info << "NOT Found the one at "  */
-          /*            << coord_vec[i][0] << " " */
-          /*            << coord_vec[i][1] << "\n"; */
         }
         else
         {
-          /* oomph_info << "Found the one at "  */
-          /*            << coord_vec[i][0] << " " */
-          /*            << coord_vec[i][1] << "\n"; */
+          previous_fe_pt = fe_pt;
         }
 
         // Save result in a pair
         Plot_point[i] = std::pair<FiniteElement*, Vector<double>>(fe_pt, s);
+        Plot_point_is_valid[i] = (fe_pt != 0);
       }
 
+      delete mesh_geom_tmp_pt;
+      mesh_geom_tmp_pt = 0;
+
+      // Remember the state of the mesh
+      Nelement_when_located = Mesh_pt->nelement();
+      Element_storage_generation_when_located =
+        Mesh_pt->element_storage_generation();
+
 
       oomph_info << "Number of points not found locally: "
                  << count_not_found_local << std::endl;
@@ -793,10 +1073,49 @@ namespace oomph
       }
       oomph_info << "Number of plot points not found (with max search radius="
                  << Max_search_radius << ")]: " << count_not_found
+                 << "\nNumber of plot points (re-)located: " << count_relocated
                  << "\nTotal time for LineVisualiser setup [sec]: "
                  << TimingHelpers::timer() - tt_start << std::endl;
     }
 
+
+    /// Helper function to relocate all plot points if the mesh has
+    /// been adapted (detected by a change in the generation of the mesh's
+    /// element storage or in the number of elements) and to revalidate
+    /// them if automatic revalidation is enabled.
+    void update_plot_points_if_required()
+    {
+      if (Nplot_points == 0) return;
+
+      // Has the mesh been adapted on any processor? (Adaptation can
+      // replace the elements without changing their number, so check
+      // the generation of the element storage too)
+      unsigned mesh_changed = (Mesh_pt->nelement() != Nelement_when_located) ||
+                              (Mesh_pt->element_storage_generation() !=
+                               Element_storage_generation_when_located);
+#ifdef OOMPH_HAS_MPI
+      if ((Comm_pt != 0) && (Comm_pt->nproc() > 1))
+      {
+        unsigned mesh_changed_local = mesh_changed;
+        MPI_Allreduce(&mesh_changed_local,
+                      &mesh_changed,
+                      1,
+                      MPI_UNSIGNED,
+                      MPI_MAX,
+                      Comm_pt->mpi_comm());
+      }
+#endif
+
+      if (mesh_changed)
+      {
+        relocate_plot_points();
+      }
+      else if (Automatic_revalidation)
+      {
+        revalidate_plot_points();
+      }
+    }
+
     // Get coordinates of found points
     void get_local_plot_points_coordinates(Vector<Vector<double>>& data)
     {
@@ -826,6 +1145,36 @@ namespace oomph
     /// Number of plot points
     unsigned Nplot_points;
 
+    /// Pointer to the mesh in which the plot points are located
+    Mesh* Mesh_pt;
+
+    /// Coordinates of the plot points (kept so the points can be
+    /// relocated after the mesh has moved or been adapted)
+    Vector<Vector<double>> Plot_point_coordinates;
+
+    /// Is the stored element/local coordinate of the plot point
+    /// still valid?
+    std::vector<bool> Plot_point_is_valid;
+
+    /// Number of elements in the mesh when the plot points were
+    /// last located (used to detect mesh adaptation)
+    unsigned long Nelement_when_located;
+
+    /// Generation of the mesh's element storage when the plot points
+    /// were last located (used to detect mesh adaptation that does not
+    /// change the number of elements)
+    unsigned long Element_storage_generation_when_located;
+
+    /// Revalidate the plot points every time output data is requested?
+    bool Automatic_revalidation;
+
+    /// Times at which the time series was recorded
+    Vector<double> Time_series_time;
+
+    /// Time series: flat-packed output data for all plot points at
+    /// the recorded times
+    Vector<Vector<double>> Time_series_data;
+
   }; // end of class
 
 } // namespace oomph
@@ -34,6 +34,8 @@
 #include "mpi.h"
 #endif
 
+#include <climits>
+
 // oomph-lib includes
 #include "Vector.h"
 #include "linear_solver.h"
@@ -1194,6 +1196,15 @@ namespace oomph
     // CRDoubleMatrix*
     cr_pt = dynamic_cast<CRDoubleMatrix*>(matrix_pt);
 
+    // Record the memory usage now, while the matrix and its LU factors
+    // are both held in memory
+    Memory_usage_of_last_solve.clear();
+    if (cr_pt != 0)
+    {
+      cr_pt->get_memory_usage(Memory_usage_of_last_solve, "jacobian");
+    }
+    get_memory_usage(Memory_usage_of_last_solve);
+
     // If the input matrix is a CRDoubleMatrix
     if (cr_pt != 0)
     {
@@ -1781,11 +1792,10 @@ namespace oomph
   //===================================================================
   void SuperLUSolver::factorise(DoubleMatrixBase* const& matrix_pt)
   {
-    // wipe memory
-    this->clean_up_memory();
-
-    // if we have mpi and the solver is distributed or default and nproc
-    // gt 1
+    // Use the serial SuperLU solver unless we have mpi and the solver
+    // is distributed or default and nproc gt 1, and the matrix is a
+    // distributed linear algebra object
+    bool use_dist = false;
 #ifdef OOMPH_HAS_MPI
     DistributableLinearAlgebraObject* dist_matrix_pt =
       dynamic_cast<DistributableLinearAlgebraObject*>(matrix_pt);
@@ -1794,21 +1804,30 @@ namespace oomph
     {
       nproc = dist_matrix_pt->distribution_pt()->communicator_pt()->nproc();
     }
-    if (Solver_type == Distributed || (Solver_type == Default && nproc > 1 &&
-                                       MPI_Helpers::mpi_has_been_initialised()))
+    if ((Solver_type == Distributed ||
+         (Solver_type == Default && nproc > 1 &&
+          MPI_Helpers::mpi_has_been_initialised())) &&
+        (dist_matrix_pt != 0))
     {
-      // if the matrix is a distributed linear algebra object then use SuperLU
-      // dist
-      if (dist_matrix_pt != 0)
-      {
-        factorise_distributed(matrix_pt);
-        Using_dist = true;
-      }
-      else
-      {
-        factorise_serial(matrix_pt);
-        Using_dist = false;
-      }
+      use_dist = true;
+    }
+#endif
+
+    // wipe memory (unless the column ordering of the stored serial
+    // factors is to be re-used; the serial factorisation then decides
+    // whether they can be re-used and wipes them itself)
+    if (use_dist || (!Serial_reuse_symbolic_factorisation) ||
+        (Serial_f_factors == 0))
+    {
+      this->clean_up_memory();
+    }
+
+    // LU decompose with SuperLU_dist or SuperLU
+#ifdef OOMPH_HAS_MPI
+    if (use_dist)
+    {
+      factorise_distributed(matrix_pt);
+      Using_dist = true;
     }
     else
 #endif
@@ -2160,18 +2179,22 @@ namespace oomph
     // Storage for the values, rows and column indices
     // required by SuplerLU
     double* value = 0;
-    int *index = 0, *start = 0;
+    int* index = 0;
+    SparseOffset* start = 0;
 
     // Integer used to represent compressed row or column format
     // Default compressed row
     int transpose = 0;
 
     // Number of non-zero entries in the matrix
-    int nnz = 0;
+    unsigned long nnz_long = 0;
 
     // Doc flag (convert to int for SuperLU)
     int doc = Doc_stats;
 
+    // Storage format of the stored factors (if any)
+    bool stored_compressed_row_flag = Serial_compressed_row_flag;
+
     // Is it a CR matrix
     if (dynamic_cast<CRDoubleMatrix*>(matrix_pt))
     {
@@ -2183,7 +2206,7 @@ namespace oomph
 
       // Now set the pointers to the interanally stored values
       // and indices
-      nnz = CR_matrix_pt->nnz();
+      nnz_long = CR_matrix_pt->nnz();
       value = CR_matrix_pt->value();
       index = CR_matrix_pt->column_index();
       start = CR_matrix_pt->row_start();
@@ -2198,7 +2221,7 @@ namespace oomph
 
       // Now set the pointers to the interanally stored values
       // and indices
-      nnz = CC_matrix_pt->nnz();
+      nnz_long = CC_matrix_pt->nnz();
       value = CC_matrix_pt->value();
       index = CC_matrix_pt->row_index();
       start = CC_matrix_pt->column_start();
@@ -2211,25 +2234,71 @@ namespace oomph
                           OOMPH_EXCEPTION_LOCATION);
     }
 
-    // Clean up any previous storage so that if this is called twice with
-    // the same matrix, we don't get a memory leak
-    clean_up_memory();
+    // SuperLU uses int offsets, so the number of non-zero entries
+    // must be representable as an int
+    if (nnz_long > static_cast<unsigned long>(INT_MAX))
+    {
+      std::ostringstream error_message_stream;
+      error_message_stream
+        << "The matrix has " << nnz_long << " non-zero entries but SuperLU\n"
+        << "can only handle " << INT_MAX << " entries.\n";
+      throw OomphLibError(error_message_stream.str(),
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+    int nnz = static_cast<int>(nnz_long);
+
+#ifdef OOMPH_HAS_64_BIT_SPARSE_OFFSETS
+    // Copy the (64-bit) offsets into the int storage required by SuperLU.
+    // SuperLU only refers to them during the factorisation.
+    Vector<int> superlu_start(n + 1);
+    for (int j = 0; j <= n; j++)
+    {
+      superlu_start[j] = static_cast<int>(start[j]);
+    }
+    int* superlu_start_pt = &superlu_start[0];
+#else
+    int* superlu_start_pt = start;
+#endif
 
-    // Perform the lu decompose phase (i=1)
+    // Perform the lu decompose phase (i=1). The serial SuperLU library
+    // keeps static data during the factorisation so factorisations
+    // must not be performed concurrently by different threads
     int i = 1;
-    Serial_sign_of_determinant_of_matrix = superlu(&i,
-                                                   &n,
-                                                   &nnz,
-                                                   0,
-                                                   value,
-                                                   index,
-                                                   start,
-                                                   0,
-                                                   &n,
-                                                   &transpose,
-                                                   &doc,
-                                                   &Serial_f_factors,
-                                                   &Serial_info);
+
+    // Re-use the column ordering of the stored factors (i=4) if
+    // requested and if they were computed for a matrix of the same size
+    // and storage format; SuperLU then frees them. Otherwise clean up
+    // any previous storage so that if this is called twice with the same
+    // matrix, we don't get a memory leak
+    if (Serial_reuse_symbolic_factorisation && (Serial_f_factors != 0) &&
+        (Serial_n_dof == static_cast<unsigned long>(n)) &&
+        (stored_compressed_row_flag == Serial_compressed_row_flag))
+    {
+      i = 4;
+    }
+    else
+    {
+      clean_up_memory();
+    }
+#ifdef _OPENMP
+#pragma omp critical(oomph_superlu_factorisation)
+#endif
+    {
+      Serial_sign_of_determinant_of_matrix = superlu(&i,
+                                                     &n,
+                                                     &nnz,
+                                                     0,
+                                                     value,
+                                                     index,
+                                                     superlu_start_pt,
+                                                     0,
+                                                     &n,
+                                                     &transpose,
+                                                     &doc,
+                                                     &Serial_f_factors,
+                                                     &Serial_info);
+    }
 
     // Throw an error if superLU returned an error status in info.
     if (Serial_info != 0)
@@ -87,6 +87,12 @@ namespace oomph
     /// Newton method
     DoubleVector Gradient_for_glob_conv_newton_solve;
 
+    /// Memory held by the solver at the peak of its most recent
+    /// solve (i.e. before any data that is not required for a resolve
+    /// was wiped). Only filled by the solvers that overload
+    /// get_memory_usage(...).
+    MemoryAccount Memory_usage_of_last_solve;
+
   public:
     /// Empty constructor, initialise the member data
     LinearSolver()
@@ -255,6 +261,18 @@ namespace oomph
     /// allocated (e.g. when preparing for a re-solve).
     virtual void clean_up_memory() {}
 
+    /// Add the memory currently held by the solver (e.g. stored
+    /// matrices, LU factors and preconditioners) to the account,
+    /// broken down into categories. Empty by default.
+    virtual void get_memory_usage(MemoryAccount& account) {}
+
+    /// Memory held by the solver at the peak of its most recent solve
+    /// (before the data that is not required for a resolve was wiped)
+    const MemoryAccount& memory_usage_of_last_solve() const
+    {
+      return Memory_usage_of_last_solve;
+    }
+
     ///  returns the time taken to assemble the Jacobian matrix and
     /// residual vector (needs to be overloaded for each solver)
     virtual double jacobian_setup_time() const
@@ -522,6 +540,7 @@ namespace oomph
       Serial_compressed_row_flag = true;
       Serial_sign_of_determinant_of_matrix = 0;
       Serial_n_dof = 0;
+      Serial_reuse_symbolic_factorisation = false;
     }
 
     /// Broken copy constructor
@@ -611,6 +630,23 @@ namespace oomph
       Doc_stats = false;
     }
 
+    /// Re-use the column ordering (the symbolic part of the
+    /// factorisation) of the stored LU factors in subsequent
+    /// factorisations with SuperLU (serial). Only use this if the
+    /// matrices that are factorised have the same sparsity pattern
+    /// as the one whose factors are stored. Ignored if no factors are
+    /// stored (e.g. because resolve is disabled).
+    void enable_reuse_of_symbolic_factorisation()
+    {
+      Serial_reuse_symbolic_factorisation = true;
+    }
+
+    /// Compute a new column ordering in each factorisation (default)
+    void disable_reuse_of_symbolic_factorisation()
+    {
+      Serial_reuse_symbolic_factorisation = false;
+    }
+
     /// returns the time taken to assemble the jacobian matrix and
     /// residual vector
     double jacobian_setup_time() const
@@ -641,6 +677,20 @@ namespace oomph
     /// Clean up the memory allocated by the solver
     void clean_up_memory();
 
+    /// Add the memory held by the LU factors (if any) to the
+    /// category "lu_factors" of the account and the remaining memory
+    /// allocated by SuperLU to "lu_workspace"
+    void get_memory_usage(MemoryAccount& account)
+    {
+      double lu_factor_nbyte = get_memory_usage_for_lu_factors();
+      if (lu_factor_nbyte > 0.0)
+      {
+        account.add("lu_factors", lu_factor_nbyte);
+        account.add("lu_workspace",
+                    get_total_needed_memory() - lu_factor_nbyte);
+      }
+    }
+
     /// Specify the solve type. Either default, serial or distributed.
     /// See enum SuperLU_solver_type for more details.
     void set_solver_type(const Type& t)
@@ -793,6 +843,10 @@ namespace oomph
     /// Use compressed row version?
     bool Serial_compressed_row_flag;
 
+    /// Re-use the column ordering of the stored LU factors in the
+    /// next factorisation?
+    bool Serial_reuse_symbolic_factorisation;
+
   public:
     /// How much memory do the LU factors take up? In bytes
     double get_memory_usage_for_lu_factors();
@@ -25,9 +25,61 @@
 // LIC//====================================================================
 #include "macro_element.h"
 #include "domain.h"
+#include "nodes.h"
 
 namespace oomph
 {
+  //=================================================================
+  /// Derivatives of the mapping from local to global coordinates
+  /// (at the current time) w.r.t. the values of the Data in the set
+  /// geom_data_pt, obtained by finite differencing macro_map(...):
+  /// dr_dgeom_data[data_pt](i,k) = dr_i / d (k-th value of data_pt).
+  //=================================================================
+  void MacroElement::dmacro_map_dgeom_data(
+    const Vector<double>& s,
+    const std::set<Data*>& geom_data_pt,
+    std::map<Data*, DenseMatrix<double>>& dr_dgeom_data)
+  {
+    dr_dgeom_data.clear();
+
+    // Unperturbed position (macro elements map n-dimensional local
+    // coordinates to n-dimensional positions)
+    const unsigned n_dim = s.size();
+    Vector<double> r(n_dim);
+    macro_map(s, r);
+
+    // Use the same step as the default finite difference Jacobians
+    const double fd_step = 1.0e-8;
+
+    // Loop over the Data and their values
+    Vector<double> r_pls(n_dim);
+    for (std::set<Data*>::const_iterator it = geom_data_pt.begin();
+         it != geom_data_pt.end();
+         it++)
+    {
+      Data* data_pt = *it;
+      const unsigned n_value = data_pt->nvalue();
+      DenseMatrix<double>& dr_ddata = dr_dgeom_data[data_pt];
+      dr_ddata.resize(n_dim, n_value, 0.0);
+      for (unsigned k = 0; k < n_value; k++)
+      {
+        // Perturb the value and get the new position
+        double* value_pt = data_pt->value_pt(k);
+        double old_var = *value_pt;
+        *value_pt += fd_step;
+        macro_map(s, r_pls);
+        for (unsigned i = 0; i < n_dim; i++)
+        {
+          dr_ddata(i, k) = (r_pls[i] - r[i]) / fd_step;
+        }
+
+        // Reset the value
+        *value_pt = old_var;
+      }
+    }
+  }
+
+
   //=================================================================
   /// Get global position r(S) at discrete time level t.
   /// t=0: Present time; t>0: previous timestep.
@@ -231,6 +283,85 @@ namespace oomph
   }
 
 
+  //=================================================================
+  /// Derivatives of the mapping from local to global coordinates
+  /// w.r.t. the values of the Data in the set geom_data_pt:
+  /// dr_dgeom_data[data_pt](i,k) = dr_i / d (k-th value of data_pt).
+  /// The mapping (see macro_map(...)) can be written as
+  /// r = (1-eta) f_S(xi) + eta f_N(xi) + (1-xi) f_W(eta) + xi f_E(eta)
+  ///     - [(1-eta)(1-xi) r_SW + (1-eta) xi r_SE
+  ///        + eta (1-xi) r_NW + eta xi r_NE]
+  /// where xi=(s[0]+1)/2, eta=(s[1]+1)/2 and r_SW etc. are the corners,
+  /// so its derivatives are the same combination of the derivatives
+  /// of the boundaries.
+  //=================================================================
+  void QMacroElement<2>::dmacro_map_dgeom_data(
+    const Vector<double>& s,
+    const std::set<Data*>& geom_data_pt,
+    std::map<Data*, DenseMatrix<double>>& dr_dgeom_data)
+  {
+    using namespace QuadTreeNames;
+
+    dr_dgeom_data.clear();
+
+    const double xi = 0.5 * (s[0] + 1.0);
+    const double eta = 0.5 * (s[1] + 1.0);
+
+    // The boundaries and positions along them that contribute and
+    // their weights
+    const unsigned n_contribution = 8;
+    const unsigned direction[n_contribution] = {S, N, W, E, S, S, N, N};
+    const double zeta_value[n_contribution] = {
+      s[0], s[0], s[1], s[1], -1.0, 1.0, -1.0, 1.0};
+    const double weight[n_contribution] = {1.0 - eta,
+                                           eta,
+                                           1.0 - xi,
+                                           xi,
+                                           -(1.0 - eta) * (1.0 - xi),
+                                           -(1.0 - eta) * xi,
+                                           -eta * (1.0 - xi),
+                                           -eta * xi};
+
+    Vector<double> zeta(1);
+    std::map<Data*, DenseMatrix<double>> df_dgeom_data;
+    for (unsigned c = 0; c < n_contribution; c++)
+    {
+      // Get the derivatives of the position on the boundary
+      zeta[0] = zeta_value[c];
+      Domain_pt->dmacro_element_boundary_dgeom_data(Macro_element_number,
+                                                    direction[c],
+                                                    zeta,
+                                                    geom_data_pt,
+                                                    df_dgeom_data);
+
+      // Add them in
+      for (std::map<Data*, DenseMatrix<double>>::iterator it =
+             df_dgeom_data.begin();
+           it != df_dgeom_data.end();
+           it++)
+      {
+        DenseMatrix<double>& df_ddata = it->second;
+        const unsigned n_value = df_ddata.ncol();
+        std::map<Data*, DenseMatrix<double>>::iterator it_r =
+          dr_dgeom_data.find(it->first);
+        if (it_r == dr_dgeom_data.end())
+        {
+          dr_dgeom_data[it->first].resize(2, n_value, 0.0);
+          it_r = dr_dgeom_data.find(it->first);
+        }
+        DenseMatrix<double>& dr_ddata = it_r->second;
+        for (unsigned i = 0; i < 2; i++)
+        {
+          for (unsigned k = 0; k < n_value; k++)
+          {
+            dr_ddata(i, k) += weight[c] * df_ddata(i, k);
+          }
+        }
+      }
+    }
+  }
+
+
   //=============================================================================
   /// Assembles the jacobian of the mapping from the macro coordinates to
   /// the global coordinates
@@ -36,6 +36,9 @@
 #include "mpi.h"
 #endif
 
+#include <map>
+#include <set>
+
 // oomph-lib headers
 #include "Vector.h"
 #include "oomph_utilities.h"
@@ -45,6 +48,7 @@
 namespace oomph
 {
   class Domain;
+  class Data;
 
   //================================================================
   /// Base class for MacroElement s that are used during mesh refinement
@@ -159,6 +163,18 @@ namespace oomph
     } // End of macro_map
 
 
+    /// Derivatives of the mapping from local to global coordinates
+    /// (at the current time) w.r.t. the values of the Data in the set
+    /// geom_data_pt, which are assumed to contain all Data that the shape
+    /// of the Domain depends on:
+    /// dr_dgeom_data[data_pt](i,k) = dr_i / d (k-th value of data_pt).
+    /// The default implementation finite differences macro_map(...).
+    virtual void dmacro_map_dgeom_data(
+      const Vector<double>& s,
+      const std::set<Data*>& geom_data_pt,
+      std::map<Data*, DenseMatrix<double>>& dr_dgeom_data);
+
+
     /// Output all macro element boundaries as tecplot zones
     virtual void output_macro_element_boundaries(std::ostream& outfile,
                                                  const unsigned& nplot) = 0;
@@ -335,6 +351,18 @@ namespace oomph
     void macro_map(const double& t, const Vector<double>& s, Vector<double>& r);
 
 
+    /// Derivatives of the mapping from local to global coordinates
+    /// w.r.t. the values of the Data in the set geom_data_pt:
+    /// dr_dgeom_data[data_pt](i,k) = dr_i / d (k-th value of data_pt).
+    /// The mapping is linear in the positions of the boundaries so the
+    /// derivatives are assembled from those of the boundaries, provided by
+    /// Domain::dmacro_element_boundary_dgeom_data(...).
+    void dmacro_map_dgeom_data(
+      const Vector<double>& s,
+      const std::set<Data*>& geom_data_pt,
+      std::map<Data*, DenseMatrix<double>>& dr_dgeom_data);
+
+
     /// assemble the jacobian of the mapping from the macro coordinates to
     /// the global coordinates
     virtual void assemble_macro_to_eulerian_jacobian(
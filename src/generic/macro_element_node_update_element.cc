@@ -24,6 +24,7 @@
 // LIC//
 // LIC//====================================================================
 #include "macro_element_node_update_element.h"
+#include "Qelements.h"
 
 namespace oomph
 {
@@ -113,4 +114,52 @@ namespace oomph
     }
   }
 
+
+  //========================================================================
+  /// Compute the derivatives of the (current) nodal position w.r.t.
+  /// the values of all Data that affect the node update by
+  /// differentiating the macro element representation of the update
+  /// element: dposition_dgeom_data[data_pt](i,k) = dx_i / d (k-th value
+  /// of data_pt).
+  //========================================================================
+  void MacroElementNodeUpdateNode::get_dposition_dgeom_data(
+    std::map<Data*, DenseMatrix<double>>& dposition_dgeom_data)
+  {
+    // The position of hanging nodes is determined by their master nodes;
+    // for those (and for nodes that aren't updated via a QElement's macro
+    // element) finite difference the node update
+    QElementBase* q_el_pt = dynamic_cast<QElementBase*>(Node_update_element_pt);
+    if (is_hanging() || (q_el_pt == 0) || (q_el_pt->macro_elem_pt() == 0))
+    {
+      Node::get_dposition_dgeom_data(dposition_dgeom_data);
+      return;
+    }
+
+    // Collect the Data that affect the node update
+    std::set<Data*> geom_data_pt;
+    assemble_set_of_all_geometric_data(geom_data_pt);
+
+    // Nothing to be done?
+    if (geom_data_pt.empty())
+    {
+      dposition_dgeom_data.clear();
+      return;
+    }
+
+    // Local coordinate of the node in the macro element (see
+    // QElementBase::get_x_from_macro_element(...))
+    const unsigned el_dim = q_el_pt->dim();
+    Vector<double> s_macro(el_dim);
+    for (unsigned i = 0; i < el_dim; i++)
+    {
+      s_macro[i] = q_el_pt->s_macro_ll(i) +
+                   0.5 * (S_in_node_update_element[i] + 1.0) *
+                     (q_el_pt->s_macro_ur(i) - q_el_pt->s_macro_ll(i));
+    }
+
+    // Differentiate the macro element representation
+    q_el_pt->macro_elem_pt()->dmacro_map_dgeom_data(
+      s_macro, geom_data_pt, dposition_dgeom_data);
+  }
+
 } // namespace oomph
@@ -96,6 +96,17 @@ namespace oomph
     /// MacroElementNodeUpdateElementBase::build_macro_element_node_update_node(...)
     void node_update(const bool& update_all_time_levels_for_new_node = false);
 
+    /// Compute the derivatives of the (current) nodal position w.r.t.
+    /// the values of all Data that affect the node update:
+    /// dposition_dgeom_data[data_pt](i,k) = dx_i / d (k-th value of
+    /// data_pt). Differentiates the macro element representation of the
+    /// update element (see MacroElement::dmacro_map_dgeom_data(...)), so
+    /// the derivatives are analytic if the Domain provides analytic
+    /// derivatives of its boundaries. Hanging nodes, and nodes that aren't
+    /// updated by a QElement, use the finite difference default.
+    void get_dposition_dgeom_data(
+      std::map<Data*, DenseMatrix<double>>& dposition_dgeom_data);
+
     ///  Pointer to finite element that performs the update by referring
     /// to its macro-element representation (Access required...)
     FiniteElement*& node_update_element_pt()
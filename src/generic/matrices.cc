@@ -584,7 +584,7 @@ namespace oomph
   //=======================================================================
   CCDoubleMatrix::CCDoubleMatrix(const Vector<double>& value,
                                  const Vector<int>& row_index,
-                                 const Vector<int>& column_start,
+                                 const Vector<SparseOffset>& column_start,
                                  const unsigned long& n,
                                  const unsigned long& m)
     : CCMatrix<double>(value, row_index, column_start, n, m)
@@ -699,7 +699,7 @@ namespace oomph
     const double* x_pt = x.values_pt();
     for (unsigned long j = 0; j < N; j++)
     {
-      for (long k = Column_start[j]; k < Column_start[j + 1]; k++)
+      for (SparseOffset k = Column_start[j]; k < Column_start[j + 1]; k++)
       {
         unsigned long i = Row_index[k];
         double a_ij = Value[k];
@@ -793,7 +793,7 @@ namespace oomph
     const double* x_pt = x.values_pt();
     for (unsigned long i = 0; i < N; i++)
     {
-      for (long k = Column_start[i]; k < Column_start[i + 1]; k++)
+      for (SparseOffset k = Column_start[i]; k < Column_start[i + 1]; k++)
       {
         unsigned long j = Row_index[k];
         double a_ij = Value[k];
@@ -842,18 +842,18 @@ namespace oomph
     unsigned long Nnz = 0;
 
     // pointers to arrays which store result
-    int* Column_start;
+    SparseOffset* Column_start;
     double* Value;
     int* Row_index;
 
     // get pointers to matrix_in
-    const int* matrix_in_col_start = matrix_in.column_start();
+    const SparseOffset* matrix_in_col_start = matrix_in.column_start();
     const int* matrix_in_row_index = matrix_in.row_index();
     const double* matrix_in_value = matrix_in.value();
 
     // get pointers to this matrix
     const double* this_value = this->value();
-    const int* this_col_start = this->column_start();
+    const SparseOffset* this_col_start = this->column_start();
     const int* this_row_index = this->row_index();
 
     // set method
@@ -866,7 +866,7 @@ namespace oomph
     if (method == 1)
     {
       // allocate storage for column starts
-      Column_start = new int[M + 1];
+      Column_start = new SparseOffset[M + 1];
       Column_start[0] = 0;
 
       // a set to store number of non-zero rows in each column of result
@@ -877,7 +877,7 @@ namespace oomph
       for (unsigned long this_col = 0; this_col < M; this_col++)
       {
         // run through non-zeros in this_col of this matrix
-        for (int this_ptr = this_col_start[this_col];
+        for (SparseOffset this_ptr = this_col_start[this_col];
              this_ptr < this_col_start[this_col + 1];
              this_ptr++)
         {
@@ -885,7 +885,7 @@ namespace oomph
           unsigned matrix_in_col = this_row_index[this_ptr];
 
           // run through corresponding column in matrix_in
-          for (int matrix_in_ptr = matrix_in_col_start[matrix_in_col];
+          for (SparseOffset matrix_in_ptr = matrix_in_col_start[matrix_in_col];
                matrix_in_ptr < matrix_in_col_start[matrix_in_col + 1];
                matrix_in_ptr++)
           {
@@ -914,7 +914,7 @@ namespace oomph
       for (unsigned long this_col = 0; this_col < M; this_col++)
       {
         // run through non-zeros in this_column
-        for (int this_ptr = this_col_start[this_col];
+        for (SparseOffset this_ptr = this_col_start[this_col];
              this_ptr < this_col_start[this_col + 1];
              this_ptr++)
         {
@@ -925,7 +925,7 @@ namespace oomph
           unsigned matrix_in_col = this_row_index[this_ptr];
 
           // run through corresponding column in matrix_in
-          for (int matrix_in_ptr = matrix_in_col_start[matrix_in_col];
+          for (SparseOffset matrix_in_ptr = matrix_in_col_start[matrix_in_col];
                matrix_in_ptr < matrix_in_col_start[matrix_in_col + 1];
                matrix_in_ptr++)
           {
@@ -933,7 +933,7 @@ namespace oomph
             int row = matrix_in_row_index[matrix_in_ptr];
 
             // find position in result to insert value
-            for (int ptr = Column_start[this_col];
+            for (SparseOffset ptr = Column_start[this_col];
                  ptr <= Column_start[this_col + 1];
                  ptr++)
             {
@@ -978,7 +978,7 @@ namespace oomph
       for (unsigned long this_col = 0; this_col < M; this_col++)
       {
         // run through non-zeros in this_col
-        for (int this_ptr = this_col_start[this_col];
+        for (SparseOffset this_ptr = this_col_start[this_col];
              this_ptr < this_col_start[this_col + 1];
              this_ptr++)
         {
@@ -989,7 +989,7 @@ namespace oomph
           unsigned matrix_in_col = this_row_index[this_ptr];
 
           // run through corresponding column in matrix_in
-          for (int matrix_in_ptr = matrix_in_col_start[matrix_in_col];
+          for (SparseOffset matrix_in_ptr = matrix_in_col_start[matrix_in_col];
                matrix_in_ptr < matrix_in_col_start[matrix_in_col + 1];
                matrix_in_ptr++)
           {
@@ -1004,7 +1004,7 @@ namespace oomph
       }
 
       // allocate Column_start
-      Column_start = new int[M + 1];
+      Column_start = new SparseOffset[M + 1];
 
       // copy across column starts
       Column_start[0] = 0;
@@ -1024,7 +1024,7 @@ namespace oomph
       // copy values and row indices
       for (unsigned long col = 0; col < M; col++)
       {
-        unsigned ptr = Column_start[col];
+        SparseOffset ptr = Column_start[col];
         for (std::map<int, double>::iterator i = result_maps[col].begin();
              i != result_maps[col].end();
              i++)
@@ -1051,7 +1051,7 @@ namespace oomph
       for (unsigned long this_col = 0; this_col < M; this_col++)
       {
         // run through non-zeros in this_col
-        for (int this_ptr = this_col_start[this_col];
+        for (SparseOffset this_ptr = this_col_start[this_col];
              this_ptr < this_col_start[this_col + 1];
              this_ptr++)
         {
@@ -1062,7 +1062,7 @@ namespace oomph
           unsigned matrix_in_col = this_row_index[this_ptr];
 
           // run through corresponding column in matrix_in
-          for (int matrix_in_ptr = matrix_in_col_start[matrix_in_col];
+          for (SparseOffset matrix_in_ptr = matrix_in_col_start[matrix_in_col];
                matrix_in_ptr < matrix_in_col_start[matrix_in_col + 1];
                matrix_in_ptr++)
           {
@@ -1093,7 +1093,7 @@ namespace oomph
       }
 
       // allocate Column_start
-      Column_start = new int[M + 1];
+      Column_start = new SparseOffset[M + 1];
 
       // copy across column starts
       Column_start[0] = 0;
@@ -1113,7 +1113,7 @@ namespace oomph
       // copy across values and row indices
       for (unsigned long col = 0; col < N; col++)
       {
-        unsigned ptr = Column_start[col];
+        SparseOffset ptr = Column_start[col];
         unsigned n_rows = result_rows[col].size();
         for (unsigned i = 0; i < n_rows; i++)
         {
@@ -1155,7 +1155,7 @@ namespace oomph
     Vector<double> max_row(nrow(), 0.0);
 
     // Here's the packed format for the new matrix
-    Vector<int> B_row_start(1);
+    Vector<SparseOffset> B_row_start(1);
     Vector<int> B_column_index;
     Vector<double> B_value;
 
@@ -1170,7 +1170,7 @@ namespace oomph
     for (long i = 0; i < n_coln; i++)
     {
       // Loop over entries in columns
-      for (long j = Column_start[i]; j < Column_start[i + 1]; j++)
+      for (SparseOffset j = Column_start[i]; j < Column_start[i + 1]; j++)
       {
         // Find max. value in row
         if (std::fabs(Value[j]) > max_row[Row_index[j]])
@@ -1180,7 +1180,7 @@ namespace oomph
       }
 
       // Decide if we need to retain the entries in the row
-      for (long j = Column_start[i]; j < Column_start[i + 1]; j++)
+      for (SparseOffset j = Column_start[i]; j < Column_start[i + 1]; j++)
       {
         // If we're on the diagonal or the value is sufficiently large: retain
         // i.e. copy across.
@@ -1239,10 +1239,10 @@ namespace oomph
     // copy coefficients
     const double* values_pt = other_matrix.value();
     const int* column_indices = other_matrix.column_index();
-    const int* row_start = other_matrix.row_start();
+    const SparseOffset* row_start = other_matrix.row_start();
 
     // This is the local nnz.
-    const unsigned nnz = other_matrix.nnz();
+    const unsigned long nnz = other_matrix.nnz();
 
     // Using number of local rows since the underlying CRMatrix is local to
     // each processor.
@@ -1251,7 +1251,7 @@ namespace oomph
     // Storage for the (yet to be copied) data.
     double* my_values_pt = new double[nnz];
     int* my_column_indices = new int[nnz];
-    int* my_row_start = new int[nrow_local + 1];
+    SparseOffset* my_row_start = new SparseOffset[nrow_local + 1];
 
     // Copying over the data.
     std::copy(values_pt, values_pt + nnz, my_values_pt);
@@ -1312,7 +1312,7 @@ namespace oomph
                                  const unsigned& ncol,
                                  const Vector<double>& value,
                                  const Vector<int>& column_index,
-                                 const Vector<int>& row_start)
+                                 const Vector<SparseOffset>& row_start)
   {
     // build the compressed row matrix
     CR_matrix.build(
@@ -1391,7 +1391,7 @@ namespace oomph
     // the CR matrix. Since we do not change anything in row_start_pt we
     // give it the const prefix
     const int* column_index_pt = this->column_index();
-    const int* row_start_pt = this->row_start();
+    const SparseOffset* row_start_pt = this->row_start();
 
     // Loop over the rows of matrix
     for (unsigned i = 0; i < n_rows; i++)
@@ -1474,7 +1474,7 @@ namespace oomph
     // give it the const prefix
     double* value_pt = this->value();
     int* column_index_pt = this->column_index();
-    const int* row_start_pt = this->row_start();
+    const SparseOffset* row_start_pt = this->row_start();
 
     // Resize the Index_of_diagonal_entries vector
     Index_of_diagonal_entries.resize(n_rows, 0);
@@ -1673,7 +1673,7 @@ namespace oomph
                              const unsigned& ncol,
                              const Vector<double>& value,
                              const Vector<int>& column_index,
-                             const Vector<int>& row_start)
+                             const Vector<SparseOffset>& row_start)
   {
     // clear
     this->clear();
@@ -1694,7 +1694,7 @@ namespace oomph
   void CRDoubleMatrix::build(const unsigned& ncol,
                              const Vector<double>& value,
                              const Vector<int>& column_index,
-                             const Vector<int>& row_start)
+                             const Vector<SparseOffset>& row_start)
   {
     // call the underlying build method
     CR_matrix.clean_up_memory();
@@ -1708,10 +1708,10 @@ namespace oomph
   /// method to rebuild the matrix, but not the distribution
   //=============================================================================
   void CRDoubleMatrix::build_without_copy(const unsigned& ncol,
-                                          const unsigned& nnz,
+                                          const unsigned long& nnz,
                                           double* value,
                                           int* column_index,
-                                          int* row_start)
+                                          SparseOffset* row_start)
   {
     // call the underlying build method
     CR_matrix.clean_up_memory();
@@ -1857,21 +1857,26 @@ namespace oomph
     }
     else
     {
-      unsigned n = this->nrow();
-      const int* row_start = CR_matrix.row_start();
+      long n = this->nrow();
+      const SparseOffset* row_start = CR_matrix.row_start();
       const int* column_index = CR_matrix.column_index();
       const double* value = CR_matrix.value();
       double* soln_pt = soln.values_pt();
       const double* x_pt = x.values_pt();
-      for (unsigned long i = 0; i < n; i++)
+      // The rows are independent so they can be processed concurrently
+#ifdef _OPENMP
+#pragma omp parallel for if (n > 256)
+#endif
+      for (long i = 0; i < n; i++)
       {
-        soln_pt[i] = 0.0;
-        for (long k = row_start[i]; k < row_start[i + 1]; k++)
+        double soln_i = 0.0;
+        for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
         {
           unsigned long j = column_index[k];
           double a_ij = value[k];
-          soln_pt[i] += a_ij * x_pt[j];
+          soln_i += a_ij * x_pt[j];
         }
+        soln_pt[i] = soln_i;
       }
     }
   }
@@ -1951,7 +1956,7 @@ namespace oomph
     else
     {
       unsigned n = this->nrow();
-      const int* row_start = CR_matrix.row_start();
+      const SparseOffset* row_start = CR_matrix.row_start();
       const int* column_index = CR_matrix.column_index();
       const double* value = CR_matrix.value();
       double* soln_pt = soln.values_pt();
@@ -1959,7 +1964,7 @@ namespace oomph
       // Matrix vector product
       for (unsigned long i = 0; i < n; i++)
       {
-        for (long k = row_start[i]; k < row_start[i + 1]; k++)
+        for (SparseOffset k = row_start[i]; k < row_start[i + 1]; k++)
         {
           unsigned long j = column_index[k];
           double a_ij = value[k];
@@ -2046,18 +2051,18 @@ namespace oomph
       unsigned long Nnz = 0;
 
       // pointers to arrays which store result
-      int* Row_start = 0;
+      SparseOffset* Row_start = 0;
       double* Value = 0;
       int* Column_index = 0;
 
       // get pointers to matrix_in
-      const int* matrix_in_row_start = matrix_in.row_start();
+      const SparseOffset* matrix_in_row_start = matrix_in.row_start();
       const int* matrix_in_column_index = matrix_in.column_index();
       const double* matrix_in_value = matrix_in.value();
 
       // get pointers to this matrix
       const double* this_value = this->value();
-      const int* this_row_start = this->row_start();
+      const SparseOffset* this_row_start = this->row_start();
       const int* this_column_index = this->column_index();
 
       // clock_t clock1 = clock();
@@ -2067,7 +2072,7 @@ namespace oomph
       if (method == 1)
       {
         // allocate storage for row starts
-        Row_start = new int[N + 1];
+        Row_start = new SparseOffset[N + 1];
         Row_start[0] = 0;
 
         // a set to store number of non-zero columns in each row of result
@@ -2078,7 +2083,7 @@ namespace oomph
         for (unsigned long this_row = 0; this_row < N; this_row++)
         {
           // run through non-zeros in this_row of this matrix
-          for (int this_ptr = this_row_start[this_row];
+          for (SparseOffset this_ptr = this_row_start[this_row];
                this_ptr < this_row_start[this_row + 1];
                this_ptr++)
           {
@@ -2086,7 +2091,8 @@ namespace oomph
             int matrix_in_row = this_column_index[this_ptr];
 
             // run through corresponding row in matrix_in
-            for (int matrix_in_ptr = matrix_in_row_start[matrix_in_row];
+            for (SparseOffset matrix_in_ptr =
+                   matrix_in_row_start[matrix_in_row];
                  matrix_in_ptr < matrix_in_row_start[matrix_in_row + 1];
                  matrix_in_ptr++)
             {
@@ -2119,7 +2125,7 @@ namespace oomph
         for (unsigned long this_row = 0; this_row < N; this_row++)
         {
           // run through non-zeros in this_row
-          for (int this_ptr = this_row_start[this_row];
+          for (SparseOffset this_ptr = this_row_start[this_row];
                this_ptr < this_row_start[this_row + 1];
                this_ptr++)
           {
@@ -2130,7 +2136,8 @@ namespace oomph
             int matrix_in_row = this_column_index[this_ptr];
 
             // run through corresponding row in matrix_in
-            for (int matrix_in_ptr = matrix_in_row_start[matrix_in_row];
+            for (SparseOffset matrix_in_ptr =
+                   matrix_in_row_start[matrix_in_row];
                  matrix_in_ptr < matrix_in_row_start[matrix_in_row + 1];
                  matrix_in_ptr++)
             {
@@ -2138,7 +2145,7 @@ namespace oomph
               int col = matrix_in_column_index[matrix_in_ptr];
 
               // find position in result to insert value
-              for (int ptr = Row_start[this_row];
+              for (SparseOffset ptr = Row_start[this_row];
                    ptr <= Row_start[this_row + 1];
                    ptr++)
               {
@@ -2183,7 +2190,7 @@ namespace oomph
         for (unsigned long this_row = 0; this_row < N; this_row++)
         {
           // run through non-zeros in this_row
-          for (int this_ptr = this_row_start[this_row];
+          for (SparseOffset this_ptr = this_row_start[this_row];
                this_ptr < this_row_start[this_row + 1];
                this_ptr++)
           {
@@ -2194,7 +2201,8 @@ namespace oomph
             int matrix_in_row = this_column_index[this_ptr];
 
             // run through corresponding row in matrix_in
-            for (int matrix_in_ptr = matrix_in_row_start[matrix_in_row];
+            for (SparseOffset matrix_in_ptr =
+                   matrix_in_row_start[matrix_in_row];
                  matrix_in_ptr < matrix_in_row_start[matrix_in_row + 1];
                  matrix_in_ptr++)
             {
@@ -2209,7 +2217,7 @@ namespace oomph
         }
 
         // allocate Row_start
-        Row_start = new int[N + 1];
+        Row_start = new SparseOffset[N + 1];
 
         // copy across row starts
         Row_start[0] = 0;
@@ -2229,7 +2237,7 @@ namespace oomph
         // copy values and column indices
         for (unsigned long row = 0; row < N; row++)
         {
-          unsigned ptr = Row_start[row];
+          SparseOffset ptr = Row_start[row];
           for (std::map<int, double>::iterator i = result_maps[row].begin();
                i != result_maps[row].end();
                i++)
@@ -2256,7 +2264,7 @@ namespace oomph
         for (unsigned long this_row = 0; this_row < N; this_row++)
         {
           // run through non-zeros in this_row
-          for (int this_ptr = this_row_start[this_row];
+          for (SparseOffset this_ptr = this_row_start[this_row];
                this_ptr < this_row_start[this_row + 1];
                this_ptr++)
           {
@@ -2267,7 +2275,8 @@ namespace oomph
             int matrix_in_row = this_column_index[this_ptr];
 
             // run through corresponding row in matrix_in
-            for (int matrix_in_ptr = matrix_in_row_start[matrix_in_row];
+            for (SparseOffset matrix_in_ptr =
+                   matrix_in_row_start[matrix_in_row];
                  matrix_in_ptr < matrix_in_row_start[matrix_in_row + 1];
                  matrix_in_ptr++)
             {
@@ -2298,7 +2307,7 @@ namespace oomph
         }
 
         // allocate Row_start
-        Row_start = new int[N + 1];
+        Row_start = new SparseOffset[N + 1];
 
         // copy across row starts
         Row_start[0] = 0;
@@ -2318,7 +2327,7 @@ namespace oomph
         // copy across values and column indices
         for (unsigned long row = 0; row < N; row++)
         {
-          unsigned ptr = Row_start[row];
+          SparseOffset ptr = Row_start[row];
           unsigned nnn = result_cols[row].size();
           for (unsigned i = 0; i < nnn; i++)
           {
@@ -2370,12 +2379,12 @@ namespace oomph
     double max_row;
 
     // Here's the packed format for the new matrix
-    Vector<int> B_row_start(1);
+    Vector<SparseOffset> B_row_start(1);
     Vector<int> B_column_index;
     Vector<double> B_value;
 
     // get pointers to the underlying data
-    const int* row_start = CR_matrix.row_start();
+    const SparseOffset* row_start = CR_matrix.row_start();
     const int* column_index = CR_matrix.column_index();
     const double* value = CR_matrix.value();
 
@@ -2392,7 +2401,7 @@ namespace oomph
       max_row = 0.0;
 
       // Loop over entries in columns
-      for (long j = row_start[i]; j < row_start[i + 1]; j++)
+      for (SparseOffset j = row_start[i]; j < row_start[i + 1]; j++)
       {
         // Find max. value in row
         if (std::fabs(value[j]) > max_row)
@@ -2402,7 +2411,7 @@ namespace oomph
       }
 
       // Decide if we need to retain the entries in the row
-      for (long j = row_start[i]; j < row_start[i + 1]; j++)
+      for (SparseOffset j = row_start[i]; j < row_start[i + 1]; j++)
       {
         // If we're on the diagonal or the value is sufficiently large: retain
         // i.e. copy across.
@@ -2482,12 +2491,12 @@ namespace oomph
     // get pointers to the (current) distributed data
     // const_cast required because MPI requires non-const data when sending
     // data
-    int* dist_row_start = const_cast<int*>(this->row_start());
+    SparseOffset* dist_row_start = const_cast<SparseOffset*>(this->row_start());
     int* dist_column_index = const_cast<int*>(this->column_index());
     double* dist_value = const_cast<double*>(this->value());
 
     // space for the global matrix
-    int* global_row_start = new int[nrow + 1];
+    SparseOffset* global_row_start = new SparseOffset[nrow + 1];
     int* global_column_index = new int[nnz_global];
     double* global_value = new double[nnz_global];
 
@@ -2618,7 +2627,7 @@ namespace oomph
       unsigned long ncol = this->ncol();
 
       // current data
-      int* current_row_start = this->row_start();
+      SparseOffset* current_row_start = this->row_start();
       int* current_column_index = this->column_index();
       double* current_value = this->value();
 
@@ -2742,7 +2751,8 @@ namespace oomph
         }
 
         // allocate new storage for the new row_start
-        int* new_row_start = new int[new_nrow_local[my_rank] + 1];
+        SparseOffset* new_row_start =
+          new SparseOffset[new_nrow_local[my_rank] + 1];
 
         // wait for recvs to complete
         unsigned n_recv_req = nnz_recv_req.size();
@@ -3022,12 +3032,12 @@ namespace oomph
         }
 
         // get pointers to the (current) distributed data
-        int* dist_row_start = this->row_start();
+        SparseOffset* dist_row_start = this->row_start();
         int* dist_column_index = this->column_index();
         double* dist_value = this->value();
 
         // space for the global matrix
-        int* global_row_start = new int[nrow + 1];
+        SparseOffset* global_row_start = new SparseOffset[nrow + 1];
         int* global_column_index = new int[nnz_count];
         double* global_value = new double[nnz_count];
 
@@ -3231,7 +3241,7 @@ namespace oomph
         unsigned first_row = dist_pt->first_row();
 
         // get pointers to the (current) distributed data
-        int* global_row_start = this->row_start();
+        SparseOffset* global_row_start = this->row_start();
         int* global_column_index = this->column_index();
         double* global_value = this->value();
 
@@ -3240,7 +3250,7 @@ namespace oomph
                        global_row_start[first_row];
 
         // allocate
-        int* dist_row_start = new int[nrow_local + 1];
+        SparseOffset* dist_row_start = new SparseOffset[nrow_local + 1];
         int* dist_column_index = new int[nnz];
         double* dist_value = new double[nnz];
 
@@ -3305,14 +3315,14 @@ namespace oomph
     // Acquire access to the value, row_start and column_index
     // arrays from the CR matrix
     const double* value_pt = this->value();
-    const int* row_start_pt = this->row_start();
+    const SparseOffset* row_start_pt = this->row_start();
     const int* column_index_pt = this->column_index();
 
     // Allocate space for the row_start and column_index vectors
     // associated with the transpose of the current matrix.
     Vector<double> value_t(nnon_zeros, 0.0);
     Vector<int> column_index_t(nnon_zeros, 0);
-    Vector<int> row_start_t(n_rows_t + 1, 0);
+    Vector<SparseOffset> row_start_t(n_rows_t + 1, 0);
 
     // Loop over the column index vector and count how many times
     // each column number occurs and increment the appropriate
@@ -3425,12 +3435,12 @@ namespace oomph
     // compute the local norm
     unsigned nrow_local = this->nrow_local();
     double n = 0;
-    const int* row_start = CR_matrix.row_start();
+    const SparseOffset* row_start = CR_matrix.row_start();
     const double* value = CR_matrix.value();
     for (unsigned i = 0; i < nrow_local; i++)
     {
       double a = 0;
-      for (int j = row_start[i]; j < row_start[i + 1]; j++)
+      for (SparseOffset j = row_start[i]; j < row_start[i + 1]; j++)
       {
         a += fabs(value[j]);
       }
@@ -3594,14 +3604,14 @@ namespace oomph
     unsigned nrow_local = this->nrow_local();
     Vector<int> res_column_indices;
     Vector<double> res_values;
-    Vector<int> res_row_start;
+    Vector<SparseOffset> res_row_start;
     res_row_start.reserve(nrow_local + 1);
 
     // The row_start and column_indices
     const int* this_column_indices = this->column_index();
-    const int* this_row_start = this->row_start();
+    const SparseOffset* this_row_start = this->row_start();
     const int* in_column_indices = matrix_in.column_index();
-    const int* in_row_start = matrix_in.row_start();
+    const SparseOffset* in_row_start = matrix_in.row_start();
 
     // Values from this matrix and matrix_in.
     const double* this_values = this->value();
@@ -3619,13 +3629,17 @@ namespace oomph
       std::map<int, double> res_row_map;
 
       // Insert the column and value pair for this matrix.
-      for (int i = this_row_start[row_i]; i < this_row_start[row_i + 1]; i++)
+      for (SparseOffset i = this_row_start[row_i];
+           i < this_row_start[row_i + 1];
+           i++)
       {
         res_row_map[this_column_indices[i]] = this_values[i];
       }
 
       // Insert the column and value pair for in matrix.
-      for (int i = in_row_start[row_i]; i < in_row_start[row_i + 1]; i++)
+      for (SparseOffset i = in_row_start[row_i];
+           i < in_row_start[row_i + 1];
+           i++)
       {
         res_row_map[in_column_indices[i]] += in_values[i];
       }
@@ -3679,7 +3693,7 @@ namespace oomph
       const OomphCommunicator* const comm_pt,
       const Vector<double>& values,
       const Vector<int>& column_indices,
-      const Vector<int>& row_start,
+      const Vector<SparseOffset>& row_start,
       CRDoubleMatrix& matrix_out)
     {
 #ifdef PARANOID
@@ -3946,11 +3960,11 @@ namespace oomph
             // Locally cache the pointer to the current block.
             CRDoubleMatrix* block_pt = matrix_pt(block_row_i, block_col_i);
 
-            const int* row_start = block_pt->row_start();
+            const SparseOffset* row_start = block_pt->row_start();
             const double* value = block_pt->value();
 
             // Loop through the values
-            for (int val_i = row_start[local_row_i];
+            for (SparseOffset val_i = row_start[local_row_i];
                  val_i < row_start[local_row_i + 1];
                  val_i++)
             {
@@ -4220,11 +4234,11 @@ namespace oomph
             // Locally cache the pointer to the current block.
             CRDoubleMatrix* block_pt = matrix_pt(block_row_i, block_col_i);
 
-            const int* row_start = block_pt->row_start();
+            const SparseOffset* row_start = block_pt->row_start();
             const double* value = block_pt->value();
 
             // Loop through the values
-            for (int val_i = row_start[local_row_i];
+            for (SparseOffset val_i = row_start[local_row_i];
                  val_i < row_start[local_row_i + 1];
                  val_i++)
             {
@@ -4237,7 +4251,8 @@ namespace oomph
           double* s_values = matrix_pt(block_row_i, block_row_i)->value();
           int* s_column_index =
             matrix_pt(block_row_i, block_row_i)->column_index();
-          int* s_row_start = matrix_pt(block_row_i, block_row_i)->row_start();
+          SparseOffset* s_row_start =
+            matrix_pt(block_row_i, block_row_i)->row_start();
           // int s_nrow_local =
           // matrix_pt(block_row_i,block_row_i)->nrow_local();
           int s_first_row = matrix_pt(block_row_i, block_row_i)->first_row();
@@ -4245,7 +4260,7 @@ namespace oomph
           // Get the diagonal value...
           double diagonal_value = 0;
           bool found = false;
-          for (int j = s_row_start[local_row_i];
+          for (SparseOffset j = s_row_start[local_row_i];
                j < s_row_start[local_row_i + 1] && !found;
                j++)
           {
@@ -4603,7 +4618,7 @@ namespace oomph
         // Declare the vectors required to build a CRDoubleMatrix
         Vector<double> res_values;
         Vector<int> res_column_indices;
-        Vector<int> res_row_start;
+        Vector<SparseOffset> res_row_start;
 
         // Reserve space for the vectors.
         res_values.reserve(res_nnz);
@@ -4613,7 +4628,7 @@ namespace oomph
         // Now we fill in the data.
 
         // Running sum of nnz per row.
-        int nnz_running_sum = 0;
+        SparseOffset nnz_running_sum = 0;
 
         // Loop through the block rows.
         for (unsigned block_row_i = 0; block_row_i < matrix_nrow; block_row_i++)
@@ -4639,9 +4654,10 @@ namespace oomph
               double* current_block_values = current_block_pt->value();
               int* current_block_column_indices =
                 current_block_pt->column_index();
-              int* current_block_row_start = current_block_pt->row_start();
+              SparseOffset* current_block_row_start =
+                current_block_pt->row_start();
 
-              for (int val_i = current_block_row_start[row_i];
+              for (SparseOffset val_i = current_block_row_start[row_i];
                    val_i < current_block_row_start[row_i + 1];
                    val_i++)
               {
@@ -4741,7 +4757,7 @@ namespace oomph
                  block_col_i++)
             {
               // Get the row_start
-              int* current_block_row_start =
+              SparseOffset* current_block_row_start =
                 matrix_pt(block_row_i, block_col_i)->row_start();
 
               // Update the nnz for this row.
@@ -4783,10 +4799,11 @@ namespace oomph
               double* current_block_values = current_block_pt->value();
               int* current_block_column_indices =
                 current_block_pt->column_index();
-              int* current_block_row_start = current_block_pt->row_start();
+              SparseOffset* current_block_row_start =
+                current_block_pt->row_start();
 
               // Loop though the values and column_indices
-              for (int val_i = current_block_row_start[sub_local_eqn];
+              for (SparseOffset val_i = current_block_row_start[sub_local_eqn];
                    val_i < current_block_row_start[sub_local_eqn + 1];
                    val_i++)
               {
@@ -5085,15 +5102,15 @@ namespace oomph
         // the column indices in the correct order.
         Vector<int> res_column_indices;
         Vector<double> res_values;
-        Vector<int> res_row_start;
+        Vector<SparseOffset> res_row_start;
 
         res_column_indices.reserve(res_nnz_local);
         res_values.reserve(res_nnz_local);
         res_row_start.reserve(res_nrow_local + 1);
 
-        // Running sum of nnz for the row_start. Must be int because
-        // res_row_start is templated with int.
-        int nnz_running_sum = 0;
+        // Running sum of nnz for the row_start. Must be a SparseOffset
+        // because res_row_start is templated with SparseOffset.
+        SparseOffset nnz_running_sum = 0;
 
         // Now insert the rows.
         for (unsigned local_row_i = 0; local_row_i < res_nrow_local;
@@ -5780,7 +5797,7 @@ namespace oomph
       // CALLGRIND_START_INSTRUMENTATION;
 
       // storage for the result matrix.
-      int* res_row_start = new int[res_nrow_local + 1];
+      SparseOffset* res_row_start = new SparseOffset[res_nrow_local + 1];
       int* res_column_index = new int[res_nnz];
       double* res_value = new double[res_nnz];
 
@@ -5806,7 +5823,7 @@ namespace oomph
             if (matrix_pt(i, j) != 0)
             {
               // get pointers for the elements in the current block
-              int* b_row_start = matrix_pt(i, j)->row_start();
+              SparseOffset* b_row_start = matrix_pt(i, j)->row_start();
               int* b_column_index = matrix_pt(i, j)->column_index();
               double* b_value = matrix_pt(i, j)->value();
 
@@ -5818,7 +5835,7 @@ namespace oomph
                      b_value + b_row_start[k],
                      numEleToCopy * sizeof(double));
               // Loop through the current local row.
-              for (int l = b_row_start[k]; l < b_row_start[k + 1]; l++)
+              for (SparseOffset l = b_row_start[k]; l < b_row_start[k + 1]; l++)
               {
                 // if b_column_index[l] was a row index, what processor
                 // would it be on
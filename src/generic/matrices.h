@@ -56,6 +56,25 @@
 
 namespace oomph
 {
+  //=================================================================
+  /// Integer type of the offsets into the arrays of values and
+  /// indices of the compressed row (and compressed column) matrices,
+  /// i.e. of the row (column) starts. It limits the number of non-zero
+  /// entries that can be stored on each processor. By default it is an
+  /// int (allowing up to 2^31-1 entries); it is a 64-bit integer if
+  /// oomph-lib has been configured with --enable-64-bit-sparse-offsets.
+  /// The column (row) indices themselves are bounded by the number of
+  /// columns (rows) of the matrix and remain ints.
+  //=================================================================
+#ifdef OOMPH_HAS_64_BIT_SPARSE_OFFSETS
+#ifdef OOMPH_HAS_MPI
+#error "64-bit sparse offsets are not (yet) supported in MPI builds"
+#endif
+  typedef long long SparseOffset;
+#else
+  typedef int SparseOffset;
+#endif
+
 // Initialise dense pointer-based matrices/tensors?
 #define OOMPH_INITIALISE_DENSE_MATRICES
 #undef OOMPH_INITIALISE_DENSE_MATRICES
@@ -696,7 +715,7 @@ namespace oomph
     /// to its correct length.
     CRMatrix(const Vector<T>& value,
              const Vector<int>& column_index_,
-             const Vector<int>& row_start_,
+             const Vector<SparseOffset>& row_start_,
              const unsigned long& n,
              const unsigned long& m)
       : SparseMatrix<T, CRMatrix<T>>()
@@ -722,7 +741,7 @@ namespace oomph
       }
 
       // Row start:
-      Row_start = new int[this->N + 1];
+      Row_start = new SparseOffset[this->N + 1];
 
       // Assign:
       for (unsigned long i = 0; i <= this->N; i++)
@@ -750,7 +769,7 @@ namespace oomph
 #ifdef RANGE_CHECKING
       this->range_check(i, j);
 #endif
-      for (long k = Row_start[i]; k < Row_start[i + 1]; k++)
+      for (SparseOffset k = Row_start[i]; k < Row_start[i + 1]; k++)
       {
         if (unsigned(Column_index[k]) == j)
         {
@@ -782,13 +801,13 @@ namespace oomph
     }
 
     /// Access to C-style row_start array
-    int* row_start()
+    SparseOffset* row_start()
     {
       return Row_start;
     }
 
     /// Access to C-style row_start array (const version)
-    const int* row_start() const
+    const SparseOffset* row_start() const
     {
       return Row_start;
     }
@@ -829,7 +848,7 @@ namespace oomph
     {
       for (unsigned long i = 0; i < this->N; i++)
       {
-        for (long j = Row_start[i]; j < Row_start[i + 1]; j++)
+        for (SparseOffset j = Row_start[i]; j < Row_start[i + 1]; j++)
         {
           outfile << i << " " << Column_index[j] << " " << this->Value[j]
                   << std::endl;
@@ -847,7 +866,7 @@ namespace oomph
     /// number of local rows. The argument m is the number of columns
     void build(const Vector<T>& value,
                const Vector<int>& column_index,
-               const Vector<int>& row_start,
+               const Vector<SparseOffset>& row_start,
                const unsigned long& n,
                const unsigned long& m);
 
@@ -859,7 +878,7 @@ namespace oomph
     /// make a copy of the data pointed to by the first three arguments!
     void build_without_copy(T* value,
                             int* column_index,
-                            int* row_start,
+                            SparseOffset* row_start,
                             const unsigned long& nnz,
                             const unsigned long& n,
                             const unsigned long& m);
@@ -870,7 +889,7 @@ namespace oomph
     int* Column_index;
 
     /// Start index for row
-    int* Row_start;
+    SparseOffset* Row_start;
   };
 
 
@@ -896,7 +915,7 @@ namespace oomph
                    const unsigned& ncol,
                    const Vector<double>& value,
                    const Vector<int>& column_index,
-                   const Vector<int>& row_start);
+                   const Vector<SparseOffset>& row_start);
 
     /// Constructor: just stores the distribution but does not build the
     /// matrix
@@ -917,7 +936,7 @@ namespace oomph
     /// diagonal then the corresponding entry is -1. If, however, there are
     /// no entries in the row then the entry is irrelevant and is kept
     /// as the initialised value; 0.
-    const Vector<int> get_index_of_diagonal_entries() const
+    const Vector<SparseOffset> get_index_of_diagonal_entries() const
     {
       // Check to see if the vector has been set up
       if (Index_of_diagonal_entries.size() == 0)
@@ -967,7 +986,7 @@ namespace oomph
                const unsigned& ncol,
                const Vector<double>& value,
                const Vector<int>& column_index,
-               const Vector<int>& row_start);
+               const Vector<SparseOffset>& row_start);
 
     /// rebuild the matrix - assembles an empty matrix will a defined
     /// distribution
@@ -977,15 +996,15 @@ namespace oomph
     void build(const unsigned& ncol,
                const Vector<double>& value,
                const Vector<int>& column_index,
-               const Vector<int>& row_start);
+               const Vector<SparseOffset>& row_start);
 
     /// keeps the existing distribution and just matrix that is stored
     /// without copying the matrix data
     void build_without_copy(const unsigned& ncol,
-                            const unsigned& nnz,
+                            const unsigned long& nnz,
                             double* value,
                             int* column_index,
-                            int* row_start);
+                            SparseOffset* row_start);
 
     /// The contents of the matrix are redistributed to match the new
     /// distribution. In a non-MPI build this method does nothing.
@@ -1039,7 +1058,7 @@ namespace oomph
       unsigned n = nrow_local();
       for (unsigned long i = 0; i < n; i++)
       {
-        for (long j = row_start()[i]; j < row_start()[i + 1]; j++)
+        for (SparseOffset j = row_start()[i]; j < row_start()[i + 1]; j++)
         {
           some_file << first_row + i << " " << column_index()[j] << " "
                     << value()[j] << std::endl;
@@ -1057,13 +1076,13 @@ namespace oomph
     }
 
     /// Access to C-style row_start array
-    int* row_start()
+    SparseOffset* row_start()
     {
       return CR_matrix.row_start();
     }
 
     /// Access to C-style row_start array (const version)
-    const int* row_start() const
+    const SparseOffset* row_start() const
     {
       return CR_matrix.row_start();
     }
@@ -1098,6 +1117,29 @@ namespace oomph
       return CR_matrix.nnz();
     }
 
+    /// Number of bytes held by the (local) values, column indices and
+    /// row starts of the matrix, and by the lookup for its diagonal
+    /// entries
+    double memory_usage_in_bytes() const
+    {
+      double nbyte = double(nnz()) * (sizeof(double) + sizeof(int)) +
+                     double(Index_of_diagonal_entries.size()) *
+                       sizeof(SparseOffset);
+      if (Built)
+      {
+        nbyte += double(nrow_local() + 1) * sizeof(SparseOffset);
+      }
+      return nbyte;
+    }
+
+    /// Add the memory usage of the matrix (see memory_usage_in_bytes())
+    /// to the given category of the memory account
+    void get_memory_usage(MemoryAccount& account,
+                          const std::string& category = "matrix") const
+    {
+      account.add(category, memory_usage_in_bytes());
+    }
+
     /// LU decomposition using SuperLU if matrix is not distributed or
     /// distributed onto a single processor.
     virtual void ludecompose();
@@ -1235,7 +1277,7 @@ namespace oomph
   private:
     /// Vector whose i'th entry contains the index of the last entry
     /// below or on the diagonal of the i'th row of the matrix
-    Vector<int> Index_of_diagonal_entries;
+    Vector<SparseOffset> Index_of_diagonal_entries;
 
     /// Flag to determine which matrix-matrix multiplication method is
     /// used (for serial (or global) matrices)
@@ -2599,7 +2641,7 @@ namespace oomph
     /// to its correct length.
     CCMatrix(const Vector<T>& value,
              const Vector<int>& row_index_,
-             const Vector<int>& column_start_,
+             const Vector<SparseOffset>& column_start_,
              const unsigned long& n,
              const unsigned long& m)
       : SparseMatrix<T, CCMatrix<T>>()
@@ -2627,7 +2669,7 @@ namespace oomph
       }
 
       // Column start:
-      Column_start = new int[this->M + 1];
+      Column_start = new SparseOffset[this->M + 1];
 
       // Assign:
       for (unsigned long i = 0; i <= this->M; i++)
@@ -2656,7 +2698,7 @@ namespace oomph
 #ifdef RANGE_CHECKING
       this->range_check(i, j);
 #endif
-      for (long k = Column_start[j]; k < Column_start[j + 1]; k++)
+      for (SparseOffset k = Column_start[j]; k < Column_start[j + 1]; k++)
       {
         if (unsigned(Row_index[k]) == i)
         {
@@ -2689,13 +2731,13 @@ namespace oomph
     }
 
     /// Access to C-style column_start array
-    int* column_start()
+    SparseOffset* column_start()
     {
       return Column_start;
     }
 
     /// Access to C-style column_start array (const version)
-    const int* column_start() const
+    const SparseOffset* column_start() const
     {
       return Column_start;
     }
@@ -2736,7 +2778,7 @@ namespace oomph
     {
       for (unsigned long j = 0; j < this->N; j++)
       {
-        for (long k = Column_start[j]; k < Column_start[j + 1]; k++)
+        for (SparseOffset k = Column_start[j]; k < Column_start[j + 1]; k++)
         {
           outfile << Row_index[k] << " " << j << " " << this->Value[k]
                   << std::endl;
@@ -2754,7 +2796,7 @@ namespace oomph
     /// to its correct length.
     void build(const Vector<T>& value,
                const Vector<int>& row_index,
-               const Vector<int>& column_start,
+               const Vector<SparseOffset>& column_start,
                const unsigned long& n,
                const unsigned long& m);
 
@@ -2765,7 +2807,7 @@ namespace oomph
     /// make a copy of the data pointed to by the first three arguments!
     void build_without_copy(T* value,
                             int* row_index,
-                            int* column_start,
+                            SparseOffset* column_start,
                             const unsigned long& nnz,
                             const unsigned long& n,
                             const unsigned long& m);
@@ -2776,7 +2818,7 @@ namespace oomph
     int* Row_index;
 
     /// Start index for column
-    int* Column_start;
+    SparseOffset* Column_start;
   };
 
   /// ////////////////////////////////////////////////////////////////
@@ -2800,7 +2842,7 @@ namespace oomph
     /// to its correct length.
     CCDoubleMatrix(const Vector<double>& value,
                    const Vector<int>& row_index_,
-                   const Vector<int>& column_start_,
+                   const Vector<SparseOffset>& column_start_,
                    const unsigned long& n,
                    const unsigned long& m);
 
@@ -3198,7 +3240,7 @@ namespace oomph
   template<class T>
   void CCMatrix<T>::build_without_copy(T* value,
                                        int* row_index,
-                                       int* column_start,
+                                       SparseOffset* column_start,
                                        const unsigned long& nnz,
                                        const unsigned long& n,
                                        const unsigned long& m)
@@ -3246,7 +3288,7 @@ namespace oomph
   template<class T>
   void CCMatrix<T>::build(const Vector<T>& value,
                           const Vector<int>& row_index_,
-                          const Vector<int>& column_start_,
+                          const Vector<SparseOffset>& column_start_,
                           const unsigned long& n,
                           const unsigned long& m)
   {
@@ -3302,7 +3344,7 @@ namespace oomph
     // Column start:
     // Find the size and aollcate
     unsigned long n_column_start = column_start_.size();
-    this->Column_start = new int[n_column_start];
+    this->Column_start = new SparseOffset[n_column_start];
 
     // Assign:
     for (unsigned long i = 0; i < n_column_start; i++)
@@ -3353,7 +3395,7 @@ namespace oomph
   template<class T>
   void CRMatrix<T>::build_without_copy(T* value,
                                        int* column_index_,
-                                       int* row_start_,
+                                       SparseOffset* row_start_,
                                        const unsigned long& nnz,
                                        const unsigned long& n,
                                        const unsigned long& m)
@@ -3403,7 +3445,7 @@ namespace oomph
   template<class T>
   void CRMatrix<T>::build(const Vector<T>& value,
                           const Vector<int>& column_index_,
-                          const Vector<int>& row_start_,
+                          const Vector<SparseOffset>& row_start_,
                           const unsigned long& n,
                           const unsigned long& m)
   {
@@ -3458,7 +3500,7 @@ namespace oomph
     // Row start:
     // Find the size and allocate
     unsigned long n_row_start = row_start_.size();
-    this->Row_start = new int[n_row_start];
+    this->Row_start = new SparseOffset[n_row_start];
 
     // Assign:
     for (unsigned long i = 0; i < n_row_start; i++)
@@ -3536,12 +3578,12 @@ namespace oomph
       // Storage for the values, column indices and row start
       double* out_values = new double[in_nnz];
       int* out_column_indices = new int[in_nnz];
-      int* out_row_start = new int[in_nrow_local + 1];
+      SparseOffset* out_row_start = new SparseOffset[in_nrow_local + 1];
 
       // The data to copy over
       const double* const in_values = in_matrix_pt->value();
       const int* const in_column_indices = in_matrix_pt->column_index();
-      const int* const in_row_start = in_matrix_pt->row_start();
+      const SparseOffset* const in_row_start = in_matrix_pt->row_start();
 
       // Copy the data
       std::copy(in_values, in_values + in_nnz, out_values);
@@ -3578,7 +3620,7 @@ namespace oomph
       const OomphCommunicator* const comm_pt,
       const Vector<double>& values,
       const Vector<int>& column_indicies,
-      const Vector<int>& row_start,
+      const Vector<SparseOffset>& row_start,
       CRDoubleMatrix& mat_out);
 
 
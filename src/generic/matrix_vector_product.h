@@ -86,6 +86,27 @@ namespace oomph
       Column_distribution_pt = 0;
     }
 
+    /// Add the memory held by the (oomph-lib or Epetra) copy of the
+    /// matrix to the given category of the account
+    void get_memory_usage(MemoryAccount& account,
+                          const std::string& category) const
+    {
+#ifdef OOMPH_HAS_TRILINOS
+      if (Epetra_matrix_pt != 0)
+      {
+        account.add(
+          category,
+          double(Epetra_matrix_pt->NumMyNonzeros()) *
+              (sizeof(double) + sizeof(int)) +
+            double(Epetra_matrix_pt->NumMyRows() + 1) * sizeof(int));
+      }
+#endif
+      if (Oomph_matrix_pt != 0)
+      {
+        Oomph_matrix_pt->get_memory_usage(account, category);
+      }
+    }
+
     /// Setup the matrix vector product operator.
     /// WARNING: This class is wrapper to Trilinos Epetra matrix vector
     /// multiply methods, if Trilinos is not installed then this class will
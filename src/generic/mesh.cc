@@ -772,6 +772,92 @@ namespace oomph
     }
   }
 
+#ifdef OOMPH_HAS_MPI
+
+  //========================================================
+  /// Helper: Number of bytes held by a halo lookup scheme, i.e. a map
+  /// from processor IDs to vectors of pointers
+  //========================================================
+  template<class T>
+  double nbyte_of_halo_lookup(const std::map<unsigned, Vector<T*>>& lookup)
+  {
+    double nbyte = 0.0;
+    for (typename std::map<unsigned, Vector<T*>>::const_iterator it =
+           lookup.begin();
+         it != lookup.end();
+         it++)
+    {
+      nbyte += sizeof(unsigned) + double(it->second.size()) * sizeof(T*);
+    }
+    return nbyte;
+  }
+
+#endif
+
+  //========================================================
+  /// Add the memory held by the nodes, the elements and the
+  /// lookup schemes of the mesh to the account
+  //========================================================
+  void Mesh::get_memory_usage(MemoryAccount& account) const
+  {
+    // Nodes
+    double node_nbyte = double(Node_pt.size()) * sizeof(Node*);
+    const unsigned long n_node = Node_pt.size();
+    for (unsigned long n = 0; n < n_node; n++)
+    {
+      node_nbyte += Node_pt[n]->memory_usage_in_bytes();
+    }
+    account.add("nodes", node_nbyte);
+
+    // Elements
+    double element_nbyte =
+      double(Element_pt.size()) * sizeof(GeneralisedElement*);
+    const unsigned long n_element = Element_pt.size();
+    for (unsigned long e = 0; e < n_element; e++)
+    {
+      element_nbyte += Element_pt[e]->memory_usage_in_bytes();
+    }
+    account.add("elements", element_nbyte);
+
+    // Boundary lookup schemes
+    double boundary_nbyte = 0.0;
+    const unsigned n_boundary = Boundary_node_pt.size();
+    for (unsigned b = 0; b < n_boundary; b++)
+    {
+      boundary_nbyte += double(Boundary_node_pt[b].size()) * sizeof(Node*);
+    }
+    const unsigned n_element_boundary = Boundary_element_pt.size();
+    for (unsigned b = 0; b < n_element_boundary; b++)
+    {
+      boundary_nbyte +=
+        double(Boundary_element_pt[b].size()) * sizeof(FiniteElement*);
+    }
+    const unsigned n_face_boundary = Face_index_at_boundary.size();
+    for (unsigned b = 0; b < n_face_boundary; b++)
+    {
+      boundary_nbyte += double(Face_index_at_boundary[b].size()) * sizeof(int);
+    }
+    account.add("boundary_lookup", boundary_nbyte);
+
+#ifdef OOMPH_HAS_MPI
+    // Halo lookup schemes (only present for distributed meshes)
+    double halo_nbyte = nbyte_of_halo_lookup(Root_halo_element_pt) +
+                        nbyte_of_halo_lookup(Root_haloed_element_pt) +
+                        nbyte_of_halo_lookup(Halo_node_pt) +
+                        nbyte_of_halo_lookup(Haloed_node_pt) +
+                        nbyte_of_halo_lookup(Shared_node_pt) +
+                        nbyte_of_halo_lookup(External_halo_element_pt) +
+                        nbyte_of_halo_lookup(External_haloed_element_pt) +
+                        nbyte_of_halo_lookup(External_halo_node_pt) +
+                        nbyte_of_halo_lookup(External_haloed_node_pt);
+    if (halo_nbyte > 0.0)
+    {
+      account.add("halo_lookup", halo_nbyte);
+    }
+#endif
+  }
+
+
   //========================================================
   /// Self-test: Check elements and nodes. Return 0 for OK
   //========================================================
@@ -2018,6 +2104,581 @@ namespace oomph
   }
 
 
+  //========================================================
+  /// Output in paraview's binary XML format (.vtu) into
+  /// specified file.
+  ///
+  /// All data (coordinates, scalars and cells) is assembled
+  /// in memory in a single pass over the elements and then
+  /// written as binary (base64-encoded or raw appended) data
+  /// arrays. If merge_coincident_points is true, plot points
+  /// that are shared between sub-elements of adjacent elements
+  /// are only written once. Points are only merged if all
+  /// scalars agree, so discontinuous fields are preserved.
+  //========================================================
+  void Mesh::output_paraview_binary(
+    std::ofstream& file_out,
+    const unsigned& nplot,
+    const ParaviewBinaryEncoding& encoding,
+    const bool& merge_coincident_points) const
+  {
+    // Collect the elements that are to be plotted
+    unsigned long n_element = this->Element_pt.size();
+    Vector<FiniteElement*> plot_el_pt;
+    plot_el_pt.reserve(n_element);
+    for (unsigned long e = 0; e < n_element; e++)
+    {
+      FiniteElement* fe_pt = dynamic_cast<FiniteElement*>(Element_pt[e]);
+
+#ifdef PARANOID
+      if (fe_pt == 0)
+      {
+        std::stringstream error_stream;
+        error_stream << "Recast for element " << e << " failed" << std::endl;
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+
+#ifdef OOMPH_HAS_MPI
+      // Skip halo elements; they're written by the processor that
+      // owns them
+      if ((!Output_halo_elements) && (fe_pt->is_halo()))
+      {
+        continue;
+      }
+#endif
+      plot_el_pt.push_back(fe_pt);
+    }
+    unsigned long n_plot_element = plot_el_pt.size();
+
+    // Number of scalars (all elements have to agree, or paraview breaks)
+    unsigned n_scalar = 0;
+    if (n_plot_element > 0)
+    {
+      n_scalar = plot_el_pt[0]->nscalar_paraview();
+    }
+
+#ifdef PARANOID
+    for (unsigned long e = 1; e < n_plot_element; e++)
+    {
+      if (plot_el_pt[e]->nscalar_paraview() != n_scalar)
+      {
+        std::stringstream error_stream;
+        error_stream
+          << "Element " << e << " has different number of degrees of freedom\n"
+          << "than from previous elements, Paraview cannot handle this.\n"
+          << "We suggest that the problem is broken up into submeshes instead."
+          << std::endl;
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+    }
+#endif
+
+
+    // Assemble the data in memory
+    //----------------------------
+
+    // Coordinates of the plot points (always three per point) and
+    // the scalars at the plot points
+    Vector<double> point_coord;
+    Vector<Vector<double>> scalar(n_scalar);
+
+    // Connectivity (in terms of the global plot point numbers), offsets
+    // and types of the sub-elements
+    Vector<int> connectivity;
+    Vector<int> offsets;
+    Vector<int> types;
+
+    // Storage for the element's contributions
+    Vector<double> el_values;
+    Vector<int> el_connectivity;
+    Vector<int> el_offsets;
+    Vector<int> el_types;
+
+    unsigned long n_point = 0;
+    for (unsigned long e = 0; e < n_plot_element; e++)
+    {
+      FiniteElement* fe_pt = plot_el_pt[e];
+
+      // Coordinates of the plot points
+      unsigned n_dim = fe_pt->nodal_dimension();
+      if (n_dim > 3)
+      {
+        throw OomphLibError(
+          "Printing PlotPoint to .vtu failed; it has >3 dimensions.",
+          OOMPH_CURRENT_FUNCTION,
+          OOMPH_EXCEPTION_LOCATION);
+      }
+      Vector<double> s(fe_pt->dim(), 0.0);
+      Vector<double> x(n_dim, 0.0);
+      unsigned n_el_point = fe_pt->nplot_points_paraview(nplot);
+      for (unsigned j = 0; j < n_el_point; j++)
+      {
+        fe_pt->get_s_plot(j, nplot, s);
+        fe_pt->interpolated_x(s, x);
+        for (unsigned i = 0; i < 3; i++)
+        {
+          point_coord.push_back(i < n_dim ? x[i] : 0.0);
+        }
+      }
+
+      // Scalars
+      for (unsigned i = 0; i < n_scalar; i++)
+      {
+        fe_pt->scalar_values_paraview(i, nplot, el_values);
+        scalar[i].insert(scalar[i].end(), el_values.begin(), el_values.end());
+      }
+
+      // Cells: shift connectivity by the number of points written so far
+      // and offsets by the length of the connectivity written so far
+      fe_pt->paraview_cells(nplot, el_connectivity, el_offsets, el_types);
+      int connectivity_shift = connectivity.size();
+      unsigned n_el_connectivity = el_connectivity.size();
+      for (unsigned j = 0; j < n_el_connectivity; j++)
+      {
+        connectivity.push_back(el_connectivity[j] + int(n_point));
+      }
+      unsigned n_sub = el_offsets.size();
+      for (unsigned j = 0; j < n_sub; j++)
+      {
+        offsets.push_back(el_offsets[j] + connectivity_shift);
+        types.push_back(el_types[j]);
+      }
+
+      n_point += n_el_point;
+    }
+
+
+    // Merge coincident plot points
+    //-----------------------------
+
+    // New number of each plot point
+    Vector<unsigned long> new_point_number(n_point);
+    unsigned long n_merged_point = n_point;
+    if (merge_coincident_points && (n_point > 0))
+    {
+      // Tolerance for coincidence, relative to the size of the
+      // bounding box
+      double x_min[3];
+      double x_max[3];
+      for (unsigned i = 0; i < 3; i++)
+      {
+        x_min[i] = DBL_MAX;
+        x_max[i] = -DBL_MAX;
+      }
+      for (unsigned long j = 0; j < n_point; j++)
+      {
+        for (unsigned i = 0; i < 3; i++)
+        {
+          x_min[i] = std::min(x_min[i], point_coord[3 * j + i]);
+          x_max[i] = std::max(x_max[i], point_coord[3 * j + i]);
+        }
+      }
+      double diagonal = 0.0;
+      for (unsigned i = 0; i < 3; i++)
+      {
+        diagonal += (x_max[i] - x_min[i]) * (x_max[i] - x_min[i]);
+      }
+      double tol = 1.0e-10 * sqrt(diagonal);
+      if (tol == 0.0)
+      {
+        tol = 1.0e-10;
+      }
+
+      // Tolerance for the scalars, relative to their magnitude
+      Vector<double> scalar_tol(n_scalar, 0.0);
+      for (unsigned i = 0; i < n_scalar; i++)
+      {
+        for (unsigned long j = 0; j < n_point; j++)
+        {
+          scalar_tol[i] = std::max(scalar_tol[i], std::fabs(scalar[i][j]));
+        }
+        scalar_tol[i] *= 1.0e-8;
+      }
+
+      // Bin the points into cells of size tol. Points that are within
+      // tol of each other (in each coordinate direction) are in the same
+      // or in neighbouring cells, so compare each point against the
+      // representatives that have already been found in its own cell and
+      // in the neighbouring ones, and map it onto the first one that
+      // carries the same scalars. Processing the points in their
+      // original order ensures that representatives always precede the
+      // points they represent.
+      std::map<Vector<long long>, Vector<unsigned long>> cell_point;
+      Vector<unsigned long> representative(n_point);
+      Vector<long long> cell(3);
+      Vector<long long> neighbour_cell(3);
+      for (unsigned long j = 0; j < n_point; j++)
+      {
+        for (unsigned i = 0; i < 3; i++)
+        {
+          cell[i] =
+            (long long)(floor((point_coord[3 * j + i] - x_min[i]) / tol));
+        }
+
+        representative[j] = j;
+        for (unsigned neighbour = 0; neighbour < 27; neighbour++)
+        {
+          neighbour_cell[0] = cell[0] + (long long)(neighbour % 3) - 1;
+          neighbour_cell[1] = cell[1] + (long long)((neighbour / 3) % 3) - 1;
+          neighbour_cell[2] = cell[2] + (long long)(neighbour / 9) - 1;
+          std::map<Vector<long long>, Vector<unsigned long>>::iterator
+            it = cell_point.find(neighbour_cell);
+          if (it == cell_point.end()) continue;
+
+          unsigned long n_candidate = it->second.size();
+          for (unsigned long l = 0; l < n_candidate; l++)
+          {
+            unsigned long candidate = it->second[l];
+            bool same_point = true;
+            for (unsigned i = 0; i < 3; i++)
+            {
+              if (!(std::fabs(point_coord[3 * j + i] -
+                              point_coord[3 * candidate + i]) <= tol))
+              {
+                same_point = false;
+                break;
+              }
+            }
+            for (unsigned i = 0; same_point && (i < n_scalar); i++)
+            {
+              if (!(std::fabs(scalar[i][j] - scalar[i][candidate]) <=
+                    scalar_tol[i]))
+              {
+                same_point = false;
+              }
+            }
+
+            // Keep the representative with the lowest number
+            if (same_point && (candidate < representative[j]))
+            {
+              representative[j] = candidate;
+            }
+          }
+        }
+
+        // New representative
+        if (representative[j] == j)
+        {
+          cell_point[cell].push_back(j);
+        }
+      }
+
+      // Renumber the remaining points, retaining their original order
+      // (representatives always precede the points they represent)
+      n_merged_point = 0;
+      for (unsigned long j = 0; j < n_point; j++)
+      {
+        if (representative[j] == j)
+        {
+          new_point_number[j] = n_merged_point++;
+        }
+        else
+        {
+          new_point_number[j] = new_point_number[representative[j]];
+        }
+      }
+    }
+    else
+    {
+      for (unsigned long j = 0; j < n_point; j++)
+      {
+        new_point_number[j] = j;
+      }
+    }
+
+
+    // Convert to the types written to file
+    //-------------------------------------
+
+    Vector<float> point_coord_out(3 * n_merged_point);
+    Vector<Vector<float>> scalar_out(n_scalar);
+    for (unsigned i = 0; i < n_scalar; i++)
+    {
+      scalar_out[i].resize(n_merged_point);
+    }
+    for (unsigned long j = 0; j < n_point; j++)
+    {
+      unsigned long jj = new_point_number[j];
+      for (unsigned i = 0; i < 3; i++)
+      {
+        point_coord_out[3 * jj + i] = float(point_coord[3 * j + i]);
+      }
+      for (unsigned i = 0; i < n_scalar; i++)
+      {
+        scalar_out[i][jj] = float(scalar[i][j]);
+      }
+    }
+    unsigned long n_connectivity = connectivity.size();
+    for (unsigned long j = 0; j < n_connectivity; j++)
+    {
+      connectivity[j] = int(new_point_number[connectivity[j]]);
+    }
+    unsigned long n_cell = types.size();
+    Vector<unsigned char> types_out(n_cell);
+    for (unsigned long j = 0; j < n_cell; j++)
+    {
+      types_out[j] = (unsigned char)(types[j]);
+    }
+
+
+    // Write the file
+    //---------------
+
+    // Pointers to and sizes (in bytes) of the data arrays, in the order
+    // in which they're written
+    Vector<std::pair<const unsigned char*, unsigned long long>> data_array;
+    Vector<std::string> data_array_attributes;
+    for (unsigned i = 0; i < n_scalar; i++)
+    {
+      data_array.push_back(std::make_pair(
+        reinterpret_cast<const unsigned char*>(scalar_out[i].data()),
+        (unsigned long long)(sizeof(float) * n_merged_point)));
+      data_array_attributes.push_back(
+        "type=\"Float32\" Name=\"" +
+        plot_el_pt[0]->scalar_name_paraview(i) + "\"");
+    }
+    data_array.push_back(std::make_pair(
+      reinterpret_cast<const unsigned char*>(point_coord_out.data()),
+      (unsigned long long)(sizeof(float) * 3 * n_merged_point)));
+    data_array_attributes.push_back(
+      "type=\"Float32\" NumberOfComponents=\"3\"");
+    data_array.push_back(std::make_pair(
+      reinterpret_cast<const unsigned char*>(connectivity.data()),
+      (unsigned long long)(sizeof(int) * n_connectivity)));
+    data_array_attributes.push_back("type=\"Int32\" Name=\"connectivity\"");
+    data_array.push_back(std::make_pair(
+      reinterpret_cast<const unsigned char*>(offsets.data()),
+      (unsigned long long)(sizeof(int) * n_cell)));
+    data_array_attributes.push_back("type=\"Int32\" Name=\"offsets\"");
+    data_array.push_back(std::make_pair(
+      reinterpret_cast<const unsigned char*>(types_out.data()),
+      (unsigned long long)(n_cell)));
+    data_array_attributes.push_back("type=\"UInt8\" Name=\"types\"");
+
+    // Write a single data array: either inline (base64-encoded, with the
+    // size of the data as a separately encoded UInt64 header) or as
+    // a reference to the appended data
+    unsigned long long appended_offset = 0;
+
+    // Header
+    file_out << "<?xml version=\"1.0\"?>\n"
+             << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" "
+             << "byte_order=\"" << ParaviewHelper::byte_order() << "\" "
+             << "header_type=\"UInt64\">\n"
+             << "<UnstructuredGrid>\n"
+             << "<Piece NumberOfPoints=\"" << n_merged_point
+             << "\" NumberOfCells=\"" << n_cell << "\">\n";
+
+    // Loop over the sections of the file and the data arrays in them
+    unsigned n_data_array = data_array.size();
+    for (unsigned a = 0; a < n_data_array; a++)
+    {
+      // Open the sections
+      if ((a == 0) && (n_scalar > 0))
+      {
+        file_out << "<PointData Scalars=\""
+                 << plot_el_pt[0]->scalar_name_paraview(0) << "\">\n";
+      }
+      else if (a == n_scalar)
+      {
+        file_out << "<Points>\n";
+      }
+      else if (a == n_scalar + 1)
+      {
+        file_out << "<Cells>\n";
+      }
+
+      file_out << "<DataArray " << data_array_attributes[a];
+      unsigned long long nbyte = data_array[a].second;
+      if (encoding == Paraview_raw_appended)
+      {
+        file_out << " format=\"appended\" offset=\"" << appended_offset
+                 << "\"/>\n";
+        appended_offset += sizeof(unsigned long long) + nbyte;
+      }
+      else
+      {
+        file_out << " format=\"binary\">\n"
+                 << ParaviewHelper::base64_encode(
+                      reinterpret_cast<const unsigned char*>(&nbyte),
+                      sizeof(unsigned long long))
+                 << ParaviewHelper::base64_encode(data_array[a].first, nbyte)
+                 << "\n</DataArray>\n";
+      }
+
+      // Close the sections
+      if ((n_scalar > 0) && (a == n_scalar - 1))
+      {
+        file_out << "</PointData>\n";
+      }
+      else if (a == n_scalar)
+      {
+        file_out << "</Points>\n";
+      }
+      else if (a == n_data_array - 1)
+      {
+        file_out << "</Cells>\n";
+      }
+    }
+
+    file_out << "</Piece>\n"
+             << "</UnstructuredGrid>\n";
+
+    // Raw binary data: UInt64 size of each array followed by its data
+    if (encoding == Paraview_raw_appended)
+    {
+      file_out << "<AppendedData encoding=\"raw\">\n_";
+      for (unsigned a = 0; a < n_data_array; a++)
+      {
+        unsigned long long nbyte = data_array[a].second;
+        file_out.write(reinterpret_cast<const char*>(&nbyte),
+                       sizeof(unsigned long long));
+        if (nbyte > 0)
+        {
+          file_out.write(reinterpret_cast<const char*>(data_array[a].first),
+                         nbyte);
+        }
+      }
+      file_out << "\n</AppendedData>\n";
+    }
+
+    file_out << "</VTKFile>";
+  }
+
+
+  //========================================================
+  /// Output in paraview's binary XML format into files
+  /// with the specified stem: a single .vtu file for
+  /// non-distributed meshes; one .vtu piece per processor plus
+  /// a .pvtu file (written by processor 0) otherwise.
+  //========================================================
+  void Mesh::output_paraview_binary(
+    const std::string& file_stem,
+    const unsigned& nplot,
+    const ParaviewBinaryEncoding& encoding,
+    const bool& merge_coincident_points) const
+  {
+#ifdef OOMPH_HAS_MPI
+    if (is_mesh_distributed())
+    {
+      unsigned n_proc = Comm_pt->nproc();
+      unsigned my_rank = Comm_pt->my_rank();
+
+      // Names of the pieces (relative to the pvtu file, so strip
+      // any directories)
+      Vector<std::string> piece_filename(n_proc);
+      std::string::size_type slash = file_stem.find_last_of('/');
+      std::string file_base = (slash == std::string::npos) ?
+                                file_stem :
+                                file_stem.substr(slash + 1);
+      for (unsigned p = 0; p < n_proc; p++)
+      {
+        piece_filename[p] =
+          file_base + "_proc" + StringConversion::to_string(p) + ".vtu";
+      }
+
+      // Write our own piece
+      std::ofstream piece_file(
+        (file_stem + "_proc" + StringConversion::to_string(my_rank) + ".vtu")
+          .c_str(),
+        std::ios_base::out | std::ios_base::binary);
+      output_paraview_binary(
+        piece_file, nplot, encoding, merge_coincident_points);
+      piece_file.close();
+
+      // Processor zero writes the file that collects the pieces. The
+      // scalar names are only available from an element, so ask
+      // a processor that has some.
+      int n_scalar = -1;
+      Vector<std::string> scalar_name;
+      unsigned long n_element = Element_pt.size();
+      for (unsigned long e = 0; e < n_element; e++)
+      {
+        FiniteElement* fe_pt = dynamic_cast<FiniteElement*>(Element_pt[e]);
+        if ((fe_pt != 0) && (Output_halo_elements || (!fe_pt->is_halo())))
+        {
+          n_scalar = fe_pt->nscalar_paraview();
+          for (int i = 0; i < n_scalar; i++)
+          {
+            scalar_name.push_back(fe_pt->scalar_name_paraview(i));
+          }
+          break;
+        }
+      }
+
+      // Find the lowest rank that has elements and get it to send the
+      // names to processor zero
+      int has_elements = (n_scalar >= 0) ? int(my_rank) : int(n_proc);
+      int source_rank = int(n_proc);
+      MPI_Allreduce(&has_elements,
+                    &source_rank,
+                    1,
+                    MPI_INT,
+                    MPI_MIN,
+                    Comm_pt->mpi_comm());
+      if ((source_rank != int(n_proc)) && (source_rank != 0))
+      {
+        if (int(my_rank) == source_rank)
+        {
+          std::string names;
+          for (int i = 0; i < n_scalar; i++)
+          {
+            names += scalar_name[i] + "\n";
+          }
+          int n_char = names.size();
+          MPI_Send(&n_char, 1, MPI_INT, 0, 0, Comm_pt->mpi_comm());
+          if (n_char > 0)
+          {
+            MPI_Send(&names[0], n_char, MPI_CHAR, 0, 1, Comm_pt->mpi_comm());
+          }
+        }
+        else if (my_rank == 0)
+        {
+          int n_char = 0;
+          MPI_Status status;
+          MPI_Recv(
+            &n_char, 1, MPI_INT, source_rank, 0, Comm_pt->mpi_comm(), &status);
+          std::string names(n_char, ' ');
+          if (n_char > 0)
+          {
+            MPI_Recv(&names[0],
+                     n_char,
+                     MPI_CHAR,
+                     source_rank,
+                     1,
+                     Comm_pt->mpi_comm(),
+                     &status);
+          }
+          scalar_name.clear();
+          std::istringstream names_stream(names);
+          std::string name;
+          while (std::getline(names_stream, name))
+          {
+            scalar_name.push_back(name);
+          }
+        }
+      }
+
+      if (my_rank == 0)
+      {
+        std::ofstream pvtu_file((file_stem + ".pvtu").c_str());
+        ParaviewHelper::write_pvtu_file(pvtu_file, piece_filename, scalar_name);
+        pvtu_file.close();
+      }
+      return;
+    }
+#endif
+
+    std::ofstream file_out((file_stem + ".vtu").c_str(),
+                           std::ios_base::out | std::ios_base::binary);
+    output_paraview_binary(file_out, nplot, encoding, merge_coincident_points);
+    file_out.close();
+  }
+
+
   //========================================================
   /// Output function for the mesh class
   ///
@@ -9641,6 +10302,99 @@ namespace oomph
       pvd_file << "</Collection>" << std::endl << "</VTKFile>";
     }
 
+    /// Byte order of this machine, as specified in the header
+    /// of VTK's XML files: "LittleEndian" or "BigEndian"
+    std::string byte_order()
+    {
+      unsigned one = 1;
+      if (*reinterpret_cast<unsigned char*>(&one) == 1)
+      {
+        return "LittleEndian";
+      }
+      return "BigEndian";
+    }
+
+    /// Base64-encode nbyte bytes of data, as required for inline binary
+    /// data arrays in VTK's XML files.
+    std::string base64_encode(const unsigned char* data,
+                              const unsigned long& nbyte)
+    {
+      static const char alphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+      std::string encoded;
+      encoded.reserve(4 * ((nbyte + 2) / 3));
+
+      // Each group of three bytes turns into four characters
+      unsigned long i = 0;
+      for (; i + 2 < nbyte; i += 3)
+      {
+        unsigned long triple = (static_cast<unsigned long>(data[i]) << 16) |
+                               (static_cast<unsigned long>(data[i + 1]) << 8) |
+                               static_cast<unsigned long>(data[i + 2]);
+        encoded += alphabet[(triple >> 18) & 63];
+        encoded += alphabet[(triple >> 12) & 63];
+        encoded += alphabet[(triple >> 6) & 63];
+        encoded += alphabet[triple & 63];
+      }
+
+      // Pad the remaining one or two bytes
+      unsigned long n_remaining = nbyte - i;
+      if (n_remaining > 0)
+      {
+        unsigned long triple = static_cast<unsigned long>(data[i]) << 16;
+        if (n_remaining == 2)
+        {
+          triple |= static_cast<unsigned long>(data[i + 1]) << 8;
+        }
+        encoded += alphabet[(triple >> 18) & 63];
+        encoded += alphabet[(triple >> 12) & 63];
+        encoded += (n_remaining == 2) ? alphabet[(triple >> 6) & 63] : '=';
+        encoded += '=';
+      }
+
+      return encoded;
+    }
+
+    /// Write the pvtu file that collects the .vtu files written by
+    /// the different processors in a distributed run. The scalar names
+    /// and the number of scalars must match those in the pieces.
+    void write_pvtu_file(std::ofstream& pvtu_file,
+                         const Vector<std::string>& piece_filename,
+                         const Vector<std::string>& scalar_name)
+    {
+      pvtu_file << "<?xml version=\"1.0\"?>\n"
+                << "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" "
+                << "byte_order=\"" << byte_order() << "\" "
+                << "header_type=\"UInt64\">\n"
+                << "<PUnstructuredGrid GhostLevel=\"0\">\n";
+
+      unsigned n_scalar = scalar_name.size();
+      if (n_scalar > 0)
+      {
+        pvtu_file << "<PPointData Scalars=\"" << scalar_name[0] << "\">\n";
+        for (unsigned i = 0; i < n_scalar; i++)
+        {
+          pvtu_file << "<PDataArray type=\"Float32\" Name=\"" << scalar_name[i]
+                    << "\"/>\n";
+        }
+        pvtu_file << "</PPointData>\n";
+      }
+
+      pvtu_file << "<PPoints>\n"
+                << "<PDataArray type=\"Float32\" NumberOfComponents=\"3\"/>\n"
+                << "</PPoints>\n";
+
+      unsigned n_piece = piece_filename.size();
+      for (unsigned p = 0; p < n_piece; p++)
+      {
+        pvtu_file << "<Piece Source=\"" << piece_filename[p] << "\"/>\n";
+      }
+
+      pvtu_file << "</PUnstructuredGrid>\n"
+                << "</VTKFile>";
+    }
+
   } // namespace ParaviewHelper
 
   /// /////////////////////////////////////////////////////////////
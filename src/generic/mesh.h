@@ -185,6 +185,11 @@ namespace oomph
     /// Vector of pointers to generalised elements
     Vector<GeneralisedElement*> Element_pt;
 
+    /// Counter that is incremented whenever the elements stored in
+    /// the mesh are replaced (e.g. during mesh adaptation); see
+    /// element_storage_generation()
+    unsigned long Element_storage_generation;
+
     /// Vector of boolean data that indicates whether the boundary
     /// coordinates have been set for the boundary
     std::vector<bool> Boundary_coordinate_exists;
@@ -233,7 +238,7 @@ namespace oomph
     static bool Suppress_warning_about_empty_mesh_level_time_stepper_function;
 
     /// Default constructor
-    Mesh()
+    Mesh() : Element_storage_generation(0)
     {
       // Lookup scheme hasn't been setup yet
       Lookup_for_elements_next_boundary_is_setup = false;
@@ -254,7 +259,7 @@ namespace oomph
     /// Constructor builds combined mesh from the meshes specified.
     /// Note: This simply merges the meshes' elements and nodes (ignoring
     /// duplicates; no boundary information etc. is created).
-    Mesh(const Vector<Mesh*>& sub_mesh_pt)
+    Mesh(const Vector<Mesh*>& sub_mesh_pt) : Element_storage_generation(0)
     {
 #ifdef OOMPH_HAS_MPI
       // Mesh hasn't been distributed: Null out pointer to communicator
@@ -423,6 +428,7 @@ namespace oomph
     void flush_element_storage()
     {
       Element_pt.clear();
+      Element_storage_generation++;
     }
 
     /// Flush storage for nodes (only) by emptying the
@@ -592,6 +598,27 @@ namespace oomph
       return Element_pt.size();
     }
 
+    /// Generation of the element storage: a counter that is
+    /// incremented whenever the elements stored in the mesh are
+    /// replaced, e.g. when the mesh is adapted or its element storage is
+    /// flushed. Objects that store pointers to the mesh's elements
+    /// (e.g. the LineVisualiser) can compare it against the value at the
+    /// time they obtained their pointers to detect that the pointers may
+    /// be stale, even if the number of elements has not changed.
+    unsigned long element_storage_generation() const
+    {
+      return Element_storage_generation;
+    }
+
+    /// Increment the generation of the element storage (see
+    /// element_storage_generation()). Must be called by any
+    /// function that replaces the elements stored in the mesh
+    /// (mesh adaptation, load balancing, ...).
+    void increment_element_storage_generation()
+    {
+      Element_storage_generation++;
+    }
+
     /// Return number of nodes in the mesh
     unsigned long nnode() const
     {
@@ -686,6 +713,13 @@ namespace oomph
     /// Self-test: Check elements and nodes. Return 0 for OK
     unsigned self_test();
 
+    /// Add the memory held by the mesh to the account: the nodes
+    /// (category "nodes"), the elements ("elements"), the boundary
+    /// lookup schemes ("boundary_lookup") and, for distributed meshes,
+    /// the halo lookup schemes ("halo_lookup"). Only the storage
+    /// allocated by the base classes Node, FiniteElement etc. is counted.
+    void get_memory_usage(MemoryAccount& account) const;
+
 
     /// Determine max and min area for all FiniteElements in the mesh
     /// (non-FiniteElements are ignored)
@@ -959,6 +993,43 @@ namespace oomph
       const double& time,
       FiniteElement::UnsteadyExactSolutionFctPt exact_soln_pt) const;
 
+    /// Encoding of the data arrays in binary paraview output:
+    /// base64-encoded data inside the XML (the file is valid XML) or raw
+    /// binary data appended after the XML (smaller and faster to write
+    /// and read, but the file must be opened in binary mode).
+    enum ParaviewBinaryEncoding
+    {
+      Paraview_base64,
+      Paraview_raw_appended
+    };
+
+    /// Output in paraview's binary XML format (.vtu) into specified
+    /// file. Uses the same plot points and sub-elements as
+    /// output_paraview(...) but writes coordinates, scalars and cells as
+    /// binary data arrays, assembled in a single pass over the elements.
+    /// If merge_coincident_points is true, plot points that coincide
+    /// (and carry the same values for all scalars, so discontinuous
+    /// fields are preserved) are written only once and shared
+    /// by the adjacent sub-elements. Halo elements are skipped unless
+    /// their output has been enabled.
+    void output_paraview_binary(
+      std::ofstream& file_out,
+      const unsigned& nplot,
+      const ParaviewBinaryEncoding& encoding = Paraview_base64,
+      const bool& merge_coincident_points = true) const;
+
+    /// Output in paraview's binary XML format into files with the
+    /// specified stem. For non-distributed meshes this writes
+    /// file_stem.vtu. For distributed meshes each processor writes its
+    /// own (non-halo) elements to file_stem_proc[rank].vtu and processor 0
+    /// writes file_stem.pvtu which collects the pieces; open that
+    /// in paraview.
+    void output_paraview_binary(
+      const std::string& file_stem,
+      const unsigned& nplot,
+      const ParaviewBinaryEncoding& encoding = Paraview_base64,
+      const bool& merge_coincident_points = true) const;
+
     /// Output for all elements
     void output(std::ostream& outfile);
 
@@ -2903,6 +2974,22 @@ namespace oomph
     /// Write the pvd file footer
     extern void write_pvd_footer(std::ofstream& pvd_file);
 
+    /// Byte order of this machine, as specified in the header
+    /// of VTK's XML files: "LittleEndian" or "BigEndian"
+    extern std::string byte_order();
+
+    /// Base64-encode nbyte bytes of data, as required for inline binary
+    /// data arrays in VTK's XML files.
+    extern std::string base64_encode(const unsigned char* data,
+                                     const unsigned long& nbyte);
+
+    /// Write the pvtu file that collects the .vtu files written by
+    /// the different processors in a distributed run. The scalar names
+    /// and the number of scalars must match those in the pieces.
+    extern void write_pvtu_file(std::ofstream& pvtu_file,
+                                const Vector<std::string>& piece_filename,
+                                const Vector<std::string>& scalar_name);
+
   } // namespace ParaviewHelper
 
   /// /////////////////////////////////////////////////////////////
@@ -49,8 +49,8 @@ namespace oomph
   namespace MeshAsGeomObject_Helper
   {
     /// Default sample point container type. Must currently be one of
-    /// UseCGALSamplePointContainer, UseRefineableBinArray or
-    /// UseNonRefineableBinArray
+    /// UseCGALSamplePointContainer, UseRefineableBinArray,
+    /// UseNonRefineableBinArray or UseBVHSamplePointContainer
 #ifdef OOMPH_HAS_CGAL
     unsigned Default_sample_point_container_version =
       UseCGALSamplePointContainer;
@@ -79,6 +79,12 @@ namespace oomph
 
           break;
 
+        case UseBVHSamplePointContainer:
+          sample_point_container_parameters_pt =
+            new BVHSamplePointContainerParameters(mesh_pt);
+
+          break;
+
 #ifdef OOMPH_HAS_CGAL
 
         case UseCGALSamplePointContainer:
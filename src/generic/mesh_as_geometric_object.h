@@ -107,6 +107,11 @@ namespace oomph
       {
         Sample_point_container_version = UseNonRefineableBinArray;
       }
+      else if (dynamic_cast<BVHSamplePointContainerParameters*>(
+                 sample_point_container_parameters_pt) != 0)
+      {
+        Sample_point_container_version = UseBVHSamplePointContainer;
+      }
 #ifdef OOMPH_HAS_CGAL
       else if (dynamic_cast<CGALSamplePointContainerParameters*>(
                  sample_point_container_parameters_pt) != 0)
@@ -239,6 +244,12 @@ namespace oomph
             new NonRefineableBinArray(sample_point_container_parameters_pt);
           break;
 
+        case UseBVHSamplePointContainer:
+
+          Sample_point_container_pt =
+            new BVHSamplePointContainer(sample_point_container_parameters_pt);
+          break;
+
 #ifdef OOMPH_HAS_CGAL
 
         case UseCGALSamplePointContainer:
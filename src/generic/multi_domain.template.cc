@@ -1313,6 +1313,13 @@ namespace oomph
         }
       }
 #endif // cgal
+      // The search through the BVH is exhaustive so a single pass
+      // does it
+      else if (mesh_geom_obj_pt[0]->sample_point_container_version() ==
+               UseBVHSamplePointContainer)
+      {
+        has_not_reached_max_level_of_search = false;
+      }
     } // end of "spirals" loop
 
 
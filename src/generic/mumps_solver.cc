@@ -304,7 +304,7 @@ namespace oomph
         // Copy into coordinate storage scheme using pointer arithmetic
         double* matrix_value_pt = cr_matrix_pt->value();
         int* matrix_index_pt = cr_matrix_pt->column_index();
-        int* matrix_start_pt = cr_matrix_pt->row_start();
+        SparseOffset* matrix_start_pt = cr_matrix_pt->row_start();
         int i_row = 0;
 
         // is the matrix symmetric? If so, we must only provide
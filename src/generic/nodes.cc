@@ -30,6 +30,8 @@
 // oomph-lib headers
 #include "nodes.h"
 #include "timesteppers.h"
+#include "geom_objects.h"
+#include "elements.h"
 
 
 namespace oomph
@@ -525,6 +527,49 @@ namespace oomph
   }
 
 
+  //================================================================
+  /// Number of bytes held by the node: the values (see
+  /// Data::memory_usage_in_bytes()), the positions with their history
+  /// values, and the HangInfo objects (the geometric one may be shared
+  /// by the values, so it is only counted once).
+  //================================================================
+  double Node::memory_usage_in_bytes() const
+  {
+    double nbyte =
+      Data::memory_usage_in_bytes() + sizeof(Node) - sizeof(Data);
+
+    // Positions (X_position is allocated even if it is then made to point
+    // to the positions of another node by a copy)
+    if (X_position != 0)
+    {
+      unsigned n_tstorage = 1;
+      if (Position_time_stepper_pt != 0)
+      {
+        n_tstorage = Position_time_stepper_pt->ntstorage();
+      }
+      nbyte += double(Ndim * Nposition_type) *
+               (sizeof(double*) + n_tstorage * sizeof(double));
+    }
+
+    // Hanging node information
+    if (Hanging_pt != 0)
+    {
+      const unsigned n_hang = nvalue() + 1;
+      nbyte += double(n_hang) * sizeof(HangInfo*);
+      for (unsigned i = 0; i < n_hang; i++)
+      {
+        if ((Hanging_pt[i] != 0) &&
+            ((i == 0) || (Hanging_pt[i] != Hanging_pt[0])))
+        {
+          nbyte += sizeof(HangInfo) + double(Hanging_pt[i]->nmaster()) *
+                                        (sizeof(Node*) + sizeof(double));
+        }
+      }
+    }
+    return nbyte;
+  }
+
+
   //================================================================
   /// Assign (global) equation number. Overloaded version for nodes.
   /// Checks if a hanging value has a non-negative equation number
@@ -881,6 +926,23 @@ namespace oomph
     return Time_stepper_pt->ntstorage();
   }
 
+  //================================================================
+  /// Number of bytes held by the object: the object itself, the
+  /// pointers to its copies and, unless the values are copies of those
+  /// stored in another Data object, the values (with their history
+  /// values), the pointers to them and the equation numbers.
+  //================================================================
+  double Data::memory_usage_in_bytes() const
+  {
+    double nbyte = sizeof(Data) + double(Ncopies) * sizeof(Data*);
+    if ((Value != 0) && (!is_a_copy()))
+    {
+      nbyte += double(Nvalue) * (sizeof(double*) + sizeof(long) +
+                                 ntstorage() * sizeof(double));
+    }
+    return nbyte;
+  }
+
   //================================================================
   /// Assign (global) equation number.
   /// This function does NOT initialise the value because
@@ -2754,6 +2816,101 @@ namespace oomph
   }
 
 
+  //========================================================================
+  /// Return the set of all Data that affect the node update, i.e.
+  /// the geometric Data and the Data that the geometric objects depend on
+  //========================================================================
+  void Node::assemble_set_of_all_geometric_data(std::set<Data*>& geom_data_pt)
+  {
+    // First clear the set (just in case)
+    geom_data_pt.clear();
+
+    const unsigned n_geom_data = ngeom_data();
+    if (n_geom_data > 0)
+    {
+      Data** node_geom_data_pt = all_geom_data_pt();
+      for (unsigned i = 0; i < n_geom_data; i++)
+      {
+        geom_data_pt.insert(node_geom_data_pt[i]);
+      }
+    }
+    const unsigned n_geom_obj = ngeom_object();
+    if (n_geom_obj > 0)
+    {
+      GeomObject** geom_object_pt = all_geom_object_pt();
+      for (unsigned i = 0; i < n_geom_obj; i++)
+      {
+        unsigned n_obj_data = geom_object_pt[i]->ngeom_data();
+        for (unsigned j = 0; j < n_obj_data; j++)
+        {
+          geom_data_pt.insert(geom_object_pt[i]->geom_data_pt(j));
+        }
+      }
+    }
+  }
+
+
+  //========================================================================
+  /// Compute the derivatives of the (current) nodal position w.r.t.
+  /// the values of all Data that affect the node update by finite
+  /// differences: dposition_dgeom_data[data_pt](i,k) = dx_i / d (k-th
+  /// value of data_pt). Only this node is updated.
+  //========================================================================
+  void Node::get_dposition_dgeom_data(
+    std::map<Data*, DenseMatrix<double>>& dposition_dgeom_data)
+  {
+    dposition_dgeom_data.clear();
+
+    // Collect the Data that affect the node update
+    std::set<Data*> geom_data_pt;
+    assemble_set_of_all_geometric_data(geom_data_pt);
+
+    // Nothing to be done?
+    if (geom_data_pt.empty()) return;
+
+    // Backup the current position
+    const unsigned n_dim = this->ndim();
+    Vector<double> x_old(n_dim);
+    for (unsigned i = 0; i < n_dim; i++)
+    {
+      x_old[i] = x(i);
+    }
+
+    // Use the default finite difference step
+    const double fd_step = GeneralisedElement::Default_fd_jacobian_step;
+
+    // Loop over the Data and their values
+    for (std::set<Data*>::iterator it = geom_data_pt.begin();
+         it != geom_data_pt.end();
+         it++)
+    {
+      Data* data_pt = *it;
+      const unsigned n_value = data_pt->nvalue();
+      DenseMatrix<double>& dx_ddata = dposition_dgeom_data[data_pt];
+      dx_ddata.resize(n_dim, n_value, 0.0);
+      for (unsigned k = 0; k < n_value; k++)
+      {
+        // Perturb the value and update the node
+        double* value_pt = data_pt->value_pt(k);
+        double old_var = *value_pt;
+        *value_pt += fd_step;
+        node_update();
+
+        for (unsigned i = 0; i < n_dim; i++)
+        {
+          dx_ddata(i, k) = (x(i) - x_old[i]) / fd_step;
+        }
+
+        // Reset the value
+        *value_pt = old_var;
+      }
+    }
+
+    // Node update one final time to get back to the original state
+    node_update();
+  }
+
+
   //========================================================================
   /// Output nodal coordinates
   //========================================================================
@@ -3646,6 +3803,21 @@ namespace oomph
     return posn;
   }
 
+  //================================================================
+  /// Number of bytes held by the SolidNode. The positions are stored
+  /// as the values of the Data object that represents them; these are
+  /// included in Node::memory_usage_in_bytes(), so only that object and
+  /// its equation numbers need to be added, together with the Lagrangian
+  /// coordinates.
+  //================================================================
+  double SolidNode::memory_usage_in_bytes() const
+  {
+    return Node::memory_usage_in_bytes() + sizeof(SolidNode) -
+           sizeof(Node) + sizeof(Data) +
+           double(Variable_position_pt->nvalue()) * sizeof(long) +
+           double(Nlagrangian * Nlagrangian_type) * sizeof(double);
+  }
+
   //================================================================
   /// Assign (global) equation number, for SolidNodes
   //================================================================
@@ -494,6 +494,11 @@ namespace oomph
     virtual void assign_eqn_numbers(unsigned long& global_ndof,
                                     Vector<double*>& dof_pt);
 
+    /// Number of bytes held by the object, including the values
+    /// (with their history values) and equation numbers, unless
+    /// these are copies of those stored in another Data object.
+    virtual double memory_usage_in_bytes() const;
+
     /// Function to describe the dofs of the Node. The ostream
     /// specifies the output stream to which the description
     /// is written; the string stores the currently
@@ -1051,6 +1056,10 @@ namespace oomph
     virtual void assign_eqn_numbers(unsigned long& global_ndof,
                                     Vector<double*>& dof_pt);
 
+    /// Number of bytes held by the node: the values, the positions
+    /// (with their history values) and the hanging node information
+    virtual double memory_usage_in_bytes() const;
+
     /// Return (Eulerian) spatial dimension of the node.
     unsigned ndim() const
     {
@@ -1650,6 +1659,20 @@ namespace oomph
       return 0;
     }
 
+    /// Return the set of all Data that affect the node update, i.e.
+    /// the geometric Data and the Data that the geometric objects depend on
+    void assemble_set_of_all_geometric_data(std::set<Data*>& geom_data_pt);
+
+    /// Compute the derivatives of the (current) nodal position w.r.t.
+    /// the values of all Data that affect the node update, i.e. the
+    /// geometric Data and the Data that the geometric objects depend on:
+    /// dposition_dgeom_data[data_pt](i,k) = dx_i / d (k-th value of
+    /// data_pt). The default implementation uses finite differences and
+    /// only updates this node; it can be overloaded to provide analytic
+    /// sensitivities for specific node update strategies.
+    virtual void get_dposition_dgeom_data(
+      std::map<Data*, DenseMatrix<double>>& dposition_dgeom_data);
+
     /// Output nodal position
     void output(std::ostream& outfile);
 
@@ -1787,6 +1810,10 @@ namespace oomph
       return Variable_position_pt->is_a_copy();
     }
 
+    /// Number of bytes held by the node, including the Lagrangian
+    /// coordinates and the equation numbers of the positions
+    double memory_usage_in_bytes() const;
+
     /// Return whether the position coordinate i has been copied
     bool position_is_a_copy(const unsigned& i) const
     {
@@ -30,6 +30,7 @@
 #include <algorithm>
 #include <limits.h>
 #include <cstring>
+#include <chrono>
 
 #ifdef OOMPH_HAS_UNISTDH
 #include <unistd.h> // for getpid()
@@ -1306,6 +1307,15 @@ namespace oomph
         return double(t) / double(CLOCKS_PER_SEC);
       }
     }
+
+    /// Returns the wall-clock time in seconds after some point in past
+    double wall_clock_time()
+    {
+      return std::chrono::duration<double>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+    }
+
   } // end of namespace TimingHelpers
 
 
@@ -1648,7 +1658,165 @@ namespace oomph
     }
 
 
+    /// Peak resident set size ("high water mark") of this process in
+    /// kB, as reported in /proc/self/status. Linux specific; returns -1
+    /// if the information is not available.
+    double peak_resident_set_size_in_kb()
+    {
+      std::ifstream status_file("/proc/self/status");
+      std::string line;
+      while (std::getline(status_file, line))
+      {
+        // The line is of the form "VmHWM:    12345 kB"
+        if (line.compare(0, 6, "VmHWM:") == 0)
+        {
+          std::istringstream line_stream(line.substr(6));
+          double peak_rss = -1.0;
+          line_stream >> peak_rss;
+          return peak_rss;
+        }
+      }
+      return -1.0;
+    }
+
   } // end of namespace MemoryUsage
 
 
+  /// /////////////////////////////////////////////////////////////
+  /// /////////////////////////////////////////////////////////////
+  /// /////////////////////////////////////////////////////////////
+
+
+  //====================================================================
+  /// Namespace for the wall-clock times spent in named phases of a run
+  //====================================================================
+  namespace PhaseTimings
+  {
+    /// Record the phase timings? Default: false
+    bool Record_phase_timings = false;
+
+    /// Accumulated wall-clock times, indexed by the names of the phases
+    std::map<std::string, double> Phase_time;
+
+    /// Number of times the phases have been started
+    std::map<std::string, unsigned> Ncall;
+
+    /// Stack of the currently active (nested) phases
+    Vector<std::string> Active_phase;
+
+    /// Wall-clock time at which the currently active phase was last
+    /// (re-)started
+    double Start_time = 0.0;
+
+    /// Start (or restart) the timer for the given phase, halting that
+    /// of the currently active phase (if any)
+    void start(const std::string& phase)
+    {
+      if (!Record_phase_timings) return;
+
+      double t = TimingHelpers::wall_clock_time();
+      if (!Active_phase.empty())
+      {
+        Phase_time[Active_phase.back()] += t - Start_time;
+      }
+      Active_phase.push_back(phase);
+      Ncall[phase]++;
+      Start_time = t;
+    }
+
+    /// Halt the timer for the given phase, which must be the currently
+    /// active one, and resume that of the enclosing phase (if any).
+    /// Mismatches (e.g. after a reset() while a phase was active) are
+    /// only reported since this is called from PhaseTimer's destructor.
+    void halt(const std::string& phase)
+    {
+      if (!Record_phase_timings) return;
+
+      if (Active_phase.empty() || (Active_phase.back() != phase))
+      {
+        OomphLibWarning("Trying to halt the timer for phase \"" + phase +
+                          "\" which is not the currently active one.\n" +
+                          "Ignoring the request.",
+                        OOMPH_CURRENT_FUNCTION,
+                        OOMPH_EXCEPTION_LOCATION);
+        return;
+      }
+
+      double t = TimingHelpers::wall_clock_time();
+      Phase_time[phase] += t - Start_time;
+      Active_phase.pop_back();
+      Start_time = t;
+    }
+
+    /// Wall-clock time accumulated in the given phase
+    double phase_time(const std::string& phase)
+    {
+      std::map<std::string, double>::iterator it = Phase_time.find(phase);
+      if (it == Phase_time.end()) return 0.0;
+      return it->second;
+    }
+
+    /// Number of times the given phase has been started
+    unsigned ncall(const std::string& phase)
+    {
+      std::map<std::string, unsigned>::iterator it = Ncall.find(phase);
+      if (it == Ncall.end()) return 0;
+      return it->second;
+    }
+
+    /// Wipe all phase timings (and the stack of active phases)
+    void reset()
+    {
+      Phase_time.clear();
+      Ncall.clear();
+      Active_phase.clear();
+      Start_time = 0.0;
+    }
+
+    /// Doc the phase timings (one line per phase, containing the
+    /// phase, the accumulated time and the number of calls), followed
+    /// by the peak resident set size in kB (as "peak_rss_kb ...")
+    void doc(std::ostream& outfile)
+    {
+      outfile << "# phase wall_clock_time[sec] ncall" << std::endl;
+      for (std::map<std::string, double>::iterator it = Phase_time.begin();
+           it != Phase_time.end();
+           it++)
+      {
+        outfile << it->first << " " << it->second << " " << Ncall[it->first]
+                << std::endl;
+      }
+      outfile << "peak_rss_kb "
+              << MemoryUsage::peak_resident_set_size_in_kb() << std::endl;
+    }
+
+  } // namespace PhaseTimings
+
+
+  /// /////////////////////////////////////////////////////////////
+  /// /////////////////////////////////////////////////////////////
+  /// /////////////////////////////////////////////////////////////
+
+
+  //====================================================================
+  /// Doc the account: One line per category, containing the category,
+  /// the number of bytes and the number of MB, followed by the total.
+  /// Each line is preceded by prefix.
+  //====================================================================
+  void MemoryAccount::doc(std::ostream& outfile,
+                          const std::string& prefix) const
+  {
+    double mb = 1024.0 * 1024.0;
+    for (std::map<std::string, double>::const_iterator it = Nbyte.begin();
+         it != Nbyte.end();
+         it++)
+    {
+      outfile << prefix << it->first << " " << it->second << " "
+              << it->second / mb << std::endl;
+    }
+    double total = total_nbyte();
+    outfile << prefix << "total " << total << " " << total / mb << std::endl;
+  }
+
+
 } // namespace oomph
@@ -952,6 +952,10 @@ namespace oomph
     /// returns the time in seconds after some point in past
     double timer();
 
+    /// Returns the wall-clock time in seconds after some point in past
+    /// (unlike timer(), which returns the cpu time in serial runs)
+    double wall_clock_time();
+
   } // end of namespace TimingHelpers
 
 
@@ -1082,9 +1086,199 @@ namespace oomph
     /// Insert comment into running continuous top output
     void insert_comment_to_continous_top(const std::string& comment);
 
+    /// Peak resident set size ("high water mark") of this process in
+    /// kB, as reported in /proc/self/status. Linux specific; returns -1
+    /// if the information is not available.
+    double peak_resident_set_size_in_kb();
+
   } // end of namespace MemoryUsage
 
 
+  /// /////////////////////////////////////////////////////////////
+  /// /////////////////////////////////////////////////////////////
+  /// /////////////////////////////////////////////////////////////
+
+
+  //====================================================================
+  /// Namespace for the wall-clock times spent in named phases of a run
+  /// (e.g. "assembly", "solve", "adapt" and "output"), used by the
+  /// performance benchmarks. Phases may be nested: the time spent in an
+  /// inner phase is not charged to the enclosing one, so the phase
+  /// times add up to (at most) the total run time. Problem charges
+  /// the assembly of residuals and Jacobians, the linear solves in
+  /// its Newton solver and the mesh adaptation to the phases "assembly",
+  /// "solve" and "adapt", respectively. Nothing is recorded unless
+  /// Record_phase_timings is set to true.
+  //====================================================================
+  namespace PhaseTimings
+  {
+    /// Record the phase timings? Default: false
+    extern bool Record_phase_timings;
+
+    /// Start (or restart) the timer for the given phase, halting that
+    /// of the currently active phase (if any)
+    extern void start(const std::string& phase);
+
+    /// Halt the timer for the given phase, which must be the currently
+    /// active one, and resume that of the enclosing phase (if any)
+    extern void halt(const std::string& phase);
+
+    /// Wall-clock time accumulated in the given phase
+    extern double phase_time(const std::string& phase);
+
+    /// Number of times the given phase has been started
+    extern unsigned ncall(const std::string& phase);
+
+    /// Wipe all phase timings (and the stack of active phases)
+    extern void reset();
+
+    /// Doc the phase timings (one line per phase, containing the
+    /// phase, the accumulated time and the number of calls), followed
+    /// by the peak resident set size in kB (as "peak_rss_kb ...")
+    extern void doc(std::ostream& outfile);
+
+    /// Accumulated wall-clock times, indexed by the names of the phases
+    extern std::map<std::string, double> Phase_time;
+
+    /// Number of times the phases have been started
+    extern std::map<std::string, unsigned> Ncall;
+
+    /// Stack of the currently active (nested) phases
+    extern Vector<std::string> Active_phase;
+
+    /// Wall-clock time at which the currently active phase was last
+    /// (re-)started
+    extern double Start_time;
+
+  } // namespace PhaseTimings
+
+
+  //====================================================================
+  /// Timer for a phase of the run (see PhaseTimings) that is started
+  /// on construction and halted when the object goes out of scope, so
+  /// the phases remain properly nested if an exception is thrown.
+  //====================================================================
+  class PhaseTimer
+  {
+  public:
+    /// Constructor: Pass the name of the phase (a string literal since
+    /// it is only converted to a string if the timings are recorded)
+    PhaseTimer(const char* phase)
+      : Phase(phase), Is_active(PhaseTimings::Record_phase_timings)
+    {
+      if (Is_active)
+      {
+        PhaseTimings::start(Phase);
+      }
+    }
+
+    /// Broken copy constructor
+    PhaseTimer(const PhaseTimer&) = delete;
+
+    /// Broken assignment operator
+    void operator=(const PhaseTimer&) = delete;
+
+    /// Destructor: Halt the timer for the phase
+    ~PhaseTimer()
+    {
+      if (Is_active)
+      {
+        PhaseTimings::halt(Phase);
+      }
+    }
+
+  private:
+    /// Name of the phase
+    const char* Phase;
+
+    /// Was the timer started when the object was created?
+    bool Is_active;
+  };
+
+
+  /// /////////////////////////////////////////////////////////////
+  /// /////////////////////////////////////////////////////////////
+  /// /////////////////////////////////////////////////////////////
+
+
+  //====================================================================
+  /// Account of the memory (in bytes) held by the main data
+  /// structures of a computation, broken down into named categories
+  /// (e.g. "nodes", "elements", "jacobian" or "lu_factors"). The
+  /// accounts are filled by the get_memory_usage(...) functions of
+  /// Mesh, Problem, CRDoubleMatrix, LinearSolver and Preconditioner.
+  /// Only the storage whose size scales with the problem size is
+  /// counted, so the totals are (fairly tight) lower bounds.
+  //====================================================================
+  class MemoryAccount
+  {
+  public:
+    /// Constructor: Empty account
+    MemoryAccount() {}
+
+    /// Add nbyte bytes to the given category
+    void add(const std::string& category, const double& nbyte)
+    {
+      Nbyte[category] += nbyte;
+    }
+
+    /// Add all entries of another account, optionally prefixing
+    /// their categories by prefix (e.g. "preconditioner:")
+    void add(const MemoryAccount& account, const std::string& prefix = "")
+    {
+      for (std::map<std::string, double>::const_iterator it =
+             account.Nbyte.begin();
+           it != account.Nbyte.end();
+           it++)
+      {
+        Nbyte[prefix + it->first] += it->second;
+      }
+    }
+
+    /// Number of bytes in the given category (zero if there is none)
+    double nbyte(const std::string& category) const
+    {
+      std::map<std::string, double>::const_iterator it = Nbyte.find(category);
+      if (it == Nbyte.end()) return 0.0;
+      return it->second;
+    }
+
+    /// Total number of bytes in all categories
+    double total_nbyte() const
+    {
+      double total = 0.0;
+      for (std::map<std::string, double>::const_iterator it = Nbyte.begin();
+           it != Nbyte.end();
+           it++)
+      {
+        total += it->second;
+      }
+      return total;
+    }
+
+    /// The number of bytes, indexed by the categories
+    const std::map<std::string, double>& nbyte_by_category() const
+    {
+      return Nbyte;
+    }
+
+    /// Wipe all entries
+    void clear()
+    {
+      Nbyte.clear();
+    }
+
+    /// Doc the account: One line per category, containing the
+    /// category, the number of bytes and the number of MB, followed by
+    /// the total (as "total ..."). Each line is preceded by prefix.
+    void doc(std::ostream& outfile, const std::string& prefix = "") const;
+
+  private:
+    /// Number of bytes, indexed by the categories
+    std::map<std::string, double> Nbyte;
+  };
+
+
   /// /////////////////////////////////////////////////////////////
   /// /////////////////////////////////////////////////////////////
   /// /////////////////////////////////////////////////////////////
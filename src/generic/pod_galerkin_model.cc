@@ -0,0 +1,1005 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+#include <algorithm>
+
+#include "pod_galerkin_model.h"
+#include "problem.h"
+#include "mesh.h"
+#include "elements.h"
+#include "assembly_handler.h"
+#include "timesteppers.h"
+
+namespace oomph
+{
+  //=======================================================================
+  /// Constructor: Pass the problem
+  //=======================================================================
+  PODGalerkinModel::PODGalerkinModel(Problem* problem_pt)
+    : Problem_pt(problem_pt),
+      Energy_tolerance(1.0e-8),
+      Max_nmode(100),
+      Ntraining_point(0),
+      Hyper_reduction_tolerance(1.0e-4),
+      Newton_solver_tolerance(1.0e-8),
+      Max_newton_iterations(10),
+      Nnewton_iter_taken(0),
+      Use_full_model_fallback(false),
+      Error_indicator_tolerance(0.0),
+      Error_indicator(-1.0),
+      Full_model_was_used(false),
+      Nfull_model_fallback(0),
+      Doc_time(false)
+  {
+#ifdef OOMPH_HAS_MPI
+    if (problem_pt->communicator_pt()->nproc() > 1)
+    {
+      std::ostringstream error_stream;
+      error_stream << "PODGalerkinModel has not been implemented for "
+                   << "problems on more than one processor yet.\n";
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+  }
+
+  //=======================================================================
+  /// Store the problem's current dofs as a snapshot
+  //=======================================================================
+  void PODGalerkinModel::add_snapshot()
+  {
+    unsigned long n_dof = Problem_pt->ndof();
+#ifdef PARANOID
+    if ((Snapshot.size() > 0) && (Snapshot[0].size() != n_dof))
+    {
+      std::ostringstream error_stream;
+      error_stream << "The problem has " << n_dof << " dofs but the previous "
+                   << "snapshots have " << Snapshot[0].size() << ".\n";
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+    DoubleVector dofs;
+    Problem_pt->get_dofs(dofs);
+    Snapshot.push_back(Vector<double>(n_dof));
+    Vector<double>& snapshot = Snapshot.back();
+    for (unsigned long i = 0; i < n_dof; i++)
+    {
+      snapshot[i] = dofs[i];
+    }
+  }
+
+  //=======================================================================
+  /// Assign the dofs of the i-th snapshot to the problem
+  //=======================================================================
+  void PODGalerkinModel::assign_snapshot(const unsigned& i)
+  {
+#ifdef PARANOID
+    if (i >= Snapshot.size())
+    {
+      std::ostringstream error_stream;
+      error_stream << "Snapshot " << i << " does not exist; there are only "
+                   << Snapshot.size() << " snapshots.\n";
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+    unsigned long n_dof = Snapshot[i].size();
+    for (unsigned long j = 0; j < n_dof; j++)
+    {
+      Problem_pt->dof(j) = Snapshot[i][j];
+    }
+  }
+
+  //=======================================================================
+  /// Compute the POD basis by the method of snapshots: The eigenvectors
+  /// of the correlation matrix C_ij = (u_i - u_mean).(u_j - u_mean) of
+  /// the snapshots' deviations from their mean, weighted by the inverse
+  /// square roots of the eigenvalues, provide the coefficients of the
+  /// (orthonormal) modes in terms of the deviations.
+  //=======================================================================
+  void PODGalerkinModel::build_basis()
+  {
+    double t_start = TimingHelpers::timer();
+
+    unsigned n_snapshot = Snapshot.size();
+    if (n_snapshot == 0)
+    {
+      std::ostringstream error_stream;
+      error_stream << "Can't build the POD basis without any snapshots.\n";
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+    unsigned long n_dof = Snapshot[0].size();
+
+    // Mean of the snapshots
+    Mean_dofs.assign(n_dof, 0.0);
+    for (unsigned j = 0; j < n_snapshot; j++)
+    {
+      for (unsigned long i = 0; i < n_dof; i++)
+      {
+        Mean_dofs[i] += Snapshot[j][i];
+      }
+    }
+    for (unsigned long i = 0; i < n_dof; i++)
+    {
+      Mean_dofs[i] /= double(n_snapshot);
+    }
+
+    // Deviations from the mean
+    Vector<Vector<double>> deviation(n_snapshot, Vector<double>(n_dof));
+    for (unsigned j = 0; j < n_snapshot; j++)
+    {
+      for (unsigned long i = 0; i < n_dof; i++)
+      {
+        deviation[j][i] = Snapshot[j][i] - Mean_dofs[i];
+      }
+    }
+
+    // Correlation matrix
+    DenseMatrix<double> correlation(n_snapshot, n_snapshot, 0.0);
+    for (unsigned j = 0; j < n_snapshot; j++)
+    {
+      for (unsigned k = 0; k <= j; k++)
+      {
+        double sum = 0.0;
+        for (unsigned long i = 0; i < n_dof; i++)
+        {
+          sum += deviation[j][i] * deviation[k][i];
+        }
+        correlation(j, k) = sum;
+        correlation(k, j) = sum;
+      }
+    }
+    Vector<double> eigenvalue;
+    DenseMatrix<double> eigenvector;
+    symmetric_eigen_decomposition(correlation, eigenvalue, eigenvector);
+
+    // Sort the eigenvalues into decreasing order
+    Vector<unsigned> order(n_snapshot);
+    for (unsigned j = 0; j < n_snapshot; j++)
+    {
+      order[j] = j;
+    }
+    for (unsigned j = 0; j < n_snapshot; j++)
+    {
+      unsigned j_max = j;
+      for (unsigned k = j + 1; k < n_snapshot; k++)
+      {
+        if (eigenvalue[order[k]] > eigenvalue[order[j_max]])
+        {
+          j_max = k;
+        }
+      }
+      std::swap(order[j], order[j_max]);
+    }
+    Pod_eigenvalue.resize(n_snapshot);
+    double total_energy = 0.0;
+    for (unsigned j = 0; j < n_snapshot; j++)
+    {
+      Pod_eigenvalue[j] = std::max(eigenvalue[order[j]], 0.0);
+      total_energy += Pod_eigenvalue[j];
+    }
+
+    // Number of modes required to capture the energy (ignoring modes
+    // that are only due to round-off)
+    unsigned n_mode = 0;
+    double discarded_energy = total_energy;
+    unsigned max_nmode = std::min(Max_nmode, n_snapshot);
+    while ((n_mode < max_nmode) &&
+           (discarded_energy > Energy_tolerance * total_energy) &&
+           (Pod_eigenvalue[n_mode] > 1.0e-14 * total_energy))
+    {
+      discarded_energy -= Pod_eigenvalue[n_mode];
+      n_mode++;
+    }
+
+    // Assemble the modes
+    Basis.resize(n_dof, n_mode, 0.0);
+    Basis.initialise(0.0);
+    for (unsigned k = 0; k < n_mode; k++)
+    {
+      double factor = 1.0 / sqrt(Pod_eigenvalue[k]);
+      for (unsigned j = 0; j < n_snapshot; j++)
+      {
+        double coefficient = factor * eigenvector(order[k], j);
+        for (unsigned long i = 0; i < n_dof; i++)
+        {
+          Basis(i, k) += coefficient * deviation[j][i];
+        }
+      }
+    }
+
+    // Re-orthonormalise the modes (modified Gram-Schmidt) to remove the
+    // effects of round-off
+    for (unsigned k = 0; k < n_mode; k++)
+    {
+      for (unsigned l = 0; l < k; l++)
+      {
+        double dot = 0.0;
+        for (unsigned long i = 0; i < n_dof; i++)
+        {
+          dot += Basis(i, k) * Basis(i, l);
+        }
+        for (unsigned long i = 0; i < n_dof; i++)
+        {
+          Basis(i, k) -= dot * Basis(i, l);
+        }
+      }
+      double norm = 0.0;
+      for (unsigned long i = 0; i < n_dof; i++)
+      {
+        norm += Basis(i, k) * Basis(i, k);
+      }
+      norm = sqrt(norm);
+      for (unsigned long i = 0; i < n_dof; i++)
+      {
+        Basis(i, k) /= norm;
+      }
+    }
+
+    // The hyper-reduction refers to the old basis
+    clear_hyper_reduction();
+
+    if (Doc_time)
+    {
+      oomph_info << "Time to build POD basis with " << n_mode << " modes from "
+                 << n_snapshot << " snapshots [sec]: "
+                 << TimingHelpers::timer() - t_start << std::endl
+                 << "Fraction of the snapshots' energy discarded: "
+                 << ((total_energy > 0.0) ? discarded_energy / total_energy :
+                                            0.0)
+                 << std::endl;
+    }
+  }
+
+  //=======================================================================
+  /// Compute the eigenvalues and eigenvectors of the symmetric matrix a
+  /// (which is overwritten) by the cyclic Jacobi method:
+  /// eigenvector(i,j) is the j-th entry of the i-th eigenvector. (The
+  /// correlation matrix only has as many rows as there are snapshots, so
+  /// the cost is negligible compared to that of its assembly.)
+  //=======================================================================
+  void PODGalerkinModel::symmetric_eigen_decomposition(
+    DenseMatrix<double>& a,
+    Vector<double>& eigenvalue,
+    DenseMatrix<double>& eigenvector) const
+  {
+    unsigned n = a.nrow();
+
+    // Accumulate the rotations in v, whose columns are the eigenvectors
+    DenseMatrix<double> v(n, n, 0.0);
+    for (unsigned i = 0; i < n; i++)
+    {
+      v(i, i) = 1.0;
+    }
+
+    unsigned max_sweep = 100;
+    for (unsigned sweep = 0; sweep < max_sweep; sweep++)
+    {
+      // Compare the off-diagonal to the diagonal entries
+      double off_diagonal = 0.0;
+      double diagonal = 0.0;
+      for (unsigned i = 0; i < n; i++)
+      {
+        diagonal += a(i, i) * a(i, i);
+        for (unsigned j = i + 1; j < n; j++)
+        {
+          off_diagonal += a(i, j) * a(i, j);
+        }
+      }
+      if (off_diagonal <= 1.0e-30 * diagonal)
+      {
+        break;
+      }
+
+      // Annihilate each off-diagonal entry in turn
+      for (unsigned p = 0; p < n; p++)
+      {
+        for (unsigned q = p + 1; q < n; q++)
+        {
+          if (a(p, q) == 0.0)
+          {
+            continue;
+          }
+          double theta = 0.5 * (a(q, q) - a(p, p)) / a(p, q);
+          double t = 1.0 / (std::fabs(theta) + sqrt(theta * theta + 1.0));
+          if (theta < 0.0)
+          {
+            t = -t;
+          }
+          double c = 1.0 / sqrt(t * t + 1.0);
+          double s = t * c;
+          for (unsigned k = 0; k < n; k++)
+          {
+            double a_kp = a(k, p);
+            double a_kq = a(k, q);
+            a(k, p) = c * a_kp - s * a_kq;
+            a(k, q) = s * a_kp + c * a_kq;
+          }
+          for (unsigned k = 0; k < n; k++)
+          {
+            double a_pk = a(p, k);
+            double a_qk = a(q, k);
+            a(p, k) = c * a_pk - s * a_qk;
+            a(q, k) = s * a_pk + c * a_qk;
+          }
+          for (unsigned k = 0; k < n; k++)
+          {
+            double v_kp = v(k, p);
+            double v_kq = v(k, q);
+            v(k, p) = c * v_kp - s * v_kq;
+            v(k, q) = s * v_kp + c * v_kq;
+          }
+        }
+      }
+    }
+
+    eigenvalue.resize(n);
+    eigenvector.resize(n, n);
+    for (unsigned i = 0; i < n; i++)
+    {
+      eigenvalue[i] = a(i, i);
+      for (unsigned j = 0; j < n; j++)
+      {
+        eigenvector(i, j) = v(j, i);
+      }
+    }
+  }
+
+  //=======================================================================
+  /// Compute the reduced coordinates of the problem's current dofs,
+  /// q = V^T (u - u_mean)
+  //=======================================================================
+  void PODGalerkinModel::get_reduced_coordinates(Vector<double>& q) const
+  {
+    unsigned long n_dof = Basis.nrow();
+    unsigned n_mode = Basis.ncol();
+    q.assign(n_mode, 0.0);
+    for (unsigned long i = 0; i < n_dof; i++)
+    {
+      double deviation = Problem_pt->dof(i) - Mean_dofs[i];
+      for (unsigned k = 0; k < n_mode; k++)
+      {
+        q[k] += Basis(i, k) * deviation;
+      }
+    }
+  }
+
+  //=======================================================================
+  /// Assign the dofs u = u_mean + V q to the problem
+  //=======================================================================
+  void PODGalerkinModel::set_dofs_from_reduced_coordinates(
+    const Vector<double>& q)
+  {
+    unsigned long n_dof = Mean_dofs.size();
+    unsigned n_mode = Basis.ncol();
+    for (unsigned long i = 0; i < n_dof; i++)
+    {
+      double value = Mean_dofs[i];
+      for (unsigned k = 0; k < n_mode; k++)
+      {
+        value += Basis(i, k) * q[k];
+      }
+      Problem_pt->dof(i) = value;
+    }
+  }
+
+  //=======================================================================
+  /// Assign u = u_mean + V q to the dofs of the sampled elements only
+  /// (to all dofs if hyper-reduction is not used)
+  //=======================================================================
+  void PODGalerkinModel::set_sampled_dofs_from_reduced_coordinates(
+    const Vector<double>& q)
+  {
+    if (Sampled_element_pt.size() == 0)
+    {
+      set_dofs_from_reduced_coordinates(q);
+      return;
+    }
+
+    unsigned n_mode = Basis.ncol();
+    unsigned long n_sampled_dof = Sampled_eqn_number.size();
+    for (unsigned long j = 0; j < n_sampled_dof; j++)
+    {
+      unsigned long i = Sampled_eqn_number[j];
+      double value = Mean_dofs[i];
+      for (unsigned k = 0; k < n_mode; k++)
+      {
+        value += Basis(i, k) * q[k];
+      }
+      Problem_pt->dof(i) = value;
+    }
+  }
+
+  //=======================================================================
+  /// Add the weighted contribution of the element to the reduced
+  /// residuals, V_e^T r_e, and the reduced Jacobian, V_e^T J_e V_e, where
+  /// V_e contains the rows of the basis for the element's dofs
+  //=======================================================================
+  void PODGalerkinModel::add_reduced_element_contribution(
+    GeneralisedElement* const& elem_pt,
+    const double& weight,
+    Vector<double>& reduced_residuals,
+    DenseMatrix<double>& reduced_jacobian)
+  {
+    AssemblyHandler* const assembly_handler_pt =
+      Problem_pt->assembly_handler_pt();
+    unsigned n_element_dof = assembly_handler_pt->ndof(elem_pt);
+    if (n_element_dof == 0)
+    {
+      return;
+    }
+
+    Vector<double> residuals(n_element_dof);
+    DenseMatrix<double> jacobian(n_element_dof, n_element_dof, 0.0);
+    assembly_handler_pt->get_jacobian(elem_pt, residuals, jacobian);
+
+    Vector<unsigned long> eqn_number(n_element_dof);
+    for (unsigned l = 0; l < n_element_dof; l++)
+    {
+      eqn_number[l] = assembly_handler_pt->eqn_number(elem_pt, l);
+    }
+
+    // J_e V_e
+    unsigned n_mode = Basis.ncol();
+    DenseMatrix<double> jacobian_times_basis(n_element_dof, n_mode, 0.0);
+    for (unsigned l = 0; l < n_element_dof; l++)
+    {
+      for (unsigned m = 0; m < n_element_dof; m++)
+      {
+        double jacobian_entry = jacobian(l, m);
+        if (jacobian_entry != 0.0)
+        {
+          for (unsigned k = 0; k < n_mode; k++)
+          {
+            jacobian_times_basis(l, k) +=
+              jacobian_entry * Basis(eqn_number[m], k);
+          }
+        }
+      }
+    }
+
+    // Project
+    for (unsigned l = 0; l < n_element_dof; l++)
+    {
+      for (unsigned k = 0; k < n_mode; k++)
+      {
+        double weighted_basis = weight * Basis(eqn_number[l], k);
+        reduced_residuals[k] += weighted_basis * residuals[l];
+        for (unsigned k2 = 0; k2 < n_mode; k2++)
+        {
+          reduced_jacobian(k, k2) +=
+            weighted_basis * jacobian_times_basis(l, k2);
+        }
+      }
+    }
+  }
+
+  //=======================================================================
+  /// Get the reduced residuals V^T r and the reduced Jacobian V^T J V at
+  /// the problem's current dofs, from the weighted sampled elements if
+  /// hyper-reduction has been set up, otherwise from all elements
+  //=======================================================================
+  void PODGalerkinModel::get_reduced_jacobian(
+    Vector<double>& reduced_residuals, DenseDoubleMatrix& reduced_jacobian)
+  {
+    unsigned n_mode = Basis.ncol();
+    reduced_residuals.assign(n_mode, 0.0);
+    reduced_jacobian.resize(n_mode, n_mode);
+    reduced_jacobian.initialise(0.0);
+
+    unsigned n_sampled_element = Sampled_element_pt.size();
+    if (n_sampled_element > 0)
+    {
+      for (unsigned e = 0; e < n_sampled_element; e++)
+      {
+        add_reduced_element_contribution(Sampled_element_pt[e],
+                                         Sampled_element_weight[e],
+                                         reduced_residuals,
+                                         reduced_jacobian);
+      }
+    }
+    else
+    {
+      Mesh* const mesh_pt = Problem_pt->mesh_pt();
+      unsigned n_element = mesh_pt->nelement();
+      for (unsigned e = 0; e < n_element; e++)
+      {
+        add_reduced_element_contribution(
+          mesh_pt->element_pt(e), 1.0, reduced_residuals, reduced_jacobian);
+      }
+    }
+  }
+
+  //=======================================================================
+  /// Add a training point for the hyper-reduction: For each element,
+  /// store its (unweighted) contributions to the reduced residuals and to
+  /// the reduced Jacobian times the reduced coordinates, evaluated at the
+  /// projection of the problem's current dofs onto the reduced space.
+  /// The data of each training point is scaled by the norm of its sum
+  /// over all elements so that all training points carry the same weight.
+  //=======================================================================
+  void PODGalerkinModel::add_hyper_reduction_training_point()
+  {
+    unsigned n_mode = Basis.ncol();
+    if (n_mode == 0)
+    {
+      std::ostringstream error_stream;
+      error_stream << "The POD basis must be built (and contain at least "
+                   << "one mode)\nbefore training the hyper-reduction.\n";
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+
+    // Back up the current dofs and replace them by their projection
+    unsigned long n_dof = Mean_dofs.size();
+    Vector<double> dofs_backup(n_dof);
+    for (unsigned long i = 0; i < n_dof; i++)
+    {
+      dofs_backup[i] = Problem_pt->dof(i);
+    }
+    Vector<double> q;
+    get_reduced_coordinates(q);
+    set_dofs_from_reduced_coordinates(q);
+
+    Mesh* const mesh_pt = Problem_pt->mesh_pt();
+    unsigned n_element = mesh_pt->nelement();
+    if (Training_data.size() == 0)
+    {
+      Training_data.resize(n_element);
+    }
+#ifdef PARANOID
+    if (Training_data.size() != n_element)
+    {
+      std::ostringstream error_stream;
+      error_stream << "The mesh has " << n_element << " elements but the "
+                   << "previous training points had " << Training_data.size()
+                   << ".\n";
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    // Contributions of the elements
+    unsigned n_entry = 2 * n_mode;
+    Vector<double> element_data(n_element * n_entry);
+    Vector<double> sum(n_entry, 0.0);
+    Vector<double> reduced_residuals(n_mode);
+    DenseMatrix<double> reduced_jacobian(n_mode, n_mode);
+    for (unsigned e = 0; e < n_element; e++)
+    {
+      reduced_residuals.initialise(0.0);
+      reduced_jacobian.initialise(0.0);
+      add_reduced_element_contribution(
+        mesh_pt->element_pt(e), 1.0, reduced_residuals, reduced_jacobian);
+      for (unsigned k = 0; k < n_mode; k++)
+      {
+        double jacobian_times_q = 0.0;
+        for (unsigned l = 0; l < n_mode; l++)
+        {
+          jacobian_times_q += reduced_jacobian(k, l) * q[l];
+        }
+        element_data[e * n_entry + k] = reduced_residuals[k];
+        element_data[e * n_entry + n_mode + k] = jacobian_times_q;
+        sum[k] += reduced_residuals[k];
+        sum[n_mode + k] += jacobian_times_q;
+      }
+    }
+
+    // Scale and store
+    double norm = 0.0;
+    for (unsigned k = 0; k < n_entry; k++)
+    {
+      norm += sum[k] * sum[k];
+    }
+    norm = sqrt(norm);
+    double scaling = (norm > 0.0) ? 1.0 / norm : 1.0;
+    for (unsigned e = 0; e < n_element; e++)
+    {
+      for (unsigned k = 0; k < n_entry; k++)
+      {
+        Training_data[e].push_back(scaling * element_data[e * n_entry + k]);
+      }
+    }
+    Ntraining_point++;
+
+    // Restore the dofs
+    for (unsigned long i = 0; i < n_dof; i++)
+    {
+      Problem_pt->dof(i) = dofs_backup[i];
+    }
+  }
+
+  //=======================================================================
+  /// Choose the sampled elements and their weights by solving the
+  /// non-negative least-squares problem min |G w - b| subject to w >= 0
+  /// with the (Lawson-Hanson) active set method, where the e-th column
+  /// of G contains the training data for the e-th element and b is the
+  /// sum of the columns (so w = 1 is the exact solution). The iteration
+  /// is terminated as soon as |G w - b| < tol |b|, which typically leaves
+  /// only a small number of elements with non-zero weights.
+  //=======================================================================
+  void PODGalerkinModel::setup_hyper_reduction()
+  {
+    double t_start = TimingHelpers::timer();
+
+    if (Ntraining_point == 0)
+    {
+      std::ostringstream error_stream;
+      error_stream << "No training points have been specified for the "
+                   << "hyper-reduction.\n";
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+
+    unsigned n_element = Training_data.size();
+    unsigned n_row = Training_data[0].size();
+
+    // The target
+    Vector<double> target(n_row, 0.0);
+    for (unsigned e = 0; e < n_element; e++)
+    {
+      for (unsigned i = 0; i < n_row; i++)
+      {
+        target[i] += Training_data[e][i];
+      }
+    }
+    double target_norm = 0.0;
+    for (unsigned i = 0; i < n_row; i++)
+    {
+      target_norm += target[i] * target[i];
+    }
+    target_norm = sqrt(target_norm);
+
+    // Weights, the set of elements with positive weights ("passive set")
+    // and the elements that must not be added to it again
+    Vector<double> weight(n_element, 0.0);
+    Vector<unsigned> passive;
+    std::vector<bool> is_passive(n_element, false);
+    std::vector<bool> is_excluded(n_element, false);
+
+    Vector<double> residual(target);
+    double residual_norm = target_norm;
+    unsigned max_iter = 3 * n_element;
+    unsigned iter = 0;
+    while ((residual_norm > Hyper_reduction_tolerance * target_norm) &&
+           (iter < max_iter))
+    {
+      iter++;
+
+      // Add the element whose column is most strongly correlated with the
+      // residual
+      int e_max = -1;
+      double max_gradient = 0.0;
+      for (unsigned e = 0; e < n_element; e++)
+      {
+        if (is_passive[e] || is_excluded[e])
+        {
+          continue;
+        }
+        double gradient = 0.0;
+        for (unsigned i = 0; i < n_row; i++)
+        {
+          gradient += Training_data[e][i] * residual[i];
+        }
+        if (gradient > max_gradient)
+        {
+          max_gradient = gradient;
+          e_max = e;
+        }
+      }
+      if (e_max < 0)
+      {
+        break;
+      }
+      passive.push_back(e_max);
+      is_passive[e_max] = true;
+
+      // Solve the unconstrained least-squares problem for the passive
+      // set; step back if this makes any weights negative
+      unsigned n_inner = passive.size() + 1;
+      for (unsigned inner = 0; inner < n_inner; inner++)
+      {
+        unsigned n_passive = passive.size();
+        DenseDoubleMatrix normal_matrix(n_passive, n_passive, 0.0);
+        Vector<double> z(n_passive, 0.0);
+        for (unsigned j = 0; j < n_passive; j++)
+        {
+          const Vector<double>& column_j = Training_data[passive[j]];
+          for (unsigned k = 0; k <= j; k++)
+          {
+            const Vector<double>& column_k = Training_data[passive[k]];
+            double dot = 0.0;
+            for (unsigned i = 0; i < n_row; i++)
+            {
+              dot += column_j[i] * column_k[i];
+            }
+            normal_matrix(j, k) = dot;
+            normal_matrix(k, j) = dot;
+          }
+          for (unsigned i = 0; i < n_row; i++)
+          {
+            z[j] += column_j[i] * target[i];
+          }
+        }
+        normal_matrix.ludecompose();
+        normal_matrix.lubksub(z);
+
+        double alpha = 1.0;
+        for (unsigned j = 0; j < n_passive; j++)
+        {
+          if (z[j] <= 0.0)
+          {
+            double w = weight[passive[j]];
+            alpha = std::min(alpha, w / (w - z[j]));
+          }
+        }
+        for (unsigned j = 0; j < n_passive; j++)
+        {
+          weight[passive[j]] += alpha * (z[j] - weight[passive[j]]);
+        }
+        if (alpha == 1.0)
+        {
+          break;
+        }
+
+        // Remove the elements whose weights have dropped to zero
+        Vector<unsigned> new_passive;
+        for (unsigned j = 0; j < n_passive; j++)
+        {
+          unsigned e = passive[j];
+          if (weight[e] > 0.0)
+          {
+            new_passive.push_back(e);
+          }
+          else
+          {
+            weight[e] = 0.0;
+            is_passive[e] = false;
+            if (int(e) == e_max)
+            {
+              is_excluded[e] = true;
+            }
+          }
+        }
+        passive = new_passive;
+      }
+
+      // Update the residual
+      residual = target;
+      unsigned n_passive = passive.size();
+      for (unsigned j = 0; j < n_passive; j++)
+      {
+        const Vector<double>& column = Training_data[passive[j]];
+        double w = weight[passive[j]];
+        for (unsigned i = 0; i < n_row; i++)
+        {
+          residual[i] -= w * column[i];
+        }
+      }
+      residual_norm = 0.0;
+      for (unsigned i = 0; i < n_row; i++)
+      {
+        residual_norm += residual[i] * residual[i];
+      }
+      residual_norm = sqrt(residual_norm);
+    }
+
+    // Store the sampled elements and the equation numbers of their dofs
+    Sampled_element_pt.clear();
+    Sampled_element_weight.clear();
+    Sampled_eqn_number.clear();
+    Mesh* const mesh_pt = Problem_pt->mesh_pt();
+    AssemblyHandler* const assembly_handler_pt =
+      Problem_pt->assembly_handler_pt();
+    for (unsigned e = 0; e < n_element; e++)
+    {
+      if (weight[e] > 0.0)
+      {
+        GeneralisedElement* elem_pt = mesh_pt->element_pt(e);
+        Sampled_element_pt.push_back(elem_pt);
+        Sampled_element_weight.push_back(weight[e]);
+        unsigned n_element_dof = assembly_handler_pt->ndof(elem_pt);
+        for (unsigned l = 0; l < n_element_dof; l++)
+        {
+          Sampled_eqn_number.push_back(
+            assembly_handler_pt->eqn_number(elem_pt, l));
+        }
+      }
+    }
+    std::sort(Sampled_eqn_number.begin(), Sampled_eqn_number.end());
+    Sampled_eqn_number.erase(
+      std::unique(Sampled_eqn_number.begin(), Sampled_eqn_number.end()),
+      Sampled_eqn_number.end());
+
+    // Wipe the training data
+    Training_data.clear();
+    Ntraining_point = 0;
+
+    if (Doc_time)
+    {
+      oomph_info << "Time to set up hyper-reduction [sec]: "
+                 << TimingHelpers::timer() - t_start << std::endl
+                 << "Number of sampled elements: " << Sampled_element_pt.size()
+                 << " (of " << n_element << "); relative error in the "
+                 << "training data: "
+                 << ((target_norm > 0.0) ? residual_norm / target_norm : 0.0)
+                 << std::endl;
+    }
+  }
+
+  //=======================================================================
+  /// Wipe the hyper-reduction and its training data
+  //=======================================================================
+  void PODGalerkinModel::clear_hyper_reduction()
+  {
+    Training_data.clear();
+    Ntraining_point = 0;
+    Sampled_element_pt.clear();
+    Sampled_element_weight.clear();
+    Sampled_eqn_number.clear();
+  }
+
+  //=======================================================================
+  /// Solve the reduced equations by Newton's method, starting from the
+  /// projection of the problem's current dofs. The Problem's
+  /// actions_before/after_newton_... functions are called as in
+  /// Problem::newton_solve(). If the fallback to the full model is
+  /// enabled, the maximum residual of the full model is evaluated at the
+  /// reduced solution; if it exceeds the tolerance (or if the reduced
+  /// Newton iteration has not converged), the problem is solved with
+  /// Problem::newton_solve().
+  //=======================================================================
+  void PODGalerkinModel::newton_solve()
+  {
+    double t_start = TimingHelpers::timer();
+
+#ifdef PARANOID
+    if (Mean_dofs.size() != Problem_pt->ndof())
+    {
+      std::ostringstream error_stream;
+      error_stream << "The POD basis has not been built, or the number of "
+                   << "dofs has changed\nsince it was built.\n";
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    Full_model_was_used = false;
+    Error_indicator = -1.0;
+
+    Problem_pt->actions_before_newton_solve();
+
+    Vector<double> q;
+    get_reduced_coordinates(q);
+
+    unsigned n_mode = Basis.ncol();
+    Vector<double> reduced_residuals;
+    double max_res = 0.0;
+    bool converged = false;
+    Nnewton_iter_taken = 0;
+    while (true)
+    {
+      set_sampled_dofs_from_reduced_coordinates(q);
+      Problem_pt->actions_before_newton_convergence_check();
+
+      DenseDoubleMatrix reduced_jacobian;
+      get_reduced_jacobian(reduced_residuals, reduced_jacobian);
+      max_res = 0.0;
+      for (unsigned k = 0; k < n_mode; k++)
+      {
+        max_res = std::max(max_res, std::fabs(reduced_residuals[k]));
+      }
+      if (max_res < Newton_solver_tolerance)
+      {
+        converged = true;
+        break;
+      }
+      if (Nnewton_iter_taken == Max_newton_iterations)
+      {
+        break;
+      }
+
+      Nnewton_iter_taken++;
+      Problem_pt->actions_before_newton_step();
+      reduced_jacobian.ludecompose();
+      reduced_jacobian.lubksub(reduced_residuals);
+      for (unsigned k = 0; k < n_mode; k++)
+      {
+        q[k] -= reduced_residuals[k];
+      }
+      Problem_pt->actions_after_newton_step();
+    }
+
+    // Assign the reduced solution to all dofs
+    set_dofs_from_reduced_coordinates(q);
+    Problem_pt->actions_after_newton_solve();
+
+    if (Doc_time)
+    {
+      oomph_info << "Time for reduced Newton solve ( nmode = " << n_mode
+                 << "; " << Nnewton_iter_taken << " iterations ) [sec]: "
+                 << TimingHelpers::timer() - t_start << std::endl;
+    }
+
+    if (Use_full_model_fallback)
+    {
+      DoubleVector residuals;
+      Problem_pt->get_residuals(residuals);
+      Error_indicator = residuals.max();
+      if ((!converged) || (Error_indicator > Error_indicator_tolerance))
+      {
+        if (Doc_time)
+        {
+          oomph_info << "Maximum residual of the full model at the reduced "
+                     << "solution: " << Error_indicator
+                     << "\nFalling back to the full model." << std::endl;
+        }
+        Problem_pt->newton_solve();
+        Full_model_was_used = true;
+        Nfull_model_fallback++;
+      }
+    }
+    else if (!converged)
+    {
+      throw NewtonSolverError(Nnewton_iter_taken, max_res);
+    }
+  }
+
+  //=======================================================================
+  /// Take a timestep of size dt with the reduced model: shift the time
+  /// values, advance the time and call the Problem's (and timesteppers')
+  /// actions before and after the timestep, as in
+  /// Problem::unsteady_newton_solve(dt)
+  //=======================================================================
+  void PODGalerkinModel::unsteady_newton_solve(const double& dt)
+  {
+    Problem_pt->shift_time_values();
+    Problem_pt->time_pt()->time() += dt;
+    Problem_pt->time_pt()->dt() = dt;
+
+    unsigned n_time_steppers = Problem_pt->ntime_stepper();
+    for (unsigned i = 0; i < n_time_steppers; i++)
+    {
+      Problem_pt->time_stepper_pt(i)->set_weights();
+    }
+    for (unsigned i = 0; i < n_time_steppers; i++)
+    {
+      Problem_pt->time_stepper_pt(i)->actions_before_timestep(Problem_pt);
+    }
+    Problem_pt->actions_before_implicit_timestep();
+
+    newton_solve();
+
+    for (unsigned i = 0; i < n_time_steppers; i++)
+    {
+      Problem_pt->time_stepper_pt(i)->actions_after_timestep(Problem_pt);
+    }
+    Problem_pt->actions_after_implicit_timestep();
+    Problem_pt->actions_after_implicit_timestep_and_error_estimation();
+  }
+
+} // namespace oomph
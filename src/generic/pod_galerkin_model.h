@@ -0,0 +1,357 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+#ifndef OOMPH_POD_GALERKIN_MODEL_HEADER
+#define OOMPH_POD_GALERKIN_MODEL_HEADER
+
+// Config header generated by autoconfig
+#ifdef HAVE_CONFIG_H
+#include <oomph-lib-config.h>
+#endif
+
+// oomph-lib headers
+#include "Vector.h"
+#include "matrices.h"
+#include "double_vector.h"
+
+namespace oomph
+{
+  // Forward declarations
+  class Problem;
+  class GeneralisedElement;
+
+
+  //====================================================================
+  /// Snapshot-based (POD-Galerkin) reduced-order model for a Problem
+  /// that has to be solved many times on the same mesh (e.g. in
+  /// parameter sweeps or optimisation loops):
+  /// - Offline: The dofs of (full) solutions are collected with
+  ///   add_snapshot(). build_basis() then computes a proper orthogonal
+  ///   decomposition (by the method of snapshots) of the snapshots'
+  ///   deviations from their mean, u_mean, and retains the modes
+  ///   V = [v_1, ..., v_m] required to capture all but a fraction
+  ///   energy_tolerance() of their energy.
+  /// - Online: newton_solve() and unsteady_newton_solve(...) seek
+  ///   u = u_mean + V q and solve the Galerkin-projected equations
+  ///   V^T r(u_mean + V q) = 0 by Newton's method for the m reduced
+  ///   coordinates q, using the reduced Jacobian V^T J V.
+  ///
+  /// By default, the reduced residuals and Jacobian are obtained from
+  /// the contributions of all elements. Hyper-reduction replaces these
+  /// by the weighted contributions of a (small) sample of the elements.
+  /// The sample and the (non-negative) weights are chosen by
+  /// setup_hyper_reduction() ("energy-conserving sampling and
+  /// weighting"). It solves a non-negative least-squares problem so that
+  /// the sample reproduces the reduced residuals and the reduced
+  /// Jacobian (applied to the reduced coordinates) at the training
+  /// points that have been specified with
+  /// add_hyper_reduction_training_point().
+  ///
+  /// After each online solve, the residuals of the full model can be
+  /// used as an error indicator: if they exceed the tolerance specified
+  /// in enable_full_model_fallback(...), or if the reduced Newton
+  /// iteration fails to converge, the solution is recomputed with the
+  /// Problem's own Newton solver (starting from the reduced solution).
+  ///
+  /// Only for (non-distributed) problems whose equation numbering does
+  /// not change after the snapshots have been taken.
+  //====================================================================
+  class PODGalerkinModel
+  {
+  public:
+    /// Constructor: Pass the problem
+    PODGalerkinModel(Problem* problem_pt);
+
+    /// Broken copy constructor
+    PODGalerkinModel(const PODGalerkinModel&) = delete;
+
+    /// Broken assignment operator
+    void operator=(const PODGalerkinModel&) = delete;
+
+    /// Destructor (empty)
+    ~PODGalerkinModel() {}
+
+    /// Store the problem's current dofs as a snapshot
+    void add_snapshot();
+
+    /// Number of snapshots
+    unsigned nsnapshot() const
+    {
+      return Snapshot.size();
+    }
+
+    /// Assign the dofs of the i-th snapshot to the problem
+    void assign_snapshot(const unsigned& i);
+
+    /// Wipe the snapshots (but not the basis)
+    void clear_snapshots()
+    {
+      Snapshot.clear();
+    }
+
+    /// Fraction of the snapshots' energy that may be discarded by
+    /// the truncation of the POD basis (defaults to 1.0e-8)
+    double& energy_tolerance()
+    {
+      return Energy_tolerance;
+    }
+
+    /// Maximum number of POD modes (defaults to 100)
+    unsigned& max_nmode()
+    {
+      return Max_nmode;
+    }
+
+    /// Compute the POD basis from the snapshots (also wipes any
+    /// hyper-reduction)
+    void build_basis();
+
+    /// Number of POD modes in the basis
+    unsigned nmode() const
+    {
+      return Basis.ncol();
+    }
+
+    /// Eigenvalues of the snapshots' correlation matrix (the squares of
+    /// their singular values), in decreasing order
+    const Vector<double>& pod_eigenvalue() const
+    {
+      return Pod_eigenvalue;
+    }
+
+    /// Compute the reduced coordinates of the problem's current dofs,
+    /// q = V^T (u - u_mean)
+    void get_reduced_coordinates(Vector<double>& q) const;
+
+    /// Assign the dofs u = u_mean + V q to the problem
+    void set_dofs_from_reduced_coordinates(const Vector<double>& q);
+
+    /// Add a training point for the hyper-reduction at the problem's
+    /// current state: the reduced residuals and Jacobian are evaluated
+    /// at the projection of the current dofs onto the reduced space.
+    /// The problem's parameters must be those for which the current
+    /// dofs were obtained, e.g. after assign_snapshot(...) or after
+    /// a full solve. Requires the basis to have been built.
+    void add_hyper_reduction_training_point();
+
+    /// Number of hyper-reduction training points
+    unsigned nhyper_reduction_training_point() const
+    {
+      return Ntraining_point;
+    }
+
+    /// Relative tolerance for the reproduction of the training data
+    /// by the sampled elements (defaults to 1.0e-4)
+    double& hyper_reduction_tolerance()
+    {
+      return Hyper_reduction_tolerance;
+    }
+
+    /// Choose the sampled elements and their weights from the
+    /// training data (which is then wiped)
+    void setup_hyper_reduction();
+
+    /// Wipe the hyper-reduction (and its training data): The reduced
+    /// equations are assembled from all elements
+    void clear_hyper_reduction();
+
+    /// Number of sampled elements (zero if hyper-reduction is not used)
+    unsigned nsampled_element() const
+    {
+      return Sampled_element_pt.size();
+    }
+
+    /// Get the reduced residuals V^T r and the reduced Jacobian
+    /// V^T J V at the problem's current dofs (from the sampled elements
+    /// if hyper-reduction has been set up)
+    void get_reduced_jacobian(Vector<double>& reduced_residuals,
+                              DenseDoubleMatrix& reduced_jacobian);
+
+    /// Solve the reduced equations by Newton's method, starting from
+    /// the projection of the problem's current dofs
+    void newton_solve();
+
+    /// Take a timestep of size dt with the reduced model (analogous
+    /// to Problem::unsteady_newton_solve(dt))
+    void unsteady_newton_solve(const double& dt);
+
+    /// Tolerance for the maximum reduced residual in the reduced Newton
+    /// iteration (defaults to 1.0e-8)
+    double& newton_solver_tolerance()
+    {
+      return Newton_solver_tolerance;
+    }
+
+    /// Maximum number of reduced Newton iterations (defaults to 10)
+    unsigned& max_newton_iterations()
+    {
+      return Max_newton_iterations;
+    }
+
+    /// Number of reduced Newton iterations taken in the most recent
+    /// online solve
+    unsigned nnewton_iter_taken() const
+    {
+      return Nnewton_iter_taken;
+    }
+
+    /// Fall back to the full model if the maximum residual of the full
+    /// model exceeds the specified tolerance after an online solve (or
+    /// if the reduced Newton iteration does not converge)
+    void enable_full_model_fallback(const double& tolerance)
+    {
+      Use_full_model_fallback = true;
+      Error_indicator_tolerance = tolerance;
+    }
+
+    /// Don't evaluate the error indicator; throw a NewtonSolverError
+    /// if the reduced Newton iteration does not converge (default)
+    void disable_full_model_fallback()
+    {
+      Use_full_model_fallback = false;
+    }
+
+    /// Maximum residual of the full model after the most recent online
+    /// solve (negative if it has not been evaluated)
+    double error_indicator() const
+    {
+      return Error_indicator;
+    }
+
+    /// Has the most recent online solve fallen back to the full model?
+    bool full_model_was_used() const
+    {
+      return Full_model_was_used;
+    }
+
+    /// Number of online solves that have fallen back to the full model
+    unsigned nfull_model_fallback() const
+    {
+      return Nfull_model_fallback;
+    }
+
+    /// Enable documentation of the timings
+    void enable_doc_time()
+    {
+      Doc_time = true;
+    }
+
+    /// Disable documentation of the timings (default)
+    void disable_doc_time()
+    {
+      Doc_time = false;
+    }
+
+  private:
+    /// Add the weighted contribution of the element to the reduced
+    /// residuals and the reduced Jacobian
+    void add_reduced_element_contribution(
+      GeneralisedElement* const& elem_pt,
+      const double& weight,
+      Vector<double>& reduced_residuals,
+      DenseMatrix<double>& reduced_jacobian);
+
+    /// Assign u = u_mean + V q to the dofs of the sampled elements only
+    /// (to all dofs if hyper-reduction is not used)
+    void set_sampled_dofs_from_reduced_coordinates(const Vector<double>& q);
+
+    /// Compute the eigenvalues and eigenvectors of the symmetric matrix
+    /// a (which is overwritten) by the cyclic Jacobi method:
+    /// eigenvector(i,j) is the j-th entry of the i-th eigenvector
+    void symmetric_eigen_decomposition(DenseMatrix<double>& a,
+                                       Vector<double>& eigenvalue,
+                                       DenseMatrix<double>& eigenvector) const;
+
+    /// Pointer to the problem
+    Problem* Problem_pt;
+
+    /// The snapshots
+    Vector<Vector<double>> Snapshot;
+
+    /// Mean of the snapshots
+    Vector<double> Mean_dofs;
+
+    /// The POD basis: Basis(i,k) is the i-th entry of the k-th mode
+    DenseMatrix<double> Basis;
+
+    /// Eigenvalues of the snapshots' correlation matrix
+    Vector<double> Pod_eigenvalue;
+
+    /// Fraction of the snapshots' energy that may be discarded
+    double Energy_tolerance;
+
+    /// Maximum number of POD modes
+    unsigned Max_nmode;
+
+    /// Training data for the hyper-reduction: the entries for the e-th
+    /// element of the mesh
+    Vector<Vector<double>> Training_data;
+
+    /// Number of hyper-reduction training points
+    unsigned Ntraining_point;
+
+    /// Relative tolerance for the reproduction of the training data
+    double Hyper_reduction_tolerance;
+
+    /// Pointers to the sampled elements
+    Vector<GeneralisedElement*> Sampled_element_pt;
+
+    /// Weights of the sampled elements
+    Vector<double> Sampled_element_weight;
+
+    /// Equation numbers of the dofs of the sampled elements
+    Vector<unsigned long> Sampled_eqn_number;
+
+    /// Tolerance for the maximum reduced residual
+    double Newton_solver_tolerance;
+
+    /// Maximum number of reduced Newton iterations
+    unsigned Max_newton_iterations;
+
+    /// Number of reduced Newton iterations taken in the most recent solve
+    unsigned Nnewton_iter_taken;
+
+    /// Fall back to the full model?
+    bool Use_full_model_fallback;
+
+    /// Tolerance for the error indicator
+    double Error_indicator_tolerance;
+
+    /// Error indicator after the most recent online solve
+    double Error_indicator;
+
+    /// Has the most recent online solve fallen back to the full model?
+    bool Full_model_was_used;
+
+    /// Number of online solves that have fallen back to the full model
+    unsigned Nfull_model_fallback;
+
+    /// Document the timings?
+    bool Doc_time;
+  };
+
+} // namespace oomph
+
+#endif
@@ -146,6 +146,11 @@ namespace oomph
     /// Clean up memory (empty). Generic interface function.
     virtual void clean_up_memory() {}
 
+    /// Add the memory held by the preconditioner (e.g. its factors
+    /// or copies of matrix blocks) to the account, broken down into
+    /// categories. Empty by default.
+    virtual void get_memory_usage(MemoryAccount& account) {}
+
     /// Get function for matrix pointer.
     virtual DoubleMatrixBase* matrix_pt() const
     {
@@ -29,14 +29,23 @@
 #include <oomph-lib-config.h>
 #endif
 
-// Preconditioner array is only useful if we have mpi, otherwise a dummy
-// implmentation is used and this file doesn't need to implement anything
-// (see the header file).
-#ifdef OOMPH_HAS_MPI
-
 // oomph-lib includes
 #include "preconditioner_array.h"
 
+// c++ includes
+#include <algorithm>
+#include <exception>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Preconditioner array is only useful if we have mpi, otherwise a dummy
+// implmentation is used and this file doesn't need to implement it
+// (see the header file). The SharedMemoryPreconditionerArray (at the end
+// of this file) is always available.
+#ifdef OOMPH_HAS_MPI
+
 namespace oomph
 {
   //============================================================================
@@ -316,7 +325,7 @@ namespace oomph
           {
             if (Nrow_local_for_proc[i][p] != 0)
             {
-              int* row_start = matrix_pt[i]->row_start();
+              SparseOffset* row_start = matrix_pt[i]->row_start();
               unsigned k =
                 First_row_for_proc[i][p] - current_first_row[my_rank];
               nnz_send[i][p] =
@@ -387,7 +396,7 @@ namespace oomph
 
           // get pointers to the underlying data in the current matrix
           double* values_send = matrix_pt[i]->value();
-          int* row_start_send = matrix_pt[i]->row_start();
+          SparseOffset* row_start_send = matrix_pt[i]->row_start();
           int* column_index_send = matrix_pt[i]->column_index();
 
           // send and receive the contents of the vector
@@ -474,7 +483,7 @@ namespace oomph
             // get pointers to the underlying data
             double* values_pt = matrix_pt[i]->value();
             int* column_index_pt = matrix_pt[i]->column_index();
-            int* row_start_pt = matrix_pt[i]->row_start();
+            SparseOffset* row_start_pt = matrix_pt[i]->row_start();
 
             // build the matrix without a copy of the data
             local_matrix_pt->build_without_copy(matrix_pt[i]->ncol(),
@@ -535,7 +544,8 @@ namespace oomph
             // storage for received data
             double* values_recv = new double[nnz_total];
             int* column_index_recv = new int[nnz_total];
-            int* row_start_recv = new int[target_nrow_local[i][my_rank] + 1];
+            SparseOffset* row_start_recv =
+              new SparseOffset[target_nrow_local[i][my_rank] + 1];
 
             // send and receive the contents of the vector
             for (unsigned pp = 0; pp < nproc; pp++)
@@ -602,7 +612,7 @@ namespace oomph
                 {
                   // get pointers to the underlying data in the current matrix
                   double* values_send = matrix_pt[i]->value();
-                  int* row_start_send = matrix_pt[i]->row_start();
+                  SparseOffset* row_start_send = matrix_pt[i]->row_start();
                   int* column_index_send = matrix_pt[i]->column_index();
 
                   // offset for row_start send to self
@@ -724,7 +734,7 @@ namespace oomph
             // get pointers to the underlying data
             double* values_pt = matrix_pt[i]->value();
             int* column_index_pt = matrix_pt[i]->column_index();
-            int* row_start_pt = matrix_pt[i]->row_start();
+            SparseOffset* row_start_pt = matrix_pt[i]->row_start();
 
             // build the matrix without a copy of the data
             local_matrix_pt->build_without_copy(matrix_pt[i]->ncol(),
@@ -824,7 +834,7 @@ namespace oomph
           {
             if (Nrow_local_for_proc[i][p] != 0)
             {
-              int* row_start = matrix_pt[i]->row_start();
+              SparseOffset* row_start = matrix_pt[i]->row_start();
               unsigned k =
                 First_row_for_proc[i][p] - current_first_row[my_rank];
               nnz_send[i][p] =
@@ -938,7 +948,8 @@ namespace oomph
       // storage for received data
       double* values_recv = new double[nnz_total];
       int* column_index_recv = new int[nnz_total];
-      int* row_start_recv = new int[target_nrow_local[Color][my_rank] + 1];
+      SparseOffset* row_start_recv =
+        new SparseOffset[target_nrow_local[Color][my_rank] + 1];
 
       /// ////////////////////////////////////////////////////////////////////////
       // SEND
@@ -952,7 +963,7 @@ namespace oomph
       {
         // get pointers to the underlying data in the current matrix
         double* values_send = matrix_pt[i]->value();
-        int* row_start_send = matrix_pt[i]->row_start();
+        SparseOffset* row_start_send = matrix_pt[i]->row_start();
         int* column_index_send = matrix_pt[i]->column_index();
 
         // send and receive the contents of the vector
@@ -1144,7 +1155,7 @@ namespace oomph
       {
         // get pointers to the underlying data in the current matrix
         double* values_send = matrix_pt[Color]->value();
-        int* row_start_send = matrix_pt[Color]->row_start();
+        SparseOffset* row_start_send = matrix_pt[Color]->row_start();
         int* column_index_send = matrix_pt[Color]->column_index();
 
         // offset for row_start send to self
@@ -1287,7 +1298,7 @@ namespace oomph
             // get pointers to the underlying data
             double* values_pt = matrix_pt[i]->value();
             int* column_index_pt = matrix_pt[i]->column_index();
-            int* row_start_pt = matrix_pt[i]->row_start();
+            SparseOffset* row_start_pt = matrix_pt[i]->row_start();
 
             // build the matrix without a copy of the data
             local_matrix_pt->build_without_copy(matrix_pt[i]->ncol(),
@@ -1387,7 +1398,7 @@ namespace oomph
           {
             if (Nrow_local_for_proc[i][p] != 0)
             {
-              int* row_start = matrix_pt[i]->row_start();
+              SparseOffset* row_start = matrix_pt[i]->row_start();
               unsigned k =
                 First_row_for_proc[i][p] - current_first_row[my_rank];
               nnz_send[i][p] =
@@ -1501,7 +1512,8 @@ namespace oomph
       // storage for received data
       double* values_recv = new double[nnz_total];
       int* column_index_recv = new int[nnz_total];
-      int* row_start_recv = new int[target_nrow_local[Color][my_rank] + 1];
+      SparseOffset* row_start_recv =
+        new SparseOffset[target_nrow_local[Color][my_rank] + 1];
 
       /// ////////////////////////////////////////////////////////////////////////
       // RECV
@@ -1612,7 +1624,7 @@ namespace oomph
       {
         // get pointers to the underlying data in the current matrix
         double* values_send = matrix_pt[i]->value();
-        int* row_start_send = matrix_pt[i]->row_start();
+        SparseOffset* row_start_send = matrix_pt[i]->row_start();
         int* column_index_send = matrix_pt[i]->column_index();
 
         // send and receive the contents of the vector
@@ -1707,7 +1719,7 @@ namespace oomph
       {
         // get pointers to the underlying data in the current matrix
         double* values_send = matrix_pt[Color]->value();
-        int* row_start_send = matrix_pt[Color]->row_start();
+        SparseOffset* row_start_send = matrix_pt[Color]->row_start();
         int* column_index_send = matrix_pt[Color]->column_index();
 
         // offset for row_start send to self
@@ -1850,7 +1862,7 @@ namespace oomph
             // get pointers to the underlying data
             double* values_pt = matrix_pt[i]->value();
             int* column_index_pt = matrix_pt[i]->column_index();
-            int* row_start_pt = matrix_pt[i]->row_start();
+            SparseOffset* row_start_pt = matrix_pt[i]->row_start();
 
             // build the matrix without a copy of the data
             local_matrix_pt->build_without_copy(matrix_pt[i]->ncol(),
@@ -1950,7 +1962,7 @@ namespace oomph
           {
             if (Nrow_local_for_proc[i][p] != 0)
             {
-              int* row_start = matrix_pt[i]->row_start();
+              SparseOffset* row_start = matrix_pt[i]->row_start();
               unsigned k =
                 First_row_for_proc[i][p] - current_first_row[my_rank];
               nnz_send[i][p] =
@@ -2071,7 +2083,8 @@ namespace oomph
       // storage for received data
       double* values_recv = new double[nnz_total];
       int* column_index_recv = new int[nnz_total];
-      int* row_start_recv = new int[target_nrow_local[Color][my_rank] + 1];
+      SparseOffset* row_start_recv =
+        new SparseOffset[target_nrow_local[Color][my_rank] + 1];
 
       /// ////////////////////////////////////////////////////////////////////////
       // RECV
@@ -2182,7 +2195,7 @@ namespace oomph
       {
         // get pointers to the underlying data in the current matrix
         double* values_send = matrix_pt[i]->value();
-        int* row_start_send = matrix_pt[i]->row_start();
+        SparseOffset* row_start_send = matrix_pt[i]->row_start();
         int* column_index_send = matrix_pt[i]->column_index();
 
         // send and receive the contents of the vector
@@ -2277,7 +2290,7 @@ namespace oomph
       {
         // get pointers to the underlying data in the current matrix
         double* values_send = matrix_pt[Color]->value();
-        int* row_start_send = matrix_pt[Color]->row_start();
+        SparseOffset* row_start_send = matrix_pt[Color]->row_start();
         int* column_index_send = matrix_pt[Color]->column_index();
 
         // offset for row_start send to self
@@ -2770,3 +2783,252 @@ namespace oomph
 
 // End of "if we have mpi"
 #endif
+
+
+namespace oomph
+{
+  //============================================================================
+  /// Setup the preconditioners. Sets up each preconditioner in the
+  /// array for the corresponding matrix in the vector matrix_pt.
+  /// The number of preconditioners in the array is taken to be the length of
+  /// prec_pt.
+  //============================================================================
+  void SharedMemoryPreconditionerArray::setup_preconditioners(
+    const Vector<CRDoubleMatrix*>& matrix_pt,
+    const Vector<Preconditioner*>& prec_pt)
+  {
+    // clean memory
+    this->clean_up_memory();
+
+    // get the number of preconditioners in the array
+    unsigned n_prec = prec_pt.size();
+
+#ifdef PARANOID
+    // check that we have a matrix for each preconditioner
+    if (matrix_pt.size() != n_prec)
+    {
+      std::ostringstream error_message;
+      error_message << "The number of matrices (" << matrix_pt.size()
+                    << ") must be the same as the number of preconditioners ("
+                    << n_prec << ").";
+      throw OomphLibError(
+        error_message.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+
+    // check that the preconditioners and matrices have been set and that the
+    // matrices are not distributed
+    for (unsigned i = 0; i < n_prec; i++)
+    {
+      if ((prec_pt[i] == 0) || (matrix_pt[i] == 0))
+      {
+        std::ostringstream error_message;
+        error_message << "The pointer to preconditioner " << i
+                      << " or its matrix is null.";
+        throw OomphLibError(error_message.str(),
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+      if (matrix_pt[i]->distributed() &&
+          (matrix_pt[i]->distribution_pt()->communicator_pt()->nproc() > 1))
+      {
+        std::ostringstream error_message;
+        error_message << "Matrix " << i << " is distributed. "
+                      << "The SharedMemoryPreconditionerArray only works "
+                      << "with non-distributed matrices; use the "
+                      << "PreconditionerArray instead.";
+        throw OomphLibError(error_message.str(),
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+    }
+#endif
+
+    // store the preconditioners
+    Preconditioner_pt = prec_pt;
+    Setup_time.assign(n_prec, 0.0);
+
+    // distribute the work over the thread groups
+    setup_thread_groups(matrix_pt);
+
+    // and set up the preconditioners
+    process_preconditioners(&matrix_pt, 0, 0);
+  }
+
+  //============================================================================
+  /// Applies each preconditioner to the corresponding vector in
+  /// r and z
+  //============================================================================
+  void SharedMemoryPreconditionerArray::solve_preconditioners(
+    const Vector<DoubleVector>& r, Vector<DoubleVector>& z)
+  {
+    // get the number of preconditioners in the array
+    unsigned n_prec = Preconditioner_pt.size();
+
+#ifdef PARANOID
+    // check that the preconditioners have been set up
+    if (Prec_in_group.size() == 0 && n_prec > 0)
+    {
+      throw OomphLibError("The preconditioners have not been set up.",
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+
+    // check that r is the right length
+    if (r.size() != n_prec)
+    {
+      std::ostringstream error_message;
+      error_message << "r needs to have the same length as the number of "
+                    << "preconditioners in the array.";
+      throw OomphLibError(
+        error_message.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    // make sure we have a solution vector for each preconditioner
+    z.resize(n_prec);
+
+    // apply the preconditioners
+    process_preconditioners(0, &r, &z);
+  }
+
+  //============================================================================
+  /// Distribute the preconditioners (and the available threads) over
+  /// the thread groups, using the number of nonzeros in the matrices
+  /// as the measure of the work
+  //============================================================================
+  void SharedMemoryPreconditionerArray::setup_thread_groups(
+    const Vector<CRDoubleMatrix*>& matrix_pt)
+  {
+    // get the number of preconditioners in the array
+    unsigned n_prec = matrix_pt.size();
+    if (n_prec == 0) return;
+
+    // the number of available threads
+    unsigned n_thread = 1;
+#ifdef _OPENMP
+    n_thread = omp_get_max_threads();
+#endif
+
+    // the number of thread groups
+    unsigned n_group = std::min(n_thread, n_prec);
+
+    // sort the preconditioners by decreasing amount of work (the number
+    // of nonzeros in the matrix plus the number of rows)
+    Vector<std::pair<double, unsigned>> work_and_prec(n_prec);
+    for (unsigned i = 0; i < n_prec; i++)
+    {
+      work_and_prec[i] = std::make_pair(
+        -double(matrix_pt[i]->nnz() + matrix_pt[i]->nrow()), i);
+    }
+    std::sort(work_and_prec.begin(), work_and_prec.end());
+
+    // give each preconditioner (largest first) to the group with the least
+    // work so far
+    Prec_in_group.resize(n_group);
+    Vector<double> group_work(n_group, 0.0);
+    for (unsigned k = 0; k < n_prec; k++)
+    {
+      unsigned g =
+        std::min_element(group_work.begin(), group_work.end()) -
+        group_work.begin();
+      Prec_in_group[g].push_back(work_and_prec[k].second);
+      group_work[g] -= work_and_prec[k].first;
+    }
+
+    // split the threads evenly over the groups and give any spare threads
+    // to the groups with the most work
+    Nthread_for_group.assign(n_group, n_thread / n_group);
+    Vector<std::pair<double, unsigned>> work_and_group(n_group);
+    for (unsigned g = 0; g < n_group; g++)
+    {
+      work_and_group[g] = std::make_pair(-group_work[g], g);
+    }
+    std::sort(work_and_group.begin(), work_and_group.end());
+    unsigned n_spare = n_thread % n_group;
+    for (unsigned k = 0; k < n_spare; k++)
+    {
+      Nthread_for_group[work_and_group[k].second]++;
+    }
+  }
+
+  //============================================================================
+  /// Set up (if matrix_pt is non-null) or apply (otherwise) all the
+  /// preconditioners, with each group of threads processing its own
+  /// preconditioners
+  //============================================================================
+  void SharedMemoryPreconditionerArray::process_preconditioners(
+    const Vector<CRDoubleMatrix*>* matrix_pt,
+    const Vector<DoubleVector>* r_pt,
+    Vector<DoubleVector>* z_pt)
+  {
+    // the number of thread groups
+    int n_group = Prec_in_group.size();
+
+    // Exceptions can't leave a parallel region so we catch them and rethrow
+    // them once all groups have finished
+    Vector<std::exception_ptr> group_exception_pt(n_group);
+
+    // Suppress any output from the preconditioners while they're processed
+    // concurrently
+    std::ostream* stream_pt = oomph_info.stream_pt();
+    if (n_group > 1)
+    {
+      oomph_info.stream_pt() = &oomph_nullstream;
+    }
+
+#ifdef _OPENMP
+    // Allow the groups' threads to be used in the preconditioners' own
+    // parallel regions
+    int max_active_levels = omp_get_max_active_levels();
+    omp_set_max_active_levels(std::max(max_active_levels, 2));
+#pragma omp parallel for num_threads(n_group) schedule(static, 1)
+#endif
+    for (int g = 0; g < n_group; g++)
+    {
+#ifdef _OPENMP
+      // the size of the thread team for nested parallel regions
+      omp_set_num_threads(Nthread_for_group[g]);
+#endif
+      try
+      {
+        unsigned n_prec_in_group = Prec_in_group[g].size();
+        for (unsigned j = 0; j < n_prec_in_group; j++)
+        {
+          unsigned i = Prec_in_group[g][j];
+          if (matrix_pt != 0)
+          {
+            double t_start = TimingHelpers::timer();
+            Preconditioner_pt[i]->setup((*matrix_pt)[i]);
+            Setup_time[i] = TimingHelpers::timer() - t_start;
+          }
+          else
+          {
+            Preconditioner_pt[i]->preconditioner_solve((*r_pt)[i],
+                                                       (*z_pt)[i]);
+          }
+        }
+      }
+      catch (...)
+      {
+        group_exception_pt[g] = std::current_exception();
+      }
+    }
+
+#ifdef _OPENMP
+    // restore the OpenMP settings
+    omp_set_max_active_levels(max_active_levels);
+#endif
+
+    // restore the output stream
+    oomph_info.stream_pt() = stream_pt;
+
+    // rethrow the first exception (if any)
+    for (int g = 0; g < n_group; g++)
+    {
+      if (group_exception_pt[g])
+      {
+        std::rethrow_exception(group_exception_pt[g]);
+      }
+    }
+  }
+} // namespace oomph
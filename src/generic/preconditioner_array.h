@@ -242,5 +242,124 @@ namespace oomph
 // End of "if we have MPI"
 #endif
 
+
+namespace oomph
+{
+  //=============================================================================
+  /// SharedMemoryPreconditionerArray - thread-based counterpart of the
+  /// PreconditionerArray for runs on a single (multi-core) node: The
+  /// preconditioners in the array are set up and applied concurrently, each
+  /// by its own group of threads. Notes:
+  /// 1. Only works with (non-distributed) CRDoubleMatrices
+  /// 2. The available threads are split into (at most) one group per
+  ///    preconditioner. The preconditioners are distributed over the groups
+  ///    so that the total number of nonzeros in the matrices is balanced
+  ///    (largest first); any spare threads go to the most heavily loaded
+  ///    groups and are available to the preconditioners' own (nested)
+  ///    parallel regions.
+  /// 3. Unlike the PreconditionerArray, this class does NOT take ownership
+  ///    of the preconditioners (or the matrices) passed to
+  ///    setup_preconditioners(...)
+  /// 4. It is assumed that preconditioners do not require access to matrix
+  ///    once setup(...) is called and that they don't share any (non-const)
+  ///    data with each other so they can safely be set up and applied
+  ///    concurrently
+  /// 5. Any output written to oomph_info by the preconditioners while they
+  ///    are processed concurrently is suppressed.
+  /// 6. The serial SuperLU library keeps static data during its
+  ///    factorisation so SuperLUSolver (and hence SuperLUPreconditioner)
+  ///    factorises its matrices one at a time, inside an OpenMP critical
+  ///    section; only its back-substitutions run concurrently. Setting up
+  ///    an array of SuperLU preconditioners is therefore no faster than
+  ///    setting them up one after the other.
+  /// Threading uses OpenMP; if the library is compiled without OpenMP the
+  /// preconditioners are simply set up and applied one after the other.
+  //=============================================================================
+  class SharedMemoryPreconditionerArray
+  {
+  public:
+    /// Constructor (empty)
+    SharedMemoryPreconditionerArray() {}
+
+    /// Broken copy constructor
+    SharedMemoryPreconditionerArray(const SharedMemoryPreconditionerArray&) =
+      delete;
+
+    /// Broken assignment operator
+    void operator=(const SharedMemoryPreconditionerArray&) = delete;
+
+    /// Destructor (empty -- the preconditioners are not owned by this class)
+    ~SharedMemoryPreconditionerArray() {}
+
+    /// Setup the preconditioners. Sets up each preconditioner in the
+    /// array for the corresponding matrix in the vector matrix_pt.
+    /// The number of preconditioners in the array is taken to be the length of
+    /// prec_pt.
+    void setup_preconditioners(const Vector<CRDoubleMatrix*>& matrix_pt,
+                               const Vector<Preconditioner*>& prec_pt);
+
+    /// Applies each preconditioner to the corresponding vector in
+    /// r and z
+    void solve_preconditioners(const Vector<DoubleVector>& r,
+                               Vector<DoubleVector>& z);
+
+    /// Clean up memory (forget about the preconditioners)
+    void clean_up_memory()
+    {
+      Preconditioner_pt.clear();
+      Prec_in_group.clear();
+      Nthread_for_group.clear();
+      Setup_time.clear();
+    }
+
+    /// Number of thread groups
+    unsigned ngroup() const
+    {
+      return Prec_in_group.size();
+    }
+
+    /// Number of threads in the g-th thread group
+    unsigned nthread_for_group(const unsigned& g) const
+    {
+      return Nthread_for_group[g];
+    }
+
+    /// Wall-clock time [sec] taken to set up the i-th preconditioner
+    /// (by its thread group) in the most recent call to
+    /// setup_preconditioners(...)
+    double setup_time(const unsigned& i) const
+    {
+      return Setup_time[i];
+    }
+
+  private:
+    /// Distribute the preconditioners (and the available threads) over
+    /// the thread groups, using the number of nonzeros in the matrices
+    /// as the measure of the work
+    void setup_thread_groups(const Vector<CRDoubleMatrix*>& matrix_pt);
+
+    /// Set up (if matrix_pt is non-null) or apply (otherwise) all the
+    /// preconditioners, with each group of threads processing its own
+    /// preconditioners
+    void process_preconditioners(const Vector<CRDoubleMatrix*>* matrix_pt,
+                                 const Vector<DoubleVector>* r_pt,
+                                 Vector<DoubleVector>* z_pt);
+
+    /// The preconditioners in the array
+    Vector<Preconditioner*> Preconditioner_pt;
+
+    /// Storage (indexed [g][j]) for the number of the j-th preconditioner
+    /// processed by the g-th thread group
+    Vector<Vector<unsigned>> Prec_in_group;
+
+    /// The number of threads in each thread group
+    Vector<unsigned> Nthread_for_group;
+
+    /// Setup time for each preconditioner
+    Vector<double> Setup_time;
+
+  }; // SharedMemoryPreconditionerArray
+} // namespace oomph
+
 // End of include guard
 #endif
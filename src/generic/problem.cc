@@ -45,6 +45,7 @@
 #include "dg_elements.h"
 #include "partitioning.h"
 #include "spines.h"
+#include "block_cr_double_matrix.h"
 
 // Include to fill in additional_setup_shared_node_scheme() function
 #include "refineable_mesh.template.cc"
@@ -76,6 +77,11 @@ namespace oomph
       Empty_actions_before_read_unstructured_meshes_has_been_called(false),
       Empty_actions_after_read_unstructured_meshes_has_been_called(false),
       Store_local_dof_pt_in_elements(false),
+      Affine_operator_caching_is_enabled(false),
+      Affine_operator_load_is_constant(false),
+      Affine_stiffness_matrix_pt(0),
+      Affine_mass_matrix_pt(0),
+      Affine_jacobian_weight(0.0),
       Calculate_hessian_products_analytic(false),
 #ifdef OOMPH_HAS_MPI
       Doc_imbalance_in_parallel_assembly(false),
@@ -91,6 +97,7 @@ namespace oomph
       Time_adaptive_newton_crash_on_solve_fail(false),
       Jacobian_reuse_is_enabled(false),
       Jacobian_has_been_computed(false),
+      Doc_memory_usage_in_newton_solve(false),
       Problem_is_nonlinear(true),
       Pause_at_end_of_sparse_assembly(false),
       Doc_time_in_distribute(false),
@@ -125,6 +132,9 @@ namespace oomph
       First_jacobian_sign_change(false),
       Arc_length_step_taken(false),
       Use_finite_differences_for_continuation_derivatives(false),
+      Jacobian_reuse_in_continuation_is_enabled(false),
+      Continuation_jacobian_has_been_factorised(false),
+      Max_residual_ratio_for_continuation_jacobian_reuse(0.25),
 #ifdef OOMPH_HAS_MPI
       Dist_problem_matrix_distribution(Uniform_matrix_distribution),
       Parallel_sparse_assemble_previous_allocation(0),
@@ -200,6 +210,9 @@ namespace oomph
     delete Communicator_pt;
     delete Dof_distribution_pt;
 
+    // Wipe the cached operator of a linear problem (if any)
+    clear_affine_operator_cache();
+
     // Delete any copies of the problem that have been created for
     // use in adaptive bifurcation tracking.
     // ALH: This will eventually go
@@ -2018,6 +2031,13 @@ namespace oomph
     }
 #endif
 
+    // The cached operator of a linear problem (if any) refers to the
+    // old equation numbers
+    clear_affine_operator_cache();
+
+    // ... and so does any factorisation kept for re-use in continuation
+    Continuation_jacobian_has_been_factorised = false;
+
     // Number of submeshes
     unsigned n_sub_mesh = Sub_mesh_pt.size();
 
@@ -3605,6 +3625,35 @@ namespace oomph
     // We can invert the mass matrix element by element
     if (Discontinuous_element_formulation)
     {
+      // Precompute the numerical fluxes across the faces in the meshes
+      // in which this has been enabled, so that the flux across each
+      // interface is only computed once
+      Vector<DGMesh*> flux_mesh_pt;
+      const unsigned n_sub_mesh = this->nsub_mesh();
+      if (n_sub_mesh == 0)
+      {
+        DGMesh* const dg_mesh_pt = dynamic_cast<DGMesh*>(Problem::mesh_pt());
+        if (dg_mesh_pt != 0)
+        {
+          flux_mesh_pt.push_back(dg_mesh_pt);
+        }
+      }
+      else
+      {
+        for (unsigned m = 0; m < n_sub_mesh; m++)
+        {
+          DGMesh* const dg_mesh_pt = dynamic_cast<DGMesh*>(this->mesh_pt(m));
+          if (dg_mesh_pt != 0)
+          {
+            flux_mesh_pt.push_back(dg_mesh_pt);
+          }
+        }
+      }
+
+      // (The fluxes become out of date as soon as the unknowns change,
+      // so they are released when the precomputation goes out of scope)
+      DGInterfaceFluxPrecomputation flux_precomputation(flux_mesh_pt);
+
       // Loop over the elements and get their residuals
       const unsigned n_element = Problem::mesh_pt()->nelement();
       Vector<double> element_Mres;
@@ -3713,6 +3762,18 @@ namespace oomph
   //================================================================
   void Problem::get_residuals(DoubleVector& residuals)
   {
+    // Charge the time to the assembly phase (if recorded)
+    PhaseTimer phase_timer("assembly");
+
+    // Compute the residuals of a linear problem from the cached operator?
+    if (Affine_operator_caching_is_enabled &&
+        Affine_operator_load_is_constant &&
+        (Assembly_handler_pt == Default_assembly_handler_pt))
+    {
+      get_affine_residuals(residuals);
+      return;
+    }
+
     // Three different cases; if MPI_Helpers::MPI_has_been_initialised=true
     // this means MPI_Helpers::init() has been called.  This could happen on a
     // code compiled with MPI but run serially; in this instance the
@@ -3856,9 +3917,9 @@ namespace oomph
       // Setup memory for parallel sparse assemble
       // No matrix so all size zero
       Vector<int*> column_index;
-      Vector<int*> row_start;
+      Vector<SparseOffset*> row_start;
       Vector<double*> value;
-      Vector<unsigned> nnz;
+      Vector<unsigned long> nnz;
       // One set of residuals of sizer one
       Vector<double*> res(1);
 
@@ -3890,6 +3951,9 @@ namespace oomph
   void Problem::get_jacobian(DoubleVector& residuals,
                              DenseDoubleMatrix& jacobian)
   {
+    // Charge the time to the assembly phase (if recorded)
+    PhaseTimer phase_timer("assembly");
+
     // get the number of degrees of freedom
     unsigned n_dof = ndof();
 
@@ -3996,6 +4060,17 @@ namespace oomph
   //=============================================================================
   void Problem::get_jacobian(DoubleVector& residuals, CRDoubleMatrix& jacobian)
   {
+    // Charge the time to the assembly phase (if recorded)
+    PhaseTimer phase_timer("assembly");
+
+    // Recombine the Jacobian of a linear problem from the cached operator?
+    if (Affine_operator_caching_is_enabled &&
+        (Assembly_handler_pt == Default_assembly_handler_pt))
+    {
+      get_affine_jacobian(residuals, jacobian);
+      return;
+    }
+
     // Three different cases; if MPI_Helpers::MPI_has_been_initialised=true
     // this means MPI_Helpers::setup() has been called.  This could happen on a
     // code compiled with MPI but run serially; in this instance the
@@ -4016,9 +4091,9 @@ namespace oomph
     // for the most general interface to sparse_assemble() which allows
     // the assembly of multiple matrices at once.
     Vector<int*> column_index(1);
-    Vector<int*> row_start(1);
+    Vector<SparseOffset*> row_start(1);
     Vector<double*> value(1);
-    Vector<unsigned> nnz(1);
+    Vector<unsigned long> nnz(1);
 
 #ifdef PARANOID
     // PARANOID checks that the distribution of the jacobian matches that of the
@@ -4177,6 +4252,377 @@ namespace oomph
     delete dist_pt;
   }
 
+  //=============================================================================
+  /// Return the (only) non-steady timestepper whose weights enter the
+  /// cached operator of a linear problem; null if all timesteppers are
+  /// steady.
+  //=============================================================================
+  TimeStepper* Problem::affine_operator_time_stepper_pt() const
+  {
+    TimeStepper* affine_time_stepper_pt = 0;
+    unsigned n_time_steppers = Time_stepper_pt.size();
+    for (unsigned i = 0; i < n_time_steppers; i++)
+    {
+      TimeStepper* ts_pt = Time_stepper_pt[i];
+      if (ts_pt->is_steady())
+      {
+        continue;
+      }
+
+      if ((affine_time_stepper_pt != 0) && (ts_pt != affine_time_stepper_pt))
+      {
+        std::ostringstream error_stream;
+        error_stream
+          << "The operator of a linear problem can only be cached if\n"
+          << "its time derivatives are discretised by a single timestepper.\n"
+          << "This problem has (at least) two non-steady timesteppers.\n";
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+
+      if (ts_pt->highest_derivative() != 1)
+      {
+        std::ostringstream error_stream;
+        error_stream
+          << "The operator of a linear problem can only be cached if\n"
+          << "its timestepper only provides first time derivatives,\n"
+          << "but the timestepper (" << ts_pt->type() << ") provides\n"
+          << "time derivatives of order up to "
+          << ts_pt->highest_derivative() << ".\n";
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+      affine_time_stepper_pt = ts_pt;
+    }
+    return affine_time_stepper_pt;
+  }
+
+  //=============================================================================
+  /// Timestepper weight for the current value in the first time
+  /// derivative (zero if all timesteppers are steady)
+  //=============================================================================
+  double Problem::affine_operator_weight() const
+  {
+    TimeStepper* time_stepper_pt = affine_operator_time_stepper_pt();
+    if (time_stepper_pt == 0)
+    {
+      return 0.0;
+    }
+    return time_stepper_pt->weight(1, 0);
+  }
+
+  //=============================================================================
+  /// Assemble the operator of a linear problem, r = K u + M du/dt + f,
+  /// in which the time derivative du/dt is a linear combination of the
+  /// current and previous values of the unknowns u. The stiffness matrix
+  /// K and the load vector f are obtained from the Jacobian and residuals
+  /// with all timesteppers made steady; the mass matrix M is obtained
+  /// from the difference between the Jacobian with the actual timestepper
+  /// weights and K. Both matrices are stored with the same sparsity
+  /// pattern so that the Jacobian can be recombined without re-assembly.
+  /// If all timesteppers are steady (e.g. during a steady solve), M can't
+  /// be obtained (and isn't needed) and is left unassigned.
+  //=============================================================================
+  void Problem::setup_affine_operator_cache()
+  {
+    // Wipe the previous operator (if any)
+    clear_affine_operator_cache();
+
+#ifdef OOMPH_HAS_MPI
+    if (Communicator_pt->nproc() > 1)
+    {
+      std::ostringstream error_stream;
+      error_stream << "Caching of the operator of a linear problem has not "
+                   << "been implemented\nfor problems on more than one "
+                   << "processor yet.\n";
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    TimeStepper* time_stepper_pt = affine_operator_time_stepper_pt();
+
+    // Assemble the matrices with the normal machinery
+    Affine_operator_caching_is_enabled = false;
+
+    // Get the steady residuals and Jacobian (i.e. the stiffness matrix)
+    DoubleVector steady_residuals;
+    CRDoubleMatrix stiffness_matrix;
+    if (time_stepper_pt != 0)
+    {
+      time_stepper_pt->make_steady();
+    }
+    get_jacobian(steady_residuals, stiffness_matrix);
+
+    // Get the Jacobian with the actual weights
+    double weight = 0.0;
+    CRDoubleMatrix jacobian;
+    if (time_stepper_pt != 0)
+    {
+      time_stepper_pt->undo_make_steady();
+      weight = time_stepper_pt->weight(1, 0);
+      if (weight == 0.0)
+      {
+        Affine_operator_caching_is_enabled = true;
+        std::ostringstream error_stream;
+        error_stream << "The weight of the current value in the first time\n"
+                     << "derivative is zero. Has the timestep been set?\n";
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+      DoubleVector residuals;
+      get_jacobian(residuals, jacobian);
+    }
+    Affine_operator_caching_is_enabled = true;
+
+    // Merge the sparsity patterns of the stiffness matrix and the Jacobian
+    unsigned n_row = stiffness_matrix.nrow();
+    unsigned n_col = stiffness_matrix.ncol();
+    const SparseOffset* k_row_start = stiffness_matrix.row_start();
+    const int* k_column_index = stiffness_matrix.column_index();
+    const double* k_value = stiffness_matrix.value();
+    Vector<SparseOffset> row_start(n_row + 1, 0);
+    Vector<int> column_index;
+    Vector<double> stiffness_value;
+    Vector<double> mass_value;
+    column_index.reserve(stiffness_matrix.nnz());
+    stiffness_value.reserve(stiffness_matrix.nnz());
+    mass_value.reserve(stiffness_matrix.nnz());
+
+    // Position of the entry in each column of the current row (entries
+    // before the start of the current row refer to previous rows)
+    Vector<SparseOffset> position(n_col, -1);
+    for (unsigned i = 0; i < n_row; i++)
+    {
+      SparseOffset start = column_index.size();
+      row_start[i] = start;
+      for (SparseOffset k = k_row_start[i]; k < k_row_start[i + 1]; k++)
+      {
+        position[k_column_index[k]] = column_index.size();
+        column_index.push_back(k_column_index[k]);
+        stiffness_value.push_back(k_value[k]);
+        mass_value.push_back(0.0);
+      }
+
+      // M = (J - K) / w
+      if (time_stepper_pt != 0)
+      {
+        const SparseOffset* j_row_start = jacobian.row_start();
+        const int* j_column_index = jacobian.column_index();
+        const double* j_value = jacobian.value();
+        for (SparseOffset k = j_row_start[i]; k < j_row_start[i + 1]; k++)
+        {
+          int j = j_column_index[k];
+          if (position[j] < start)
+          {
+            position[j] = column_index.size();
+            column_index.push_back(j);
+            stiffness_value.push_back(0.0);
+            mass_value.push_back(0.0);
+          }
+          mass_value[position[j]] += j_value[k];
+        }
+        SparseOffset end = column_index.size();
+        for (SparseOffset k = start; k < end; k++)
+        {
+          mass_value[k] = (mass_value[k] - stiffness_value[k]) / weight;
+        }
+      }
+    }
+    row_start[n_row] = column_index.size();
+
+    Affine_stiffness_matrix_pt = new CRDoubleMatrix;
+    Affine_stiffness_matrix_pt->build(stiffness_matrix.distribution_pt(),
+                                      n_col,
+                                      stiffness_value,
+                                      column_index,
+                                      row_start);
+    if (time_stepper_pt != 0)
+    {
+      Affine_mass_matrix_pt = new CRDoubleMatrix;
+      Affine_mass_matrix_pt->build(stiffness_matrix.distribution_pt(),
+                                   n_col,
+                                   mass_value,
+                                   column_index,
+                                   row_start);
+    }
+
+    // The load vector is the steady residual for zero unknowns, f = r - K u
+    DoubleVector dofs;
+    get_dofs(dofs);
+    DoubleVector k_times_dofs;
+    Affine_stiffness_matrix_pt->multiply(dofs, k_times_dofs);
+    Affine_load_vector = steady_residuals;
+    Affine_load_vector -= k_times_dofs;
+  }
+
+  //=============================================================================
+  /// Set up the cached operator of a linear problem if it hasn't been
+  /// set up yet, or if it was set up while all timesteppers were steady
+  /// (so the mass matrix is missing) and a timestepper is no longer steady
+  //=============================================================================
+  void Problem::setup_affine_operator_cache_if_required()
+  {
+    if ((Affine_stiffness_matrix_pt == 0) ||
+        ((Affine_mass_matrix_pt == 0) &&
+         (affine_operator_time_stepper_pt() != 0)))
+    {
+      setup_affine_operator_cache();
+    }
+  }
+
+  //=============================================================================
+  /// Wipe the cached operator of a linear problem
+  //=============================================================================
+  void Problem::clear_affine_operator_cache()
+  {
+    delete Affine_stiffness_matrix_pt;
+    Affine_stiffness_matrix_pt = 0;
+    delete Affine_mass_matrix_pt;
+    Affine_mass_matrix_pt = 0;
+    Affine_load_vector.clear();
+  }
+
+  //=============================================================================
+  /// Compute the residuals of a linear problem, r = K u + M du/dt + f,
+  /// from the cached operator (set up if required) by sparse matrix-vector
+  /// products
+  //=============================================================================
+  void Problem::get_affine_residuals(DoubleVector& residuals)
+  {
+    setup_affine_operator_cache_if_required();
+
+    DoubleVector dofs;
+    get_dofs(dofs);
+    residuals.clear();
+    Affine_stiffness_matrix_pt->multiply(dofs, residuals);
+    residuals += Affine_load_vector;
+
+    // Add the contribution from the time derivative
+    TimeStepper* time_stepper_pt = affine_operator_time_stepper_pt();
+    if (time_stepper_pt != 0)
+    {
+      unsigned n_row_local = dofs.nrow_local();
+      DoubleVector dudt(dofs.distribution_pt(), 0.0);
+      double* dudt_pt = dudt.values_pt();
+      unsigned n_tstorage = time_stepper_pt->ntstorage();
+      for (unsigned t = 0; t < n_tstorage; t++)
+      {
+        double weight = time_stepper_pt->weight(1, t);
+        if (weight == 0.0)
+        {
+          continue;
+        }
+        if (t > 0)
+        {
+          get_dofs(t, dofs);
+        }
+        const double* dofs_pt = dofs.values_pt();
+        for (unsigned i = 0; i < n_row_local; i++)
+        {
+          dudt_pt[i] += weight * dofs_pt[i];
+        }
+      }
+      DoubleVector m_times_dudt;
+      Affine_mass_matrix_pt->multiply(dudt, m_times_dudt);
+      residuals += m_times_dudt;
+    }
+  }
+
+  //=============================================================================
+  /// Recombine the Jacobian of a linear problem, J = K + w M, from the
+  /// cached operator (set up if required); w is the timestepper weight
+  /// for the current value in the first time derivative. The residuals
+  /// are assembled as usual unless the load is constant, in which case
+  /// they are also computed from the cached operator.
+  //=============================================================================
+  void Problem::get_affine_jacobian(DoubleVector& residuals,
+                                    CRDoubleMatrix& jacobian)
+  {
+    setup_affine_operator_cache_if_required();
+
+    double weight = affine_operator_weight();
+
+    // J = K + w M (the two matrices share their sparsity pattern; there
+    // is no mass matrix if the cache was set up while all timesteppers
+    // were steady, in which case w is zero too)
+    unsigned n_row = Affine_stiffness_matrix_pt->nrow();
+    unsigned long nnz = Affine_stiffness_matrix_pt->nnz();
+    const double* k_value = Affine_stiffness_matrix_pt->value();
+    const int* k_column_index = Affine_stiffness_matrix_pt->column_index();
+    const SparseOffset* k_row_start = Affine_stiffness_matrix_pt->row_start();
+    double* value = new double[nnz];
+    int* column_index = new int[nnz];
+    SparseOffset* row_start = new SparseOffset[n_row + 1];
+    for (unsigned long k = 0; k < nnz; k++)
+    {
+      value[k] = k_value[k];
+      column_index[k] = k_column_index[k];
+    }
+    if (Affine_mass_matrix_pt != 0)
+    {
+      const double* m_value = Affine_mass_matrix_pt->value();
+      for (unsigned long k = 0; k < nnz; k++)
+      {
+        value[k] += weight * m_value[k];
+      }
+    }
+    for (unsigned i = 0; i <= n_row; i++)
+    {
+      row_start[i] = k_row_start[i];
+    }
+    jacobian.build(Affine_stiffness_matrix_pt->distribution_pt());
+    jacobian.build_without_copy(Affine_stiffness_matrix_pt->ncol(),
+                                nnz,
+                                value,
+                                column_index,
+                                row_start);
+    Affine_jacobian_weight = weight;
+
+    // Get the residuals (from the cached operator if the load is constant)
+    residuals.clear();
+    get_residuals(residuals);
+  }
+
+  //=============================================================================
+  /// Return the fully-assembled Jacobian and residuals for the problem,
+  /// in the case where the Jacobian matrix is in block compressed row
+  /// storage format, with the block size specified in the matrix. The
+  /// Jacobian is assembled as a (non-distributed) CRDoubleMatrix and then
+  /// converted.
+  //=============================================================================
+  void Problem::get_jacobian(DoubleVector& residuals,
+                             BlockCRDoubleMatrix& jacobian)
+  {
+    // Get the block size from the matrix
+    const unsigned block_size = jacobian.block_size();
+
+    // Check the block size (partially pinned nodes can easily make the
+    // number of degrees of freedom odd)
+    if ((block_size == 0) || (this->ndof() % block_size != 0))
+    {
+      std::ostringstream error_stream;
+      error_stream << "The block size of the Jacobian (" << block_size
+                   << ") must divide the number of degrees of freedom ("
+                   << this->ndof() << ")\n";
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+
+    // Assemble the Jacobian in (non-distributed) row compressed format
+    LinearAlgebraDistribution dist(this->communicator_pt(), this->ndof(), false);
+    CRDoubleMatrix cr_jacobian(&dist);
+    if (!residuals.built())
+    {
+      residuals.build(&dist, 0.0);
+    }
+    get_jacobian(residuals, cr_jacobian);
+
+    // Convert it
+    jacobian.build(cr_jacobian, block_size);
+  }
+
+
   //=============================================================================
   /// Return the fully-assembled Jacobian and residuals for the problem,
   /// in the case when the jacobian matrix is in column-compressed storage
@@ -4184,6 +4630,9 @@ namespace oomph
   //=============================================================================
   void Problem::get_jacobian(DoubleVector& residuals, CCDoubleMatrix& jacobian)
   {
+    // Charge the time to the assembly phase (if recorded)
+    PhaseTimer phase_timer("assembly");
+
     // Three different cases; if MPI_Helpers::MPI_has_been_initialised=true
     // this means MPI_Helpers::setup() has been called.  This could happen on a
     // code compiled with MPI but run serially; in this instance the
@@ -4244,14 +4693,14 @@ namespace oomph
     // for the most general interface to sparse_assemble() which allows
     // the assembly of multiple matrices at once.
     Vector<int*> row_index(1);
-    Vector<int*> column_start(1);
+    Vector<SparseOffset*> column_start(1);
     Vector<double*> value(1);
 
     // Allocate generalised storage format for passing to sparse_assemble()
     Vector<double*> res(1);
 
     // allocate storage for the number of non-zeros in each matrix
-    Vector<unsigned> nnz(1);
+    Vector<unsigned long> nnz(1);
 
     // The matrix is in compressed column format
     bool compressed_row_flag = false;
@@ -4483,9 +4932,9 @@ namespace oomph
   //=====================================================================
   void Problem::sparse_assemble_row_or_column_compressed(
     Vector<int*>& column_or_row_index,
-    Vector<int*>& row_or_column_start,
+    Vector<SparseOffset*>& row_or_column_start,
     Vector<double*>& value,
-    Vector<unsigned>& nnz,
+    Vector<unsigned long>& nnz,
     Vector<double*>& residuals,
     bool compressed_row_flag)
   {
@@ -4583,9 +5032,9 @@ namespace oomph
   //=====================================================================
   void Problem::sparse_assemble_row_or_column_compressed_with_maps(
     Vector<int*>& column_or_row_index,
-    Vector<int*>& row_or_column_start,
+    Vector<SparseOffset*>& row_or_column_start,
     Vector<double*>& value,
-    Vector<unsigned>& nnz,
+    Vector<unsigned long>& nnz,
     Vector<double*>& residuals,
     bool compressed_row_flag)
   {
@@ -4855,7 +5304,7 @@ namespace oomph
     for (unsigned m = 0; m < n_matrix; m++)
     {
       // Set the number of rows or columns
-      row_or_column_start[m] = new int[ndof + 1];
+      row_or_column_start[m] = new SparseOffset[ndof + 1];
       // Counter for the total number of entries in the storage scheme
       unsigned long entry_count = 0;
       row_or_column_start[m][0] = entry_count;
@@ -4929,9 +5378,9 @@ namespace oomph
   //=====================================================================
   void Problem::sparse_assemble_row_or_column_compressed_with_lists(
     Vector<int*>& column_or_row_index,
-    Vector<int*>& row_or_column_start,
+    Vector<SparseOffset*>& row_or_column_start,
     Vector<double*>& value,
-    Vector<unsigned>& nnz,
+    Vector<unsigned long>& nnz,
     Vector<double*>& residuals,
     bool compressed_row_flag)
   {
@@ -5210,7 +5659,7 @@ namespace oomph
     for (unsigned m = 0; m < n_matrix; m++)
     {
       // Set the number of rows or columns
-      row_or_column_start[m] = new int[ndof + 1];
+      row_or_column_start[m] = new SparseOffset[ndof + 1];
       // Counter for the total number of entries in the storage scheme
       unsigned long entry_count = 0;
       // The first entry is 0
@@ -5344,9 +5793,9 @@ namespace oomph
   //=====================================================================
   void Problem::sparse_assemble_row_or_column_compressed_with_vectors_of_pairs(
     Vector<int*>& column_or_row_index,
-    Vector<int*>& row_or_column_start,
+    Vector<SparseOffset*>& row_or_column_start,
     Vector<double*>& value,
-    Vector<unsigned>& nnz,
+    Vector<unsigned long>& nnz,
     Vector<double*>& residuals,
     bool compressed_row_flag)
   {
@@ -5632,7 +6081,7 @@ namespace oomph
     for (unsigned m = 0; m < n_matrix; m++)
     {
       // Set the number of rows or columns
-      row_or_column_start[m] = new int[ndof + 1];
+      row_or_column_start[m] = new SparseOffset[ndof + 1];
 
       // fill row_or_column_start and find the number of entries
       row_or_column_start[m][0] = 0;
@@ -5641,7 +6090,7 @@ namespace oomph
         row_or_column_start[m][i + 1] =
           row_or_column_start[m][i] + matrix_data[m][i].size();
       }
-      const unsigned entries = row_or_column_start[m][ndof];
+      const unsigned long entries = row_or_column_start[m][ndof];
 
       // resize vectors
       column_or_row_index[m] = new int[entries];
@@ -5660,7 +6109,7 @@ namespace oomph
         // Loop over all the entries in the vectors corresponding to the given
         // row or column. It will NOT be ordered
         unsigned p = 0;
-        for (int j = row_or_column_start[m][i_global];
+        for (SparseOffset j = row_or_column_start[m][i_global];
              j < row_or_column_start[m][i_global + 1];
              j++)
         {
@@ -5697,9 +6146,9 @@ namespace oomph
   //=====================================================================
   void Problem::sparse_assemble_row_or_column_compressed_with_two_vectors(
     Vector<int*>& column_or_row_index,
-    Vector<int*>& row_or_column_start,
+    Vector<SparseOffset*>& row_or_column_start,
     Vector<double*>& value,
-    Vector<unsigned>& nnz,
+    Vector<unsigned long>& nnz,
     Vector<double*>& residuals,
     bool compressed_row_flag)
   {
@@ -5995,7 +6444,7 @@ namespace oomph
     for (unsigned m = 0; m < n_matrix; m++)
     {
       // Set the number of rows or columns
-      row_or_column_start[m] = new int[ndof + 1];
+      row_or_column_start[m] = new SparseOffset[ndof + 1];
 
       // fill row_or_column_start and find the number of entries
       row_or_column_start[m][0] = 0;
@@ -6004,7 +6453,7 @@ namespace oomph
         row_or_column_start[m][i + 1] =
           row_or_column_start[m][i] + matrix_values[m][i].size();
       }
-      const unsigned entries = row_or_column_start[m][ndof];
+      const unsigned long entries = row_or_column_start[m][ndof];
 
       // resize vectors
       column_or_row_index[m] = new int[entries];
@@ -6023,7 +6472,7 @@ namespace oomph
         // Loop over all the entries in the vectors corresponding to the given
         // row or column. It will NOT be ordered
         unsigned p = 0;
-        for (int j = row_or_column_start[m][i_global];
+        for (SparseOffset j = row_or_column_start[m][i_global];
              j < row_or_column_start[m][i_global + 1];
              j++)
         {
@@ -6060,9 +6509,9 @@ namespace oomph
   //=====================================================================
   void Problem::sparse_assemble_row_or_column_compressed_with_two_arrays(
     Vector<int*>& column_or_row_index,
-    Vector<int*>& row_or_column_start,
+    Vector<SparseOffset*>& row_or_column_start,
     Vector<double*>& value,
-    Vector<unsigned>& nnz,
+    Vector<unsigned long>& nnz,
     Vector<double*>& residuals,
     bool compressed_row_flag)
   {
@@ -6445,7 +6894,7 @@ namespace oomph
     for (unsigned m = 0; m < n_matrix; m++)
     {
       // Set the number of rows or columns
-      row_or_column_start[m] = new int[ndof + 1];
+      row_or_column_start[m] = new SparseOffset[ndof + 1];
 
       // fill row_or_column_start and find the number of entries
       row_or_column_start[m][0] = 0;
@@ -6454,7 +6903,7 @@ namespace oomph
         row_or_column_start[m][i + 1] = row_or_column_start[m][i] + ncoef[m][i];
         Sparse_assemble_with_arrays_previous_allocation[m][i] = ncoef[m][i];
       }
-      const unsigned entries = row_or_column_start[m][ndof];
+      const unsigned long entries = row_or_column_start[m][ndof];
 
       // resize vectors
       column_or_row_index[m] = new int[entries];
@@ -6473,7 +6922,7 @@ namespace oomph
         // Loop over all the entries in the vectors corresponding to the given
         // row or column. It will NOT be ordered
         unsigned p = 0;
-        for (int j = row_or_column_start[m][i_global];
+        for (SparseOffset j = row_or_column_start[m][i_global];
              j < row_or_column_start[m][i_global + 1];
              j++)
         {
@@ -6558,7 +7007,7 @@ namespace oomph
     Vector<int*>& column_indices,
     Vector<int*>& row_start,
     Vector<double*>& values,
-    Vector<unsigned>& nnz,
+    Vector<unsigned long>& nnz,
     Vector<double*>& residuals)
   {
     // Time assembly
@@ -7475,7 +7924,7 @@ namespace oomph
     for (unsigned m = 0; m < n_matrix; m++)
     {
       // allocate row_start
-      row_start[m] = new int[target_nrow_local + 1];
+      row_start[m] = new SparseOffset[target_nrow_local + 1];
       row_start[m][0] = 0;
 
       // initially allocate storage based on the maximum number of non-zeros
@@ -8428,9 +8877,9 @@ namespace oomph
 
     // Prepare the storage formats.
     Vector<int*> column_or_row_index(2);
-    Vector<int*> row_or_column_start(2);
+    Vector<SparseOffset*> row_or_column_start(2);
     Vector<double*> value(2);
-    Vector<unsigned> nnz(2);
+    Vector<unsigned long> nnz(2);
     // Allocate pointer to residuals, although not used in these problems
     Vector<double*> residuals_vectors(0);
 
@@ -8773,6 +9222,71 @@ namespace oomph
   }
 
 
+  //================================================================
+  /// Add the memory held by the problem (its mesh, global data,
+  /// dof vectors, cached affine operator and linear solver) to the
+  /// account
+  //================================================================
+  void Problem::get_memory_usage(MemoryAccount& account)
+  {
+    // The global mesh contains all nodes and elements of the submeshes
+    if (mesh_pt() != 0)
+    {
+      mesh_pt()->get_memory_usage(account);
+    }
+
+    // Global data
+    double global_data_nbyte = double(Global_data_pt.size()) * sizeof(Data*);
+    const unsigned n_global_data = Global_data_pt.size();
+    for (unsigned i = 0; i < n_global_data; i++)
+    {
+      global_data_nbyte += Global_data_pt[i]->memory_usage_in_bytes();
+    }
+    account.add("global_data", global_data_nbyte);
+
+    // Vectors indexed by the dofs
+    double dof_vector_nbyte =
+      double(Dof_pt.size()) * sizeof(double*) +
+      double(Max_res.size() + Dof_derivative.size() + Dof_current.size()) *
+        sizeof(double);
+    if (Element_count_per_dof.built())
+    {
+      dof_vector_nbyte +=
+        double(Element_count_per_dof.nrow_local()) * sizeof(double);
+    }
+#ifdef OOMPH_HAS_MPI
+    dof_vector_nbyte += double(Halo_dof_pt.size()) * sizeof(double*) +
+                        double(Elemental_assembly_time.size()) * sizeof(double);
+#endif
+    account.add("dof_vectors", dof_vector_nbyte);
+
+    // Cached affine operator
+    if (Affine_stiffness_matrix_pt != 0)
+    {
+      Affine_stiffness_matrix_pt->get_memory_usage(account,
+                                                   "affine_operator_cache");
+    }
+    if (Affine_mass_matrix_pt != 0)
+    {
+      Affine_mass_matrix_pt->get_memory_usage(account,
+                                              "affine_operator_cache");
+    }
+    if (Affine_load_vector.built())
+    {
+      account.add("affine_operator_cache",
+                  double(Affine_load_vector.nrow_local()) * sizeof(double));
+    }
+
+    // Linear solver (e.g. stored LU factors or preconditioners)
+    if (Linear_solver_pt != 0)
+    {
+      MemoryAccount linear_solver_account;
+      Linear_solver_pt->get_memory_usage(linear_solver_account);
+      account.add(linear_solver_account, "linear_solver:");
+    }
+  }
+
+
   //================================================================
   /// General Newton solver. Requires only a convergence tolerance.
   /// The linear solver takes a pointer to the problem (which defines
@@ -8787,6 +9301,10 @@ namespace oomph
     double t_start = TimingHelpers::timer();
     Max_res.clear();
 
+    // The linear solves below replace (or free) any factorisation that
+    // was kept for re-use in arc-length continuation
+    Continuation_jacobian_has_been_factorised = false;
+
     // Find total number of dofs
     unsigned long n_dofs = ndof();
 
@@ -8945,43 +9463,71 @@ namespace oomph
       // Initialise timer for linear solver
       double t_solver_start = TimingHelpers::timer();
 
-      // Now do the linear solve -- recycling Jacobian if requested
-      if (Jacobian_reuse_is_enabled && Jacobian_has_been_computed)
+      // If the Jacobian is recombined from the cached operator of a
+      // linear problem, it has only changed if the timestepper weight has
+      // changed
+      if (Jacobian_has_been_computed && Affine_operator_caching_is_enabled &&
+          (affine_operator_weight() != Affine_jacobian_weight))
       {
-        if (!Shut_up_in_newton_solve)
+        Jacobian_has_been_computed = false;
+      }
+
+      // Now do the linear solve -- recycling Jacobian if requested.
+      // Charge the time to the solve phase (if recorded); the assembly
+      // of the Jacobian and residuals charges itself to the assembly phase
+      {
+        PhaseTimer phase_timer("solve");
+        if (Jacobian_reuse_is_enabled && Jacobian_has_been_computed)
         {
-          oomph_info << "Not recomputing Jacobian! " << std::endl;
-        }
+          if (!Shut_up_in_newton_solve)
+          {
+            oomph_info << "Not recomputing Jacobian! " << std::endl;
+          }
 
-        // If we're doing the first iteration and the problem is nonlinear,
-        // the residuals have already been computed above during the
-        // initial convergence check. Otherwise compute them here.
-        if ((count != 1) || (!Problem_is_nonlinear)) get_residuals(dx);
+          // If we're doing the first iteration and the problem is
+          // nonlinear, the residuals have already been computed above
+          // during the initial convergence check. Otherwise compute them
+          // here.
+          if ((count != 1) || (!Problem_is_nonlinear)) get_residuals(dx);
 
-        // Backup residuals
-        DoubleVector resid(dx);
+          // Backup residuals
+          DoubleVector resid(dx);
 
-        // Resolve
-        Linear_solver_pt->resolve(resid, dx);
-      }
-      else
-      {
-        if (Jacobian_reuse_is_enabled)
+          // Resolve
+          Linear_solver_pt->resolve(resid, dx);
+        }
+        else
         {
-          if (!Shut_up_in_newton_solve)
+          if (Jacobian_reuse_is_enabled)
           {
-            oomph_info << "Enabling resolve" << std::endl;
+            if (!Shut_up_in_newton_solve)
+            {
+              oomph_info << "Enabling resolve" << std::endl;
+            }
+            Linear_solver_pt->enable_resolve();
           }
-          Linear_solver_pt->enable_resolve();
+          Linear_solver_pt->solve(this, dx);
+          Jacobian_has_been_computed = true;
         }
-        Linear_solver_pt->solve(this, dx);
-        Jacobian_has_been_computed = true;
       }
 
       // End of linear solver
       double t_solver_end = TimingHelpers::timer();
       total_linear_solver_time += t_solver_end - t_solver_start;
 
+      // Doc the memory usage of the problem and that of the linear
+      // solver at the peak of the solve
+      if (Doc_memory_usage_in_newton_solve)
+      {
+        MemoryAccount account;
+        get_memory_usage(account);
+        account.add(Linear_solver_pt->memory_usage_of_last_solve(),
+                    "linear_solve_peak:");
+        oomph_info << "Memory usage after linear solve in Newton step "
+                   << count << " [category bytes MB]:" << std::endl;
+        account.doc(*(oomph_info.stream_pt()), "   ");
+      }
+
       if (!Shut_up_in_newton_solve)
       {
         oomph_info << std::endl;
@@ -9406,6 +9952,9 @@ namespace oomph
 
     // Assign memory for the dot products of the uderivatives and y and z
     double uderiv_dot_y = 0.0, uderiv_dot_z = 0.0;
+    // Maximum residual before the current Newton iteration (used to decide
+    // whether a re-used factorisation of the Jacobian is still good enough)
+    double previous_maxres = 0.0;
     // Set and initialise the counter
     unsigned count = 0;
     // Set the loop flag
@@ -9481,6 +10030,8 @@ namespace oomph
           maxres = std::fabs(arc_length_constraint_residual);
         }
 
+        previous_maxres = maxres;
+
         // Find the max
         if (!Shut_up_in_newton_solve)
         {
@@ -9519,8 +10070,26 @@ namespace oomph
       // Otherwise
       else
       {
+        // Re-use the factorisation of a previous Jacobian, if allowed: the
+        // residuals are already stored in y so only a resolve is required
+        if (Jacobian_reuse_in_continuation_is_enabled &&
+            Continuation_jacobian_has_been_factorised)
+        {
+          if (!Shut_up_in_newton_solve)
+          {
+            oomph_info << "Not recomputing Jacobian! " << std::endl;
+          }
+          PhaseTimer phase_timer("solve");
+          DoubleVector input_y(y);
+          Linear_solver_pt->resolve(input_y, y);
+        }
         // Solve the standard problem
-        Linear_solver_pt->solve(this, y);
+        else
+        {
+          PhaseTimer phase_timer("solve");
+          Linear_solver_pt->solve(this, y);
+          Continuation_jacobian_has_been_factorised = true;
+        }
 
         // Get the vector dresiduals/dparameter
         z.clear();
@@ -9536,6 +10105,7 @@ namespace oomph
         // Do not clear z because we assume that it has dR/dparam
         z.clear();
         // Now resolve the system with the new RHS
+        PhaseTimer phase_timer("solve");
         Linear_solver_pt->resolve(input_z, z);
       }
 
@@ -9676,17 +10246,30 @@ namespace oomph
       // of iterations has been reached
       if ((maxres > Max_residuals) || (count == Max_newton_iterations))
       {
+        // The factorisation at the failed iterate is useless for the
+        // (smaller) step that will be tried next
+        Continuation_jacobian_has_been_factorised = false;
         throw NewtonSolverError(count, maxres);
       }
 
+      // If the iteration with the re-used Jacobian contracts too slowly,
+      // recompute the Jacobian at the current iterate
+      if (maxres >
+          Max_residual_ratio_for_continuation_jacobian_reuse * previous_maxres)
+      {
+        Continuation_jacobian_has_been_factorised = false;
+      }
+      previous_maxres = maxres;
+
     } while (LOOP_FLAG);
 
     // Now update anything that needs updating
     actions_after_newton_solve();
 
     // Reset the storage of the matrix on the linear solver to what it was
-    // on entry to this routine
-    if (enable_resolve)
+    // on entry to this routine, unless the factorisation is to be re-used
+    // at the next point on the branch
+    if (enable_resolve || Jacobian_reuse_in_continuation_is_enabled)
     {
       Linear_solver_pt->enable_resolve();
     }
@@ -9746,8 +10329,14 @@ namespace oomph
 
       // Solve the standard problem, we only want to make sure that
       // we factorise the matrix, if it has not been factorised. We shall
-      // ignore the return value of z.
-      Linear_solver_pt->solve(this, z);
+      // ignore the return value of z. There's no need to do this if
+      // we are allowed to re-use an existing factorisation.
+      if (!(Jacobian_reuse_in_continuation_is_enabled &&
+            Continuation_jacobian_has_been_factorised))
+      {
+        Linear_solver_pt->solve(this, z);
+        Continuation_jacobian_has_been_factorised = true;
+      }
 
       // Get the vector dresiduals/dparameter
       get_derivative_wrt_global_parameter(parameter_pt, z);
@@ -9761,8 +10350,9 @@ namespace oomph
       // Now resolve the system with the new RHS and overwrite the solution
       Linear_solver_pt->resolve(input_z, z);
 
-      // Restore the storage status of the linear solver
-      if (enable_resolve)
+      // Restore the storage status of the linear solver (unless the
+      // factorisation is to be re-used)
+      if (enable_resolve || Jacobian_reuse_in_continuation_is_enabled)
       {
         Linear_solver_pt->enable_resolve();
       }
@@ -11122,6 +11712,9 @@ namespace oomph
       reject_timestep = 0;
       double dt_rescaling_factor = 1.0;
 
+      // Is the estimated temporal error within the tolerance?
+      bool error_within_tolerance = false;
+
       // Set the new time and value of dt
       time_pt()->time() += dt_actual;
       time_pt()->dt() = dt_actual;
@@ -11209,8 +11802,9 @@ namespace oomph
         double error = std::max(std::abs(global_temporal_error_norm()), 1e-12);
 
         // Calculate the scaling  factor
-        dt_rescaling_factor = std::pow(
-          (epsilon / error), (1.0 / (1.0 + time_stepper_pt()->order())));
+        dt_rescaling_factor =
+          time_stepper_pt()->dt_rescaling_factor(this, error, epsilon);
+        error_within_tolerance = (error <= epsilon);
 
         oomph_info << "Timestep scaling factor is  " << dt_rescaling_factor
                    << std::endl;
@@ -11261,8 +11855,11 @@ namespace oomph
         new_dt_candidate = DTSF_max_increase * dt_actual;
       }
       // If we have already rejected the timestep then don't do this check
-      // because DTSF will definitely be too small.
-      else if ((!reject_timestep) && (dt_rescaling_factor <= DTSF_min_decrease))
+      // because DTSF will definitely be too small. Also don't reject
+      // a timestep whose error is within the tolerance only because the
+      // timestepper's controller wants to reduce the next timestep.
+      else if ((!reject_timestep) && (!error_within_tolerance) &&
+               (dt_rescaling_factor <= DTSF_min_decrease))
       {
         // Handle this special case where we want to continue anyway (usually
         // Minimum_dt_but_still_proceed = -1 so this has no effect).
@@ -11314,6 +11911,12 @@ namespace oomph
         dt_actual = new_dt_candidate;
       }
 
+      // Tell the timesteppers whether the timestep has been accepted
+      for (unsigned i = 0; i < n_time_steppers; i++)
+      {
+        time_stepper_pt(i)->actions_after_timestep_acceptance_check(
+          this, !reject_timestep);
+      }
 
       actions_after_implicit_timestep_and_error_estimation();
 
@@ -13660,6 +14263,10 @@ namespace oomph
   //======================================================================
   void Problem::adapt(unsigned& n_refined, unsigned& n_unrefined)
   {
+    // Charge the time to the adaptation phase (if recorded); this
+    // includes the reassignment of the equation numbers
+    PhaseTimer phase_timer("adapt");
+
     double t_start_total = 0.0;
     if (Global_timings::Doc_comprehensive_timings)
     {
@@ -15441,6 +16048,9 @@ namespace oomph
                                      DocInfo& doc_info,
                                      const bool& prune)
   {
+    // Charge the time to the adaptation phase (if recorded)
+    PhaseTimer phase_timer("adapt");
+
     double t_start = 0.0;
     if (Global_timings::Doc_comprehensive_timings)
     {
@@ -87,6 +87,9 @@ namespace oomph
   // Forward definition for sum of matrices class
   class SumOfMatrices;
 
+  // Forward definition for block compressed row matrices
+  class BlockCRDoubleMatrix;
+
   /// //////////////////////////////////////////////////////////////////
   /// //////////////////////////////////////////////////////////////////
   /// //////////////////////////////////////////////////////////////////
@@ -161,6 +164,14 @@ namespace oomph
     friend class AugmentedBlockPitchForkLinearSolver;
     friend class BlockHopfLinearSolver;
 
+    // The variable-order BDF timestepper needs to evaluate the global
+    // temporal error norm for its order selection
+    friend class VariableOrderBDF;
+
+    // The POD-Galerkin reduced-order model calls the actions_... functions
+    // around its own (reduced) Newton solves
+    friend class PODGalerkinModel;
+
 
   private:
     /// The mesh pointer
@@ -228,6 +239,34 @@ namespace oomph
     /// Use values from the time stepper predictor as an initial guess
     bool Use_predictor_values_as_initial_guess;
 
+    /// Is caching of the (affine) operator of a linear problem enabled?
+    /// Default: false
+    bool Affine_operator_caching_is_enabled;
+
+    /// Are the residuals of the linear problem to be computed from the
+    /// cached operator (and the cached, constant load vector)?
+    /// Default: false
+    bool Affine_operator_load_is_constant;
+
+    /// Pointer to the cached "stiffness" matrix, i.e. the Jacobian
+    /// without the contributions from the time derivatives. Stored with
+    /// the same sparsity pattern as the cached mass matrix.
+    CRDoubleMatrix* Affine_stiffness_matrix_pt;
+
+    /// Pointer to the cached "mass" matrix, i.e. the derivative of the
+    /// residuals with respect to the first time derivatives of the
+    /// unknowns. Null if the cache was set up while all timesteppers were
+    /// steady (e.g. during a steady solve); the cache is then set up
+    /// again as soon as a timestepper is no longer steady.
+    CRDoubleMatrix* Affine_mass_matrix_pt;
+
+    /// Cached load vector, i.e. the steady residuals for zero unknowns
+    DoubleVector Affine_load_vector;
+
+    /// Timestepper weight for the time derivative that was used
+    /// when the Jacobian was last recombined from the cached operator
+    double Affine_jacobian_weight;
+
   protected:
     /// Vector of pointers to copies of the problem used in adaptive
     /// bifurcation tracking problems (ALH: TEMPORARY HACK, WILL BE FIXED)
@@ -359,9 +398,9 @@ namespace oomph
     /// This version uses vectors of pairs.
     virtual void sparse_assemble_row_or_column_compressed_with_vectors_of_pairs(
       Vector<int*>& column_or_row_index,
-      Vector<int*>& row_or_column_start,
+      Vector<SparseOffset*>& row_or_column_start,
       Vector<double*>& value,
-      Vector<unsigned>& nnz,
+      Vector<unsigned long>& nnz,
       Vector<double*>& residual,
       bool compressed_row_flag);
 
@@ -372,9 +411,9 @@ namespace oomph
     /// This version uses two vectors.
     virtual void sparse_assemble_row_or_column_compressed_with_two_vectors(
       Vector<int*>& column_or_row_index,
-      Vector<int*>& row_or_column_start,
+      Vector<SparseOffset*>& row_or_column_start,
       Vector<double*>& value,
-      Vector<unsigned>& nnz,
+      Vector<unsigned long>& nnz,
       Vector<double*>& residual,
       bool compressed_row_flag);
 
@@ -385,9 +424,9 @@ namespace oomph
     /// This version uses maps
     virtual void sparse_assemble_row_or_column_compressed_with_maps(
       Vector<int*>& column_or_row_index,
-      Vector<int*>& row_or_column_start,
+      Vector<SparseOffset*>& row_or_column_start,
       Vector<double*>& value,
-      Vector<unsigned>& nnz,
+      Vector<unsigned long>& nnz,
       Vector<double*>& residual,
       bool compressed_row_flag);
 
@@ -398,9 +437,9 @@ namespace oomph
     /// This version uses lists
     virtual void sparse_assemble_row_or_column_compressed_with_lists(
       Vector<int*>& column_or_row_index,
-      Vector<int*>& row_or_column_start,
+      Vector<SparseOffset*>& row_or_column_start,
       Vector<double*>& value,
-      Vector<unsigned>& nnz,
+      Vector<unsigned long>& nnz,
       Vector<double*>& residual,
       bool compressed_row_flag);
 
@@ -411,9 +450,9 @@ namespace oomph
     /// This version uses lists
     virtual void sparse_assemble_row_or_column_compressed_with_two_arrays(
       Vector<int*>& column_or_row_index,
-      Vector<int*>& row_or_column_start,
+      Vector<SparseOffset*>& row_or_column_start,
       Vector<double*>& value,
-      Vector<unsigned>& nnz,
+      Vector<unsigned long>& nnz,
       Vector<double*>& residual,
       bool compressed_row_flag);
 
@@ -475,9 +514,9 @@ namespace oomph
     void parallel_sparse_assemble(
       const LinearAlgebraDistribution* const& dist_pt,
       Vector<int*>& column_or_row_index,
-      Vector<int*>& row_or_column_start,
+      Vector<SparseOffset*>& row_or_column_start,
       Vector<double*>& value,
-      Vector<unsigned>& nnz,
+      Vector<unsigned long>& nnz,
       Vector<double*>& residuals);
 
     /// A private helper function to
@@ -621,6 +660,10 @@ namespace oomph
     /// if required)? Default: false
     bool Jacobian_has_been_computed;
 
+    /// Doc the memory usage (see get_memory_usage(...)) after each
+    /// linear solve in the Newton iteration? Default: false
+    bool Doc_memory_usage_in_newton_solve;
+
     /// Boolean flag indicating if we're dealing with a linear or
     /// nonlinear Problem -- if set to false the Newton solver will not check
     /// the residual before or after the linear solve. Set to true by default;
@@ -676,9 +719,9 @@ namespace oomph
     /// if we want compressed row format (true) or compressed column.
     virtual void sparse_assemble_row_or_column_compressed(
       Vector<int*>& column_or_row_index,
-      Vector<int*>& row_or_column_start,
+      Vector<SparseOffset*>& row_or_column_start,
       Vector<double*>& value,
-      Vector<unsigned>& nnz,
+      Vector<unsigned long>& nnz,
       Vector<double*>& residual,
       bool compressed_row_flag);
 
@@ -802,6 +845,21 @@ namespace oomph
     /// derivatievs
     bool Use_finite_differences_for_continuation_derivatives;
 
+    /// Is re-use of the factorised Jacobian in the bordered Newton
+    /// iteration of arc-length continuation enabled? Default: false
+    bool Jacobian_reuse_in_continuation_is_enabled;
+
+    /// Is there a factorisation of the Jacobian (from a previous
+    /// iteration, possibly at a previous point on the branch) stored in
+    /// the linear solver that can be re-used during continuation?
+    bool Continuation_jacobian_has_been_factorised;
+
+    /// When the factorised Jacobian is re-used during continuation,
+    /// it is recomputed (at the current iterate) as soon as a Newton
+    /// iteration fails to reduce the maximum residual by at least this
+    /// factor. Default: 0.25
+    double Max_residual_ratio_for_continuation_jacobian_reuse;
+
   public:
     /// If we have MPI return the "problem has been distributed" flag,
     /// otherwise it can't be distributed so return false.
@@ -1874,6 +1932,24 @@ namespace oomph
     virtual void get_jacobian(DoubleVector& residuals,
                               CCDoubleMatrix& jacobian);
 
+    /// Return the fully-assembled Jacobian and residuals for the
+    /// problem. Interface for the case when the Jacobian is in block
+    /// compressed row storage format, using the block size that has been
+    /// specified in the matrix. The Jacobian is assembled in row-compressed
+    /// format and converted, so the nodal blocks are only captured if the
+    /// unknowns are numbered node by node, with block-size unknowns per node.
+    /// assign_eqn_numbers() only produces this numbering if every node
+    /// stores block-size values that are either all pinned or all unpinned;
+    /// a single partially pinned node (or a node with extra values, such as
+    /// the vertex pressures in Taylor-Hood elements) shifts the block
+    /// boundaries for all subsequent unknowns. The matrix is still correct
+    /// but blocks that straddle two nodes contain explicitly stored zeros,
+    /// which reduces the storage savings. The block size must divide the
+    /// number of degrees of freedom (an error is thrown otherwise) and the
+    /// Jacobian must not be distributed.
+    virtual void get_jacobian(DoubleVector& residuals,
+                              BlockCRDoubleMatrix& jacobian);
+
     /// Dummy virtual function that must be overloaded by the problem to
     /// specify which matrices should be summed to give the final Jacobian.
     virtual void get_jacobian(DoubleVector& residuals, SumOfMatrices& jacobian)
@@ -1991,6 +2067,106 @@ namespace oomph
       return Jacobian_reuse_is_enabled;
     }
 
+    /// Enable re-use of the factorised Jacobian in the Newton iteration
+    /// of arc-length continuation (if the linear solver allows resolves).
+    /// The bordered system is then solved by two resolves with the stored
+    /// factorisation (for the residuals and for dR/dparameter), which is
+    /// only recomputed if the iteration contracts too slowly (see
+    /// Max_residual_ratio_for_continuation_jacobian_reuse), after a failed
+    /// step, or after the equation numbers have changed. The factorisation
+    /// is carried over from one point on the branch to the next, which
+    /// pays off if the factorisation dominates the cost of the Newton
+    /// iteration. Since more (but cheaper) iterations are taken, consider
+    /// increasing Desired_newton_iterations_ds. The solution of
+    /// J z = dR/dparameter with an out-of-date Jacobian is a poor
+    /// approximation to the tangent to the branch near folds, so the
+    /// continuation derivatives are best computed by finite differences
+    /// (secant predictor; see
+    /// Use_finite_differences_for_continuation_derivatives). Bifurcation
+    /// detection picks up the sign of the Jacobian only when it is
+    /// refactorised.
+    void enable_jacobian_reuse_in_continuation()
+    {
+      Jacobian_reuse_in_continuation_is_enabled = true;
+      Continuation_jacobian_has_been_factorised = false;
+    }
+
+    /// Disable re-use of the factorised Jacobian in continuation
+    void disable_jacobian_reuse_in_continuation()
+    {
+      Jacobian_reuse_in_continuation_is_enabled = false;
+      Continuation_jacobian_has_been_factorised = false;
+    }
+
+    /// Is re-use of the factorised Jacobian in continuation enabled?
+    bool jacobian_reuse_in_continuation_is_enabled() const
+    {
+      return Jacobian_reuse_in_continuation_is_enabled;
+    }
+
+    /// Doc the memory usage of the problem after each linear solve in
+    /// the Newton iteration, together with that of the linear solver at
+    /// the peak of the solve (see LinearSolver::memory_usage_of_last_solve())
+    void enable_doc_memory_usage_in_newton_solve()
+    {
+      Doc_memory_usage_in_newton_solve = true;
+    }
+
+    /// Don't doc the memory usage in the Newton iteration (the default)
+    void disable_doc_memory_usage_in_newton_solve()
+    {
+      Doc_memory_usage_in_newton_solve = false;
+    }
+
+    /// Add the memory held by the problem to the account: that held by
+    /// the (global) mesh (see Mesh::get_memory_usage(...)), the global
+    /// data ("global_data"), the vectors of pointers to and values of the
+    /// dofs ("dof_vectors"), the cached affine operator (if any;
+    /// "affine_operator_cache") and that currently held by the linear
+    /// solver (categories prefixed by "linear_solver:"). Only the storage
+    /// whose size scales with the problem size is counted.
+    void get_memory_usage(MemoryAccount& account);
+
+    /// Enable caching of the operator of a linear problem whose time
+    /// derivatives are discretised by a single (first-order) timestepper,
+    /// such as BDF<NSTEPS>. The Jacobian J = K + w M is then recombined
+    /// from the "stiffness" and "mass" matrices, K and M, which are
+    /// assembled once; w is the timestepper's weight for the current value
+    /// in the first time derivative, so J changes with the timestep and
+    /// the order of the scheme. If load_is_constant is true, the residuals
+    /// are also computed from the cached matrices (and the steady
+    /// residuals for zero unknowns) by sparse matrix-vector products,
+    /// bypassing the element assembly altogether; this is only correct if
+    /// the source functions and the boundary conditions do not vary
+    /// with time. Otherwise the residuals are assembled as usual.
+    /// If recycling of the Jacobian is enabled too, the Jacobian (and its
+    /// factorisation) is only recomputed when w changes. The cached
+    /// matrices are wiped when the equation numbers are re-assigned;
+    /// call this function again after changing any parameters of the
+    /// problem.
+    void enable_affine_operator_caching(const bool& load_is_constant = false)
+    {
+      clear_affine_operator_cache();
+      Affine_operator_caching_is_enabled = true;
+      Affine_operator_load_is_constant = load_is_constant;
+      Jacobian_has_been_computed = false;
+    }
+
+    /// Disable caching of the operator of a linear problem
+    void disable_affine_operator_caching()
+    {
+      clear_affine_operator_cache();
+      Affine_operator_caching_is_enabled = false;
+      Affine_operator_load_is_constant = false;
+      Jacobian_has_been_computed = false;
+    }
+
+    /// Is caching of the operator of a linear problem enabled?
+    bool affine_operator_caching_is_enabled() const
+    {
+      return Affine_operator_caching_is_enabled;
+    }
+
     bool& use_predictor_values_as_initial_guess()
     {
       return Use_predictor_values_as_initial_guess;
@@ -2021,6 +2197,35 @@ namespace oomph
       double& half_residual_squared,
       const double& stpmax);
 
+    /// Return the (only) non-steady timestepper whose weights enter
+    /// the cached operator of a linear problem (null if all timesteppers
+    /// are steady)
+    TimeStepper* affine_operator_time_stepper_pt() const;
+
+    /// Timestepper weight for the current value in the first time
+    /// derivative (zero if all timesteppers are steady)
+    double affine_operator_weight() const;
+
+    /// Assemble the stiffness and mass matrices and the load vector of
+    /// a linear problem
+    void setup_affine_operator_cache();
+
+    /// Set up the cached operator of a linear problem if it hasn't been
+    /// set up yet, or if its mass matrix is required but is missing
+    /// because the cache was set up while all timesteppers were steady
+    void setup_affine_operator_cache_if_required();
+
+    /// Wipe the cached operator of a linear problem
+    void clear_affine_operator_cache();
+
+    /// Compute the residuals of a linear problem from the cached operator
+    void get_affine_residuals(DoubleVector& residuals);
+
+    /// Recombine the Jacobian of a linear problem from the cached
+    /// operator; also get the residuals
+    void get_affine_jacobian(DoubleVector& residuals,
+                             CRDoubleMatrix& jacobian);
+
   public:
     /// Adaptive Newton solve: up to max_adapt adaptations of all
     /// refineable submeshes are performed to achieve the
@@ -2414,6 +2619,7 @@ namespace oomph
       Parameter_derivative = 1.0;
       First_jacobian_sign_change = false;
       Arc_length_step_taken = false;
+      Continuation_jacobian_has_been_factorised = false;
       Dof_derivative.resize(0);
     }
 
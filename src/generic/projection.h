@@ -744,6 +744,20 @@ namespace oomph
       Use_iterative_solver_for_projection = false;
     }
 
+    /// Enable documentation of timings for the assembly/setup
+    /// of the projection matrices and the (re-)solves
+    void enable_timings_projection()
+    {
+      Doc_timings_projection = true;
+    }
+
+    /// Disable documentation of timings for the assembly/setup
+    /// of the projection matrices and the (re-)solves
+    void disable_timings_projection()
+    {
+      Doc_timings_projection = false;
+    }
+
     /// Project from base into the problem's own mesh.
     void project(Mesh* base_mesh_pt, const bool& dont_project_positions = false)
     {
@@ -913,6 +927,11 @@ namespace oomph
       }
       t_start = TimingHelpers::timer();
 
+      // Reset the timers and counters for the projection solves
+      T_projection_matrix_setup = 0.0;
+      T_projection_resolve = 0.0;
+      Nprojection_matrix_setup = 0;
+      Nprojection_resolve = 0;
 
       // Let us first pin every degree of freedom
       // We shall unpin selected dofs for each different projection problem
@@ -957,14 +976,20 @@ namespace oomph
             // Set the coordinate for projection
             this->set_lagrangian_coordinate_for_projection(i);
 
-            // Assign equation number
-            unsigned ndof_tmp = assign_eqn_numbers();
-            if (!Output_during_projection_suppressed)
+            // Assign equation numbers (only once: the unknowns, and
+            // hence the mass matrix, are the same for all Lagrangian
+            // coordinates)
+            if (i == 0)
             {
-              oomph_info << "Number of equations for projection of Lagrangian "
-                            "coordinate "
-                         << " : " << ndof_tmp << std::endl
-                         << std::endl;
+              unsigned ndof_tmp = assign_eqn_numbers();
+              if (!Output_during_projection_suppressed)
+              {
+                oomph_info
+                  << "Number of equations for projection of Lagrangian "
+                     "coordinate "
+                  << " : " << ndof_tmp << std::endl
+                  << std::endl;
+              }
             }
 
 
@@ -988,8 +1013,10 @@ namespace oomph
             }
 
 
-            // Projection and interpolation
-            Problem::newton_solve();
+            // Projection and interpolation; only the right-hand side
+            // changes between the Lagrangian coordinates so re-use the
+            // mass matrix
+            solve_for_projection(i > 0);
 
             // Move values back into Lagrangian coordinate for all nodes
             unsigned n_node = Problem::mesh_pt()->nnode();
@@ -1062,6 +1089,16 @@ namespace oomph
               this->set_coordinate_for_projection(i);
               this->unpin_dofs_of_coordinate(i);
 
+              // Assign equation numbers
+              unsigned ndof_tmp = assign_eqn_numbers();
+              if (!Output_during_projection_suppressed)
+              {
+                oomph_info
+                  << "Number of equations for projection of coordinate " << i
+                  << " : " << ndof_tmp << std::endl
+                  << std::endl;
+              }
+
               // Loop over number of history values, beginning with the latest
               // one. Don't deal with current time.
               for (unsigned h_tim = n_history_values; h_tim > 1; h_tim--)
@@ -1071,19 +1108,11 @@ namespace oomph
                 // Set time_level we are dealing with
                 this->set_time_level_for_projection(time_level);
 
-                // Assign equation number
-                unsigned ndof_tmp = assign_eqn_numbers();
-                if (!Output_during_projection_suppressed)
-                {
-                  oomph_info
-                    << "Number of equations for projection of coordinate " << i
-                    << " at time level " << time_level << " : " << ndof_tmp
-                    << std::endl
-                    << std::endl;
-                }
-
-                // Projection and interpolation
-                Problem::newton_solve();
+                // Projection and interpolation. All position dofs of
+                // the i-th coordinate are free so the mass matrix is the
+                // same for all coordinates and time levels: only assemble
+                // (and factorise) it for the very first solve.
+                solve_for_projection((i > 0) || (h_tim != n_history_values));
 
                 // Move values back into history value of coordinate
                 unsigned n_node = Problem::mesh_pt()->nnode();
@@ -1183,6 +1212,20 @@ namespace oomph
               // Set the coordinate for projection
               this->set_coordinate_for_projection(i);
 
+              // Assign equation numbers (the unknowns are the values of
+              // field 0 for all coordinates so this only needs doing once)
+              if (i == 0)
+              {
+                unsigned ndof_tmp = assign_eqn_numbers();
+                if (!Output_during_projection_suppressed)
+                {
+                  oomph_info
+                    << "Number of equations for projection of coordinates : "
+                    << ndof_tmp << std::endl
+                    << std::endl;
+                }
+              }
+
               // Loop over number of history values, beginning with the latest
               // one. Don't deal with current time.
               for (unsigned h_tim = n_history_values; h_tim > 1; h_tim--)
@@ -1192,19 +1235,9 @@ namespace oomph
                 // Set time_level we are dealing with
                 this->set_time_level_for_projection(time_level);
 
-                // Assign equation number
-                unsigned ndof_tmp = assign_eqn_numbers();
-                if (!Output_during_projection_suppressed)
-                {
-                  oomph_info
-                    << "Number of equations for projection of coordinate " << i
-                    << " at time level " << time_level << " : " << ndof_tmp
-                    << std::endl
-                    << std::endl;
-                }
-
-                // Projection and interpolation
-                Problem::newton_solve();
+                // Projection and interpolation; the mass matrix is the
+                // same for all coordinates and time levels
+                solve_for_projection((i > 0) || (h_tim != n_history_values));
 
                 // Move values back into history value of coordinate
                 unsigned n_element = Problem::mesh_pt()->nelement();
@@ -1247,6 +1280,13 @@ namespace oomph
         el_pt->set_project_values();
       }
 
+      // Field whose mass matrix is currently stored (and factorised or
+      // preconditioned) in the linear solver; negative if none. Fields
+      // that are interpolated in the same way (e.g. the velocity
+      // components in Navier-Stokes elements) share the mass matrix
+      // so it only has to be assembled once for all of them.
+      int field_of_stored_mass_matrix = -1;
+
       // Loop over fields
       for (unsigned fld = 0; fld < n_fields; fld++)
       {
@@ -1258,6 +1298,28 @@ namespace oomph
         this->set_current_field_for_projection(fld);
         this->unpin_dofs_of_field(fld);
 
+        // Can we re-use the mass matrix from a previous field?
+        bool reuse_mass_matrix = false;
+        if (field_of_stored_mass_matrix >= 0)
+        {
+          reuse_mass_matrix = fields_share_interpolation(
+            fld, unsigned(field_of_stored_mass_matrix));
+        }
+
+        // Assign equation numbers (the same for all time levels)
+        unsigned ndof_tmp = assign_eqn_numbers();
+        if (!Output_during_projection_suppressed)
+        {
+          oomph_info << "Number of equations for projection of field " << fld
+                     << " : " << ndof_tmp << std::endl;
+          if (reuse_mass_matrix)
+          {
+            oomph_info << "Re-using mass matrix of field "
+                       << field_of_stored_mass_matrix << std::endl;
+          }
+          oomph_info << std::endl;
+        }
+
         // Check number of history values
         n_history_values =
           dynamic_cast<PROJECTABLE_ELEMENT*>(Problem::mesh_pt()->element_pt(0))
@@ -1279,18 +1341,11 @@ namespace oomph
           // Set time_level we are dealing with
           this->set_time_level_for_projection(time_level);
 
-          // Assign equation number
-          unsigned ndof_tmp = assign_eqn_numbers();
-          if (!Output_during_projection_suppressed)
-          {
-            oomph_info << "Number of equations for projection of field " << fld
-                       << " at time level " << time_level << " : " << ndof_tmp
-                       << std::endl
-                       << std::endl;
-          }
-
-          // Projection and interpolation
-          Problem::newton_solve();
+          // Projection and interpolation: only the right-hand side
+          // changes between the time levels
+          solve_for_projection(reuse_mass_matrix ||
+                               (h_tim != n_history_values));
+          field_of_stored_mass_matrix = fld;
 
           // Move computed values into the required time-level (not needed
           // for  current values which are done last -- they simply
@@ -1319,6 +1374,20 @@ namespace oomph
 
       } // End of loop over fields
 
+      // Wipe the stored mass matrix (and its factorisation)
+      linear_solver_pt()->disable_resolve();
+
+      if (Doc_timings_projection)
+      {
+        oomph_info << "CPU for assembly and setup of " << Nprojection_matrix_setup
+                   << " projection matrices: " << T_projection_matrix_setup
+                   << std::endl;
+        oomph_info << "CPU for " << Nprojection_resolve
+                   << " re-solves with stored projection matrices: "
+                   << T_projection_resolve << std::endl;
+        oomph_info << "CPU for projection solves (TOTAL): "
+                   << TimingHelpers::timer() - t_start << std::endl;
+      }
 
       // Reset parameters of external storage and interactions
       for (unsigned e = 0; e < n_element; e++)
@@ -1400,6 +1469,13 @@ namespace oomph
       // Initialise the pointer to the solver and the preconditioner
       Iterative_solver_projection_pt = 0;
       Preconditioner_projection_pt = 0;
+
+      // By default don't document the timings
+      Doc_timings_projection = false;
+      T_projection_matrix_setup = 0.0;
+      T_projection_resolve = 0.0;
+      Nprojection_matrix_setup = 0;
+      Nprojection_resolve = 0;
     }
 
     // Destructor
@@ -1420,6 +1496,98 @@ namespace oomph
     }
 
 
+    /// Solve the (linear) projection problem for the current
+    /// right-hand side and update the unknowns. If reuse_matrix is true
+    /// the mass matrix (and its factorisation or preconditioner) stored
+    /// by the linear solver during a previous call is re-used and only
+    /// the residuals are assembled; otherwise the mass matrix is
+    /// assembled and kept for subsequent re-solves.
+    void solve_for_projection(const bool& reuse_matrix)
+    {
+      double t_start = TimingHelpers::timer();
+
+      // Storage for the correction
+      DoubleVector dx;
+
+      if (reuse_matrix)
+      {
+        // Get the residuals (i.e. the right-hand side) for the current
+        // field/time level and re-solve with the stored matrix
+        DoubleVector resid;
+        get_residuals(resid);
+        linear_solver_pt()->resolve(resid, dx);
+
+        T_projection_resolve += TimingHelpers::timer() - t_start;
+        Nprojection_resolve++;
+      }
+      else
+      {
+        // Assemble the mass matrix and the residuals, solve, and
+        // keep whatever is required for subsequent re-solves
+        linear_solver_pt()->enable_resolve();
+        linear_solver_pt()->solve(this, dx);
+
+        T_projection_matrix_setup += TimingHelpers::timer() - t_start;
+        Nprojection_matrix_setup++;
+      }
+
+      // The problem is linear so a single "Newton" update yields the
+      // solution, irrespective of the current values of the unknowns
+      dx.redistribute(dof_distribution_pt());
+      double* dx_pt = dx.values_pt();
+      unsigned ndof_local = dof_distribution_pt()->nrow_local();
+      for (unsigned l = 0; l < ndof_local; l++)
+      {
+        *Dof_pt[l] -= dx_pt[l];
+      }
+
+#ifdef OOMPH_HAS_MPI
+      // Synchronise the solution on different processors
+      this->synchronise_all_dofs();
+#endif
+    }
+
+    /// Check if fields fld and other_fld are interpolated in the
+    /// same way, i.e. if they are represented by the same Data in every
+    /// element (albeit by different values within it). If so, the
+    /// mass matrices (and equation numbering) of the two projection
+    /// problems are identical.
+    bool fields_share_interpolation(const unsigned& fld,
+                                    const unsigned& other_fld)
+    {
+      unsigned n_element = Problem::mesh_pt()->nelement();
+      for (unsigned e = 0; e < n_element; e++)
+      {
+        PROJECTABLE_ELEMENT* el_pt =
+          dynamic_cast<PROJECTABLE_ELEMENT*>(Problem::mesh_pt()->element_pt(e));
+
+        // Different number of shape functions?
+        if (el_pt->nvalue_of_field(fld) != el_pt->nvalue_of_field(other_fld))
+        {
+          return false;
+        }
+
+        Vector<std::pair<Data*, unsigned>> data =
+          el_pt->data_values_of_field(fld);
+        Vector<std::pair<Data*, unsigned>> other_data =
+          el_pt->data_values_of_field(other_fld);
+
+        unsigned d_size = data.size();
+        if (d_size != other_data.size())
+        {
+          return false;
+        }
+        for (unsigned d = 0; d < d_size; d++)
+        {
+          if (data[d].first != other_data[d].first)
+          {
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+
     /// Helper function to store positions (the only things that
     /// have been set before doing projection
     void store_positions()
@@ -1809,6 +1977,22 @@ namespace oomph
 
     // The preconditioner for the solver
     Preconditioner* Preconditioner_projection_pt;
+
+    /// Flag to document the timings of the projection solves
+    bool Doc_timings_projection;
+
+    /// Accumulated time for assembly and setup (factorisation or
+    /// preconditioner setup) of the projection matrices
+    double T_projection_matrix_setup;
+
+    /// Accumulated time for the re-solves with stored projection matrices
+    double T_projection_resolve;
+
+    /// Number of projection matrices that were assembled and set up
+    unsigned Nprojection_matrix_setup;
+
+    /// Number of re-solves with stored projection matrices
+    unsigned Nprojection_resolve;
   };
 
 
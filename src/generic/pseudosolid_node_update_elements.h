@@ -124,6 +124,19 @@ namespace oomph
       SOLID::fill_in_contribution_to_residuals(residuals);
     }
 
+    /// Final override for the products of the Hessian with the vectors
+    /// Y and C: The residuals of the BASIC equations depend on the nodal
+    /// positions, so the contributions of the underlying element types
+    /// would be incomplete. Use the (broken) default.
+    void fill_in_contribution_to_hessian_vector_products(
+      Vector<double> const& Y,
+      DenseMatrix<double> const& C,
+      DenseMatrix<double>& product)
+    {
+      FiniteElement::fill_in_contribution_to_hessian_vector_products(
+        Y, C, product);
+    }
+
     /// Final override for jacobian function: Contributions are
     /// included from both the underlying element types
     void fill_in_contribution_to_jacobian(Vector<double>& residuals,
@@ -651,6 +664,17 @@ namespace oomph
       SOLID::fill_in_contribution_to_residuals(residuals);
     }
 
+    /// Final override for the products of the Hessian with the vectors
+    /// Y and C: Use the (broken) default, as in the non-refineable version.
+    void fill_in_contribution_to_hessian_vector_products(
+      Vector<double> const& Y,
+      DenseMatrix<double> const& C,
+      DenseMatrix<double>& product)
+    {
+      FiniteElement::fill_in_contribution_to_hessian_vector_products(
+        Y, C, product);
+    }
+
     /// Final override for jacobian function: Calls get_jacobian() for
     /// both of the underlying element types
     void fill_in_contribution_to_jacobian(Vector<double>& residuals,
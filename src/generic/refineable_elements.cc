@@ -457,6 +457,9 @@ namespace oomph
       }
 
 
+      // Build the constraint matrix from the local equation numbers
+      setup_hanging_constraint_matrix();
+
       // If there are no hanging_eqn_numbers delete the (empty) stored maps
       if (!hanging_eqn_numbers)
       {
@@ -514,6 +517,156 @@ namespace oomph
     } // End of if nodes
   }
 
+  //=======================================================================
+  /// Build the hanging-node constraint matrix for all continuously
+  /// interpolated values: for each value and local node, list the local
+  /// equation numbers (and weights) of the unknowns that determine the
+  /// nodal value, i.e. the node itself if it's not hanging, or its
+  /// master nodes if it is.
+  //=======================================================================
+  void RefineableElement::setup_hanging_constraint_matrix()
+  {
+    // Find the number of nodes and continuously interpolated values
+    const unsigned n_node = nnode();
+    const unsigned n_cont_values = ncont_interpolated_values();
+
+    Constraint_start.resize(n_cont_values);
+    Constraint_local_eqn.resize(n_cont_values);
+    Constraint_weight.resize(n_cont_values);
+
+    // Loop over the values
+    for (unsigned j = 0; j < n_cont_values; j++)
+    {
+      Constraint_start[j].resize(n_node + 1);
+      Constraint_local_eqn[j].clear();
+      Constraint_weight[j].clear();
+      Constraint_start[j][0] = 0;
+
+      // Loop over the nodes
+      for (unsigned n = 0; n < n_node; n++)
+      {
+        Node* nod_pt = node_pt(n);
+
+        // If the node is hanging in value j, its value is determined
+        // by the master nodes
+        if (nod_pt->is_hanging(j))
+        {
+          HangInfo* hang_info_pt = nod_pt->hanging_pt(j);
+          unsigned n_master = hang_info_pt->nmaster();
+          for (unsigned m = 0; m < n_master; m++)
+          {
+            int local_eqn =
+              Local_hang_eqn[j][hang_info_pt->master_node_pt(m)];
+            if (local_eqn >= 0)
+            {
+              Constraint_local_eqn[j].push_back(local_eqn);
+              Constraint_weight[j].push_back(hang_info_pt->master_weight(m));
+            }
+          }
+        }
+        // Otherwise it's the node's own value (if it stores one)
+        else if (j < nod_pt->nvalue())
+        {
+          int local_eqn = nodal_local_eqn(n, j);
+          if (local_eqn >= 0)
+          {
+            Constraint_local_eqn[j].push_back(local_eqn);
+            Constraint_weight[j].push_back(1.0);
+          }
+        }
+        Constraint_start[j][n + 1] = Constraint_local_eqn[j].size();
+      }
+    }
+  }
+
+  //=======================================================================
+  /// Add the contributions of the unconstrained nodal residuals
+  /// for the i-th continuously interpolated value to the elemental
+  /// residual vector, using the hanging-node constraint matrix.
+  //=======================================================================
+  void RefineableElement::add_constrained_nodal_residuals(
+    const unsigned& i,
+    const Vector<double>& nodal_residuals,
+    Vector<double>& residuals) const
+  {
+#ifdef PARANOID
+    if (i >= Constraint_start.size())
+    {
+      std::ostringstream error_stream;
+      error_stream << "The constraint matrix for value " << i
+                   << " has not been set up.\n"
+                   << "Have the local equation numbers been assigned?"
+                   << std::endl;
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    const unsigned* start_pt = &Constraint_start[i][0];
+    const int* local_eqn_pt = Constraint_local_eqn[i].data();
+    const double* weight_pt = Constraint_weight[i].data();
+
+    const unsigned n_node = nnode();
+    for (unsigned l = 0; l < n_node; l++)
+    {
+      const double nodal_residual = nodal_residuals[l];
+      for (unsigned k = start_pt[l]; k < start_pt[l + 1]; k++)
+      {
+        residuals[local_eqn_pt[k]] += weight_pt[k] * nodal_residual;
+      }
+    }
+  }
+
+  //=======================================================================
+  /// Add the contributions of the unconstrained nodal Jacobian (residuals
+  /// for the i-th value w.r.t. the j-th value) to the elemental Jacobian
+  /// matrix, using the hanging-node constraint matrix.
+  //=======================================================================
+  void RefineableElement::add_constrained_nodal_jacobian(
+    const unsigned& i,
+    const unsigned& j,
+    const DenseMatrix<double>& nodal_jacobian,
+    DenseMatrix<double>& jacobian) const
+  {
+#ifdef PARANOID
+    if ((i >= Constraint_start.size()) || (j >= Constraint_start.size()))
+    {
+      std::ostringstream error_stream;
+      error_stream << "The constraint matrix for value " << i << " or " << j
+                   << " has not been set up.\n"
+                   << "Have the local equation numbers been assigned?"
+                   << std::endl;
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    const unsigned* row_start_pt = &Constraint_start[i][0];
+    const int* row_eqn_pt = Constraint_local_eqn[i].data();
+    const double* row_weight_pt = Constraint_weight[i].data();
+    const unsigned* col_start_pt = &Constraint_start[j][0];
+    const int* col_eqn_pt = Constraint_local_eqn[j].data();
+    const double* col_weight_pt = Constraint_weight[j].data();
+
+    const unsigned n_node = nnode();
+    for (unsigned l = 0; l < n_node; l++)
+    {
+      for (unsigned k = row_start_pt[l]; k < row_start_pt[l + 1]; k++)
+      {
+        const int local_eqn = row_eqn_pt[k];
+        const double row_weight = row_weight_pt[k];
+        for (unsigned l2 = 0; l2 < n_node; l2++)
+        {
+          const double entry = row_weight * nodal_jacobian(l, l2);
+          for (unsigned k2 = col_start_pt[l2]; k2 < col_start_pt[l2 + 1]; k2++)
+          {
+            jacobian(local_eqn, col_eqn_pt[k2]) += entry * col_weight_pt[k2];
+          }
+        }
+      }
+    }
+  }
+
   //======================================================================
   /// The purpose of this function is to identify all possible
   /// Data that can affect the fields interpolated by the FiniteElement.
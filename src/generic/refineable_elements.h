@@ -171,6 +171,26 @@ namespace oomph
     /// non-hanging nodes of this element or master nodes of hanging nodes.
     std::map<Node*, unsigned> Shape_controlling_node_lookup;
 
+    /// Compressed row storage for the hanging-node constraint
+    /// (prolongation) matrix of the i-th continuously interpolated value:
+    /// The value at local node l is the weighted sum of the unknowns with
+    /// local equation numbers Constraint_local_eqn[i][k] and weights
+    /// Constraint_weight[i][k] for
+    /// Constraint_start[i][l] <= k < Constraint_start[i][l+1].
+    /// Pinned values are omitted.
+    Vector<Vector<unsigned>> Constraint_start;
+
+    /// Local equation numbers in the hanging-node constraint matrix
+    Vector<Vector<int>> Constraint_local_eqn;
+
+    /// Weights in the hanging-node constraint matrix
+    Vector<Vector<double>> Constraint_weight;
+
+    /// Build the hanging-node constraint matrix from the hanging
+    /// information and the local equation numbers (called when the
+    /// local equation numbers are assigned)
+    void setup_hanging_constraint_matrix();
+
   protected:
     /// Assign the local equation numbers for hanging node variables
     void assign_hanging_local_eqn_numbers(const bool& store_local_dof_pt);
@@ -293,6 +313,28 @@ namespace oomph
       return Local_hang_eqn[i][node_pt];
     }
 
+    /// Add the contributions of the unconstrained nodal residuals
+    /// (nodal_residuals[l] is the residual associated with the test
+    /// function at local node l) for the i-th continuously interpolated
+    /// value to the elemental residual vector, using the precomputed
+    /// hanging-node constraint matrix. This allows residuals to be
+    /// assembled without reference to hanging nodes.
+    void add_constrained_nodal_residuals(const unsigned& i,
+                                         const Vector<double>& nodal_residuals,
+                                         Vector<double>& residuals) const;
+
+    /// Add the contributions of the unconstrained nodal Jacobian
+    /// (nodal_jacobian(l,l2) is the derivative of the residual associated
+    /// with the test function at local node l w.r.t. the j-th value at
+    /// local node l2) for the i-th continuously interpolated value to the
+    /// elemental Jacobian matrix, using the precomputed hanging-node
+    /// constraint matrix.
+    void add_constrained_nodal_jacobian(
+      const unsigned& i,
+      const unsigned& j,
+      const DenseMatrix<double>& nodal_jacobian,
+      DenseMatrix<double>& jacobian) const;
+
     /// Interface to function that builds the element: i.e.  construct
     /// the nodes, assign their positions, apply boundary conditions, etc. The
     /// required procedures depend on the geometrical type of the element and
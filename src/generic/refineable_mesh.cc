@@ -33,6 +33,10 @@
 #include <stdlib.h>
 #include <limits>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "refineable_mesh.h"
 // Include to fill in additional_synchronise_hanging_nodes() function
 #include "refineable_mesh.template.cc"
@@ -939,10 +943,21 @@ namespace oomph
       // Pointer to mesh needs to be passed to some functions
       Mesh* mesh_pt = this;
 
+      // Number of threads used for the concurrent phases (for doc only)
+      unsigned n_thread = 1;
+#ifdef _OPENMP
+      if (Use_threaded_adaptation)
+      {
+        n_thread = omp_get_max_threads();
+      }
+#endif
+
       double t_start = 0.0;
+      double t_adapt_start = 0.0;
       if (Global_timings::Doc_comprehensive_timings)
       {
         t_start = TimingHelpers::timer();
+        t_adapt_start = t_start;
       }
 
       // Do refinement(=splitting) of elements that have been selected
@@ -953,8 +968,8 @@ namespace oomph
       if (Global_timings::Doc_comprehensive_timings)
       {
         double t_end = TimingHelpers::timer();
-        oomph_info << "Time for split_elements_if_required: " << t_end - t_start
-                   << std::endl;
+        oomph_info << "Time for split_elements_if_required [" << n_thread
+                   << " thread(s)]: " << t_end - t_start << std::endl;
         t_start = TimingHelpers::timer();
       }
 
@@ -1045,7 +1060,19 @@ namespace oomph
       Vector<std::set<Node*>> hanging_nodes_on_boundary_pt(n_boundary);
 
       unsigned long n_node = this->nnode();
-      for (unsigned long n = 0; n < n_node; n++)
+
+      // Reconstruct the nodal values/positions (and Lagrangian coordinates)
+      // of all hanging nodes from their hanging node representation.
+      // This only reads the data of the (non-hanging) master nodes, so it
+      // can be done concurrently; the reconstructed data is stored as
+      // [values and position at t=0, values and position at t=1, ...,
+      // Lagrangian coordinates] and only copied into the nodes below.
+      Vector<Vector<double>> reconstructed_data(n_node);
+      Vector<unsigned> node_is_hanging(n_node, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 256) if (Use_threaded_adaptation)
+#endif
+      for (long n = 0; n < long(n_node); n++)
       {
         // Get the pointer to the node
         Node* nod_pt = this->node_pt(n);
@@ -1056,36 +1083,78 @@ namespace oomph
         // We need to find if any of the values are hanging
         bool is_hanging = nod_pt->is_hanging();
         // Loop over the values and find out whether any are hanging
-        for (unsigned n = 0; n < n_value; n++)
+        for (unsigned i = 0; i < n_value; i++)
         {
-          is_hanging |= nod_pt->is_hanging(n);
+          is_hanging |= nod_pt->is_hanging(i);
         }
 
-        // If the node is hanging then ...
+        // If the node is hanging, reconstruct its data
         if (is_hanging)
+        {
+          node_is_hanging[n] = 1;
+          unsigned nt = nod_pt->ntstorage();
+          unsigned n_dim = nod_pt->ndim();
+          SolidNode* solid_node_pt = dynamic_cast<SolidNode*>(nod_pt);
+          unsigned n_lagrangian = 0;
+          if (solid_node_pt != 0)
+          {
+            n_lagrangian = solid_node_pt->nlagrangian();
+          }
+          Vector<double>& data = reconstructed_data[n];
+          data.resize(nt * (n_value + n_dim) + n_lagrangian);
+          Vector<double> values(n_value);
+          Vector<double> position(n_dim);
+          unsigned count = 0;
+          // Loop over all history values
+          for (unsigned t = 0; t < nt; t++)
+          {
+            nod_pt->value(t, values);
+            for (unsigned i = 0; i < n_value; i++)
+            {
+              data[count++] = values[i];
+            }
+            nod_pt->position(t, position);
+            for (unsigned i = 0; i < n_dim; i++)
+            {
+              data[count++] = position[i];
+            }
+          }
+          for (unsigned i = 0; i < n_lagrangian; i++)
+          {
+            data[count++] = solid_node_pt->lagrangian_position(i);
+          }
+        }
+      }
+
+      for (unsigned long n = 0; n < n_node; n++)
+      {
+        // Get the pointer to the node
+        Node* nod_pt = this->node_pt(n);
+
+        // If the node is hanging then ...
+        if (node_is_hanging[n])
         {
           // Unless they are turned into hanging nodes again below
           // (this might or might not happen), fill in all the necessary
           // data to make them 'proper' nodes again.
 
-          // Reconstruct the nodal values/position from the node's
-          // hanging node representation
+          // Copy the nodal values/position reconstructed from the node's
+          // hanging node representation into the node
+          unsigned n_value = nod_pt->nvalue();
           unsigned nt = nod_pt->ntstorage();
-          Vector<double> values(n_value);
           unsigned n_dim = nod_pt->ndim();
-          Vector<double> position(n_dim);
+          const Vector<double>& data = reconstructed_data[n];
+          unsigned count = 0;
           // Loop over all history values
           for (unsigned t = 0; t < nt; t++)
           {
-            nod_pt->value(t, values);
             for (unsigned i = 0; i < n_value; i++)
             {
-              nod_pt->set_value(t, i, values[i]);
+              nod_pt->set_value(t, i, data[count++]);
             }
-            nod_pt->position(t, position);
             for (unsigned i = 0; i < n_dim; i++)
             {
-              nod_pt->x(t, i) = position[i];
+              nod_pt->x(t, i) = data[count++];
             }
           }
 
@@ -1106,7 +1175,7 @@ namespace oomph
             unsigned n_lagrangian = solid_node_pt->nlagrangian();
             for (unsigned i = 0; i < n_lagrangian; i++)
             {
-              solid_node_pt->xi(i) = solid_node_pt->lagrangian_position(i);
+              solid_node_pt->xi(i) = data[count++];
             }
           }
 
@@ -1146,8 +1215,9 @@ namespace oomph
       if (Global_timings::Doc_comprehensive_timings)
       {
         t_end = TimingHelpers::timer();
-        oomph_info << "Time for sorting out initial hanging status: "
-                   << t_end - t_start << std::endl;
+        oomph_info << "Time for sorting out initial hanging status ["
+                   << n_thread << " thread(s)]: " << t_end - t_start
+                   << std::endl;
         t_start = TimingHelpers::timer();
       }
 
@@ -1178,9 +1248,11 @@ namespace oomph
       Vector<Tree*> tree_nodes_pt;
       Forest_pt->stick_leaves_into_vector(tree_nodes_pt);
 
-      // Copy the elements into the mesh Vector
+      // Copy the elements into the mesh Vector (and record that the
+      // element storage has changed)
       num_tree_nodes = tree_nodes_pt.size();
       Element_pt.resize(num_tree_nodes);
+      increment_element_storage_generation();
       for (unsigned long e = 0; e < num_tree_nodes; e++)
       {
         Element_pt[e] = tree_nodes_pt[e]->object_pt();
@@ -1262,8 +1334,8 @@ namespace oomph
       if (Global_timings::Doc_comprehensive_timings)
       {
         t_end = TimingHelpers::timer();
-        oomph_info << "Time for complete_hanging_nodes: " << t_end - t_start
-                   << std::endl;
+        oomph_info << "Time for complete_hanging_nodes [" << n_thread
+                   << " thread(s)]: " << t_end - t_start << std::endl;
         t_start = TimingHelpers::timer();
       }
 
@@ -1750,6 +1822,12 @@ namespace oomph
           some_file.close();
         }
       } // End of documentation
+
+      if (Global_timings::Doc_comprehensive_timings)
+      {
+        oomph_info << "Total time for adapt_mesh: "
+                   << TimingHelpers::timer() - t_adapt_start << std::endl;
+      }
     } // End if (this->nelement()>0)
 
 
@@ -2275,8 +2353,23 @@ namespace oomph
     unsigned long n_node = this->nnode();
     double min_weight = 1.0e-8; // RefineableBrickElement::min_weight_value();
 
+    // Number of hanging schemes per node (geometric one is stored first)
+    const unsigned n_scheme = ncont_interpolated_values + 1;
+
+    // Storage for the completed hanging schemes: Entry [n*n_scheme+i+1]
+    // holds the new scheme for value i (i=-1 for geometric) of node n,
+    // or zero if that scheme doesn't have to be replaced.
+    // The completed schemes are only computed from the existing (incomplete)
+    // ones, so this can be done concurrently and the result doesn't depend
+    // on the order in which the nodes are visited; the (serial)
+    // assignment below then replaces (and deletes) the existing schemes.
+    Vector<HangInfo*> new_hang_pt(n_node * n_scheme, 0);
+
     // Loop over the nodes in the mesh
-    for (unsigned long n = 0; n < n_node; n++)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64) if (Use_threaded_adaptation)
+#endif
+    for (long n = 0; n < long(n_node); n++)
     {
       // Assign a local pointer to the node
       Node* nod_pt = this->node_pt(n);
@@ -2322,13 +2415,29 @@ namespace oomph
               ++hang_weights_index;
             }
 
-            // Assign the new hanging pointer to the appropriate value
-            nod_pt->set_hanging_pt(hang_pt, i);
+            // Store the new hanging scheme
+            new_hang_pt[n * n_scheme + i + 1] = hang_pt;
           }
         }
       }
     }
 
+    // Now assign the new hanging pointers to the appropriate values
+    // (geometric first, because this also resets all values that share
+    // the geometric scheme)
+    for (unsigned long n = 0; n < n_node; n++)
+    {
+      Node* nod_pt = this->node_pt(n);
+      for (int i = -1; i < ncont_interpolated_values; i++)
+      {
+        HangInfo* hang_pt = new_hang_pt[n * n_scheme + i + 1];
+        if (hang_pt != 0)
+        {
+          nod_pt->set_hanging_pt(hang_pt, i);
+        }
+      }
+    }
+
 #ifdef PARANOID
 
     // Check hanging node scheme: The weights need to add up to one
@@ -4598,9 +4707,11 @@ namespace oomph
       Vector<Tree*> tree_nodes_pt;
       this->forest_pt()->stick_leaves_into_vector(tree_nodes_pt);
 
-      // Copy the elements into the mesh Vector
+      // Copy the elements into the mesh Vector (and record that the
+      // element storage has changed)
       unsigned long num_tree_nodes = tree_nodes_pt.size();
       this->element_pt().resize(num_tree_nodes);
+      this->increment_element_storage_generation();
       for (unsigned long e = 0; e < num_tree_nodes; e++)
       {
         this->element_pt(e) = tree_nodes_pt[e]->object_pt();
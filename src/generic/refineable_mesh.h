@@ -398,6 +398,9 @@ namespace oomph
 
       // Mesh hasn't been pruned yet
       Uniform_refinement_level_when_pruned = 0;
+
+      // Adapt in serial by default
+      Use_threaded_adaptation = false;
     }
 
 
@@ -453,6 +456,32 @@ namespace oomph
     /// p-unrefine mesh uniformly
     void p_unrefine_uniformly(DocInfo& doc_info);
 
+    /// Enable threaded mesh adaptation. If the library is compiled
+    /// with OpenMP, adapt_mesh() then splits the elements of the different
+    /// trees in the forest concurrently, and reconstructs the nodal data
+    /// of previously hanging nodes and completes the hanging node schemes
+    /// concurrently for the nodes. The construction of new nodes and
+    /// the initial markup of hanging nodes act on nodes that are shared
+    /// between trees and remain serial, so the node numbering is the same
+    /// as in a serial adaptation. Only use this if the constructors of
+    /// the mesh's elements are thread-safe.
+    void enable_threaded_adaptation()
+    {
+      Use_threaded_adaptation = true;
+    }
+
+    /// Disable threaded mesh adaptation (default)
+    void disable_threaded_adaptation()
+    {
+      Use_threaded_adaptation = false;
+    }
+
+    /// Is threaded mesh adaptation enabled?
+    bool is_threaded_adaptation_enabled() const
+    {
+      return Use_threaded_adaptation;
+    }
+
     /// Set up the tree forest associated with the Mesh (if any)
     virtual void setup_tree_forest() = 0;
 
@@ -767,6 +796,10 @@ namespace oomph
     /// Forest representation of the mesh
     TreeForest* Forest_pt;
 
+    /// Use threads (if available) for the parts of the mesh adaptation
+    /// that can be performed concurrently?
+    bool Use_threaded_adaptation;
+
   private:
 #ifdef OOMPH_HAS_MPI
 
@@ -814,10 +847,14 @@ namespace oomph
     void split_elements_if_required()
     {
       // Find the number of trees in the forest
-      unsigned n_tree = this->Forest_pt->ntree();
+      long n_tree = this->Forest_pt->ntree();
       // Loop over all "active" elements in the forest and split them
-      // if required
-      for (unsigned long e = 0; e < n_tree; e++)
+      // if required. The trees are independent so they can be
+      // processed concurrently.
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1) if (this->Use_threaded_adaptation)
+#endif
+      for (long e = 0; e < n_tree; e++)
       {
         this->Forest_pt->tree_pt(e)->traverse_leaves(
           &Tree::split_if_required<ELEMENT>);
@@ -3377,6 +3377,509 @@ namespace oomph
     false;
 
 
+  /// /////////////////////////////////////////////////////////////////////////////
+  /// /////////////////////////////////////////////////////////////////////////////
+  /// /////////////////////////////////////////////////////////////////////////////
+  ///                        BVHSamplePointContainer
+  /// /////////////////////////////////////////////////////////////////////////////
+  /// /////////////////////////////////////////////////////////////////////////////
+  /// /////////////////////////////////////////////////////////////////////////////
+
+
+  /// Max. number of elements in the leaves of the tree
+  unsigned BVHSamplePointContainer::Max_number_of_elements_per_leaf = 4;
+
+
+  //====================================================================
+  /// Helper class to compare the centres of element bounding boxes
+  /// in a given coordinate direction (used to split the nodes of the
+  /// BVH)
+  //====================================================================
+  class BVHBoxCentreComparison
+  {
+  public:
+    /// Constructor: pass the box centres (box_centre[j*dim+i] is the
+    /// i-th coordinate of the centre of box j), their dimension and the
+    /// direction in which they're compared
+    BVHBoxCentreComparison(const Vector<double>& box_centre,
+                           const unsigned& dim,
+                           const unsigned& direction)
+      : Box_centre(box_centre), Dim(dim), Direction(direction)
+    {
+    }
+
+    /// Is centre of box a to the left of that of box b?
+    bool operator()(const unsigned& a, const unsigned& b) const
+    {
+      return Box_centre[a * Dim + Direction] < Box_centre[b * Dim + Direction];
+    }
+
+  private:
+    /// The box centres
+    const Vector<double>& Box_centre;
+
+    /// Their dimension
+    unsigned Dim;
+
+    /// The direction in which they're compared
+    unsigned Direction;
+  };
+
+
+  //====================================================================
+  /// Constructor
+  //====================================================================
+  BVHSamplePointContainer::BVHSamplePointContainer(
+    SamplePointContainerParameters* sample_point_container_parameters_pt)
+    : SamplePointContainer(
+        sample_point_container_parameters_pt->mesh_pt(),
+        sample_point_container_parameters_pt->min_and_max_coordinates(),
+        sample_point_container_parameters_pt
+          ->use_eulerian_coordinates_during_setup(),
+        sample_point_container_parameters_pt
+          ->ignore_halo_elements_during_locate_zeta_search(),
+        sample_point_container_parameters_pt
+          ->nsample_points_generated_per_element())
+  {
+    // Get the spatial dimension (int because of mpi below)
+    int dim = 0;
+    if (Mesh_pt->nelement() != 0)
+    {
+      dim = Mesh_pt->finite_element_pt(0)->dim();
+    }
+
+    // Need to do an Allreduce to ensure that the dimension is consistent
+    // even when no elements are assigned to a certain processor
+#ifdef OOMPH_HAS_MPI
+    // Only a problem if the mesh has been distributed
+    if (Mesh_pt->is_mesh_distributed())
+    {
+      // Need a non-null communicator
+      if (Mesh_pt->communicator_pt() != 0)
+      {
+        int n_proc = Mesh_pt->communicator_pt()->nproc();
+        if (n_proc > 1)
+        {
+          int dim_reduce;
+          MPI_Allreduce(&dim,
+                        &dim_reduce,
+                        1,
+                        MPI_INT,
+                        MPI_MAX,
+                        Mesh_pt->communicator_pt()->mpi_comm());
+          dim = dim_reduce;
+        }
+      }
+    }
+#endif
+
+    Ndim_zeta = dim;
+
+    // Have we specified max/min coordinates?
+    // If not, compute them on the fly from mesh
+    if (Min_and_max_coordinates.size() == 0)
+    {
+      setup_min_and_max_coordinates();
+    }
+
+    // Time it
+    double t_start = 0.0;
+    if (SamplePointContainer::Enable_timing_of_setup)
+    {
+      t_start = TimingHelpers::timer();
+    }
+
+    // Build the tree
+    build_bvh();
+
+    if (SamplePointContainer::Enable_timing_of_setup)
+    {
+      double t_end = TimingHelpers::timer();
+      oomph_info << "Time for setup of " << dim
+                 << "-dimensional BVH sample point container containing "
+                 << Element_index.size() << " element bounding boxes in "
+                 << nbvh_node() << " nodes: " << t_end - t_start << " sec"
+                 << std::endl;
+    }
+
+    // Initialise
+    Total_number_of_sample_points_visited_during_locate_zeta_from_top_level = 0;
+  }
+
+
+  //====================================================================
+  /// Compute the bounding boxes of the elements (from their sample
+  /// points, enlarged by Percentage_offset percent of their extent in
+  /// each direction to allow for curved elements) and build the tree.
+  //====================================================================
+  void BVHSamplePointContainer::build_bvh()
+  {
+    const unsigned dim = Ndim_zeta;
+
+    // Collect the elements that we're going to search
+    unsigned n_el_mesh = Mesh_pt->nelement();
+    Element_index.clear();
+    Element_index.reserve(n_el_mesh);
+    for (unsigned e = 0; e < n_el_mesh; e++)
+    {
+#ifdef OOMPH_HAS_MPI
+      // Don't bother with halo elements if we're ignoring them anyway
+      if (Ignore_halo_elements_during_locate_zeta_search &&
+          Mesh_pt->finite_element_pt(e)->is_halo())
+      {
+        continue;
+      }
+#endif
+      Element_index.push_back(e);
+    }
+    const unsigned nel = Element_index.size();
+
+    // Bounding boxes of the elements, in mesh order for now
+    Vector<double> box_min(nel * dim, DBL_MAX);
+    Vector<double> box_max(nel * dim, -DBL_MAX);
+
+    // Local coordinates of the element centres, in mesh order for now
+    Vector<Vector<double>> s_centre(nel);
+
+    // Sample at least the vertices
+    unsigned n_plot = std::max(Nsample_points_generated_per_element, 2u);
+    Vector<double> zeta(dim);
+    for (unsigned j = 0; j < nel; j++)
+    {
+      FiniteElement* el_pt = Mesh_pt->finite_element_pt(Element_index[j]);
+      unsigned dim_el = el_pt->dim();
+      Vector<double> s(dim_el);
+      s_centre[j].resize(dim_el, 0.0);
+      unsigned n_plot_points = el_pt->nplot_points(n_plot);
+      for (unsigned iplot = 0; iplot < n_plot_points; iplot++)
+      {
+        el_pt->get_s_plot(iplot, n_plot, s, false);
+        for (unsigned i = 0; i < dim_el; i++)
+        {
+          s_centre[j][i] += s[i] / double(n_plot_points);
+        }
+        if (Use_eulerian_coordinates_during_setup)
+        {
+          el_pt->interpolated_x(s, zeta);
+        }
+        else
+        {
+          el_pt->interpolated_zeta(s, zeta);
+        }
+        for (unsigned i = 0; i < dim; i++)
+        {
+          box_min[j * dim + i] = std::min(box_min[j * dim + i], zeta[i]);
+          box_max[j * dim + i] = std::max(box_max[j * dim + i], zeta[i]);
+        }
+      }
+
+      // Enlarge the box (the element may be curved between the
+      // sample points). Use the largest extent so that flat elements
+      // (e.g. in a boundary layer) still get a box of finite width.
+      double max_length = 0.0;
+      for (unsigned i = 0; i < dim; i++)
+      {
+        max_length =
+          std::max(max_length, box_max[j * dim + i] - box_min[j * dim + i]);
+      }
+      double offset = (Percentage_offset / 100.0) * max_length;
+      for (unsigned i = 0; i < dim; i++)
+      {
+        box_min[j * dim + i] -= offset;
+        box_max[j * dim + i] += offset;
+      }
+    }
+
+    // Box centres (used to split the nodes)
+    Vector<double> box_centre(nel * dim);
+    for (unsigned j = 0; j < nel; j++)
+    {
+      for (unsigned i = 0; i < dim; i++)
+      {
+        box_centre[j * dim + i] =
+          0.5 * (box_min[j * dim + i] + box_max[j * dim + i]);
+      }
+    }
+
+    // Element_index now stores positions in the box vectors; it gets
+    // mapped back to element numbers once the tree is built
+    Vector<unsigned> element_number(Element_index);
+    for (unsigned j = 0; j < nel; j++)
+    {
+      Element_index[j] = j;
+    }
+
+    // Build the tree (a balanced binary tree has fewer than 2*nel/leaf
+    // size nodes)
+    Node_box_min.clear();
+    Node_box_max.clear();
+    Node_first.clear();
+    Node_last.clear();
+    Node_first_child.clear();
+    if (nel > 0)
+    {
+      unsigned n_node_estimate =
+        2 * (nel / std::max(Max_number_of_elements_per_leaf, 1u) + 1);
+      Node_box_min.reserve(n_node_estimate * dim);
+      Node_box_max.reserve(n_node_estimate * dim);
+      Node_first.reserve(n_node_estimate);
+      Node_last.reserve(n_node_estimate);
+      Node_first_child.reserve(n_node_estimate);
+
+      // Create the root and do the rest recursively
+      Node_box_min.resize(dim);
+      Node_box_max.resize(dim);
+      Node_first.push_back(0);
+      Node_last.push_back(nel);
+      Node_first_child.push_back(0);
+
+      build_bvh_node(0, 0, nel, box_min, box_max, box_centre);
+    }
+
+    // Now store the element boxes in tree order, by coordinate direction
+    Element_box_min.resize(nel * dim);
+    Element_box_max.resize(nel * dim);
+    Element_s_centre.resize(nel);
+    for (unsigned j = 0; j < nel; j++)
+    {
+      unsigned jj = Element_index[j];
+      Element_s_centre[j] = s_centre[jj];
+      for (unsigned i = 0; i < dim; i++)
+      {
+        Element_box_min[i * nel + j] = box_min[jj * dim + i];
+        Element_box_max[i * nel + j] = box_max[jj * dim + i];
+      }
+      Element_index[j] = element_number[jj];
+    }
+  }
+
+
+  //====================================================================
+  /// Recursively build the node of the tree that contains the
+  /// elements Element_index[first],...,Element_index[last-1]: compute
+  /// its box and, unless the node is small enough to be a leaf, split
+  /// its elements at the median of their box centres in the direction
+  /// in which the centres are spread out the most.
+  //====================================================================
+  void BVHSamplePointContainer::build_bvh_node(
+    const unsigned& node,
+    const unsigned& first,
+    const unsigned& last,
+    const Vector<double>& box_min,
+    const Vector<double>& box_max,
+    const Vector<double>& box_centre)
+  {
+    const unsigned dim = Ndim_zeta;
+
+    // Bounding box of the node and of the box centres in it
+    Vector<double> centre_min(dim, DBL_MAX);
+    Vector<double> centre_max(dim, -DBL_MAX);
+    for (unsigned i = 0; i < dim; i++)
+    {
+      Node_box_min[node * dim + i] = DBL_MAX;
+      Node_box_max[node * dim + i] = -DBL_MAX;
+    }
+    for (unsigned j = first; j < last; j++)
+    {
+      unsigned jj = Element_index[j];
+      for (unsigned i = 0; i < dim; i++)
+      {
+        Node_box_min[node * dim + i] =
+          std::min(Node_box_min[node * dim + i], box_min[jj * dim + i]);
+        Node_box_max[node * dim + i] =
+          std::max(Node_box_max[node * dim + i], box_max[jj * dim + i]);
+        centre_min[i] = std::min(centre_min[i], box_centre[jj * dim + i]);
+        centre_max[i] = std::max(centre_max[i], box_centre[jj * dim + i]);
+      }
+    }
+
+    // Leaf? (A leaf must contain at least one element, otherwise a node
+    // with a single element would be split forever)
+    if (last - first <= std::max(Max_number_of_elements_per_leaf, 1u))
+    {
+      return;
+    }
+
+    // Split in the direction in which the centres are spread out most
+    unsigned split_dir = 0;
+    double max_spread = -1.0;
+    for (unsigned i = 0; i < dim; i++)
+    {
+      if (centre_max[i] - centre_min[i] > max_spread)
+      {
+        max_spread = centre_max[i] - centre_min[i];
+        split_dir = i;
+      }
+    }
+
+    // Partition the elements at the median
+    unsigned middle = first + (last - first) / 2;
+    BVHBoxCentreComparison comparison(box_centre, dim, split_dir);
+    std::nth_element(Element_index.begin() + first,
+                     Element_index.begin() + middle,
+                     Element_index.begin() + last,
+                     comparison);
+
+    // Create the two children
+    unsigned first_child = Node_first.size();
+    Node_first_child[node] = first_child;
+    Node_box_min.resize((first_child + 2) * dim);
+    Node_box_max.resize((first_child + 2) * dim);
+    Node_first.push_back(first);
+    Node_last.push_back(middle);
+    Node_first_child.push_back(0);
+    Node_first.push_back(middle);
+    Node_last.push_back(last);
+    Node_first_child.push_back(0);
+
+    // ...and recurse
+    build_bvh_node(first_child, first, middle, box_min, box_max, box_centre);
+    build_bvh_node(first_child + 1, middle, last, box_min, box_max, box_centre);
+  }
+
+
+  //====================================================================
+  /// Find sub-GeomObject (finite element) and the local coordinate
+  /// s within it that contains point with global coordinate zeta.
+  /// sub_geom_object_pt=0 if point can't be found.
+  //====================================================================
+  void BVHSamplePointContainer::locate_zeta(const Vector<double>& zeta,
+                                            GeomObject*& sub_geom_object_pt,
+                                            Vector<double>& s)
+  {
+    // Reset counter for number of sample points visited.
+    Total_number_of_sample_points_visited_during_locate_zeta_from_top_level = 0;
+
+    // Initialise return to null -- if it's still null when we're
+    // leaving we've failed!
+    sub_geom_object_pt = 0;
+
+    const unsigned dim = Ndim_zeta;
+    const unsigned nel = Element_index.size();
+    if (nel == 0) return;
+
+    // Flags indicating if the point is inside the boxes of the elements
+    // in a leaf (resized below if the max. number of elements per leaf
+    // has been increased since the tree was built)
+    Vector<unsigned char> inside(std::max(Max_number_of_elements_per_leaf, 1u));
+
+    // Candidate elements (paired with a measure of how far the point
+    // is from the centre of the element's box, relative to the box size)
+    Vector<std::pair<double, unsigned>> candidate;
+
+    // Depth-first traversal of the nodes whose box contains the point
+    Vector<unsigned> node_stack;
+    node_stack.reserve(64);
+    node_stack.push_back(0);
+    while (!node_stack.empty())
+    {
+      unsigned node = node_stack.back();
+      node_stack.pop_back();
+
+      // Is the point inside the node's box?
+      bool in_node_box = true;
+      for (unsigned i = 0; i < dim; i++)
+      {
+        in_node_box &= (zeta[i] >= Node_box_min[node * dim + i]) &
+                       (zeta[i] <= Node_box_max[node * dim + i]);
+      }
+      if (!in_node_box) continue;
+
+      // Descend
+      unsigned first_child = Node_first_child[node];
+      if (first_child != 0)
+      {
+        node_stack.push_back(first_child + 1);
+        node_stack.push_back(first_child);
+        continue;
+      }
+
+      // Leaf: check all element boxes at once (the loop over the
+      // elements is innermost and accesses contiguous memory, so it can
+      // be vectorised)
+      const unsigned first = Node_first[node];
+      const unsigned n_leaf = Node_last[node] - first;
+      if (n_leaf > inside.size())
+      {
+        inside.resize(n_leaf);
+      }
+      for (unsigned j = 0; j < n_leaf; j++)
+      {
+        inside[j] = 1;
+      }
+      for (unsigned i = 0; i < dim; i++)
+      {
+        const double zeta_i = zeta[i];
+        const double* box_min_pt = &Element_box_min[i * nel + first];
+        const double* box_max_pt = &Element_box_max[i * nel + first];
+        for (unsigned j = 0; j < n_leaf; j++)
+        {
+          inside[j] &= (zeta_i >= box_min_pt[j]) & (zeta_i <= box_max_pt[j]);
+        }
+      }
+
+      // Record the candidates
+      for (unsigned j = 0; j < n_leaf; j++)
+      {
+        if (!inside[j]) continue;
+        double dist = 0.0;
+        for (unsigned i = 0; i < dim; i++)
+        {
+          double box_min = Element_box_min[i * nel + first + j];
+          double box_max = Element_box_max[i * nel + first + j];
+          double half_width = 0.5 * (box_max - box_min);
+          if (half_width > 0.0)
+          {
+            dist = std::max(
+              dist,
+              std::fabs(zeta[i] - 0.5 * (box_max + box_min)) / half_width);
+          }
+        }
+        candidate.push_back(std::make_pair(dist, first + j));
+      }
+    }
+
+    // Do the (expensive) elemental locate_zeta for the candidates, starting
+    // with the one whose box centre is closest to the point -- this
+    // is almost always the right one because the boxes of neighbouring
+    // elements only overlap by the offset.
+    std::sort(candidate.begin(), candidate.end());
+    unsigned n_candidate = candidate.size();
+
+    // First pass: start the Newton iteration from the centre of the
+    // element; second pass (only if this fails for all candidates, e.g.
+    // for strongly curved elements): let the element find the best
+    // initial guess itself.
+    for (unsigned pass = 0; pass < 2; pass++)
+    {
+      bool use_coordinate_as_initial_guess = (pass == 0);
+      for (unsigned c = 0; c < n_candidate; c++)
+      {
+        unsigned j = candidate[c].second;
+        FiniteElement* el_pt = Mesh_pt->finite_element_pt(Element_index[j]);
+
+        // Bump counter
+        Total_number_of_sample_points_visited_during_locate_zeta_from_top_level++;
+
+        if (use_coordinate_as_initial_guess)
+        {
+          s = Element_s_centre[j];
+        }
+        el_pt->locate_zeta(
+          zeta, sub_geom_object_pt, s, use_coordinate_as_initial_guess);
+
+        // Always fail? (Used for debugging)
+        if (SamplePointContainer::Always_fail_elemental_locate_zeta)
+        {
+          sub_geom_object_pt = 0;
+        }
+
+        if (sub_geom_object_pt != 0) return;
+      }
+    }
+  }
+
+
   /// /////////////////////////////////////////////////////////////////////////////
   /// /////////////////////////////////////////////////////////////////////////////
   /// /////////////////////////////////////////////////////////////////////////////
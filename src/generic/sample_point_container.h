@@ -1026,6 +1026,126 @@ private:
 };
 
 
+/// /////////////////////////////////////////////////////////////////////
+/// /////////////////////////////////////////////////////////////////////
+/// /////////////////////////////////////////////////////////////////////
+
+//==============================================================================
+/// Sample point container based on a bounding volume hierarchy (BVH):
+/// a binary tree of axis-aligned boxes whose leaves hold the bounding boxes
+/// of (at most a few) elements. locate_zeta(...) only descends into
+/// boxes that contain the required point and only performs the
+/// (Newton-based) elemental locate_zeta in the elements whose
+/// bounding box contains it. Unlike the bin arrays, the tree adapts
+/// to the element sizes so it does not require any tuning (number of
+/// bins, max. search radius, ...) and works equally well on strongly
+/// graded or anisotropic meshes. The search is exhaustive so the
+/// multi-domain setup only requires a single pass.
+//==============================================================================
+class BVHSamplePointContainer : public virtual SamplePointContainer
+{
+public:
+  /// Constructor
+  BVHSamplePointContainer(
+    SamplePointContainerParameters* sample_point_container_parameters_pt);
+
+  /// Broken copy constructor.
+  BVHSamplePointContainer(const BVHSamplePointContainer& data) = delete;
+
+  /// Broken assignment operator.
+  void operator=(const BVHSamplePointContainer&) = delete;
+
+  /// Virtual destructor
+  virtual ~BVHSamplePointContainer() {}
+
+  /// Find sub-GeomObject (finite element) and the local coordinate
+  /// s within it that contains point with global coordinate zeta.
+  /// sub_geom_object_pt=0 if point can't be found.
+  void locate_zeta(const Vector<double>& zeta,
+                   GeomObject*& sub_geom_object_pt,
+                   Vector<double>& s);
+
+  /// Dimension of the zeta ( =  dim of local coordinate of elements)
+  unsigned ndim_zeta() const
+  {
+    return Ndim_zeta;
+  }
+
+  /// Total number of "sample points": here the number of element
+  /// bounding boxes stored in the tree
+  unsigned total_number_of_sample_points_computed_recursively() const
+  {
+    return Element_index.size();
+  }
+
+  /// Number of nodes (boxes) in the tree
+  unsigned nbvh_node() const
+  {
+    return Node_first.size();
+  }
+
+  /// Max. number of elements in the leaves of the tree (values
+  /// less than one are treated as one)
+  static unsigned Max_number_of_elements_per_leaf;
+
+private:
+  /// Compute the bounding boxes of the elements and build the tree.
+  void build_bvh();
+
+  /// Recursively build the node of the tree that contains the
+  /// elements Element_index[first],...,Element_index[last-1]. The
+  /// min./max. coordinates and the centres of the elements' boxes are
+  /// indexed by the entries in Element_index.
+  void build_bvh_node(const unsigned& node,
+                      const unsigned& first,
+                      const unsigned& last,
+                      const Vector<double>& box_min,
+                      const Vector<double>& box_max,
+                      const Vector<double>& box_centre);
+
+  /// Dimension of the zeta ( =  dim of local coordinate of elements)
+  unsigned Ndim_zeta;
+
+  /// Indices (in the mesh) of the elements, sorted such that the
+  /// elements in each node of the tree are stored contiguously.
+  Vector<unsigned> Element_index;
+
+  /// Min. coordinates of the element bounding boxes, stored "by
+  /// coordinate direction" for vectorisable point-in-box tests:
+  /// Element_box_min[i*nel+j] is the min. i-th coordinate of the box of
+  /// element Element_index[j].
+  Vector<double> Element_box_min;
+
+  /// Max. coordinates of the element bounding boxes (stored like
+  /// Element_box_min)
+  Vector<double> Element_box_max;
+
+  /// Local coordinates of the centre of the elements (the average of
+  /// their sample points), used as the initial guess for the elemental
+  /// locate_zeta. Stored in the same order as Element_index.
+  Vector<Vector<double>> Element_s_centre;
+
+  /// Min. coordinates of the boxes of the nodes in the tree:
+  /// Node_box_min[node*ndim_zeta+i]
+  Vector<double> Node_box_min;
+
+  /// Max. coordinates of the boxes of the nodes in the tree:
+  /// Node_box_max[node*ndim_zeta+i]
+  Vector<double> Node_box_max;
+
+  /// Index (in Element_index) of the first element in each node
+  Vector<unsigned> Node_first;
+
+  /// Index (in Element_index) of one beyond the last element in
+  /// each node
+  Vector<unsigned> Node_last;
+
+  /// Index of the first child of each node (the second one follows
+  /// it); zero for leaves (the root can't be anybody's child)
+  Vector<unsigned> Node_first_child;
+};
+
+
 /// /////////////////////////////////////////////////////////////////////
 /// /////////////////////////////////////////////////////////////////////
 /// /////////////////////////////////////////////////////////////////////
@@ -39,7 +39,8 @@ namespace oomph
   enum Sample_Point_Container_Type
   {
     UseRefineableBinArray = 1,
-    UseNonRefineableBinArray = 2
+    UseNonRefineableBinArray = 2,
+    UseBVHSamplePointContainer = 4
 #ifdef OOMPH_HAS_CGAL
     ,
     UseCGALSamplePointContainer = 3
@@ -74,6 +75,7 @@ namespace oomph
     friend class BinArrayParameters;
     friend class RefineableBinArrayParameters;
     friend class NonRefineableBinArrayParameters;
+    friend class BVHSamplePointContainerParameters;
 #ifdef OOMPH_HAS_CGAL
     friend class CGALSamplePointContainerParameters;
 #endif
@@ -222,6 +224,35 @@ namespace oomph
   /// ///////////////////////////////////////////////////////////////////////////
   /// ///////////////////////////////////////////////////////////////////////////
 
+  //=========================================================================
+  /// Helper object for dealing with the parameters used for the
+  /// BVHSamplePointContainer objects (there aren't any beyond those
+  /// shared by all sample point containers)
+  //=========================================================================
+  class BVHSamplePointContainerParameters
+    : public virtual SamplePointContainerParameters
+  {
+  public:
+    /// Constructor: Pass mesh.
+    BVHSamplePointContainerParameters(Mesh* mesh_pt)
+      : SamplePointContainerParameters(mesh_pt)
+    {
+    }
+
+    /// Broken copy constructor.
+    BVHSamplePointContainerParameters(
+      const BVHSamplePointContainerParameters& data) = delete;
+
+    /// Broken assignment operator.
+    void operator=(const BVHSamplePointContainerParameters&) = delete;
+  };
+
+
+  /// ///////////////////////////////////////////////////////////////////////////
+  /// ///////////////////////////////////////////////////////////////////////////
+  /// ///////////////////////////////////////////////////////////////////////////
+
+
 #ifdef OOMPH_HAS_CGAL
 
   //=========================================================================
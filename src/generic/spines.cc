@@ -53,6 +53,19 @@ namespace oomph
   }
 
 
+  //====================================================================
+  /// Compute the derivatives of the nodal position w.r.t. the
+  /// geometric Data: the SpineMesh implements the node update so it
+  /// computes the sensitivities too.
+  //====================================================================
+  void SpineNode::get_dposition_dgeom_data(
+    std::map<Data*, DenseMatrix<double>>& dposition_dgeom_data)
+  {
+    Spine_mesh_pt->get_dspine_node_position_dgeom_data(this,
+                                                       dposition_dgeom_data);
+  }
+
+
   /// ////////////////////////////////////////////////////////////////
   /// ////////////////////////////////////////////////////////////////
   // Functions for the SpineMesh class
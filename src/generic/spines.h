@@ -403,6 +403,12 @@ namespace oomph
     /// the update function in the Node's SpineMesh
     void node_update(const bool& update_all_time_levels_for_new_node = false);
 
+    /// Overload the function that computes the derivatives of the
+    /// nodal position w.r.t. the geometric Data: call the function in the
+    /// Node's SpineMesh (which may provide analytic sensitivities)
+    void get_dposition_dgeom_data(
+      std::map<Data*, DenseMatrix<double>>& dposition_dgeom_data);
+
     /// Return the number of geometric data, zero if no spine.
     unsigned ngeom_data() const
     {
@@ -749,6 +755,19 @@ namespace oomph
     /// by all specific SpineMeshes.
     virtual void spine_node_update(SpineNode* spine_node_pt) = 0;
 
+    /// Compute the derivatives of the position of the given spine node
+    /// w.r.t. the Data that affect its node update:
+    /// dposition_dgeom_data[data_pt](i,k) = dx_i / d (k-th value of
+    /// data_pt). The default implementation finite differences
+    /// spine_node_update(...); specific SpineMeshes can overload this to
+    /// provide analytic sensitivities.
+    virtual void get_dspine_node_position_dgeom_data(
+      SpineNode* spine_node_pt,
+      std::map<Data*, DenseMatrix<double>>& dposition_dgeom_data)
+    {
+      spine_node_pt->Node::get_dposition_dgeom_data(dposition_dgeom_data);
+    }
+
 #ifdef __clang__
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Woverloaded-virtual"
@@ -97,6 +97,10 @@ void get_memory_usage_in_bytes(double* lu_factor_memory, double* total_memory)
                   1, performs LU decomposition for the first time
                   2, performs triangular solve
                   3, free all the storage in the end
+                  4, performs LU decomposition of a matrix with the same
+                     sparsity pattern as the one whose factors are
+                     passed in f_factors: the column permutation is
+                     re-used and the old factors are freed
    n          = dimension of matrix
    nnz        = # of nonzero entries
    nrhs       = # of RHSs
@@ -111,7 +115,8 @@ void get_memory_usage_in_bytes(double* lu_factor_memory, double* total_memory)
    info       = info flag from superlu
    f_factors  = pointer to LU factors. (If op_flag == 1, it is an output
                 and contains the pointer pointing to the structure of
-                the factored matrices. Otherwise, it it an input.
+                the factored matrices. If op_flag == 4 it is both.
+                Otherwise, it it an input.
    Returns the SIGN of the determinant of the matrix
    =========================================================================
 */
@@ -154,7 +159,7 @@ int superlu(int *op_flag, int *n, int *nnz, int *nrhs,
     trans = TRANS;
   }
 
-  if (*op_flag == 1)     /* LU decomposition */
+  if ((*op_flag == 1) || (*op_flag == 4))     /* LU decomposition */
   {
 
     /* Set the default input options. */
@@ -178,8 +183,29 @@ int superlu(int *op_flag, int *n, int *nnz, int *nrhs,
          permc_spec = 2: minimum degree on structure of A'+A
          permc_spec = 3: approximate minimum degree for unsymmetric matrices
     */
-    permc_spec = options.ColPerm;
-    get_perm_c(permc_spec, &A, perm_c);
+    if (*op_flag == 4)
+    {
+      /* Re-use the column permutation of the old factors (the symbolic
+         part of the factorisation) and free them */
+      LUfactors = (factors_t*) *f_factors;
+      for (i=0; i<*n; i++)
+      {
+        perm_c[i] = LUfactors->perm_c[i];
+      }
+      SUPERLU_FREE(LUfactors->perm_r);
+      SUPERLU_FREE(LUfactors->perm_c);
+      Destroy_SuperNode_Matrix(LUfactors->L);
+      Destroy_CompCol_Matrix(LUfactors->U);
+      SUPERLU_FREE(LUfactors->L);
+      SUPERLU_FREE(LUfactors->U);
+      SUPERLU_FREE(LUfactors);
+      *f_factors = 0;
+    }
+    else
+    {
+      permc_spec = options.ColPerm;
+      get_perm_c(permc_spec, &A, perm_c);
+    }
 
     sp_preorder(&options, &A, perm_c, etree, &AC);
 
@@ -664,6 +664,27 @@ namespace oomph
     /// Interface for any actions that need to be performed after a time
     /// step.
     virtual void actions_after_timestep(Problem* problem_pt) {}
+
+    /// Factor by which the timestep should be rescaled, given the
+    /// global temporal error estimate, error, (as computed by
+    /// Problem::global_temporal_error_norm()) for the timestep that has
+    /// just been taken and the target error, epsilon. Used in
+    /// Problem::adaptive_unsteady_newton_solve(). Default: the elementary
+    /// controller (epsilon/error)^(1/(order+1)).
+    virtual double dt_rescaling_factor(Problem* problem_pt,
+                                       const double& error,
+                                       const double& epsilon)
+    {
+      return std::pow((epsilon / error), (1.0 / (1.0 + order())));
+    }
+
+    /// Interface for any actions that need to be performed once
+    /// Problem::adaptive_unsteady_newton_solve() has decided whether the
+    /// timestep that has just been taken is accepted or rejected.
+    virtual void actions_after_timestep_acceptance_check(
+      Problem* problem_pt, const bool& timestep_accepted)
+    {
+    }
   };
 
 
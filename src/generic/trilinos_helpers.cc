@@ -319,7 +319,8 @@ namespace oomph
     // method
     int* column = const_cast<int*>(oomph_matrix_pt->column_index());
     double* value = const_cast<double*>(oomph_matrix_pt->value());
-    int* row_start = const_cast<int*>(oomph_matrix_pt->row_start());
+    SparseOffset* row_start =
+      const_cast<SparseOffset*>(oomph_matrix_pt->row_start());
 
     // create the corresponding Epetra_Map
     LinearAlgebraDistribution* target_dist_pt = 0;
@@ -364,7 +365,7 @@ namespace oomph
     for (unsigned row = 0; row < nrow_local; row++)
     {
       // get pointer to this row in values/columns
-      int ptr = row_start[row + offset];
+      SparseOffset ptr = row_start[row + offset];
 #ifdef PARANOID
       int err = 0;
       err =
@@ -489,7 +490,8 @@ namespace oomph
     // method
     int* column = const_cast<int*>(oomph_matrix_pt->column_index());
     double* value = const_cast<double*>(oomph_matrix_pt->value());
-    int* row_start = const_cast<int*>(oomph_matrix_pt->row_start());
+    SparseOffset* row_start =
+      const_cast<SparseOffset*>(oomph_matrix_pt->row_start());
 
     // create the corresponding Epetra_Map
     LinearAlgebraDistribution* target_dist_pt = 0;
@@ -594,7 +596,7 @@ namespace oomph
     for (unsigned row = 0; row < nrow_local; row++)
     {
       // get pointer to this row in values/columns
-      int ptr = row_start[row + offset];
+      SparseOffset ptr = row_start[row + offset];
 #ifdef PARANOID
       int err = 0;
       err =
@@ -941,8 +943,8 @@ namespace oomph
     // extract values from Epetra matrix row by row
     double* value = new double[nnz_local];
     int* column_index = new int[nnz_local];
-    int* row_start = new int[nrow_local + 1];
-    int ptr = 0;
+    SparseOffset* row_start = new SparseOffset[nrow_local + 1];
+    SparseOffset ptr = 0;
     int num_entries = 0;
     int first = matrix_soln.first_row();
     int last = first + matrix_soln.nrow_local();
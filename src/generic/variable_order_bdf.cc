@@ -0,0 +1,581 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+#include "variable_order_bdf.h"
+#include "problem.h"
+
+namespace oomph
+{
+  //=======================================================================
+  /// Constructor: Pass the maximum order (between 1 and 5)
+  //=======================================================================
+  VariableOrderBDF::VariableOrderBDF(const unsigned& max_order)
+    : TimeStepper(max_order + 3, 1),
+      Max_order(max_order),
+      Order(1),
+      Error_estimate_order(1),
+      Next_order(1),
+      Nstep_at_current_order(0),
+      Nconsecutive_rejection(0),
+      Error(-1.0),
+      Previous_error(-1.0),
+      Dt_safety_factor(0.9),
+      Pi_integral_gain(0.3),
+      Pi_proportional_gain(0.4),
+      Order_change_threshold(1.2),
+      Nrejected_timestep(0)
+  {
+#ifdef PARANOID
+    if ((max_order < 1) || (max_order > 5))
+    {
+      std::ostringstream error_stream;
+      error_stream << "The maximum order of VariableOrderBDF must be between "
+                   << "1 and 5, not " << max_order << std::endl;
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    Type = "BDF";
+
+    // The scheme is always adaptive
+    Adaptive_Flag = true;
+
+    // Storing predicted values in slot after the previous values
+    Predictor_storage_index = max_order + 2;
+
+    // Weights for the predictor and the error estimate
+    Predictor_weight.resize(max_order + 2, 0.0);
+    Error_weight.resize(max_order + 2, 0.0);
+
+    // Statistics
+    Naccepted_timestep.resize(max_order + 1, 0);
+  }
+
+
+  //=======================================================================
+  /// Set the order of the scheme
+  //=======================================================================
+  void VariableOrderBDF::set_order(const unsigned& order)
+  {
+#ifdef PARANOID
+    if ((order < 1) || (order > Max_order))
+    {
+      std::ostringstream error_stream;
+      error_stream << "Order " << order << " is outside the range 1 to "
+                   << Max_order << std::endl;
+      throw OomphLibError(
+        error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+    Order = order;
+    Error_estimate_order = order;
+    Next_order = order;
+    Nstep_at_current_order = 0;
+    Nconsecutive_rejection = 0;
+    Error = -1.0;
+    Previous_error = -1.0;
+  }
+
+
+  //=======================================================================
+  /// Get the time levels t_{n+1-j} - t_{n+1}, j=0,...,n_level-1
+  //=======================================================================
+  void VariableOrderBDF::get_relative_time_levels(const unsigned& n_level,
+                                                  Vector<double>& tau) const
+  {
+    tau.resize(n_level);
+    tau[0] = 0.0;
+    for (unsigned j = 1; j < n_level; j++)
+    {
+      tau[j] = tau[j - 1] - Time_pt->dt(j - 1);
+    }
+  }
+
+
+  //=======================================================================
+  /// Initialise the time-history for the Data values,
+  /// corresponding to an impulsive start.
+  //=======================================================================
+  void VariableOrderBDF::assign_initial_values_impulsive(Data* const& data_pt)
+  {
+    // Find number of values stored
+    unsigned n_value = data_pt->nvalue();
+    // Loop over values
+    for (unsigned j = 0; j < n_value; j++)
+    {
+      // Set previous values and prediction to the initial value,
+      // if not a copy
+      if (data_pt->is_a_copy(j) == false)
+      {
+        for (unsigned t = 1; t <= Max_order + 2; t++)
+        {
+          data_pt->set_value(t, j, data_pt->value(j));
+        }
+      }
+    }
+
+    // Restart at first order
+    set_order(1);
+  }
+
+
+  //=======================================================================
+  /// Initialise the time-history for the nodal positions
+  /// corresponding to an impulsive start.
+  //=======================================================================
+  void VariableOrderBDF::assign_initial_positions_impulsive(
+    Node* const& node_pt)
+  {
+    // Find the dimension of the node
+    unsigned n_dim = node_pt->ndim();
+    // Find the number of position types at the node
+    unsigned n_position_type = node_pt->nposition_type();
+
+    // Loop over the position variables
+    for (unsigned i = 0; i < n_dim; i++)
+    {
+      // If the position is not copied
+      if (node_pt->position_is_a_copy(i) == false)
+      {
+        // Loop over the position types
+        for (unsigned k = 0; k < n_position_type; k++)
+        {
+          // Set previous values and prediction to the initial value
+          for (unsigned t = 1; t <= Max_order + 2; t++)
+          {
+            node_pt->x_gen(t, k, i) = node_pt->x_gen(k, i);
+          }
+        }
+      }
+    }
+
+    // Restart at first order
+    set_order(1);
+  }
+
+
+  //=======================================================================
+  /// Push the values backwards to advance to the next timestep
+  //=======================================================================
+  void VariableOrderBDF::shift_time_values(Data* const& data_pt)
+  {
+    // Find number of values stored
+    unsigned n_value = data_pt->nvalue();
+
+    // Loop over the values
+    for (unsigned j = 0; j < n_value; j++)
+    {
+      // Set previous values to the previous value, if not a copy
+      if (data_pt->is_a_copy(j) == false)
+      {
+        // Loop over times, in reverse order
+        for (unsigned t = Max_order + 1; t > 0; t--)
+        {
+          data_pt->set_value(t, j, data_pt->value(t - 1, j));
+        }
+      }
+    }
+  }
+
+
+  //=======================================================================
+  /// Push the nodal positions backwards to advance to the next timestep
+  //=======================================================================
+  void VariableOrderBDF::shift_time_positions(Node* const& node_pt)
+  {
+    // Find the number of coordinates
+    unsigned n_dim = node_pt->ndim();
+    // Find the number of position types
+    unsigned n_position_type = node_pt->nposition_type();
+
+    // Loop over the positions
+    for (unsigned i = 0; i < n_dim; i++)
+    {
+      // If the position is not a copy
+      if (node_pt->position_is_a_copy(i) == false)
+      {
+        // Loop over the position types
+        for (unsigned k = 0; k < n_position_type; k++)
+        {
+          // Loop over stored times, and set values to previous values
+          for (unsigned t = Max_order + 1; t > 0; t--)
+          {
+            node_pt->x_gen(t, k, i) = node_pt->x_gen(t - 1, k, i);
+          }
+        }
+      }
+    }
+  }
+
+
+  //=======================================================================
+  /// Assign the weights: Derivative of the polynomial that interpolates
+  /// the current and the Order previous values, evaluated at the
+  /// current time.
+  //=======================================================================
+  void VariableOrderBDF::set_weights()
+  {
+    Vector<double> tau;
+    get_relative_time_levels(Order + 1, tau);
+
+    unsigned n_tstorage = ntstorage();
+    for (unsigned t = 0; t < n_tstorage; t++)
+    {
+      Weight(1, t) = 0.0;
+    }
+
+    for (unsigned j = 1; j <= Order; j++)
+    {
+      Weight(1, 0) += 1.0 / (tau[0] - tau[j]);
+
+      double numerator = 1.0;
+      double denominator = tau[j] - tau[0];
+      for (unsigned l = 1; l <= Order; l++)
+      {
+        if (l != j)
+        {
+          numerator *= tau[0] - tau[l];
+          denominator *= tau[j] - tau[l];
+        }
+      }
+      Weight(1, j) = numerator / denominator;
+    }
+  }
+
+
+  //=======================================================================
+  /// Set the predictor weights: Extrapolation of the polynomial that
+  /// interpolates the Order+1 previous values to the current time.
+  //=======================================================================
+  void VariableOrderBDF::set_predictor_weights()
+  {
+    Vector<double> tau;
+    get_relative_time_levels(Order + 2, tau);
+
+    unsigned n_weight = Predictor_weight.size();
+    for (unsigned j = 0; j < n_weight; j++)
+    {
+      Predictor_weight[j] = 0.0;
+    }
+
+    for (unsigned j = 1; j <= Order + 1; j++)
+    {
+      double weight = 1.0;
+      for (unsigned l = 1; l <= Order + 1; l++)
+      {
+        if (l != j)
+        {
+          weight *= (tau[0] - tau[l]) / (tau[j] - tau[l]);
+        }
+      }
+      Predictor_weight[j] = weight;
+    }
+  }
+
+
+  //=======================================================================
+  /// Calculate the predicted values and store them at the appropriate
+  /// location in the data structure
+  /// This function must be called after the time-values have been shifted!
+  //=======================================================================
+  void VariableOrderBDF::calculate_predicted_values(Data* const& data_pt)
+  {
+    // Find number of values
+    unsigned n_value = data_pt->nvalue();
+    // Loop over the values
+    for (unsigned j = 0; j < n_value; j++)
+    {
+      // If the value is not copied
+      if (data_pt->is_a_copy(j) == false)
+      {
+        double predicted_value = 0.0;
+        for (unsigned t = 1; t <= Order + 1; t++)
+        {
+          predicted_value += data_pt->value(t, j) * Predictor_weight[t];
+        }
+        data_pt->set_value(Predictor_storage_index, j, predicted_value);
+      }
+    }
+  }
+
+
+  //=======================================================================
+  /// Calculate predictions for the positions
+  //=======================================================================
+  void VariableOrderBDF::calculate_predicted_positions(Node* const& node_pt)
+  {
+    // Find number of dimensions of the problem
+    unsigned n_dim = node_pt->ndim();
+    // Loop over the dimensions
+    for (unsigned j = 0; j < n_dim; j++)
+    {
+      // If the node is not copied
+      if (node_pt->position_is_a_copy(j) == false)
+      {
+        double predicted_value = 0.0;
+        for (unsigned t = 1; t <= Order + 1; t++)
+        {
+          predicted_value += node_pt->x(t, j) * Predictor_weight[t];
+        }
+        node_pt->x(Predictor_storage_index, j) = predicted_value;
+      }
+    }
+  }
+
+
+  //=======================================================================
+  /// Set the error weights for the scheme of order q=Error_estimate_order.
+  /// Its local truncation error is
+  /// \f[ y[t_{n+1},...,t_{n-q}] \prod_{j=1}^q (t_{n+1}-t_{n+1-j}) / w_0 \f]
+  /// where \f$ w_0 \f$ is the weight of the current value in the
+  /// time derivative and \f$ y[\ldots] \f$ is the divided difference
+  /// of the current and the q+1 previous values. For q=Order, this is
+  /// the usual multiple of the difference between the current
+  /// and the predicted value.
+  //=======================================================================
+  void VariableOrderBDF::set_error_weights()
+  {
+    const unsigned q = Error_estimate_order;
+
+    Vector<double> tau;
+    get_relative_time_levels(q + 2, tau);
+
+    // Scaling factor
+    double w0 = 0.0;
+    double product = 1.0;
+    for (unsigned j = 1; j <= q; j++)
+    {
+      w0 += 1.0 / (tau[0] - tau[j]);
+      product *= tau[0] - tau[j];
+    }
+    double scaling = product / w0;
+
+    unsigned n_weight = Error_weight.size();
+    for (unsigned j = 0; j < n_weight; j++)
+    {
+      Error_weight[j] = 0.0;
+    }
+
+    // Weights for the divided difference
+    for (unsigned j = 0; j <= q + 1; j++)
+    {
+      double denominator = 1.0;
+      for (unsigned l = 0; l <= q + 1; l++)
+      {
+        if (l != j)
+        {
+          denominator *= tau[j] - tau[l];
+        }
+      }
+      Error_weight[j] = scaling / denominator;
+    }
+  }
+
+
+  //===================================================================
+  /// Function to compute the error in position i at node
+  //===================================================================
+  double VariableOrderBDF::temporal_error_in_position(Node* const& node_pt,
+                                                     const unsigned& i)
+  {
+    double error = 0.0;
+    const unsigned n_level = Error_estimate_order + 2;
+    for (unsigned t = 0; t < n_level; t++)
+    {
+      error += Error_weight[t] * node_pt->x(t, i);
+    }
+    return error;
+  }
+
+
+  //=========================================================================
+  /// Function to calculate the error in the data value i
+  //=========================================================================
+  double VariableOrderBDF::temporal_error_in_value(Data* const& data_pt,
+                                                  const unsigned& i)
+  {
+    double error = 0.0;
+    const unsigned n_level = Error_estimate_order + 2;
+    for (unsigned t = 0; t < n_level; t++)
+    {
+      error += Error_weight[t] * data_pt->value(t, i);
+    }
+    return error;
+  }
+
+
+  //=========================================================================
+  /// Return the global temporal error estimate for the scheme of
+  /// the given order
+  //=========================================================================
+  double VariableOrderBDF::global_temporal_error_norm_at_order(
+    Problem* problem_pt, const unsigned& order)
+  {
+    Error_estimate_order = order;
+    set_error_weights();
+    double error =
+      std::max(std::abs(problem_pt->global_temporal_error_norm()), 1e-12);
+
+    // Reset the error weights for the current order
+    Error_estimate_order = Order;
+    set_error_weights();
+
+    return error;
+  }
+
+
+  //=========================================================================
+  /// PI control of the timestep and selection of the order for
+  /// the next timestep. If the error exceeds the tolerance (so the
+  /// timestep will be rejected) the elementary controller is used for the
+  /// repeated step. Otherwise the timestep is controlled by the PI
+  /// controller
+  /// \f[ \Delta t_{n+1} = s \, \Delta t_n
+  ///     (\epsilon/e_n)^{k_I/(k+1)} (e_{n-1}/e_n)^{k_P/(k+1)} \f]
+  /// (Gustafsson's controller), where \f$ k \f$ is the order. Once
+  /// order+1 timesteps have been taken at the present order, the error
+  /// estimates for the schemes of order \f$ k \pm 1 \f$ are computed
+  /// and the order that allows the largest timestep is selected
+  /// (an increase of the order has to increase the timestep by at least
+  /// the factor Order_change_threshold).
+  //=========================================================================
+  double VariableOrderBDF::dt_rescaling_factor(Problem* problem_pt,
+                                               const double& error,
+                                               const double& epsilon)
+  {
+    Error = error;
+    Next_order = Order;
+
+    const double k = double(Order);
+
+    // Elementary controller for the current order
+    double elementary_factor =
+      Dt_safety_factor * std::pow(epsilon / error, 1.0 / (k + 1.0));
+
+    // Repeat the step with the elementary controller
+    if (error > epsilon)
+    {
+      return elementary_factor;
+    }
+
+    // PI controller (elementary controller if there's no previous error)
+    double factor = elementary_factor;
+    if (Previous_error > 0.0)
+    {
+      factor = Dt_safety_factor *
+               std::pow(epsilon / error, Pi_integral_gain / (k + 1.0)) *
+               std::pow(Previous_error / error, Pi_proportional_gain / (k + 1.0));
+    }
+
+    // Consider a change of order?
+    if (Nstep_at_current_order >= Order + 1)
+    {
+      double best_factor = elementary_factor;
+
+      // Lower order: Accept if it allows a larger timestep
+      if (Order > 1)
+      {
+        double error_lower =
+          global_temporal_error_norm_at_order(problem_pt, Order - 1);
+        double factor_lower =
+          Dt_safety_factor * std::pow(epsilon / error_lower, 1.0 / k);
+        if (factor_lower > best_factor)
+        {
+          best_factor = factor_lower;
+          Next_order = Order - 1;
+        }
+      }
+
+      // Higher order: Accept if it allows a sufficiently larger timestep
+      if (Order < Max_order)
+      {
+        double error_higher =
+          global_temporal_error_norm_at_order(problem_pt, Order + 1);
+        double factor_higher =
+          Dt_safety_factor * std::pow(epsilon / error_higher, 1.0 / (k + 2.0));
+        if (factor_higher > Order_change_threshold * best_factor)
+        {
+          best_factor = factor_higher;
+          Next_order = Order + 1;
+        }
+      }
+
+      if (Next_order != Order)
+      {
+        factor = best_factor;
+      }
+    }
+
+    return factor;
+  }
+
+
+  //=========================================================================
+  /// Update the controller history and the order, depending on
+  /// whether the timestep has been accepted.
+  //=========================================================================
+  void VariableOrderBDF::actions_after_timestep_acceptance_check(
+    Problem* problem_pt, const bool& timestep_accepted)
+  {
+    if (timestep_accepted)
+    {
+      Naccepted_timestep[Order]++;
+      Nconsecutive_rejection = 0;
+
+      if (Next_order != Order)
+      {
+        oomph_info << "VariableOrderBDF: Changing order from " << Order
+                   << " to " << Next_order << std::endl;
+        set_order(Next_order);
+      }
+      else
+      {
+        Nstep_at_current_order++;
+        Previous_error = Error;
+      }
+    }
+    else
+    {
+      Nrejected_timestep++;
+      Nconsecutive_rejection++;
+      Next_order = Order;
+
+      // Drop the order after repeated failures
+      if ((Nconsecutive_rejection >= 2) && (Order > 1))
+      {
+        oomph_info << "VariableOrderBDF: Reducing order from " << Order
+                   << " to " << Order - 1 << " after "
+                   << Nconsecutive_rejection << " rejected timesteps"
+                   << std::endl;
+        set_order(Order - 1);
+      }
+    }
+
+    // The error estimate has been used
+    Error = -1.0;
+  }
+
+} // namespace oomph
@@ -0,0 +1,275 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+#ifndef OOMPH_VARIABLE_ORDER_BDF_H
+#define OOMPH_VARIABLE_ORDER_BDF_H
+
+// Config header generated by autoconfig
+#ifdef HAVE_CONFIG_H
+#include <oomph-lib-config.h>
+#endif
+
+// oomph-lib headers
+#include "Vector.h"
+#include "nodes.h"
+#include "matrices.h"
+#include "timesteppers.h"
+
+namespace oomph
+{
+  // Forward decl. so that we can have function of Problem*
+  class Problem;
+
+
+  //====================================================================
+  /// Variable-order, variable-timestep BDF timestepper. The order
+  /// (between 1 and the maximum order specified in the constructor; at
+  /// most 5) and the size of the next timestep are chosen after each
+  /// step of Problem::adaptive_unsteady_newton_solve(...):
+  /// - The timestep is controlled by a PI controller, based on the
+  ///   global temporal error estimates (as computed by
+  ///   Problem::global_temporal_error_norm()) for the present and the
+  ///   previous timestep.
+  /// - Once the scheme has taken order+1 steps at the present order, the
+  ///   temporal error is also estimated for the schemes of one order lower
+  ///   and higher; the order is changed if this allows a sufficiently
+  ///   larger timestep.
+  ///
+  /// The weights for the time derivative are obtained from the
+  /// derivative of the polynomial that interpolates the current and the
+  /// previous values at the actual (variable) time levels. The predictor
+  /// extrapolates the polynomial that interpolates the previous values
+  /// to the new time level; the temporal error is estimated from the
+  /// divided differences of the current and the previous values.
+  ///
+  /// A time data set consists of
+  /// [y_np1, y_n, ..., y_{n-max_order}, y^P_np1]
+  /// i.e. the present value, max_order+1 previous values and the
+  /// prediction for the present value.
+  ///
+  /// After an impulsive start (or after re-assigning the initial
+  /// conditions by assign_initial_values_impulsive()) the scheme
+  /// restarts at first order.
+  //====================================================================
+  class VariableOrderBDF : public TimeStepper
+  {
+  public:
+    /// Constructor: Pass the maximum order (between 1 and 5;
+    /// defaults to 5)
+    VariableOrderBDF(const unsigned& max_order = 5);
+
+    /// Broken copy constructor
+    VariableOrderBDF(const VariableOrderBDF&) = delete;
+
+    /// Broken assignment operator
+    void operator=(const VariableOrderBDF&) = delete;
+
+    /// Return the actual (current) order of the scheme
+    unsigned order() const
+    {
+      return Order;
+    }
+
+    /// Maximum order of the scheme
+    unsigned max_order() const
+    {
+      return Max_order;
+    }
+
+    /// Set the order of the scheme (e.g. to restart at a higher order
+    /// if the time history has been set up with
+    /// assign_initial_data_values(...)).
+    void set_order(const unsigned& order);
+
+    /// Safety factor applied to the rescaling of the timestep
+    /// (defaults to 0.9)
+    double& dt_safety_factor()
+    {
+      return Dt_safety_factor;
+    }
+
+    /// Integral gain of the PI controller (scaled by 1/(order+1);
+    /// defaults to 0.3)
+    double& pi_integral_gain()
+    {
+      return Pi_integral_gain;
+    }
+
+    /// Proportional gain of the PI controller (scaled by 1/(order+1);
+    /// defaults to 0.4)
+    double& pi_proportional_gain()
+    {
+      return Pi_proportional_gain;
+    }
+
+    /// The order is only changed if the rescaling factor for the
+    /// timestep at the new order exceeds that for the present order by
+    /// this factor (defaults to 1.2)
+    double& order_change_threshold()
+    {
+      return Order_change_threshold;
+    }
+
+    /// Number of timesteps that have been accepted at each order
+    /// (entry 0 is unused)
+    const Vector<unsigned>& naccepted_timestep() const
+    {
+      return Naccepted_timestep;
+    }
+
+    /// Number of timesteps that have been rejected
+    unsigned nrejected_timestep() const
+    {
+      return Nrejected_timestep;
+    }
+
+    /// Initialise the time-history for the Data values,
+    /// corresponding to an impulsive start (also resets the order to one)
+    void assign_initial_values_impulsive(Data* const& data_pt);
+
+    /// Initialise the time-history for the nodal positions
+    /// corresponding to an impulsive start (also resets the order to one)
+    void assign_initial_positions_impulsive(Node* const& node_pt);
+
+    /// This function updates the Data's time history so that
+    /// we can advance to the next timestep
+    void shift_time_values(Data* const& data_pt);
+
+    /// This function advances the time history of the positions
+    /// at a node.
+    void shift_time_positions(Node* const& node_pt);
+
+    /// Set the weights for the present order and timestep
+    void set_weights();
+
+    /// Number of previous values available.
+    unsigned nprev_values() const
+    {
+      return Max_order + 1;
+    }
+
+    /// Number of timestep increments that need to be stored by the scheme
+    unsigned ndt() const
+    {
+      return Max_order + 1;
+    }
+
+    /// Function to set the predictor weights
+    void set_predictor_weights();
+
+    /// Function to calculate predicted positions at a node
+    void calculate_predicted_positions(Node* const& node_pt);
+
+    /// Function to calculate predicted data values in a Data object
+    void calculate_predicted_values(Data* const& data_pt);
+
+    /// Function to set the error weights for the error estimate
+    /// at the order specified by Error_estimate_order
+    void set_error_weights();
+
+    /// Compute the error in the position i at a node
+    double temporal_error_in_position(Node* const& node_pt, const unsigned& i);
+
+    /// Compute the error in the value i in a Data structure
+    double temporal_error_in_value(Data* const& data_pt, const unsigned& i);
+
+    /// PI control of the timestep and selection of the order for
+    /// the next timestep
+    double dt_rescaling_factor(Problem* problem_pt,
+                               const double& error,
+                               const double& epsilon);
+
+    /// Update the controller history and the order, depending on
+    /// whether the timestep has been accepted
+    void actions_after_timestep_acceptance_check(Problem* problem_pt,
+                                                 const bool& timestep_accepted);
+
+  private:
+    /// Get the time levels t_{n+1-j} - t_{n+1}, j=0,...,n_level-1
+    void get_relative_time_levels(const unsigned& n_level,
+                                  Vector<double>& tau) const;
+
+    /// Return the global temporal error estimate for the scheme of
+    /// the given order
+    double global_temporal_error_norm_at_order(Problem* problem_pt,
+                                               const unsigned& order);
+
+    /// Maximum order
+    unsigned Max_order;
+
+    /// Current order
+    unsigned Order;
+
+    /// Order for which the temporal error is estimated (normally the
+    /// current order)
+    unsigned Error_estimate_order;
+
+    /// Order to be used for the next timestep if the present
+    /// one is accepted
+    unsigned Next_order;
+
+    /// Number of timesteps accepted since the last change of order
+    /// (or the impulsive start)
+    unsigned Nstep_at_current_order;
+
+    /// Number of consecutive rejections of the present timestep
+    unsigned Nconsecutive_rejection;
+
+    /// Global temporal error estimate for the timestep that
+    /// has just been taken
+    double Error;
+
+    /// Global temporal error estimate for the previous (accepted)
+    /// timestep; negative if not available.
+    double Previous_error;
+
+    /// Safety factor applied to the rescaling of the timestep
+    double Dt_safety_factor;
+
+    /// Integral gain of the PI controller
+    double Pi_integral_gain;
+
+    /// Proportional gain of the PI controller
+    double Pi_proportional_gain;
+
+    /// Threshold for changes of order
+    double Order_change_threshold;
+
+    /// Predictor weights for the previous values
+    Vector<double> Predictor_weight;
+
+    /// Error weights for the current and previous values
+    Vector<double> Error_weight;
+
+    /// Number of timesteps accepted at each order
+    Vector<unsigned> Naccepted_timestep;
+
+    /// Number of timesteps rejected
+    unsigned Nrejected_timestep;
+  };
+
+} // namespace oomph
+
+#endif
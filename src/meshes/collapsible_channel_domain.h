@@ -210,6 +210,24 @@ namespace oomph
                                 Vector<double>& r);
 
 
+    /// Analytic derivatives of the vector representation of the
+    /// imacro-th macro element boundary idirect (N/S/W/E) at the current
+    /// time w.r.t. the Data that the wall GeomObject depends on (so the
+    /// set of Data that's passed in isn't needed):
+    /// df_dgeom_data[data_pt](i,k) = df_i / d (k-th value of data_pt).
+    /// Points on the boundaries in the collapsible section are located at
+    /// a fixed fraction of the straight line from the bottom wall to a
+    /// fixed point on the upper wall, so their derivatives are that
+    /// fraction times the derivatives of the wall's position, provided
+    /// by GeomObject::dposition_dgeom_data(...).
+    void dmacro_element_boundary_dgeom_data(
+      const unsigned& imacro,
+      const unsigned& idirect,
+      const Vector<double>& zeta,
+      const std::set<Data*>& geom_data_pt,
+      std::map<Data*, DenseMatrix<double>>& df_dgeom_data);
+
+
     /// Rotate the domain (for axisymmetric problems)
     void enable_rotate_domain()
     {
@@ -485,6 +503,95 @@ namespace oomph
   }
 
 
+  //===================================================================
+  /// Analytic derivatives of the vector representation of the
+  /// imacro-th macro element boundary idirect (N/S/W/E) at the current
+  /// time w.r.t. the Data that the wall GeomObject depends on:
+  /// df_dgeom_data[data_pt](i,k) = df_i / d (k-th value of data_pt)
+  //=================================================================
+  void CollapsibleChannelDomain::dmacro_element_boundary_dgeom_data(
+    const unsigned& imacro,
+    const unsigned& idirect,
+    const Vector<double>& zeta,
+    const std::set<Data*>& geom_data_pt,
+    std::map<Data*, DenseMatrix<double>>& df_dgeom_data)
+  {
+    using namespace QuadTreeNames;
+
+    df_dgeom_data.clear();
+
+    // Determines the "coordinates" of the macro-element
+    unsigned x = unsigned(imacro % (Nup + Ncollapsible + Ndown));
+    unsigned y = unsigned(double(imacro) / double(Nup + Ncollapsible + Ndown));
+
+    // The boundaries in the upstream and downstream sections don't move
+    if ((x < Nup) || (x >= Nup + Ncollapsible)) return;
+
+    // Lagrangian coordinate of the point on the upper wall and fractional
+    // position along the straight line from the bottom wall to that point
+    // (see r_N_collapsible(...) etc.)
+    Vector<double> xi(1);
+    double fract = 0.0;
+    if ((idirect == N) || (idirect == S))
+    {
+      xi[0] = (double(x - Nup) + (0.5 * (1.0 + zeta[0]))) *
+              (Lcollapsible / double(Ncollapsible));
+      if (idirect == N)
+      {
+        fract = (double(y) + 1.0) / double(Ny);
+      }
+      else
+      {
+        fract = double(y) / double(Ny);
+      }
+    }
+    else
+    {
+      if (idirect == W)
+      {
+        xi[0] = double(x - Nup) * (Lcollapsible / double(Ncollapsible));
+      }
+      else
+      {
+        xi[0] =
+          (double(x - Nup) + 1.0) * (Lcollapsible / double(Ncollapsible));
+      }
+      fract = (double(y) + (0.5 * (1.0 + zeta[0]))) / double(Ny);
+    }
+
+    // Map it via squash fct
+    fract = s_squash(fract);
+
+    // Get the derivatives of the position on the wall...
+    Wall_pt->dposition_dgeom_data(xi, df_dgeom_data);
+
+    // ...and scale (and rotate) them
+    for (std::map<Data*, DenseMatrix<double>>::iterator it =
+           df_dgeom_data.begin();
+         it != df_dgeom_data.end();
+         it++)
+    {
+      DenseMatrix<double>& df_ddata = it->second;
+      unsigned n_value = df_ddata.ncol();
+      for (unsigned k = 0; k < n_value; k++)
+      {
+        double df0 = fract * df_ddata(0, k);
+        double df1 = fract * df_ddata(1, k);
+        if (Rotate_domain)
+        {
+          df_ddata(0, k) = df1;
+          df_ddata(1, k) = -df0;
+        }
+        else
+        {
+          df_ddata(0, k) = df0;
+          df_ddata(1, k) = df1;
+        }
+      }
+    }
+  }
+
+
   //===========================================================================
   /// Western edge of the  macro element in the upstream (part=0)
   /// or downstream (part=1) parts of the channel; \f$ \zeta \in [-1,1] \f$
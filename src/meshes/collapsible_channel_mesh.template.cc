@@ -316,6 +316,54 @@ namespace oomph
   }
 
 
+  //======================================================================
+  /// Analytic derivatives of the (current) position of the given node
+  /// w.r.t. the Data that the wall GeomObject depends on:
+  /// dposition_dgeom_data[data_pt](i,k) = dx_i / d (k-th value of data_pt)
+  //======================================================================
+  template<class ELEMENT>
+  void AlgebraicCollapsibleChannelMesh<ELEMENT>::
+    get_dalgebraic_node_position_dgeom_data(
+      AlgebraicNode* node_pt,
+      std::map<Data*, DenseMatrix<double>>& dposition_dgeom_data)
+  {
+    dposition_dgeom_data.clear();
+
+    // Nodes outside the collapsible section don't move
+    if (node_pt->ngeom_object() == 0) return;
+
+    // Fractional position along the straight line from the bottom
+    // to the reference point on the upper wall (see algebraic_node_update())
+    double fract = node_pt->ref_value(1);
+
+    // Reference local coordinate in the GeomObject that represents the
+    // upper wall
+    Vector<double> s(1);
+    s[0] = node_pt->ref_value(2);
+
+    // Get the derivatives of the position on the wall...
+    node_pt->geom_object_pt(0)->dposition_dgeom_data(s, dposition_dgeom_data);
+
+    // ...and scale them
+    for (std::map<Data*, DenseMatrix<double>>::iterator it =
+           dposition_dgeom_data.begin();
+         it != dposition_dgeom_data.end();
+         it++)
+    {
+      DenseMatrix<double>& dx_ddata = it->second;
+      unsigned n_row = dx_ddata.nrow();
+      unsigned n_col = dx_ddata.ncol();
+      for (unsigned i = 0; i < n_row; i++)
+      {
+        for (unsigned k = 0; k < n_col; k++)
+        {
+          dx_ddata(i, k) *= fract;
+        }
+      }
+    }
+  }
+
+
   //=====start_setup=================================================
   /// Setup algebraic mesh update -- assumes that mesh has
   /// initially been set up with a flush upper wall
@@ -561,6 +561,16 @@ namespace oomph
     /// t>0: previous)
     void algebraic_node_update(const unsigned& t, AlgebraicNode*& node_pt);
 
+    /// Analytic derivatives of the (current) position of the given
+    /// node w.r.t. the Data that the wall GeomObject depends on: the node
+    /// is located at a fixed fraction of the straight line from the bottom
+    /// wall to a fixed point on the upper wall, so dx_i/d(wall data) =
+    /// fraction * dr_wall_i/d(wall data). The derivatives of the wall's
+    /// position are provided by GeomObject::dposition_dgeom_data(...).
+    void get_dalgebraic_node_position_dgeom_data(
+      AlgebraicNode* node_pt,
+      std::map<Data*, DenseMatrix<double>>& dposition_dgeom_data);
+
     /// Update the node-udate data after mesh adaptation.
     /// Empty -- no update of node update required as this is
     /// non-refineable mesh.
@@ -345,6 +345,7 @@ namespace oomph
       Node_pt.resize(nnod);
       nel = new_mesh_pt->nelement();
       Element_pt.resize(nel);
+      this->increment_element_storage_generation();
       for (unsigned j = 0; j < nnod; j++)
       {
         Node_pt[j] = new_mesh_pt->node_pt(j);
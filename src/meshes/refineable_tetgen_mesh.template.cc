@@ -1076,6 +1076,14 @@ namespace oomph
         //---------------------------------------
         ProjectionProblem<ELEMENT>* project_problem_pt =
           new ProjectionProblem<ELEMENT>;
+
+        // Document timings for the assembly and (re-)solves of the
+        // projection problems
+        if (Print_timings_projection)
+        {
+          project_problem_pt->enable_timings_projection();
+        }
+
         project_problem_pt->mesh_pt() = new_mesh_pt;
         project_problem_pt->project(this);
         delete project_problem_pt;
@@ -1114,6 +1122,7 @@ namespace oomph
       Node_pt.resize(nnod);
       nel = new_mesh_pt->nelement();
       Element_pt.resize(nel);
+      this->increment_element_storage_generation();
       for (unsigned j = 0; j < nnod; j++)
       {
         Node_pt[j] = new_mesh_pt->node_pt(j);
@@ -226,6 +226,18 @@ namespace oomph
       Projection_is_disabled = false;
     }
 
+    /// Enables info. and timings for projection
+    void enable_timings_projection()
+    {
+      Print_timings_projection = true;
+    }
+
+    /// Disables info. and timings for projection
+    void disable_timings_projection()
+    {
+      Print_timings_projection = false;
+    }
+
 
   protected:
     /// Helper function to initialise data associated with adaptation
@@ -238,6 +250,9 @@ namespace oomph
 
       /// By default we project solution onto new mesh during adaptation
       Projection_is_disabled = false;
+
+      // Don't doc the timings of the projection
+      Print_timings_projection = false;
     }
 
     // Update the surface
@@ -254,6 +269,9 @@ namespace oomph
     /// Disable projection of solution onto new mesh during adaptation
     bool Projection_is_disabled;
 
+    /// Doc info. and timings for the projection?
+    bool Print_timings_projection;
+
     /// Corner elements which have all of their nodes on the outer
     /// boundary are to be split into elements which have some non-boundary
     /// nodes
@@ -52,7 +52,8 @@ namespace oomph
     const double& h,
     TimeStepper* time_stepper_pt)
     : RectangularQuadMesh<ELEMENT>(
-        nx, ny, 0.0, lx, 0.0, h, false, false, time_stepper_pt)
+        nx, ny, 0.0, lx, 0.0, h, false, false, time_stepper_pt),
+      Use_analytic_dspine_node_position_dgeom_data(false)
   {
     // Mesh can only be built with 2D Qelements.
     MeshChecker::assert_geometric_element<QElementGeometricBase, ELEMENT>(2);
@@ -89,7 +90,8 @@ namespace oomph
     const bool& periodic_in_x,
     TimeStepper* time_stepper_pt)
     : RectangularQuadMesh<ELEMENT>(
-        nx, ny, 0.0, lx, 0.0, h, periodic_in_x, false, time_stepper_pt)
+        nx, ny, 0.0, lx, 0.0, h, periodic_in_x, false, time_stepper_pt),
+      Use_analytic_dspine_node_position_dgeom_data(false)
   {
     // Mesh can only be built with 2D Qelements.
     MeshChecker::assert_geometric_element<QElementGeometricBase, ELEMENT>(2);
@@ -82,11 +82,51 @@ namespace oomph
       spine_node_pt->x(1) = this->Ymin + W * H;
     }
 
+    /// Use the analytic derivatives of the nodal positions w.r.t. the
+    /// spine heights, dy/dH = W, which are only correct for the node
+    /// update implemented in SingleLayerSpineMesh::spine_node_update(...).
+    /// Don't enable this in derived meshes that overload the node update.
+    void enable_analytic_dspine_node_position_dgeom_data()
+    {
+      Use_analytic_dspine_node_position_dgeom_data = true;
+    }
+
+    /// Finite difference the node update to obtain the derivatives of
+    /// the nodal positions w.r.t. the spine heights (the default)
+    void disable_analytic_dspine_node_position_dgeom_data()
+    {
+      Use_analytic_dspine_node_position_dgeom_data = false;
+    }
+
+    /// Derivatives of the position of the spine node w.r.t. the spine
+    /// height: analytic (only y depends on it, dy/dH = W) if enabled,
+    /// otherwise obtained by finite differencing the node update.
+    virtual void get_dspine_node_position_dgeom_data(
+      SpineNode* spine_node_pt,
+      std::map<Data*, DenseMatrix<double>>& dposition_dgeom_data)
+    {
+      if (!Use_analytic_dspine_node_position_dgeom_data)
+      {
+        SpineMesh::get_dspine_node_position_dgeom_data(spine_node_pt,
+                                                       dposition_dgeom_data);
+        return;
+      }
+      dposition_dgeom_data.clear();
+      DenseMatrix<double>& dx_dh =
+        dposition_dgeom_data[spine_node_pt->spine_pt()->spine_height_pt()];
+      dx_dh.resize(spine_node_pt->ndim(), 1, 0.0);
+      dx_dh(1, 0) = spine_node_pt->fraction();
+    }
+
 
   protected:
     /// Helper function to actually build the single-layer spine mesh
     /// (called from various constructors)
     virtual void build_single_layer_mesh(TimeStepper* time_stepper_pt);
+
+    /// Use the analytic derivatives of the nodal positions w.r.t. the
+    /// spine heights? Default: false
+    bool Use_analytic_dspine_node_position_dgeom_data;
   };
 
 } // namespace oomph
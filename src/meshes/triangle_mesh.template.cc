@@ -31332,6 +31332,13 @@ namespace oomph
         ProjectionProblem<ELEMENT>* project_problem_pt =
           new ProjectionProblem<ELEMENT>;
 
+        // Document timings for the assembly and (re-)solves of the
+        // projection problems
+        if (Print_timings_projection)
+        {
+          project_problem_pt->enable_timings_projection();
+        }
+
         // Projection requires to be enabled as distributed if working
         // with a distributed mesh
 #ifdef OOMPH_HAS_MPI
@@ -31518,6 +31525,7 @@ namespace oomph
       Node_pt.resize(nnod);
       nel = new_mesh_pt->nelement();
       Element_pt.resize(nel);
+      this->increment_element_storage_generation();
       for (unsigned j = 0; j < nnod; j++)
       {
         Node_pt[j] = new_mesh_pt->node_pt(j);
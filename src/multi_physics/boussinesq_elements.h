@@ -330,6 +330,20 @@ namespace oomph
         residuals);
     }
 
+    /// The analytic products of the Hessian with the vectors Y and C
+    /// provided by the advection-diffusion equations ignore the
+    /// advection of the temperature by the (unknown) velocity, and the
+    /// Navier-Stokes equations do not provide them: Use the (broken)
+    /// default.
+    void fill_in_contribution_to_hessian_vector_products(
+      Vector<double> const& Y,
+      DenseMatrix<double> const& C,
+      DenseMatrix<double>& product)
+    {
+      FiniteElement::fill_in_contribution_to_hessian_vector_products(
+        Y, C, product);
+    }
+
 
 //-----------Finite-difference the entire jacobian-----------------------
 //-----------------------------------------------------------------------
@@ -1260,6 +1274,18 @@ namespace oomph
         DIM>::fill_in_contribution_to_residuals(residuals);
     }
 
+    /// Products of the Hessian with the vectors Y and C: Use the
+    /// (broken) default, for the same reasons as in
+    /// BuoyantQCrouzeixRaviartElement.
+    void fill_in_contribution_to_hessian_vector_products(
+      Vector<double> const& Y,
+      DenseMatrix<double> const& C,
+      DenseMatrix<double>& product)
+    {
+      FiniteElement::fill_in_contribution_to_hessian_vector_products(
+        Y, C, product);
+    }
+
 
     /// Compute the element's residual Vector and the jacobian matrix
     /// using full finite differences, the default implementation
@@ -472,6 +472,20 @@ namespace oomph
     } // end of get_wind_adv_diff
 
 
+    /// The wind depends on the (external) fluid velocity, so the
+    /// residuals are not linear in the unknowns and the advection-diffusion
+    /// equations' analytic products of the Hessian with the vectors Y and
+    /// C do not apply: Use the (broken) default.
+    void fill_in_contribution_to_hessian_vector_products(
+      Vector<double> const& Y,
+      DenseMatrix<double> const& C,
+      DenseMatrix<double>& product)
+    {
+      FiniteElement::fill_in_contribution_to_hessian_vector_products(
+        Y, C, product);
+    }
+
+
     /// Compute the element's residual vector and the Jacobian matrix.
     void fill_in_contribution_to_jacobian(Vector<double>& residuals,
                                           DenseMatrix<double>& jacobian)
@@ -278,7 +278,8 @@ namespace oomph
       // Data from the constrained block.
       double* s_values = solid_matrix_pt(block_i, block_i)->value();
       int* s_column_index = solid_matrix_pt(block_i, block_i)->column_index();
-      int* s_row_start = solid_matrix_pt(block_i, block_i)->row_start();
+      SparseOffset* s_row_start =
+        solid_matrix_pt(block_i, block_i)->row_start();
       int s_nrow_local = solid_matrix_pt(block_i, block_i)->nrow_local();
       int s_first_row = solid_matrix_pt(block_i, block_i)->first_row();
 
@@ -286,7 +287,9 @@ namespace oomph
       for (int i = 0; i < s_nrow_local; i++)
       {
         bool found = false;
-        for (int j = s_row_start[i]; j < s_row_start[i + 1] && !found; j++)
+        for (SparseOffset j = s_row_start[i];
+             j < s_row_start[i + 1] && !found;
+             j++)
         {
           if (s_column_index[j] == i + s_first_row)
           {
@@ -845,13 +848,15 @@ namespace oomph
     // add the scaled identity matrix to block 11
     double* s11_values = s11_pt->value();
     int* s11_column_index = s11_pt->column_index();
-    int* s11_row_start = s11_pt->row_start();
+    SparseOffset* s11_row_start = s11_pt->row_start();
     int s11_nrow_local = s11_pt->nrow_local();
     int s11_first_row = s11_pt->first_row();
     for (int i = 0; i < s11_nrow_local; i++)
     {
       bool found = false;
-      for (int j = s11_row_start[i]; j < s11_row_start[i + 1] && !found; j++)
+      for (SparseOffset j = s11_row_start[i];
+           j < s11_row_start[i + 1] && !found;
+           j++)
       {
         if (s11_column_index[j] == i + s11_first_row)
         {
@@ -915,7 +915,7 @@ namespace oomph
       // Storage for inv_w matrix vectors
       Vector<double> invw_i_diag_values(l_i_nrow_local, 0);
       Vector<int> w_i_column_indices(l_i_nrow_local);
-      Vector<int> w_i_row_start(l_i_nrow_local + 1);
+      Vector<SparseOffset> w_i_row_start(l_i_nrow_local + 1);
 
       // Divide by Scaling_sigma and create the inverse of w.
       for (unsigned long row_i = 0; row_i < l_i_nrow_local; row_i++)
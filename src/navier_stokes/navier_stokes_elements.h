@@ -1067,6 +1067,50 @@ namespace oomph
       }
     }
 
+    /// Return the values of the i-th scalar field at the plot points
+    /// (in the order used by scalar_value_paraview(...)) in numerical
+    /// form, for use by the binary paraview output
+    void scalar_values_paraview(const unsigned& i,
+                                const unsigned& nplot,
+                                Vector<double>& values) const
+    {
+#ifdef PARANOID
+      if (i > DIM)
+      {
+        std::stringstream error_stream;
+        error_stream << "These Navier Stokes elements only store " << DIM + 1
+                     << " fields, "
+                     << "but i is currently  " << i << std::endl;
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+
+      // Vector of local coordinates
+      Vector<double> s(DIM);
+
+      // Loop over plot points
+      unsigned num_plot_points = nplot_points_paraview(nplot);
+      values.resize(num_plot_points);
+      for (unsigned iplot = 0; iplot < num_plot_points; iplot++)
+      {
+        // Get local coordinates of plot point
+        get_s_plot(iplot, nplot, s);
+
+        // Velocities
+        if (i < DIM)
+        {
+          values[iplot] = interpolated_u_nst(s, i);
+        }
+
+        // Pressure
+        else
+        {
+          values[iplot] = interpolated_p_nst(s);
+        }
+      }
+    }
+
 
     /// Write values of the i-th scalar field at the plot points. Needs
     /// to be implemented for each new specific element type.
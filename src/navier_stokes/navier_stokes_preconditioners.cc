@@ -1608,7 +1608,7 @@ namespace oomph
 
     // Create column index and row start for velocity mass matrix
     int* v_column_index = new int[v_nrow_local];
-    int* v_row_start = new int[v_nrow_local + 1];
+    SparseOffset* v_row_start = new SparseOffset[v_nrow_local + 1];
     for (unsigned i = 0; i < v_nrow_local; i++)
     {
 #ifdef PARANOID
@@ -1638,7 +1638,7 @@ namespace oomph
     {
       // Create column index and row start for pressure mass matrix
       int* p_column_index = new int[p_nrow_local];
-      int* p_row_start = new int[p_nrow_local + 1];
+      SparseOffset* p_row_start = new SparseOffset[p_nrow_local + 1];
       for (unsigned i = 0; i < p_nrow_local; i++)
       {
 #ifdef PARANOID
@@ -1703,4 +1703,48 @@ namespace oomph
   }
 
 
+  //=======================================================================
+  /// Add the memory held by the preconditioner to the account
+  //=======================================================================
+  void NavierStokesSchurComplementPreconditioner::get_memory_usage(
+    MemoryAccount& account)
+  {
+    BlockPreconditioner<CRDoubleMatrix>::get_memory_usage(account);
+
+    if (!Preconditioner_has_been_setup) return;
+
+    // The blocks are stored in the matrix-vector products
+    if (Bt_mat_vec_pt != 0)
+    {
+      Bt_mat_vec_pt->get_memory_usage(account, "matvec_blocks");
+    }
+    if (F_mat_vec_pt != 0)
+    {
+      F_mat_vec_pt->get_memory_usage(account, "matvec_blocks");
+    }
+    if (QBt_mat_vec_pt != 0)
+    {
+      QBt_mat_vec_pt->get_memory_usage(account, "matvec_blocks");
+    }
+    if (E_mat_vec_pt != 0)
+    {
+      E_mat_vec_pt->get_memory_usage(account, "matvec_blocks");
+    }
+
+    // The subsidiary preconditioners
+    if (F_preconditioner_pt != 0)
+    {
+      MemoryAccount f_account;
+      F_preconditioner_pt->get_memory_usage(f_account);
+      account.add(f_account, "f_preconditioner:");
+    }
+    if (P_preconditioner_pt != 0)
+    {
+      MemoryAccount p_account;
+      P_preconditioner_pt->get_memory_usage(p_account);
+      account.add(p_account, "p_preconditioner:");
+    }
+  }
+
+
 } // namespace oomph
@@ -862,6 +862,12 @@ namespace oomph
     /// Helper function to delete preconditioner data.
     void clean_up_memory();
 
+    /// Add the memory held by the block lookup schemes, the blocks
+    /// stored in the matrix-vector products (category "matvec_blocks")
+    /// and the subsidiary preconditioners (categories prefixed by
+    /// "f_preconditioner:" and "p_preconditioner:") to the account
+    void get_memory_usage(MemoryAccount& account);
+
     /// Use  Robin BC elements for the Fp preconditioner
     void enable_robin_for_fp()
     {
@@ -396,7 +396,7 @@ namespace oomph
     void interpolation_matrix_set(const unsigned& level,
                                   double* value,
                                   int* col_index,
-                                  int* row_st,
+                                  SparseOffset* row_st,
                                   unsigned& ncol,
                                   unsigned& nnz)
     {
@@ -415,7 +415,7 @@ namespace oomph
     void interpolation_matrix_set(const unsigned& level,
                                   Vector<double>& value,
                                   Vector<int>& col_index,
-                                  Vector<int>& row_st,
+                                  Vector<SparseOffset>& row_st,
                                   unsigned& ncol,
                                   unsigned& nrow)
     {
@@ -2001,12 +2001,12 @@ namespace oomph
     // the real and imaginary portions of the full matrix.
     // Real part:
     const double* value_r_pt = real_matrix_pt->value();
-    const int* row_start_r_pt = real_matrix_pt->row_start();
+    const SparseOffset* row_start_r_pt = real_matrix_pt->row_start();
     const int* column_index_r_pt = real_matrix_pt->column_index();
 
     // Imaginary part:
     const double* value_c_pt = imag_matrix_pt->value();
-    const int* row_start_c_pt = imag_matrix_pt->row_start();
+    const SparseOffset* row_start_c_pt = imag_matrix_pt->row_start();
     const int* column_index_c_pt = imag_matrix_pt->column_index();
 
 #ifdef PARANOID
@@ -2041,7 +2041,7 @@ namespace oomph
     // the complete matrix
     Vector<double> value(nnz, 0.0);
     Vector<int> column_index(nnz, 0);
-    Vector<int> row_start(2 * n_rows_r + 1, 0);
+    Vector<SparseOffset> row_start(2 * n_rows_r + 1, 0);
 
     //----------------------------
     // Build the row start vector:
@@ -2988,7 +2988,7 @@ namespace oomph
 
       // Create the row start vector whose i-th entry will contain the index
       // in column_start where the entries in the i-th row of the matrix start
-      Vector<int> row_start(n_row + 1);
+      Vector<SparseOffset> row_start(n_row + 1);
 
       // Create the column index vector whose entries will store the column
       // index of each contribution, i.e. the global equation of the coarse
@@ -3291,7 +3291,7 @@ namespace oomph
       // as the vector value.
       Vector<double> value;
       Vector<int> column_index;
-      Vector<int> row_start(fine_n_unknowns + 1);
+      Vector<SparseOffset> row_start(fine_n_unknowns + 1);
 
       // Vector to contain the (Eulerian) spatial location of the fine node
       Vector<double> fine_node_position(DIM);
@@ -145,6 +145,37 @@ namespace oomph
       }
     }
 
+    /// Return the values of the i-th scalar field at the plot points
+    /// (in the order used by scalar_value_paraview(...)) in numerical
+    /// form, for use by the binary paraview output
+    void scalar_values_paraview(const unsigned& i,
+                                const unsigned& nplot,
+                                Vector<double>& values) const
+    {
+#ifdef PARANOID
+      if (i != 0)
+      {
+        std::stringstream error_stream;
+        error_stream
+          << "Poisson elements only store a single field so i must be 0 rather"
+          << " than " << i << std::endl;
+        throw OomphLibError(
+          error_stream.str(), OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+
+      unsigned local_loop = this->nplot_points_paraview(nplot);
+      values.resize(local_loop);
+      Vector<double> s(DIM);
+      for (unsigned j = 0; j < local_loop; j++)
+      {
+        // Get the local coordinate of the required plot point
+        this->get_s_plot(j, nplot, s);
+
+        values[j] = this->interpolated_u_poisson(s);
+      }
+    }
+
     /// Name of the i-th scalar field. Default implementation
     /// returns V1 for the first one, V2 for the second etc. Can (should!) be
     /// overloaded with more meaningful names in specific elements.
@@ -442,6 +473,26 @@ namespace oomph
     }
 
 
+    /// Contribution to the products of the Hessian with the vectors Y
+    /// and C (see Problem::set_analytic_hessian_products()): None, since
+    /// the residuals are linear in the unknowns -- unless the element's
+    /// shape depends on geometric data (e.g. in a SpineElement or
+    /// AlgebraicElement wrapper) which may be unknowns too. In that case
+    /// we call the (broken) default; use the global finite-difference
+    /// products instead.
+    void fill_in_contribution_to_hessian_vector_products(
+      Vector<double> const& Y,
+      DenseMatrix<double> const& C,
+      DenseMatrix<double>& product)
+    {
+      if (this->ngeom_data() != 0)
+      {
+        FiniteElement::fill_in_contribution_to_hessian_vector_products(
+          Y, C, product);
+      }
+    }
+
+
     /// Return FE representation of function value u_poisson(s)
     /// at local coordinate s
     virtual inline double interpolated_u_poisson(const Vector<double>& s) const
@@ -154,11 +154,16 @@ namespace oomph
     // The local index at which the poisson variable is stored
     unsigned u_nodal_index = this->u_index_poisson();
 
-    // Integers to store the local equation and unknown numbers
-    int local_eqn = 0, local_unknown = 0;
-
-    // Local storage for pointers to hang_info objects
-    HangInfo *hang_info_pt = 0, *hang_info2_pt = 0;
+    // Storage for the residuals and Jacobian associated with the nodal
+    // test and shape functions. Hanging nodes are taken into account
+    // afterwards by applying the element's precomputed constraint matrix
+    // so the loops below are the same as for non-refineable elements.
+    Vector<double> nodal_residuals(n_node, 0.0);
+    DenseMatrix<double> nodal_jacobian;
+    if (flag)
+    {
+      nodal_jacobian.resize(n_node, n_node, 0.0);
+    }
 
     // Loop over the integration points
     for (unsigned ipt = 0; ipt < n_intpt; ipt++)
@@ -205,133 +210,39 @@ namespace oomph
       // Loop over the nodes for the test functions
       for (unsigned l = 0; l < n_node; l++)
       {
-        // Local variables used to store the number of master nodes and the
-        // weight associated with the shape function if the node is hanging
-        unsigned n_master = 1;
-        double hang_weight = 1.0;
-
-        // Local bool (is the node hanging)
-        bool is_node_hanging = this->node_pt(l)->is_hanging();
+        // Add body force/source term here
+        nodal_residuals[l] += source * test(l) * W;
 
-        // If the node is hanging, get the number of master nodes
-        if (is_node_hanging)
+        // The Poisson bit itself
+        for (unsigned k = 0; k < DIM; k++)
         {
-          hang_info_pt = this->node_pt(l)->hanging_pt();
-          n_master = hang_info_pt->nmaster();
-        }
-        // Otherwise there is just one master node, the node itself
-        else
-        {
-          n_master = 1;
+          nodal_residuals[l] += interpolated_dudx[k] * dtestdx(l, k) * W;
         }
 
-        // Loop over the master nodes
-        for (unsigned m = 0; m < n_master; m++)
+        // Calculate the Jacobian
+        if (flag)
         {
-          // Get the local equation number and hang_weight
-          // If the node is hanging
-          if (is_node_hanging)
+          // Loop over the nodes for the variables
+          for (unsigned l2 = 0; l2 < n_node; l2++)
           {
-            // Read out the local equation number from the m-th master node
-            local_eqn = this->local_hang_eqn(hang_info_pt->master_node_pt(m),
-                                             u_nodal_index);
-
-            // Read out the weight from the master node
-            hang_weight = hang_info_pt->master_weight(m);
-          }
-          // If the node is not hanging
-          else
-          {
-            // The local equation number comes from the node itself
-            local_eqn = this->nodal_local_eqn(l, u_nodal_index);
-
-            // The hang weight is one
-            hang_weight = 1.0;
-          }
-
-          // If the nodal equation is not a boundary condition
-          if (local_eqn >= 0)
-          {
-            // Add body force/source term here
-            residuals[local_eqn] += source * test(l) * W * hang_weight;
-
-            // The Poisson bit itself
-            for (unsigned k = 0; k < DIM; k++)
+            // Add contribution to Elemental Matrix
+            for (unsigned i = 0; i < DIM; i++)
             {
-              residuals[local_eqn] +=
-                interpolated_dudx[k] * dtestdx(l, k) * W * hang_weight;
+              nodal_jacobian(l, l2) += dpsidx(l2, i) * dtestdx(l, i) * W;
             }
-
-            // Calculate the Jacobian
-            if (flag)
-            {
-              // Local variables to store the number of master nodes
-              // and the weights associated with each hanging node
-              unsigned n_master2 = 1;
-              double hang_weight2 = 1.0;
-
-              // Loop over the nodes for the variables
-              for (unsigned l2 = 0; l2 < n_node; l2++)
-              {
-                // Local bool (is the node hanging)
-                bool is_node2_hanging = this->node_pt(l2)->is_hanging();
-
-                // If the node is hanging, get the number of master nodes
-                if (is_node2_hanging)
-                {
-                  hang_info2_pt = this->node_pt(l2)->hanging_pt();
-                  n_master2 = hang_info2_pt->nmaster();
-                }
-                // Otherwise there is one master node, the node itself
-                else
-                {
-                  n_master2 = 1;
-                }
-
-                // Loop over the master nodes
-                for (unsigned m2 = 0; m2 < n_master2; m2++)
-                {
-                  // Get the local unknown and weight
-                  // If the node is hanging
-                  if (is_node2_hanging)
-                  {
-                    // Read out the local unknown from the master node
-                    local_unknown = this->local_hang_eqn(
-                      hang_info2_pt->master_node_pt(m2), u_nodal_index);
-
-                    // Read out the hanging weight from the master node
-                    hang_weight2 = hang_info2_pt->master_weight(m2);
-                  }
-                  // If the node is not hanging
-                  else
-                  {
-                    // The local unknown number comes from the node
-                    local_unknown = this->nodal_local_eqn(l2, u_nodal_index);
-
-                    // The hang weight is one
-                    hang_weight2 = 1.0;
-                  }
-
-                  // If the unknown is not pinned
-                  if (local_unknown >= 0)
-                  {
-                    // Add contribution to Elemental Matrix
-                    for (unsigned i = 0; i < DIM; i++)
-                    {
-                      jacobian(local_eqn, local_unknown) +=
-                        dpsidx(l2, i) * dtestdx(l, i) * W * hang_weight *
-                        hang_weight2;
-                    }
-                  }
-                } // End of loop over master nodes
-              } // End of loop over nodes
-            } // End of Jacobian calculation
-
-          } // End of case when residual equation is not pinned
-        } // End of loop over master nodes for residual
+          }
+        } // End of Jacobian calculation
       } // End of loop over nodes
-
     } // End of loop over integration points
+
+    // Distribute the nodal contributions to the (master) equations
+    this->add_constrained_nodal_residuals(
+      u_nodal_index, nodal_residuals, residuals);
+    if (flag)
+    {
+      this->add_constrained_nodal_jacobian(
+        u_nodal_index, u_nodal_index, nodal_jacobian, jacobian);
+    }
   }
 
 
@@ -61,6 +61,28 @@ namespace oomph
       DenseMatrix<double>& jacobian,
       const unsigned& flag);
 
+    /// The analytic products of the Hessian with the vectors Y and C
+    /// computed in PVDEquations<DIM> do not take hanging nodes into
+    /// account: Use the (broken) default if the element has any.
+    void fill_in_contribution_to_hessian_vector_products(
+      Vector<double> const& Y,
+      DenseMatrix<double> const& C,
+      DenseMatrix<double>& product)
+    {
+      unsigned n_node = this->nnode();
+      for (unsigned l = 0; l < n_node; l++)
+      {
+        if (this->node_pt(l)->is_hanging())
+        {
+          FiniteElement::fill_in_contribution_to_hessian_vector_products(
+            Y, C, product);
+          return;
+        }
+      }
+      PVDEquations<DIM>::fill_in_contribution_to_hessian_vector_products(
+        Y, C, product);
+    }
+
     /// No values are interpolated in this element (pure solid)
     void get_interpolated_values(const unsigned& t,
                                  const Vector<double>& s,
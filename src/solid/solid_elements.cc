@@ -229,7 +229,36 @@ namespace oomph
     // Integer to store the local equation number
     int local_eqn = 0;
 
-    // Loop over the integration points
+    // Storage for the quantities that are needed at all integration
+    // points. Tensors are stored as structure of arrays (entry (i,j)
+    // at integration point ipt is at (i*DIM+j)*n_intpt+ipt) so that
+    // the constitutive law can be evaluated for all integration points
+    // in one go.
+    const unsigned n_entry = DIM * DIM;
+    Vector<double> interpolated_G_ipt(n_entry * n_intpt);
+    Vector<double> g_ipt(n_entry * n_intpt);
+    Vector<double> G_ipt(n_entry * n_intpt);
+    Vector<double> sigma_ipt(n_entry * n_intpt);
+    Vector<double> prestress_ipt(n_entry * n_intpt);
+    Vector<double> accel_ipt(DIM * n_intpt);
+    Vector<double> b_ipt(DIM * n_intpt);
+    Vector<double> W_ipt(n_intpt);
+
+    // Calculate interpolated values of the derivative of global position
+    // wrt lagrangian coordinates
+    DenseMatrix<double> interpolated_G(DIM);
+
+    // Setup memory for accelerations
+    Vector<double> accel(DIM);
+
+    // Storage for Lagrangian coordinates
+    Vector<double> interpolated_xi(DIM);
+
+    // Body force
+    Vector<double> b(DIM);
+
+    // First loop over the integration points: Assemble the metric tensors
+    //--------------------------------------------------------------------
     for (unsigned ipt = 0; ipt < n_intpt; ipt++)
     {
       // Assign the values of s
@@ -244,27 +273,18 @@ namespace oomph
       // Call the derivatives of the shape functions (and get Jacobian)
       double J = this->dshape_lagrangian_at_knot(ipt, psi, dpsidxi);
 
-      // Calculate interpolated values of the derivative of global position
-      // wrt lagrangian coordinates
-      DenseMatrix<double> interpolated_G(DIM);
-
-      // Setup memory for accelerations
-      Vector<double> accel(DIM);
-
       // Initialise to zero
       for (unsigned i = 0; i < DIM; i++)
       {
-        // Initialise acclerations
+        // Initialise acclerations and Lagrangian coordinates
         accel[i] = 0.0;
+        interpolated_xi[i] = 0.0;
         for (unsigned j = 0; j < DIM; j++)
         {
           interpolated_G(i, j) = 0.0;
         }
       }
 
-      // Storage for Lagrangian coordinates (initialised to zero)
-      Vector<double> interpolated_xi(DIM, 0.0);
-
       // Calculate displacements and derivatives and lagrangian coordinates
       for (unsigned l = 0; l < n_node; l++)
       {
@@ -300,79 +320,118 @@ namespace oomph
 
 
       // Get body force at current time
-      Vector<double> b(DIM);
       this->body_force(interpolated_xi, b);
 
       // We use Cartesian coordinates as the reference coordinate
       // system. In this case the undeformed metric tensor is always
       // the identity matrix -- stretched by the isotropic growth
       double diag_entry = pow(gamma, 2.0 / double(DIM));
-      DenseMatrix<double> g(DIM);
       for (unsigned i = 0; i < DIM; i++)
       {
         for (unsigned j = 0; j < DIM; j++)
         {
           if (i == j)
           {
-            g(i, j) = diag_entry;
+            g_ipt[(i * DIM + j) * n_intpt + ipt] = diag_entry;
           }
           else
           {
-            g(i, j) = 0.0;
+            g_ipt[(i * DIM + j) * n_intpt + ipt] = 0.0;
           }
         }
       }
 
       // Premultiply the undeformed volume ratio (from the isotropic
       // growth), the weights and the Jacobian
-      double W = gamma * w * J;
+      W_ipt[ipt] = gamma * w * J;
 
-      // Declare and calculate the deformed metric tensor
-      DenseMatrix<double> G(DIM);
-
-      // Assign values of G
+      // Assign values of the deformed metric tensor G
       for (unsigned i = 0; i < DIM; i++)
       {
         // Do upper half of matrix
         for (unsigned j = i; j < DIM; j++)
         {
-          // Initialise G(i,j) to zero
-          G(i, j) = 0.0;
           // Now calculate the dot product
+          double G_ij = 0.0;
           for (unsigned k = 0; k < DIM; k++)
           {
-            G(i, j) += interpolated_G(i, k) * interpolated_G(j, k);
+            G_ij += interpolated_G(i, k) * interpolated_G(j, k);
           }
+          // Matrix is symmetric so copy to lower half too
+          G_ipt[(i * DIM + j) * n_intpt + ipt] = G_ij;
+          G_ipt[(j * DIM + i) * n_intpt + ipt] = G_ij;
         }
-        // Matrix is symmetric so just copy lower half
-        for (unsigned j = 0; j < i; j++)
+      }
+
+      // Keep the remaining quantities for the second loop
+      for (unsigned i = 0; i < DIM; i++)
+      {
+        accel_ipt[i * n_intpt + ipt] = accel[i];
+        b_ipt[i * n_intpt + ipt] = b[i];
+        for (unsigned j = 0; j < DIM; j++)
         {
-          G(i, j) = G(j, i);
+          interpolated_G_ipt[(i * DIM + j) * n_intpt + ipt] =
+            interpolated_G(i, j);
+          prestress_ipt[(i * DIM + j) * n_intpt + ipt] =
+            this->prestress(i, j, interpolated_xi);
         }
       }
+    }
 
-      // Now calculate the stress tensor from the constitutive law
-      DenseMatrix<double> sigma(DIM);
-      get_stress(g, G, sigma);
+    // Now calculate the stress tensors at all integration points
+    // from the constitutive law and add the pre-stress
+    get_stress_at_points(n_intpt, &g_ipt[0], &G_ipt[0], &sigma_ipt[0]);
+    for (unsigned k = 0; k < n_entry * n_intpt; k++)
+    {
+      sigma_ipt[k] += prestress_ipt[k];
+    }
 
-      // Add pre-stress
+    // Get stress derivatives (only needed for Jacobian): The "upper
+    // triangular" entries of the derivatives of the stress tensor with
+    // respect to G at all integration points
+    Vector<double> d_stress_dG_ipt;
+    if (flag == 1)
+    {
+      d_stress_dG_ipt.resize(n_entry * n_entry * n_intpt, 0.0);
+      this->get_d_stress_dG_upper_at_points(n_intpt,
+                                            &g_ipt[0],
+                                            &G_ipt[0],
+                                            &sigma_ipt[0],
+                                            &d_stress_dG_ipt[0]);
+    }
+
+    // Stress tensor at current integration point
+    DenseMatrix<double> sigma(DIM);
+
+    // Stress derivative at current integration point
+    RankFourTensor<double> d_stress_dG(DIM, DIM, DIM, DIM, 0.0);
+
+    // Derivative of metric tensor w.r.t. to nodal coords
+    RankFiveTensor<double> d_G_dX(n_node, n_position_type, DIM, DIM, DIM, 0.0);
+
+    // Second loop over the integration points: Assemble residuals
+    //------------------------------------------------------------
+    for (unsigned ipt = 0; ipt < n_intpt; ipt++)
+    {
+      // Call the derivatives of the shape functions
+      (void)this->dshape_lagrangian_at_knot(ipt, psi, dpsidxi);
+
+      // Premultiplied weight
+      double W = W_ipt[ipt];
+
+      // Recover the quantities computed in the first loop
       for (unsigned i = 0; i < DIM; i++)
       {
+        accel[i] = accel_ipt[i * n_intpt + ipt];
+        b[i] = b_ipt[i * n_intpt + ipt];
         for (unsigned j = 0; j < DIM; j++)
         {
-          sigma(i, j) += this->prestress(i, j, interpolated_xi);
+          interpolated_G(i, j) =
+            interpolated_G_ipt[(i * DIM + j) * n_intpt + ipt];
+          sigma(i, j) = sigma_ipt[(i * DIM + j) * n_intpt + ipt];
         }
       }
 
-      // Get stress derivative by FD only needed for Jacobian
-      //-----------------------------------------------------
-
-      // Stress derivative
-      RankFourTensor<double> d_stress_dG(DIM, DIM, DIM, DIM, 0.0);
-      // Derivative of metric tensor w.r.t. to nodal coords
-      RankFiveTensor<double> d_G_dX(
-        n_node, n_position_type, DIM, DIM, DIM, 0.0);
-
       // Get Jacobian too?
       if (flag == 1)
       {
@@ -400,9 +459,11 @@ namespace oomph
           }
         }
 
-        // Get the "upper triangular" entries of the derivatives of the stress
-        // tensor with respect to G
-        this->get_d_stress_dG_upper(g, G, sigma, d_stress_dG);
+        // Extract the stress derivatives at this integration point
+        for (unsigned k = 0; k < n_entry * n_entry; k++)
+        {
+          d_stress_dG.raw_direct_access(k) = d_stress_dG_ipt[k * n_intpt + ipt];
+        }
       }
 
       //=====EQUATIONS OF ELASTICITY FROM PRINCIPLE OF VIRTUAL
@@ -568,6 +629,327 @@ namespace oomph
   }
 
 
+  //=======================================================================
+  /// Add the element's contribution to the products of the Hessian,
+  /// (d(J_{ij})/d u_{k}) Y_{j} C_{k}, with the vectors Y and C.
+  /// Only the stress term in the residuals, sigma^{ab}(G) F_{ai}
+  /// dpsi/dxi_b, where F_{ai} = dx_i/dxi_a, is nonlinear in the
+  /// unknowns. Since F is linear in the unknowns, its second directional
+  /// derivative is
+  ///
+  ///  [ D2sigma^{ab} F_{ai} + Dsigma[Y]^{ab} F[C]_{ai}
+  ///                        + Dsigma[C]^{ab} F[Y]_{ai} ] dpsi/dxi_b
+  ///
+  /// where F[Y] and F[C] are interpolated from Y and C, the derivatives
+  /// of the metric tensor are dG[Y]_{ab} = F_{ak} F[Y]_{bk} +
+  /// F[Y]_{ak} F_{bk} and d2G_{ab} = F[Y]_{ak} F[C]_{bk} +
+  /// F[C]_{ak} F[Y]_{bk}, and
+  ///
+  ///  Dsigma[Y] = dsigma/dG : dG[Y],
+  ///  D2sigma = dsigma/dG : d2G + (d(dsigma/dG)/dG : dG[C]) : dG[Y].
+  ///
+  /// The derivative of dsigma/dG in the last term is evaluated by central
+  /// differences of the constitutive law's dsigma/dG; everything else is
+  /// analytic. Accelerations, body forces and pre-stresses do not
+  /// contribute.
+  //=======================================================================
+  template<unsigned DIM>
+  void PVDEquations<DIM>::fill_in_contribution_to_hessian_vector_products(
+    Vector<double> const& Y,
+    DenseMatrix<double> const& C,
+    DenseMatrix<double>& product)
+  {
+    // The residuals for the assignment of the initial conditions and the
+    // Jacobian for the consistent Newmark accelerations are linear
+    if ((this->Solid_ic_pt != 0) ||
+        (this->Solve_for_consistent_newmark_accel_flag))
+    {
+      return;
+    }
+
+    // Find out how many nodes and positional dofs there are
+    const unsigned n_node = this->nnode();
+    const unsigned n_position_type = this->nnodal_position_type();
+
+    // Number of integration points and of vectors C
+    const unsigned n_intpt = this->integral_pt()->nweight();
+    const unsigned n_vec = C.nrow();
+
+    // Relative size of the perturbation of the metric tensor used for the
+    // finite-difference derivatives of dsigma/dG
+    const double fd_step = 1.0e-5;
+
+    // Set up memory for the shape functions
+    Shape psi(n_node, n_position_type);
+    DShape dpsidxi(n_node, n_position_type, DIM);
+
+    // Local and Lagrangian coordinates
+    Vector<double> s(DIM);
+    Vector<double> interpolated_xi(DIM);
+
+    // Storage for the quantities that are needed at all integration
+    // points; tensors are stored as structure of arrays (as in
+    // fill_in_generic_contribution_to_residuals_pvd(...)).
+    const unsigned n_entry = DIM * DIM;
+    Vector<double> g_ipt(n_entry * n_intpt);
+    Vector<double> G_ipt(n_entry * n_intpt);
+    Vector<double> W_ipt(n_intpt);
+
+    // F, F[Y], F[C] and the derivatives dG[Y], dG[C] at the integration
+    // points
+    Vector<double> F_ipt(n_entry * n_intpt, 0.0);
+    Vector<double> F_Y_ipt(n_entry * n_intpt, 0.0);
+    Vector<Vector<double>> F_C_ipt(n_vec,
+                                   Vector<double>(n_entry * n_intpt, 0.0));
+    Vector<double> dG_Y_ipt(n_entry * n_intpt);
+    Vector<Vector<double>> dG_C_ipt(n_vec, Vector<double>(n_entry * n_intpt));
+
+    // First loop over the integration points: Interpolate
+    //----------------------------------------------------
+    for (unsigned ipt = 0; ipt < n_intpt; ipt++)
+    {
+      // Assign the values of s
+      for (unsigned i = 0; i < DIM; ++i)
+      {
+        s[i] = this->integral_pt()->knot(ipt, i);
+        interpolated_xi[i] = 0.0;
+      }
+
+      // Call the derivatives of the shape functions (and get Jacobian)
+      double J = this->dshape_lagrangian_at_knot(ipt, psi, dpsidxi);
+
+      for (unsigned l = 0; l < n_node; l++)
+      {
+        for (unsigned k = 0; k < n_position_type; k++)
+        {
+          for (unsigned i = 0; i < DIM; i++)
+          {
+            interpolated_xi[i] +=
+              this->lagrangian_position_gen(l, k, i) * psi(l, k);
+
+            // Pinned positions do not vary
+            int local_unknown = this->position_local_eqn(l, k, i);
+            for (unsigned a = 0; a < DIM; a++)
+            {
+              const unsigned index = (a * DIM + i) * n_intpt + ipt;
+              F_ipt[index] +=
+                this->nodal_position_gen(l, k, i) * dpsidxi(l, k, a);
+              if (local_unknown >= 0)
+              {
+                F_Y_ipt[index] += Y[local_unknown] * dpsidxi(l, k, a);
+                for (unsigned v = 0; v < n_vec; v++)
+                {
+                  F_C_ipt[v][index] += C(v, local_unknown) * dpsidxi(l, k, a);
+                }
+              }
+            }
+          }
+        }
+      }
+
+      // Get isotropic growth factor
+      double gamma = 1.0;
+      this->get_isotropic_growth(ipt, s, interpolated_xi, gamma);
+
+      // Undeformed metric tensor and premultiplied weight as in the
+      // residuals
+      double diag_entry = pow(gamma, 2.0 / double(DIM));
+      for (unsigned a = 0; a < DIM; a++)
+      {
+        for (unsigned b = 0; b < DIM; b++)
+        {
+          g_ipt[(a * DIM + b) * n_intpt + ipt] = (a == b) ? diag_entry : 0.0;
+        }
+      }
+      W_ipt[ipt] = gamma * this->integral_pt()->weight(ipt) * J;
+
+      // Deformed metric tensor and its derivatives
+      for (unsigned a = 0; a < DIM; a++)
+      {
+        for (unsigned b = 0; b < DIM; b++)
+        {
+          double G_ab = 0.0;
+          double dG_Y_ab = 0.0;
+          for (unsigned k = 0; k < DIM; k++)
+          {
+            const double F_ak = F_ipt[(a * DIM + k) * n_intpt + ipt];
+            const double F_bk = F_ipt[(b * DIM + k) * n_intpt + ipt];
+            G_ab += F_ak * F_bk;
+            dG_Y_ab += F_ak * F_Y_ipt[(b * DIM + k) * n_intpt + ipt] +
+                       F_Y_ipt[(a * DIM + k) * n_intpt + ipt] * F_bk;
+          }
+          G_ipt[(a * DIM + b) * n_intpt + ipt] = G_ab;
+          dG_Y_ipt[(a * DIM + b) * n_intpt + ipt] = dG_Y_ab;
+
+          for (unsigned v = 0; v < n_vec; v++)
+          {
+            double dG_C_ab = 0.0;
+            for (unsigned k = 0; k < DIM; k++)
+            {
+              dG_C_ab += F_ipt[(a * DIM + k) * n_intpt + ipt] *
+                           F_C_ipt[v][(b * DIM + k) * n_intpt + ipt] +
+                         F_C_ipt[v][(a * DIM + k) * n_intpt + ipt] *
+                           F_ipt[(b * DIM + k) * n_intpt + ipt];
+            }
+            dG_C_ipt[v][(a * DIM + b) * n_intpt + ipt] = dG_C_ab;
+          }
+        }
+      }
+    }
+
+    // The stress and its ("upper triangular") derivatives w.r.t. G at all
+    // integration points
+    Vector<double> sigma_ipt(n_entry * n_intpt);
+    get_stress_at_points(n_intpt, &g_ipt[0], &G_ipt[0], &sigma_ipt[0]);
+    Vector<double> d_stress_dG_ipt(n_entry * n_entry * n_intpt, 0.0);
+    this->get_d_stress_dG_upper_at_points(
+      n_intpt, &g_ipt[0], &G_ipt[0], &sigma_ipt[0], &d_stress_dG_ipt[0]);
+
+    // Largest entry of the metric tensors, to scale the FD step
+    double max_G = 0.0;
+    for (unsigned k = 0; k < n_entry * n_intpt; k++)
+    {
+      max_G = std::max(max_G, std::fabs(G_ipt[k]));
+    }
+
+    // Storage for the perturbed quantities
+    Vector<double> G_pert_ipt(n_entry * n_intpt);
+    Vector<double> sigma_pert_ipt(n_entry * n_intpt);
+    Vector<double> d_stress_dG_pls_ipt(n_entry * n_entry * n_intpt);
+    Vector<double> d_stress_dG_mns_ipt(n_entry * n_entry * n_intpt);
+
+    // Derivatives of the stress at the current integration point
+    DenseMatrix<double> d_sigma_Y(DIM), d_sigma_C(DIM), d2_sigma(DIM);
+
+    // Loop over the vectors C
+    for (unsigned v = 0; v < n_vec; v++)
+    {
+      // Derivative of dsigma/dG in the direction of dG[C] by central
+      // differences (stored in d_stress_dG_pls_ipt)
+      double max_dG_C = 0.0;
+      for (unsigned k = 0; k < n_entry * n_intpt; k++)
+      {
+        max_dG_C = std::max(max_dG_C, std::fabs(dG_C_ipt[v][k]));
+      }
+      if (max_dG_C > 0.0)
+      {
+        const double h = fd_step * std::max(max_G, 1.0) / max_dG_C;
+        for (unsigned k = 0; k < n_entry * n_intpt; k++)
+        {
+          G_pert_ipt[k] = G_ipt[k] + h * dG_C_ipt[v][k];
+        }
+        get_stress_at_points(
+          n_intpt, &g_ipt[0], &G_pert_ipt[0], &sigma_pert_ipt[0]);
+        d_stress_dG_pls_ipt.initialise(0.0);
+        this->get_d_stress_dG_upper_at_points(n_intpt,
+                                              &g_ipt[0],
+                                              &G_pert_ipt[0],
+                                              &sigma_pert_ipt[0],
+                                              &d_stress_dG_pls_ipt[0]);
+        for (unsigned k = 0; k < n_entry * n_intpt; k++)
+        {
+          G_pert_ipt[k] = G_ipt[k] - h * dG_C_ipt[v][k];
+        }
+        get_stress_at_points(
+          n_intpt, &g_ipt[0], &G_pert_ipt[0], &sigma_pert_ipt[0]);
+        d_stress_dG_mns_ipt.initialise(0.0);
+        this->get_d_stress_dG_upper_at_points(n_intpt,
+                                              &g_ipt[0],
+                                              &G_pert_ipt[0],
+                                              &sigma_pert_ipt[0],
+                                              &d_stress_dG_mns_ipt[0]);
+        for (unsigned k = 0; k < n_entry * n_entry * n_intpt; k++)
+        {
+          d_stress_dG_pls_ipt[k] =
+            (d_stress_dG_pls_ipt[k] - d_stress_dG_mns_ipt[k]) / (2.0 * h);
+        }
+      }
+      else
+      {
+        d_stress_dG_pls_ipt.initialise(0.0);
+      }
+
+      // Second loop over the integration points: Assemble the products
+      //---------------------------------------------------------------
+      for (unsigned ipt = 0; ipt < n_intpt; ipt++)
+      {
+        // Call the derivatives of the shape functions
+        (void)this->dshape_lagrangian_at_knot(ipt, psi, dpsidxi);
+
+        // Directional derivatives of the stress (upper triangle only,
+        // consistent with the derivatives w.r.t. G returned by the
+        // constitutive law)
+        for (unsigned a = 0; a < DIM; a++)
+        {
+          for (unsigned b = a; b < DIM; b++)
+          {
+            double sum_Y = 0.0;
+            double sum_C = 0.0;
+            double sum_YC = 0.0;
+            for (unsigned c = 0; c < DIM; c++)
+            {
+              for (unsigned d = c; d < DIM; d++)
+              {
+                const unsigned index =
+                  (((a * DIM + b) * DIM + c) * DIM + d) * n_intpt + ipt;
+                const unsigned cd = (c * DIM + d) * n_intpt + ipt;
+
+                // Second derivative of G
+                double d2G_cd = 0.0;
+                for (unsigned k = 0; k < DIM; k++)
+                {
+                  d2G_cd += F_Y_ipt[(c * DIM + k) * n_intpt + ipt] *
+                              F_C_ipt[v][(d * DIM + k) * n_intpt + ipt] +
+                            F_C_ipt[v][(c * DIM + k) * n_intpt + ipt] *
+                              F_Y_ipt[(d * DIM + k) * n_intpt + ipt];
+                }
+
+                sum_Y += d_stress_dG_ipt[index] * dG_Y_ipt[cd];
+                sum_C += d_stress_dG_ipt[index] * dG_C_ipt[v][cd];
+                sum_YC += d_stress_dG_ipt[index] * d2G_cd +
+                          d_stress_dG_pls_ipt[index] * dG_Y_ipt[cd];
+              }
+            }
+            d_sigma_Y(a, b) = d_sigma_Y(b, a) = sum_Y;
+            d_sigma_C(a, b) = d_sigma_C(b, a) = sum_C;
+            d2_sigma(a, b) = d2_sigma(b, a) = sum_YC;
+          }
+        }
+
+        const double W = W_ipt[ipt];
+
+        // Loop over the test functions
+        for (unsigned l = 0; l < n_node; l++)
+        {
+          for (unsigned k = 0; k < n_position_type; k++)
+          {
+            for (unsigned i = 0; i < DIM; i++)
+            {
+              int local_eqn = this->position_local_eqn(l, k, i);
+              if (local_eqn >= 0)
+              {
+                double sum = 0.0;
+                for (unsigned a = 0; a < DIM; a++)
+                {
+                  const unsigned ai = (a * DIM + i) * n_intpt + ipt;
+                  for (unsigned b = 0; b < DIM; b++)
+                  {
+                    sum += (d2_sigma(a, b) * F_ipt[ai] +
+                            d_sigma_Y(a, b) * F_C_ipt[v][ai] +
+                            d_sigma_C(a, b) * F_Y_ipt[ai]) *
+                           dpsidxi(l, k, b);
+                  }
+                }
+                product(v, local_eqn) += W * sum;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+
   //=======================================================================
   /// Output: x,y,[z],xi0,xi1,[xi2],gamma
   //=======================================================================
@@ -1331,7 +1713,44 @@ namespace oomph
     // Integers to hold the local equation and unknown numbers
     int local_eqn = 0, local_unknown = 0;
 
-    // Loop over the integration points
+    // Storage for the quantities that are needed at all integration
+    // points. Tensors are stored as structure of arrays (entry (i,j)
+    // at integration point ipt is at (i*DIM+j)*n_intpt+ipt) so that
+    // the constitutive law can be evaluated for all integration points
+    // in one go.
+    const unsigned n_entry = DIM * DIM;
+    Vector<double> interpolated_G_ipt(n_entry * n_intpt);
+    Vector<double> g_ipt(n_entry * n_intpt);
+    Vector<double> G_ipt(n_entry * n_intpt);
+    Vector<double> sigma_dev_ipt(n_entry * n_intpt);
+    Vector<double> Gup_ipt(n_entry * n_intpt);
+    Vector<double> interpolated_xi_ipt(DIM * n_intpt);
+    Vector<double> accel_ipt(DIM * n_intpt);
+    Vector<double> b_ipt(DIM * n_intpt);
+    Vector<double> W_ipt(n_intpt);
+    Vector<double> gamma_ipt(n_intpt);
+
+    // Determinant of the deformed metric tensor (incompressible),
+    // or generalised dilatation and inverse bulk modulus (nearly
+    // incompressible)
+    Vector<double> detG_ipt(n_intpt, 0.0);
+    Vector<double> gen_dil_ipt(n_intpt, 0.0);
+    Vector<double> inv_kappa_ipt(n_intpt, 0.0);
+
+    // Storage for Lagrangian coordinates
+    Vector<double> interpolated_xi(DIM);
+
+    // Deformed tangent vectors
+    DenseMatrix<double> interpolated_G(DIM);
+
+    // Setup memory for accelerations
+    Vector<double> accel(DIM);
+
+    // Body force
+    Vector<double> b(DIM);
+
+    // First loop over the integration points: Assemble the metric tensors
+    //--------------------------------------------------------------------
     for (unsigned ipt = 0; ipt < n_intpt; ipt++)
     {
       // Assign the values of s
@@ -1346,23 +1765,12 @@ namespace oomph
       // Call the derivatives of the shape functions
       double J = this->dshape_lagrangian_at_knot(ipt, psi, dpsidxi);
 
-      // Call the pressure shape functions
-      solid_pshape_at_knot(ipt, psisp);
-
-      // Storage for Lagrangian coordinates (initialised to zero)
-      Vector<double> interpolated_xi(DIM, 0.0);
-
-      // Deformed tangent vectors
-      DenseMatrix<double> interpolated_G(DIM);
-
-      // Setup memory for accelerations
-      Vector<double> accel(DIM);
-
       // Initialise to zero
       for (unsigned i = 0; i < DIM; i++)
       {
-        // Initialise acclerations
+        // Initialise acclerations and Lagrangian coordinates
         accel[i] = 0.0;
+        interpolated_xi[i] = 0.0;
         for (unsigned j = 0; j < DIM; j++)
         {
           interpolated_G(i, j) = 0.0;
@@ -1405,82 +1813,149 @@ namespace oomph
       this->get_isotropic_growth(ipt, s, interpolated_xi, gamma);
 
       // Get body force at current time
-      Vector<double> b(DIM);
       this->body_force(interpolated_xi, b);
 
       // We use Cartesian coordinates as the reference coordinate
       // system. In this case the undeformed metric tensor is always
       // the identity matrix -- stretched by the isotropic growth
       double diag_entry = pow(gamma, 2.0 / double(DIM));
-      DenseMatrix<double> g(DIM);
       for (unsigned i = 0; i < DIM; i++)
       {
         for (unsigned j = 0; j < DIM; j++)
         {
           if (i == j)
           {
-            g(i, j) = diag_entry;
+            g_ipt[(i * DIM + j) * n_intpt + ipt] = diag_entry;
           }
           else
           {
-            g(i, j) = 0.0;
+            g_ipt[(i * DIM + j) * n_intpt + ipt] = 0.0;
           }
         }
       }
 
       // Premultiply the undeformed volume ratio (from the isotropic
       // growth), the weights and the Jacobian
-      double W = gamma * w * J;
-
-      // Calculate the interpolated solid pressure
-      double interpolated_solid_p = 0.0;
-      for (unsigned l = 0; l < n_solid_pres; l++)
-      {
-        interpolated_solid_p += solid_p(l) * psisp[l];
-      }
-
+      W_ipt[ipt] = gamma * w * J;
+      gamma_ipt[ipt] = gamma;
 
-      // Declare and calculate the deformed metric tensor
-      DenseMatrix<double> G(DIM);
-
-      // Assign values of G
+      // Assign values of the deformed metric tensor G
       for (unsigned i = 0; i < DIM; i++)
       {
         // Do upper half of matrix
         for (unsigned j = i; j < DIM; j++)
         {
-          // Initialise G(i,j) to zero
-          G(i, j) = 0.0;
           // Now calculate the dot product
+          double G_ij = 0.0;
           for (unsigned k = 0; k < DIM; k++)
           {
-            G(i, j) += interpolated_G(i, k) * interpolated_G(j, k);
+            G_ij += interpolated_G(i, k) * interpolated_G(j, k);
           }
+          // Matrix is symmetric so copy to lower half too
+          G_ipt[(i * DIM + j) * n_intpt + ipt] = G_ij;
+          G_ipt[(j * DIM + i) * n_intpt + ipt] = G_ij;
         }
-        // Matrix is symmetric so just copy lower half
-        for (unsigned j = 0; j < i; j++)
+      }
+
+      // Keep the remaining quantities for the second loop
+      for (unsigned i = 0; i < DIM; i++)
+      {
+        interpolated_xi_ipt[i * n_intpt + ipt] = interpolated_xi[i];
+        accel_ipt[i * n_intpt + ipt] = accel[i];
+        b_ipt[i * n_intpt + ipt] = b[i];
+        for (unsigned j = 0; j < DIM; j++)
         {
-          G(i, j) = G(j, i);
+          interpolated_G_ipt[(i * DIM + j) * n_intpt + ipt] =
+            interpolated_G(i, j);
         }
       }
+    }
+
+    // Now calculate the deviatoric stress and all pressure-related
+    // quantitites at all integration points
+    if (Incompressible)
+    {
+      get_stress_at_points(n_intpt,
+                           &g_ipt[0],
+                           &G_ipt[0],
+                           &sigma_dev_ipt[0],
+                           &Gup_ipt[0],
+                           &detG_ipt[0]);
+    }
+    else
+    {
+      get_stress_at_points(n_intpt,
+                           &g_ipt[0],
+                           &G_ipt[0],
+                           &sigma_dev_ipt[0],
+                           &Gup_ipt[0],
+                           &gen_dil_ipt[0],
+                           &inv_kappa_ipt[0]);
+    }
+
+    // Metric tensors, stress and contravariant metric tensor at
+    // current integration point
+    DenseMatrix<double> g(DIM), G(DIM), sigma(DIM, DIM), Gup(DIM, DIM);
 
-      // Now calculate the deviatoric stress and all pressure-related
-      // quantitites
-      DenseMatrix<double> sigma(DIM, DIM), sigma_dev(DIM, DIM), Gup(DIM, DIM);
-      double detG = 0.0;
-      double gen_dil = 0.0;
-      double inv_kappa = 0.0;
+    // Stress etc derivatives
+    RankFourTensor<double> d_stress_dG(DIM, DIM, DIM, DIM, 0.0);
+    DenseMatrix<double> d_detG_dG(DIM, DIM, 0.0);
+    DenseMatrix<double> d_gen_dil_dG(DIM, DIM, 0.0);
 
-      // Get stress derivative by FD only needed for Jacobian
+    // Derivative of metric tensor w.r.t. to nodal coords
+    RankFiveTensor<double> d_G_dX(n_node, n_position_type, DIM, DIM, DIM, 0.0);
 
-      // Stress etc derivatives
-      RankFourTensor<double> d_stress_dG(DIM, DIM, DIM, DIM, 0.0);
-      DenseMatrix<double> d_detG_dG(DIM, DIM, 0.0);
-      DenseMatrix<double> d_gen_dil_dG(DIM, DIM, 0.0);
+    // Second loop over the integration points: Assemble residuals
+    //------------------------------------------------------------
+    for (unsigned ipt = 0; ipt < n_intpt; ipt++)
+    {
+      // Call the derivatives of the shape functions
+      (void)this->dshape_lagrangian_at_knot(ipt, psi, dpsidxi);
+
+      // Call the pressure shape functions
+      solid_pshape_at_knot(ipt, psisp);
+
+      // Premultiplied weight and isotropic growth factor
+      double W = W_ipt[ipt];
+      double gamma = gamma_ipt[ipt];
+
+      // Pressure-related quantities from the constitutive law
+      double detG = detG_ipt[ipt];
+      double gen_dil = gen_dil_ipt[ipt];
+      double inv_kappa = inv_kappa_ipt[ipt];
 
-      // Derivative of metric tensor w.r.t. to nodal coords
-      RankFiveTensor<double> d_G_dX(
-        n_node, n_position_type, DIM, DIM, DIM, 0.0);
+      // Recover the quantities computed in the first loop
+      for (unsigned i = 0; i < DIM; i++)
+      {
+        interpolated_xi[i] = interpolated_xi_ipt[i * n_intpt + ipt];
+        accel[i] = accel_ipt[i * n_intpt + ipt];
+        b[i] = b_ipt[i * n_intpt + ipt];
+        for (unsigned j = 0; j < DIM; j++)
+        {
+          const unsigned ij = (i * DIM + j) * n_intpt + ipt;
+          interpolated_G(i, j) = interpolated_G_ipt[ij];
+          g(i, j) = g_ipt[ij];
+          G(i, j) = G_ipt[ij];
+          Gup(i, j) = Gup_ipt[ij];
+        }
+      }
+
+      // Calculate the interpolated solid pressure
+      double interpolated_solid_p = 0.0;
+      for (unsigned l = 0; l < n_solid_pres; l++)
+      {
+        interpolated_solid_p += solid_p(l) * psisp[l];
+      }
+
+      // Get full stress
+      for (unsigned a = 0; a < DIM; a++)
+      {
+        for (unsigned b = 0; b < DIM; b++)
+        {
+          sigma(a, b) = sigma_dev_ipt[(a * DIM + b) * n_intpt + ipt] -
+                        interpolated_solid_p * Gup(a, b);
+        }
+      }
 
       // Get Jacobian too?
       if ((flag == 1) || (flag == 3))
@@ -1508,55 +1983,20 @@ namespace oomph
             }
           }
         }
-      }
-
 
-      // Incompressible: Compute the deviatoric part of the stress tensor, the
-      // contravariant deformed metric tensor and the determinant
-      // of the deformed covariant metric tensor.
-      if (Incompressible)
-      {
-        get_stress(g, G, sigma_dev, Gup, detG);
-
-        // Get full stress
-        for (unsigned a = 0; a < DIM; a++)
+        // Get the "upper triangular" entries of the derivatives of the
+        // stress tensor with respect to G. (These depend on the
+        // interpolated pressure so they are still computed point by point.)
+        d_stress_dG.initialise(0.0);
+        if (Incompressible)
         {
-          for (unsigned b = 0; b < DIM; b++)
-          {
-            sigma(a, b) = sigma_dev(a, b) - interpolated_solid_p * Gup(a, b);
-          }
-        }
-
-        // Get Jacobian too?
-        if ((flag == 1) || (flag == 3))
-        {
-          // Get the "upper triangular" entries of the derivatives of the stress
-          // tensor with respect to G
+          d_detG_dG.initialise(0.0);
           this->get_d_stress_dG_upper(
             g, G, sigma, detG, interpolated_solid_p, d_stress_dG, d_detG_dG);
         }
-      }
-      // Nearly incompressible: Compute the deviatoric part of the
-      // stress tensor, the contravariant deformed metric tensor,
-      // the generalised dilatation and the inverse bulk modulus.
-      else
-      {
-        get_stress(g, G, sigma_dev, Gup, gen_dil, inv_kappa);
-
-        // Get full stress
-        for (unsigned a = 0; a < DIM; a++)
-        {
-          for (unsigned b = 0; b < DIM; b++)
-          {
-            sigma(a, b) = sigma_dev(a, b) - interpolated_solid_p * Gup(a, b);
-          }
-        }
-
-        // Get Jacobian too?
-        if ((flag == 1) || (flag == 3))
+        else
         {
-          // Get the "upper triangular" entries of the derivatives of the stress
-          // tensor with respect to G
+          d_gen_dil_dG.initialise(0.0);
           this->get_d_stress_dG_upper(g,
                                       G,
                                       sigma,
@@ -502,6 +502,19 @@ namespace oomph
     }
 
 
+    /// Add the element's contribution to the products of the Hessian
+    /// (the derivatives of the Jacobian w.r.t. the unknowns) with the
+    /// vectors Y and C, used in the tracking of bifurcations if
+    /// Problem::set_analytic_hessian_products() has been called.
+    /// The constitutive law only provides the first derivatives of the
+    /// stress w.r.t. the metric tensor; their derivative in the direction
+    /// of C is obtained by (central) finite differences.
+    void fill_in_contribution_to_hessian_vector_products(
+      Vector<double> const& Y,
+      DenseMatrix<double> const& C,
+      DenseMatrix<double>& product);
+
+
     /// Output: x,y,[z],xi0,xi1,[xi2],gamma
     void output(std::ostream& outfile)
     {
@@ -590,6 +603,64 @@ namespace oomph
         g, G, sigma, d_sigma_dG, false);
     }
 
+    /// Return the 2nd Piola Kirchhoff stress tensors at n_point
+    /// integration points in one go, as calculated from the constitutive
+    /// law. Metric tensors and stresses are stored as structure of arrays
+    /// (see ConstitutiveLaw::calculate_second_piola_kirchhoff_stress_at_points())
+    inline void get_stress_at_points(const unsigned& n_point,
+                                     const double* g,
+                                     const double* G,
+                                     double* sigma)
+    {
+#ifdef PARANOID
+      // If the pointer to the constitutive law hasn't been set, issue an error
+      if (this->Constitutive_law_pt == 0)
+      {
+        // Write an error message
+        std::string error_message =
+          "Elements derived from PVDEquations must have a constitutive law:\n";
+        error_message +=
+          "set one using the constitutive_law_pt() member function";
+        // Throw the error
+        throw OomphLibError(
+          error_message, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+      this->Constitutive_law_pt
+        ->calculate_second_piola_kirchhoff_stress_at_points(
+          n_point, DIM, g, G, sigma);
+    }
+
+    /// Return the "upper triangular" entries of the derivatives of the
+    /// 2nd Piola Kirchhoff stress tensors at n_point integration points
+    /// in one go (structure of arrays storage, see
+    /// ConstitutiveLaw::calculate_d_second_piola_kirchhoff_stress_dG_at_points())
+    inline void get_d_stress_dG_upper_at_points(const unsigned& n_point,
+                                                const double* g,
+                                                const double* G,
+                                                const double* sigma,
+                                                double* d_sigma_dG)
+    {
+#ifdef PARANOID
+      // If the pointer to the constitutive law hasn't been set, issue an error
+      if (this->Constitutive_law_pt == 0)
+      {
+        // Write an error message
+        std::string error_message =
+          "Elements derived from PVDEquations must have a constitutive law:\n";
+        error_message +=
+          "set one using the constitutive_law_pt() member function";
+        // Throw the error
+        throw OomphLibError(
+          error_message, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+      // Only bother with the symmetric part by passing false as last entry
+      this->Constitutive_law_pt
+        ->calculate_d_second_piola_kirchhoff_stress_dG_at_points(
+          n_point, DIM, g, G, sigma, d_sigma_dG, false);
+    }
+
 
   private:
     /// Unpin all solid pressure dofs -- empty as there are no pressures
@@ -1312,6 +1383,73 @@ namespace oomph
       this->Constitutive_law_pt->calculate_d_second_piola_kirchhoff_stress_dG(
         g, G, sigma, detG, interpolated_solid_p, d_sigma_dG, d_detG_dG, false);
     }
+
+    /// Return the deviatoric parts of the 2nd Piola Kirchhoff stress
+    /// tensors, the contravariant deformed metric tensors and the
+    /// determinants of the deformed covariant metric tensors at n_point
+    /// integration points in one go (incompressible formulation).
+    /// Tensors are stored as structure of arrays (see
+    /// ConstitutiveLaw::calculate_second_piola_kirchhoff_stress_at_points())
+    inline void get_stress_at_points(const unsigned& n_point,
+                                     const double* g,
+                                     const double* G,
+                                     double* sigma_dev,
+                                     double* Gcontra,
+                                     double* detG)
+    {
+#ifdef PARANOID
+      // If the pointer to the constitutive law hasn't been set, issue an error
+      if (this->Constitutive_law_pt == 0)
+      {
+        // Write an error message
+        std::string error_message =
+          "Elements derived from PVDEquationsWithPressure \n";
+        error_message += "must have a constitutive law:\n";
+        error_message +=
+          "set one using the constitutive_law_pt() member function";
+        // Throw the error
+        throw OomphLibError(
+          error_message, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+      this->Constitutive_law_pt
+        ->calculate_second_piola_kirchhoff_stress_at_points(
+          n_point, DIM, g, G, sigma_dev, Gcontra, detG);
+    }
+
+    /// Return the deviatoric parts of the 2nd Piola Kirchhoff stress
+    /// tensors, the contravariant deformed metric tensors, the generalised
+    /// dilatations and the inverse bulk moduli at n_point integration
+    /// points in one go (nearly incompressible formulation).
+    /// Tensors are stored as structure of arrays (see
+    /// ConstitutiveLaw::calculate_second_piola_kirchhoff_stress_at_points())
+    inline void get_stress_at_points(const unsigned& n_point,
+                                     const double* g,
+                                     const double* G,
+                                     double* sigma_dev,
+                                     double* Gcontra,
+                                     double* gen_dil,
+                                     double* inv_kappa)
+    {
+#ifdef PARANOID
+      // If the pointer to the constitutive law hasn't been set, issue an error
+      if (this->Constitutive_law_pt == 0)
+      {
+        // Write an error message
+        std::string error_message =
+          "Elements derived from PVDEquationsWithPressure \n";
+        error_message += "must have a constitutive law:\n";
+        error_message +=
+          "set one using the constitutive_law_pt() member function";
+        // Throw the error
+        throw OomphLibError(
+          error_message, OOMPH_CURRENT_FUNCTION, OOMPH_EXCEPTION_LOCATION);
+      }
+#endif
+      this->Constitutive_law_pt
+        ->calculate_second_piola_kirchhoff_stress_at_points(
+          n_point, DIM, g, G, sigma_dev, Gcontra, gen_dil, inv_kappa);
+    }
   };
 
 
@@ -1333,7 +1333,7 @@ namespace oomph
 
     // create column index and row start
     int* m_column_index = new int[nrow_local];
-    int* m_row_start = new int[nrow_local + 1];
+    SparseOffset* m_row_start = new SparseOffset[nrow_local + 1];
     for (unsigned i = 0; i < nrow_local; i++)
     {
       m_values[i] = 1 / m_values[i];
@@ -273,6 +273,13 @@ namespace oomph
     // The total time for setting up the matrix-vector products
     double t_mvp_setup_total = 0.0;
 
+    // If we're using the parareal iteration we need a coarse preconditioner
+    // for each diagonal block
+    if (Use_parareal)
+    {
+      Coarse_preconditioner_pt.resize(n_block_types, 0);
+    }
+
     // Build the preconditioners and matrix vector products
     for (unsigned i = 0; i < n_block_types; i++)
     {
@@ -280,6 +287,22 @@ namespace oomph
       if (dynamic_cast<BlockPreconditioner<CRDoubleMatrix>*>(
             this->Subsidiary_preconditioner_pt[i]) != 0)
       {
+        // The parareal solver applies the subsidiary preconditioners to
+        // the block vectors concurrently which block preconditioners can't
+        // handle (they need the full vectors)
+        if (Use_parareal)
+        {
+          std::ostringstream error_message_stream;
+          error_message_stream
+            << "The " << i << "-th subsidiary preconditioner is a block "
+            << "preconditioner.\nThis can't be used with the parareal "
+            << "iteration; call disable_parareal()\nor use non-block "
+            << "subsidiary preconditioners." << std::endl;
+          throw OomphLibError(error_message_stream.str(),
+                              OOMPH_CURRENT_FUNCTION,
+                              OOMPH_EXCEPTION_LOCATION);
+        }
+
         // If we need to compute the memory statistics
         if (Compute_memory_statistics)
         {
@@ -330,6 +353,14 @@ namespace oomph
         // Set up the i-th subsidiary preconditioner with this block
         this->Subsidiary_preconditioner_pt[i]->setup(&block_matrix);
 
+        // Set up the coarse preconditioner for the parareal iteration
+        if (Use_parareal)
+        {
+          Coarse_preconditioner_pt[i] =
+            (*Coarse_preconditioner_creation_function_pt)();
+          Coarse_preconditioner_pt[i]->setup(&block_matrix);
+        }
+
         // Get the end time
         double t_subsidiary_setup_end = TimingHelpers::timer();
 
@@ -434,6 +465,15 @@ namespace oomph
       }
     } // for (unsigned i=0;i<n_block_types;i++)
 
+    // Pass the operators to the parareal solver
+    if (Use_parareal)
+    {
+      Parareal_solver.setup(this->Subsidiary_preconditioner_pt,
+                            Coarse_preconditioner_pt,
+                            Off_diagonal_matrix_vector_products,
+                            Upper_triangular);
+    }
+
     // Remember that the preconditioner has been set up
     Preconditioner_has_been_setup = true;
 
@@ -600,6 +640,22 @@ namespace oomph
   void BandedBlockTriangularPreconditioner<MATRIX>::preconditioner_solve(
     const DoubleVector& r, DoubleVector& z)
   {
+    // If we're using the parareal iteration the solver does all the work
+    if (Use_parareal)
+    {
+      // Split r into the block vectors
+      Vector<DoubleVector> block_r;
+      this->get_block_vectors(r, block_r);
+
+      // Solve the block triangular system
+      Vector<DoubleVector> block_z;
+      Parareal_solver.solve(block_r, block_z);
+
+      // Copy the solution back into z
+      this->return_block_vectors(block_z, z);
+      return;
+    }
+
     // Cache number of block types
     unsigned n_block = this->nblock_types();
 
@@ -35,6 +35,10 @@
 // Oomph-lib headers
 #include "generic/iterative_linear_solver.h"
 #include "generic/general_purpose_block_preconditioners.h"
+#include "generic/general_purpose_preconditioners.h"
+
+// The parallel-in-time solver for the block triangular systems
+#include "parareal_block_triangular_solver.h"
 
 // Add in the subsidiary preconditioners
 #include "general_purpose_space_time_subsidiary_block_preconditioner.h"
@@ -45,6 +49,23 @@
 
 namespace oomph
 {
+  //=============================================================================
+  /// Helper functions to create the preconditioners used by the space-time
+  /// block preconditioners
+  //=============================================================================
+  namespace SpaceTimePreconditionerCreationFunctions
+  {
+    /// Create an ILU(3) preconditioner (the default coarse preconditioner
+    /// for the parareal iteration in BandedBlockTriangularPreconditioner).
+    /// Some fill is needed for the incomplete factorisation to capture the
+    /// propagation of the solution through the time slab; ILU(0) gives
+    /// very slow parareal convergence.
+    inline Preconditioner* create_iluk_preconditioner()
+    {
+      return new ILUKPreconditioner(3);
+    }
+  } // namespace SpaceTimePreconditionerCreationFunctions
+
   //=============================================================================
   /// General purpose block tridiagonal preconditioner. By default
   /// SuperLUPreconditioner (or SuperLUDistPreconditioner) is used to solve the
@@ -216,6 +237,14 @@ namespace oomph
 
       // Initialise the value of Memory_usage_in_bytes
       Memory_usage_in_bytes = 0.0;
+
+      // Use sequential block substitution by default
+      Use_parareal = false;
+
+      // By default the coarse (parareal) preconditioners are ILU(3)
+      Coarse_preconditioner_creation_function_pt =
+        &SpaceTimePreconditionerCreationFunctions::
+          create_iluk_preconditioner;
     } // End of BandedBlockTriangularPreconditioner
 
 
@@ -247,6 +276,17 @@ namespace oomph
         }
       } // for (unsigned i=0,ni=Off_diagonal_matrix_vector_products.nrow();...
 
+      // Delete the coarse preconditioners used by the parareal solver
+      unsigned n_coarse = Coarse_preconditioner_pt.size();
+      for (unsigned i = 0; i < n_coarse; i++)
+      {
+        delete Coarse_preconditioner_pt[i];
+      }
+      Coarse_preconditioner_pt.clear();
+
+      // The parareal solver doesn't own anything, just make it forget
+      Parareal_solver.clean_up_memory();
+
       // Clean up the base class too
       GeneralPurposeBlockPreconditioner<MATRIX>::clean_up_memory();
     } // End of clean_up_memory
@@ -307,6 +347,53 @@ namespace oomph
     } // End of is_upper_triangular
 
 
+    /// Apply the preconditioner with n_iteration parareal iterations
+    /// (see PararealBlockTriangularSolver) rather than sequential block
+    /// substitution. The solves with the subsidiary preconditioners for the
+    /// diagonal blocks are then done concurrently; only the cheap coarse
+    /// preconditioners are applied sequentially. The preconditioner is
+    /// exact (i.e. the same as block substitution) if n_iteration is at
+    /// least the number of block types. Requires the subsidiary
+    /// preconditioners to be non-block preconditioners that can be applied
+    /// concurrently.
+    void enable_parareal(const unsigned& n_iteration = 2)
+    {
+      Use_parareal = true;
+      Parareal_solver.n_iteration() = n_iteration;
+    } // End of enable_parareal
+
+
+    /// Use sequential block substitution (default)
+    void disable_parareal()
+    {
+      Use_parareal = false;
+    } // End of disable_parareal
+
+
+    /// Is the parareal iteration used?
+    bool is_parareal_enabled() const
+    {
+      return Use_parareal;
+    } // End of is_parareal_enabled
+
+
+    /// Set the function used to create the coarse preconditioners for the
+    /// diagonal blocks in the parareal iteration (ILU(3) by default).
+    void set_coarse_preconditioner_function(
+      typename GeneralPurposeBlockPreconditioner<
+        MATRIX>::SubsidiaryPreconditionerFctPt coarse_prec_fn)
+    {
+      Coarse_preconditioner_creation_function_pt = coarse_prec_fn;
+    } // End of set_coarse_preconditioner_function
+
+
+    /// Access to the parareal solver (e.g. to doc the solve times)
+    PararealBlockTriangularSolver& parareal_solver()
+    {
+      return Parareal_solver;
+    } // End of parareal_solver
+
+
     /// Document the memory usage
     void enable_doc_memory_usage()
     {
@@ -399,6 +486,21 @@ namespace oomph
     /// Storage for the memory usage of the solver if the flag above
     /// is set to true (in bytes)
     double Memory_usage_in_bytes;
+
+    /// Flag to indicate whether the parareal iteration is used
+    bool Use_parareal;
+
+    /// The parallel-in-time solver for the block triangular system
+    PararealBlockTriangularSolver Parareal_solver;
+
+    /// The coarse preconditioners for the diagonal blocks (used by the
+    /// parareal solver)
+    Vector<Preconditioner*> Coarse_preconditioner_pt;
+
+    /// Function to create the coarse preconditioners
+    typename GeneralPurposeBlockPreconditioner<
+      MATRIX>::SubsidiaryPreconditionerFctPt
+      Coarse_preconditioner_creation_function_pt;
   };
 } // End of namespace oomph
 #endif
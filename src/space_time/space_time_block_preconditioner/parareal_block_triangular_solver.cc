@@ -0,0 +1,336 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+// Oomph-lib headers
+#include "generic/oomph_utilities.h"
+
+// Header file
+#include "parareal_block_triangular_solver.h"
+
+// c++ includes
+#include <algorithm>
+#include <exception>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/// /////////////////////////////////////////////////////////////////////////
+/// /////////////////////////////////////////////////////////////////////////
+/// /////////////////////////////////////////////////////////////////////////
+
+namespace oomph
+{
+  //============================================================================
+  /// Setup: Pass the (set up) fine and coarse preconditioners for
+  /// the diagonal blocks and the matrix-vector products for the
+  /// off-diagonal blocks (coupling_pt(i,j) is the operator for block
+  /// (i,j); null pointers indicate blocks that are zero). The flag
+  /// indicates whether the system is upper or lower block triangular.
+  //============================================================================
+  void PararealBlockTriangularSolver::setup(
+    const Vector<Preconditioner*>& fine_preconditioner_pt,
+    const Vector<Preconditioner*>& coarse_preconditioner_pt,
+    const DenseMatrix<MatrixVectorProduct*>& coupling_pt,
+    const bool& upper_triangular)
+  {
+#ifdef PARANOID
+    // Number of slabs
+    unsigned n_slab = fine_preconditioner_pt.size();
+
+    // Check the sizes
+    if ((coarse_preconditioner_pt.size() != n_slab) ||
+        (coupling_pt.nrow() != n_slab) || (coupling_pt.ncol() != n_slab))
+    {
+      std::ostringstream error_message_stream;
+      error_message_stream
+        << "The number of fine preconditioners (" << n_slab
+        << "), coarse preconditioners (" << coarse_preconditioner_pt.size()
+        << ") and the size of the matrix of off-diagonal blocks ("
+        << coupling_pt.nrow() << "x" << coupling_pt.ncol()
+        << ") must be consistent.";
+      throw OomphLibError(error_message_stream.str(),
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+
+    for (unsigned i = 0; i < n_slab; i++)
+    {
+      // Check the preconditioners have been set
+      if ((fine_preconditioner_pt[i] == 0) ||
+          (coarse_preconditioner_pt[i] == 0))
+      {
+        std::ostringstream error_message_stream;
+        error_message_stream << "The fine or coarse preconditioner for slab "
+                             << i << " is null.";
+        throw OomphLibError(error_message_stream.str(),
+                            OOMPH_CURRENT_FUNCTION,
+                            OOMPH_EXCEPTION_LOCATION);
+      }
+
+      // Check the system is block triangular
+      for (unsigned j = 0; j < n_slab; j++)
+      {
+        if ((coupling_pt(i, j) != 0) &&
+            ((i == j) || ((j > i) != upper_triangular)))
+        {
+          std::ostringstream error_message_stream;
+          error_message_stream << "Block (" << i << "," << j
+                               << ") must be zero in a block "
+                               << (upper_triangular ? "upper" : "lower")
+                               << " triangular system.";
+          throw OomphLibError(error_message_stream.str(),
+                              OOMPH_CURRENT_FUNCTION,
+                              OOMPH_EXCEPTION_LOCATION);
+        }
+      }
+    }
+#endif
+
+    // Store everything
+    Fine_preconditioner_pt = fine_preconditioner_pt;
+    Coarse_preconditioner_pt = coarse_preconditioner_pt;
+    Coupling_pt = coupling_pt;
+    Upper_triangular = upper_triangular;
+  } // End of setup
+
+  //============================================================================
+  /// Compute rhs = r_i - sum_j C_ij z_j for the i-th slab
+  //============================================================================
+  void PararealBlockTriangularSolver::get_slab_rhs(
+    const unsigned& i,
+    const DoubleVector& r_i,
+    const Vector<DoubleVector>& z,
+    DoubleVector& rhs) const
+  {
+    // Start with the rhs
+    rhs = r_i;
+
+    // Subtract the contributions from the coupled slabs
+    unsigned n_slab = nslab();
+    for (unsigned j = 0; j < n_slab; j++)
+    {
+      if (Coupling_pt(i, j) != 0)
+      {
+        DoubleVector temp;
+        Coupling_pt(i, j)->multiply(z[j], temp);
+        rhs -= temp;
+      }
+    }
+  } // End of get_slab_rhs
+
+  //============================================================================
+  /// Do the fine solves for all slabs concurrently:
+  /// f_i = P_i (r_i - sum_j C_ij z_j). Slabs that come before the
+  /// first_position-th slab (in the direction of the sweep) are already
+  /// exact and are skipped (f_i is not touched).
+  //============================================================================
+  void PararealBlockTriangularSolver::concurrent_fine_solves(
+    const Vector<DoubleVector>& r,
+    const Vector<DoubleVector>& z,
+    const unsigned& first_position,
+    Vector<DoubleVector>& f)
+  {
+    // Number of slabs
+    int n_slab = nslab();
+    int first = first_position;
+
+    // Exceptions can't leave a parallel region so we catch them and rethrow
+    // them once all slabs have been processed
+    Vector<std::exception_ptr> slab_exception_pt(n_slab);
+
+    // The subsidiary solves may communicate so only use threads if
+    // everything is on a single processor
+    bool use_threads = true;
+    if (r[0].distributed() &&
+        (r[0].distribution_pt()->communicator_pt()->nproc() > 1))
+    {
+      use_threads = false;
+    }
+
+    // Suppress any output from the preconditioners while they're applied
+    // concurrently
+    std::ostream* stream_pt = oomph_info.stream_pt();
+    if (use_threads)
+    {
+      oomph_info.stream_pt() = &oomph_nullstream;
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1) if (use_threads)
+#endif
+    for (int s = first; s < n_slab; s++)
+    {
+      int i = Upper_triangular ? n_slab - 1 - s : s;
+      try
+      {
+        DoubleVector rhs;
+        get_slab_rhs(i, r[i], z, rhs);
+        Fine_preconditioner_pt[i]->preconditioner_solve(rhs, f[i]);
+      }
+      catch (...)
+      {
+        slab_exception_pt[i] = std::current_exception();
+      }
+    }
+
+    // Restore the output stream
+    oomph_info.stream_pt() = stream_pt;
+
+    // Rethrow the first exception (if any)
+    for (int i = 0; i < n_slab; i++)
+    {
+      if (slab_exception_pt[i])
+      {
+        std::rethrow_exception(slab_exception_pt[i]);
+      }
+    }
+  } // End of concurrent_fine_solves
+
+  //============================================================================
+  /// Solve the block triangular system for the block vectors r
+  //============================================================================
+  void PararealBlockTriangularSolver::solve(const Vector<DoubleVector>& r,
+                                            Vector<DoubleVector>& z)
+  {
+    // Number of slabs
+    unsigned n_slab = nslab();
+
+#ifdef PARANOID
+    // Check the number of block vectors
+    if (r.size() != n_slab)
+    {
+      std::ostringstream error_message_stream;
+      error_message_stream << "The number of block vectors (" << r.size()
+                           << ") must be the same as the number of slabs ("
+                           << n_slab << ").";
+      throw OomphLibError(error_message_stream.str(),
+                          OOMPH_CURRENT_FUNCTION,
+                          OOMPH_EXCEPTION_LOCATION);
+    }
+#endif
+
+    // Reset the timers
+    Fine_solve_time = 0.0;
+    Coarse_solve_time = 0.0;
+
+    // Nothing to do?
+    z.resize(n_slab);
+    if (n_slab == 0) return;
+
+    // The order in which the slabs are swept
+    Vector<unsigned> slab_in_sweep(n_slab);
+    for (unsigned s = 0; s < n_slab; s++)
+    {
+      slab_in_sweep[s] = Upper_triangular ? n_slab - 1 - s : s;
+    }
+
+    // Initial guess from a coarse sweep
+    double t_start = TimingHelpers::timer();
+    for (unsigned s = 0; s < n_slab; s++)
+    {
+      unsigned i = slab_in_sweep[s];
+      DoubleVector rhs;
+      get_slab_rhs(i, r[i], z, rhs);
+      Coarse_preconditioner_pt[i]->preconditioner_solve(rhs, z[i]);
+    }
+    Coarse_solve_time += TimingHelpers::timer() - t_start;
+
+    // Storage for the fine solutions and the previous iterate
+    Vector<DoubleVector> f(n_slab);
+    Vector<DoubleVector> z_old(n_slab);
+
+    // Do the parareal iterations. After the k-th iteration the first k
+    // slabs in the direction of the sweep are exact (their fine solves
+    // only depend on the preceding slabs, which didn't change), so they
+    // are skipped in the subsequent iterations. There's no point doing
+    // more iterations than there are slabs since the solution is exact
+    // after that.
+    unsigned n_iter = std::min(N_iteration, n_slab);
+    for (unsigned k = 0; k < n_iter; k++)
+    {
+      // Do the fine solves (concurrently) with the current iterate
+      t_start = TimingHelpers::timer();
+      concurrent_fine_solves(r, z, k, f);
+      Fine_solve_time += TimingHelpers::timer() - t_start;
+
+      // Store the current iterate
+      t_start = TimingHelpers::timer();
+      for (unsigned i = 0; i < n_slab; i++)
+      {
+        z_old[i] = z[i];
+      }
+
+      // Correction sweep: z_i = f_i - Q_i sum_j C_ij (z_j - z_old_j)
+      // (the exact slabs don't change)
+      for (unsigned s = k; s < n_slab; s++)
+      {
+        unsigned i = slab_in_sweep[s];
+
+        // Get the change in the coupling terms
+        DoubleVector delta_rhs;
+        bool have_coupling = false;
+        for (unsigned j = 0; j < n_slab; j++)
+        {
+          if (Coupling_pt(i, j) != 0)
+          {
+            DoubleVector delta_z(z[j]);
+            delta_z -= z_old[j];
+            DoubleVector temp;
+            Coupling_pt(i, j)->multiply(delta_z, temp);
+            if (!have_coupling)
+            {
+              delta_rhs.build(temp.distribution_pt(), 0.0);
+              have_coupling = true;
+            }
+            delta_rhs -= temp;
+          }
+        }
+
+        // Correct the fine solution
+        z[i] = f[i];
+        if (have_coupling)
+        {
+          DoubleVector correction;
+          Coarse_preconditioner_pt[i]->preconditioner_solve(delta_rhs,
+                                                            correction);
+          z[i] += correction;
+        }
+      }
+      Coarse_solve_time += TimingHelpers::timer() - t_start;
+    }
+
+    // Doc the times
+    if (Doc_time)
+    {
+      oomph_info << "Parareal solve with " << n_slab << " slabs and " << n_iter
+                 << " iterations.\nTime for fine solves [sec]: "
+                 << Fine_solve_time
+                 << "\nTime for coarse sweeps [sec]: " << Coarse_solve_time
+                 << std::endl;
+    }
+  } // End of solve
+
+} // End of namespace oomph
@@ -0,0 +1,200 @@
+// LIC// ====================================================================
+// LIC// This file forms part of oomph-lib, the object-oriented,
+// LIC// multi-physics finite-element library, available
+// LIC// at http://www.oomph-lib.org.
+// LIC//
+// LIC// Copyright (C) 2006-2021 Matthias Heil and Andrew Hazel
+// LIC//
+// LIC// This library is free software; you can redistribute it and/or
+// LIC// modify it under the terms of the GNU Lesser General Public
+// LIC// License as published by the Free Software Foundation; either
+// LIC// version 2.1 of the License, or (at your option) any later version.
+// LIC//
+// LIC// This library is distributed in the hope that it will be useful,
+// LIC// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// LIC// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// LIC// Lesser General Public License for more details.
+// LIC//
+// LIC// You should have received a copy of the GNU Lesser General Public
+// LIC// License along with this library; if not, write to the Free Software
+// LIC// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+// LIC// 02110-1301  USA.
+// LIC//
+// LIC// The authors may be contacted at oomph-lib@maths.man.ac.uk.
+// LIC//
+// LIC//====================================================================
+// Header file for the parallel-in-time solver for block triangular systems
+#ifndef OOMPH_PARAREAL_BLOCK_TRIANGULAR_SOLVER_HEADER
+#define OOMPH_PARAREAL_BLOCK_TRIANGULAR_SOLVER_HEADER
+
+// Config header generated by autoconfig
+#ifdef HAVE_CONFIG_H
+#include <oomph-lib-config.h>
+#endif
+
+// Oomph-lib headers
+#include "generic/matrices.h"
+#include "generic/preconditioner.h"
+#include "generic/matrix_vector_product.h"
+
+/// /////////////////////////////////////////////////////////////////////////
+/// /////////////////////////////////////////////////////////////////////////
+/// /////////////////////////////////////////////////////////////////////////
+
+namespace oomph
+{
+  //=============================================================================
+  /// Parallel-in-time (parareal) solver for the block triangular systems
+  /// that arise from space-time (time-slab) discretisations, i.e.
+  /// \f[ D_i z_i + \sum_{j} C_{ij} z_j = r_i, \f]
+  /// where block i corresponds to the i-th time slab and the off-diagonal
+  /// blocks C_{ij} only couple slab i to the preceding slabs j<i (lower
+  /// triangular, time runs forwards) or to the following slabs j>i (upper
+  /// triangular). Sequential forward substitution requires the slab solves
+  /// (with the "fine" preconditioners, which approximate inv(D_i)) to be
+  /// done one after the other. The parareal iteration
+  /// \f[ f_i = P_i \left(r_i - \sum_j C_{ij} z^k_j\right), \qquad
+  ///     z^{k+1}_i = f_i - Q_i \sum_j C_{ij} (z^{k+1}_j - z^k_j) \f]
+  /// instead does all the fine solves (P_i) of an iteration concurrently
+  /// and only performs the sweep with the cheap "coarse" preconditioners
+  /// (Q_i, e.g. an incomplete factorisation of D_i) sequentially. The
+  /// initial guess is obtained from a coarse sweep. After k iterations the
+  /// first k slabs are exact (i.e. the same as for sequential forward
+  /// substitution) so the iteration is exact once the number of iterations
+  /// reaches the number of slabs.
+  ///
+  /// The fine solves are distributed over the threads with OpenMP (if the
+  /// library is compiled with OpenMP; otherwise, and if the vectors are
+  /// distributed over several processors, they're done one after the
+  /// other). The fine preconditioners must therefore be safe to apply
+  /// concurrently. Any output written to oomph_info during the concurrent
+  /// fine solves is suppressed.
+  ///
+  /// This class does not take ownership of any of the objects passed to
+  /// setup(...).
+  //=============================================================================
+  class PararealBlockTriangularSolver
+  {
+  public:
+    /// Constructor: Specify the number of parareal iterations
+    PararealBlockTriangularSolver(const unsigned& n_iteration = 2)
+      : N_iteration(n_iteration),
+        Upper_triangular(false),
+        Doc_time(false),
+        Fine_solve_time(0.0),
+        Coarse_solve_time(0.0)
+    {
+    }
+
+    /// Broken copy constructor
+    PararealBlockTriangularSolver(const PararealBlockTriangularSolver&) =
+      delete;
+
+    /// Broken assignment operator
+    void operator=(const PararealBlockTriangularSolver&) = delete;
+
+    /// Destructor (empty -- nothing is owned by this class)
+    ~PararealBlockTriangularSolver() {}
+
+    /// Setup: Pass the (set up) fine and coarse preconditioners for
+    /// the diagonal blocks and the matrix-vector products for the
+    /// off-diagonal blocks (coupling_pt(i,j) is the operator for block
+    /// (i,j); null pointers indicate blocks that are zero). The flag
+    /// indicates whether the system is upper or lower block triangular.
+    void setup(const Vector<Preconditioner*>& fine_preconditioner_pt,
+               const Vector<Preconditioner*>& coarse_preconditioner_pt,
+               const DenseMatrix<MatrixVectorProduct*>& coupling_pt,
+               const bool& upper_triangular);
+
+    /// Solve the block triangular system for the block vectors r
+    void solve(const Vector<DoubleVector>& r, Vector<DoubleVector>& z);
+
+    /// Clean up memory (forget about the operators)
+    void clean_up_memory()
+    {
+      Fine_preconditioner_pt.clear();
+      Coarse_preconditioner_pt.clear();
+      Coupling_pt.resize(0, 0);
+    }
+
+    /// Access function to the number of parareal iterations
+    unsigned& n_iteration()
+    {
+      return N_iteration;
+    }
+
+    /// Number of time slabs
+    unsigned nslab() const
+    {
+      return Fine_preconditioner_pt.size();
+    }
+
+    /// Enable documentation of the solve times
+    void enable_doc_time()
+    {
+      Doc_time = true;
+    }
+
+    /// Disable documentation of the solve times
+    void disable_doc_time()
+    {
+      Doc_time = false;
+    }
+
+    /// Wall-clock time [sec] spent in the (concurrent) fine solves during
+    /// the last solve
+    double fine_solve_time() const
+    {
+      return Fine_solve_time;
+    }
+
+    /// Wall-clock time [sec] spent in the (sequential) coarse sweeps
+    /// during the last solve
+    double coarse_solve_time() const
+    {
+      return Coarse_solve_time;
+    }
+
+  private:
+    /// Compute rhs = r_i - sum_j C_ij z_j for the i-th slab
+    void get_slab_rhs(const unsigned& i,
+                      const DoubleVector& r_i,
+                      const Vector<DoubleVector>& z,
+                      DoubleVector& rhs) const;
+
+    /// Do the fine solves concurrently for all slabs from the
+    /// first_position-th one in the direction of the sweep onwards:
+    /// f_i = P_i (r_i - sum_j C_ij z_j)
+    void concurrent_fine_solves(const Vector<DoubleVector>& r,
+                                const Vector<DoubleVector>& z,
+                                const unsigned& first_position,
+                                Vector<DoubleVector>& f);
+
+    /// The fine preconditioners for the diagonal blocks
+    Vector<Preconditioner*> Fine_preconditioner_pt;
+
+    /// The coarse preconditioners for the diagonal blocks
+    Vector<Preconditioner*> Coarse_preconditioner_pt;
+
+    /// Matrix-vector products for the off-diagonal blocks
+    DenseMatrix<MatrixVectorProduct*> Coupling_pt;
+
+    /// Number of parareal iterations
+    unsigned N_iteration;
+
+    /// Is the system upper (rather than lower) block triangular?
+    bool Upper_triangular;
+
+    /// Doc the solve times?
+    bool Doc_time;
+
+    /// Time spent in the fine solves during the last solve
+    double Fine_solve_time;
+
+    /// Time spent in the coarse sweeps during the last solve
+    double Coarse_solve_time;
+  };
+
+} // End of namespace oomph
+
+#endif